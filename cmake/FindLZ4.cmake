@@ -0,0 +1,50 @@
+#[=======================================================================[.rst:
+FindLZ4
+-------
+
+Find the lz4 compression library
+
+IMPORTED targets
+^^^^^^^^^^^^^^^^
+
+This module defines the following :prop_tgt:`IMPORTED` target:
+
+``LZ4::LZ4``
+
+Result variables
+^^^^^^^^^^^^^^^^
+
+This module will set the following variables if found:
+
+``LZ4_INCLUDE_DIRS``
+  where to find lz4frame.h, etc.
+``LZ4_LIBRARIES``
+  the libraries to link against to use lz4.
+``LZ4_FOUND``
+  TRUE if found
+
+#]=======================================================================]
+
+# Look for the necessary header
+find_path(LZ4_INCLUDE_DIR NAMES lz4frame.h)
+mark_as_advanced(LZ4_INCLUDE_DIR)
+
+# Look for the necessary library
+find_library(LZ4_LIBRARY NAMES lz4)
+mark_as_advanced(LZ4_LIBRARY)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(LZ4
+    REQUIRED_VARS LZ4_INCLUDE_DIR LZ4_LIBRARY)
+
+# Create the imported target
+if(LZ4_FOUND)
+    set(LZ4_INCLUDE_DIRS ${LZ4_INCLUDE_DIR})
+    set(LZ4_LIBRARIES ${LZ4_LIBRARY})
+    if(NOT TARGET LZ4::LZ4)
+        add_library(LZ4::LZ4 UNKNOWN IMPORTED)
+        set_target_properties(LZ4::LZ4 PROPERTIES
+            IMPORTED_LOCATION             "${LZ4_LIBRARY}"
+            INTERFACE_INCLUDE_DIRECTORIES "${LZ4_INCLUDE_DIR}")
+    endif()
+endif()
@@ -40,12 +40,15 @@ enum class AggregateOp {
     USUM,
 
     COUNT,
+    COUNTD,
 };
 
 inline std::ostream& operator<<(std::ostream& os, AggregateOp op) {
     switch (op) {
         case AggregateOp::COUNT: return os << "count";
 
+        case AggregateOp::COUNTD: return os << "countd";
+
         case AggregateOp::MEAN: return os << "mean";
 
         case AggregateOp::MAX:
@@ -69,6 +72,7 @@ inline std::pair<uint8_t, uint8_t> aggregateArity(AggregateOp op) {
     switch (op) {
         case AggregateOp::COUNT: return {0, 0};
 
+        case AggregateOp::COUNTD:
         case AggregateOp::FMAX:
         case AggregateOp::FMIN:
         case AggregateOp::FSUM:
@@ -90,6 +94,7 @@ inline std::pair<uint8_t, uint8_t> aggregateArity(AggregateOp op) {
 inline TypeAttribute getTypeAttributeAggregate(const AggregateOp op) {
     switch (op) {
         case AggregateOp::COUNT:
+        case AggregateOp::COUNTD:
         case AggregateOp::MAX:
         case AggregateOp::MIN:
         case AggregateOp::SUM: return TypeAttribute::Signed;
@@ -114,7 +119,8 @@ inline bool isOverloadedAggregator(const AggregateOp op) {
         case AggregateOp::SUM: return true;
 
         case AggregateOp::MEAN:
-        case AggregateOp::COUNT: return false;
+        case AggregateOp::COUNT:
+        case AggregateOp::COUNTD: return false;
 
         default: return false;
     }
@@ -0,0 +1,20 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CommonBTreeInstantiations.cpp
+ *
+ * Explicitly instantiates the btree specialisations declared in
+ * BTreeCommon.h into libsouffle-common-btree, so generated programs can
+ * link against them instead of re-instantiating the templates.
+ *
+ ***********************************************************************/
+
+#define SOUFFLE_INSTANTIATE_COMMON_BTREE
+#include "souffle/datastructure/BTreeCommon.h"
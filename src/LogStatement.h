@@ -103,6 +103,14 @@ public:
         return line.str();
     }
 
+    static const std::string nRecursiveDelta(
+            const std::string& relationName, const SrcLocation& srcLocation) {
+        const char* messageType = "@n-recursive-delta";
+        std::stringstream line;
+        line << messageType << ";" << relationName << ";" << srcLocation << ";";
+        return line.str();
+    }
+
     static const std::string cRecursiveRelation(
             const std::string& relationName, const SrcLocation& srcLocation) {
         const char* messageType = "@c-recursive-relation";
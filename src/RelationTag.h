@@ -35,6 +35,7 @@ enum class RelationTag {
     BRIE,         // use brie data-structure
     BTREE,        // use btree data-structure
     EQREL,        // use union data-structure
+    INTERVAL,     // use interval data-structure
 };
 
 /** Space of qualifiers that a relation can have */
@@ -53,10 +54,11 @@ enum class RelationQualifier {
 /** Space of internal representations that a relation can have */
 enum class RelationRepresentation {
     DEFAULT,  // use default data-structure
-    BRIE,     // use brie data-structure
-    BTREE,    // use btree data-structure
-    EQREL,    // use union data-structure
-    INFO,     // info relation for provenance
+    BRIE,      // use brie data-structure
+    BTREE,     // use btree data-structure
+    EQREL,     // use union data-structure
+    INTERVAL,  // use interval data-structure
+    INFO,      // info relation for provenance
 };
 
 /**
@@ -66,7 +68,8 @@ inline bool isRelationRepresentationTag(const RelationTag& tag) {
     switch (tag) {
         case RelationTag::BRIE:
         case RelationTag::BTREE:
-        case RelationTag::EQREL: return true;
+        case RelationTag::EQREL:
+        case RelationTag::INTERVAL: return true;
         default: return false;
     }
 }
@@ -115,6 +118,7 @@ inline RelationRepresentation getRelationRepresentationFromTag(const RelationTag
         case RelationTag::BRIE: return RelationRepresentation::BRIE;
         case RelationTag::BTREE: return RelationRepresentation::BTREE;
         case RelationTag::EQREL: return RelationRepresentation::EQREL;
+        case RelationTag::INTERVAL: return RelationRepresentation::INTERVAL;
         default: fatal("invalid relation tag");
     }
 
@@ -135,6 +139,7 @@ inline std::ostream& operator<<(std::ostream& os, RelationTag qualifier) {
         case RelationTag::BRIE: return os << "brie";
         case RelationTag::BTREE: return os << "btree";
         case RelationTag::EQREL: return os << "eqrel";
+        case RelationTag::INTERVAL: return os << "interval";
     }
 
     UNREACHABLE_BAD_CASE_ANALYSIS
@@ -161,6 +166,7 @@ inline std::ostream& operator<<(std::ostream& os, RelationRepresentation represe
         case RelationRepresentation::BTREE: return os << "btree";
         case RelationRepresentation::BRIE: return os << "brie";
         case RelationRepresentation::EQREL: return os << "eqrel";
+        case RelationRepresentation::INTERVAL: return os << "interval";
         case RelationRepresentation::INFO: return os << "info";
         case RelationRepresentation::DEFAULT: return os;
     }
@@ -57,6 +57,14 @@ void Clause::setExecutionPlan(Own<ExecutionPlan> plan) {
     this->plan = std::move(plan);
 }
 
+Own<Clause> Clause::cloneHead() const {
+    auto myClone = mk<Clause>(souffle::clone(head), getSrcLoc());
+    if (plan != nullptr) {
+        myClone->setExecutionPlan(souffle::clone(plan));
+    }
+    return myClone;
+}
+
 void Clause::apply(const NodeMapper& map) {
     head = map(std::move(head));
     mapAll(bodyLiterals, map);
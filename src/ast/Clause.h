@@ -75,6 +75,9 @@ public:
         plan = nullptr;
     }
 
+    /** Creates a clause of the same kind with the same head but an empty body */
+    virtual Own<Clause> cloneHead() const;
+
     void apply(const NodeMapper& map) override;
 
 protected:
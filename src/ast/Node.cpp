@@ -6,6 +6,9 @@
  * - <souffle root>/licenses/SOUFFLE-UPL.txt
  */
 #include "ast/Node.h"
+#include <functional>
+#include <sstream>
+#include <string>
 #include <typeinfo>
 #include <utility>
 
@@ -29,6 +32,12 @@ Own<Node> Node::cloneImpl() const {
     return Own<Node>(cloning());
 }
 
+std::size_t Node::getStructuralHash() const {
+    std::ostringstream buffer;
+    print(buffer);
+    return std::hash<std::string>{}(buffer.str());
+}
+
 /** Apply the mapper to all child nodes */
 void Node::apply(const NodeMapper& /* mapper */) {}
 
@@ -21,6 +21,7 @@
 #include "souffle/utility/NodeMapperFwd.h"
 #include "souffle/utility/Types.h"
 #include "souffle/utility/VisitorFwd.h"
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <string>
@@ -79,6 +80,15 @@ public:
         return !(*this == other);
     }
 
+    /**
+     * Compute a structural fingerprint of this node. Derived from the
+     * canonical printed form, hence equal nodes yield equal fingerprints and
+     * differing fingerprints prove inequality; used as a memoised pre-filter
+     * in front of the deep equal() machinery when many subtrees are compared
+     * against each other.
+     */
+    std::size_t getStructuralHash() const;
+
     /** Create a clone (i.e. deep copy) of this node */
     Own<Node> cloneImpl() const;
 
@@ -0,0 +1,58 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+#include "ast/SubsumptiveClause.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <ostream>
+#include <utility>
+
+namespace souffle::ast {
+
+SubsumptiveClause::SubsumptiveClause(
+        Own<Atom> head, VecOwn<Literal> bodyLiterals, Own<ExecutionPlan> plan, SrcLocation loc)
+        : Clause(std::move(head), std::move(bodyLiterals), std::move(plan), std::move(loc)) {}
+
+SubsumptiveClause::SubsumptiveClause(Own<Atom> head, SrcLocation loc)
+        : SubsumptiveClause(std::move(head), {}, {}, std::move(loc)) {}
+
+Own<Clause> SubsumptiveClause::cloneHead() const {
+    auto myClone = mk<SubsumptiveClause>(clone(getHead()), getSrcLoc());
+    if (getExecutionPlan() != nullptr) {
+        myClone->setExecutionPlan(clone(getExecutionPlan()));
+    }
+    return myClone;
+}
+
+void SubsumptiveClause::print(std::ostream& os) const {
+    const auto bodyLiterals = getBodyLiterals();
+    os << *bodyLiterals[0] << " <= " << *bodyLiterals[1];
+    if (bodyLiterals.size() > 2) {
+        os << " :- \n   ";
+        for (std::size_t i = 2; i < bodyLiterals.size(); i++) {
+            if (i > 2) {
+                os << ",\n   ";
+            }
+            os << *bodyLiterals[i];
+        }
+    }
+    os << ".";
+    if (getExecutionPlan() != nullptr) {
+        os << *getExecutionPlan();
+    }
+}
+
+SubsumptiveClause* SubsumptiveClause::cloning() const {
+    VecOwn<Literal> body;
+    for (const auto* literal : getBodyLiterals()) {
+        body.push_back(clone(literal));
+    }
+    return new SubsumptiveClause(clone(getHead()), std::move(body), clone(getExecutionPlan()), getSrcLoc());
+}
+
+}  // namespace souffle::ast
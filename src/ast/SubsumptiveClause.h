@@ -0,0 +1,70 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SubsumptiveClause.h
+ *
+ * Defines the subsumptive clause class
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast/Atom.h"
+#include "ast/Clause.h"
+#include "ast/ExecutionPlan.h"
+#include "ast/Literal.h"
+#include "parser/SrcLocation.h"
+#include <iosfwd>
+#include <vector>
+
+namespace souffle::ast {
+
+/**
+ * @class SubsumptiveClause
+ * @brief Intermediate representation of a subsumptive clause
+ *
+ *  A subsumptive clause of the form
+ *
+ *      R(x) <= R(y) :- condition.
+ *
+ * declares a partial order on the tuples of relation R: whenever the
+ * condition holds, the dominated tuple R(x) is deleted from the relation.
+ * The head of the clause is the dominated atom, and by convention the
+ * first two body literals are the dominated and the dominating atom,
+ * in this order, so that grounding and typing of the clause work like
+ * for any other clause. The remaining body literals form the condition.
+ */
+class SubsumptiveClause : public Clause {
+public:
+    SubsumptiveClause(
+            Own<Atom> head, VecOwn<Literal> bodyLiterals, Own<ExecutionPlan> plan = {}, SrcLocation loc = {});
+
+    SubsumptiveClause(Own<Atom> head, SrcLocation loc = {});
+
+    /** Return the dominated atom of the clause */
+    Atom* getDominatedAtom() const {
+        return as<Atom>(getBodyLiterals()[0]);
+    }
+
+    /** Return the dominating atom of the clause */
+    Atom* getDominatingAtom() const {
+        return as<Atom>(getBodyLiterals()[1]);
+    }
+
+    Own<Clause> cloneHead() const override;
+
+protected:
+    void print(std::ostream& os) const override;
+
+private:
+    SubsumptiveClause* cloning() const override;
+};
+
+}  // namespace souffle::ast
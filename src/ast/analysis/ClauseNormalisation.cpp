@@ -39,6 +39,8 @@
 #include <cassert>
 #include <memory>
 #include <ostream>
+#include <set>
+#include <sstream>
 
 namespace souffle::ast::analysis {
 
@@ -55,6 +57,23 @@ NormalisedClause::NormalisedClause(const Clause* clause) {
     for (const auto* lit : clause->getBodyLiterals()) {
         addClauseBodyLiteral("@min:scope:0", lit);
     }
+
+    // fingerprint: a bijection between two clauses preserves the element-name
+    // multiset, the head arity, the variable count and the constant set
+    std::multiset<std::string> elementNames;
+    for (const auto& element : clauseElements) {
+        elementNames.insert(toString(element.name) + "/" + std::to_string(element.params.size()));
+    }
+    std::ostringstream repr;
+    repr << clauseElements.size() << ";" << headVars.size() << ";" << variables.size();
+    for (const auto& elementName : elementNames) {
+        repr << ";" << elementName;
+    }
+    repr << "#";
+    for (const auto& constant : constants) {
+        repr << ";" << constant;
+    }
+    fingerprint = repr.str();
 }
 
 void NormalisedClause::addClauseAtom(
@@ -63,12 +63,19 @@ public:
         return clauseElements;
     }
 
+    /** A cheap equivalence-class key: clauses with different fingerprints
+     * can never be bijectively equivalent. */
+    const std::string& getFingerprint() const {
+        return fingerprint;
+    }
+
 private:
     bool fullyNormalised{true};
     std::size_t aggrScopeCount{0};
     std::set<std::string> variables{};
     std::set<std::string> constants{};
     std::vector<NormalisedClauseElement> clauseElements{};
+    std::string fingerprint{};
 
     /**
      * Parse an atom with a preset name qualifier into the element list.
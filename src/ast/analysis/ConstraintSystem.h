@@ -17,6 +17,8 @@
 #pragma once
 
 #include "souffle/utility/StreamUtil.h"
+#include <cstddef>
+#include <deque>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -294,6 +296,10 @@ class Assignment {
     /** the actual mapping of variables to values */
     data_type data;
 
+    /** an optional log recording every variable looked up, used by the
+     * solver to discover the footprint of a constraint */
+    std::vector<Var>* accessLog = nullptr;
+
 public:
     using iterator = typename data_type::const_iterator;
 
@@ -310,6 +316,9 @@ public:
      * @return a const reference to the associated value
      */
     const value_type& operator[](const Var& var) const {
+        if (accessLog != nullptr) {
+            accessLog->push_back(var);
+        }
         auto pos = data.find(var);
         return (pos != data.end()) ? pos->second : bottom;
     }
@@ -324,6 +333,9 @@ public:
      * @return a mutable reference to the associated value
      */
     value_type& operator[](const Var& var) {
+        if (accessLog != nullptr) {
+            accessLog->push_back(var);
+        }
         auto pos = data.find(var);
         if (pos == data.end()) {
             return data[var] = bottom;
@@ -331,6 +343,15 @@ public:
         return pos->second;
     }
 
+    /**
+     * Installs (or, given nullptr, removes) a log recording each variable
+     * looked up through this assignment. The solver uses it to learn which
+     * variables a constraint touches.
+     */
+    void setAccessLog(std::vector<Var>* log) {
+        accessLog = log;
+    }
+
     /** Adds print support */
     void print(std::ostream& out) const {
         out << data;
@@ -394,18 +415,59 @@ public:
      * Computes a solution (minimum fixpoint) for the contained list of
      * constraints based on an initial assignment.
      *
+     * A worklist algorithm: a constraint is only re-fired when a variable it
+     * touches may have changed since its last evaluation. The footprint of
+     * each constraint is discovered - and kept up to date, as conditional
+     * reads may surface late - by logging the variables accessed during each
+     * evaluation.
+     *
      * @return an assignment representing a solution for this problem
      */
     Assignment<Var>& solve(Assignment<Var>& assignment) const {
-        // this is the most naive version of a solver, but sound and complete
-        bool change = true;
-        while (change) {
-            change = false;
-            for (const auto& constraint : constraints) {
-                change |= constraint->update(assignment);
+        // maps each variable to the constraints whose footprint contains it
+        std::map<Var, std::vector<std::size_t>> dependents;
+        std::vector<std::set<Var>> footprint(constraints.size());
+
+        // initially every constraint has to be evaluated once
+        std::deque<std::size_t> worklist;
+        std::vector<bool> queued(constraints.size(), true);
+        for (std::size_t i = 0; i < constraints.size(); ++i) {
+            worklist.push_back(i);
+        }
+
+        std::vector<Var> accessed;
+        while (!worklist.empty()) {
+            const std::size_t index = worklist.front();
+            worklist.pop_front();
+            queued[index] = false;
+
+            accessed.clear();
+            assignment.setAccessLog(&accessed);
+            const bool changed = constraints[index]->update(assignment);
+            assignment.setAccessLog(nullptr);
+
+            // merge newly observed variables into the constraint's footprint
+            for (const auto& var : accessed) {
+                if (footprint[index].insert(var).second) {
+                    dependents[var].push_back(index);
+                }
+            }
+            if (!changed) {
+                continue;
+            }
+
+            // re-fire every constraint sharing a variable; the update
+            // interface does not reveal which of the accessed variables
+            // were actually altered, so all of them are treated as such
+            for (const auto& var : footprint[index]) {
+                for (const auto dependent : dependents[var]) {
+                    if (!queued[dependent]) {
+                        queued[dependent] = true;
+                        worklist.push_back(dependent);
+                    }
+                }
             }
         }
-        // already done
         return assignment;
     }
 
@@ -59,4 +59,15 @@ std::size_t ProfileUseAnalysis::getRelationSize(const QualifiedName& rel) const
     }
 }
 
+/**
+ * Get number of tuples read from relation from profile
+ */
+std::size_t ProfileUseAnalysis::getRelationReads(const QualifiedName& rel) const {
+    if (const auto* profRel = programRun->getRelation(rel.toString())) {
+        return profRel->getReads();
+    } else {
+        return 0;
+    }
+}
+
 }  // namespace souffle::ast::analysis
@@ -53,6 +53,9 @@ public:
     /** Return size of relation in the profile */
     std::size_t getRelationSize(const QualifiedName& rel) const;
 
+    /** Return number of tuples read from relation in the profile */
+    std::size_t getRelationReads(const QualifiedName& rel) const;
+
 private:
     /** performance model of profile run */
     std::shared_ptr<profile::ProgramRun> programRun;
@@ -27,9 +27,13 @@
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace souffle::ast::analysis {
 
@@ -41,31 +45,95 @@ void SCCGraphAnalysis::run(const TranslationUnit& translationUnit) {
     predecessors.clear();
     successors.clear();
 
-    /* Compute SCC */
     Program& program = translationUnit.getProgram();
     std::vector<Relation*> relations = program.getRelations();
+    const std::size_t numVertices = relations.size();
+    constexpr std::size_t unassigned = (std::size_t)-1;
+
+    /* Assign dense vertex ids in relation order and flatten the predecessor
+     * edges of the precedence graph into a compressed sparse row array; the
+     * SCC computation below then works on plain integers rather than chasing
+     * pointer-keyed set nodes, which dominates once component expansion
+     * produces tens of thousands of relations. */
+    std::map<const Relation*, std::size_t> vertexId;
+    for (std::size_t i = 0; i < numVertices; i++) {
+        vertexId[relations[i]] = i;
+    }
+    std::vector<std::size_t> offsets(numVertices + 1, 0);
+    for (std::size_t i = 0; i < numVertices; i++) {
+        offsets[i + 1] = offsets[i] + precedenceGraph->graph().predecessors(relations[i]).size();
+    }
+    std::vector<std::size_t> edges(offsets[numVertices]);
+    for (std::size_t i = 0; i < numVertices; i++) {
+        std::size_t pos = offsets[i];
+        for (const Relation* pred : precedenceGraph->graph().predecessors(relations[i])) {
+            edges[pos++] = vertexId.at(pred);
+        }
+    }
+
+    /* Compute strongly connected components using Gabow's algorithm (cf.
+     * Algorithms in Java by Robert Sedgewick / Part 5 / Graph algorithms).
+     * The algorithm has linear runtime; the depth-first search is driven by
+     * an explicit frame stack so deep programs cannot overflow the call
+     * stack. */
     std::size_t counter = 0;
     std::size_t numSCCs = 0;
-    std::stack<const Relation*> S;
-    std::stack<const Relation*> P;
-    std::map<const Relation*, std::size_t> preOrder;  // Pre-order number of a node (for Gabow's Algo)
-    for (const Relation* relation : relations) {
-        relationToScc[relation] = preOrder[relation] = (std::size_t)-1;
-    }
-    for (const Relation* relation : relations) {
-        if (preOrder[relation] == (std::size_t)-1) {
-            scR(relation, preOrder, counter, S, P, numSCCs);
+    std::vector<std::size_t> preOrder(numVertices, unassigned);
+    std::vector<std::size_t> vertexToScc(numVertices, unassigned);
+    std::vector<std::size_t> S;
+    std::vector<std::size_t> P;
+    std::vector<std::pair<std::size_t, std::size_t>> frames;  // (vertex, next edge position)
+    for (std::size_t root = 0; root < numVertices; root++) {
+        if (preOrder[root] != unassigned) {
+            continue;
         }
+        preOrder[root] = counter++;
+        S.push_back(root);
+        P.push_back(root);
+        frames.emplace_back(root, offsets[root]);
+        while (!frames.empty()) {
+            const std::size_t w = frames.back().first;
+            std::size_t& edge = frames.back().second;
+            if (edge < offsets[w + 1]) {
+                const std::size_t t = edges[edge];
+                ++edge;
+                if (preOrder[t] == unassigned) {
+                    preOrder[t] = counter++;
+                    S.push_back(t);
+                    P.push_back(t);
+                    frames.emplace_back(t, offsets[t]);
+                } else if (vertexToScc[t] == unassigned) {
+                    while (preOrder[P.back()] > preOrder[t]) {
+                        P.pop_back();
+                    }
+                }
+            } else {
+                if (P.back() == w) {
+                    P.pop_back();
+                    std::size_t v;
+                    do {
+                        v = S.back();
+                        S.pop_back();
+                        vertexToScc[v] = numSCCs;
+                    } while (v != w);
+                    numSCCs++;
+                }
+                frames.pop_back();
+            }
+        }
+    }
+    for (std::size_t i = 0; i < numVertices; i++) {
+        relationToScc[relations[i]] = vertexToScc[i];
     }
 
     /* Build SCC graph */
     successors.resize(numSCCs);
     predecessors.resize(numSCCs);
-    for (const Relation* u : relations) {
-        for (const Relation* v : precedenceGraph->graph().predecessors(u)) {
-            auto scc_u = relationToScc[u];
-            auto scc_v = relationToScc[v];
-            assert(scc_u < numSCCs && "Wrong range");
+    for (std::size_t u = 0; u < numVertices; u++) {
+        const auto scc_u = vertexToScc[u];
+        assert(scc_u < numSCCs && "Wrong range");
+        for (std::size_t pos = offsets[u]; pos < offsets[u + 1]; pos++) {
+            const auto scc_v = vertexToScc[edges[pos]];
             assert(scc_v < numSCCs && "Wrong range");
             if (scc_u != scc_v) {
                 predecessors[scc_u].insert(scc_v);
@@ -81,39 +149,6 @@ void SCCGraphAnalysis::run(const TranslationUnit& translationUnit) {
     }
 }
 
-/* Compute strongly connected components using Gabow's algorithm (cf. Algorithms in
- * Java by Robert Sedgewick / Part 5 / Graph *  algorithms). The algorithm has linear
- * runtime. */
-void SCCGraphAnalysis::scR(const Relation* w, std::map<const Relation*, std::size_t>& preOrder,
-        std::size_t& counter, std::stack<const Relation*>& S, std::stack<const Relation*>& P,
-        std::size_t& numSCCs) {
-    preOrder[w] = counter++;
-    S.push(w);
-    P.push(w);
-    for (const Relation* t : precedenceGraph->graph().predecessors(w)) {
-        if (preOrder[t] == (std::size_t)-1) {
-            scR(t, preOrder, counter, S, P, numSCCs);
-        } else if (relationToScc[t] == (std::size_t)-1) {
-            while (preOrder[P.top()] > preOrder[t]) {
-                P.pop();
-            }
-        }
-    }
-    if (P.top() == w) {
-        P.pop();
-    } else {
-        return;
-    }
-
-    const Relation* v;
-    do {
-        v = S.top();
-        S.pop();
-        relationToScc[v] = numSCCs;
-    } while (v != w);
-    numSCCs++;
-}
-
 void SCCGraphAnalysis::printRaw(std::stringstream& ss) const {
     const std::string& name = Global::config().get("name");
     /* Print SCC graph */
@@ -26,7 +26,6 @@
 #include <cstddef>
 #include <map>
 #include <set>
-#include <stack>
 #include <string>
 #include <vector>
 
@@ -223,10 +222,6 @@ private:
     /** Relations contained in a SCC */
     std::vector<std::set<const Relation*>> sccToRelation;
 
-    /** Recursive scR method for computing SCC */
-    void scR(const Relation* relation, std::map<const Relation*, std::size_t>& preOrder, std::size_t& counter,
-            std::stack<const Relation*>& S, std::stack<const Relation*>& P, std::size_t& numSCCs);
-
     IOTypeAnalysis* ioType = nullptr;
 
     /** Print the SCC graph to a string. */
@@ -479,6 +479,10 @@ void TypeAnalysis::run(const TranslationUnit& translationUnit) {
     typeEnv = &translationUnit.getAnalysis<TypeEnvironmentAnalysis>().getTypeEnvironment();
     functorAnalysis = &translationUnit.getAnalysis<FunctorAnalysis>();
 
+    // force the remaining analyses consulted per clause, so that the
+    // concurrent lookups below are plain cache hits
+    translationUnit.getAnalysis<SumTypeBranchesAnalysis>();
+
     // Analyse user-defined functor types
     const Program& program = translationUnit.getProgram();
 
@@ -488,12 +492,27 @@ void TypeAnalysis::run(const TranslationUnit& translationUnit) {
         changed = false;
         argumentTypes.clear();
 
-        // Analyse general argument types, clause by clause.
-        for (const Clause* clause : program.getClauses()) {
-            auto clauseArgumentTypes = analyseTypes(translationUnit, *clause, debugStream);
-            argumentTypes.insert(clauseArgumentTypes.begin(), clauseArgumentTypes.end());
+        // Analyse general argument types, clause by clause. The per-clause
+        // constraint systems are independent of each other and thus solved
+        // in parallel; the serial path is kept when analysis logs are
+        // collected, as these interleave otherwise.
+        const auto& clauses = program.getClauses();
+        if (debugStream == nullptr) {
+            std::vector<std::map<const Argument*, TypeSet>> clauseTypes(clauses.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (std::size_t i = 0; i < clauses.size(); i++) {
+                clauseTypes[i] = analyseTypes(translationUnit, *clauses[i], nullptr);
+            }
+            for (auto& clauseArgumentTypes : clauseTypes) {
+                argumentTypes.insert(clauseArgumentTypes.begin(), clauseArgumentTypes.end());
+            }
+        } else {
+            for (const Clause* clause : clauses) {
+                auto clauseArgumentTypes = analyseTypes(translationUnit, *clause, debugStream);
+                argumentTypes.insert(clauseArgumentTypes.begin(), clauseArgumentTypes.end());
 
-            if (debugStream != nullptr) {
                 // Store an annotated clause for printing purposes
                 annotatedClauses.emplace_back(createAnnotatedClause(clause, clauseArgumentTypes));
             }
@@ -234,6 +234,11 @@ void TypeConstraintsAnalysis::visit_(type_identity<BranchInit>, const BranchInit
 void TypeConstraintsAnalysis::visit_(type_identity<Aggregator>, const Aggregator& agg) {
     if (agg.getBaseOperator() == AggregateOp::COUNT) {
         addConstraint(isSubtypeOf(getVar(agg), typeEnv.getConstantType(TypeAttribute::Signed)));
+    } else if (agg.getBaseOperator() == AggregateOp::COUNTD) {
+        addConstraint(isSubtypeOf(getVar(agg), typeEnv.getConstantType(TypeAttribute::Signed)));
+        // the counted expression may be of any type; it is typed by the
+        // aggregate body rather than by the aggregate's own value
+        return;
     } else if (agg.getBaseOperator() == AggregateOp::MEAN) {
         addConstraint(isSubtypeOf(getVar(agg), typeEnv.getConstantType(TypeAttribute::Float)));
     } else {
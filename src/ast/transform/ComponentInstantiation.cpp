@@ -41,6 +41,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <sstream>
 #include <utility>
 #include <vector>
 
@@ -118,14 +119,44 @@ struct ComponentContent {
     }
 };
 
+/**
+ * A per-run cache of expanded component content, keyed by the component, its
+ * enclosing scope and the actual type parameters. Repeated instantiations of
+ * the same component reuse the expansion and only redo the instance-name
+ * prefixing.
+ */
+struct InstantiationCacheEntry {
+    ComponentContent content;
+    VecOwn<Clause> orphans;
+};
+using InstantiationCache = std::map<std::string, InstantiationCacheEntry>;
+
+/** Deep copy of an instantiated component's content. */
+ComponentContent cloneContent(const ComponentContent& content) {
+    ComponentContent copy;
+    for (const auto& cur : content.types) {
+        copy.types.push_back(clone(cur));
+    }
+    for (const auto& cur : content.relations) {
+        copy.relations.push_back(clone(cur));
+    }
+    for (const auto& cur : content.directives) {
+        copy.directives.push_back(clone(cur));
+    }
+    for (const auto& cur : content.clauses) {
+        copy.clauses.push_back(clone(cur));
+    }
+    return copy;
+}
+
 /**
  * Recursively computes the set of relations (and included clauses) introduced
  * by this init statement enclosed within the given scope.
  */
 ComponentContent getInstantiatedContent(Program& program, const ComponentInit& componentInit,
         const Component* enclosingComponent, const ComponentLookupAnalysis& componentLookup,
-        VecOwn<Clause>& orphans, ErrorReport& report, const TypeBinding& binding = analysis::TypeBinding(),
-        unsigned int maxDepth = MAX_INSTANTIATION_DEPTH);
+        VecOwn<Clause>& orphans, ErrorReport& report, InstantiationCache& cache,
+        const TypeBinding& binding = analysis::TypeBinding(), unsigned int maxDepth = MAX_INSTANTIATION_DEPTH);
 
 /**
  * Collects clones of all the content in the given component and its base components.
@@ -133,7 +164,7 @@ ComponentContent getInstantiatedContent(Program& program, const ComponentInit& c
 void collectContent(Program& program, const Component& component, const TypeBinding& binding,
         const Component* enclosingComponent, const ComponentLookupAnalysis& componentLookup,
         ComponentContent& res, VecOwn<Clause>& orphans, const std::set<std::string>& overridden,
-        ErrorReport& report, unsigned int maxInstantiationDepth) {
+        ErrorReport& report, InstantiationCache& cache, unsigned int maxInstantiationDepth) {
     // start with relations and clauses of the base components
     for (const auto& base : component.getBaseComponents()) {
         const Component* comp = componentLookup.getComponent(enclosingComponent, base->getName(), binding);
@@ -148,7 +179,7 @@ void collectContent(Program& program, const Component& component, const TypeBind
             for (const auto& cur : comp->getInstantiations()) {
                 // instantiate sub-component
                 ComponentContent content = getInstantiatedContent(program, *cur, enclosingComponent,
-                        componentLookup, orphans, report, activeBinding, maxInstantiationDepth - 1);
+                        componentLookup, orphans, report, cache, activeBinding, maxInstantiationDepth - 1);
 
                 // process types
                 for (auto& type : content.types) {
@@ -176,7 +207,7 @@ void collectContent(Program& program, const Component& component, const TypeBind
             superOverridden.insert(overridden.begin(), overridden.end());
             superOverridden.insert(component.getOverridden().begin(), component.getOverridden().end());
             collectContent(program, *comp, activeBinding, comp, componentLookup, res, orphans,
-                    superOverridden, report, maxInstantiationDepth);
+                    superOverridden, report, cache, maxInstantiationDepth);
         }
     }
 
@@ -311,7 +342,8 @@ void collectContent(Program& program, const Component& component, const TypeBind
 
 ComponentContent getInstantiatedContent(Program& program, const ComponentInit& componentInit,
         const Component* enclosingComponent, const ComponentLookupAnalysis& componentLookup,
-        VecOwn<Clause>& orphans, ErrorReport& report, const TypeBinding& binding, unsigned int maxDepth) {
+        VecOwn<Clause>& orphans, ErrorReport& report, InstantiationCache& cache, const TypeBinding& binding,
+        unsigned int maxDepth) {
     // start with an empty list
     ComponentContent res;
 
@@ -333,38 +365,70 @@ ComponentContent getInstantiatedContent(Program& program, const ComponentInit& c
     const auto& actualParams = componentInit.getComponentType()->getTypeParameters();
     TypeBinding activeBinding = binding.extend(formalParams, actualParams);
 
-    // instantiated nested components
-    for (const auto& cur : component->getInstantiations()) {
-        // get nested content
-        ComponentContent nestedContent = getInstantiatedContent(
-                program, *cur, component, componentLookup, orphans, report, activeBinding, maxDepth - 1);
+    // the expansion below this point only depends on the component, its
+    // enclosing scope and the resolved type parameters, not on the instance
+    // name; reuse a previous expansion of the same key if there is one
+    std::ostringstream keyStream;
+    keyStream << component << ";" << enclosingComponent;
+    for (const auto& param : formalParams) {
+        keyStream << ";" << activeBinding.find(param);
+    }
+    const std::string cacheKey = keyStream.str();
 
-        // add types
-        for (auto& type : nestedContent.types) {
-            res.add(type, report);
+    auto cached = cache.find(cacheKey);
+    if (cached != cache.end()) {
+        res = cloneContent(cached->second.content);
+        for (const auto& orphan : cached->second.orphans) {
+            orphans.push_back(clone(orphan));
         }
+    } else {
+        const unsigned errorsBefore = report.getNumErrors();
+        const std::size_t orphansBefore = orphans.size();
+
+        // instantiated nested components
+        for (const auto& cur : component->getInstantiations()) {
+            // get nested content
+            ComponentContent nestedContent = getInstantiatedContent(
+                    program, *cur, component, componentLookup, orphans, report, cache, activeBinding,
+                    maxDepth - 1);
+
+            // add types
+            for (auto& type : nestedContent.types) {
+                res.add(type, report);
+            }
 
-        // add relations
-        for (auto& rel : nestedContent.relations) {
-            res.add(rel, report);
-        }
+            // add relations
+            for (auto& rel : nestedContent.relations) {
+                res.add(rel, report);
+            }
 
-        // add clauses
-        for (auto& clause : nestedContent.clauses) {
-            res.add(clause, report);
+            // add clauses
+            for (auto& clause : nestedContent.clauses) {
+                res.add(clause, report);
+            }
+
+            // add directives
+            for (auto& directive : nestedContent.directives) {
+                res.add(directive, report);
+            }
         }
 
-        // add directives
-        for (auto& directive : nestedContent.directives) {
-            res.add(directive, report);
+        // collect all content in this component
+        std::set<std::string> overridden;
+        collectContent(program, *component, activeBinding, enclosingComponent, componentLookup, res, orphans,
+                overridden, report, cache, maxDepth);
+
+        // only successful expansions are reusable
+        if (report.getNumErrors() == errorsBefore) {
+            InstantiationCacheEntry entry;
+            entry.content = cloneContent(res);
+            for (std::size_t i = orphansBefore; i < orphans.size(); i++) {
+                entry.orphans.push_back(clone(orphans[i]));
+            }
+            cache.emplace(cacheKey, std::move(entry));
         }
     }
 
-    // collect all content in this component
-    std::set<std::string> overridden;
-    collectContent(program, *component, activeBinding, enclosingComponent, componentLookup, res, orphans,
-            overridden, report, maxDepth);
-
     // update user-defined type names
     std::map<QualifiedName, QualifiedName> typeNameMapping;
     for (const auto& cur : res.types) {
@@ -522,10 +586,11 @@ bool ComponentInstantiationTransformer::transform(TranslationUnit& translationUn
 
     auto& componentLookup = translationUnit.getAnalysis<ComponentLookupAnalysis>();
 
+    InstantiationCache cache;
     for (const auto* cur : program.getComponentInstantiations()) {
         VecOwn<Clause> orphans;
 
-        auto content = getInstantiatedContent(program, *cur, nullptr, componentLookup, orphans, report);
+        auto content = getInstantiatedContent(program, *cur, nullptr, componentLookup, orphans, report, cache);
         if (report.getNumErrors() != 0) continue;
 
         for (auto& type : content.types) {
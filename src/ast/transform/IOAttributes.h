@@ -17,15 +17,24 @@
 
 #pragma once
 
+#include "Global.h"
+#include "ast/Aggregator.h"
 #include "ast/AlgebraicDataType.h"
+#include "ast/Atom.h"
 #include "ast/Attribute.h"
+#include "ast/Clause.h"
+#include "ast/Constant.h"
 #include "ast/Directive.h"
+#include "ast/NumericConstant.h"
+#include "ast/StringConstant.h"
 #include "ast/Program.h"
 #include "ast/QualifiedName.h"
 #include "ast/RecordType.h"
 #include "ast/Relation.h"
 #include "ast/TranslationUnit.h"
 #include "ast/Type.h"
+#include "ast/UnnamedVariable.h"
+#include "ast/Variable.h"
 #include "ast/analysis/typesystem/TypeEnvironment.h"
 #include "ast/analysis/typesystem/TypeSystem.h"
 #include "ast/transform/Transformer.h"
@@ -38,6 +47,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <map>
+#include <set>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -65,10 +75,188 @@ private:
         changed |= setAttributeNames(translationUnit);
         changed |= setAttributeTypes(translationUnit);
         changed |= setAttributeParams(translationUnit);
+        changed |= setDeadColumns(translationUnit);
+        changed |= setConstantFilters(translationUnit);
 
         return changed;
     }
 
+    /**
+     * Pushes constant filters into input directives: when every occurrence of
+     * an input relation in a rule body places the same constant on an
+     * attribute, rows without that constant can never participate in any rule
+     * and the reader drops them at parse time, before interning and
+     * insertion. Relations that are stored or appear in a rule head keep
+     * their full content.
+     */
+    bool setConstantFilters(TranslationUnit& translationUnit) {
+        // provenance needs the unfiltered relations to explain derivations
+        if (Global::config().has("provenance")) {
+            return false;
+        }
+        bool changed = false;
+        Program& program = translationUnit.getProgram();
+
+        // relations whose full content is observable
+        std::set<QualifiedName> keepAll;
+        for (Directive* io : program.getDirectives()) {
+            if (io->getType() != ast::DirectiveType::input) {
+                keepAll.insert(io->getQualifiedName());
+            }
+        }
+        for (const Clause* clause : program.getClauses()) {
+            keepAll.insert(clause->getHead()->getQualifiedName());
+        }
+
+        // the constant each attribute carries in every body occurrence so far;
+        // an attribute drops out once an occurrence disagrees
+        struct AttributeConstant {
+            bool eligible = true;
+            Own<Constant> value;
+        };
+        std::map<QualifiedName, std::vector<AttributeConstant>> candidates;
+        visit(program, [&](const Clause& clause) {
+            visit(clause, [&](const Atom& atom) {
+                if (&atom == clause.getHead()) {
+                    return;
+                }
+                const auto& args = atom.getArguments();
+                auto entry = candidates.find(atom.getQualifiedName());
+                if (entry == candidates.end()) {
+                    auto& attributes = candidates[atom.getQualifiedName()];
+                    attributes.resize(args.size());
+                    for (std::size_t i = 0; i < args.size(); ++i) {
+                        if (isA<StringConstant>(args[i]) || isA<NumericConstant>(args[i])) {
+                            attributes[i].value = clone(as<Constant>(args[i]));
+                        } else {
+                            attributes[i].eligible = false;
+                        }
+                    }
+                    return;
+                }
+                auto& attributes = entry->second;
+                for (std::size_t i = 0; i < attributes.size(); ++i) {
+                    if (!attributes[i].eligible) {
+                        continue;
+                    }
+                    if (i >= args.size() || *args[i] != *attributes[i].value) {
+                        attributes[i].eligible = false;
+                    }
+                }
+            });
+        });
+
+        for (Directive* io : program.getDirectives()) {
+            if (io->getType() != ast::DirectiveType::input || io->hasParameter("constant-filters") ||
+                    keepAll.count(io->getQualifiedName()) != 0) {
+                continue;
+            }
+            auto entry = candidates.find(io->getQualifiedName());
+            if (entry == candidates.end()) {
+                continue;
+            }
+            std::map<std::string, json11::Json> filters;
+            for (std::size_t i = 0; i < entry->second.size(); ++i) {
+                const auto& attribute = entry->second[i];
+                if (attribute.eligible) {
+                    filters.emplace(std::to_string(i), attribute.value->getConstant());
+                }
+            }
+            if (filters.empty()) {
+                continue;
+            }
+            io->addParameter("constant-filters", json11::Json(filters).dump());
+            changed = true;
+        }
+        return changed;
+    }
+
+    /**
+     * Marks input columns whose values are never inspected, so that readers
+     * can skip converting and interning them. An attribute is dead when every
+     * occurrence of its relation in a rule body binds it to an anonymous or
+     * otherwise unused variable. Relations that are stored, appear in a rule
+     * head or are enumerated under an aggregate keep all their columns: dead
+     * columns load as zero, which collapses tuples differing only in them,
+     * and those uses would observe the difference.
+     */
+    bool setDeadColumns(TranslationUnit& translationUnit) {
+        // provenance instruments relations with extra columns; leave it alone
+        if (Global::config().has("provenance")) {
+            return false;
+        }
+        bool changed = false;
+        Program& program = translationUnit.getProgram();
+
+        // relations whose tuples are constructed or counted keep all columns
+        std::set<QualifiedName> keepAll;
+        for (Directive* io : program.getDirectives()) {
+            if (io->getType() != ast::DirectiveType::input) {
+                keepAll.insert(io->getQualifiedName());
+            }
+        }
+        for (const Clause* clause : program.getClauses()) {
+            keepAll.insert(clause->getHead()->getQualifiedName());
+        }
+        visit(program, [&](const Aggregator& aggregator) {
+            visit(aggregator, [&](const Atom& atom) { keepAll.insert(atom.getQualifiedName()); });
+        });
+
+        // per-relation attribute liveness over all body occurrences
+        std::map<QualifiedName, std::vector<bool>> live;
+        visit(program, [&](const Clause& clause) {
+            // an argument variable occurring once in its clause is never inspected
+            std::map<std::string, int> uses;
+            visit(clause, [&](const ast::Variable& var) { ++uses[var.getName()]; });
+            visit(clause, [&](const Atom& atom) {
+                if (&atom == clause.getHead()) {
+                    return;
+                }
+                const auto& args = atom.getArguments();
+                auto& flags = live[atom.getQualifiedName()];
+                if (flags.size() < args.size()) {
+                    flags.resize(args.size(), false);
+                }
+                for (std::size_t i = 0; i < args.size(); ++i) {
+                    const Argument* arg = args[i];
+                    if (isA<UnnamedVariable>(arg)) {
+                        continue;
+                    }
+                    if (const auto* var = as<ast::Variable>(arg)) {
+                        if (uses[var->getName()] == 1) {
+                            continue;
+                        }
+                    }
+                    flags[i] = true;
+                }
+            });
+        });
+
+        for (Directive* io : program.getDirectives()) {
+            if (io->getType() != ast::DirectiveType::input || io->hasParameter("dead-columns") ||
+                    keepAll.count(io->getQualifiedName()) != 0) {
+                continue;
+            }
+            Relation* rel = getRelation(program, io->getQualifiedName());
+            if (rel == nullptr || rel->getArity() == 0) {
+                continue;
+            }
+            const auto& flags = live[io->getQualifiedName()];
+            std::vector<std::string> dead;
+            for (std::size_t i = 0; i < rel->getArity(); ++i) {
+                if (i >= flags.size() || !flags[i]) {
+                    dead.push_back(std::to_string(i));
+                }
+            }
+            if (dead.empty()) {
+                continue;
+            }
+            io->addParameter("dead-columns", toString(join(dead, ":")));
+            changed = true;
+        }
+        return changed;
+    }
+
     bool setAttributeParams(TranslationUnit& translationUnit) {
         bool changed = false;
         Program& program = translationUnit.getProgram();
@@ -0,0 +1,110 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file IncrementalCheckpoint.h
+ *
+ * Defines AST transformation to checkpoint relation states for
+ * incremental evaluation.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "Global.h"
+#include "ast/Aggregator.h"
+#include "ast/Directive.h"
+#include "ast/Negation.h"
+#include "ast/Program.h"
+#include "ast/QualifiedName.h"
+#include "ast/Relation.h"
+#include "ast/TranslationUnit.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/transform/Transformer.h"
+#include "ast/utility/Visitor.h"
+#include "reports/ErrorReport.h"
+#include "souffle/utility/StringUtil.h"
+#include <string>
+
+namespace souffle::ast::transform {
+
+/**
+ * Transformation pass to checkpoint relation states for incremental evaluation.
+ *
+ * When an incremental directory is configured, every relation in a recursive
+ * stratum receives an additional store directive writing its final state into
+ * that directory. A later run restores these checkpoints and seeds the
+ * semi-naive deltas with the difference to the previous fixpoint only, so
+ * unchanged derivations are not recomputed (see the semi-naive unit
+ * translator). The mode is insertion-only: fact deletions require a full
+ * re-evaluation from scratch.
+ */
+class IncrementalCheckpointTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "IncrementalCheckpointTransformer";
+    }
+
+private:
+    IncrementalCheckpointTransformer* cloning() const override {
+        return new IncrementalCheckpointTransformer();
+    }
+
+    bool transform(TranslationUnit& translationUnit) override {
+        if (!Global::config().has("incremental-dir")) {
+            return false;
+        }
+        // Provenance maintains auxiliary columns the checkpoint format does
+        // not cover.
+        if (Global::config().has("provenance")) {
+            return false;
+        }
+
+        const std::string dir = Global::config().get("incremental-dir");
+        Program& program = translationUnit.getProgram();
+        const auto& sccGraph = translationUnit.getAnalysis<analysis::SCCGraphAnalysis>();
+
+        bool changed = false;
+        for (Relation* rel : program.getRelations()) {
+            // Only relations computed by a fixpoint benefit from a warm start;
+            // non-recursive strata are recomputed either way.
+            if (!sccGraph.isRecursive(sccGraph.getSCC(rel))) {
+                continue;
+            }
+            const std::string name = toString(rel->getQualifiedName());
+            auto directive = mk<Directive>(DirectiveType::output, rel->getQualifiedName());
+            directive->addParameter("IO", "file");
+            directive->addParameter("operation", "output");
+            directive->addParameter("name", name);
+            directive->addParameter("filename", dir + "/" + name + ".facts");
+            directive->addParameter("incremental-checkpoint", "true");
+            program.addDirective(std::move(directive));
+            changed = true;
+        }
+
+        // Restoring a fixpoint is only sound for monotone programs; flag
+        // constructs that can invalidate previously derived tuples.
+        bool warned = false;
+        auto warn = [&](const SrcLocation& loc) {
+            if (!warned) {
+                translationUnit.getErrorReport().addWarning(
+                        "Incremental evaluation is insertion-only and may be unsound for programs "
+                        "with negation or aggregation",
+                        loc);
+                warned = true;
+            }
+        };
+        visit(program, [&](const Negation& neg) { warn(neg.getSrcLoc()); });
+        visit(program, [&](const Aggregator& agg) { warn(agg.getSrcLoc()); });
+
+        return changed;
+    }
+};
+
+}  // namespace souffle::ast::transform
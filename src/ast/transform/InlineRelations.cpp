@@ -50,6 +50,8 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <functional>
+#include <map>
 #include <memory>
 #include <optional>
 #include <ostream>
@@ -634,14 +636,15 @@ NullableVector<Argument*> getInlinedArgument(Program& program, const Argument* a
                             case AggregateOp::FSUM:
                             case AggregateOp::USUM:
                             case AggregateOp::COUNT: return "+";
-                            case AggregateOp::MEAN: fatal("no translation");
+                            case AggregateOp::MEAN:
+                            case AggregateOp::COUNTD: fatal("no translation");
                         }
 
                         UNREACHABLE_BAD_CASE_ANALYSIS
                     };
                     // Create the actual overall aggregator that ties the replacement aggregators together.
                     // example: min x : { a(x) }. <=> min ( min x : { a1(x) }, min x : { a2(x) }, ... )
-                    if (op != AggregateOp::MEAN) {
+                    if (op != AggregateOp::MEAN && op != AggregateOp::COUNTD) {
                         versions.push_back(combineAggregators(aggrVersions, aggregateToFunctor(op)));
                     }
                 }
@@ -1018,6 +1021,133 @@ std::vector<Clause*> getInlinedClause(Program& program, const Clause& clause) {
     }
 }
 
+/**
+ * Estimates the clause blowup that full inlining would cause and demotes
+ * inline-marked relations until the estimate fits the configured budget.
+ * Inlining an atom multiplies its clause by the number of clauses the atom's
+ * relation unfolds into, so deep inline chains grow multiplicatively.
+ * Relations are demoted largest estimated blowup first; among comparable
+ * blowups the relation whose call sites carry the fewest constant arguments
+ * goes first, as its specialised clauses profit the least. Demotion is
+ * always sound - the relation is simply materialised as usual.
+ */
+bool enforceInlineBudget(Program& program) {
+    std::size_t budget = 50000;
+    if (Global::config().has("inline-budget")) {
+        budget = std::stoul(Global::config().get("inline-budget"));
+    }
+    // a zero budget inlines unconditionally
+    if (budget == 0) {
+        return false;
+    }
+
+    bool changed = false;
+    while (true) {
+        // relations currently marked for inlining
+        std::set<QualifiedName> inlined;
+        for (Relation* rel : program.getRelations()) {
+            if (rel->hasQualifier(RelationQualifier::INLINE)) {
+                inlined.insert(rel->getQualifiedName());
+            }
+        }
+        if (inlined.empty()) {
+            return changed;
+        }
+
+        // expansion(R): estimated number of clauses an atom of R unfolds into
+        // when fully inlined; memoised recursion, terminating since inlined
+        // relations may not depend on each other cyclically
+        std::map<QualifiedName, double> expansion;
+        std::function<double(const QualifiedName&)> expansionOf = [&](const QualifiedName& name) -> double {
+            auto it = expansion.find(name);
+            if (it != expansion.end()) {
+                return it->second;
+            }
+            // guard against revisits while the value is being computed
+            expansion[name] = 1.0;
+            double total = 0.0;
+            for (Clause* clause : getClauses(program, name)) {
+                double versions = 1.0;
+                visit(*clause, [&](const Atom& atom) {
+                    if (&atom != clause->getHead() && contains(inlined, atom.getQualifiedName())) {
+                        versions *= expansionOf(atom.getQualifiedName());
+                    }
+                });
+                total += versions;
+            }
+            expansion[name] = std::max(total, 1.0);
+            return expansion[name];
+        };
+
+        // estimate the post-inline clause count of the program
+        double estimate = 0.0;
+        for (Relation* rel : program.getRelations()) {
+            if (contains(inlined, rel->getQualifiedName())) {
+                continue;
+            }
+            for (Clause* clause : getClauses(program, *rel)) {
+                double versions = 1.0;
+                visit(*clause, [&](const Atom& atom) {
+                    if (&atom != clause->getHead() && contains(inlined, atom.getQualifiedName())) {
+                        versions *= expansionOf(atom.getQualifiedName());
+                    }
+                });
+                estimate += versions;
+            }
+        }
+        if (estimate <= static_cast<double>(budget)) {
+            return changed;
+        }
+
+        // gather the call sites of each inlined relation along with how many
+        // of their arguments are constant-bound
+        std::map<QualifiedName, std::size_t> occurrences;
+        std::map<QualifiedName, std::pair<std::size_t, std::size_t>> boundArgs;
+        for (Clause* clause : program.getClauses()) {
+            visit(*clause, [&](const Atom& atom) {
+                const auto& name = atom.getQualifiedName();
+                if (&atom == clause->getHead() || !contains(inlined, name)) {
+                    return;
+                }
+                occurrences[name]++;
+                auto& bound = boundArgs[name];
+                for (const Argument* arg : atom.getArguments()) {
+                    if (isA<Constant>(*arg)) {
+                        bound.first++;
+                    }
+                    bound.second++;
+                }
+            });
+        }
+
+        // demote the relation with the largest estimated blowup
+        Relation* victim = nullptr;
+        double victimScore = -1.0;
+        double victimBoundness = 2.0;
+        for (Relation* rel : program.getRelations()) {
+            const auto& name = rel->getQualifiedName();
+            if (!contains(inlined, name)) {
+                continue;
+            }
+            const std::size_t sites = std::max<std::size_t>(occurrences[name], 1);
+            const double score = expansionOf(name) * static_cast<double>(sites);
+            const auto& bound = boundArgs[name];
+            const double boundness =
+                    bound.second == 0 ? 0.0 : static_cast<double>(bound.first) / bound.second;
+            if (victim == nullptr || score > victimScore ||
+                    (score == victimScore && boundness < victimBoundness)) {
+                victim = rel;
+                victimScore = score;
+                victimBoundness = boundness;
+            }
+        }
+        assert(victim != nullptr && "no inline relation left to demote");
+        victim->removeQualifier(RelationQualifier::INLINE);
+        victim->addQualifier(RelationQualifier::NO_INLINE);
+        changed = true;
+    }
+}
+
 ExcludedRelations InlineRelationsTransformer::excluded() {
     ExcludedRelations xs;
     auto addAll = [&](const std::string& name) {
@@ -1034,6 +1164,9 @@ bool InlineRelationsTransformer::transform(TranslationUnit& translationUnit) {
     bool changed = false;
     Program& program = translationUnit.getProgram();
 
+    // Demote inline relations whose expansion would blow the clause budget
+    changed |= enforceInlineBudget(program);
+
     // Replace constants in the head of inlined clauses with (constrained) variables.
     // This is done to simplify atom unification, particularly when negations are involved.
     changed |= normaliseInlinedHeads(program);
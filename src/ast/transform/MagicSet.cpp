@@ -29,6 +29,7 @@
 #include "ast/RecordInit.h"
 #include "ast/Relation.h"
 #include "ast/StringConstant.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/UnnamedVariable.h"
 #include "ast/analysis/IOType.h"
@@ -182,6 +183,13 @@ std::set<QualifiedName> MagicSetTransformer::getWeaklyIgnoredRelations(const Tra
         }
     }
 
+    // - Any relation with subsumptive clauses, as pruning relies on the full tuple set
+    for (auto* clause : program.getClauses()) {
+        if (isA<SubsumptiveClause>(clause)) {
+            weaklyIgnoredRelations.insert(clause->getHead()->getQualifiedName());
+        }
+    }
+
     // - Any atom appearing in a clause containing a counter
     for (auto* clause : program.getClauses()) {
         bool containsCounter = false;
@@ -620,6 +628,43 @@ QualifiedName AdornDatabaseTransformer::getAdornmentID(
     return adornmentID;
 }
 
+std::string AdornDatabaseTransformer::findSubsumingAdornment(
+        const QualifiedName& relName, const std::string& adornmentMarker) const {
+    if (adornmentMarker.empty() || !contains(relationAdornments, relName)) {
+        return adornmentMarker;
+    }
+
+    // A queued adornment subsumes the given one if its bound positions are a subset of
+    // the given bound positions. Prefer the candidate with the most bound positions, so
+    // that the least amount of extra tuples is computed; the marker itself is its own
+    // tightest candidate if it has been queued before.
+    std::string bestMarker = adornmentMarker;
+    std::size_t bestBoundCount = 0;
+    bool foundSubsumer = false;
+    for (const auto& seenMarker : relationAdornments.at(relName)) {
+        if (seenMarker.length() != adornmentMarker.length()) {
+            continue;
+        }
+        bool subsumes = true;
+        std::size_t boundCount = 0;
+        for (std::size_t i = 0; i < seenMarker.length(); i++) {
+            if (seenMarker[i] == 'b') {
+                if (adornmentMarker[i] != 'b') {
+                    subsumes = false;
+                    break;
+                }
+                boundCount++;
+            }
+        }
+        if (subsumes && (!foundSubsumer || boundCount > bestBoundCount)) {
+            bestMarker = seenMarker;
+            bestBoundCount = boundCount;
+            foundSubsumer = true;
+        }
+    }
+    return bestMarker;
+}
+
 Own<Clause> AdornDatabaseTransformer::adornClause(const Clause* clause, const std::string& adornmentMarker) {
     const auto& relName = clause->getHead()->getQualifiedName();
     const auto& headArgs = clause->getHead()->getArguments();
@@ -699,10 +744,13 @@ Own<Clause> AdornDatabaseTransformer::adornClause(const Clause* clause, const st
                 atomAdornment << (variableBindings.isBound(var->getName()) ? "b" : "f");
             }
         }
-        auto currAtomAdornmentID = getAdornmentID(atom->getQualifiedName(), atomAdornment.str());
+        // Reuse a subsuming adornment if one was queued before, so that overlapping
+        // demand patterns of the same relation share one magic set
+        auto atomAdornmentMarker = findSubsumingAdornment(atom->getQualifiedName(), atomAdornment.str());
+        auto currAtomAdornmentID = getAdornmentID(atom->getQualifiedName(), atomAdornmentMarker);
 
         // Add to the ToDo queue if needed
-        queueAdornment(atom->getQualifiedName(), atomAdornment.str());
+        queueAdornment(atom->getQualifiedName(), atomAdornmentMarker);
 
         // Add the adorned version to the clause
         auto adornedBodyAtom = clone(atom);
@@ -27,6 +27,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -242,6 +243,7 @@ private:
 
     std::set<adorned_predicate> headAdornmentsToDo;
     std::set<QualifiedName> headAdornmentsSeen;
+    std::map<QualifiedName, std::set<std::string>> relationAdornments;
 
     VecOwn<Clause> adornedClauses;
     VecOwn<Clause> redundantClauses;
@@ -258,9 +260,20 @@ private:
         if (!contains(headAdornmentsSeen, adornmentID)) {
             headAdornmentsToDo.insert(std::make_pair(relName, adornmentMarker));
             headAdornmentsSeen.insert(adornmentID);
+            relationAdornments[relName].insert(adornmentMarker);
         }
     }
 
+    /**
+     * Find the tightest previously queued adornment of the relation that subsumes the
+     * given one, i.e. whose bound positions form a subset of the given bound positions.
+     * The subsuming version computes a superset of the demanded tuples, so reusing it
+     * shares one magic set between overlapping demand patterns. Returns the given
+     * marker itself if no queued adornment subsumes it.
+     */
+    std::string findSubsumingAdornment(
+            const QualifiedName& relName, const std::string& adornmentMarker) const;
+
     /** Check if any more relations need to be adorned. */
     bool hasAdornmentToProcess() const {
         return !headAdornmentsToDo.empty();
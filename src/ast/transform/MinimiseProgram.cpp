@@ -22,6 +22,7 @@
 #include "ast/Program.h"
 #include "ast/QualifiedName.h"
 #include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/analysis/ClauseNormalisation.h"
 #include "ast/analysis/IOType.h"
@@ -212,6 +213,13 @@ bool MinimiseProgramTransformer::areBijectivelyEquivalent(
         return false;
     }
 
+    // the fingerprint collapses the shape checks below and additionally
+    // rejects pairs whose element-name multisets differ, sparing the
+    // permutation search for almost all inequivalent pairs
+    if (left.getFingerprint() != right.getFingerprint()) {
+        return false;
+    }
+
     // rules must be the same length to be equal
     if (leftElements.size() != rightElements.size()) {
         return false;
@@ -264,6 +272,11 @@ bool MinimiseProgramTransformer::reduceLocallyEquivalentClauses(TranslationUnit&
         std::vector<std::vector<Clause*>> equivalenceClasses;
 
         for (Clause* clause : getClauses(program, *rel)) {
+            // normalisation is blind to the atom roles of a subsumptive clause
+            if (isA<SubsumptiveClause>(clause)) {
+                continue;
+            }
+
             bool added = false;
 
             for (std::vector<Clause*>& eqClass : equivalenceClasses) {
@@ -307,7 +320,9 @@ bool MinimiseProgramTransformer::reduceSingletonRelations(TranslationUnit& trans
     for (Relation* rel : program.getRelations()) {
         if (!ioTypes.isIO(rel) && getClauses(program, *rel).size() == 1) {
             Clause* clause = getClauses(program, *rel)[0];
-            singletonRelationClauses.push_back(clause);
+            if (!isA<SubsumptiveClause>(clause)) {
+                singletonRelationClauses.push_back(clause);
+            }
         }
     }
 
@@ -383,6 +398,10 @@ bool MinimiseProgramTransformer::reduceSingletonRelations(TranslationUnit& trans
 bool MinimiseProgramTransformer::removeRedundantClauses(TranslationUnit& translationUnit) {
     Program& program = translationUnit.getProgram();
     auto isRedundant = [&](const Clause* clause) {
+        // the head of a subsumptive clause repeats its first body atom by construction
+        if (isA<SubsumptiveClause>(clause)) {
+            return false;
+        }
         const auto* head = clause->getHead();
         for (const auto* lit : clause->getBodyLiterals()) {
             if (*head == *lit) {
@@ -411,11 +430,20 @@ bool MinimiseProgramTransformer::reduceClauseBodies(TranslationUnit& translation
     std::set<Own<Clause>> clausesToRemove;
 
     for (const auto* clause : program.getClauses()) {
+        if (isA<SubsumptiveClause>(clause)) {
+            continue;
+        }
         auto bodyLiterals = clause->getBodyLiterals();
+        // memoise the structural hash of every literal up front, so the
+        // quadratic scan below only walks subtrees on hash collisions
+        std::vector<std::size_t> literalHashes(bodyLiterals.size());
+        for (std::size_t i = 0; i < bodyLiterals.size(); i++) {
+            literalHashes[i] = bodyLiterals[i]->getStructuralHash();
+        }
         std::set<std::size_t> redundantPositions;
         for (std::size_t i = 0; i < bodyLiterals.size(); i++) {
             for (std::size_t j = 0; j < i; j++) {
-                if (*bodyLiterals[i] == *bodyLiterals[j]) {
+                if (literalHashes[i] == literalHashes[j] && *bodyLiterals[i] == *bodyLiterals[j]) {
                     redundantPositions.insert(j);
                     break;
                 }
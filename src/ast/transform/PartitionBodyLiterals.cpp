@@ -20,6 +20,7 @@
 #include "ast/Program.h"
 #include "ast/QualifiedName.h"
 #include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/Variable.h"
 #include "ast/utility/Visitor.h"
@@ -66,6 +67,11 @@ bool PartitionBodyLiteralsTransformer::transform(TranslationUnit& translationUni
 
     // The transformation is local to each rule, so can visit each independently
     visit(program, [&](const Clause& clause) {
+        // Subsumptive clauses must keep their leading atoms in place
+        if (isA<SubsumptiveClause>(clause)) {
+            return;
+        }
+
         // Create the variable dependency graph G
         Graph<std::string> variableGraph = Graph<std::string>();
         std::set<std::string> ruleVariables;
@@ -25,6 +25,7 @@
 #include "ast/Program.h"
 #include "ast/QualifiedName.h"
 #include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/UnnamedVariable.h"
 #include "ast/analysis/IOType.h"
@@ -76,6 +77,11 @@ bool ReduceExistentialsTransformer::transform(TranslationUnit& translationUnit)
             minimalIrreducibleRelations.insert(relation->getQualifiedName());
         }
         for (Clause* clause : getClauses(program, *relation)) {
+            // Subsumptive pruning inspects the relation's own tuples
+            if (isA<SubsumptiveClause>(clause)) {
+                minimalIrreducibleRelations.insert(relation->getQualifiedName());
+                continue;
+            }
             bool recursive = isRecursiveClause(*clause);
             visit(*clause, [&](const Atom& atom) {
                 if (atom.getQualifiedName() == clause->getHead()->getQualifiedName()) {
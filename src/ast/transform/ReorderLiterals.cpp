@@ -21,12 +21,14 @@
 #include "ast/Atom.h"
 #include "ast/Clause.h"
 #include "ast/Program.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
 #include "ast/Variable.h"
 #include "ast/analysis/ProfileUse.h"
 #include "ast/utility/BindingStore.h"
 #include "ast/utility/SipsMetric.h"
 #include "ast/utility/Utils.h"
+#include "ast/utility/Visitor.h"
 #include <algorithm>
 #include <memory>
 #include <set>
@@ -36,12 +38,65 @@
 
 namespace souffle::ast::transform {
 
+/**
+ * Checks whether the join graph of a clause contains a cycle, i.e. whether
+ * two of its body atoms are joined through more than one chain of shared
+ * variables, as in the triangle rule R(x,y), S(y,z), T(z,x).
+ */
+static bool hasCyclicJoinGraph(const Clause* clause) {
+    auto atoms = getBodyLiterals<Atom>(*clause);
+    if (atoms.size() < 3) {
+        return false;
+    }
+
+    // collect the variables appearing in each atom
+    std::vector<std::set<std::string>> atomVars;
+    for (const auto* atom : atoms) {
+        std::set<std::string> vars;
+        visit(*atom, [&](const Variable& var) { vars.insert(var.getName()); });
+        atomVars.push_back(std::move(vars));
+    }
+
+    // union-find over the atoms; an edge between two atoms that are already
+    // connected closes a cycle
+    std::vector<std::size_t> rep(atoms.size());
+    for (std::size_t i = 0; i < rep.size(); i++) {
+        rep[i] = i;
+    }
+    auto find = [&](std::size_t x) {
+        while (rep[x] != x) {
+            x = rep[x] = rep[rep[x]];
+        }
+        return x;
+    };
+
+    for (std::size_t i = 0; i < atoms.size(); i++) {
+        for (std::size_t j = i + 1; j < atoms.size(); j++) {
+            bool shared = std::any_of(atomVars[i].begin(), atomVars[i].end(),
+                    [&](const std::string& var) { return atomVars[j].count(var) != 0; });
+            if (!shared) {
+                continue;
+            }
+            if (find(i) == find(j)) {
+                return true;
+            }
+            rep[find(i)] = find(j);
+        }
+    }
+    return false;
+}
+
 Clause* ReorderLiteralsTransformer::reorderClauseWithSips(const SipsMetric& sips, const Clause* clause) {
     // ignore clauses with fixed execution plans
     if (clause->getExecutionPlan() != nullptr) {
         return nullptr;
     }
 
+    // ignore subsumptive clauses - the positions of their leading atoms are fixed
+    if (isA<SubsumptiveClause>(clause)) {
+        return nullptr;
+    }
+
     // get the ordering corresponding to the SIPS
     std::vector<unsigned int> newOrdering = sips.getReordering(clause);
 
@@ -88,10 +143,36 @@ bool ReorderLiteralsTransformer::transform(TranslationUnit& translationUnit) {
         program.removeClause(clause);
     }
 
+    // --- cyclic-join handling ---
+    // under the default SIPS, clauses whose join graph contains a cycle are
+    // rescheduled so that every atom after the first is joined on already
+    // bound variables, bounding the size of the intermediate results
+    if (!Global::config().has("SIPS")) {
+        auto cyclicSips = SipsMetric::create("cyclic-join", translationUnit);
+
+        std::vector<Clause*> clausesToRemove;
+        for (Clause* clause : program.getClauses()) {
+            if (!hasCyclicJoinGraph(clause)) {
+                continue;
+            }
+            Clause* newClause = reorderClauseWithSips(*cyclicSips, clause);
+            if (newClause != nullptr) {
+                // reordering needed - swap around
+                clausesToRemove.push_back(clause);
+                program.addClause(Own<Clause>(newClause));
+            }
+        }
+
+        changed |= !clausesToRemove.empty();
+        for (auto* clause : clausesToRemove) {
+            program.removeClause(clause);
+        }
+    }
+
     // --- profile-guided reordering ---
     if (Global::config().has("profile-use")) {
-        // parse supplied profile information
-        auto profilerSips = SipsMetric::create("profiler", translationUnit);
+        // reorder based on the cost model over the supplied profile
+        auto profilerSips = SipsMetric::create("selectivity", translationUnit);
 
         // change the ordering of literals within clauses
         std::vector<Clause*> clausesToRemove;
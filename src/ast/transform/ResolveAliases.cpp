@@ -37,6 +37,7 @@
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <map>
@@ -445,7 +446,9 @@ Own<Clause> ResolveAliasesTransformer::removeComplexTermsInAtoms(const Clause& c
     using substitution_map = std::vector<std::pair<Own<Argument>, Own<ast::Variable>>>;
     substitution_map termToVar;
 
-    static int varCounter = 0;
+    // atomic: clauses are normalised concurrently, and the fresh names only
+    // need to be unique, not consecutive
+    static std::atomic<int> varCounter{0};
     for (const Argument* arg : terms) {
         // create a new mapping for this term
         auto term = clone(arg);
@@ -509,24 +512,31 @@ bool ResolveAliasesTransformer::transform(TranslationUnit& translationUnit) {
         }
     });
 
-    // clean all clauses
-    for (const Clause* clause : clauses) {
+    // clean all clauses; each rewrite only reads its own clause, so the
+    // clauses are processed in parallel and the program updated afterwards
+    std::vector<Own<Clause>> normalised(clauses.size());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (std::size_t i = 0; i < clauses.size(); i++) {
         // -- Step 1 --
         // get rid of aliases
-        Own<Clause> noAlias = resolveAliases(*clause);
+        Own<Clause> noAlias = resolveAliases(*clauses[i]);
 
         // clean up equalities
         Own<Clause> cleaned = removeTrivialEquality(*noAlias);
 
         // -- Step 2 --
         // restore simple terms in atoms
-        Own<Clause> normalised = removeComplexTermsInAtoms(*cleaned);
+        normalised[i] = removeComplexTermsInAtoms(*cleaned);
+    }
 
-        // swap if changed
-        if (*normalised != *clause) {
+    // swap the changed clauses
+    for (std::size_t i = 0; i < clauses.size(); i++) {
+        if (*normalised[i] != *clauses[i]) {
             changed = true;
-            program.removeClause(clause);
-            program.addClause(std::move(normalised));
+            program.removeClause(clauses[i]);
+            program.addClause(std::move(normalised[i]));
         }
     }
 
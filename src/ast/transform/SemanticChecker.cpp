@@ -46,6 +46,7 @@
 #include "ast/RecordInit.h"
 #include "ast/Relation.h"
 #include "ast/StringConstant.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/Term.h"
 #include "ast/TranslationUnit.h"
 #include "ast/Type.h"
@@ -116,6 +117,7 @@ private:
     void checkConstant(const Argument& argument);
     void checkFact(const Clause& fact);
     void checkClause(const Clause& clause);
+    void checkSubsumptiveClause(const SubsumptiveClause& clause);
     void checkComplexRule(std::set<const Clause*> multiRule);
     void checkRelationDeclaration(const Relation& relation);
     void checkRelationFunctionalDependencies(const Relation& relation);
@@ -170,8 +172,14 @@ SemanticCheckerImpl::SemanticCheckerImpl(TranslationUnit& tu) : tu(tu) {
     for (auto* rel : program.getRelations()) {
         checkRelation(*rel);
     }
-    for (auto* clause : program.getClauses()) {
-        checkClause(*clause);
+    // the clause checks only read the program and the analyses resolved
+    // above, and the error report accepts diagnostics concurrently
+    const auto& clauses = program.getClauses();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (std::size_t i = 0; i < clauses.size(); i++) {
+        checkClause(*clauses[i]);
     }
 
     for (auto* decl : program.getFunctorDeclarations()) {
@@ -490,6 +498,68 @@ void SemanticCheckerImpl::checkClause(const Clause& clause) {
             report.addError("Auto-increment functor in a recursive rule", ctr.getSrcLoc());
         });
     }
+
+    // check subsumptive clauses
+    if (const auto* subsumptiveClause = as<SubsumptiveClause>(clause)) {
+        checkSubsumptiveClause(*subsumptiveClause);
+    }
+}
+
+void SemanticCheckerImpl::checkSubsumptiveClause(const SubsumptiveClause& clause) {
+    const Atom* dominated = clause.getDominatedAtom();
+    const Atom* dominating = clause.getDominatingAtom();
+
+    // both atoms must refer to the same relation
+    if (dominated->getQualifiedName() != dominating->getQualifiedName()) {
+        report.addError("Atoms of subsumptive clause refer to different relations", clause.getSrcLoc());
+        return;
+    }
+
+    // subsumption on propositions is meaningless
+    if (dominated->getArity() == 0) {
+        report.addError("Subsumptive clause on a nullary relation", clause.getSrcLoc());
+        return;
+    }
+
+    // the relation must support in-place deletion of tuples
+    const auto* relation = getRelation(program, dominated->getQualifiedName());
+    if (relation != nullptr) {
+        auto representation = relation->getRepresentation();
+        if (representation != RelationRepresentation::DEFAULT &&
+                representation != RelationRepresentation::BTREE) {
+            report.addError("Relation with subsumptive clause requires a btree representation",
+                    relation->getSrcLoc());
+        }
+        if (relation->hasQualifier(RelationQualifier::INLINE)) {
+            report.addError("Relation with subsumptive clause cannot be inlined", relation->getSrcLoc());
+        }
+    }
+    if (Global::config().has("provenance")) {
+        report.addError("Subsumptive clauses cannot be used with provenance", clause.getSrcLoc());
+    }
+
+    // atom arguments are restricted to variables and constants, so dominance
+    // can be decided by comparing the two bound tuples alone
+    for (const Atom* atom : {dominated, dominating}) {
+        for (const Argument* arg : atom->getArguments()) {
+            if (!isA<ast::Variable>(arg) && !isA<UnnamedVariable>(arg) && !isA<Constant>(arg)) {
+                report.addError(
+                        "Argument of subsumptive clause atom is not a variable or constant", arg->getSrcLoc());
+            }
+        }
+    }
+
+    // the dominance condition must consist of constraints only
+    const auto bodyLiterals = clause.getBodyLiterals();
+    for (std::size_t i = 2; i < bodyLiterals.size(); i++) {
+        if (!isA<Constraint>(bodyLiterals[i])) {
+            report.addError("Body of subsumptive clause contains a non-constraint literal",
+                    bodyLiterals[i]->getSrcLoc());
+        }
+    }
+    visit(clause, [&](const Aggregator& agg) {
+        report.addError("Aggregator in subsumptive clause", agg.getSrcLoc());
+    });
 }
 
 void SemanticCheckerImpl::checkComplexRule(std::set<const Clause*> multiRule) {
@@ -610,6 +680,13 @@ void SemanticCheckerImpl::checkRelation(const Relation& relation) {
         }
     }
 
+    if (relation.getRepresentation() == RelationRepresentation::INTERVAL) {
+        if (relation.getArity() != 1) {
+            report.addError("Interval relation " + toString(relation.getQualifiedName()) + " is not unary",
+                    relation.getSrcLoc());
+        }
+    }
+
     // start with declaration
     checkRelationDeclaration(relation);
 
@@ -0,0 +1,225 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SharedBodyPrefix.cpp
+ *
+ ***********************************************************************/
+
+#include "ast/transform/SharedBodyPrefix.h"
+#include "Global.h"
+#include "ast/Argument.h"
+#include "ast/Atom.h"
+#include "ast/Attribute.h"
+#include "ast/Clause.h"
+#include "ast/Constant.h"
+#include "ast/Literal.h"
+#include "ast/Program.h"
+#include "ast/QualifiedName.h"
+#include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
+#include "ast/TranslationUnit.h"
+#include "ast/Variable.h"
+#include "ast/analysis/SCCGraph.h"
+#include "ast/analysis/typesystem/Type.h"
+#include "ast/analysis/typesystem/TypeSystem.h"
+#include "ast/utility/Utils.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <cassert>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ast::transform {
+
+namespace {
+
+/** Checks that an atom only contains variables and constants */
+bool isSimpleAtom(const Atom* atom) {
+    for (const Argument* arg : atom->getArguments()) {
+        if (!isA<ast::Variable>(arg) && !isA<Constant>(arg)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Canonical description of a two-atom prefix: relation names together with
+ * the pattern of variable sharing and constant positions. Two prefixes with
+ * the same key describe the same sub-join up to variable renaming.
+ */
+std::string getPrefixKey(const Atom* first, const Atom* second) {
+    std::map<std::string, std::size_t> varIds;
+    std::stringstream key;
+    auto append = [&](const Atom* atom) {
+        key << toString(atom->getQualifiedName()) << "(";
+        for (const Argument* arg : atom->getArguments()) {
+            if (const auto* var = as<ast::Variable>(arg)) {
+                auto pos = varIds.insert(std::make_pair(var->getName(), varIds.size()));
+                key << "v" << pos.first->second << ",";
+            } else {
+                key << "c[" << toString(*arg) << "],";
+            }
+        }
+        key << ")";
+    };
+    append(first);
+    key << ",";
+    append(second);
+    return key.str();
+}
+
+/** The distinct variables of the two-atom prefix, in order of first occurrence */
+std::vector<std::string> getPrefixVariables(const Clause* clause) {
+    std::vector<std::string> vars;
+    std::set<std::string> seen;
+    for (std::size_t i = 0; i < 2; i++) {
+        const auto* atom = as<Atom>(clause->getBodyLiterals().at(i));
+        for (const Argument* arg : atom->getArguments()) {
+            if (const auto* var = as<ast::Variable>(arg)) {
+                if (seen.insert(var->getName()).second) {
+                    vars.push_back(var->getName());
+                }
+            }
+        }
+    }
+    return vars;
+}
+
+}  // namespace
+
+bool SharedBodyPrefixTransformer::transform(TranslationUnit& translationUnit) {
+    Program& program = translationUnit.getProgram();
+
+    // provenance reconstructs proof trees from the original clause bodies
+    if (Global::config().has("provenance")) {
+        return false;
+    }
+
+    const auto& sccGraph = translationUnit.getAnalysis<analysis::SCCGraphAnalysis>();
+
+    // Group clauses by the canonical form of their two-atom body prefix
+    std::map<std::string, std::vector<Clause*>> prefixGroups;
+    for (Clause* clause : program.getClauses()) {
+        // clauses with user-given plans are kept as they are
+        if (clause->getExecutionPlan() != nullptr) {
+            continue;
+        }
+
+        // the leading atoms of a subsumptive clause are not a joinable prefix
+        if (isA<SubsumptiveClause>(clause)) {
+            continue;
+        }
+        const auto& body = clause->getBodyLiterals();
+        if (body.size() < 2) {
+            continue;
+        }
+        const auto* first = as<Atom>(body[0]);
+        const auto* second = as<Atom>(body[1]);
+        if (first == nullptr || second == nullptr || !isSimpleAtom(first) || !isSimpleAtom(second)) {
+            continue;
+        }
+
+        // the prefix must be computable before the clause's own stratum, as
+        // the materialised relation is evaluated ahead of its consumers
+        const auto* headRel = getRelation(program, clause->getHead()->getQualifiedName());
+        const auto* firstRel = getRelation(program, first->getQualifiedName());
+        const auto* secondRel = getRelation(program, second->getQualifiedName());
+        if (headRel == nullptr || firstRel == nullptr || secondRel == nullptr) {
+            continue;
+        }
+        std::size_t headSCC = sccGraph.getSCC(headRel);
+        if (sccGraph.getSCC(firstRel) == headSCC || sccGraph.getSCC(secondRel) == headSCC) {
+            continue;
+        }
+
+        prefixGroups[getPrefixKey(first, second)].push_back(clause);
+    }
+
+    bool changed = false;
+    for (auto& [key, clauses] : prefixGroups) {
+        // materialisation only pays off if the sub-join is shared
+        if (clauses.size() < 2) {
+            continue;
+        }
+
+        // Come up with a unique new name for the prefix relation
+        static int sharedPrefixCount = 0;
+        std::stringstream nextName;
+        nextName << "+shared_prefix" << sharedPrefixCount;
+        QualifiedName prefixRelationName(nextName.str());
+        sharedPrefixCount++;
+
+        // Create the defining clause from a representative of the group:
+        // +shared_prefixX(vars...) :- first(...), second(...).
+        const Clause* representative = clauses[0];
+        const auto representativeVars = getPrefixVariables(representative);
+
+        auto prefixClause = mk<Clause>(prefixRelationName, representative->getSrcLoc());
+        for (const auto& var : representativeVars) {
+            prefixClause->getHead()->addArgument(mk<ast::Variable>(var));
+        }
+        prefixClause->addToBody(clone(as<Atom>(representative->getBodyLiterals()[0])));
+        prefixClause->addToBody(clone(as<Atom>(representative->getBodyLiterals()[1])));
+
+        // Derive the attribute types from the defining clause
+        std::map<const Argument*, analysis::TypeSet> argTypes =
+                analysis::TypeAnalysis::analyseTypes(translationUnit, *prefixClause);
+        auto prefixRelation = mk<Relation>(prefixRelationName);
+        bool typeable = true;
+        for (const auto* arg : prefixClause->getHead()->getArguments()) {
+            const auto& types = argTypes[arg];
+            if (types.empty() || types.isAll()) {
+                typeable = false;
+                break;
+            }
+            prefixRelation->addAttribute(mk<Attribute>(toString(*arg), types.begin()->getName()));
+        }
+        if (!typeable) {
+            continue;
+        }
+
+        program.addRelation(std::move(prefixRelation));
+        program.addClause(std::move(prefixClause));
+
+        // Rewrite each clause of the group to scan the materialised prefix
+        for (Clause* clause : clauses) {
+            const auto vars = getPrefixVariables(clause);
+            assert(vars.size() == representativeVars.size() &&
+                    "matching prefixes should have the same variable count");
+
+            auto replacementAtom = mk<Atom>(prefixRelationName);
+            for (const auto& var : vars) {
+                replacementAtom->addArgument(mk<ast::Variable>(var));
+            }
+
+            VecOwn<Literal> newBody;
+            newBody.push_back(std::move(replacementAtom));
+            const auto& body = clause->getBodyLiterals();
+            for (std::size_t i = 2; i < body.size(); i++) {
+                newBody.push_back(clone(body[i]));
+            }
+
+            auto newClause =
+                    mk<Clause>(clone(clause->getHead()), std::move(newBody), nullptr, clause->getSrcLoc());
+            program.removeClause(clause);
+            program.addClause(std::move(newClause));
+        }
+        changed = true;
+    }
+    return changed;
+}
+
+}  // namespace souffle::ast::transform
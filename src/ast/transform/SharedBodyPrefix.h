@@ -0,0 +1,52 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SharedBodyPrefix.h
+ *
+ * Transformation pass to materialise body prefixes shared by several
+ * clauses in a temporary relation, so that the common sub-join is
+ * computed once instead of once per clause.
+ * E.g. a(x) :- b(x,y), c(y,z), d(z).
+ *      e(x) :- b(x,y), c(y,z), f(z).
+ * is transformed into:
+ *      - +shared_prefix0(x,y,z) :- b(x,y), c(y,z).
+ *      - a(x) :- +shared_prefix0(x,y,z), d(z).
+ *      - e(x) :- +shared_prefix0(x,y,z), f(z).
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ast/TranslationUnit.h"
+#include "ast/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ast::transform {
+
+/**
+ * Transformation pass to materialise body prefixes shared by several
+ * clauses in a temporary relation, so that the common sub-join is
+ * computed once instead of once per clause.
+ */
+class SharedBodyPrefixTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "SharedBodyPrefixTransformer";
+    }
+
+private:
+    SharedBodyPrefixTransformer* cloning() const override {
+        return new SharedBodyPrefixTransformer();
+    }
+
+    bool transform(TranslationUnit& translationUnit) override;
+};
+
+}  // namespace souffle::ast::transform
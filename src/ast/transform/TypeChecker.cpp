@@ -42,6 +42,7 @@
 #include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <map>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -76,8 +77,14 @@ public:
 
     /** Analyse types, clause by clause */
     void run() {
-        for (auto const* clause : program.getClauses()) {
-            visit(*clause, *this);
+        // clause checks only read the precomputed analyses and report
+        // diagnostics, so the clauses are visited in parallel
+        const auto& clauses = program.getClauses();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (std::size_t i = 0; i < clauses.size(); i++) {
+            visit(*clauses[i], *this);
         }
 
         for (auto const* decl : program.getFunctorDeclarations()) {
@@ -116,7 +123,15 @@ private:
 
     const Program& program = tu.getProgram();
 
+    /** Negated atoms, shared between concurrent clause visits */
     std::unordered_set<const Atom*> negatedAtoms;
+    std::mutex negatedAtomsAccess;
+
+    /** An atom is registered here by the enclosing negation before its own visit */
+    bool isNegated(const Atom& atom) {
+        std::lock_guard<std::mutex> guard(negatedAtomsAccess);
+        return negatedAtoms.count(&atom) != 0;
+    }
 
     /** Collect negated atoms */
     void visit_(type_identity<Negation>, const Negation& neg) override;
@@ -356,7 +371,7 @@ void TypeCheckerImpl::visit_(type_identity<Atom>, const Atom& atom) {
 
         // We consider two cases: negated and not negated atoms.
         // Negated atom have to agree in kind, non-negated atom need to follow source/sink rules.
-        if (negatedAtoms.count(&atom) == 0) {
+        if (!isNegated(atom)) {
             // Attribute and argument type agree if, argument type is a subtype of declared type
             // or is of the appropriate constant type or the (constant) record type.
             bool validAttribute = all_of(argTypes, [&attributeType](const analysis::Type& type) {
@@ -679,6 +694,7 @@ void TypeCheckerImpl::visit_(type_identity<Aggregator>, const Aggregator& aggreg
 }
 
 void TypeCheckerImpl::visit_(type_identity<Negation>, const Negation& neg) {
+    std::lock_guard<std::mutex> guard(negatedAtomsAccess);
     negatedAtoms.insert(neg.getAtom());
 }
 
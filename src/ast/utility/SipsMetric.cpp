@@ -24,8 +24,10 @@
 #include "ast/utility/BindingStore.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
+#include <algorithm>
 #include <cmath>
 #include <limits>
+#include <numeric>
 #include <vector>
 
 namespace souffle::ast {
@@ -78,6 +80,10 @@ std::unique_ptr<SipsMetric> SipsMetric::create(const std::string& heuristic, con
         return mk<LeastFreeVarsSips>();
     else if (heuristic == "profile-use")
         return mk<ProfileUseSips>(tu.getAnalysis<analysis::ProfileUseAnalysis>());
+    else if (heuristic == "selectivity")
+        return mk<SelectivitySips>(tu.getAnalysis<analysis::ProfileUseAnalysis>());
+    else if (heuristic == "cyclic-join")
+        return mk<CyclicJoinSips>();
     else if (heuristic == "delta")
         return mk<DeltaSips>();
     else if (heuristic == "input")
@@ -295,10 +301,132 @@ std::vector<double> ProfileUseSips::evaluateCosts(
         int numFree = arity - numBound;
         double value = log(profileUse.getRelationSize(atom->getQualifiedName()));
         value *= (numFree * 1.0) / arity;
+        cost.push_back(value);
     }
     return cost;
 }
 
+std::vector<unsigned int> SelectivitySips::getReordering(const Clause* clause) const {
+    auto atoms = getBodyLiterals<Atom>(*clause);
+    std::size_t numAtoms = atoms.size();
+
+    // exhaustively scoring all schedules is only feasible for short bodies;
+    // longer bodies fall back to the greedy scheme of the base class
+    constexpr std::size_t maxExhaustiveAtoms = 7;
+    if (numAtoms < 2 || numAtoms > maxExhaustiveAtoms) {
+        return SipsMetric::getReordering(clause);
+    }
+
+    std::vector<unsigned int> order(numAtoms);
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<unsigned int> bestOrder = order;
+    double bestCost = std::numeric_limits<double>::max();
+    do {
+        double cost = estimatePlanCost(clause, atoms, order);
+        if (cost < bestCost) {
+            bestCost = cost;
+            bestOrder = order;
+        }
+    } while (std::next_permutation(order.begin(), order.end()));
+    return bestOrder;
+}
+
+double SelectivitySips::estimatePlanCost(const Clause* clause, const std::vector<Atom*>& atoms,
+        const std::vector<unsigned int>& order) const {
+    BindingStore bindingStore(clause);
+
+    // the cost of a schedule is the sum of the estimated sizes of all its
+    // intermediate results
+    double tuples = 1;
+    double cost = 0;
+    for (auto idx : order) {
+        const auto* atom = atoms[idx];
+        tuples *= estimateCardinality(atom, bindingStore);
+        cost += tuples;
+
+        // set all arguments that are variables as bound
+        for (const auto* arg : atom->getArguments()) {
+            if (const auto* var = as<Variable>(arg)) {
+                bindingStore.bindVariableStrongly(var->getName());
+            }
+        }
+    }
+    return cost;
+}
+
+double SelectivitySips::estimateCardinality(const Atom* atom, const BindingStore& bindingStore) const {
+    std::size_t arity = atom->getArity();
+    if (arity == 0) {
+        return 1;
+    }
+
+    // relations without profile data are assumed to be mid-sized
+    double size = 1 << 20;
+    if (profileUse.hasRelationSize(atom->getQualifiedName())) {
+        size = static_cast<double>(profileUse.getRelationSize(atom->getQualifiedName()));
+    }
+
+    // each bound argument filters the relation by the number of distinct
+    // values in its column, which in the absence of recorded per-column
+    // statistics is approximated by the arity-th root of the relation size
+    std::size_t numBound = bindingStore.numBoundArguments(atom);
+    return std::pow(size, static_cast<double>(arity - numBound) / arity);
+}
+
+std::vector<double> SelectivitySips::evaluateCosts(
+        const std::vector<Atom*> atoms, const BindingStore& bindingStore) const {
+    // Goal: choose the atom expected to produce the fewest tuples under the
+    // current bindings
+    std::vector<double> cost;
+    for (const auto* atom : atoms) {
+        if (atom == nullptr) {
+            cost.push_back(std::numeric_limits<double>::max());
+            continue;
+        }
+        cost.push_back(estimateCardinality(atom, bindingStore));
+    }
+    return cost;
+}
+
+std::vector<double> CyclicJoinSips::evaluateCosts(
+        const std::vector<Atom*> atoms, const BindingStore& bindingStore) const {
+    // Goal: keep the schedule connected: prioritise (1) all-bound, then (2)
+    // atoms joined on bound variables that introduce the fewest new ones, and
+    // (3) heavily penalise atoms disconnected from the bound variables
+    std::vector<double> cost;
+    for (const auto* atom : atoms) {
+        if (atom == nullptr) {
+            cost.push_back(std::numeric_limits<double>::max());
+            continue;
+        }
+
+        int arity = atom->getArity();
+        int numBound = bindingStore.numBoundArguments(atom);
+
+        // use a set to hold the new variables to avoid double-counting
+        std::set<std::string> newVars;
+        visit(*atom, [&](const Variable& var) {
+            if (!bindingStore.isBound(var.getName())) {
+                newVars.insert(var.getName());
+            }
+        });
+        int numNew = static_cast<int>(newVars.size());
+
+        if (arity == numBound) {
+            // always better than anything else
+            cost.push_back(0);
+        } else if (numBound == 0) {
+            // a disconnected atom re-opens the cycle: always worst
+            cost.push_back(3.0 + numNew);
+        } else {
+            // between 1 and 2, decreasing as fewer new variables are introduced
+            cost.push_back(1.0 + static_cast<double>(numNew) / (numNew + numBound));
+        }
+    }
+    assert(atoms.size() == cost.size() && "each atom should have exactly one cost");
+    return cost;
+}
+
 std::vector<double> DeltaSips::evaluateCosts(
         const std::vector<Atom*> atoms, const BindingStore& bindingStore) const {
     // Goal: prioritise (1) all-bound, then (2) deltas, and then (3) left-most
@@ -45,7 +45,7 @@ public:
      * @param clause clause to reorder
      * @return the vector of new positions; v[i] = j iff atom j moves to pos i
      */
-    std::vector<unsigned int> getReordering(const Clause* clause) const;
+    virtual std::vector<unsigned int> getReordering(const Clause* clause) const;
 
     /** Create a SIPS metric based on a given heuristic. */
     static std::unique_ptr<SipsMetric> create(const std::string& heuristic, const TranslationUnit& tu);
@@ -158,6 +158,48 @@ private:
     const analysis::ProfileUseAnalysis& profileUse;
 };
 
+/**
+ * Goal: minimise the estimated sizes of the intermediate results
+ * Metric: cost(schedule) = sum of the result cardinalities after each atom,
+ *         where the cardinality of an atom is estimated from the profiled
+ *         relation size and the number of bound arguments
+ */
+class SelectivitySips : public SipsMetric {
+public:
+    SelectivitySips(const analysis::ProfileUseAnalysis& profileUse) : profileUse(profileUse) {}
+
+    std::vector<unsigned int> getReordering(const Clause* clause) const override;
+
+protected:
+    std::vector<double> evaluateCosts(
+            const std::vector<Atom*> atoms, const BindingStore& bindingStore) const override;
+
+private:
+    /** Estimates the cost of executing the atoms of a clause in the given order */
+    double estimatePlanCost(const Clause* clause, const std::vector<Atom*>& atoms,
+            const std::vector<unsigned int>& order) const;
+
+    /** Estimates the number of tuples an atom produces under the current bindings */
+    double estimateCardinality(const Atom* atom, const BindingStore& bindingStore) const;
+
+    const analysis::ProfileUseAnalysis& profileUse;
+};
+
+/**
+ * Goal: keep the schedules of cyclic join graphs connected
+ * Metric: prioritise (1) all-bound, then (2) atoms joined on bound variables
+ *         that introduce the fewest new ones, and (3) heavily penalise atoms
+ *         disconnected from the bound variables
+ */
+class CyclicJoinSips : public SipsMetric {
+public:
+    CyclicJoinSips() = default;
+
+protected:
+    std::vector<double> evaluateCosts(
+            const std::vector<Atom*> atoms, const BindingStore& bindingStore) const override;
+};
+
 /** Goal: prioritise (1) all-bound, then (2) deltas, and then (3) left-most */
 class DeltaSips : public SipsMetric {
 public:
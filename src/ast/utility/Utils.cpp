@@ -236,11 +236,7 @@ bool isDeltaRelation(const QualifiedName& name) {
 }
 
 Own<Clause> cloneHead(const Clause& clause) {
-    auto myClone = mk<Clause>(clone(clause.getHead()), clause.getSrcLoc());
-    if (clause.getExecutionPlan() != nullptr) {
-        myClone->setExecutionPlan(clone(clause.getExecutionPlan()));
-    }
-    return myClone;
+    return clause.cloneHead();
 }
 
 std::vector<Atom*> reorderAtoms(const std::vector<Atom*>& atoms, const std::vector<unsigned int>& newOrder) {
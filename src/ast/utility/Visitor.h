@@ -49,6 +49,7 @@
 #include "ast/Relation.h"
 #include "ast/StringConstant.h"
 #include "ast/SubsetType.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/Term.h"
 #include "ast/Type.h"
 #include "ast/TypeCast.h"
@@ -73,6 +74,55 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
     R dispatch(NodeType& node, Params const&... args) override {
         // dispatch node processing based on dynamic type
 
+        // exact-type fast path: almost every node is an instance of one of
+        // the concrete kinds below, resolved by one type_info comparison each
+        const std::type_info& kind = typeid(node);
+
+        // types
+        SOUFFLE_VISITOR_FORWARD_EXACT(AliasType);
+        SOUFFLE_VISITOR_FORWARD_EXACT(SubsetType);
+        SOUFFLE_VISITOR_FORWARD_EXACT(UnionType);
+        SOUFFLE_VISITOR_FORWARD_EXACT(RecordType);
+        SOUFFLE_VISITOR_FORWARD_EXACT(AlgebraicDataType);
+        SOUFFLE_VISITOR_FORWARD_EXACT(BranchType)
+
+        // arguments
+        SOUFFLE_VISITOR_FORWARD_EXACT(Variable)
+        SOUFFLE_VISITOR_FORWARD_EXACT(UnnamedVariable)
+        SOUFFLE_VISITOR_FORWARD_EXACT(IntrinsicFunctor)
+        SOUFFLE_VISITOR_FORWARD_EXACT(UserDefinedFunctor)
+        SOUFFLE_VISITOR_FORWARD_EXACT(Counter)
+        SOUFFLE_VISITOR_FORWARD_EXACT(NumericConstant)
+        SOUFFLE_VISITOR_FORWARD_EXACT(StringConstant)
+        SOUFFLE_VISITOR_FORWARD_EXACT(NilConstant)
+        SOUFFLE_VISITOR_FORWARD_EXACT(TypeCast)
+        SOUFFLE_VISITOR_FORWARD_EXACT(RecordInit)
+        SOUFFLE_VISITOR_FORWARD_EXACT(BranchInit)
+        SOUFFLE_VISITOR_FORWARD_EXACT(Aggregator)
+
+        // literals
+        SOUFFLE_VISITOR_FORWARD_EXACT(Atom)
+        SOUFFLE_VISITOR_FORWARD_EXACT(Negation)
+        SOUFFLE_VISITOR_FORWARD_EXACT(BooleanConstraint)
+        SOUFFLE_VISITOR_FORWARD_EXACT(BinaryConstraint)
+        SOUFFLE_VISITOR_FORWARD_EXACT(FunctionalConstraint)
+
+        // components
+        SOUFFLE_VISITOR_FORWARD_EXACT(ComponentType);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ComponentInit);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Component);
+
+        // rest
+        SOUFFLE_VISITOR_FORWARD_EXACT(Attribute);
+        SOUFFLE_VISITOR_FORWARD_EXACT(SubsumptiveClause);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Clause);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Relation);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Program);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Pragma);
+        SOUFFLE_VISITOR_FORWARD_EXACT(FunctorDeclaration);
+
+        // RTTI fallback for node types not covered above
+
         // types
         SOUFFLE_VISITOR_FORWARD(AliasType);
         SOUFFLE_VISITOR_FORWARD(SubsetType);
@@ -109,6 +159,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
 
         // rest
         SOUFFLE_VISITOR_FORWARD(Attribute);
+        SOUFFLE_VISITOR_FORWARD(SubsumptiveClause);
         SOUFFLE_VISITOR_FORWARD(Clause);
         SOUFFLE_VISITOR_FORWARD(Relation);
         SOUFFLE_VISITOR_FORWARD(Program);
@@ -170,6 +221,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
     // -- others --
     SOUFFLE_VISITOR_LINK(Program, Node);
     SOUFFLE_VISITOR_LINK(Attribute, Node);
+    SOUFFLE_VISITOR_LINK(SubsumptiveClause, Clause);
     SOUFFLE_VISITOR_LINK(Clause, Node);
     SOUFFLE_VISITOR_LINK(Relation, Node);
     SOUFFLE_VISITOR_LINK(Pragma, Node);
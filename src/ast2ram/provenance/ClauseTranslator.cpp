@@ -61,6 +61,13 @@ Own<ram::Operation> ClauseTranslator::addNegatedDeltaAtom(
             mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
 }
 
+Own<ram::Operation> ClauseTranslator::addHeadDeltaGuard(
+        Own<ram::Operation> op, const ast::Atom* /* head */) const {
+    // provenance may re-derive a tuple already in the delta at a smaller
+    // height, so the delta shortcut does not apply
+    return op;
+}
+
 Own<ram::Operation> ClauseTranslator::addNegatedAtom(
         Own<ram::Operation> op, const ast::Clause& clause, const ast::Atom* atom) const {
     VecOwn<ram::Expression> values;
@@ -38,6 +38,7 @@ public:
 
 protected:
     Own<ram::Operation> addNegatedDeltaAtom(Own<ram::Operation> op, const ast::Atom* atom) const override;
+    Own<ram::Operation> addHeadDeltaGuard(Own<ram::Operation> op, const ast::Atom* head) const override;
     Own<ram::Operation> addNegatedAtom(
             Own<ram::Operation> op, const ast::Clause& clause, const ast::Atom* atom) const override;
     Own<ram::Operation> createInsertion(const ast::Clause& clause) const override;
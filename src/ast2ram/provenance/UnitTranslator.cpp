@@ -32,6 +32,7 @@
 #include "ram/Filter.h"
 #include "ram/Insert.h"
 #include "ram/LogRelationTimer.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/Query.h"
 #include "ram/Scan.h"
@@ -174,19 +175,19 @@ void UnitTranslator::addProvenanceClauseSubroutines(const ast::Program* program)
 
 Own<ram::Statement> UnitTranslator::generateMergeRelations(
         const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const {
-    VecOwn<ram::Expression> values;
-
-    // Predicate - insert all values
-    for (std::size_t i = 0; i < rel->getArity() + 2; i++) {
-        values.push_back(mk<ram::TupleElement>(0, i));
-    }
-
-    auto insertion = mk<ram::Insert>(destRelation, std::move(values));
-    auto stmt = mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
+    // Equivalence relations are extended, with the delta inserted tuple by tuple
     if (rel->getRepresentation() == RelationRepresentation::EQREL) {
+        VecOwn<ram::Expression> values;
+        for (std::size_t i = 0; i < rel->getArity() + 2; i++) {
+            values.push_back(mk<ram::TupleElement>(0, i));
+        }
+        auto insertion = mk<ram::Insert>(destRelation, std::move(values));
+        auto stmt = mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
         return mk<ram::Sequence>(mk<ram::Extend>(destRelation, srcRelation), std::move(stmt));
     }
-    return stmt;
+
+    // Predicate - merge the source relation wholesale, including annotations
+    return mk<ram::Merge>(destRelation, srcRelation);
 }
 
 Own<ram::Sequence> UnitTranslator::generateInfoClauses(const ast::Program* program) {
@@ -448,6 +448,11 @@ Own<ram::Operation> ClauseTranslator::addNegatedDeltaAtom(
             mk<ram::Negation>(mk<ram::ExistenceCheck>(name, std::move(values))), std::move(op));
 }
 
+Own<ram::Operation> ClauseTranslator::addHeadDeltaGuard(
+        Own<ram::Operation> op, const ast::Atom* head) const {
+    return addNegatedDeltaAtom(std::move(op), head);
+}
+
 Own<ram::Operation> ClauseTranslator::addNegatedAtom(
         Own<ram::Operation> op, const ast::Clause& /* clause */, const ast::Atom* atom) const {
     std::size_t arity = atom->getArity();
@@ -481,6 +486,12 @@ Own<ram::Operation> ClauseTranslator::addBodyLiteralConstraints(
         if (clause.getHead()->getArity() > 0) {
             // also negate the head
             op = addNegatedAtom(std::move(op), clause, clause.getHead());
+
+            // probe the delta of the head first: since the delta is a subset of
+            // the full relation, the extra check does not change the result, but
+            // it rejects tuples re-derived from the previous iteration against a
+            // small relation before the accumulated one is searched
+            op = addHeadDeltaGuard(std::move(op), clause.getHead());
         }
 
         // also add in prev stuff
@@ -72,6 +72,7 @@ protected:
     virtual Own<ram::Operation> addNegatedAtom(
             Own<ram::Operation> op, const ast::Clause& clause, const ast::Atom* atom) const;
     virtual Own<ram::Operation> addNegatedDeltaAtom(Own<ram::Operation> op, const ast::Atom* atom) const;
+    virtual Own<ram::Operation> addHeadDeltaGuard(Own<ram::Operation> op, const ast::Atom* head) const;
 
     Own<ValueIndex> valueIndex;
 
@@ -15,15 +15,26 @@
 #include "ast2ram/seminaive/UnitTranslator.h"
 #include "Global.h"
 #include "LogStatement.h"
+#include "ast/Atom.h"
+#include "ast/Attribute.h"
 #include "ast/Clause.h"
+#include "ast/Constant.h"
 #include "ast/Directive.h"
+#include "ast/FunctionalConstraint.h"
+#include "ast/NumericConstant.h"
 #include "ast/Relation.h"
+#include "ast/SubsumptiveClause.h"
 #include "ast/TranslationUnit.h"
+#include "ast/Variable.h"
 #include "ast/analysis/TopologicallySortedSCCGraph.h"
 #include "ast/utility/Utils.h"
 #include "ast/utility/Visitor.h"
+#include "ast2ram/utility/Location.h"
 #include "ast2ram/utility/TranslatorContext.h"
 #include "ast2ram/utility/Utils.h"
+#include "ast2ram/utility/ValueIndex.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/BinRelationStatement.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
 #include "ram/Condition.h"
@@ -31,22 +42,28 @@
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
 #include "ram/Expression.h"
 #include "ram/Extend.h"
 #include "ram/Filter.h"
+#include "ram/GuardedInsert.h"
 #include "ram/IO.h"
 #include "ram/Insert.h"
 #include "ram/LogRelationTimer.h"
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/Parallel.h"
 #include "ram/Program.h"
 #include "ram/Query.h"
 #include "ram/Relation.h"
+#include "ram/RelationOperation.h"
 #include "ram/RelationSize.h"
+#include "ram/RelationStatement.h"
 #include "ram/Scan.h"
 #include "ram/Sequence.h"
 #include "ram/SignedConstant.h"
@@ -54,12 +71,15 @@
 #include "ram/Swap.h"
 #include "ram/TranslationUnit.h"
 #include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
 #include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/TypeAttribute.h"
 #include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
 #include "souffle/utility/FunctionalUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StringUtil.h"
@@ -77,6 +97,51 @@
 
 namespace souffle::ast2ram::seminaive {
 
+namespace {
+
+/** Whether a completed checkpoint from a previous run can be restored. */
+bool hasRestorableCheckpoint() {
+    return Global::config().has("incremental-dir") && !Global::config().has("provenance") &&
+           existFile(Global::config().get("incremental-dir") + "/.complete");
+}
+
+/** Whether an in-process update entry point should be generated. */
+bool hasLiveUpdates() {
+    return Global::config().has("live") && !Global::config().has("provenance");
+}
+
+/** Collect the names of all relations the given RAM fragment references. */
+std::set<std::string> getReferencedRelations(const ram::Statement& stmt) {
+    std::set<std::string> names;
+    visit(stmt, [&](const ram::RelationOperation& op) { names.insert(op.getRelation()); });
+    visit(stmt, [&](const ram::RelationStatement& statement) { names.insert(statement.getRelation()); });
+    visit(stmt, [&](const ram::BinRelationStatement& statement) {
+        names.insert(statement.getFirstRelation());
+        names.insert(statement.getSecondRelation());
+    });
+    visit(stmt, [&](const ram::AbstractExistenceCheck& check) { names.insert(check.getRelation()); });
+    visit(stmt, [&](const ram::EmptinessCheck& check) { names.insert(check.getRelation()); });
+    visit(stmt, [&](const ram::RelationSize& size) { names.insert(size.getRelation()); });
+    visit(stmt, [&](const ram::Insert& insert) { names.insert(insert.getRelation()); });
+    visit(stmt, [&](const ram::Erase& erase) { names.insert(erase.getRelation()); });
+    return names;
+}
+
+/** Collect the names of all relations the given RAM fragment may modify. */
+std::set<std::string> getModifiedRelations(const ram::Statement& stmt) {
+    std::set<std::string> names;
+    visit(stmt, [&](const ram::Insert& insert) { names.insert(insert.getRelation()); });
+    visit(stmt, [&](const ram::Erase& erase) { names.insert(erase.getRelation()); });
+    visit(stmt, [&](const ram::RelationStatement& statement) { names.insert(statement.getRelation()); });
+    visit(stmt, [&](const ram::BinRelationStatement& statement) {
+        names.insert(statement.getFirstRelation());
+        names.insert(statement.getSecondRelation());
+    });
+    return names;
+}
+
+}  // namespace
+
 UnitTranslator::UnitTranslator() : ast2ram::UnitTranslator() {}
 
 UnitTranslator::~UnitTranslator() = default;
@@ -101,6 +166,11 @@ Own<ram::Statement> UnitTranslator::generateNonRecursiveRelation(const ast::Rela
             continue;
         }
 
+        // Subsumptive clauses are lowered separately as pruning passes
+        if (isA<ast::SubsumptiveClause>(clause)) {
+            continue;
+        }
+
         // Translate clause
         Own<ram::Statement> rule = context->translateNonRecursiveClause(*clause);
 
@@ -164,6 +234,7 @@ Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
         assert(sccRelations.size() == 1 && "only one relation should exist in non-recursive stratum");
         const auto* relation = *sccRelations.begin();
         appendStmt(current, generateNonRecursiveRelation(*relation));
+        appendStmt(current, generateSubsumptivePruning(relation, false));
     }
 
     // Store all internal output relations to the output dir with a .csv extension
@@ -194,16 +265,90 @@ Own<ram::Statement> UnitTranslator::generateMergeRelations(
                 mk<ram::Negation>(mk<ram::EmptinessCheck>(srcRelation)), std::move(insertion)));
     }
 
-    // Predicate - insert all values
+    // Equivalence relations are extended, with the delta inserted tuple by tuple
+    if (rel->getRepresentation() == RelationRepresentation::EQREL) {
+        for (std::size_t i = 0; i < rel->getArity(); i++) {
+            values.push_back(mk<ram::TupleElement>(0, i));
+        }
+        auto insertion = mk<ram::Insert>(destRelation, std::move(values));
+        auto stmt = mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
+        return mk<ram::Sequence>(mk<ram::Extend>(destRelation, srcRelation), std::move(stmt));
+    }
+
+    // Predicate - merge the source relation wholesale
+    return mk<ram::Merge>(destRelation, srcRelation);
+}
+
+Own<ram::Statement> UnitTranslator::generateGuardedMergeRelations(
+        const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const {
+    const auto& attributes = rel->getAttributes();
+
+    // A tuple is copied over unless it would break a functional dependency,
+    // mirroring the guards imposed on derived tuples in the clause translator
+    VecOwn<ram::Condition> guards;
+    std::vector<const ast::FunctionalConstraint*> addedConstraints;
+    for (const auto* fd : rel->getFunctionalDependencies()) {
+        // Skip if already seen
+        bool alreadySeen = false;
+        for (const auto* other : addedConstraints) {
+            if (other->equivalentConstraint(*fd)) {
+                alreadySeen = true;
+                break;
+            }
+        }
+        if (alreadySeen) {
+            continue;
+        }
+        addedConstraints.push_back(fd);
+
+        std::set<std::string> keys;
+        for (const auto* key : fd->getKeys()) {
+            keys.insert(key->getName());
+        }
+
+        // Match the key attributes against the destination, leaving the rest unbound
+        VecOwn<ram::Expression> vals;
+        for (std::size_t i = 0; i < attributes.size(); i++) {
+            if (contains(keys, attributes[i]->getName())) {
+                vals.push_back(mk<ram::TupleElement>(0, i));
+            } else {
+                vals.push_back(mk<ram::UndefValue>());
+            }
+        }
+        guards.push_back(mk<ram::Negation>(mk<ram::ExistenceCheck>(destRelation, std::move(vals))));
+    }
+
+    VecOwn<ram::Expression> values;
     for (std::size_t i = 0; i < rel->getArity(); i++) {
         values.push_back(mk<ram::TupleElement>(0, i));
     }
-    auto insertion = mk<ram::Insert>(destRelation, std::move(values));
-    auto stmt = mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
-    if (rel->getRepresentation() == RelationRepresentation::EQREL) {
-        return mk<ram::Sequence>(mk<ram::Extend>(destRelation, srcRelation), std::move(stmt));
+    auto insertion = mk<ram::GuardedInsert>(destRelation, std::move(values), ram::toCondition(guards));
+    return mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(insertion)));
+}
+
+Own<ram::Statement> UnitTranslator::generateDiffRelations(const ast::Relation* rel,
+        const std::string& destRelation, const std::string& srcRelation,
+        const std::string& filterRelation) const {
+    // Proposition - insert if in the source but not in the filter relation
+    if (rel->getArity() == 0) {
+        auto insertion = mk<ram::Insert>(destRelation, VecOwn<ram::Expression>());
+        auto condition = mk<ram::Conjunction>(mk<ram::Negation>(mk<ram::EmptinessCheck>(srcRelation)),
+                mk<ram::EmptinessCheck>(filterRelation));
+        return mk<ram::Query>(mk<ram::Filter>(std::move(condition), std::move(insertion)));
+    }
+
+    // Predicate - insert all values not present in the filter relation
+    VecOwn<ram::Expression> values;
+    VecOwn<ram::Expression> existenceValues;
+    for (std::size_t i = 0; i < rel->getArity(); i++) {
+        values.push_back(mk<ram::TupleElement>(0, i));
+        existenceValues.push_back(mk<ram::TupleElement>(0, i));
     }
-    return stmt;
+    auto insertion = mk<ram::Insert>(destRelation, std::move(values));
+    auto notInFilter =
+            mk<ram::Negation>(mk<ram::ExistenceCheck>(filterRelation, std::move(existenceValues)));
+    return mk<ram::Query>(
+            mk<ram::Scan>(srcRelation, 0, mk<ram::Filter>(std::move(notInFilter), std::move(insertion))));
 }
 
 Own<ram::Statement> UnitTranslator::translateRecursiveClauses(
@@ -218,6 +363,11 @@ Own<ram::Statement> UnitTranslator::translateRecursiveClauses(
             continue;
         }
 
+        // Subsumptive clauses are lowered separately as pruning passes
+        if (isA<ast::SubsumptiveClause>(clause)) {
+            continue;
+        }
+
         auto clauseVersions = generateClauseVersions(clause, scc);
         for (auto& clauseVersion : clauseVersions) {
             appendStmt(result, std::move(clauseVersion));
@@ -251,15 +401,36 @@ VecOwn<ram::Statement> UnitTranslator::generateClauseVersions(
 }
 
 Own<ram::Statement> UnitTranslator::generateStratumPreamble(const std::set<const ast::Relation*>& scc) const {
+    const bool restore = hasRestorableCheckpoint();
     VecOwn<ram::Statement> preamble;
     for (const ast::Relation* rel : scc) {
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string prevRelation = getPrevRelationName(rel->getQualifiedName());
+
+        // Warm-start: restore the previous fixpoint before deriving anything
+        if (restore) {
+            appendStmt(preamble, generateRestoreCheckpoint(rel));
+            appendStmt(preamble, generateMergeRelations(rel, mainRelation, prevRelation));
+        }
+
         // Generate code for the non-recursive part of the relation */
         appendStmt(preamble, generateNonRecursiveRelation(*rel));
 
-        // Copy the result into the delta relation
-        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
-        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
-        appendStmt(preamble, generateMergeRelations(rel, deltaRelation, mainRelation));
+        // Prune dominated tuples before seeding the delta
+        appendStmt(preamble, generateSubsumptivePruning(rel, false));
+
+        if (restore && rel->getRepresentation() != RelationRepresentation::EQREL) {
+            // Seed the delta with the difference to the previous fixpoint only,
+            // so unchanged derivations are not re-joined.
+            appendStmt(preamble, generateDiffRelations(rel, deltaRelation, mainRelation, prevRelation));
+        } else {
+            // Copy the result into the delta relation
+            appendStmt(preamble, generateMergeRelations(rel, deltaRelation, mainRelation));
+        }
+        if (restore) {
+            appendStmt(preamble, mk<ram::Clear>(prevRelation));
+        }
     }
     return mk<ram::Sequence>(std::move(preamble));
 }
@@ -268,6 +439,15 @@ Own<ram::Statement> UnitTranslator::generateStratumPostamble(
         const std::set<const ast::Relation*>& scc) const {
     VecOwn<ram::Statement> postamble;
     for (const ast::Relation* rel : scc) {
+        // Live updates diff the relation against the fixpoint just computed,
+        // so retain a copy of it before the temporary tables are dropped
+        if (hasLiveUpdates() && rel->getRepresentation() != RelationRepresentation::EQREL) {
+            std::string prevRelation = getPrevRelationName(rel->getQualifiedName());
+            appendStmt(postamble, mk<ram::Clear>(prevRelation));
+            appendStmt(postamble, generateMergeRelations(rel, prevRelation,
+                                          getConcreteRelationName(rel->getQualifiedName())));
+        }
+
         // Drop temporary tables after recursion
         appendStmt(postamble, mk<ram::Clear>(getDeltaRelationName(rel->getQualifiedName())));
         appendStmt(postamble, mk<ram::Clear>(getNewRelationName(rel->getQualifiedName())));
@@ -295,12 +475,171 @@ Own<ram::Statement> UnitTranslator::generateStratumTableUpdates(
         }
 
         appendStmt(updateTable, std::move(updateRelTable));
+
+        // After the swap the delta relation holds exactly the tuples produced
+        // by this iteration; record its cardinality to track convergence
+        if (Global::config().has("profile")) {
+            appendStmt(updateTable,
+                    mk<ram::LogSize>(deltaRelation, LogStatement::nRecursiveDelta(
+                                                            toString(rel->getQualifiedName()),
+                                                            rel->getSrcLoc())));
+        }
     }
     return mk<ram::Sequence>(std::move(updateTable));
 }
 
+Own<ram::Statement> UnitTranslator::generateStratumPruning(const std::set<const ast::Relation*>& scc) const {
+    VecOwn<ram::Statement> pruning;
+    for (const ast::Relation* rel : scc) {
+        appendStmt(pruning, generateSubsumptivePruning(rel, true));
+    }
+    return mk<ram::Sequence>(std::move(pruning));
+}
+
+std::vector<const ast::SubsumptiveClause*> UnitTranslator::getSubsumptiveClauses(
+        const ast::Relation& rel) const {
+    std::vector<const ast::SubsumptiveClause*> result;
+    for (const auto* clause : context->getClauses(rel.getQualifiedName())) {
+        if (const auto* subsumptiveClause = as<ast::SubsumptiveClause>(clause)) {
+            result.push_back(subsumptiveClause);
+        }
+    }
+    return result;
+}
+
+Own<ram::Statement> UnitTranslator::generateSubsumptiveStaging(const ast::SubsumptiveClause& clause,
+        const std::string& dominatedRelation, const std::string& dominatingRelation,
+        const std::string& stagingRelation) const {
+    const auto* dominated = clause.getDominatedAtom();
+    const auto* dominating = clause.getDominatingAtom();
+    std::size_t arity = dominated->getArity();
+    assert(arity > 0 && "subsumptive clauses on propositions are rejected by the semantic checker");
+
+    // Index the variable occurrences across the two atoms: the dominated
+    // tuple is bound at level 0, the dominating tuple at level 1
+    ValueIndex valueIndex;
+    const std::vector<const ast::Atom*> atoms = {dominated, dominating};
+    for (std::size_t level = 0; level < atoms.size(); level++) {
+        const auto& args = atoms[level]->getArguments();
+        for (std::size_t i = 0; i < args.size(); i++) {
+            if (const auto* var = as<ast::Variable>(args[i])) {
+                valueIndex.addVarReference(var->getName(), static_cast<int>(level), static_cast<int>(i));
+            }
+        }
+    }
+
+    Own<ram::Condition> condition;
+    auto addCondition = [&](Own<ram::Condition> term) {
+        condition = addConjunctiveTerm(std::move(condition), std::move(term));
+    };
+
+    // Equate the first appearance of each variable to all other appearances
+    for (const auto& [_, references] : valueIndex.getVariableReferences()) {
+        const auto& first = *references.begin();
+        for (const auto& reference : references) {
+            if (first != reference) {
+                addCondition(mk<ram::Constraint>(BinaryConstraintOp::EQ, makeRamTupleElement(first),
+                        makeRamTupleElement(reference)));
+            }
+        }
+    }
+
+    // Equate constant arguments to the corresponding tuple elements
+    for (std::size_t level = 0; level < atoms.size(); level++) {
+        const auto& args = atoms[level]->getArguments();
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const auto* argument = args[i];
+            if (const auto* numericConstant = as<ast::NumericConstant>(argument)) {
+                bool isFloat = context->getInferredNumericConstantType(*numericConstant) ==
+                               ast::NumericConstant::Type::Float;
+                auto eqOp = isFloat ? BinaryConstraintOp::FEQ : BinaryConstraintOp::EQ;
+                addCondition(mk<ram::Constraint>(
+                        eqOp, mk<ram::TupleElement>(level, i), context->translateValue(valueIndex, argument)));
+            } else if (isA<ast::Constant>(argument)) {
+                addCondition(mk<ram::Constraint>(BinaryConstraintOp::EQ, mk<ram::TupleElement>(level, i),
+                        context->translateValue(valueIndex, argument)));
+            }
+        }
+    }
+
+    // Translate the remaining body literals forming the dominance condition
+    const auto bodyLiterals = clause.getBodyLiterals();
+    for (std::size_t i = 2; i < bodyLiterals.size(); i++) {
+        addCondition(context->translateConstraint(valueIndex, bodyLiterals[i]));
+    }
+
+    // A tuple must never subsume itself
+    Own<ram::Condition> identical;
+    for (std::size_t i = 0; i < arity; i++) {
+        identical = addConjunctiveTerm(std::move(identical), mk<ram::Constraint>(BinaryConstraintOp::EQ,
+                                                                     mk<ram::TupleElement>(0, i),
+                                                                     mk<ram::TupleElement>(1, i)));
+    }
+    addCondition(mk<ram::Negation>(std::move(identical)));
+
+    // Stage the dominated tuple for erasure
+    VecOwn<ram::Expression> values;
+    for (std::size_t i = 0; i < arity; i++) {
+        values.push_back(mk<ram::TupleElement>(0, i));
+    }
+    Own<ram::Operation> op = mk<ram::Insert>(stagingRelation, std::move(values));
+    op = mk<ram::Filter>(std::move(condition), std::move(op));
+    op = mk<ram::Scan>(dominatingRelation, 1, std::move(op));
+    op = mk<ram::Scan>(dominatedRelation, 0, std::move(op));
+    return mk<ram::Query>(std::move(op));
+}
+
+Own<ram::Statement> UnitTranslator::generateEraseStagedTuples(const ast::Relation* rel,
+        const std::string& stagingRelation, const std::string& destRelation) const {
+    VecOwn<ram::Expression> values;
+    for (std::size_t i = 0; i < rel->getArity(); i++) {
+        values.push_back(mk<ram::TupleElement>(0, i));
+    }
+    return mk<ram::Query>(
+            mk<ram::Scan>(stagingRelation, 0, mk<ram::Erase>(destRelation, std::move(values))));
+}
+
+Own<ram::Statement> UnitTranslator::generateSubsumptivePruning(
+        const ast::Relation* rel, bool withinFixpoint) const {
+    auto subsumptiveClauses = getSubsumptiveClauses(*rel);
+    if (subsumptiveClauses.empty()) {
+        return mk<ram::Sequence>();
+    }
+
+    std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+    std::string stagingRelation = getSubsumedRelationName(rel->getQualifiedName());
+
+    VecOwn<ram::Statement> result;
+    if (!withinFixpoint) {
+        // Prune the stable content against itself
+        for (const auto* clause : subsumptiveClauses) {
+            appendStmt(result,
+                    generateSubsumptiveStaging(*clause, mainRelation, mainRelation, stagingRelation));
+        }
+        appendStmt(result, generateEraseStagedTuples(rel, stagingRelation, mainRelation));
+    } else {
+        // Freshly derived tuples may be dominated by existing tuples or by
+        // one another, and may themselves dominate existing tuples; the
+        // dominated @new tuples are removed before the merge so they never
+        // reach the main relation or the next delta
+        std::string newRelation = getNewRelationName(rel->getQualifiedName());
+        for (const auto* clause : subsumptiveClauses) {
+            appendStmt(
+                    result, generateSubsumptiveStaging(*clause, newRelation, mainRelation, stagingRelation));
+            appendStmt(
+                    result, generateSubsumptiveStaging(*clause, newRelation, newRelation, stagingRelation));
+            appendStmt(
+                    result, generateSubsumptiveStaging(*clause, mainRelation, newRelation, stagingRelation));
+        }
+        appendStmt(result, generateEraseStagedTuples(rel, stagingRelation, newRelation));
+        appendStmt(result, generateEraseStagedTuples(rel, stagingRelation, mainRelation));
+    }
+    appendStmt(result, mk<ram::Clear>(stagingRelation));
+    return mk<ram::Sequence>(std::move(result));
+}
+
 Own<ram::Statement> UnitTranslator::generateStratumLoopBody(const std::set<const ast::Relation*>& scc) const {
-    VecOwn<ram::Statement> loopBody;
+    VecOwn<ram::Statement> groups;
     for (const ast::Relation* rel : scc) {
         auto relClauses = translateRecursiveClauses(scc, rel);
 
@@ -313,7 +652,60 @@ Own<ram::Statement> UnitTranslator::generateStratumLoopBody(const std::set<const
                     logTimerStatement, getNewRelationName(rel->getQualifiedName()));
         }
 
-        appendStmt(loopBody, mk<ram::Sequence>(std::move(relClauses)));
+        appendStmt(groups, mk<ram::Sequence>(std::move(relClauses)));
+    }
+
+    if (groups.size() <= 1) {
+        return mk<ram::Sequence>(std::move(groups));
+    }
+
+    // Partition the per-relation rule groups into batches of mutually
+    // independent groups: two groups may run concurrently if neither modifies
+    // a relation the other touches. Within an iteration each group only
+    // inserts into its own new relation while the delta and full relations
+    // stay frozen until the table update, so typically every group lands in a
+    // single batch and all relations of the scc are evaluated concurrently.
+    auto intersects = [](const std::set<std::string>& lhs, const std::set<std::string>& rhs) {
+        for (const auto& name : lhs) {
+            if (rhs.count(name) != 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    struct Batch {
+        VecOwn<ram::Statement> statements;
+        std::set<std::string> referenced;
+        std::set<std::string> modified;
+    };
+    std::vector<Batch> batches;
+    for (auto& group : groups) {
+        auto referenced = getReferencedRelations(*group);
+        auto modified = getModifiedRelations(*group);
+        Batch* target = nullptr;
+        for (auto& batch : batches) {
+            if (!intersects(modified, batch.referenced) && !intersects(referenced, batch.modified)) {
+                target = &batch;
+                break;
+            }
+        }
+        if (target == nullptr) {
+            batches.emplace_back();
+            target = &batches.back();
+        }
+        target->statements.push_back(std::move(group));
+        target->referenced.insert(referenced.begin(), referenced.end());
+        target->modified.insert(modified.begin(), modified.end());
+    }
+
+    VecOwn<ram::Statement> loopBody;
+    for (auto& batch : batches) {
+        if (batch.statements.size() == 1) {
+            appendStmt(loopBody, std::move(batch.statements[0]));
+        } else {
+            appendStmt(loopBody, mk<ram::Parallel>(std::move(batch.statements)));
+        }
     }
     return mk<ram::Sequence>(std::move(loopBody));
 }
@@ -356,12 +748,15 @@ Own<ram::Statement> UnitTranslator::generateRecursiveStratum(
     // Add in the preamble
     appendStmt(result, generateStratumPreamble(scc));
 
-    // Add in the main fixpoint loop
-    auto loopBody = mk<ram::Parallel>(generateStratumLoopBody(scc));
+    // Add in the main fixpoint loop. Dominated tuples are pruned before the
+    // exit check: if an iteration derives only dominated tuples, the @new
+    // relations end up empty and the loop still terminates.
+    auto loopBody = generateStratumLoopBody(scc);
+    auto pruneSequence = generateStratumPruning(scc);
     auto exitSequence = generateStratumExitSequence(scc);
     auto updateSequence = generateStratumTableUpdates(scc);
-    auto fixpointLoop = mk<ram::Loop>(
-            mk<ram::Sequence>(std::move(loopBody), std::move(exitSequence), std::move(updateSequence)));
+    auto fixpointLoop = mk<ram::Loop>(mk<ram::Sequence>(std::move(loopBody), std::move(pruneSequence),
+            std::move(exitSequence), std::move(updateSequence)));
     appendStmt(result, std::move(fixpointLoop));
 
     // Add in the postamble
@@ -370,6 +765,58 @@ Own<ram::Statement> UnitTranslator::generateRecursiveStratum(
     return mk<ram::Sequence>(std::move(result));
 }
 
+/** generate RAM code folding facts inserted since the last evaluation into a stratum */
+Own<ram::Statement> UnitTranslator::generateUpdateStratum(std::size_t scc) const {
+    const auto& sccRelations = context->getRelationsInSCC(scc);
+
+    // Non-recursive strata are simply re-derived: insertion into the already
+    // materialised relation is idempotent, so only the rows enabled by the
+    // new facts are actually added
+    if (!context->isRecursiveSCC(scc)) {
+        assert(sccRelations.size() == 1 && "only one relation should exist in non-recursive stratum");
+        const auto* relation = *sccRelations.begin();
+        return mk<ram::Sequence>(
+                generateNonRecursiveRelation(*relation), generateSubsumptivePruning(relation, false));
+    }
+
+    // Recursive strata re-enter the semi-naive loop, with the difference to
+    // the retained previous fixpoint as the initial delta so unchanged
+    // derivations are not re-joined
+    VecOwn<ram::Statement> result;
+    VecOwn<ram::Statement> preamble;
+    for (const ast::Relation* rel : sccRelations) {
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string prevRelation = getPrevRelationName(rel->getQualifiedName());
+
+        // Re-run the non-recursive rules over the grown lower strata
+        appendStmt(preamble, generateNonRecursiveRelation(*rel));
+        appendStmt(preamble, generateSubsumptivePruning(rel, false));
+
+        if (rel->getRepresentation() != RelationRepresentation::EQREL) {
+            appendStmt(preamble, generateDiffRelations(rel, deltaRelation, mainRelation, prevRelation));
+        } else {
+            // Equivalence relations keep no per-tuple history; re-seed wholesale
+            appendStmt(preamble, generateMergeRelations(rel, deltaRelation, mainRelation));
+        }
+    }
+    appendStmt(result, mk<ram::Sequence>(std::move(preamble)));
+
+    // Re-enter the fixpoint loop; with an empty delta the first iteration
+    // derives nothing and the loop exits immediately
+    auto loopBody = generateStratumLoopBody(sccRelations);
+    auto pruneSequence = generateStratumPruning(sccRelations);
+    auto exitSequence = generateStratumExitSequence(sccRelations);
+    auto updateSequence = generateStratumTableUpdates(sccRelations);
+    appendStmt(result, mk<ram::Loop>(mk<ram::Sequence>(std::move(loopBody), std::move(pruneSequence),
+                               std::move(exitSequence), std::move(updateSequence))));
+
+    // The postamble also refreshes the retained fixpoint for the next update
+    appendStmt(result, generateStratumPostamble(sccRelations));
+
+    return mk<ram::Sequence>(std::move(result));
+}
+
 void UnitTranslator::addAuxiliaryArity(
         const ast::Relation* /* relation */, std::map<std::string, std::string>& directives) const {
     directives.insert(std::make_pair("auxArity", "0"));
@@ -377,6 +824,14 @@ void UnitTranslator::addAuxiliaryArity(
 
 Own<ram::Statement> UnitTranslator::generateLoadRelation(const ast::Relation* relation) const {
     VecOwn<ram::Statement> loadStmts;
+
+    // Facts for a choice relation are read into a staging relation and copied
+    // over with the functional dependencies imposed, so that input tuples
+    // violating a dependency are dropped on insert like derived tuples
+    bool guarded = !relation->getFunctionalDependencies().empty();
+    std::string targetRelationName = guarded ? getLoadRelationName(relation->getQualifiedName())
+                                             : getConcreteRelationName(relation->getQualifiedName());
+
     for (const auto* load : context->getLoadDirectives(relation->getQualifiedName())) {
         // Set up the corresponding directive map
         std::map<std::string, std::string> directives;
@@ -390,17 +845,46 @@ Own<ram::Statement> UnitTranslator::generateLoadRelation(const ast::Relation* re
 
         // Create the resultant load statement, with profile information
         std::string ramRelationName = getConcreteRelationName(relation->getQualifiedName());
-        Own<ram::Statement> loadStmt = mk<ram::IO>(ramRelationName, directives);
+        Own<ram::Statement> loadStmt = mk<ram::IO>(targetRelationName, directives);
         if (Global::config().has("profile")) {
             const std::string logTimerStatement =
                     LogStatement::tRelationLoadTime(ramRelationName, relation->getSrcLoc());
-            loadStmt = mk<ram::LogRelationTimer>(std::move(loadStmt), logTimerStatement, ramRelationName);
+            loadStmt = mk<ram::LogRelationTimer>(std::move(loadStmt), logTimerStatement, targetRelationName);
         }
         appendStmt(loadStmts, std::move(loadStmt));
     }
+
+    // Copy the staged facts over and drop the staging content
+    if (guarded && !loadStmts.empty()) {
+        appendStmt(loadStmts,
+                generateGuardedMergeRelations(relation, getConcreteRelationName(relation->getQualifiedName()),
+                        targetRelationName));
+        appendStmt(loadStmts, mk<ram::Clear>(targetRelationName));
+    }
     return mk<ram::Sequence>(std::move(loadStmts));
 }
 
+Own<ram::Statement> UnitTranslator::generateRestoreCheckpoint(const ast::Relation* relation) const {
+    VecOwn<ram::Statement> restoreStmts;
+    for (const auto* store : context->getStoreDirectives(relation->getQualifiedName())) {
+        // Only the checkpoint directive added for incremental evaluation; it
+        // carries the attributed types needed to parse the file back in.
+        if (!store->hasParameter("incremental-checkpoint")) {
+            continue;
+        }
+        std::map<std::string, std::string> directives;
+        for (const auto& [key, value] : store->getParameters()) {
+            directives.insert(std::make_pair(key, unescape(value)));
+        }
+        directives["operation"] = "input";
+        addAuxiliaryArity(relation, directives);
+
+        std::string prevRelationName = getPrevRelationName(relation->getQualifiedName());
+        appendStmt(restoreStmts, mk<ram::IO>(prevRelationName, directives));
+    }
+    return mk<ram::Sequence>(std::move(restoreStmts));
+}
+
 Own<ram::Statement> UnitTranslator::generateStoreRelation(const ast::Relation* relation) const {
     VecOwn<ram::Statement> storeStmts;
     for (const auto* store : context->getStoreDirectives(relation->getQualifiedName())) {
@@ -427,7 +911,12 @@ Own<ram::Statement> UnitTranslator::generateStoreRelation(const ast::Relation* r
 Own<ram::Relation> UnitTranslator::createRamRelation(
         const ast::Relation* baseRelation, std::string ramRelationName) const {
     auto arity = baseRelation->getArity();
-    auto representation = baseRelation->getRepresentation();
+    auto representation = context->getPreferredRepresentation(baseRelation);
+
+    // Subsumptive pruning erases tuples in place, which only the B-tree supports
+    if (representation == RelationRepresentation::DEFAULT && !getSubsumptiveClauses(*baseRelation).empty()) {
+        representation = RelationRepresentation::BTREE;
+    }
 
     std::vector<std::string> attributeNames;
     std::vector<std::string> attributeTypeQualifiers;
@@ -449,6 +938,21 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
             std::string mainName = getConcreteRelationName(rel->getQualifiedName());
             ramRelations.push_back(createRamRelation(rel, mainName));
 
+            // Choice relations with facts to load need a staging relation, so
+            // their functional dependencies can be imposed on the input tuples
+            if (!rel->getFunctionalDependencies().empty() &&
+                    !context->getLoadDirectives(rel->getQualifiedName()).empty()) {
+                std::string loadName = getLoadRelationName(rel->getQualifiedName());
+                ramRelations.push_back(createRamRelation(rel, loadName));
+            }
+
+            // Relations pruned by subsumptive clauses need a staging relation
+            // collecting the dominated tuples of each round
+            if (!getSubsumptiveClauses(*rel).empty()) {
+                std::string subsumedName = getSubsumedRelationName(rel->getQualifiedName());
+                ramRelations.push_back(createRamRelation(rel, subsumedName));
+            }
+
             // Recursive relations also require @delta and @new variants, with the same signature
             if (isRecursive) {
                 // Add delta relation
@@ -458,6 +962,13 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
                 // Add new relation
                 std::string newName = getNewRelationName(rel->getQualifiedName());
                 ramRelations.push_back(createRamRelation(rel, newName));
+
+                // Warm starts and live updates also require a @prev variant
+                // holding the previous fixpoint
+                if (hasRestorableCheckpoint() || hasLiveUpdates()) {
+                    std::string prevName = getPrevRelationName(rel->getQualifiedName());
+                    ramRelations.push_back(createRamRelation(rel, prevName));
+                }
             }
         }
     }
@@ -477,19 +988,68 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         // Generate the main stratum code
         auto stratum = generateStratum(sccOrdering.at(i));
 
-        // Clear expired relations
-        const auto& expiredRelations = context->getExpiredRelations(i);
-        stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
-
         // Add the subroutine
         std::string stratumID = "stratum_" + toString(i);
         addRamSubroutine(stratumID, std::move(stratum));
     }
 
-    // Invoke all strata
-    VecOwn<ram::Statement> res;
+    // With live updates, register an entry point folding facts inserted since
+    // the last evaluation into the fixpoint, which embedders (and the server
+    // mode) invoke instead of a full re-run. Maintenance is insert-only: a
+    // retraction, or new facts reaching a negation or an aggregate, still
+    // requires a fresh evaluation.
+    if (hasLiveUpdates()) {
+        VecOwn<ram::Statement> update;
+        for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+            appendStmt(update, generateUpdateStratum(sccOrdering.at(i)));
+        }
+        addRamSubroutine("update", mk<ram::Sequence>(std::move(update)));
+    }
+
+    // Assign each stratum its level in the SCC dependency DAG; strata on the
+    // same level have no precedence edges between them and may run
+    // concurrently
+    std::map<std::size_t, std::size_t> sccToStratum;
+    for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+        sccToStratum[sccOrdering.at(i)] = i;
+    }
+    std::vector<std::size_t> stratumLevel(sccOrdering.size(), 0);
+    std::size_t numLevels = 1;
     for (std::size_t i = 0; i < sccOrdering.size(); i++) {
-        appendStmt(res, mk<ram::Call>("stratum_" + toString(i)));
+        for (std::size_t pred : context->getPredecessorSCCs(sccOrdering.at(i))) {
+            stratumLevel[i] = std::max(stratumLevel[i], stratumLevel.at(sccToStratum.at(pred)) + 1);
+        }
+        numLevels = std::max(numLevels, stratumLevel[i] + 1);
+    }
+
+    // Invoke the strata level by level: the calls within a level form a
+    // parallel block, and the relations expired by a level are cleared once
+    // all of its strata are done, so no sibling can still be reading them
+    VecOwn<ram::Statement> res;
+    for (std::size_t level = 0; level < numLevels; level++) {
+        VecOwn<ram::Statement> calls;
+        for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+            if (stratumLevel[i] == level) {
+                appendStmt(calls, mk<ram::Call>("stratum_" + toString(i)));
+            }
+        }
+        if (calls.size() == 1) {
+            appendStmt(res, std::move(calls.at(0)));
+        } else {
+            appendStmt(res, mk<ram::Parallel>(std::move(calls)));
+        }
+
+        // Clear expired relations; with live updates every relation is read
+        // again by the update entry point, so nothing expires
+        for (std::size_t i = 0; i < sccOrdering.size(); i++) {
+            if (stratumLevel[i] != level || hasLiveUpdates()) {
+                continue;
+            }
+            const auto& expiredRelations = context->getExpiredRelations(i);
+            if (!expiredRelations.empty()) {
+                appendStmt(res, generateClearExpiredRelations(expiredRelations));
+            }
+        }
     }
 
     // Add main timer if profiling
@@ -24,6 +24,7 @@
 namespace souffle::ast {
 class Clause;
 class Relation;
+class SubsumptiveClause;
 class TranslationUnit;
 }  // namespace souffle::ast
 
@@ -66,21 +67,37 @@ protected:
     /** IO translation */
     Own<ram::Statement> generateStoreRelation(const ast::Relation* relation) const;
     Own<ram::Statement> generateLoadRelation(const ast::Relation* relation) const;
+    Own<ram::Statement> generateRestoreCheckpoint(const ast::Relation* relation) const;
 
     /** Low-level stratum translation */
     Own<ram::Statement> generateStratum(std::size_t scc) const;
+    Own<ram::Statement> generateUpdateStratum(std::size_t scc) const;
     Own<ram::Statement> generateStratumPreamble(const std::set<const ast::Relation*>& scc) const;
     Own<ram::Statement> generateStratumPostamble(const std::set<const ast::Relation*>& scc) const;
     Own<ram::Statement> generateStratumLoopBody(const std::set<const ast::Relation*>& scc) const;
     Own<ram::Statement> generateStratumTableUpdates(const std::set<const ast::Relation*>& scc) const;
+    Own<ram::Statement> generateStratumPruning(const std::set<const ast::Relation*>& scc) const;
     Own<ram::Statement> generateStratumExitSequence(const std::set<const ast::Relation*>& scc) const;
 
+    /** Subsumptive clause translation */
+    std::vector<const ast::SubsumptiveClause*> getSubsumptiveClauses(const ast::Relation& rel) const;
+    Own<ram::Statement> generateSubsumptiveStaging(const ast::SubsumptiveClause& clause,
+            const std::string& dominatedRelation, const std::string& dominatingRelation,
+            const std::string& stagingRelation) const;
+    Own<ram::Statement> generateEraseStagedTuples(const ast::Relation* rel,
+            const std::string& stagingRelation, const std::string& destRelation) const;
+    Own<ram::Statement> generateSubsumptivePruning(const ast::Relation* rel, bool withinFixpoint) const;
+
     /** Other helper generations */
     virtual Own<ram::Statement> generateClearExpiredRelations(
             const std::set<const ast::Relation*>& expiredRelations) const;
     Own<ram::Statement> generateClearRelation(const ast::Relation* relation) const;
     virtual Own<ram::Statement> generateMergeRelations(
             const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const;
+    Own<ram::Statement> generateGuardedMergeRelations(
+            const ast::Relation* rel, const std::string& destRelation, const std::string& srcRelation) const;
+    Own<ram::Statement> generateDiffRelations(const ast::Relation* rel, const std::string& destRelation,
+            const std::string& srcRelation, const std::string& filterRelation) const;
 
 private:
     std::map<std::string, Own<ram::Statement>> ramSubroutines;
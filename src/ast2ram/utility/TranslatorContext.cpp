@@ -18,9 +18,11 @@
 #include "ast/BranchInit.h"
 #include "ast/Directive.h"
 #include "ast/QualifiedName.h"
+#include "ast/Relation.h"
 #include "ast/TranslationUnit.h"
 #include "ast/analysis/Functor.h"
 #include "ast/analysis/IOType.h"
+#include "ast/analysis/ProfileUse.h"
 #include "ast/analysis/RecursiveClauses.h"
 #include "ast/analysis/RelationDetailCache.h"
 #include "ast/analysis/RelationSchedule.h"
@@ -60,6 +62,7 @@ TranslatorContext::TranslatorContext(const ast::TranslationUnit& tu) {
     typeEnv = &tu.getAnalysis<ast::analysis::TypeEnvironmentAnalysis>().getTypeEnvironment();
     sumTypeBranches = &tu.getAnalysis<ast::analysis::SumTypeBranchesAnalysis>();
     polyAnalysis = &tu.getAnalysis<ast::analysis::PolymorphicObjectsAnalysis>();
+    profileUse = &tu.getAnalysis<ast::analysis::ProfileUseAnalysis>();
 
     // Set up clause nums
     for (const ast::Relation* rel : program->getRelations()) {
@@ -110,6 +113,10 @@ bool TranslatorContext::isRecursiveSCC(std::size_t scc) const {
     return sccGraph->isRecursive(scc);
 }
 
+const std::set<std::size_t>& TranslatorContext::getPredecessorSCCs(std::size_t scc) const {
+    return sccGraph->getPredecessorSCCs(scc);
+}
+
 std::vector<ast::Directive*> TranslatorContext::getStoreDirectives(const ast::QualifiedName& name) const {
     return filter(getDirectives(*program, name), [&](const ast::Directive* dir) {
         return dir->getType() == ast::DirectiveType::printsize ||
@@ -131,6 +138,33 @@ std::size_t TranslatorContext::getSizeLimit(const ast::Relation* relation) const
     return ioType->getLimitSize(relation);
 }
 
+RelationRepresentation TranslatorContext::getPreferredRepresentation(const ast::Relation* relation) const {
+    auto representation = relation->getRepresentation();
+
+    // representations explicitly chosen by the user are kept as they are
+    if (representation != RelationRepresentation::DEFAULT) {
+        return representation;
+    }
+
+    // without profile data there is no basis for a better choice
+    const auto& name = relation->getQualifiedName();
+    if (!Global::config().has("profile-use") || !profileUse->hasRelationSize(name)) {
+        return representation;
+    }
+
+    // large relations that are filled more than they are queried benefit
+    // from the compact prefix sharing of the brie; lookup-heavy relations
+    // stay on the default btree, whose operation hints favour repeated
+    // searches
+    constexpr std::size_t largeRelationThreshold = 1u << 22;
+    std::size_t size = profileUse->getRelationSize(name);
+    std::size_t reads = profileUse->getRelationReads(name);
+    if (relation->getArity() > 0 && size >= largeRelationThreshold && reads <= size) {
+        return RelationRepresentation::BRIE;
+    }
+    return representation;
+}
+
 const ast::Relation* TranslatorContext::getAtomRelation(const ast::Atom* atom) const {
     return ast::getAtomRelation(atom, program);
 }
@@ -16,6 +16,7 @@
 
 #include "AggregateOp.h"
 #include "FunctorOps.h"
+#include "RelationTag.h"
 #include "ast/NumericConstant.h"
 #include "ast/analysis/typesystem/Type.h"
 #include "souffle/BinaryConstraintOps.h"
@@ -53,6 +54,7 @@ namespace souffle::ast::analysis {
 class FunctorAnalysis;
 class IOTypeAnalysis;
 class PolymorphicObjectsAnalysis;
+class ProfileUseAnalysis;
 class RecursiveClausesAnalysis;
 class RelationDetailCacheAnalysis;
 class RelationScheduleAnalysis;
@@ -83,6 +85,7 @@ public:
     std::string getAttributeTypeQualifier(const ast::QualifiedName& name) const;
     bool hasSizeLimit(const ast::Relation* relation) const;
     std::size_t getSizeLimit(const ast::Relation* relation) const;
+    RelationRepresentation getPreferredRepresentation(const ast::Relation* relation) const;
 
     /** Clause methods */
     std::vector<ast::Clause*> getClauses(const ast::QualifiedName& name) const;
@@ -92,6 +95,7 @@ public:
     /** SCC methods */
     std::size_t getNumberOfSCCs() const;
     bool isRecursiveSCC(std::size_t scc) const;
+    const std::set<std::size_t>& getPredecessorSCCs(std::size_t scc) const;
     std::set<const ast::Relation*> getExpiredRelations(std::size_t scc) const;
     std::set<const ast::Relation*> getRelationsInSCC(std::size_t scc) const;
     std::set<const ast::Relation*> getInputRelationsInSCC(std::size_t scc) const;
@@ -140,6 +144,7 @@ private:
     const ast::analysis::TypeEnvironment* typeEnv;
     const ast::analysis::SumTypeBranchesAnalysis* sumTypeBranches;
     const ast::analysis::PolymorphicObjectsAnalysis* polyAnalysis;
+    const ast::analysis::ProfileUseAnalysis* profileUse;
     std::map<const ast::Clause*, std::size_t> clauseNums;
     Own<ast::SipsMetric> sipsMetric;
     Own<TranslationStrategy> translationStrategy;
@@ -47,12 +47,26 @@ std::string getNewRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@new_");
 }
 
+std::string getPrevRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@prev_");
+}
+
+std::string getLoadRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@load_");
+}
+
+std::string getSubsumedRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@subsumed_");
+}
+
 std::string getRelationName(const ast::QualifiedName& name) {
     return toString(join(name.getQualifiers(), "."));
 }
 
 std::string getBaseRelationName(const ast::QualifiedName& name) {
-    return stripPrefix("@new_", stripPrefix("@delta_", stripPrefix("@info_", name.toString())));
+    return stripPrefix("@new_",
+            stripPrefix("@delta_", stripPrefix("@prev_", stripPrefix("@load_", stripPrefix("@subsumed_",
+                                                                 stripPrefix("@info_", name.toString()))))));
 }
 
 void appendStmt(VecOwn<ram::Statement>& stmtList, Own<ram::Statement> stmt) {
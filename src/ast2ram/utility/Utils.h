@@ -49,6 +49,15 @@ std::string getDeltaRelationName(const ast::QualifiedName& name);
 /** Get the corresponding RAM 'new' relation name for the relation */
 std::string getNewRelationName(const ast::QualifiedName& name);
 
+/** Get the corresponding RAM 'prev' relation name for the relation */
+std::string getPrevRelationName(const ast::QualifiedName& name);
+
+/** Get the corresponding RAM staging relation name for facts loaded into a choice relation */
+std::string getLoadRelationName(const ast::QualifiedName& name);
+
+/** Get the corresponding RAM staging relation name for tuples dominated under a subsumptive clause */
+std::string getSubsumedRelationName(const ast::QualifiedName& name);
+
 /** Get base relation name, strip off any possible prefix */
 std::string getBaseRelationName(const ast::QualifiedName& name);
 
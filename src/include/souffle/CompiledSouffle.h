@@ -16,13 +16,19 @@
 
 #pragma once
 
+#include "souffle/ConvergenceMonitor.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SignalHandler.h"
 #include "souffle/SouffleInterface.h"
 #include "souffle/SymbolTable.h"
+#include "souffle/datastructure/BTreeCommon.h"
+#include "souffle/datastructure/BloomFilter.h"
 #include "souffle/datastructure/Brie.h"
+#include "souffle/datastructure/ConcurrentInsertOnlyHashSet.h"
 #include "souffle/datastructure/EquivalenceRelation.h"
+#include "souffle/datastructure/HyperLogLog.h"
+#include "souffle/datastructure/IntervalSet.h"
 #include "souffle/datastructure/Table.h"
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/WriteStream.h"
@@ -35,6 +41,29 @@
 #include <omp.h>
 #endif
 
+/**
+ * Branch hint for generated code: marks a condition that is expected to be
+ * false on the hot path, such as the exit test of a fixpoint loop.
+ */
+#if defined(__GNUC__)
+#define SOUFFLE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define SOUFFLE_UNLIKELY(x) (x)
+#endif
+
+/**
+ * Function attributes for generated code: cold functions are kept out of
+ * line and placed away from the hot text so that query loops stay dense in
+ * the instruction cache; hot functions are clustered together by the linker.
+ */
+#if defined(__GNUC__)
+#define SOUFFLE_COLD __attribute__((cold, noinline))
+#define SOUFFLE_HOT __attribute__((hot))
+#else
+#define SOUFFLE_COLD
+#define SOUFFLE_HOT
+#endif
+
 namespace souffle {
 
 extern "C" {
@@ -85,6 +114,9 @@ private:
             return new iterator_wrapper(*this);
         }
 
+        // batch extraction reaches through to the typed iterator
+        friend RelationWrapper;
+
     protected:
         bool equal(const iterator_base& o) const override {
             const auto& casted = asAssert<iterator_wrapper>(o);
@@ -114,6 +146,31 @@ public:
         }
         relation.insert(t);
     }
+    void insertBatch(const RamDomain* data, std::size_t count) override {
+        auto ctxt = relation.createContext();
+        TupleType t;
+        for (std::size_t i = 0; i < count; i++) {
+            for (std::size_t j = 0; j < Arity; j++) {
+                t[j] = data[i * Arity + j];
+            }
+            relation.insert(t, ctxt);
+        }
+    }
+    std::size_t extractBatch(iterator& it, RamDomain* buffer, std::size_t maxRows) const override {
+        auto& typedIt = asAssert<iterator_wrapper>(it.base()).it;
+        const auto stop = relation.end();
+        std::size_t rows = 0;
+        for (; rows < maxRows && typedIt != stop; ++typedIt, ++rows) {
+            auto&& value = *typedIt;
+            for (std::size_t j = 0; j < Arity; j++) {
+                buffer[rows * Arity + j] = value[j];
+            }
+        }
+        return rows;
+    }
+    std::vector<std::pair<iterator, iterator>> partition(std::size_t chunks) const override {
+        return partition(relation, chunks == 0 ? 1 : chunks, 0);
+    }
     bool contains(const tuple& arg) const override {
         TupleType t;
         assert(arg.size() == Arity && "wrong tuple arity");
@@ -125,6 +182,9 @@ public:
     std::size_t size() const override {
         return relation.size();
     }
+    std::size_t getMemoryUsage() const override {
+        return getMemoryUsage(relation, 0);
+    }
     std::string getName() const override {
         return name;
     }
@@ -150,6 +210,41 @@ public:
     void purge() override {
         relation.purge();
     }
+
+private:
+    /** Defer to the generated relation's memory accounting when it has any. */
+    template <typename R>
+    static auto getMemoryUsage(const R& relation, int) -> decltype(relation.getMemoryUsage()) {
+        return relation.getMemoryUsage();
+    }
+
+    /** Reuse the generated relation's index partitioning, merging its chunks
+     * down to approximately the requested count. */
+    template <typename R>
+    auto partition(const R& rel, std::size_t chunks, int) const
+            -> decltype(rel.partition(), std::vector<std::pair<iterator, iterator>>()) {
+        std::vector<std::pair<iterator, iterator>> res;
+        const auto parts = rel.partition();
+        const std::size_t count = parts.size();
+        const std::size_t group = count <= chunks ? 1 : (count + chunks - 1) / chunks;
+        for (std::size_t i = 0; i < count; i += group) {
+            const auto& last = parts[std::min(i + group, count) - 1];
+            res.emplace_back(iterator(mk<iterator_wrapper>(id, this, parts[i].begin())),
+                    iterator(mk<iterator_wrapper>(id, this, last.end())));
+        }
+        return res;
+    }
+
+    /** Fall back to the serial counting split for relations without one. */
+    template <typename R>
+    std::vector<std::pair<iterator, iterator>> partition(const R&, std::size_t chunks, long) const {
+        return Relation::partition(chunks);
+    }
+
+    template <typename R>
+    static std::size_t getMemoryUsage(const R&, long) {
+        return 0;
+    }
 };
 
 /** Nullary relations */
@@ -233,6 +328,7 @@ public:
         data = false;
     }
     void printStatistics(std::ostream& /* o */) const {}
+    void addHintStatistics(const std::string& /* relation */) const {}
 };
 
 /** Info relations */
@@ -316,6 +412,7 @@ public:
         data.clear();
     }
     void printStatistics(std::ostream& /* o */) const {}
+    void addHintStatistics(const std::string& /* relation */) const {}
 
 private:
     std::vector<Tuple<RamDomain, Arity>> data;
@@ -474,6 +571,7 @@ struct t_eqrel {
         return res;
     }
     void printStatistics(std::ostream& /* o */) const {}
+    void addHintStatistics(const std::string& /* relation */) const {}
 };
 
 }  // namespace souffle
@@ -0,0 +1,110 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ConvergenceMonitor.h
+ *
+ * Watches the per-iteration delta cardinalities of the semi-naive
+ * fixpoint loops and raises an alarm when the deltas grow instead of
+ * shrink for a configurable number of consecutive iterations — an early
+ * warning that a recursive computation is diverging, long before memory
+ * runs out.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/SignalHandler.h"
+#include <cstddef>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+
+namespace souffle {
+
+/**
+ * Tracks the total number of delta tuples produced by each iteration of a
+ * fixpoint loop. Enabled by setting SOUFFLE_DELTA_ALARM to the number of
+ * consecutive growing iterations that should trigger the alarm; when
+ * SOUFFLE_DELTA_ALARM_ABORT is also set, the alarm terminates evaluation
+ * instead of only reporting.
+ */
+class ConvergenceMonitor {
+public:
+    ConvergenceMonitor() {
+        if (const char* env = std::getenv("SOUFFLE_DELTA_ALARM")) {
+            threshold = std::strtoul(env, nullptr, 10);
+        }
+        abortOnAlarm = (std::getenv("SOUFFLE_DELTA_ALARM_ABORT") != nullptr);
+    }
+
+    /** true when an alarm threshold has been configured */
+    bool enabled() const {
+        return threshold > 0;
+    }
+
+    /** start watching a new fixpoint loop */
+    void beginLoop() {
+        previousDelta = 0;
+        currentDelta = 0;
+        growingIterations = 0;
+        alarmed = false;
+    }
+
+    /** add the delta cardinality of one relation for the current iteration */
+    void addDelta(const std::size_t deltaSize) {
+        currentDelta += deltaSize;
+    }
+
+    /** close the current iteration and check the convergence trend */
+    void endIteration(const std::size_t iteration) {
+        if (!enabled()) {
+            return;
+        }
+        if (previousDelta > 0 && currentDelta > previousDelta) {
+            ++growingIterations;
+        } else {
+            growingIterations = 0;
+        }
+        if (growingIterations >= threshold && !alarmed) {
+            alarmed = true;
+            std::stringstream warning;
+            warning << "warning: fixpoint may be diverging: delta tuples grew for " << growingIterations
+                    << " consecutive iterations (" << currentDelta << " tuples at iteration " << iteration
+                    << ")";
+            if (abortOnAlarm) {
+                SignalHandler::instance()->error(warning.str());
+            }
+            SignalHandler::instance()->alert(warning.str());
+        }
+        previousDelta = currentDelta;
+        currentDelta = 0;
+    }
+
+private:
+    /** consecutive growing iterations that trigger the alarm; 0 disables */
+    std::size_t threshold = 0;
+
+    /** terminate evaluation when the alarm fires */
+    bool abortOnAlarm = false;
+
+    /** summed delta cardinality of the previous iteration */
+    std::size_t previousDelta = 0;
+
+    /** summed delta cardinality of the iteration being executed */
+    std::size_t currentDelta = 0;
+
+    /** current length of the growing streak */
+    std::size_t growingIterations = 0;
+
+    /** alarm already reported for this loop */
+    bool alarmed = false;
+};
+
+}  // namespace souffle
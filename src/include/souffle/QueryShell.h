@@ -0,0 +1,349 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file QueryShell.h
+ *
+ * An interactive shell for ad-hoc queries against a computed program.
+ * After evaluation the relations stay loaded in memory, and conjunctive
+ * queries over them — constants, quoted symbols and shared variables —
+ * are answered directly from the resident data, sparing a rerun with
+ * extra outputs or a grep over the serialised results. The query
+ * machinery mirrors the `query` command of the provenance explain
+ * interface, but requires no provenance instrumentation.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/SouffleInterface.h"
+// reused for the query utilities (Equivalence, ConstConstraint, split);
+// nothing provenance-specific is pulled in
+#include "souffle/provenance/ExplainProvenance.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+namespace souffle {
+
+class QueryShell {
+public:
+    explicit QueryShell(SouffleProgram& prog) : prog(prog) {}
+
+    /** The main interactive loop; returns once the user quits. */
+    void run() {
+        printPrompt("Query shell: type `help` for the available commands.\n");
+        while (true) {
+            printPrompt("query> ");
+            std::string line;
+            if (!getline(std::cin, line)) {
+                break;
+            }
+            if (!processCommand(line)) {
+                break;
+            }
+        }
+    }
+
+private:
+    SouffleProgram& prog;
+
+    /** Process one input line; false indicates the shell should exit. */
+    bool processCommand(const std::string& line) {
+        std::vector<std::string> command = split(line, ' ', 1);
+        if (command.empty()) {
+            return true;
+        }
+
+        if (command[0] == "exit" || command[0] == "q" || command[0] == "quit") {
+            return false;
+        } else if (command[0] == "relations" || command[0] == "rels") {
+            for (const Relation* rel : prog.getAllRelations()) {
+                std::cout << rel->getName() << "/" << +rel->getPrimaryArity() << ": " << rel->size()
+                          << " tuples\n";
+            }
+        } else if (command[0] == "help") {
+            std::cout << "\n----------\n"
+                         "Commands:\n"
+                         "----------\n"
+                         "<relation1>(<element1>, ...), <relation2>(<element1>, ...), ... :\n"
+                         "    evaluate a conjunctive query; elements are numbers, quoted symbols\n"
+                         "    or variables, and variables shared between atoms must agree\n"
+                         "relations: list the relations with their arity and cardinality\n"
+                         "exit: exit the shell\n\n";
+        } else {
+            processQuery(line);
+        }
+
+        return true;
+    }
+
+    /** Parse the given line as a conjunction of atoms and answer it. */
+    void processQuery(const std::string& line) {
+        // atoms take the form R(arg, ...) where an argument is a number, a
+        // quoted symbol or a variable name
+        std::regex atomRegex(
+                "([a-zA-Z0-9_.-]*)[[:blank:]]*\\(([[:blank:]]*([0-9]+|\"[^\"]*\"|[a-zA-Z_][a-zA-Z_0-9]*)([[:"
+                "blank:]]*,[[:blank:]]*([0-9]+|\"[^\"]*\"|[a-zA-Z_][a-zA-Z_0-9]*))*)?\\)",
+                std::regex_constants::extended);
+        std::regex argRegex(R"([0-9]+|"[^"]*"|[a-zA-Z_][a-zA-Z_0-9]*)", std::regex_constants::extended);
+
+        std::vector<std::pair<std::string, std::vector<std::string>>> atoms;
+        std::smatch atomMatcher;
+        std::string rest = line;
+        while (std::regex_search(rest, atomMatcher, atomRegex)) {
+            std::string atom = atomMatcher[0];
+            std::smatch relMatch;
+            std::regex_match(atom, relMatch, atomRegex);
+            std::vector<std::string> args;
+            std::string argsList = relMatch[2];
+            std::smatch argsMatcher;
+            while (std::regex_search(argsList, argsMatcher, argRegex)) {
+                args.push_back(argsMatcher[0]);
+                argsList = argsMatcher.suffix().str();
+            }
+            atoms.push_back(std::make_pair(relMatch[1], std::move(args)));
+            rest = atomMatcher.suffix().str();
+        }
+
+        if (atoms.empty()) {
+            std::cout << "Usage: <relation1>(<element1>, ...), <relation2>(<element1>, ...), ...\n"
+                         "or `help` for the available commands\n";
+            return;
+        }
+
+        evaluate(atoms);
+    }
+
+    /**
+     * Answer a conjunctive query: atoms without variables are checked by a
+     * direct membership test, the remaining atoms are joined by enumerating
+     * their product and verifying the variable equivalences and constant
+     * constraints on each combination.
+     */
+    void evaluate(const std::vector<std::pair<std::string, std::vector<std::string>>>& atoms) {
+        std::regex varRegex("[a-zA-Z_][a-zA-Z_0-9]*", std::regex_constants::extended);
+        std::regex symbolRegex("\"([^\"]*)\"", std::regex_constants::extended);
+
+        std::smatch argsMatcher;
+
+        // equivalence class per variable name
+        std::map<std::string, Equivalence> nameToEquivalence;
+
+        // constant constraints a solution must satisfy
+        ConstConstraint constConstraints;
+
+        // the atoms containing variables, in product order
+        std::vector<Relation*> varRels;
+        std::size_t idx = 0;
+
+        for (const auto& atom : atoms) {
+            Relation* relation = prog.getRelation(atom.first);
+            if (relation == nullptr) {
+                std::cout << "Relation <" << atom.first << "> does not exist" << std::endl;
+                return;
+            }
+            if (relation->getPrimaryArity() != atom.second.size()) {
+                std::cout << "<" << atom.first << "> has arity of " << +relation->getPrimaryArity()
+                          << std::endl;
+                return;
+            }
+
+            // constant values of the atom, in case it contains no variable
+            std::vector<RamDomain> constTuple;
+            bool containVar = false;
+            for (std::size_t j = 0; j < atom.second.size(); ++j) {
+                if (std::regex_match(atom.second[j], argsMatcher, varRegex)) {
+                    containVar = true;
+                    auto iter = nameToEquivalence.find(argsMatcher[0]);
+                    if (iter == nameToEquivalence.end()) {
+                        nameToEquivalence.insert({argsMatcher[0],
+                                Equivalence(*(relation->getAttrType(j)), argsMatcher[0],
+                                        std::make_pair(idx, j))});
+                    } else {
+                        iter->second.push_back(std::make_pair(idx, j));
+                    }
+                    continue;
+                }
+
+                RamDomain rd;
+                switch (*(relation->getAttrType(j))) {
+                    case 's':
+                        if (!std::regex_match(atom.second[j], argsMatcher, symbolRegex)) {
+                            std::cout << atom.second[j] << " does not match type defined in relation"
+                                      << std::endl;
+                            return;
+                        }
+                        rd = prog.getSymbolTable().encode(argsMatcher[1]);
+                        break;
+                    case 'f':
+                        if (!canBeParsedAsRamFloat(atom.second[j])) {
+                            std::cout << atom.second[j] << " does not match type defined in relation"
+                                      << std::endl;
+                            return;
+                        }
+                        rd = ramBitCast(RamFloatFromString(atom.second[j]));
+                        break;
+                    case 'i':
+                        if (!canBeParsedAsRamSigned(atom.second[j])) {
+                            std::cout << atom.second[j] << " does not match type defined in relation"
+                                      << std::endl;
+                            return;
+                        }
+                        rd = ramBitCast(RamSignedFromString(atom.second[j]));
+                        break;
+                    case 'u':
+                        if (!canBeParsedAsRamUnsigned(atom.second[j])) {
+                            std::cout << atom.second[j] << " does not match type defined in relation"
+                                      << std::endl;
+                            return;
+                        }
+                        rd = ramBitCast(RamUnsignedFromString(atom.second[j]));
+                        break;
+                    default: continue;
+                }
+
+                constConstraints.push_back(std::make_pair(std::make_pair(idx, j), rd));
+                if (!containVar) {
+                    constTuple.push_back(rd);
+                }
+            }
+
+            if (!containVar) {
+                // a ground atom is a plain membership test; satisfied, its
+                // constraints are discharged, otherwise the query is false
+                if (containsTuple(relation, constTuple)) {
+                    constConstraints.getConstraints().erase(
+                            constConstraints.getConstraints().end() - atom.second.size(),
+                            constConstraints.getConstraints().end());
+                } else {
+                    std::cout << "false." << std::endl;
+                    return;
+                }
+            } else {
+                varRels.push_back(relation);
+                ++idx;
+            }
+        }
+
+        // all atoms were ground and present
+        if (varRels.empty()) {
+            std::cout << "true." << std::endl;
+            return;
+        }
+
+        findSolutions(varRels, nameToEquivalence, constConstraints);
+    }
+
+    /** Enumerate and print every solution of the parameterised query. */
+    void findSolutions(const std::vector<Relation*>& varRels,
+            const std::map<std::string, Equivalence>& nameToEquivalence,
+            const ConstConstraint& constConstraints) {
+        std::vector<Relation::iterator> iterators;
+        for (Relation* relation : varRels) {
+            if (relation->begin() == relation->end()) {
+                // an empty atom admits no binding
+                std::cout << "no solution\n";
+                return;
+            }
+            iterators.push_back(relation->begin());
+        }
+
+        std::size_t solutionCount = 0;
+        while (true) {
+            // the candidate combination the iterators point to
+            std::vector<tuple> product;
+            for (auto& it : iterators) {
+                product.push_back(*it);
+            }
+
+            bool isSolution = constConstraints.verify(product);
+            for (auto var = nameToEquivalence.begin(); isSolution && var != nameToEquivalence.end(); ++var) {
+                isSolution = var->second.verify(product);
+            }
+
+            if (isSolution) {
+                std::size_t c = 0;
+                for (auto&& var : nameToEquivalence) {
+                    const auto& first = var.second.getFirstIdx();
+                    const RamDomain raw = product[first.first][first.second];
+
+                    std::cout << var.second.getSymbol() << " = ";
+                    switch (var.second.getType()) {
+                        case 'i': std::cout << ramBitCast<RamSigned>(raw); break;
+                        case 'f': std::cout << ramBitCast<RamFloat>(raw); break;
+                        case 'u': std::cout << ramBitCast<RamUnsigned>(raw); break;
+                        case 's': std::cout << prog.getSymbolTable().decode(raw); break;
+                        default: fatal("invalid type: `%c`", var.second.getType());
+                    }
+                    if (++c < nameToEquivalence.size()) {
+                        std::cout << ", ";
+                    }
+                }
+                std::cout << "\n";
+                ++solutionCount;
+            }
+
+            // advance the iterators in product order
+            std::size_t i = varRels.size() - 1;
+            bool exhausted = true;
+            for (auto it = iterators.rbegin(); it != iterators.rend(); ++it) {
+                if (++(*it) != varRels[i]->end()) {
+                    exhausted = false;
+                    break;
+                }
+                *it = varRels[i]->begin();
+                --i;
+            }
+            if (exhausted) {
+                break;
+            }
+        }
+
+        if (solutionCount == 0) {
+            std::cout << "no solution\n";
+        } else {
+            std::cout << solutionCount << " solution(s)\n";
+        }
+    }
+
+    /** Whether the relation holds the given ground tuple. */
+    static bool containsTuple(Relation* relation, const std::vector<RamDomain>& constTuple) {
+        for (auto it = relation->begin(); it != relation->end(); ++it) {
+            bool eq = true;
+            for (std::size_t j = 0; j < constTuple.size(); ++j) {
+                if (constTuple[j] != (*it)[j]) {
+                    eq = false;
+                    break;
+                }
+            }
+            if (eq) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Print a command prompt, disabled for non-terminal inputs. */
+    static void printPrompt(const std::string& prompt) {
+        if (isatty(fileno(stdin)) == 0) {
+            return;
+        }
+        std::cout << prompt;
+    }
+};
+
+}  // namespace souffle
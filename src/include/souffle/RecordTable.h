@@ -12,6 +12,8 @@
  *
  * Data container implementing a map between records and their references.
  * Records are separated by arity, i.e., stored in different RecordMaps.
+ * Records of arity 1 and 2 whose fields are small enough are encoded
+ * inline in the (negative) reference value and bypass the maps entirely.
  *
  ***********************************************************************/
 
@@ -20,8 +22,10 @@
 #include "souffle/RamTypes.h"
 #include "souffle/datastructure/ConcurrentFlyweight.h"
 #include "souffle/utility/span.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -40,6 +44,61 @@ constexpr void constexpr_for(F&& f) {
     }
 }
 
+/// @brief Maximum arity for which records may be encoded inline in the reference.
+constexpr std::size_t MaxInlineArity = 2;
+
+/// @brief Number of payload bits available per field of an inline record.
+constexpr std::size_t inlineFieldBits(const std::size_t Arity) {
+    return (static_cast<std::size_t>(RAM_DOMAIN_SIZE) - 1) / Arity;
+}
+
+/// @brief Tests whether records of the given arity are candidates for inline encoding.
+constexpr bool isInlineArity(const std::size_t Arity) {
+    return Arity >= 1 && Arity <= MaxInlineArity;
+}
+
+/**
+ * @brief Tests whether a record reference carries an inline-encoded record.
+ *
+ * References handed out by the record maps are strictly positive indices, so
+ * the sign bit is free to serve as the inline tag. Inline references are
+ * therefore negative and can never collide with nil (0) or a map index.
+ */
+constexpr bool isInlineRef(const RamDomain Ref) {
+    return Ref < 0;
+}
+
+/// @brief Tests whether every field of the record fits into its inline payload slot.
+inline bool fitsInline(const RamDomain* Tuple, const std::size_t Arity) {
+    const RamUnsigned Limit = RamUnsigned(1) << inlineFieldBits(Arity);
+    for (std::size_t I = 0; I < Arity; ++I) {
+        if (Tuple[I] < 0 || static_cast<RamUnsigned>(Tuple[I]) >= Limit) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// @brief Encodes a record that fitsInline directly into a (negative) record reference.
+inline RamDomain encodeInline(const RamDomain* Tuple, const std::size_t Arity) {
+    const std::size_t Bits = inlineFieldBits(Arity);
+    RamUnsigned Ref = RamUnsigned(1) << (RAM_DOMAIN_SIZE - 1);
+    for (std::size_t I = 0; I < Arity; ++I) {
+        Ref |= static_cast<RamUnsigned>(Tuple[I]) << (I * Bits);
+    }
+    return ramBitCast<RamDomain>(Ref);
+}
+
+/// @brief Decodes an inline record reference into the given field buffer.
+inline void decodeInline(const RamDomain Ref, const std::size_t Arity, RamDomain* Out) {
+    const std::size_t Bits = inlineFieldBits(Arity);
+    const RamUnsigned Mask = (RamUnsigned(1) << Bits) - 1;
+    const RamUnsigned Payload = ramBitCast<RamUnsigned>(Ref);
+    for (std::size_t I = 0; I < Arity; ++I) {
+        Out[I] = ramBitCast<RamDomain>((Payload >> (I * Bits)) & Mask);
+    }
+}
+
 /// @brief The data-type of RamDomain records of any size.
 using GenericRecord = std::vector<RamDomain>;
 
@@ -343,7 +402,34 @@ public:
     virtual RamDomain pack(const std::vector<RamDomain>& Vector) = 0;
     virtual RamDomain pack(const RamDomain* Tuple) = 0;
     virtual RamDomain pack(const std::initializer_list<RamDomain>& List) = 0;
+
+    /** @brief converts Count contiguous records to record references */
+    virtual void packBatch(const RamDomain* Tuples, const std::size_t Count, RamDomain* OutRefs) {
+        for (std::size_t I = 0; I < Count; ++I) {
+            OutRefs[I] = pack(Tuples + I * arity());
+        }
+    }
+
+    /** @brief pre-size the map for the given number of records */
+    virtual void reserve(const std::size_t /* NumRecords */) {}
+
     virtual const RamDomain* unpack(RamDomain index) const = 0;
+    virtual void enumerate(const std::function<void(RamDomain, const RamDomain*)>& Callback) const = 0;
+
+    /** @brief release the records whose reference the predicate does not
+     * report as live; see RecordTable::sweep */
+    virtual std::size_t sweep(const std::function<bool(RamDomain)>& /* IsLive */) {
+        return 0;
+    }
+
+    /** @brief approximate the number of bytes used by the stored records */
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
+
+protected:
+    /** @brief the arity of the records in this map */
+    virtual std::size_t arity() const = 0;
 };
 
 /** @brief Bidirectional mappping between records and record references, for any record arity. */
@@ -384,10 +470,46 @@ public:
         return findOrInsert(View).first;
     }
 
+    /** @brief converts Count contiguous records to record references */
+    void packBatch(const RamDomain* Tuples, const std::size_t Count, RamDomain* OutRefs) override {
+        for (std::size_t I = 0; I < Count; ++I) {
+            details::GenericRecordView View{Tuples + I * Arity, Arity};
+            OutRefs[I] = findOrInsert(View).first;
+        }
+    }
+
+    /** @brief pre-size the map for the given number of records */
+    void reserve(const std::size_t NumRecords) override {
+        Base::reserve(NumRecords);
+    }
+
     /** @brief convert record reference to a record pointer */
     const RamDomain* unpack(RamDomain Index) const override {
         return fetch(Index).data();
     }
+
+    /** @brief enumerates the stored records together with their references */
+    void enumerate(const std::function<void(RamDomain, const RamDomain*)>& Callback) const override {
+        for (auto It = Base::begin(); It != Base::end(); ++It) {
+            Callback(static_cast<RamDomain>(It->second), It->first.data());
+        }
+    }
+
+    /** @brief approximate the number of bytes used by the stored records */
+    std::size_t getMemoryUsage() const override {
+        return Base::getMemoryUsage();
+    }
+
+    /** @brief release the records whose reference is not live */
+    std::size_t sweep(const std::function<bool(RamDomain)>& IsLive) override {
+        return Base::sweep(
+                [&](const std::size_t Index) { return IsLive(static_cast<RamDomain>(Index)); });
+    }
+
+protected:
+    std::size_t arity() const override {
+        return Arity;
+    }
 };
 
 /** @brief Bidirectional mappping between records and record references, specialized for a record arity. */
@@ -433,10 +555,46 @@ public:
         return Base::findOrInsert(View).first;
     }
 
+    /** @brief converts Count contiguous records to record references */
+    void packBatch(const RamDomain* Tuples, const std::size_t Count, RamDomain* OutRefs) override {
+        for (std::size_t I = 0; I < Count; ++I) {
+            RecordView View{Tuples + I * Arity};
+            OutRefs[I] = Base::findOrInsert(View).first;
+        }
+    }
+
+    /** @brief pre-size the map for the given number of records */
+    void reserve(const std::size_t NumRecords) override {
+        Base::reserve(NumRecords);
+    }
+
     /** @brief convert record reference to a record pointer */
     const RamDomain* unpack(RamDomain Index) const override {
         return Base::fetch(Index).data();
     }
+
+    /** @brief enumerates the stored records together with their references */
+    void enumerate(const std::function<void(RamDomain, const RamDomain*)>& Callback) const override {
+        for (auto It = Base::begin(); It != Base::end(); ++It) {
+            Callback(static_cast<RamDomain>(It->second), It->first.data());
+        }
+    }
+
+    /** @brief approximate the number of bytes used by the stored records */
+    std::size_t getMemoryUsage() const override {
+        return Base::getMemoryUsage();
+    }
+
+    /** @brief release the records whose reference is not live */
+    std::size_t sweep(const std::function<bool(RamDomain)>& IsLive) override {
+        return Base::sweep(
+                [&](const std::size_t Index) { return IsLive(static_cast<RamDomain>(Index)); });
+    }
+
+protected:
+    std::size_t arity() const override {
+        return Arity;
+    }
 };
 
 /** Record map specialized for arity 0 */
@@ -474,11 +632,24 @@ public:
         return EmptyRecordIndex;
     }
 
+    /** @brief converts Count contiguous records to record references */
+    void packBatch(const RamDomain*, const std::size_t Count, RamDomain* OutRefs) override {
+        std::fill_n(OutRefs, Count, EmptyRecordIndex);
+    }
+
+    /** @brief enumerates nothing; the empty record is implicit */
+    void enumerate(const std::function<void(RamDomain, const RamDomain*)>&) const override {}
+
     /** @brief convert record reference to a record pointer */
     const RamDomain* unpack([[maybe_unused]] RamDomain Index) const override {
         assert(Index == EmptyRecordIndex);
         return EmptyRecordData;
     }
+
+protected:
+    std::size_t arity() const override {
+        return 0;
+    }
 };
 
 /** The interface of any Record Table. */
@@ -490,7 +661,50 @@ public:
 
     virtual RamDomain pack(const RamDomain* Tuple, const std::size_t Arity) = 0;
 
+    /** @brief convert Count contiguous records of the same arity to record
+     * references, acquiring the access lane only once */
+    virtual void packBatch(
+            const RamDomain* Tuples, const std::size_t Count, const std::size_t Arity, RamDomain* OutRefs) {
+        for (std::size_t I = 0; I < Count; ++I) {
+            OutRefs[I] = pack(Tuples + I * Arity, Arity);
+        }
+    }
+
+    /** @brief pre-size the table for the given number of records of an arity,
+     * avoiding repeated rehashing while it fills */
+    virtual void reserve(const std::size_t /* Arity */, const std::size_t /* NumRecords */) {}
+
     virtual const RamDomain* unpack(const RamDomain Ref, const std::size_t Arity) const = 0;
+
+    virtual void enumerate(
+            const std::function<void(std::size_t, RamDomain, const RamDomain*)>& Callback) const = 0;
+
+    /** @brief approximate the number of bytes used by the stored records */
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
+
+    /**
+     * @brief Release the interned records whose reference the predicate does
+     * not report as live, and return the number of released records.
+     *
+     * The collection is non-moving: surviving records keep their reference,
+     * so references embedded in relation tuples stay valid and no remapping
+     * takes place. The slots of the released records are recycled by later
+     * packs before the table grows. Inline-encoded references are not
+     * interned and are unaffected.
+     *
+     * The predicate must be transitively closed: a record reachable from a
+     * live record's fields must itself be reported live. Unpacking a
+     * released reference is undefined.
+     *
+     * This function is not thread-safe; call it only at a point where no
+     * other thread uses the table, e.g. between strata. The default
+     * implementation releases nothing.
+     */
+    virtual std::size_t sweep(const std::function<bool(std::size_t, RamDomain)>& /* IsLive */) {
+        return 0;
+    }
 };
 
 /** A concurrent Record Table with some specialized record maps. */
@@ -548,16 +762,91 @@ public:
 
     /** @brief convert record to record reference */
     virtual RamDomain pack(const RamDomain* Tuple, const std::size_t Arity) override {
+        if (details::isInlineArity(Arity) && details::fitsInline(Tuple, Arity)) {
+            return details::encodeInline(Tuple, Arity);
+        }
         auto Guard = Lanes.guard();
         return lookupMap(Arity).pack(Tuple);
     }
 
+    /** @brief convert a batch of records to record references */
+    virtual void packBatch(const RamDomain* Tuples, const std::size_t Count, const std::size_t Arity,
+            RamDomain* OutRefs) override {
+        auto Guard = Lanes.guard();
+        if (details::isInlineArity(Arity)) {
+            RecordMap& Map = lookupMap(Arity);
+            for (std::size_t I = 0; I < Count; ++I) {
+                const RamDomain* Tuple = Tuples + I * Arity;
+                OutRefs[I] = details::fitsInline(Tuple, Arity) ? details::encodeInline(Tuple, Arity)
+                                                               : Map.pack(Tuple);
+            }
+            return;
+        }
+        lookupMap(Arity).packBatch(Tuples, Count, OutRefs);
+    }
+
+    /** @brief pre-size the map of the given arity for the given number of records */
+    virtual void reserve(const std::size_t Arity, const std::size_t NumRecords) override {
+        auto Guard = Lanes.guard();
+        lookupMap(Arity).reserve(NumRecords);
+    }
+
     /** @brief convert record reference to a record */
     virtual const RamDomain* unpack(const RamDomain Ref, const std::size_t Arity) const override {
+        if (details::isInlineRef(Ref)) {
+            // Materialise the record in the backing map so that a stable
+            // pointer can be handed out; the reference itself stays inline.
+            // Hot paths decode inline references without ever reaching here.
+            RamDomain Data[details::MaxInlineArity];
+            details::decodeInline(Ref, Arity, Data);
+            auto& Self = const_cast<SpecializedRecordTable&>(*this);
+            auto Guard = Lanes.guard();
+            RecordMap& Map = Self.lookupMap(Arity);
+            return Map.unpack(Map.pack(static_cast<const RamDomain*>(Data)));
+        }
         auto Guard = Lanes.guard();
         return lookupMap(Arity).unpack(Ref);
     }
 
+    /** @brief enumerates the stored records of all arities, in reference order per arity */
+    virtual void enumerate(
+            const std::function<void(std::size_t, RamDomain, const RamDomain*)>& Callback) const override {
+        auto Guard = Lanes.guard();
+        for (std::size_t Arity = 0; Arity < Size; ++Arity) {
+            if (Maps[Arity] != nullptr) {
+                Maps[Arity]->enumerate([&](const RamDomain Ref, const RamDomain* Tuple) {
+                    Callback(Arity, Ref, Tuple);
+                });
+            }
+        }
+    }
+
+    /** @brief approximate the number of bytes used by the stored records;
+     * the lane guard keeps the set of maps stable while they are summed */
+    virtual std::size_t getMemoryUsage() const override {
+        auto Guard = Lanes.guard();
+        std::size_t Bytes = sizeof(*this);
+        for (std::size_t Arity = 0; Arity < Size; ++Arity) {
+            if (Maps[Arity] != nullptr) {
+                Bytes += Maps[Arity]->getMemoryUsage();
+            }
+        }
+        return Bytes;
+    }
+
+    /** @brief release the records of all arities whose reference is not live;
+     * not thread-safe, see RecordTable::sweep */
+    virtual std::size_t sweep(const std::function<bool(std::size_t, RamDomain)>& IsLive) override {
+        std::size_t Swept = 0;
+        for (std::size_t Arity = 0; Arity < Size; ++Arity) {
+            if (Maps[Arity] != nullptr) {
+                Swept += Maps[Arity]->sweep(
+                        [&IsLive, Arity](const RamDomain Ref) { return IsLive(Arity, Ref); });
+            }
+        }
+        return Swept;
+    }
+
 private:
     /** @brief lookup RecordMap for a given arity; the map for that arity must exist. */
     RecordMap& lookupMap(const std::size_t Arity) const {
@@ -605,13 +894,41 @@ private:
 /** @brief helper to convert tuple to record reference for the synthesiser */
 template <class RecordTableT, std::size_t Arity>
 RamDomain pack(RecordTableT&& recordTab, Tuple<RamDomain, Arity> const& tuple) {
+    if constexpr (details::isInlineArity(Arity)) {
+        if (details::fitsInline(tuple.data(), Arity)) {
+            return details::encodeInline(tuple.data(), Arity);
+        }
+    }
     return recordTab.pack(tuple.data(), Arity);
 }
 
 /** @brief helper to convert tuple to record reference for the synthesiser */
 template <class RecordTableT, std::size_t Arity>
 RamDomain pack(RecordTableT&& recordTab, span<const RamDomain, Arity> tuple) {
+    if constexpr (details::isInlineArity(Arity)) {
+        if (details::fitsInline(tuple.data(), Arity)) {
+            return details::encodeInline(tuple.data(), Arity);
+        }
+    }
     return recordTab.pack(tuple.data(), Arity);
 }
 
+/**
+ * @brief helper to convert a record reference to a record for the synthesiser.
+ *
+ * Inline references are decoded into the caller-provided storage, which must
+ * outlive every use of the returned pointer; table references resolve to the
+ * interned record without touching the storage.
+ */
+template <class RecordTableT, std::size_t Arity>
+const RamDomain* unpack(RecordTableT&& recordTab, const RamDomain ref, Tuple<RamDomain, Arity>& storage) {
+    if constexpr (details::isInlineArity(Arity)) {
+        if (details::isInlineRef(ref)) {
+            details::decodeInline(ref, Arity, storage.data());
+            return storage.data();
+        }
+    }
+    return recordTab.unpack(ref, Arity);
+}
+
 }  // namespace souffle
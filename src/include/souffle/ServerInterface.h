@@ -0,0 +1,333 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ServerInterface.h
+ *
+ * A lightweight evaluation service over a Unix domain socket. A long-lived
+ * process holds one program instance and serves fact batches and result
+ * scans in the binary tuple format, amortising process startup and fact
+ * parsing across many jobs.
+ *
+ * Wire protocol: every request starts with a one-byte opcode. Lengths and
+ * counts are fixed-width unsigned integers, tuple values cross the wire as
+ * int64_t regardless of the program's RAM domain width, and strings are a
+ * uint32_t byte length followed by the bytes; all fields use the host byte
+ * order, as both ends share a machine. Every reply starts with '+' on
+ * success or '-' followed by an error string.
+ *
+ *   'S' uint64 count, count strings          -> '+', count int64 indices
+ *       intern symbols, returning their symbol table indices
+ *   'Y' uint64 count, count int64 indices    -> '+', count strings
+ *       decode symbol indices back to text
+ *   'I' string relation, uint64 rows, tuples -> '+'
+ *       insert a batch of rows * arity values in row-major order
+ *   'Q' string relation                      -> '+', uint32 arity,
+ *                                               uint64 rows, tuples
+ *       scan a relation, streaming its tuples in row-major order
+ *   'R'                                      -> '+'
+ *       evaluate the program on the facts currently in its relations
+ *   'U'                                      -> '+'
+ *       fold facts inserted since the last evaluation into the fixpoint
+ *       without a full re-run; needs a program evaluated with --live
+ *   'X'                                      -> '+'
+ *       reset the program for a fresh run, purging all relations
+ *   'Z'                                      -> '+'
+ *       shut the server down
+ *
+ * A client disconnect ends its session; the server then accepts the next
+ * connection. Sessions are served one at a time.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/SouffleInterface.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+#ifndef _WIN32
+
+namespace detail {
+
+/** A connected client session, framing messages over a socket. */
+class ServerSession {
+public:
+    explicit ServerSession(int fd) : fd(fd) {}
+
+    ~ServerSession() {
+        ::close(fd);
+    }
+
+    /** Read exactly size bytes; false once the peer has disconnected. */
+    bool readExact(void* data, std::size_t size) {
+        auto* cursor = static_cast<char*>(data);
+        while (size > 0) {
+            const ssize_t got = ::read(fd, cursor, size);
+            if (got <= 0) {
+                return false;
+            }
+            cursor += got;
+            size -= static_cast<std::size_t>(got);
+        }
+        return true;
+    }
+
+    /** Write exactly size bytes; false once the peer has disconnected. */
+    bool writeExact(const void* data, std::size_t size) {
+        const auto* cursor = static_cast<const char*>(data);
+        while (size > 0) {
+            const ssize_t put = ::write(fd, cursor, size);
+            if (put <= 0) {
+                return false;
+            }
+            cursor += put;
+            size -= static_cast<std::size_t>(put);
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool readValue(T& value) {
+        return readExact(&value, sizeof(T));
+    }
+
+    template <typename T>
+    bool writeValue(const T& value) {
+        return writeExact(&value, sizeof(T));
+    }
+
+    bool readString(std::string& text) {
+        uint32_t length;
+        if (!readValue(length)) {
+            return false;
+        }
+        text.resize(length);
+        return readExact(text.data(), length);
+    }
+
+    bool writeString(const std::string& text) {
+        const auto length = static_cast<uint32_t>(text.size());
+        return writeValue(length) && writeExact(text.data(), length);
+    }
+
+    bool writeOk() {
+        const char status = '+';
+        return writeValue(status);
+    }
+
+    bool writeError(const std::string& message) {
+        const char status = '-';
+        return writeValue(status) && writeString(message);
+    }
+
+private:
+    int fd;
+};
+
+/** Number of tuples moved per read/write block. */
+constexpr std::size_t serverBlockRows = 4096;
+
+inline bool serveInsert(ServerSession& session, SouffleProgram& prog) {
+    std::string name;
+    uint64_t rows;
+    if (!session.readString(name) || !session.readValue(rows)) {
+        return false;
+    }
+    Relation* relation = prog.getRelation(name);
+    if (relation == nullptr) {
+        // drain the payload so the stream stays framed; arity is unknown,
+        // hence the error is fatal for the session when rows are pending
+        return rows == 0 && session.writeError("unknown relation: " + name);
+    }
+    const std::size_t arity = relation->getArity();
+    std::vector<int64_t> wire(serverBlockRows * arity);
+    std::vector<RamDomain> batch(serverBlockRows * arity);
+    uint64_t remaining = rows;
+    while (remaining > 0) {
+        const auto block = static_cast<std::size_t>(std::min<uint64_t>(remaining, serverBlockRows));
+        if (!session.readExact(wire.data(), block * arity * sizeof(int64_t))) {
+            return false;
+        }
+        for (std::size_t i = 0; i < block * arity; i++) {
+            batch[i] = static_cast<RamDomain>(wire[i]);
+        }
+        relation->insertBatch(batch.data(), block);
+        remaining -= block;
+    }
+    return session.writeOk();
+}
+
+inline bool serveQuery(ServerSession& session, SouffleProgram& prog) {
+    std::string name;
+    if (!session.readString(name)) {
+        return false;
+    }
+    Relation* relation = prog.getRelation(name);
+    if (relation == nullptr) {
+        return session.writeError("unknown relation: " + name);
+    }
+    const std::size_t arity = relation->getArity();
+    const uint64_t rows = relation->size();
+    if (!session.writeOk() || !session.writeValue(static_cast<uint32_t>(arity)) ||
+            !session.writeValue(rows)) {
+        return false;
+    }
+    std::vector<RamDomain> batch(serverBlockRows * std::max<std::size_t>(arity, 1));
+    std::vector<int64_t> wire(batch.size());
+    Relation::iterator it = relation->begin();
+    uint64_t remaining = rows;
+    while (remaining > 0) {
+        const std::size_t block = relation->extractBatch(it, batch.data(), serverBlockRows);
+        if (block == 0) {
+            break;
+        }
+        for (std::size_t i = 0; i < block * arity; i++) {
+            wire[i] = static_cast<int64_t>(batch[i]);
+        }
+        if (!session.writeExact(wire.data(), block * arity * sizeof(int64_t))) {
+            return false;
+        }
+        remaining -= block;
+    }
+    return remaining == 0;
+}
+
+inline bool serveEncodeSymbols(ServerSession& session, SouffleProgram& prog) {
+    uint64_t count;
+    if (!session.readValue(count)) {
+        return false;
+    }
+    std::vector<int64_t> indices(count);
+    std::string symbol;
+    for (uint64_t i = 0; i < count; i++) {
+        if (!session.readString(symbol)) {
+            return false;
+        }
+        indices[i] = static_cast<int64_t>(prog.getSymbolTable().encode(symbol));
+    }
+    return session.writeOk() && session.writeExact(indices.data(), count * sizeof(int64_t));
+}
+
+inline bool serveDecodeSymbols(ServerSession& session, SouffleProgram& prog) {
+    uint64_t count;
+    if (!session.readValue(count)) {
+        return false;
+    }
+    std::vector<int64_t> indices(count);
+    if (!session.readExact(indices.data(), count * sizeof(int64_t))) {
+        return false;
+    }
+    if (!session.writeOk()) {
+        return false;
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        if (!session.writeString(prog.getSymbolTable().decode(static_cast<RamDomain>(indices[i])))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * Serve the given program over a Unix domain socket at the given path until
+ * a client sends the shutdown request. An existing socket file at the path
+ * is replaced.
+ */
+inline void serveProgram(SouffleProgram& prog, const std::string& socketPath) {
+    const int server = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0) {
+        fatal("cannot create server socket: %s", strerror(errno));
+    }
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        fatal("server socket path is too long: %s", socketPath);
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+    ::unlink(socketPath.c_str());
+    if (::bind(server, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(server, 5) != 0) {
+        fatal("cannot bind server socket `%s`: %s", socketPath, strerror(errno));
+    }
+
+    bool running = true;
+    while (running) {
+        const int client = ::accept(server, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        detail::ServerSession session(client);
+        bool connected = true;
+        while (connected && running) {
+            char opcode;
+            if (!session.readValue(opcode)) {
+                break;
+            }
+            switch (opcode) {
+                case 'S': connected = detail::serveEncodeSymbols(session, prog); break;
+                case 'Y': connected = detail::serveDecodeSymbols(session, prog); break;
+                case 'I': connected = detail::serveInsert(session, prog); break;
+                case 'Q': connected = detail::serveQuery(session, prog); break;
+                case 'R':
+                    prog.run();
+                    connected = session.writeOk();
+                    break;
+                case 'U':
+                    try {
+                        std::vector<RamDomain> args;
+                        std::vector<RamDomain> ret;
+                        prog.executeSubroutine("update", args, ret);
+                        connected = session.writeOk();
+                    } catch (const std::exception&) {
+                        connected = session.writeError("no update entry point; evaluate with --live");
+                    }
+                    break;
+                case 'X':
+                    prog.reset();
+                    connected = session.writeOk();
+                    break;
+                case 'Z':
+                    session.writeOk();
+                    running = false;
+                    break;
+                default: connected = session.writeError("unknown request"); break;
+            }
+        }
+    }
+    ::close(server);
+    ::unlink(socketPath.c_str());
+}
+
+#else
+
+inline void serveProgram(SouffleProgram&, const std::string&) {
+    fatal("server mode is not supported on this platform");
+}
+
+#endif
+
+}  // namespace souffle
@@ -127,6 +127,17 @@ public:
         }
     }
 
+    /***
+     * warning routine that prints the rule context without terminating.
+     */
+    void alert(const std::string& warning) {
+        if (msg != nullptr) {
+            std::cerr << warning << " in rule:\n" << msg << std::endl;
+        } else {
+            std::cerr << warning << std::endl;
+        }
+    }
+
     /***
      * error handling routine that prints the rule context.
      */
@@ -0,0 +1,111 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SouffleCABI.h
+ *
+ * Stable, versioned C ABI exported by synthesised programs compiled as
+ * shared libraries. Unlike the C++ interface in SouffleInterface.h, these
+ * entry points do not expose any engine internals, so an analysis compiled
+ * against one engine version keeps working when loaded by a host built
+ * against a later one. Host processes resolve the symbols below via
+ * dlsym() after loading the program with dlopen(); each program library
+ * exports the same symbol names, so pooled programs must be loaded with
+ * RTLD_LOCAL.
+ *
+ * A host should first call souffle_cabi_version() and reject libraries
+ * whose version it does not understand, and souffle_cabi_domain_bits() to
+ * learn the width of the program's RAM domain. Tuple data always crosses
+ * the boundary as int64_t regardless of that width.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Version of the entry points declared in this header. */
+#define SOUFFLE_CABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** An opaque handle to a program instance. */
+typedef struct souffle_program souffle_program;
+
+/** An opaque handle to a relation of a program instance. */
+typedef struct souffle_relation souffle_relation;
+
+/** An opaque handle to a scan over a relation. */
+typedef struct souffle_iterator souffle_iterator;
+
+/** Return SOUFFLE_CABI_VERSION of the loaded program library. */
+int32_t souffle_cabi_version(void);
+
+/** Return the width of the program's RAM domain in bits (32 or 64). */
+int32_t souffle_cabi_domain_bits(void);
+
+/** Create a fresh instance of the program. */
+souffle_program* souffle_program_create(void);
+
+/** Destroy a program instance and all handles derived from it. */
+void souffle_program_destroy(souffle_program* program);
+
+/** Evaluate the program on the facts currently in its input relations. */
+void souffle_program_run(souffle_program* program);
+
+/** Read all input relations from fact files in the given directory. */
+void souffle_program_load_all(souffle_program* program, const char* input_directory);
+
+/** Write all output relations to files in the given directory. */
+void souffle_program_print_all(souffle_program* program, const char* output_directory);
+
+/** Encode a symbol in the program's symbol table, returning its index. */
+int64_t souffle_program_encode_symbol(souffle_program* program, const char* symbol);
+
+/**
+ * Decode a symbol index to its text. The returned string is owned by the
+ * program and remains valid until the program is destroyed.
+ */
+const char* souffle_program_decode_symbol(souffle_program* program, int64_t index);
+
+/** Look up a relation by name; returns NULL if it does not exist. */
+souffle_relation* souffle_relation_by_name(souffle_program* program, const char* name);
+
+/** Return the number of columns of a relation. */
+size_t souffle_relation_arity(souffle_relation* relation);
+
+/** Return the number of tuples in a relation. */
+size_t souffle_relation_size(souffle_relation* relation);
+
+/**
+ * Insert a batch of tuples. The data array holds tuple_count * arity
+ * values in row-major order; symbol columns hold symbol indices obtained
+ * from souffle_program_encode_symbol.
+ */
+void souffle_relation_insert(souffle_relation* relation, const int64_t* data, size_t tuple_count);
+
+/** Start a scan over a relation. */
+souffle_iterator* souffle_iterator_create(souffle_relation* relation);
+
+/**
+ * Copy the next tuple of the scan into the out array, which must hold at
+ * least arity values. Returns 1 while a tuple was produced and 0 once the
+ * scan is exhausted.
+ */
+int souffle_iterator_next(souffle_iterator* iterator, int64_t* out);
+
+/** Destroy a scan. */
+void souffle_iterator_destroy(souffle_iterator* iterator);
+
+#ifdef __cplusplus
+}
+#endif
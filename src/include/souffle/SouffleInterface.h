@@ -19,6 +19,7 @@
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
+#include "souffle/datastructure/HyperLogLog.h"
 #include "souffle/utility/MiscUtil.h"
 #include <algorithm>
 #include <cassert>
@@ -281,6 +282,18 @@ public:
         bool operator!=(const iterator& o) const {
             return !(*this == o);
         }
+
+        /**
+         * Expose the underlying iterator implementation.
+         *
+         * Only intended for relation implementations that specialise batch
+         * extraction on their own iterator type; not part of the user API.
+         *
+         * @return Reference to the wrapped iterator_base object
+         */
+        iterator_base& base() const {
+            return *iter;
+        }
     };
 
     /**
@@ -291,6 +304,22 @@ public:
      */
     virtual void insert(const tuple& t) = 0;
 
+    /**
+     * Insert a batch of tuples given as a contiguous row-major buffer.
+     *
+     * The buffer holds count rows of getArity() raw RamDomain values each,
+     * in the relation's internal encoding: symbol attributes carry symbol
+     * indices obtained from the symbol table (see SymbolTable::encodeBatch),
+     * record attributes carry record references. The default implementation
+     * funnels the rows through insert(tuple); relation implementations
+     * override it to feed the underlying index directly, without per-tuple
+     * virtual calls or intermediate tuple objects.
+     *
+     * @param data Pointer to the first value of the first row
+     * @param count Number of rows in the buffer
+     */
+    virtual void insertBatch(const RamDomain* data, std::size_t count);
+
     /**
      * Check whether a tuple exists in a relation.
      * The definition of contains has to be defined by the child class of relation class.
@@ -315,6 +344,82 @@ public:
      */
     virtual iterator end() const = 0;
 
+    /**
+     * Copy a block of tuples out into a contiguous row-major buffer.
+     *
+     * Starting from the given iterator, up to maxRows rows of getArity() raw
+     * RamDomain values each are written to the buffer and the iterator is
+     * advanced past them. The number of rows written is returned; it falls
+     * short of maxRows only when the end of the relation is reached. The raw
+     * values use the relation's internal encoding, mirroring insertBatch.
+     * The default implementation reads through the tuple interface; relation
+     * implementations override it to copy straight from the underlying index.
+     *
+     * @param it Position to resume from; advanced past the copied rows
+     * @param buffer Pointer to space for maxRows * getArity() values
+     * @param maxRows Capacity of the buffer in rows
+     * @return Number of rows written to the buffer
+     */
+    virtual std::size_t extractBatch(iterator& it, RamDomain* buffer, std::size_t maxRows) const;
+
+    /**
+     * Split the relation into independently iterable ranges.
+     *
+     * The returned (begin, end) pairs cover disjoint portions of the
+     * relation and together enumerate every tuple exactly once, so each
+     * range can be drained on its own thread -- via plain iteration or
+     * extractBatch -- as long as no writer runs concurrently. The
+     * requested count is a hint: implementations return approximately
+     * that many ranges, fewer for small relations. The default
+     * implementation splits by counting through a full serial pass;
+     * relation implementations override it to reuse the partitioning of
+     * the underlying index, which locates the split points directly.
+     *
+     * @param chunks Desired number of ranges, a hint
+     * @return Pairs of iterators bounding the ranges
+     */
+    virtual std::vector<std::pair<iterator, iterator>> partition(std::size_t chunks) const;
+
+    /**
+     * Take a detached, immutable copy of the relation's current contents.
+     *
+     * The snapshot shares no structure with the live relation: once taken,
+     * it can be queried while the program purges and refills its relations
+     * for the next run, and neither side blocks the other. Take snapshots
+     * between runs; the copy itself must not race with writers.
+     *
+     * @return An owned read-only relation holding the copied tuples
+     */
+    virtual std::unique_ptr<Relation> snapshot() const;
+
+    /**
+     * Per-column summary statistics, for cost prediction and monitoring.
+     */
+    struct ColumnStatistics {
+        /** Estimated number of distinct values (HyperLogLog, ~1.6% error) */
+        std::size_t distinct = 0;
+
+        /** Smallest raw value; meaningful for numeric columns, only valid
+         * when the relation is non-empty */
+        RamDomain minimum = 0;
+
+        /** Largest raw value, under the same caveats as minimum */
+        RamDomain maximum = 0;
+    };
+
+    /**
+     * Gather per-column statistics in a single streaming pass.
+     *
+     * The pass moves tuples in blocks through extractBatch, so it costs no
+     * per-tuple virtual calls, materialises nothing, and uses constant
+     * memory; inserts carry no bookkeeping overhead in exchange. Intended
+     * for monitoring and cost prediction between runs, e.g. sizing joins
+     * before launching the next computation.
+     *
+     * @return One entry per column of the relation
+     */
+    virtual std::vector<ColumnStatistics> getColumnStatistics() const;
+
     /**
      * Get the number of tuples in a relation.
      *
@@ -322,6 +427,19 @@ public:
      */
     virtual std::size_t size() const = 0;
 
+    /**
+     * Approximate the number of bytes held by the relation's data structures.
+     *
+     * Implementations only account memory that can be measured in constant
+     * time, so that the value may be sampled while the program is running;
+     * relations without such accounting report zero.
+     *
+     * @return The approximate number of bytes used (std::size_t)
+     */
+    virtual std::size_t getMemoryUsage() const {
+        return 0;
+    }
+
     /**
      * Get the name of a relation.
      *
@@ -685,6 +803,249 @@ public:
     }
 };
 
+// Defined out of line since they need the complete tuple type.
+
+inline void Relation::insertBatch(const RamDomain* data, std::size_t count) {
+    const arity_type arity = getArity();
+    tuple t(this);
+    for (std::size_t i = 0; i < count; i++) {
+        for (arity_type j = 0; j < arity; j++) {
+            t[j] = data[i * arity + j];
+        }
+        insert(t);
+    }
+}
+
+inline std::size_t Relation::extractBatch(iterator& it, RamDomain* buffer, std::size_t maxRows) const {
+    const arity_type arity = getArity();
+    const iterator stop = end();
+    std::size_t rows = 0;
+    for (; rows < maxRows && it != stop; ++it, ++rows) {
+        const tuple& t = *it;
+        for (arity_type j = 0; j < arity; j++) {
+            buffer[rows * arity + j] = t[j];
+        }
+    }
+    return rows;
+}
+
+inline std::vector<std::pair<Relation::iterator, Relation::iterator>> Relation::partition(
+        std::size_t chunks) const {
+    std::vector<std::pair<iterator, iterator>> res;
+    if (chunks == 0) {
+        chunks = 1;
+    }
+    const std::size_t total = size();
+    const std::size_t perChunk = (total + chunks - 1) / chunks;
+    iterator cur = begin();
+    const iterator stop = end();
+    while (cur != stop) {
+        iterator first = cur;
+        for (std::size_t i = 0; i < perChunk && cur != stop; i++) {
+            ++cur;
+        }
+        res.emplace_back(std::move(first), cur);
+    }
+    return res;
+}
+
+inline std::vector<Relation::ColumnStatistics> Relation::getColumnStatistics() const {
+    const arity_type arity = getArity();
+    std::vector<ColumnStatistics> stats(arity);
+    std::vector<HyperLogLog> sketches(arity);
+    constexpr std::size_t blockRows = 1024;
+    std::vector<RamDomain> buffer(blockRows * std::max<std::size_t>(arity, 1));
+    iterator it = begin();
+    std::size_t seen = 0;
+    while (true) {
+        const std::size_t rows = extractBatch(it, buffer.data(), blockRows);
+        if (rows == 0) {
+            break;
+        }
+        for (std::size_t i = 0; i < rows; i++, seen++) {
+            for (arity_type j = 0; j < arity; j++) {
+                const RamDomain value = buffer[i * arity + j];
+                sketches[j].insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(value)));
+                if (seen == 0) {
+                    stats[j].minimum = value;
+                    stats[j].maximum = value;
+                } else {
+                    stats[j].minimum = std::min(stats[j].minimum, value);
+                    stats[j].maximum = std::max(stats[j].maximum, value);
+                }
+            }
+        }
+    }
+    for (arity_type j = 0; j < arity; j++) {
+        stats[j].distinct = sketches[j].estimate();
+    }
+    return stats;
+}
+
+/**
+ * A detached, immutable copy of a relation's contents.
+ *
+ * Snapshots serve the double-buffering pattern in server mode: queries are
+ * answered against run N's snapshot while run N+1 purges and refills the
+ * live relations. The tuples are held in a flat row-major buffer copied out
+ * through Relation::extractBatch; metadata is copied so the snapshot stays
+ * valid independently of the source relation's lifetime (the symbol table
+ * of the owning program must outlive it, as for any relation).
+ */
+class RelationSnapshot : public Relation {
+    /**
+     * Iterator over the flat tuple buffer.
+     */
+    class iterator_snapshot : public iterator_base {
+    public:
+        iterator_snapshot(const RelationSnapshot* rel, std::size_t row)
+                : iterator_base(0), snapshot(rel), row(row), tup(rel) {}
+
+        void operator++() override {
+            ++row;
+        }
+
+        tuple& operator*() override {
+            const arity_type arity = snapshot->getArity();
+            const RamDomain* values = snapshot->rows.data() + row * arity;
+            tup.rewind();
+            for (arity_type j = 0; j < arity; j++) {
+                tup[j] = values[j];
+            }
+            return tup;
+        }
+
+        iterator_base* clone() const override {
+            return new iterator_snapshot(snapshot, row);
+        }
+
+    protected:
+        bool equal(const iterator_base& o) const override {
+            const auto& other = static_cast<const iterator_snapshot&>(o);
+            return snapshot == other.snapshot && row == other.row;
+        }
+
+    private:
+        const RelationSnapshot* snapshot;
+        std::size_t row;
+        tuple tup;
+    };
+
+public:
+    /**
+     * Copy the current contents and metadata of the given relation.
+     *
+     * @param source The relation to copy; must not be mutated concurrently
+     */
+    explicit RelationSnapshot(const Relation& source)
+            : name(source.getName()), arity(source.getArity()), auxiliaryArity(source.getAuxiliaryArity()),
+              symbolTable(source.getSymbolTable()) {
+        for (arity_type j = 0; j < arity; j++) {
+            attrTypes.push_back(source.getAttrType(j));
+            attrNames.push_back(source.getAttrName(j));
+        }
+        rowCount = source.size();
+        rows.resize(rowCount * arity);
+        iterator it = source.begin();
+        std::size_t copied = 0;
+        while (copied < rowCount) {
+            copied += source.extractBatch(it, rows.data() + copied * arity, rowCount - copied);
+        }
+    }
+
+    /** Snapshots are read-only; inserting is a usage error. */
+    void insert(const tuple&) override {
+        fatal("cannot insert into a relation snapshot");
+    }
+
+    bool contains(const tuple& t) const override {
+        assert(t.size() == arity && "wrong tuple arity");
+        for (std::size_t i = 0; i < rowCount; i++) {
+            const RamDomain* values = rows.data() + i * arity;
+            bool match = true;
+            for (arity_type j = 0; j < arity && match; j++) {
+                match = (values[j] == t[j]);
+            }
+            if (match) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    iterator begin() const override {
+        return iterator(std::make_unique<iterator_snapshot>(this, 0));
+    }
+
+    iterator end() const override {
+        return iterator(std::make_unique<iterator_snapshot>(this, rowCount));
+    }
+
+    std::size_t size() const override {
+        return rowCount;
+    }
+
+    std::string getName() const override {
+        return name;
+    }
+
+    const char* getAttrType(std::size_t idx) const override {
+        assert(idx < arity && "attribute out of bound");
+        return attrTypes[idx].c_str();
+    }
+
+    const char* getAttrName(std::size_t idx) const override {
+        assert(idx < arity && "attribute out of bound");
+        return attrNames[idx].c_str();
+    }
+
+    arity_type getArity() const override {
+        return arity;
+    }
+
+    arity_type getAuxiliaryArity() const override {
+        return auxiliaryArity;
+    }
+
+    SymbolTable& getSymbolTable() const override {
+        return symbolTable;
+    }
+
+    void purge() override {
+        rows.clear();
+        rowCount = 0;
+    }
+
+private:
+    /** Name of the source relation */
+    std::string name;
+
+    /** Copied attribute types */
+    std::vector<std::string> attrTypes;
+
+    /** Copied attribute names */
+    std::vector<std::string> attrNames;
+
+    /** Arity of the source relation */
+    arity_type arity;
+
+    /** Auxiliary arity of the source relation */
+    arity_type auxiliaryArity;
+
+    /** Symbol table of the owning program */
+    SymbolTable& symbolTable;
+
+    /** Tuples in row-major order */
+    std::vector<RamDomain> rows;
+
+    /** Number of tuples */
+    std::size_t rowCount = 0;
+};
+
+inline std::unique_ptr<Relation> Relation::snapshot() const {
+    return std::make_unique<RelationSnapshot>(*this);
+}
+
 /**
  * Abstract base class for generated Datalog programs.
  */
@@ -968,6 +1329,40 @@ public:
         }
     }
 
+    /**
+     * Reset the program so the same instance can serve a fresh run.
+     *
+     * Removes the tuples of every relation while retaining the symbol and
+     * record tables and the relations' allocated data structures, so repeat
+     * runs skip table setup and allocator warmup. Program implementations
+     * extend this to clear their own per-run state, such as auto-increment
+     * counters.
+     *
+     * @see Relation::purge()
+     */
+    virtual void reset() {
+        for (Relation* relation : allRelations) {
+            relation->purge();
+        }
+    }
+
+    /**
+     * Take detached snapshots of all output relations, keyed by name.
+     *
+     * Together with reset(), this supports double-buffered serving: snapshot
+     * the results of run N, reset, and answer queries from the snapshots
+     * while run N+1 executes. Must not be called while a run is in progress.
+     *
+     * @see Relation::snapshot()
+     */
+    std::map<std::string, std::unique_ptr<Relation>> snapshotOutputRelations() const {
+        std::map<std::string, std::unique_ptr<Relation>> snapshots;
+        for (Relation* relation : outputRelations) {
+            snapshots.emplace(relation->getName(), relation->snapshot());
+        }
+        return snapshots;
+    }
+
     /**
      * Helper function for the wrapper function Relation::insert() and Relation::contains().
      */
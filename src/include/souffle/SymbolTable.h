@@ -18,15 +18,21 @@
 
 #include "souffle/RamTypes.h"
 #include "souffle/datastructure/ConcurrentFlyweight.h"
+#include "souffle/datastructure/SymbolImage.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <atomic>
+#include <cassert>
 #include <cstdlib>
 #include <deque>
+#include <functional>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -42,6 +48,107 @@ class SymbolTable : protected FlyweightImpl<std::string> {
 private:
     using Base = FlyweightImpl<std::string>;
 
+    /**
+     * An immutable snapshot of the interned symbols, built by freeze().
+     *
+     * Symbols are reached in one indirection for decoding and through a
+     * linear-probing open-addressing table for encoding, avoiding the lane
+     * guards and pointer chasing of the flyweight on every access. The
+     * snapshot points into the flyweight's nodes, which are never moved or
+     * freed while the table is alive.
+     */
+    struct FrozenIndex {
+        /// Dense index-to-symbol mapping.
+        std::vector<const std::string*> byIndex;
+
+        /// Collation key per frozen symbol: ranks are assigned in
+        /// lexicographic symbol order, so comparing ranks answers
+        /// lexicographic comparisons without touching character data.
+        std::vector<RamDomain> rankByIndex;
+
+        /// Symbol-to-index hash table with linear probing; empty slots hold
+        /// a null symbol. Sized to a power of two at most half full.
+        std::vector<std::pair<const std::string*, RamDomain>> slots;
+        std::size_t mask = 0;
+
+        explicit FrozenIndex(const SymbolTable& table) {
+            // overlay indices are globally shifted past any attached image
+            const std::size_t offset = table.image.size();
+            std::size_t count = 0;
+            std::size_t maxIndex = 0;
+            for (auto it = table.begin(); it != table.end(); ++it) {
+                ++count;
+                maxIndex = std::max(maxIndex, static_cast<std::size_t>(it->second) + offset);
+            }
+            byIndex.resize(count == 0 ? 0 : maxIndex + 1, nullptr);
+            std::size_t size = 16;
+            while (size < 2 * count) {
+                size <<= 1;
+            }
+            slots.resize(size, {nullptr, 0});
+            mask = size - 1;
+            for (auto it = table.begin(); it != table.end(); ++it) {
+                const auto& entry = *it;
+                byIndex[entry.second + offset] = &entry.first;
+                std::size_t pos = std::hash<std::string>{}(entry.first) & mask;
+                while (slots[pos].first != nullptr) {
+                    pos = (pos + 1) & mask;
+                }
+                slots[pos] = {&entry.first, static_cast<RamDomain>(entry.second + offset)};
+            }
+
+            // derive the collation keys by ranking the frozen symbols
+            // lexicographically
+            std::vector<RamDomain> order;
+            order.reserve(count);
+            for (std::size_t i = 0; i < byIndex.size(); i++) {
+                if (byIndex[i] != nullptr) {
+                    order.push_back(static_cast<RamDomain>(i));
+                }
+            }
+            std::sort(order.begin(), order.end(),
+                    [&](RamDomain a, RamDomain b) { return *byIndex[a] < *byIndex[b]; });
+            rankByIndex.resize(byIndex.size(), 0);
+            RamDomain rank = 0;
+            for (RamDomain index : order) {
+                rankByIndex[index] = rank++;
+            }
+        }
+
+        /// Return the index of the symbol, or nullptr if it is not frozen.
+        const RamDomain* find(const std::string& symbol) const {
+            std::size_t pos = std::hash<std::string>{}(symbol) & mask;
+            while (slots[pos].first != nullptr) {
+                if (*slots[pos].first == symbol) {
+                    return &slots[pos].second;
+                }
+                pos = (pos + 1) & mask;
+            }
+            return nullptr;
+        }
+    };
+
+    /// Frozen snapshot, or null while the table is not frozen.
+    std::unique_ptr<const FrozenIndex> frozen;
+
+    /// Read-only symbol image shared across processes, or empty. Image
+    /// symbols occupy the index range [0, image.size()); symbols interned
+    /// at run time live in the flyweight overlay above that range.
+    SymbolImage image;
+
+    /// Lazily materialised string objects for decoded image symbols; the
+    /// character data itself stays in the mapping.
+    mutable std::unique_ptr<std::atomic<const std::string*>[]> materialised;
+
+    /// Obtains a view of the symbol with the given index without
+    /// materialising image symbols.
+    std::string_view view(const RamDomain index) const {
+        if (static_cast<std::size_t>(index) < image.size()) {
+            return image.get(static_cast<std::size_t>(index));
+        }
+        return decode(index);
+    }
+
 public:
     using iterator = typename Base::iterator;
 
@@ -64,6 +171,14 @@ public:
         }
     }
 
+    ~SymbolTable() {
+        if (materialised != nullptr) {
+            for (std::size_t i = 0; i < image.size(); i++) {
+                delete materialised[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
     /**
      * @brief Set the number of concurrent access lanes.
      * This function is not thread-safe, do not call when other threads are using the datastructure.
@@ -72,6 +187,11 @@ public:
         Base::setNumLanes(NumLanes);
     }
 
+    /** @brief Approximate the number of bytes used by the interned symbols; safe to call concurrently. */
+    std::size_t getMemoryUsage() const {
+        return Base::getMemoryUsage();
+    }
+
     /** @brief Return an iterator on the first symbol. */
     iterator begin() const {
         return Base::begin();
@@ -84,17 +204,159 @@ public:
 
     /** @brief Check if the given symbol exist. */
     bool weakContains(const std::string& symbol) const {
+        if (!image.empty() && image.find(symbol) != SymbolImage::npos) {
+            return true;
+        }
         return Base::weakContains(symbol);
     }
 
+    /**
+     * @brief Attach a read-only symbol image as the base of this table.
+     *
+     * The image symbols are served zero-copy from the mapping, whose pages
+     * are shared with every other process attached to the same image;
+     * symbols interned later take the regular flyweight path above the
+     * image index range. Must be called on a table that has not interned
+     * any symbols yet, and is not thread-safe.
+     */
+    void attachImage(const std::string& filename) {
+        assert(begin() == end() && "symbol image must be attached before interning symbols");
+        image.open(filename);
+        materialised = std::make_unique<std::atomic<const std::string*>[]>(image.size());
+        for (std::size_t i = 0; i < image.size(); i++) {
+            materialised[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief Check if the table serves symbols from an attached image. */
+    bool hasImage() const {
+        return !image.empty();
+    }
+
+    /**
+     * @brief Write all symbols of this table into an image file.
+     *
+     * The image contains the symbols of an attached image as well as those
+     * interned at run time; a later run attaching it will not re-intern
+     * any of them. Not thread-safe, do not call while other threads use
+     * the table.
+     */
+    void saveImage(const std::string& filename) const {
+        std::vector<std::string> symbols;
+        for (std::size_t i = 0; i < image.size(); i++) {
+            symbols.emplace_back(image.get(i));
+        }
+        for (auto it = begin(); it != end(); ++it) {
+            symbols.push_back(it->first);
+        }
+        SymbolImage::write(std::move(symbols), filename);
+    }
+
+    /**
+     * @brief Freeze the current set of symbols into a compact snapshot.
+     *
+     * Typically called once the input relations are loaded: encoding and
+     * decoding of frozen symbols then bypass the flyweight, while symbols
+     * minted later (e.g. by cat or substr) take the regular path. Not
+     * thread-safe, do not call while other threads use the table.
+     */
+    void freeze() {
+        frozen = std::make_unique<const FrozenIndex>(*this);
+    }
+
+    /** @brief Check if the table holds a frozen snapshot. */
+    bool isFrozen() const {
+        return frozen != nullptr;
+    }
+
     /** @brief Encode a symbol to a symbol index. */
     RamDomain encode(const std::string& symbol) {
-        return Base::findOrInsert(symbol).first;
+        if (!image.empty()) {
+            const std::size_t index = image.find(symbol);
+            if (index != SymbolImage::npos) {
+                return static_cast<RamDomain>(index);
+            }
+        }
+        if (frozen != nullptr) {
+            if (const RamDomain* index = frozen->find(symbol)) {
+                return *index;
+            }
+        }
+        return static_cast<RamDomain>(Base::findOrInsert(symbol).first + image.size());
+    }
+
+    /**
+     * @brief Encode a batch of symbols to symbol indices.
+     *
+     * Pre-interns count symbols in one pass, reserving table capacity up
+     * front so that the flyweight does not grow while filling. Intended
+     * for preparing raw tuple buffers for Relation::insertBatch. Not
+     * thread-safe, do not call while other threads use the table.
+     *
+     * @param symbols Pointer to the first of count symbols
+     * @param indices Output array receiving one index per symbol
+     * @param count Number of symbols to encode
+     */
+    void encodeBatch(const std::string* symbols, RamDomain* indices, std::size_t count) {
+        Base::reserve(count);
+        for (std::size_t i = 0; i < count; i++) {
+            indices[i] = encode(symbols[i]);
+        }
     }
 
     /** @brief Decode a symbol index to a symbol. */
     const std::string& decode(const RamDomain index) const {
-        return Base::fetch(index);
+        if (static_cast<std::size_t>(index) < image.size()) {
+            // materialise a string object on first decode; its character
+            // data is copied out of the mapping exactly once
+            auto& slot = materialised[static_cast<std::size_t>(index)];
+            const std::string* cur = slot.load(std::memory_order_acquire);
+            if (cur == nullptr) {
+                auto* fresh = new std::string(image.get(static_cast<std::size_t>(index)));
+                if (slot.compare_exchange_strong(cur, fresh, std::memory_order_acq_rel)) {
+                    cur = fresh;
+                } else {
+                    delete fresh;
+                }
+            }
+            return *cur;
+        }
+        if (frozen != nullptr && static_cast<std::size_t>(index) < frozen->byIndex.size() &&
+                frozen->byIndex[index] != nullptr) {
+            return *frozen->byIndex[index];
+        }
+        return Base::fetch(index - static_cast<RamDomain>(image.size()));
+    }
+
+    /**
+     * @brief Three-way lexicographic comparison of two symbols by index.
+     *
+     * Returns a negative value, zero or a positive value as the symbol of
+     * the first index compares less than, equal to or greater than the
+     * symbol of the second. While the table is frozen, symbols covered by
+     * the snapshot are ordered by their collation keys without touching
+     * character data; other symbols fall back to character comparison.
+     */
+    int compare(const RamDomain lhs, const RamDomain rhs) const {
+        if (lhs == rhs) {
+            return 0;
+        }
+        if (static_cast<std::size_t>(lhs) < image.size() && static_cast<std::size_t>(rhs) < image.size()) {
+            // image symbols are stored in lexicographic order, so their
+            // indices double as collation keys
+            return lhs < rhs ? -1 : 1;
+        }
+        if (frozen != nullptr) {
+            const auto l = static_cast<std::size_t>(lhs);
+            const auto r = static_cast<std::size_t>(rhs);
+            if (l < frozen->byIndex.size() && r < frozen->byIndex.size() &&
+                    frozen->byIndex[l] != nullptr && frozen->byIndex[r] != nullptr) {
+                return frozen->rankByIndex[l] < frozen->rankByIndex[r] ? -1 : 1;
+            }
+        }
+        const std::string_view l = view(lhs);
+        const std::string_view r = view(rhs);
+        return l.compare(r);
     }
 
     /** @brief Encode a symbol to a symbol index; aliases encode. */
@@ -114,8 +376,19 @@ public:
      * happened.
      */
     std::pair<RamDomain, bool> findOrInsert(const std::string& symbol) {
+        if (!image.empty()) {
+            const std::size_t index = image.find(symbol);
+            if (index != SymbolImage::npos) {
+                return std::make_pair(static_cast<RamDomain>(index), false);
+            }
+        }
+        if (frozen != nullptr) {
+            if (const RamDomain* index = frozen->find(symbol)) {
+                return std::make_pair(*index, false);
+            }
+        }
         auto Res = Base::findOrInsert(symbol);
-        return std::make_pair(Res.first, Res.second);
+        return std::make_pair(static_cast<RamDomain>(Res.first + image.size()), Res.second);
     }
 };
 
@@ -17,21 +17,29 @@
 
 #pragma once
 
+#include "souffle/datastructure/MemoryArena.h"
 #include "souffle/utility/CacheUtil.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <new>
 #include <string>
 #include <tuple>
 #include <type_traits>
 #include <typeinfo>
 #include <vector>
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
 
 namespace souffle {
 
@@ -203,6 +211,104 @@ struct binary_search : public search_strategy {
     }
 };
 
+/**
+ * A vectorised search strategy for b-tree nodes holding single-element
+ * 32-bit keys in their natural ascending order. Eight keys are compared at
+ * once and the branch index is derived from the comparison mask, removing
+ * the per-key branches of the scalar strategies. Where AVX2 is unavailable,
+ * or the key is not 32 bits wide (e.g. with 64-bit domains), the strategy
+ * falls back to binary search.
+ *
+ * Note: this strategy bypasses the comparator and is therefore only sound
+ * for comparators implementing the natural ascending order of the key's
+ * single signed 32-bit element.
+ */
+struct simd_search : public search_strategy {
+    /**
+     * Required user-defined default constructor.
+     */
+    simd_search() = default;
+
+    /**
+     * Obtains an iterator referencing an element equivalent to the
+     * given key in the given range. If no such element is present,
+     * a reference to the first element not less than the given key
+     * is returned.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter operator()(const Key& k, Iter a, Iter b, Comp& comp) const {
+        return lower_bound(k, a, b, comp);
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * is not less than the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter lower_bound(const Key& k, Iter a, Iter b, [[maybe_unused]] Comp& comp) const {
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+        if constexpr (sizeof(Key) == sizeof(int32_t)) {
+            const int32_t* keys = reinterpret_cast<const int32_t*>(&*a);
+            const std::size_t num = static_cast<std::size_t>(b - a);
+            const __m256i pivot = _mm256_set1_epi32(reinterpret_cast<const int32_t&>(k));
+            std::size_t i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                // bit j is set iff keys[i+j] < k; the keys are sorted, so the
+                // first zero bit marks the boundary
+                const auto mask = static_cast<unsigned>(_mm256_movemask_ps(
+                        _mm256_castsi256_ps(_mm256_cmpgt_epi32(pivot, block))));
+                if (mask != 0xffu) {
+                    return a + i + static_cast<std::size_t>(__builtin_ctz(~mask));
+                }
+            }
+            for (; i < num; ++i) {
+                if (keys[i] >= reinterpret_cast<const int32_t&>(k)) {
+                    break;
+                }
+            }
+            return a + i;
+        }
+#endif
+        return fallback.lower_bound(k, a, b, comp);
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * such that the given key is less than the referenced element.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    inline Iter upper_bound(const Key& k, Iter a, Iter b, [[maybe_unused]] Comp& comp) const {
+#if defined(__AVX2__) && (defined(__GNUC__) || defined(__clang__))
+        if constexpr (sizeof(Key) == sizeof(int32_t)) {
+            const int32_t* keys = reinterpret_cast<const int32_t*>(&*a);
+            const std::size_t num = static_cast<std::size_t>(b - a);
+            const __m256i pivot = _mm256_set1_epi32(reinterpret_cast<const int32_t&>(k));
+            std::size_t i = 0;
+            for (; i + 8 <= num; i += 8) {
+                const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(keys + i));
+                // bit j is set iff keys[i+j] > k; the first such key is the bound
+                const auto mask = static_cast<unsigned>(_mm256_movemask_ps(
+                        _mm256_castsi256_ps(_mm256_cmpgt_epi32(block, pivot))));
+                if (mask != 0u) {
+                    return a + i + static_cast<std::size_t>(__builtin_ctz(mask));
+                }
+            }
+            for (; i < num; ++i) {
+                if (keys[i] > reinterpret_cast<const int32_t&>(k)) {
+                    break;
+                }
+            }
+            return a + i;
+        }
+#endif
+        return fallback.upper_bound(k, a, b, comp);
+    }
+
+private:
+    binary_search fallback;
+};
+
 // ---------- search strategies selection --------------
 
 /**
@@ -227,6 +333,320 @@ struct default_strategy<int> : public linear {};
 template <typename... Ts>
 struct default_strategy<std::tuple<Ts...>> : public linear {};
 
+// ---------- prefetch strategies --------------
+
+/**
+ * A prefetch strategy issuing no prefetch instructions; each tree level is
+ * touched on demand while descending.
+ */
+struct no_prefetch {
+    template <typename Node>
+    void prefetch(const Node*) const {}
+};
+
+/**
+ * A prefetch strategy pulling the keys of the next tree level into cache
+ * while the remaining checks on the current node complete. Point lookups on
+ * trees exceeding the last-level cache are dominated by the pointer-chase
+ * between levels, and issuing the child fetch early hides part of that
+ * latency.
+ */
+struct child_prefetch {
+    template <typename Node>
+    void prefetch([[maybe_unused]] const Node* node) const {
+#if defined(__GNUC__) || defined(__clang__)
+        // cover the child's book-keeping fields and its key block, the
+        // parts read by the next level of the search
+        const char* addr = reinterpret_cast<const char*>(node);
+        for (std::size_t off = 0; off < sizeof(Node); off += 64) {
+            __builtin_prefetch(addr + off, 0, 3);
+        }
+#endif
+    }
+};
+
+// by default every tree prefetches the next level during descent
+using default_prefetch = child_prefetch;
+
+// ---------- node allocation strategies --------------
+
+/**
+ * A node allocation strategy mapping node requests onto a standard
+ * allocator, rebound to the respective node type. Nodes are created
+ * and released one by one through the underlying allocator.
+ */
+template <typename Allocator>
+struct direct_allocation {
+    // nodes have to be torn down individually while clearing a tree
+    static constexpr bool wholesale_release = false;
+
+    direct_allocation() = default;
+
+    direct_allocation(direct_allocation&& other) : bytes(other.bytes.load(std::memory_order_relaxed)) {
+        other.bytes.store(0, std::memory_order_relaxed);
+    }
+
+    direct_allocation& operator=(direct_allocation&& other) {
+        bytes.store(other.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.bytes.store(0, std::memory_order_relaxed);
+        return *this;
+    }
+
+    /**
+     * Creates a new default-constructed node of the given type.
+     */
+    template <typename NodeType>
+    NodeType* create() {
+        typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType> alloc;
+        NodeType* res = alloc.allocate(1);
+        bytes.fetch_add(sizeof(NodeType), std::memory_order_relaxed);
+        return new (res) NodeType();
+    }
+
+    /**
+     * Destroys the given node and returns its memory to the allocator.
+     */
+    template <typename NodeType>
+    void destroy(NodeType* node) {
+        typename std::allocator_traits<Allocator>::template rebind_alloc<NodeType> alloc;
+        node->~NodeType();
+        alloc.deallocate(node, 1);
+        bytes.fetch_sub(sizeof(NodeType), std::memory_order_relaxed);
+    }
+
+    /**
+     * Nothing to release -- no memory is retained beyond the nodes.
+     */
+    void release() {}
+
+    /**
+     * Determines the number of bytes held in nodes; safe to call while the
+     * tree is being updated concurrently.
+     */
+    std::size_t getMemoryUsage() const {
+        return bytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    // the accumulated size of all live nodes
+    std::atomic<std::size_t> bytes{0};
+};
+
+/**
+ * A node allocation strategy placing nodes in large chunks of memory
+ * owned by the enclosing tree. The nodes of a tree end up contiguous in
+ * memory instead of being scattered over the heap, the backing pages are
+ * physically placed on first touch by the inserting threads, and clearing
+ * the tree releases the chunks wholesale instead of tearing down nodes
+ * one by one.
+ *
+ * Note: destroying an individual node merely abandons its storage within
+ * the arena; the memory is only reclaimed by the wholesale release. The
+ * strategy is therefore restricted to trivially destructible keys.
+ */
+struct arena_allocation {
+    // nodes are dropped with their backing chunks while clearing a tree
+    static constexpr bool wholesale_release = true;
+
+    /**
+     * Creates a new default-constructed node of the given type.
+     */
+    template <typename NodeType>
+    NodeType* create() {
+        return new (mem.allocate(sizeof(NodeType))) NodeType();
+    }
+
+    /**
+     * Destroys the given node; its storage remains within the arena
+     * until the next wholesale release.
+     */
+    template <typename NodeType>
+    void destroy(NodeType* node) {
+        node->~NodeType();
+    }
+
+    /**
+     * Releases all node storage of this tree wholesale.
+     */
+    void release() {
+        mem.release();
+    }
+
+    /**
+     * Determines the number of bytes held in node storage; safe to call
+     * while the tree is being updated concurrently.
+     */
+    std::size_t getMemoryUsage() const {
+        return mem.getMemoryUsage();
+    }
+
+private:
+    // the arena providing the storage for all nodes of the tree
+    MemoryArena mem;
+};
+
+/**
+ * A node allocation strategy retaining the storage of destroyed nodes in
+ * free lists instead of returning it to the heap. Subsequent node requests
+ * are served from the retained storage, so a tree that is repeatedly
+ * filled and cleared -- such as the delta relation of a fixpoint
+ * computation -- stops round-tripping the allocator once it has reached
+ * its high-water mark. The retained storage is only returned to the heap
+ * when the tree itself is destroyed.
+ *
+ * Note: storage may be pushed into the free lists only while the tree is
+ * being cleared, which is an exclusive operation; concurrent inserts thus
+ * only ever pop, which keeps the lock-free lists safe from ABA effects.
+ */
+struct pool_allocation {
+    // nodes are torn down individually, their storage enters the pool
+    static constexpr bool wholesale_release = false;
+
+    pool_allocation() = default;
+
+    pool_allocation(pool_allocation&& other) : bytes(other.bytes.load(std::memory_order_relaxed)) {
+        for (std::size_t i = 0; i < pools.size(); i++) {
+            pools[i].size = other.pools[i].size;
+            pools[i].head.store(other.pools[i].head.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+            other.pools[i].head.store(nullptr, std::memory_order_relaxed);
+        }
+        other.bytes.store(0, std::memory_order_relaxed);
+    }
+
+    pool_allocation& operator=(pool_allocation&& other) {
+        release();
+        for (std::size_t i = 0; i < pools.size(); i++) {
+            pools[i].size = other.pools[i].size;
+            pools[i].head.store(other.pools[i].head.load(std::memory_order_relaxed),
+                    std::memory_order_relaxed);
+            other.pools[i].head.store(nullptr, std::memory_order_relaxed);
+        }
+        bytes.store(other.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.bytes.store(0, std::memory_order_relaxed);
+        return *this;
+    }
+
+    ~pool_allocation() {
+        release();
+    }
+
+    /**
+     * Creates a new default-constructed node of the given type, recycling
+     * pooled storage of a previously destroyed node when available.
+     */
+    template <typename NodeType>
+    NodeType* create() {
+        if (void* storage = pop(sizeof(NodeType))) {
+            return new (storage) NodeType();
+        }
+        bytes.fetch_add(sizeof(NodeType), std::memory_order_relaxed);
+        return new (::operator new(sizeof(NodeType))) NodeType();
+    }
+
+    /**
+     * Destroys the given node; its storage is retained for reuse by
+     * subsequent node requests of the same type.
+     */
+    template <typename NodeType>
+    void destroy(NodeType* node) {
+        static_assert(sizeof(NodeType) >= sizeof(block), "nodes must be able to carry a free-list link");
+        node->~NodeType();
+        push(sizeof(NodeType), node);
+    }
+
+    /**
+     * Returns all pooled node storage to the heap; storage of live nodes
+     * is unaffected.
+     */
+    void release() {
+        for (auto& pool : pools) {
+            block* cur = pool.head.exchange(nullptr, std::memory_order_relaxed);
+            while (cur != nullptr) {
+                block* next = cur->next;
+                ::operator delete(cur);
+                bytes.fetch_sub(pool.size, std::memory_order_relaxed);
+                cur = next;
+            }
+        }
+    }
+
+    /**
+     * Determines the number of bytes held in nodes and pooled storage;
+     * safe to call while the tree is being updated concurrently.
+     */
+    std::size_t getMemoryUsage() const {
+        return bytes.load(std::memory_order_relaxed);
+    }
+
+private:
+    // a link overlaid on the storage of a destroyed node
+    struct block {
+        block* next;
+    };
+
+    // a free list of uniformly sized storage blocks
+    struct pool {
+        std::size_t size = 0;
+        std::atomic<block*> head{nullptr};
+    };
+
+    void* pop(std::size_t size) {
+        for (auto& pool : pools) {
+            if (pool.size != size) {
+                continue;
+            }
+            block* cur = pool.head.load(std::memory_order_acquire);
+            while (cur != nullptr &&
+                    !pool.head.compare_exchange_weak(cur, cur->next, std::memory_order_acq_rel)) {
+            }
+            return cur;
+        }
+        return nullptr;
+    }
+
+    void push(std::size_t size, void* storage) {
+        for (auto& pool : pools) {
+            if (pool.size == 0) {
+                pool.size = size;
+            }
+            if (pool.size != size) {
+                continue;
+            }
+            auto* cur = static_cast<block*>(storage);
+            cur->next = pool.head.load(std::memory_order_relaxed);
+            while (!pool.head.compare_exchange_weak(cur->next, cur, std::memory_order_release)) {
+            }
+            return;
+        }
+        // more distinct node sizes than pools -- cannot happen for b-trees
+        assert(false && "no free list for the given node size");
+        ::operator delete(storage);
+        bytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+
+    // one free list per node type of the owning tree (inner and leaf)
+    std::array<pool, 2> pools;
+
+    // the accumulated size of all live nodes and pooled blocks
+    std::atomic<std::size_t> bytes{0};
+};
+
+/**
+ * A template-meta class resolving the node allocation strategy for a
+ * given allocator type: dedicated node allocation strategies are utilized
+ * directly, anything else is interpreted as a standard allocator.
+ */
+template <typename Allocator, typename = void>
+struct allocation_strategy {
+    using type = direct_allocation<Allocator>;
+};
+
+template <typename Allocator>
+struct allocation_strategy<Allocator, std::void_t<decltype(Allocator::wholesale_release)>> {
+    using type = Allocator;
+};
+
 /**
  * The default non-updater
  */
@@ -240,19 +660,21 @@ struct updater {
  *
  * @tparam Key             .. the element type to be stored in this tree
  * @tparam Comparator     .. a class defining an order on the stored elements
- * @tparam Allocator     .. utilized for allocating memory for required nodes
+ * @tparam Allocator     .. the strategy utilized for allocating memory for required nodes;
+ *                          either a standard allocator or a node allocation strategy
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
  * @tparam isSet        .. true = set, false = multiset
+ * @tparam PrefetchStrategy .. controls prefetching of the next level during tree descent
  */
-template <typename Key, typename Comparator,
-        typename Allocator,  // is ignored so far - TODO: add support
-        unsigned blockSize, typename SearchStrategy, bool isSet, typename WeakComparator = Comparator,
-        typename Updater = detail::updater<Key>>
+template <typename Key, typename Comparator, typename Allocator, unsigned blockSize,
+        typename SearchStrategy, bool isSet, typename WeakComparator = Comparator,
+        typename Updater = detail::updater<Key>, typename PrefetchStrategy = default_prefetch>
 class btree {
 public:
     class iterator;
     using const_iterator = iterator;
+    using reverse_iterator = std::reverse_iterator<iterator>;
 
     using key_type = Key;
     using element_type = Key;
@@ -263,6 +685,8 @@ protected:
 
     const static SearchStrategy search;
 
+    const static PrefetchStrategy prefetcher;
+
     /* ---------- comparison utilities ---------------- */
 
     mutable Comparator comp;
@@ -298,6 +722,12 @@ protected:
     using field_index_type = uint8_t;
     using lock_type = OptimisticReadWriteLock;
 
+    // the node allocation strategy resolved for the given allocator
+    using allocation = typename allocation_strategy<Allocator>::type;
+
+    static_assert(!allocation::wholesale_release || std::is_trivially_destructible<Key>::value,
+            "wholesale node release requires trivially destructible keys");
+
     struct node;
 
     /**
@@ -383,12 +813,13 @@ protected:
         node(bool inner) : base(inner) {}
 
         /**
-         * A deep-copy operation creating a clone of this node.
+         * A deep-copy operation creating a clone of this node within
+         * the given allocation strategy.
          */
-        node* clone() const {
+        node* clone(allocation& mem) const {
             // create a clone of this node
-            node* res = (this->isInner()) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* res = (this->isInner()) ? static_cast<node*>(mem.template create<inner_node>())
+                                          : static_cast<node*>(mem.template create<leaf_node>());
 
             // copy basic fields
             res->position = this->position;
@@ -406,7 +837,7 @@ protected:
             // copy child nodes recursively
             auto* ires = (inner_node*)res;
             for (size_type i = 0; i <= this->numElements; ++i) {
-                ires->children[i] = this->getChild(i)->clone();
+                ires->children[i] = this->getChild(i)->clone(mem);
                 ires->children[i]->parent = res;
             }
 
@@ -544,14 +975,15 @@ protected:
          * @param idx  .. the position of the insert causing the split
          */
 #ifdef IS_PARALLEL
-        void split(node** root, lock_type& root_lock, int idx, std::vector<node*>& locked_nodes) {
+        void split(node** root, lock_type& root_lock, allocation& mem, int idx,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        void split(node** root, lock_type& root_lock, int idx) {
+        void split(node** root, lock_type& root_lock, allocation& mem, int idx) {
 #endif
             assert(this->numElements == maxKeys);
 
@@ -559,8 +991,8 @@ protected:
             int split_point = getSplitPoint(idx);
 
             // create a new sibling node
-            node* sibling = (this->inner) ? static_cast<node*>(new inner_node())
-                                          : static_cast<node*>(new leaf_node());
+            node* sibling = (this->inner) ? static_cast<node*>(mem.template create<inner_node>())
+                                          : static_cast<node*>(mem.template create<leaf_node>());
 
 #ifdef IS_PARALLEL
             // lock sibling
@@ -590,9 +1022,9 @@ protected:
 
             // update parent
 #ifdef IS_PARALLEL
-            grow_parent(root, root_lock, sibling, locked_nodes);
+            grow_parent(root, root_lock, mem, sibling, locked_nodes);
 #else
-            grow_parent(root, root_lock, sibling);
+            grow_parent(root, root_lock, mem, sibling);
 #endif
         }
 
@@ -609,14 +1041,15 @@ protected:
          */
         // TODO: remove root_lock ... no longer needed
 #ifdef IS_PARALLEL
-        int rebalance_or_split(node** root, lock_type& root_lock, int idx, std::vector<node*>& locked_nodes) {
+        int rebalance_or_split(node** root, lock_type& root_lock, allocation& mem, int idx,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        int rebalance_or_split(node** root, lock_type& root_lock, int idx) {
+        int rebalance_or_split(node** root, lock_type& root_lock, allocation& mem, int idx) {
 #endif
 
             // this node is full ... and needs some space
@@ -634,7 +1067,7 @@ protected:
                 // lock access to left sibling
                 if (!left->lock.try_start_write()) {
                     // left node is currently updated => skip balancing and split
-                    split(root, root_lock, idx, locked_nodes);
+                    split(root, root_lock, mem, idx, locked_nodes);
                     return 0;
                 }
 #endif
@@ -707,9 +1140,9 @@ protected:
 
             // Option B) split node
 #ifdef IS_PARALLEL
-            split(root, root_lock, idx, locked_nodes);
+            split(root, root_lock, mem, idx, locked_nodes);
 #else
-            split(root, root_lock, idx);
+            split(root, root_lock, mem, idx);
 #endif
             return 0;  // = no re-balancing
         }
@@ -724,21 +1157,22 @@ protected:
          * @param sibling .. the new right-sibling to be add to the parent node
          */
 #ifdef IS_PARALLEL
-        void grow_parent(node** root, lock_type& root_lock, node* sibling, std::vector<node*>& locked_nodes) {
+        void grow_parent(node** root, lock_type& root_lock, allocation& mem, node* sibling,
+                std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(!this->parent || this->parent->lock.is_write_locked());
             assert((this->parent != nullptr) || root_lock.is_write_locked());
             assert(this->isLeaf() || souffle::contains(locked_nodes, this));
             assert(!this->parent || souffle::contains(locked_nodes, const_cast<node*>(this->parent)));
 #else
-        void grow_parent(node** root, lock_type& root_lock, node* sibling) {
+        void grow_parent(node** root, lock_type& root_lock, allocation& mem, node* sibling) {
 #endif
 
             if (this->parent == nullptr) {
                 assert(*root == this);
 
                 // create a new root node
-                auto* new_root = new inner_node();
+                auto* new_root = mem.template create<inner_node>();
                 new_root->numElements = 1;
                 new_root->keys[0] = keys[this->numElements];
 
@@ -760,9 +1194,9 @@ protected:
 
 #ifdef IS_PARALLEL
                 parent->insert_inner(
-                        root, root_lock, pos, this, keys[this->numElements], sibling, locked_nodes);
+                        root, root_lock, mem, pos, this, keys[this->numElements], sibling, locked_nodes);
 #else
-                parent->insert_inner(root, root_lock, pos, this, keys[this->numElements], sibling);
+                parent->insert_inner(root, root_lock, mem, pos, this, keys[this->numElements], sibling);
 #endif
             }
         }
@@ -776,13 +1210,13 @@ protected:
          * @param newNode .. the new right-child of the inserted key
          */
 #ifdef IS_PARALLEL
-        void insert_inner(node** root, lock_type& root_lock, unsigned pos, node* predecessor, const Key& key,
-                node* newNode, std::vector<node*>& locked_nodes) {
+        void insert_inner(node** root, lock_type& root_lock, allocation& mem, unsigned pos,
+                node* predecessor, const Key& key, node* newNode, std::vector<node*>& locked_nodes) {
             assert(this->lock.is_write_locked());
             assert(souffle::contains(locked_nodes, this));
 #else
-        void insert_inner(node** root, lock_type& root_lock, unsigned pos, node* predecessor, const Key& key,
-                node* newNode) {
+        void insert_inner(node** root, lock_type& root_lock, allocation& mem, unsigned pos,
+                node* predecessor, const Key& key, node* newNode) {
 #endif
 
             // check capacity
@@ -795,9 +1229,9 @@ protected:
 
                 // split this node
 #ifdef IS_PARALLEL
-                pos -= rebalance_or_split(root, root_lock, pos, locked_nodes);
+                pos -= rebalance_or_split(root, root_lock, mem, pos, locked_nodes);
 #else
-                pos -= rebalance_or_split(root, root_lock, pos);
+                pos -= rebalance_or_split(root, root_lock, mem, pos);
 #endif
 
                 // complete insertion within new sibling if necessary
@@ -822,9 +1256,9 @@ protected:
                     }
 
                     pos = (i > other->numElements) ? 0 : i;
-                    other->insert_inner(root, root_lock, pos, predecessor, key, newNode, locked_nodes);
+                    other->insert_inner(root, root_lock, mem, pos, predecessor, key, newNode, locked_nodes);
 #else
-                    other->insert_inner(root, root_lock, pos, predecessor, key, newNode);
+                    other->insert_inner(root, root_lock, mem, pos, predecessor, key, newNode);
 #endif
                     return;
                 }
@@ -1068,19 +1502,6 @@ protected:
 
         // a simple default constructor initializing member fields
         inner_node() : node(true) {}
-
-        // clear up child nodes recursively
-        ~inner_node() {
-            for (unsigned i = 0; i <= this->numElements; ++i) {
-                if (children[i] != nullptr) {
-                    if (children[i]->isLeaf()) {
-                        delete static_cast<leaf_node*>(children[i]);
-                    } else {
-                        delete static_cast<inner_node*>(children[i]);
-                    }
-                }
-            }
-        }
     };
 
     /**
@@ -1106,11 +1527,11 @@ public:
         field_index_type pos = 0;
 
     public:
-        using iterator_category = std::forward_iterator_tag;
+        using iterator_category = std::bidirectional_iterator_tag;
         using value_type = Key;
         using difference_type = ptrdiff_t;
-        using pointer = value_type*;
-        using reference = value_type&;
+        using pointer = const value_type*;
+        using reference = const value_type&;
 
         // default constructor -- creating an end-iterator
         iterator() : cur(nullptr) {}
@@ -1177,10 +1598,53 @@ public:
             return *this;
         }
 
+        // the decrement operator enabling descending scans via std::reverse_iterator
+        iterator& operator--() {
+            // the quick mode -- if in a leaf and there are elements on the left
+            if (cur->isLeaf() && pos > 0) {
+                --pos;
+                return *this;
+            }
+
+            // otherwise it is a bit more tricky
+
+            // A) currently in an inner node => go to the right-most element of the left sub-tree
+            if (cur->isInner()) {
+                cur = cur->getChildren()[pos];
+                while (!cur->isLeaf()) {
+                    cur = cur->getChildren()[cur->getNumElements()];
+                }
+                pos = cur->getNumElements();
+
+                // nodes may be empty due to biased insertion
+                if (pos > 0) {
+                    --pos;
+                    return *this;
+                }
+            }
+
+            // B) we are at the left-most element of a leaf => go to previous inner node
+            assert(cur->isLeaf());
+            assert(pos == 0);
+
+            while (cur != nullptr && pos == 0) {
+                pos = cur->getPositionInParent();
+                cur = cur->getParent();
+            }
+            if (cur != nullptr) {
+                --pos;
+            }
+            return *this;
+        }
+
         // prints a textual representation of this iterator to the given stream (mainly for debugging)
         void print(std::ostream& out = std::cout) const {
             out << cur << "[" << (int)pos << "]";
         }
+
+        // grants the tree access to the referenced position, e.g. for the
+        // node-wise range count
+        friend class btree;
     };
 
     /**
@@ -1203,6 +1667,13 @@ public:
         // the node where the last upper-bound operation terminated
         node_cache last_upper_bound_end;
 
+        // adaptive gates suspending the hint probes per operation kind
+        // when the observed locality does not pay for them
+        HintProbeGate insert_gate;
+        HintProbeGate find_gate;
+        HintProbeGate lower_bound_gate;
+        HintProbeGate upper_bound_gate;
+
         // default constructor
         btree_operation_hints() = default;
 
@@ -1223,18 +1694,30 @@ protected:
     node* volatile root;
 
     // a lock to synchronize update operations on the root pointer
-    lock_type root_lock;
+    mutable lock_type root_lock;
 #else
     // a pointer to the root node of this tree
     node* root;
 
     // required to not duplicate too much code
-    lock_type root_lock;
+    mutable lock_type root_lock;
 #endif
 
     // a pointer to the left-most node of this tree (initial note for iteration)
     leaf_node* leftmost;
 
+    // the allocation strategy backing the nodes of this tree
+    mutable allocation mem;
+
+    // nodes disconnected by erase operations; reclamation is deferred to
+    // clear() so that stale operation hints never touch freed memory
+    std::vector<node*> detached;
+
+    // the number of elements stored in this tree, maintained on insertion
+    // and removal so that size() is a constant-time lookup instead of a
+    // full-tree traversal
+    std::atomic<size_type> m_size{0};
+
     /* -------------- operator hint statistics ----------------- */
 
     // an aggregation of statistical values of the hint utilization
@@ -1273,9 +1756,13 @@ public:
 
     // a move constructor
     btree(btree&& other)
-            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost) {
+            : comp(other.comp), weak_comp(other.weak_comp), root(other.root), leftmost(other.leftmost),
+              mem(std::move(other.mem)), detached(std::move(other.detached)),
+              m_size(other.m_size.load(std::memory_order_relaxed)) {
         other.root = nullptr;
         other.leftmost = nullptr;
+        other.detached.clear();
+        other.m_size.store(0, std::memory_order_relaxed);
     }
 
     // a copy constructor
@@ -1284,14 +1771,6 @@ public:
         *this = set;
     }
 
-protected:
-    /**
-     * An internal constructor enabling the specific creation of a tree
-     * based on internal parameters.
-     */
-    btree(size_type /* size */, node* root, leaf_node* leftmost) : root(root), leftmost(leftmost) {}
-
-public:
     // the destructor freeing all contained nodes
     ~btree() {
         clear();
@@ -1306,7 +1785,7 @@ public:
 
     // determines the number of elements in this tree
     size_type size() const {
-        return (root) ? root->countEntries() : 0;
+        return m_size.load(std::memory_order_relaxed);
     }
 
     /**
@@ -1339,7 +1818,7 @@ public:
             }
 
             // create new node
-            leftmost = new leaf_node();
+            leftmost = mem.template create<leaf_node>();
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
@@ -1349,6 +1828,7 @@ public:
 
             hints.last_insert.access(leftmost);
 
+            m_size.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
 
@@ -1376,11 +1856,17 @@ public:
             return true;
         };
 
-        if (hints.last_insert.any(checkHint)) {
-            // register this as a hit
-            hint_stats.inserts.addHit();
+        if (hints.insert_gate.shouldProbe()) {
+            if (hints.last_insert.any(checkHint)) {
+                hints.insert_gate.registerOutcome(true);
+                // register this as a hit
+                hint_stats.inserts.addHit();
+            } else {
+                hints.insert_gate.registerOutcome(false);
+                // register this as a miss
+                hint_stats.inserts.addMiss();
+            }
         } else {
-            // register this as a miss
             hint_stats.inserts.addMiss();
         }
 
@@ -1537,7 +2023,7 @@ public:
 
                 // split this node
                 auto old_root = root;
-                idx -= cur->rebalance_or_split(const_cast<node**>(&root), root_lock, idx, parents);
+                idx -= cur->rebalance_or_split(const_cast<node**>(&root), root_lock, mem, idx, parents);
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -1582,6 +2068,7 @@ public:
 
             // remember last insertion position
             hints.last_insert.access(cur);
+            m_size.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
 
@@ -1589,13 +2076,14 @@ public:
         // special handling for inserting first element
         if (empty()) {
             // create new node
-            leftmost = new leaf_node();
+            leftmost = mem.template create<leaf_node>();
             leftmost->numElements = 1;
             leftmost->keys[0] = k;
             root = leftmost;
 
             hints.last_insert.access(leftmost);
 
+            m_size.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
 
@@ -1610,8 +2098,14 @@ public:
         };
 
         // test last insert
-        if (hints.last_insert.any(checkHints)) {
-            hint_stats.inserts.addHit();
+        if (hints.insert_gate.shouldProbe()) {
+            if (hints.last_insert.any(checkHints)) {
+                hints.insert_gate.registerOutcome(true);
+                hint_stats.inserts.addHit();
+            } else {
+                hints.insert_gate.registerOutcome(false);
+                hint_stats.inserts.addMiss();
+            }
         } else {
             hint_stats.inserts.addMiss();
         }
@@ -1664,7 +2158,7 @@ public:
 
             if (cur->numElements >= node::maxKeys) {
                 // split this node
-                idx -= cur->rebalance_or_split(&root, root_lock, static_cast<int>(idx));
+                idx -= cur->rebalance_or_split(&root, root_lock, mem, static_cast<int>(idx));
 
                 // insert element in right fragment
                 if (((size_type)idx) > cur->numElements) {
@@ -1688,6 +2182,7 @@ public:
             // remember last insertion position
             hints.last_insert.access(cur);
 
+            m_size.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
 #endif
@@ -1707,41 +2202,156 @@ public:
         }
     }
 
-    // Obtains an iterator referencing the first element of the tree.
-    iterator begin() const {
-        return iterator(leftmost, 0);
-    }
-
-    // Obtains an iterator referencing the position after the last element of the tree.
-    iterator end() const {
-        return iterator();
-    }
-
     /**
-     * Partitions the full range of this set into up to a given number of chunks.
-     * The chunks will cover approximately the same number of elements. Also, the
-     * number of chunks will only approximate the desired number of chunks.
-     *
-     * @param num .. the number of chunks requested
-     * @return a list of chunks partitioning this tree
+     * Inserts the given range of elements, expected to be ordered according
+     * to the element order of this tree, into this tree. If this tree is
+     * empty, the tree is bulk-loaded by building its nodes bottom-up, thereby
+     * avoiding the per-element root-to-leaf descent of the ordinary insert.
+     * On a non-empty tree, a range that turns out not to be ordered, or a
+     * tree updating weakly equal elements on insertion, the operation falls
+     * back to an ordinary (hinted) insertion of the range; the given
+     * iterators must support multiple passes.
      */
-    std::vector<chunk> partition(size_type num) const {
-        return getChunks(num);
-    }
+    template <typename Iter>
+    void insert_sorted(const Iter& a, const Iter& b) {
+        // the fast path is only valid on an empty tree; trees updating
+        // weakly equal elements also need the ordinary path, since the bulk
+        // construction would retain both elements instead of updating
+        if (!empty() || typeid(Comparator) != typeid(WeakComparator)) {
+            insert(a, b);
+            return;
+        }
 
-    std::vector<chunk> getChunks(size_type num) const {
-        std::vector<chunk> res;
-        if (empty()) {
-            return res;
+        // quick exit - empty range
+        if (a == b) {
+            return;
         }
-        return root->collectChunks(res, num, begin(), end());
-    }
 
-    /**
-     * Determines whether the given element is a member of this tree.
-     */
-    bool contains(const Key& k) const {
-        operation_hints hints;
+        // buffer the stream to obtain random access for the bulk construction;
+        // for sets, duplicates within the ordered input have to be dropped
+        std::vector<Key> buffer;
+        for (auto it = a; it != b; ++it) {
+            if (!buffer.empty()) {
+                // an out-of-order element voids the order expected of the
+                // range; nothing has been built yet, so the whole range can
+                // still take the ordinary insertion
+                if (less(*it, buffer.back())) {
+                    insert(a, b);
+                    return;
+                }
+                if (isSet && equal(buffer.back(), *it)) {
+                    continue;
+                }
+            }
+            buffer.push_back(*it);
+        }
+
+        // build the tree bottom-up utilizing the bulk-load facility
+        root = buildSubTree(buffer.begin(), buffer.end() - 1, mem);
+
+        // update leftmost reference
+        auto tmp = root;
+        while (!tmp->isLeaf()) {
+            tmp = tmp->getChild(0);
+        }
+        leftmost = static_cast<leaf_node*>(tmp);
+        m_size.store(static_cast<size_type>(buffer.size()), std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds all elements of the given tree to this tree. Both trees share
+     * their element order, so the source is traversed leaf-wise and replayed
+     * in order, letting each insertion reuse the leaf position of its
+     * predecessor via hints. An empty target adopts a copy of the source
+     * structure wholesale instead.
+     */
+    void insertAll(const btree& other) {
+        // quick exit - nothing to merge
+        if (other.empty()) {
+            return;
+        }
+
+        // an empty target can clone the source tree as a whole
+        if (empty()) {
+            *this = other;
+            return;
+        }
+
+        // otherwise replay the source in order; consecutive elements fall
+        // into the same or an adjacent leaf, so the hinted insert rarely
+        // needs to descend from the root
+        operation_hints hints;
+        for (const auto& key : other) {
+            insert(key, hints);
+        }
+    }
+
+    // Obtains an iterator referencing the first element of the tree.
+    iterator begin() const {
+        // an erase may leave the left-most leaf empty; in that case the first
+        // element lives in an ancestor, located by the climb of operator++
+        if (leftmost != nullptr && leftmost->numElements == 0) {
+            node const* cur = leftmost;
+            field_index_type pos = 0;
+            while (cur != nullptr && pos == cur->getNumElements()) {
+                pos = cur->getPositionInParent();
+                cur = cur->getParent();
+            }
+            return (cur != nullptr) ? iterator(cur, pos) : end();
+        }
+        return iterator(leftmost, 0);
+    }
+
+    // Obtains an iterator referencing the position after the last element of the tree.
+    iterator end() const {
+        return iterator();
+    }
+
+    // Obtains a reverse iterator referencing the last element of the tree.
+    reverse_iterator rbegin() const {
+        if (empty()) {
+            return rend();
+        }
+        // wrap the position after the right-most element; a decrement of the
+        // wrapped iterator locates the last element, climbing past leaves left
+        // empty by erase operations
+        node const* cur = root;
+        while (!cur->isLeaf()) {
+            cur = cur->getChildren()[cur->getNumElements()];
+        }
+        return reverse_iterator(iterator(cur, cur->getNumElements()));
+    }
+
+    // Obtains a reverse iterator referencing the position before the first element of the tree.
+    reverse_iterator rend() const {
+        return reverse_iterator(begin());
+    }
+
+    /**
+     * Partitions the full range of this set into up to a given number of chunks.
+     * The chunks will cover approximately the same number of elements. Also, the
+     * number of chunks will only approximate the desired number of chunks.
+     *
+     * @param num .. the number of chunks requested
+     * @return a list of chunks partitioning this tree
+     */
+    std::vector<chunk> partition(size_type num) const {
+        return getChunks(num);
+    }
+
+    std::vector<chunk> getChunks(size_type num) const {
+        std::vector<chunk> res;
+        if (empty()) {
+            return res;
+        }
+        return root->collectChunks(res, num, begin(), end());
+    }
+
+    /**
+     * Determines whether the given element is a member of this tree.
+     */
+    bool contains(const Key& k) const {
+        operation_hints hints;
         return contains(k, hints);
     }
 
@@ -1752,6 +2362,63 @@ public:
         return find(k, hints) != end();
     }
 
+    /**
+     * Probes this tree for every key of the given sorted block and records
+     * a membership flag per key through the output iterator. The tree is
+     * walked once in key order: each probe resumes from the node the
+     * previous probe ended in and ascends through the parent chain only as
+     * far as needed before descending again, so consecutive probes sharing
+     * a path prefix do not repeat the descent from the root. For blocks of
+     * nearly-sorted keys this amortises the tree height across the block,
+     * where the single-node memory of operation hints only captures reuse
+     * of the last leaf.
+     *
+     * The keys must be sorted with respect to the comparator of this tree;
+     * like iteration, the traversal must not overlap with concurrent
+     * modifications of this tree.
+     */
+    template <typename Iterator, typename OutputIterator>
+    void contains_sorted(Iterator first, Iterator last, OutputIterator out) const {
+        if (empty()) {
+            for (; first != last; ++first) {
+                *out++ = false;
+            }
+            return;
+        }
+        node* cur = root;
+        for (; first != last; ++first) {
+            const Key& k = *first;
+            // ascend to the closest retained ancestor whose key range still
+            // covers the probe; the root covers everything
+            while (cur->getParent() != nullptr && !covers(cur, k)) {
+                cur = cur->getParent();
+            }
+            // descend as in find()
+            while (true) {
+                auto a = &(cur->keys[0]);
+                auto b = &(cur->keys[cur->numElements]);
+
+                auto pos = search(k, a, b, comp);
+
+                if (cur->inner) {
+                    prefetcher.prefetch(cur->getChild(pos - a));
+                }
+
+                if (pos < b && equal(*pos, k)) {
+                    *out++ = true;
+                    break;
+                }
+
+                if (!cur->inner) {
+                    *out++ = false;
+                    break;
+                }
+
+                cur = cur->getChild(pos - a);
+            }
+        }
+    }
+
     /**
      * Locates the given key within this tree and returns an iterator
      * referencing its position. If not found, an end-iterator will be returned.
@@ -1766,6 +2433,99 @@ public:
      * referencing its position. If not found, an end-iterator will be returned.
      */
     iterator find(const Key& k, operation_hints& hints) const {
+#ifdef IS_PARALLEL
+        if (empty()) {
+            return end();
+        }
+
+        // The descent is optimistic: no locks are taken, but each node's
+        // version is validated before its content is acted upon, and the
+        // search restarts from the root if a concurrent writer interfered.
+        node* cur = nullptr;
+        typename lock_type::Lease cur_lease;
+
+        auto checkHints = [&](node* last_find_end) {
+            if (!last_find_end) return false;
+            auto lease = last_find_end->lock.start_read();
+            if (!covers(last_find_end, k)) return false;
+            if (!last_find_end->lock.validate(lease)) return false;
+            cur = last_find_end;
+            cur_lease = lease;
+            return true;
+        };
+
+        // test last location searched (temporal locality)
+        if (hints.find_gate.shouldProbe()) {
+            if (hints.last_find_end.any(checkHints)) {
+                hints.find_gate.registerOutcome(true);
+                // register it as a hit
+                hint_stats.contains.addHit();
+            } else {
+                hints.find_gate.registerOutcome(false);
+                // register it as a miss
+                hint_stats.contains.addMiss();
+            }
+        } else {
+            hint_stats.contains.addMiss();
+        }
+
+        // an iterative implementation (since 2/7 faster than recursive)
+
+        while (true) {
+            if (cur == nullptr) {
+                // pick up the current root; the pointer may be swapped by a
+                // concurrent root split, which the root lock version detects
+                auto root_lease = root_lock.start_read();
+                cur = root;
+                cur_lease = cur->lock.start_read();
+                if (!root_lock.end_read(root_lease)) {
+                    cur = nullptr;
+                    continue;
+                }
+            }
+
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search(k, a, b, comp);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(pos - a));
+            }
+
+            if (pos < b && equal(*pos, k)) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                hints.last_find_end.access(cur);
+                return iterator(cur, static_cast<field_index_type>(pos - a));
+            }
+
+            if (!cur->inner) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                hints.last_find_end.access(cur);
+                return end();
+            }
+
+            // continue search in child node, handing the lease down a level
+            auto next = cur->getChild(pos - a);
+            auto next_lease = next->lock.start_read();
+            if (!cur->lock.end_read(cur_lease)) {
+                // start over
+                cur = nullptr;
+                continue;
+            }
+            cur = next;
+            cur_lease = next_lease;
+        }
+#else
         if (empty()) {
             return end();
         }
@@ -1780,11 +2540,17 @@ public:
         };
 
         // test last location searched (temporal locality)
-        if (hints.last_find_end.any(checkHints)) {
-            // register it as a hit
-            hint_stats.contains.addHit();
+        if (hints.find_gate.shouldProbe()) {
+            if (hints.last_find_end.any(checkHints)) {
+                hints.find_gate.registerOutcome(true);
+                // register it as a hit
+                hint_stats.contains.addHit();
+            } else {
+                hints.find_gate.registerOutcome(false);
+                // register it as a miss
+                hint_stats.contains.addMiss();
+            }
         } else {
-            // register it as a miss
             hint_stats.contains.addMiss();
         }
 
@@ -1796,37 +2562,323 @@ public:
 
             auto pos = search(k, a, b, comp);
 
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(pos - a));
+            }
+
             if (pos < b && equal(*pos, k)) {
                 hints.last_find_end.access(cur);
                 return iterator(cur, static_cast<field_index_type>(pos - a));
             }
 
             if (!cur->inner) {
-                hints.last_find_end.access(cur);
-                return end();
+                hints.last_find_end.access(cur);
+                return end();
+            }
+
+            // continue search in child node
+            cur = cur->getChild(pos - a);
+        }
+#endif
+    }
+
+    // a manual, non-hinted interface for a weak-equality lookup
+    iterator weak_find(const Key& k) const {
+        operation_hints hints;
+        return weak_find(k, hints);
+    }
+
+    /**
+     * Locates an element weakly equal to the given key within this tree
+     * and returns an iterator referencing its position; if not found, an
+     * end-iterator will be returned. In a set maintained under a weak
+     * comparator there is at most one such element, so a single descent
+     * replaces a full-comparator range query with open bounds on the
+     * attributes the weak comparator ignores.
+     */
+    iterator weak_find(const Key& k, operation_hints& hints) const {
+#ifdef IS_PARALLEL
+        if (empty()) {
+            return end();
+        }
+
+        // the same optimistic, version-validated descent as find, steered
+        // by the weak comparator
+        node* cur = nullptr;
+        typename lock_type::Lease cur_lease;
+
+        auto checkHints = [&](node* last_find_end) {
+            if (!last_find_end) return false;
+            auto lease = last_find_end->lock.start_read();
+            if (!weak_covers(last_find_end, k)) return false;
+            if (!last_find_end->lock.validate(lease)) return false;
+            cur = last_find_end;
+            cur_lease = lease;
+            return true;
+        };
+
+        // test last location searched (temporal locality)
+        if (hints.find_gate.shouldProbe()) {
+            if (hints.last_find_end.any(checkHints)) {
+                hints.find_gate.registerOutcome(true);
+                hint_stats.contains.addHit();
+            } else {
+                hints.find_gate.registerOutcome(false);
+                hint_stats.contains.addMiss();
+            }
+        } else {
+            hint_stats.contains.addMiss();
+        }
+
+        while (true) {
+            if (cur == nullptr) {
+                // pick up the current root; the pointer may be swapped by a
+                // concurrent root split, which the root lock version detects
+                auto root_lease = root_lock.start_read();
+                cur = root;
+                cur_lease = cur->lock.start_read();
+                if (!root_lock.end_read(root_lease)) {
+                    cur = nullptr;
+                    continue;
+                }
+            }
+
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search(k, a, b, weak_comp);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(pos - a));
+            }
+
+            if (pos < b && weak_equal(*pos, k)) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                hints.last_find_end.access(cur);
+                return iterator(cur, static_cast<field_index_type>(pos - a));
+            }
+
+            if (!cur->inner) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                hints.last_find_end.access(cur);
+                return end();
+            }
+
+            // continue search in child node, handing the lease down a level
+            auto next = cur->getChild(pos - a);
+            auto next_lease = next->lock.start_read();
+            if (!cur->lock.end_read(cur_lease)) {
+                // start over
+                cur = nullptr;
+                continue;
+            }
+            cur = next;
+            cur_lease = next_lease;
+        }
+#else
+        if (empty()) {
+            return end();
+        }
+
+        node* cur = root;
+
+        auto checkHints = [&](node* last_find_end) {
+            if (!last_find_end) return false;
+            if (!weak_covers(last_find_end, k)) return false;
+            cur = last_find_end;
+            return true;
+        };
+
+        // test last location searched (temporal locality)
+        if (hints.find_gate.shouldProbe()) {
+            if (hints.last_find_end.any(checkHints)) {
+                hints.find_gate.registerOutcome(true);
+                hint_stats.contains.addHit();
+            } else {
+                hints.find_gate.registerOutcome(false);
+                hint_stats.contains.addMiss();
+            }
+        } else {
+            hint_stats.contains.addMiss();
+        }
+
+        while (true) {
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search(k, a, b, weak_comp);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(pos - a));
+            }
+
+            if (pos < b && weak_equal(*pos, k)) {
+                hints.last_find_end.access(cur);
+                return iterator(cur, static_cast<field_index_type>(pos - a));
+            }
+
+            if (!cur->inner) {
+                hints.last_find_end.access(cur);
+                return end();
+            }
+
+            // continue search in child node
+            cur = cur->getChild(pos - a);
+        }
+#endif
+    }
+
+    /**
+     * Removes the given key from this tree, returning whether an element
+     * has actually been removed. The tree is not rebalanced: leaves may
+     * become empty and disconnected nodes are only reclaimed on clear().
+     * Unlike the other operations, erase must not run concurrently with
+     * any other operation on this tree.
+     */
+    bool erase(const Key& k) {
+        if (empty()) {
+            return false;
+        }
+
+        // locate the node and position containing the key
+        node* cur = root;
+        field_index_type pos = 0;
+        while (true) {
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+            auto it = search(k, a, b, comp);
+            if (it != b && equal(*it, k)) {
+                pos = static_cast<field_index_type>(it - a);
+                break;
+            }
+            if (!cur->inner) {
+                return false;
+            }
+            cur = cur->getChild(static_cast<field_index_type>(it - a));
+        }
+
+        eraseAt(cur, pos);
+        m_size.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Obtains a lower boundary for the given key -- hence an iterator referencing
+     * the smallest value that is not less the given key. If there is no such element,
+     * an end-iterator will be returned.
+     */
+    iterator lower_bound(const Key& k) const {
+        operation_hints hints;
+        return lower_bound(k, hints);
+    }
+
+    /**
+     * Obtains a lower boundary for the given key -- hence an iterator referencing
+     * the smallest value that is not less the given key. If there is no such element,
+     * an end-iterator will be returned.
+     */
+    iterator lower_bound(const Key& k, operation_hints& hints) const {
+#ifdef IS_PARALLEL
+        if (empty()) {
+            return end();
+        }
+
+        // optimistic descent, restarted on concurrent modification (see find)
+        node* cur = nullptr;
+        typename lock_type::Lease cur_lease;
+
+        auto checkHints = [&](node* last_lower_bound_end) {
+            if (!last_lower_bound_end) return false;
+            auto lease = last_lower_bound_end->lock.start_read();
+            if (!covers(last_lower_bound_end, k)) return false;
+            if (!last_lower_bound_end->lock.validate(lease)) return false;
+            cur = last_lower_bound_end;
+            cur_lease = lease;
+            return true;
+        };
+
+        // test last searched node
+        if (hints.lower_bound_gate.shouldProbe()) {
+            if (hints.last_lower_bound_end.any(checkHints)) {
+                hints.lower_bound_gate.registerOutcome(true);
+                hint_stats.lower_bound.addHit();
+            } else {
+                hints.lower_bound_gate.registerOutcome(false);
+                hint_stats.lower_bound.addMiss();
+            }
+        } else {
+            hint_stats.lower_bound.addMiss();
+        }
+
+        iterator res = end();
+        while (true) {
+            if (cur == nullptr) {
+                auto root_lease = root_lock.start_read();
+                cur = root;
+                cur_lease = cur->lock.start_read();
+                if (!root_lock.end_read(root_lease)) {
+                    cur = nullptr;
+                    continue;
+                }
+                res = end();
+            }
+
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search.lower_bound(k, a, b, comp);
+            auto idx = static_cast<field_index_type>(pos - a);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(idx));
+            }
+
+            if (!cur->inner) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                hints.last_lower_bound_end.access(cur);
+                return (pos != b) ? iterator(cur, idx) : res;
             }
 
-            // continue search in child node
-            cur = cur->getChild(pos - a);
-        }
-    }
+            if (isSet && pos != b && equal(*pos, k)) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                return iterator(cur, idx);
+            }
 
-    /**
-     * Obtains a lower boundary for the given key -- hence an iterator referencing
-     * the smallest value that is not less the given key. If there is no such element,
-     * an end-iterator will be returned.
-     */
-    iterator lower_bound(const Key& k) const {
-        operation_hints hints;
-        return lower_bound(k, hints);
-    }
+            if (pos != b) {
+                res = iterator(cur, idx);
+            }
 
-    /**
-     * Obtains a lower boundary for the given key -- hence an iterator referencing
-     * the smallest value that is not less the given key. If there is no such element,
-     * an end-iterator will be returned.
-     */
-    iterator lower_bound(const Key& k, operation_hints& hints) const {
+            auto next = cur->getChild(idx);
+            auto next_lease = next->lock.start_read();
+            if (!cur->lock.end_read(cur_lease)) {
+                // start over
+                cur = nullptr;
+                continue;
+            }
+            cur = next;
+            cur_lease = next_lease;
+        }
+#else
         if (empty()) {
             return end();
         }
@@ -1841,8 +2893,14 @@ public:
         };
 
         // test last searched node
-        if (hints.last_lower_bound_end.any(checkHints)) {
-            hint_stats.lower_bound.addHit();
+        if (hints.lower_bound_gate.shouldProbe()) {
+            if (hints.last_lower_bound_end.any(checkHints)) {
+                hints.lower_bound_gate.registerOutcome(true);
+                hint_stats.lower_bound.addHit();
+            } else {
+                hints.lower_bound_gate.registerOutcome(false);
+                hint_stats.lower_bound.addMiss();
+            }
         } else {
             hint_stats.lower_bound.addMiss();
         }
@@ -1855,6 +2913,11 @@ public:
             auto pos = search.lower_bound(k, a, b, comp);
             auto idx = static_cast<field_index_type>(pos - a);
 
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(idx));
+            }
+
             if (!cur->inner) {
                 hints.last_lower_bound_end.access(cur);
                 return (pos != b) ? iterator(cur, idx) : res;
@@ -1870,6 +2933,7 @@ public:
 
             cur = cur->getChild(idx);
         }
+#endif
     }
 
     /**
@@ -1888,6 +2952,87 @@ public:
      * there is no such element, an end-iterator will be returned.
      */
     iterator upper_bound(const Key& k, operation_hints& hints) const {
+#ifdef IS_PARALLEL
+        if (empty()) {
+            return end();
+        }
+
+        // optimistic descent, restarted on concurrent modification (see find)
+        node* cur = nullptr;
+        typename lock_type::Lease cur_lease;
+
+        auto checkHints = [&](node* last_upper_bound_end) {
+            if (!last_upper_bound_end) return false;
+            auto lease = last_upper_bound_end->lock.start_read();
+            if (!coversUpperBound(last_upper_bound_end, k)) return false;
+            if (!last_upper_bound_end->lock.validate(lease)) return false;
+            cur = last_upper_bound_end;
+            cur_lease = lease;
+            return true;
+        };
+
+        // test last search node
+        if (hints.upper_bound_gate.shouldProbe()) {
+            if (hints.last_upper_bound_end.any(checkHints)) {
+                hints.upper_bound_gate.registerOutcome(true);
+                hint_stats.upper_bound.addHit();
+            } else {
+                hints.upper_bound_gate.registerOutcome(false);
+                hint_stats.upper_bound.addMiss();
+            }
+        } else {
+            hint_stats.upper_bound.addMiss();
+        }
+
+        iterator res = end();
+        while (true) {
+            if (cur == nullptr) {
+                auto root_lease = root_lock.start_read();
+                cur = root;
+                cur_lease = cur->lock.start_read();
+                if (!root_lock.end_read(root_lease)) {
+                    cur = nullptr;
+                    continue;
+                }
+                res = end();
+            }
+
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search.upper_bound(k, a, b, comp);
+            auto idx = static_cast<field_index_type>(pos - a);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(idx));
+            }
+
+            if (!cur->inner) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                hints.last_upper_bound_end.access(cur);
+                return (pos != b) ? iterator(cur, idx) : res;
+            }
+
+            if (pos != b) {
+                res = iterator(cur, idx);
+            }
+
+            auto next = cur->getChild(idx);
+            auto next_lease = next->lock.start_read();
+            if (!cur->lock.end_read(cur_lease)) {
+                // start over
+                cur = nullptr;
+                continue;
+            }
+            cur = next;
+            cur_lease = next_lease;
+        }
+#else
         if (empty()) {
             return end();
         }
@@ -1902,8 +3047,14 @@ public:
         };
 
         // test last search node
-        if (hints.last_upper_bound_end.any(checkHints)) {
-            hint_stats.upper_bound.addHit();
+        if (hints.upper_bound_gate.shouldProbe()) {
+            if (hints.last_upper_bound_end.any(checkHints)) {
+                hints.upper_bound_gate.registerOutcome(true);
+                hint_stats.upper_bound.addHit();
+            } else {
+                hints.upper_bound_gate.registerOutcome(false);
+                hint_stats.upper_bound.addMiss();
+            }
         } else {
             hint_stats.upper_bound.addMiss();
         }
@@ -1916,6 +3067,11 @@ public:
             auto pos = search.upper_bound(k, a, b, comp);
             auto idx = static_cast<field_index_type>(pos - a);
 
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(idx));
+            }
+
             if (!cur->inner) {
                 hints.last_upper_bound_end.access(cur);
                 return (pos != b) ? iterator(cur, idx) : res;
@@ -1927,6 +3083,158 @@ public:
 
             cur = cur->getChild(idx);
         }
+#endif
+    }
+
+    /**
+     * Obtains an iterator referencing the largest element not exceeding the
+     * given key -- the reverse counterpart of upper_bound, enabling
+     * logarithmic endpoint lookups on sorted ranges. If no element is less
+     * than or equal to the key, an end-iterator will be returned.
+     */
+    iterator floor_bound(const Key& k) const {
+        operation_hints hints;
+        return floor_bound(k, hints);
+    }
+
+    iterator floor_bound(const Key& k, operation_hints& hints) const {
+#ifdef IS_PARALLEL
+        if (empty()) {
+            return end();
+        }
+
+        // optimistic descent, restarted on concurrent modification (see find)
+        node* cur = nullptr;
+        typename lock_type::Lease cur_lease;
+
+        iterator res = end();
+        while (true) {
+            if (cur == nullptr) {
+                auto root_lease = root_lock.start_read();
+                cur = root;
+                cur_lease = cur->lock.start_read();
+                if (!root_lock.end_read(root_lease)) {
+                    cur = nullptr;
+                    continue;
+                }
+                res = end();
+            }
+
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search.upper_bound(k, a, b, comp);
+            auto idx = static_cast<field_index_type>(pos - a);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(idx));
+            }
+
+            if (!cur->inner) {
+                if (!cur->lock.validate(cur_lease)) {
+                    // start over
+                    cur = nullptr;
+                    continue;
+                }
+                return (idx > 0) ? iterator(cur, idx - 1) : res;
+            }
+
+            if (idx > 0) {
+                res = iterator(cur, idx - 1);
+            }
+
+            auto next = cur->getChild(idx);
+            auto next_lease = next->lock.start_read();
+            if (!cur->lock.end_read(cur_lease)) {
+                // start over
+                cur = nullptr;
+                continue;
+            }
+            cur = next;
+            cur_lease = next_lease;
+        }
+#else
+        if (empty()) {
+            return end();
+        }
+
+        node* cur = root;
+
+        // the last upper-bound hint pins down the floor as well whenever
+        // the predecessor of the upper-bound position lies within the same
+        // node; otherwise the search restarts from the root
+        auto checkHints = [&](node* last_upper_bound_end) {
+            if (!last_upper_bound_end) return false;
+            if (!coversUpperBound(last_upper_bound_end, k)) return false;
+            cur = last_upper_bound_end;
+            return true;
+        };
+        if (hints.upper_bound_gate.shouldProbe()) {
+            if (hints.last_upper_bound_end.any(checkHints)) {
+                auto a = &(cur->keys[0]);
+                auto b = &(cur->keys[cur->numElements]);
+                auto pos = search.upper_bound(k, a, b, comp);
+                auto idx = static_cast<field_index_type>(pos - a);
+                if (idx > 0) {
+                    hints.upper_bound_gate.registerOutcome(true);
+                    return iterator(cur, idx - 1);
+                }
+                // the floor precedes the hinted node
+                cur = root;
+            }
+            hints.upper_bound_gate.registerOutcome(false);
+        }
+
+        iterator res = end();
+        while (true) {
+            auto a = &(cur->keys[0]);
+            auto b = &(cur->keys[cur->numElements]);
+
+            auto pos = search.upper_bound(k, a, b, comp);
+            auto idx = static_cast<field_index_type>(pos - a);
+
+            // overlap fetching the next level with the remaining checks on this node
+            if (cur->inner) {
+                prefetcher.prefetch(cur->getChild(idx));
+            }
+
+            if (!cur->inner) {
+                hints.last_upper_bound_end.access(cur);
+                return (idx > 0) ? iterator(cur, idx - 1) : res;
+            }
+
+            if (idx > 0) {
+                res = iterator(cur, idx - 1);
+            }
+
+            cur = cur->getChild(idx);
+        }
+#endif
+    }
+
+    /**
+     * Counts the elements in the range [a,b) node-wise: the remainder of a
+     * leaf that lies entirely inside the range contributes its cardinality
+     * in a single step instead of one step per element, so the cost is
+     * proportional to the number of touched nodes rather than the number
+     * of counted elements.
+     */
+    size_type count_range(iterator a, const iterator& b) const {
+        size_type res = 0;
+        while (a != b) {
+            if (a.cur->isLeaf() && a.cur != b.cur) {
+                // consume the rest of this leaf at once; stepping onto its
+                // last element lets the increment climb out of the node
+                res += a.cur->getNumElements() - a.pos;
+                a.pos = static_cast<field_index_type>(a.cur->getNumElements() - 1);
+                ++a;
+                continue;
+            }
+            ++res;
+            ++a;
+        }
+        return res;
     }
 
     /**
@@ -1934,14 +3242,28 @@ public:
      */
     void clear() {
         if (root != nullptr) {
-            if (root->isLeaf()) {
-                delete static_cast<leaf_node*>(root);
+            if (allocation::wholesale_release) {
+                // all nodes are dropped with their backing chunks
+                mem.release();
             } else {
-                delete static_cast<inner_node*>(root);
+                freeNodes(root);
+            }
+        }
+        // nodes disconnected by erase operations are reclaimed here; under
+        // wholesale release they are covered by the chunk release above
+        if (!allocation::wholesale_release) {
+            for (node* n : detached) {
+                if (n->isInner()) {
+                    mem.destroy(&n->asInnerNode());
+                } else {
+                    mem.destroy(static_cast<leaf_node*>(n));
+                }
             }
         }
+        detached.clear();
         root = nullptr;
         leftmost = nullptr;
+        m_size.store(0, std::memory_order_relaxed);
     }
 
     /**
@@ -1953,6 +3275,11 @@ public:
         // swap the content
         std::swap(root, other.root);
         std::swap(leftmost, other.leftmost);
+        std::swap(mem, other.mem);
+        std::swap(detached, other.detached);
+        const auto tmp = m_size.load(std::memory_order_relaxed);
+        m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        other.m_size.store(tmp, std::memory_order_relaxed);
     }
 
     // Implementation of the assignment operation for trees.
@@ -1969,7 +3296,7 @@ public:
         }
 
         // clone content (deep copy)
-        root = other.root->clone();
+        root = other.root->clone(mem);
 
         // update leftmost reference
         auto tmp = root;
@@ -1978,6 +3305,8 @@ public:
         }
         leftmost = static_cast<leaf_node*>(tmp);
 
+        m_size.store(other.m_size.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
         // done
         return *this;
     }
@@ -2023,9 +3352,11 @@ public:
         return (empty()) ? 0 : root->countNodes();
     }
 
-    // Determines the amount of memory used by this data structure
+    // Determines the amount of memory used by this data structure.
+    // Obtained from the node allocation strategy in constant time, and thus
+    // safe to call while the tree is being updated concurrently.
     size_type getMemoryUsage() const {
-        return sizeof(*this) + (empty() ? 0 : root->getMemoryUsage());
+        return sizeof(*this) + mem.getMemoryUsage();
     }
 
     /*
@@ -2041,6 +3372,14 @@ public:
         }
     }
 
+    /**
+     * Provides access to the aggregated operation-hint statistics of
+     * this tree (all zero unless compiled with _SOUFFLE_STATS).
+     */
+    const hint_statistics& getHintStatistics() const {
+        return hint_stats;
+    }
+
     /**
      * Prints a textual summary of statistical properties of this
      * tree to the given output stream (for debugging and tuning).
@@ -2099,17 +3438,22 @@ public:
             return R();
         }
 
-        // resolve tree recursively
-        auto root = buildSubTree(a, b - 1);
+        // resolve tree recursively into a fresh instance, thereby drawing
+        // the nodes from the allocation strategy of the result
+        R res;
+        btree& tree = res;
+        tree.root = buildSubTree(a, b - 1, tree.mem);
 
         // find leftmost node
-        node* leftmost = root;
+        node* leftmost = tree.root;
         while (!leftmost->isLeaf()) {
             leftmost = leftmost->getChild(0);
         }
+        tree.leftmost = static_cast<leaf_node*>(leftmost);
+        tree.m_size.store(static_cast<size_type>(b - a), std::memory_order_relaxed);
 
-        // build result
-        return R(b - a, root, static_cast<leaf_node*>(leftmost));
+        // done
+        return res;
     }
 
 protected:
@@ -2151,9 +3495,125 @@ private:
         return !node->isEmpty() && !less(k, node->keys[0]) && less(k, node->keys[node->numElements - 1]);
     }
 
+    /**
+     * Recursively releases the given node and all its child nodes
+     * through the allocation strategy of this tree.
+     */
+    void freeNodes(node* n) {
+        if (n->isInner()) {
+            auto& inner = n->asInnerNode();
+            for (unsigned i = 0; i <= n->numElements; ++i) {
+                if (inner.children[i] != nullptr) {
+                    freeNodes(inner.children[i]);
+                }
+            }
+            mem.destroy(&inner);
+        } else {
+            mem.destroy(static_cast<leaf_node*>(n));
+        }
+    }
+
+    /**
+     * Disconnects the given node from the tree. The memory is kept alive
+     * until clear() so that operation hints recorded elsewhere may still
+     * be validated against it; detached nodes are always empty and are
+     * hence rejected by all hint checks.
+     */
+    void detachNode(node* n) {
+        detached.push_back(n);
+    }
+
+    /**
+     * Removes the element at the given position within the given node.
+     * Inner positions are refilled with their immediate predecessor or
+     * successor; a position whose neighbouring subtrees are both exhausted
+     * is dropped together with one of the empty leaves framing it. No
+     * rebalancing is conducted, thus leaves may end up empty.
+     */
+    void eraseAt(node* cur, field_index_type pos) {
+        while (cur->inner) {
+            // predecessor: the last element of the deepest non-empty node
+            // on the right spine of the left subtree
+            node* sub = cur->getChild(pos);
+            node* source = nullptr;
+            while (true) {
+                if (sub->numElements > 0) {
+                    source = sub;
+                }
+                if (!sub->inner) {
+                    break;
+                }
+                sub = sub->getChild(static_cast<field_index_type>(sub->numElements));
+            }
+            if (source != nullptr) {
+                auto last = static_cast<field_index_type>(source->numElements - 1);
+                cur->keys[pos] = source->keys[last];
+                cur = source;
+                pos = last;
+                continue;
+            }
+
+            // successor: the first element of the deepest non-empty node
+            // on the left spine of the right subtree
+            sub = cur->getChild(pos + 1);
+            while (true) {
+                if (sub->numElements > 0) {
+                    source = sub;
+                }
+                if (!sub->inner) {
+                    break;
+                }
+                sub = sub->getChild(0);
+            }
+            if (source != nullptr) {
+                cur->keys[pos] = source->keys[0];
+                cur = source;
+                pos = 0;
+                continue;
+            }
+
+            // both subtrees are exhausted empty leaves: drop the element
+            // together with the right one of the two framing leaves
+            auto& inner = cur->asInnerNode();
+            detachNode(inner.children[pos + 1]);
+            for (field_index_type i = pos; i < cur->numElements - 1; ++i) {
+                cur->keys[i] = cur->keys[i + 1];
+            }
+            for (field_index_type i = pos + 1; i < cur->numElements; ++i) {
+                inner.children[i] = inner.children[i + 1];
+                inner.children[i]->position = i;
+            }
+            --cur->numElements;
+
+            // an inner node that ran out of elements is spliced out by
+            // connecting its single remaining child to its parent
+            if (cur->numElements == 0) {
+                node* child = inner.children[0];
+                if (cur == root) {
+                    child->parent = nullptr;
+                    child->position = 0;
+                    root = child;
+                } else {
+                    auto* parent = cur->getParent();
+                    parent->getChildren()[cur->position] = child;
+                    child->parent = parent;
+                    child->position = cur->position;
+                }
+                detachNode(cur);
+            }
+            return;
+        }
+
+        // remove the element from a leaf by shifting its successors
+        for (field_index_type i = pos; i < cur->numElements - 1; ++i) {
+            cur->keys[i] = cur->keys[i + 1];
+        }
+        --cur->numElements;
+    }
+
     // Utility function for the load operation above.
     template <typename Iter>
-    static node* buildSubTree(const Iter& a, const Iter& b) {
+    static node* buildSubTree(const Iter& a, const Iter& b, allocation& mem) {
         const int N = node::maxKeys;
 
         // divide range in N+1 sub-ranges
@@ -2162,7 +3622,7 @@ private:
         // terminal case: length is less then maxKeys
         if (length <= N) {
             // create a leaf node
-            node* res = new leaf_node();
+            node* res = mem.template create<leaf_node>();
             res->numElements = length;
 
             for (int i = 0; i < length; ++i) {
@@ -2182,7 +3642,7 @@ private:
         }
 
         // create inner node
-        node* res = new inner_node();
+        node* res = mem.template create<inner_node>();
         res->numElements = numKeys;
 
         Iter c = a;
@@ -2191,7 +3651,7 @@ private:
             res->keys[i] = c[step];
 
             // get sub-tree
-            auto child = buildSubTree(c, c + (step - 1));
+            auto child = buildSubTree(c, c + (step - 1), mem);
             child->parent = res;
             child->position = i;
             res->getChildren()[i] = child;
@@ -2200,7 +3660,7 @@ private:
         }
 
         // and the remaining part
-        auto child = buildSubTree(c, b);
+        auto child = buildSubTree(c, b, mem);
         child->parent = res;
         child->position = numKeys;
         res->getChildren()[numKeys] = child;
@@ -2212,9 +3672,14 @@ private:
 
 // Instantiation of static member search.
 template <typename Key, typename Comparator, typename Allocator, unsigned blockSize, typename SearchStrategy,
-        bool isSet, typename WeakComparator, typename Updater>
-const SearchStrategy
-        btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator, Updater>::search;
+        bool isSet, typename WeakComparator, typename Updater, typename PrefetchStrategy>
+const SearchStrategy btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator,
+        Updater, PrefetchStrategy>::search;
+
+template <typename Key, typename Comparator, typename Allocator, unsigned blockSize, typename SearchStrategy,
+        bool isSet, typename WeakComparator, typename Updater, typename PrefetchStrategy>
+const PrefetchStrategy btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator,
+        Updater, PrefetchStrategy>::prefetcher;
 
 }  // end namespace detail
 
@@ -2223,22 +3688,24 @@ const SearchStrategy
  *
  * @tparam Key             .. the element type to be stored in this set
  * @tparam Comparator     .. a class defining an order on the stored elements
- * @tparam Allocator     .. utilized for allocating memory for required nodes
+ * @tparam Allocator     .. the strategy utilized for allocating memory for required nodes;
+ *                          either a standard allocator or a node allocation strategy
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
+ * @tparam PrefetchStrategy .. controls prefetching of the next level during tree descent
  */
 template <typename Key, typename Comparator = detail::comparator<Key>,
-        typename Allocator = std::allocator<Key>,  // is ignored so far
-        unsigned blockSize = 256,
+        typename Allocator = std::allocator<Key>, unsigned blockSize = 256,
         typename SearchStrategy = typename souffle::detail::default_strategy<Key>::type,
-        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>>
+        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>,
+        typename PrefetchStrategy = souffle::detail::default_prefetch>
 class btree_set : public souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-                          WeakComparator, Updater> {
+                          WeakComparator, Updater, PrefetchStrategy> {
     using super = souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, PrefetchStrategy>;
 
     friend class souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, true,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, PrefetchStrategy>;
 
 public:
     /**
@@ -2261,12 +3728,6 @@ public:
     // A move constructor.
     btree_set(btree_set&& other) : super(std::move(other)) {}
 
-private:
-    // A constructor required by the bulk-load facility.
-    template <typename s, typename n, typename l>
-    btree_set(s size, n* root, l* leftmost) : super(size, root, leftmost) {}
-
-public:
     // Support for the assignment operator.
     btree_set& operator=(const btree_set& other) {
         super::operator=(other);
@@ -2285,22 +3746,24 @@ public:
  *
  * @tparam Key             .. the element type to be stored in this set
  * @tparam Comparator     .. a class defining an order on the stored elements
- * @tparam Allocator     .. utilized for allocating memory for required nodes
+ * @tparam Allocator     .. the strategy utilized for allocating memory for required nodes;
+ *                          either a standard allocator or a node allocation strategy
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
+ * @tparam PrefetchStrategy .. controls prefetching of the next level during tree descent
  */
 template <typename Key, typename Comparator = detail::comparator<Key>,
-        typename Allocator = std::allocator<Key>,  // is ignored so far
-        unsigned blockSize = 256,
+        typename Allocator = std::allocator<Key>, unsigned blockSize = 256,
         typename SearchStrategy = typename souffle::detail::default_strategy<Key>::type,
-        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>>
+        typename WeakComparator = Comparator, typename Updater = souffle::detail::updater<Key>,
+        typename PrefetchStrategy = souffle::detail::default_prefetch>
 class btree_multiset : public souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy,
-                               false, WeakComparator, Updater> {
+                               false, WeakComparator, Updater, PrefetchStrategy> {
     using super = souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, false,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, PrefetchStrategy>;
 
     friend class souffle::detail::btree<Key, Comparator, Allocator, blockSize, SearchStrategy, false,
-            WeakComparator, Updater>;
+            WeakComparator, Updater, PrefetchStrategy>;
 
 public:
     /**
@@ -2323,12 +3786,6 @@ public:
     // A move constructor.
     btree_multiset(btree_multiset&& other) : super(std::move(other)) {}
 
-private:
-    // A constructor required by the bulk-load facility.
-    template <typename s, typename n, typename l>
-    btree_multiset(s size, n* root, l* leftmost) : super(size, root, leftmost) {}
-
-public:
     // Support for the assignment operator.
     btree_multiset& operator=(const btree_multiset& other) {
         super::operator=(other);
@@ -0,0 +1,151 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BTreeCommon.h
+ *
+ * Shared comparator template and precompiled instantiations for the
+ * btree types most commonly emitted by the synthesiser.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/BTree.h"
+#include "souffle/utility/StreamUtil.h"
+#include <cstddef>
+#include <memory>
+
+namespace souffle {
+
+/**
+ * Lexicographic comparator over the given column order, comparing every
+ * attribute as RamSigned. It is behaviourally identical to the comparator
+ * structs the synthesiser emits for indices whose attributes are all
+ * signed; by aliasing those to this template, equal (arity, index order)
+ * combinations denote the same btree specialisation in every generated
+ * program, so the precompiled instantiations below can serve them all.
+ */
+template <typename Tuple, std::size_t... Columns>
+struct signed_tuple_comparator;
+
+template <typename Tuple>
+struct signed_tuple_comparator<Tuple> {
+    int operator()(const Tuple&, const Tuple&) const {
+        return 0;
+    }
+    bool less(const Tuple&, const Tuple&) const {
+        return false;
+    }
+    bool equal(const Tuple&, const Tuple&) const {
+        return true;
+    }
+};
+
+template <typename Tuple, std::size_t First, std::size_t... Rest>
+struct signed_tuple_comparator<Tuple, First, Rest...> {
+    int operator()(const Tuple& a, const Tuple& b) const {
+        if (ramBitCast<RamSigned>(a[First]) < ramBitCast<RamSigned>(b[First])) {
+            return -1;
+        }
+        if (ramBitCast<RamSigned>(b[First]) < ramBitCast<RamSigned>(a[First])) {
+            return 1;
+        }
+        return signed_tuple_comparator<Tuple, Rest...>()(a, b);
+    }
+    bool less(const Tuple& a, const Tuple& b) const {
+        if (ramBitCast<RamSigned>(a[First]) < ramBitCast<RamSigned>(b[First])) {
+            return true;
+        }
+        if (ramBitCast<RamSigned>(b[First]) < ramBitCast<RamSigned>(a[First])) {
+            return false;
+        }
+        return signed_tuple_comparator<Tuple, Rest...>().less(a, b);
+    }
+    bool equal(const Tuple& a, const Tuple& b) const {
+        return ramBitCast<RamSigned>(a[First]) == ramBitCast<RamSigned>(b[First]) &&
+               signed_tuple_comparator<Tuple, Rest...>().equal(a, b);
+    }
+};
+
+}  // namespace souffle
+
+/**
+ * The (arity, index order) combinations below cover the btree
+ * specialisations that recur in virtually every compiled program. They are
+ * built once into libsouffle-common-btree at Soufflé build time; generated
+ * code compiled with SOUFFLE_USE_COMMON_BTREE declares them extern and the
+ * linker resolves them from the library, so a per-program compile only
+ * instantiates genuinely novel types.
+ *
+ * X(IsSet, Wrapper, Arity, Columns...)
+ */
+#define SOUFFLE_COMMON_BTREE_LIST(X)        \
+    X(true, btree_set, 2, 0, 1)             \
+    X(true, btree_set, 2, 1, 0)             \
+    X(true, btree_set, 3, 0, 1, 2)          \
+    X(true, btree_set, 3, 0, 2, 1)          \
+    X(true, btree_set, 3, 1, 0, 2)          \
+    X(true, btree_set, 3, 1, 2, 0)          \
+    X(true, btree_set, 3, 2, 0, 1)          \
+    X(true, btree_set, 3, 2, 1, 0)          \
+    X(true, btree_set, 4, 0, 1, 2, 3)       \
+    X(true, btree_set, 4, 1, 0, 2, 3)       \
+    X(true, btree_set, 4, 3, 0, 1, 2)       \
+    X(false, btree_multiset, 2, 0)          \
+    X(false, btree_multiset, 2, 1)          \
+    X(false, btree_multiset, 3, 0)          \
+    X(false, btree_multiset, 3, 1)          \
+    X(false, btree_multiset, 3, 2)          \
+    X(false, btree_multiset, 3, 0, 1)       \
+    X(false, btree_multiset, 3, 1, 0)       \
+    X(false, btree_multiset, 4, 0)          \
+    X(false, btree_multiset, 4, 0, 1)       \
+    X(false, btree_multiset, 4, 0, 1, 2)
+
+#if defined(SOUFFLE_USE_COMMON_BTREE) || defined(SOUFFLE_INSTANTIATE_COMMON_BTREE)
+
+// the instantiating translation unit emits definitions, everyone else
+// declarations only
+#ifdef SOUFFLE_INSTANTIATE_COMMON_BTREE
+#define SOUFFLE_COMMON_BTREE_EXTERN
+#else
+#define SOUFFLE_COMMON_BTREE_EXTERN extern
+#endif
+
+#define SOUFFLE_COMMON_BTREE_KEY(Arity) souffle::Tuple<souffle::RamDomain, Arity>
+#define SOUFFLE_COMMON_BTREE_CMP(Arity, ...) \
+    souffle::signed_tuple_comparator<SOUFFLE_COMMON_BTREE_KEY(Arity), __VA_ARGS__>
+
+#define SOUFFLE_COMMON_BTREE_ENTRY(IsSet, Wrapper, Arity, ...)                                      \
+    SOUFFLE_COMMON_BTREE_EXTERN template class souffle::detail::btree<SOUFFLE_COMMON_BTREE_KEY(     \
+                                                                              Arity),              \
+            SOUFFLE_COMMON_BTREE_CMP(Arity, __VA_ARGS__),                                           \
+            std::allocator<SOUFFLE_COMMON_BTREE_KEY(Arity)>, 256,                                   \
+            souffle::detail::default_strategy<SOUFFLE_COMMON_BTREE_KEY(Arity)>::type, IsSet,        \
+            SOUFFLE_COMMON_BTREE_CMP(Arity, __VA_ARGS__),                                           \
+            souffle::detail::updater<SOUFFLE_COMMON_BTREE_KEY(Arity)>,                              \
+            souffle::detail::default_prefetch>;                                                     \
+    SOUFFLE_COMMON_BTREE_EXTERN template class souffle::Wrapper<SOUFFLE_COMMON_BTREE_KEY(Arity),    \
+            SOUFFLE_COMMON_BTREE_CMP(Arity, __VA_ARGS__),                                           \
+            std::allocator<SOUFFLE_COMMON_BTREE_KEY(Arity)>, 256,                                   \
+            souffle::detail::default_strategy<SOUFFLE_COMMON_BTREE_KEY(Arity)>::type,               \
+            SOUFFLE_COMMON_BTREE_CMP(Arity, __VA_ARGS__),                                           \
+            souffle::detail::updater<SOUFFLE_COMMON_BTREE_KEY(Arity)>,                              \
+            souffle::detail::default_prefetch>;
+
+SOUFFLE_COMMON_BTREE_LIST(SOUFFLE_COMMON_BTREE_ENTRY)
+
+#undef SOUFFLE_COMMON_BTREE_ENTRY
+#undef SOUFFLE_COMMON_BTREE_CMP
+#undef SOUFFLE_COMMON_BTREE_KEY
+#undef SOUFFLE_COMMON_BTREE_EXTERN
+
+#endif
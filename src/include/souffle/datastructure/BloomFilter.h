@@ -0,0 +1,169 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BloomFilter.h
+ *
+ * A Bloom filter approximating the set of inserted keys, allowing
+ * membership probes to fail fast before an expensive index lookup.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace souffle {
+
+/**
+ * A Bloom filter over 64-bit key hashes. A negative probe proves that the
+ * key was never inserted, while a positive probe merely indicates likely
+ * membership and must be confirmed against the authoritative structure.
+ *
+ * The filter is sized adaptively: once the active bit segment holds more
+ * keys than it has been provisioned for, a segment of twice the size is
+ * started and earlier segments are retained for probing. Since segments
+ * grow geometrically, the false-positive rate is dominated by the segment
+ * holding the majority of the keys.
+ *
+ * Insertions and probes are lock-free; individual bits are published with
+ * relaxed ordering, relying on the synchronization of the owning data
+ * structure to order insertions before dependent probes.
+ */
+class BloomFilter {
+    /** A fixed-size segment of filter bits, linked to its predecessor. */
+    struct Segment {
+        Segment(std::size_t numBits, Segment* prev)
+                : words(std::make_unique<std::atomic<uint64_t>[]>(numBits / WORD_BITS)), numBits(numBits),
+                  prev(prev) {}
+
+        std::unique_ptr<std::atomic<uint64_t>[]> words;
+
+        // the number of bits of this segment, always a power of two
+        std::size_t numBits;
+
+        // the number of keys inserted into this segment
+        std::atomic<std::size_t> count{0};
+
+        // the saturated predecessor of this segment
+        Segment* prev;
+    };
+
+    // the number of bits per storage word
+    static constexpr std::size_t WORD_BITS = 64;
+
+    // the number of bits of the initial segment
+    static constexpr std::size_t MIN_BITS = 1 << 12;
+
+    // the number of bits probed per key
+    static constexpr std::size_t NUM_PROBES = 4;
+
+    // the number of bits provisioned per key; once a segment holds more
+    // keys than this allows for, a larger segment is started
+    static constexpr std::size_t BITS_PER_KEY = 8;
+
+    // the active segment; saturated segments remain linked behind it
+    std::atomic<Segment*> head;
+
+public:
+    BloomFilter() : head(new Segment(MIN_BITS, nullptr)) {}
+
+    // filters maintain exclusive ownership of their segments
+    BloomFilter(const BloomFilter&) = delete;
+    BloomFilter& operator=(const BloomFilter&) = delete;
+
+    ~BloomFilter() {
+        freeSegments(head.load(std::memory_order_relaxed));
+    }
+
+    /** Registers the key with the given hash in this filter. */
+    void insert(std::size_t hash) {
+        Segment* cur = head.load(std::memory_order_acquire);
+        setBits(*cur, hash);
+
+        // once the active segment is saturated, try installing a larger
+        // one; losing the race to a concurrent insertion is fine since
+        // the winner installed an equally suitable segment
+        std::size_t keys = cur->count.fetch_add(1, std::memory_order_relaxed) + 1;
+        if (keys * BITS_PER_KEY > cur->numBits) {
+            auto* fresh = new Segment(cur->numBits * 2, cur);
+            if (!head.compare_exchange_strong(cur, fresh, std::memory_order_acq_rel)) {
+                delete fresh;
+            }
+        }
+    }
+
+    /**
+     * Tests whether the key with the given hash may have been inserted.
+     * False indicates that the key is definitely absent.
+     */
+    bool mayContain(std::size_t hash) const {
+        for (Segment* cur = head.load(std::memory_order_acquire); cur != nullptr; cur = cur->prev) {
+            if (testBits(*cur, hash)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Resets this filter to its empty state. Must not be run concurrently
+     * to any other operation.
+     */
+    void clear() {
+        freeSegments(head.exchange(new Segment(MIN_BITS, nullptr)));
+    }
+
+private:
+    /** Finalizes the given hash to spread weakly distributed input bits. */
+    static uint64_t mix(uint64_t x) {
+        x += 0x9e3779b97f4a7c15;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111eb;
+        return x ^ (x >> 31);
+    }
+
+    /** Sets the probed bits of the given key hash in the given segment. */
+    static void setBits(Segment& seg, std::size_t hash) {
+        const uint64_t h1 = mix(hash);
+        const uint64_t h2 = mix(hash ^ 0xc3a5c85c97cb3127) | 1;
+        for (std::size_t i = 0; i < NUM_PROBES; i++) {
+            std::size_t pos = (h1 + i * h2) & (seg.numBits - 1);
+            seg.words[pos / WORD_BITS].fetch_or(uint64_t(1) << (pos % WORD_BITS), std::memory_order_relaxed);
+        }
+    }
+
+    /** Tests the probed bits of the given key hash in the given segment. */
+    static bool testBits(const Segment& seg, std::size_t hash) {
+        const uint64_t h1 = mix(hash);
+        const uint64_t h2 = mix(hash ^ 0xc3a5c85c97cb3127) | 1;
+        for (std::size_t i = 0; i < NUM_PROBES; i++) {
+            std::size_t pos = (h1 + i * h2) & (seg.numBits - 1);
+            if ((seg.words[pos / WORD_BITS].load(std::memory_order_relaxed) &
+                        (uint64_t(1) << (pos % WORD_BITS))) == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Frees the given segment together with all its predecessors. */
+    static void freeSegments(Segment* cur) {
+        while (cur != nullptr) {
+            Segment* prev = cur->prev;
+            delete cur;
+            cur = prev;
+        }
+    }
+};
+
+}  // namespace souffle
@@ -27,9 +27,11 @@
 #pragma once
 
 #include "souffle/RamTypes.h"
+#include "souffle/datastructure/MemoryArena.h"
 #include "souffle/utility/CacheUtil.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/span.h"
 #include <algorithm>
@@ -59,7 +61,7 @@
 
 namespace souffle {
 
-template <unsigned Dim>
+template <unsigned Dim, unsigned BITS = 6>
 class Trie;
 
 namespace detail::brie {
@@ -385,12 +387,20 @@ private:
         // the absolute offset of the theoretical first element in the tree
         index_type offset;
 
-        // the first leaf node in the tree
-        Node* first;
+        // the first leaf node in the tree; separated onto its own cache
+        // line since it is updated whenever a leaf with a smaller offset
+        // is linked, and would otherwise invalidate the root snapshot
+        // taken by every concurrent insert
+        alignas(hardware_destructive_interference_size) Node* first;
         // the absolute offset of the first element in the first leaf node
         index_type firstOffset;
     };
 
+    // the arena providing the storage for all nodes of this array;
+    // declared ahead of the root information since node creation during
+    // construction depends on it
+    MemoryArena mem;
+
     union {
         RootInfo unsynced;         // for sequential operations
         volatile RootInfo synced;  // for synchronized operations
@@ -422,7 +432,8 @@ public:
      * handed in array.
      */
     SparseArray(SparseArray&& other)
-            : unsynced(RootInfo{other.unsynced.root, other.unsynced.levels, other.unsynced.offset,
+            : mem(std::move(other.mem)),
+              unsynced(RootInfo{other.unsynced.root, other.unsynced.levels, other.unsynced.offset,
                       other.unsynced.first, other.unsynced.firstOffset}) {
         other.unsynced.root = nullptr;
         other.unsynced.levels = 0;
@@ -470,7 +481,8 @@ public:
         // clean this one
         clean();
 
-        // harvest content
+        // harvest content, including the arena backing it
+        mem = std::move(other.mem);
         unsynced.root = other.unsynced.root;
         unsynced.levels = other.unsynced.levels;
         unsynced.offset = other.unsynced.offset;
@@ -510,43 +522,14 @@ public:
         return res;
     }
 
-private:
-    /**
-     * Computes the memory usage of the given sub-tree.
-     */
-    static std::size_t getMemoryUsage(const Node* node, int level) {
-        // support null-nodes
-        if (!node) return 0;
-
-        // add size of current node
-        std::size_t res = sizeof(Node);
-
-        // sum up memory usage of child nodes
-        if (level > 0) {
-            for (int i = 0; i < NUM_CELLS; i++) {
-                res += getMemoryUsage(node->cell[i].ptr, level - 1);
-            }
-        }
-
-        // done
-        return res;
-    }
-
 public:
     /**
-     * Computes the total memory usage of this data structure.
+     * Computes the total memory usage of this data structure. Obtained
+     * from the backing arena in constant time (per chunk), and thus safe
+     * to call while the array is being updated concurrently.
      */
     std::size_t getMemoryUsage() const {
-        // the memory of the wrapper class
-        std::size_t res = sizeof(*this);
-
-        // add nodes
-        if (unsynced.root) {
-            res += getMemoryUsage(unsynced.root, unsynced.levels);
-        }
-
-        // done
-        return res;
+        return sizeof(*this) + mem.getMemoryUsage();
     }
 
     /**
@@ -564,10 +547,22 @@ public:
     /**
      * A struct to be utilized as a local, temporal context by client code
      * to speed up the execution of various operations (optional parameter).
+     *
+     * Beyond the last-node hint, the context carries a pool of node storage
+     * pre-reserved from the arena, such that concurrently inserting threads
+     * draw nodes in batches instead of contending on the arena's bump
+     * counter for every node. A context is bound to the array it is used
+     * with and must not be retained across a clear of that array.
      */
     struct op_context {
         index_type lastIndex{0};
         Node* lastNode{nullptr};
+        // the pool of pre-reserved node storage and its remaining capacity
+        char* nodePool{nullptr};
+        uint16_t nodePoolLeft{0};
+        // the size of the next pool refill; doubles up to a fixed bound so
+        // that single-shot contexts reserve no more than they consume
+        uint16_t nodePoolBatch{1};
         op_context() = default;
     };
 
@@ -785,7 +780,7 @@ private:
         // check for emptiness
         if (info.root == nullptr) {
             // build new root node
-            info.root = newNode();
+            info.root = newNode(ctxt);
 
             // initialize the new node
             info.root->parent = nullptr;
@@ -811,7 +806,7 @@ private:
             }
 
             // somebody else was faster => use standard insertion procedure
-            delete info.root;
+            freeNode(info.root, ctxt);
 
             // retrieve new root info
             info = getRootInfo();
@@ -828,7 +823,7 @@ private:
         // check boundaries
         while (!inBoundaries(i, info.levels, info.offset)) {
             // boundaries need to be expanded by growing upwards
-            raiseLevel(info);  // try raising level unless someone else did already
+            raiseLevel(info, ctxt);  // try raising level unless someone else did already
             // update root info
             info = getRootInfo();
         }
@@ -848,13 +843,13 @@ private:
             Node* next = aNext;
             if (!next) {
                 // create new sub-tree
-                Node* newNext = newNode();
+                Node* newNext = newNode(ctxt);
                 newNext->parent = node;
 
                 // try to update next
                 if (!aNext.compare_exchange_strong(next, newNext)) {
                     // some other thread was faster => use updated next
-                    delete newNext;
+                    freeNode(newNext, ctxt);
                 } else {
                     // the locally created next is the new next
                     next = newNext;
@@ -980,14 +975,14 @@ public:
 
 private:
     /**
-     * A static operation utilized internally for merging sub-trees recursively.
+     * An operation utilized internally for merging sub-trees recursively.
      *
      * @param parent the parent node of the current merge operation
      * @param trg a reference to the pointer the cloned node should be stored to
      * @param src the node to be cloned
      * @param levels the height of the cloned node
      */
-    static void merge(const Node* parent, Node*& trg, const Node* src, int levels) {
+    void merge(const Node* parent, Node*& trg, const Node* src, int levels) {
         // if other side is null => done
         if (src == nullptr) {
             return;
@@ -1310,31 +1305,59 @@ private:
     //                                 Utilities
     // --------------------------------------------------------------------------
 
+    // the upper bound for the per-context node pool refill (see newNode)
+    static constexpr uint16_t MAX_NODE_POOL_BATCH = 8;
+
     /**
-     * Creates new nodes and initializes them with 0.
+     * Creates new nodes and initializes them with 0. The nodes are drawn
+     * from the arena of this array and are released wholesale by clean().
      */
-    static Node* newNode() {
-        return new Node();
+    Node* newNode() {
+        return new (mem.allocate(sizeof(Node))) Node();
     }
 
     /**
-     * Destroys a node and all its sub-nodes recursively.
+     * Creates a new node drawing from the pool of the given context. The
+     * pool is refilled from the arena in growing batches, such that threads
+     * inserting through a persistent context reserve node storage in bulk
+     * and link the resulting nodes into the tree without touching shared
+     * state; unconsumed slots remain reserved until the context is dropped.
      */
-    static void freeNodes(Node* node, int level) {
-        if (!node) return;
-        if (level != 0) {
-            for (int i = 0; i < NUM_CELLS; i++) {
-                freeNodes(node->cell[i].ptr, level - 1);
-            }
+    Node* newNode(op_context& ctxt) {
+        if (ctxt.nodePoolLeft == 0) {
+            ctxt.nodePool = static_cast<char*>(mem.allocate(sizeof(Node) * ctxt.nodePoolBatch));
+            ctxt.nodePoolLeft = ctxt.nodePoolBatch;
+            ctxt.nodePoolBatch = std::min<uint16_t>(ctxt.nodePoolBatch * 2, MAX_NODE_POOL_BATCH);
+        }
+        auto* res = new (ctxt.nodePool) Node();
+        ctxt.nodePool += sizeof(Node);
+        --ctxt.nodePoolLeft;
+        return res;
+    }
+
+    /**
+     * Abandons a node; its storage remains within the arena until the
+     * next cleanup of this array.
+     */
+    static void freeNode(Node* /* node */) {}
+
+    /**
+     * Abandons a node that lost a linkage race; the storage of the most
+     * recent draw is handed back to the pool of the given context.
+     */
+    static void freeNode(Node* node, op_context& ctxt) {
+        if (reinterpret_cast<char*>(node) + sizeof(Node) == ctxt.nodePool) {
+            ctxt.nodePool -= sizeof(Node);
+            ++ctxt.nodePoolLeft;
         }
-        delete node;
     }
 
     /**
-     * Conducts a cleanup of the internal tree structure.
+     * Conducts a cleanup of the internal tree structure by releasing all
+     * nodes with their backing arena chunks.
      */
     void clean() {
-        freeNodes(unsynced.root, unsynced.levels);
+        mem.release();
         unsynced.root = nullptr;
         unsynced.levels = 0;
     }
@@ -1342,14 +1365,14 @@ private:
     /**
      * Clones the given node and all its sub-nodes.
      */
-    static Node* clone(const Node* node, int level) {
+    Node* clone(const Node* node, int level) {
         // support null-pointers
         if (node == nullptr) {
             return nullptr;
         }
 
         // create a clone
-        auto* res = new Node();
+        auto* res = newNode();
 
         // handle leaf level
         if (level == 0) {
@@ -1426,12 +1449,12 @@ private:
      * Attempts to raise the height of this tree based on the given root node
      * information and updates the root-info snapshot correspondingly.
      */
-    void raiseLevel(RootInfoSnapshot& info) {
+    void raiseLevel(RootInfoSnapshot& info, op_context& ctxt) {
         // something went wrong when we pass that line
         assert(info.levels < (sizeof(index_type) * 8 / BITS) + 1);
 
         // create new root
-        Node* newRoot = newNode();
+        Node* newRoot = newNode(ctxt);
         newRoot->parent = nullptr;
 
         // insert existing root as child
@@ -1454,7 +1477,7 @@ private:
             oldRoot->parent = info.root;
         } else {
             // throw away temporary new node
-            delete newRoot;
+            freeNode(newRoot, ctxt);
         }
     }
 
@@ -2001,7 +2024,7 @@ public:
     }
 };
 
-template <unsigned Dim>
+template <unsigned Dim, unsigned BITS = 6>
 struct TrieTypes;
 
 /**
@@ -2009,9 +2032,11 @@ struct TrieTypes;
  * specializations of the Trie template to inherit common functionality.
  *
  * @tparam Dim the number of dimensions / arity of the stored tuples
+ * @tparam BITS the number of bits resolved per level of the sparse arrays
+ *              indexing the individual dimensions
  * @tparam Derived the type derived from this base class
  */
-template <unsigned Dim, typename Derived>
+template <unsigned Dim, unsigned BITS, typename Derived>
 class TrieBase {
     Derived& impl() {
         return static_cast<Derived&>(*this);
@@ -2022,7 +2047,7 @@ class TrieBase {
     }
 
 protected:
-    using types = TrieTypes<Dim>;
+    using types = TrieTypes<Dim, BITS>;
     using store_type = typename types::store_type;
 
     store_type store;
@@ -2164,7 +2189,7 @@ public:
     }
 };
 
-template <unsigned Dim>
+template <unsigned Dim, unsigned BITS>
 struct TrieTypes;
 
 // FIXME: THIS KILLS COMPILE PERF - O(n^2)
@@ -2440,14 +2465,14 @@ struct fix_upper_bound {
     }
 };
 
-template <unsigned Dim>
+template <unsigned Dim, unsigned BITS>
 struct TrieTypes {
     using entry_type = std::array<brie_element_type, Dim>;
     using entry_span_type = span<brie_element_type, Dim>;
     using const_entry_span_type = span<const brie_element_type, Dim>;
 
     // the type of the nested tries (1 dimension less)
-    using nested_trie_type = Trie<Dim - 1>;
+    using nested_trie_type = Trie<Dim - 1, BITS>;
 
     // the merge operation capable of merging two nested tries
     struct nested_trie_merger {
@@ -2469,7 +2494,7 @@ struct TrieTypes {
 
     // the data structure utilized for indexing nested tries
     using store_type = SparseArray<nested_trie_type*,
-            6,  // = 2^6 entries per block
+            BITS,  // = 2^BITS entries per block
             nested_trie_merger, nested_trie_cloner>;
 
     // The iterator core for trie iterators involving this level.
@@ -2559,15 +2584,15 @@ struct TrieTypes {
     };
 };
 
-template <>
-struct TrieTypes<1u> {
+template <unsigned BITS>
+struct TrieTypes<1u, BITS> {
     using entry_type = std::array<brie_element_type, 1>;
     using entry_span_type = span<brie_element_type, 1>;
     using const_entry_span_type = span<const brie_element_type, 1>;
 
     // the map type utilized internally
     using store_type = SparseBitMap<>;
-    using op_context = store_type::op_context;
+    using op_context = typename store_type::op_context;
 
     /**
      * The iterator core of this level contributing to the construction of
@@ -2634,14 +2659,21 @@ struct TrieTypes<1u> {
 
 // use an inner class so `TrieN` is fully defined before the recursion, allowing us to use
 // `op_context` in `TrieBase`
-template <unsigned Dim>
-class Trie : public TrieBase<Dim, Trie<Dim>> {
-    template <unsigned N>
+/**
+ * @tparam Dim the number of dimensions / arity of the stored tuples
+ * @tparam BITS the number of bits resolved per level of the sparse arrays
+ *              indexing the individual dimensions; smaller values reduce the
+ *              node fan-out (2^BITS child pointers) and thereby the memory
+ *              footprint on sparse domains, at the price of deeper trees
+ */
+template <unsigned Dim, unsigned BITS>
+class Trie : public TrieBase<Dim, BITS, Trie<Dim, BITS>> {
+    template <unsigned N, unsigned B>
     friend class Trie;
 
     // a shortcut for the common base class type
-    using base = TrieBase<Dim, Trie<Dim>>;
-    using types = TrieTypes<Dim>;
+    using base = TrieBase<Dim, BITS, Trie<Dim, BITS>>;
+    using types = TrieTypes<Dim, BITS>;
     using nested_trie_type = typename types::nested_trie_type;
     using store_type = typename types::store_type;
 
@@ -2690,8 +2722,13 @@ public:
     std::size_t getMemoryUsage() const {
         // compute the total memory usage of this level
         auto res = sizeof(*this) - sizeof(store) + store.getMemoryUsage();
-        for (auto&& [_, v] : store)
-            res += v->getMemoryUsage();  // add the memory usage of sub-levels
+        for (auto&& [_, v] : store) {
+            // sub-tries may not be fully published yet when sampled
+            // concurrently with insertions
+            if (v != nullptr) {
+                res += v->getMemoryUsage();  // add the memory usage of sub-levels
+            }
+        }
 
         return res;
     }
@@ -2911,10 +2948,10 @@ public:
  * of all tries exhibiting an arity >= 1. Internally, values are stored utilizing
  * sparse bit maps.
  */
-template <>
-class Trie<1u> : public TrieBase<1u, Trie<1u>> {
-    using base = TrieBase<1u, Trie<1u>>;
-    using types = TrieTypes<1u>;
+template <unsigned BITS>
+class Trie<1u, BITS> : public TrieBase<1u, BITS, Trie<1u, BITS>> {
+    using base = TrieBase<1u, BITS, Trie<1u, BITS>>;
+    using types = TrieTypes<1u, BITS>;
     using store_type = typename types::store_type;
 
     using base::store;
@@ -8,24 +8,36 @@
 #pragma once
 
 #include "ConcurrentInsertOnlyHashMap.h"
+#include "souffle/utility/MemoryUtil.h"
 #include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace souffle {
 
 /**
  * A concurrent, almost lock-free associative datastructure that implements the
  * Flyweight pattern.  Assigns a unique index to each inserted key. Elements
- * cannot be removed, the datastructure can only grow.
+ * cannot be removed concurrently; a `sweep` at a point of quiescence releases
+ * dead elements and recycles their slots, otherwise the datastructure only
+ * grows.
  *
  * The datastructure enables a configurable number of concurrent access lanes.
  * Access to the datastructure is lock-free between different lanes.
  * Concurrent accesses through the same lane is sequential.
  *
- * Growing the datastructure requires to temporarily lock all lanes to let a
- * single lane perform the growing operation. The global lock is amortized
- * thanks to an exponential growth strategy.
+ * The index-to-value mapping is stored in power-of-two segments, in the style
+ * of `PiggyList`. Growing allocates a fresh segment and publishes its pointer;
+ * existing slots are never moved or freed before destruction, so `fetch`
+ * resolves an index with two dependent loads and readers never block on
+ * growth. The key-to-index shard maps grow per shard under their own locks.
  *
  */
 template <class LanesPolicy, class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
@@ -136,13 +148,11 @@ public:
         }
 
         reference operator*() const {
-            const auto Guard = This->Lanes.guard(Lane);
-            return *This->Slots[index(Slot)];
+            return *This->getSlot(Slot);
         }
 
         pointer operator->() const {
-            const auto Guard = This->Lanes.guard(Lane);
-            return This->Slots[index(Slot)];
+            return This->getSlot(Slot);
         }
 
         Iterator& operator++() {
@@ -194,7 +204,10 @@ public:
                 assert(Slot + 1 < SLOT_MAX);
                 if (Slot + 1 < NextMaybeUnassignedSlot) {  // next unassigned slot not reached
                     Slot = Slot + 1;
-                    return true;
+                    if (This->getSlot(Slot) != nullptr) {  // swept slots are skipped
+                        return true;
+                    }
+                    continue;
                 }
 
                 if (NextMaybeUnassignedHandle == NONE) {  // reaching end
@@ -210,7 +223,7 @@ public:
                     This->Lanes.unlock(NextMaybeUnassignedHandle);
                     Slot = Slot + 1;
                     FindNextMaybeUnassignedSlot();
-                    if (IsAssigned) {
+                    if (IsAssigned && This->getSlot(Slot) != nullptr) {
                         return true;
                     }
                 }
@@ -225,12 +238,22 @@ public:
     ConcurrentFlyweight(const std::size_t LaneCount, const std::size_t InitialCapacity,
             const bool ReserveFirst, const Hash& hash = Hash(), const KeyEqual& key_equal = KeyEqual(),
             const KeyFactory& key_factory = KeyFactory())
-            : Lanes(LaneCount), HandleCount(LaneCount),
-              Mapping(LaneCount, InitialCapacity, hash, key_equal, key_factory) {
-        Slots = std::make_unique<const value_type*[]>(InitialCapacity);
+            : Lanes(LaneCount), HandleCount(LaneCount), Hasher(hash) {
+        // the key-to-index mapping is sharded by hash prefix so that inserts
+        // contend and the map grows per shard rather than globally
+        Shards.reserve(ShardCount);
+        for (std::size_t I = 0; I < ShardCount; ++I) {
+            Shards.push_back(std::make_unique<map_type>(
+                    LaneCount, std::max<std::size_t>(8, InitialCapacity >> ShardBits), hash, key_equal,
+                    key_factory));
+        }
+        for (auto& Segment : Segments) {
+            Segment.store(nullptr, std::memory_order_relaxed);
+        }
+        reserveSlots(InitialCapacity);
         Handles = std::make_unique<Handle[]>(HandleCount);
-        NextSlot = (ReserveFirst ? 1 : 0);
-        MaxSlotBeforeGrow = InitialCapacity - 1;
+        FirstSlot = (ReserveFirst ? 1 : 0);
+        NextSlot = FirstSlot;
     }
 
     /// Initialize the datastructure with a capacity of 8 elements.
@@ -250,6 +273,9 @@ public:
                 delete Handles[I].NextNode;
             }
         }
+        for (auto& Segment : Segments) {
+            delete[] Segment.load(std::memory_order_relaxed);
+        }
     }
 
     /**
@@ -263,12 +289,33 @@ public:
             Handles.swap(NextHandles);
             HandleCount = NumLanes;
         }
-        Mapping.setNumLanes(NumLanes);
+        for (auto& Shard : Shards) {
+            Shard->setNumLanes(NumLanes);
+        }
         Lanes.setNumLanes(NumLanes);
     }
 
-    /** Return a concurrent iterator on the first element. */
+    /**
+     * Ensure capacity for the given number of keys, so that neither the slot
+     * index nor the shard tables need to grow while filling up to that count.
+     * Do not use while threads are using this datastructure.
+     */
+    void reserve(const std::size_t NumKeys) {
+        reserveSlots(NumKeys);
+        // keys spread evenly over the shards by construction
+        for (auto& Shard : Shards) {
+            Shard->reserve(NumKeys / ShardCount + 1);
+        }
+    }
+
+    /** Return a concurrent iterator on the first element, skipping the
+     * reserved slot if the datastructure was built with `ReserveFirst`. */
     Iterator begin(const lane_id H) const {
+        if (FirstSlot > 0) {
+            // The iterator starting at index I yields elements from I+1 on;
+            // starting at index 0 therefore skips the reserved slot only.
+            return Iterator(this, H, 0);
+        }
         return Iterator(this, H);
     }
 
@@ -280,15 +327,55 @@ public:
     /// Return true if the value is in the map.
     template <typename K>
     bool weakContains(const lane_id H, const K& X) const {
-        return Mapping.weakContains(H, X);
+        const std::size_t HashValue = Hasher(X);
+        return shardOf(HashValue).weakContainsPrehashed(H, HashValue, X);
     }
 
     /// Return the value associated with the given index.
     /// Assumption: the index is mapped in the datastructure.
-    const Key& fetch(const lane_id H, const index_type Idx) const {
-        const auto Lane = Lanes.guard(H);
-        assert(Idx <= MaxSlotBeforeGrow);
-        return Slots[Idx]->first;
+    /// Lock-free: the slot entry was published before the index became
+    /// visible to any other lane through the shard maps.
+    const Key& fetch(const lane_id, const index_type Idx) const {
+        assert(Idx < NextSlot.load(std::memory_order_relaxed));
+        return getSlot(slot(Idx))->first;
+    }
+
+    /// Return the value associated with the given index, going through a
+    /// small per-thread direct-mapped cache. Reads massively dominate and
+    /// repeat over few indices - symbol decoding during output writing and
+    /// string functor evaluation being the extreme case - so a hit skips the
+    /// segment walk of `fetch` with no synchronisation beyond one read-mostly
+    /// generation counter, which `sweep` bumps to drop stale entries. The
+    /// returned reference points into the stable interned storage.
+    const Key& fetchCached(const index_type Idx) const {
+        static thread_local std::array<FetchCacheEntry, FetchCacheSize> Cache;
+        FetchCacheEntry& Entry = Cache[Idx & (FetchCacheSize - 1)];
+        const std::uint64_t Generation = SweepGeneration.load(std::memory_order_acquire);
+        if (Entry.Owner == InstanceId && Entry.Generation == Generation && Entry.Idx == Idx) {
+            return *Entry.Value;
+        }
+        const Key& Value = getSlot(slot(Idx))->first;
+        Entry = {InstanceId, Generation, Idx, &Value};
+        return Value;
+    }
+
+    /**
+     * Approximates the number of bytes used by this datastructure: the
+     * key/index pairs with their heap storage, the slot segments, and the
+     * per-node bookkeeping of the shard maps. Reads only atomic counters
+     * and published segment pointers, and is thus safe to call while other
+     * lanes are inserting.
+     */
+    std::size_t getMemoryUsage() const {
+        std::size_t Bytes = sizeof(*this) + HeapBytes.load(std::memory_order_relaxed);
+        // per-node link overhead in the shard maps
+        Bytes += NextSlot.load(std::memory_order_relaxed) * sizeof(void*);
+        for (std::size_t S = 0; S < SegmentCount; ++S) {
+            if (Segments[S].load(std::memory_order_acquire) != nullptr) {
+                Bytes += (SegmentSize << S) * sizeof(const value_type*);
+            }
+        }
+        return Bytes;
     }
 
     /// Return the pair of the index for the given value and a boolean
@@ -297,31 +384,36 @@ public:
     /// yet indexed.
     template <class... Args>
     std::pair<index_type, bool> findOrInsert(const lane_id H, Args&&... Xs) {
+        const std::size_t HashValue = Hasher(Xs...);
         const auto Lane = Lanes.guard(H);
         slot_type Slot = Handles[H].NextSlot;
         node_type Node;
 
         if (Slot == NONE) {
-            // reserve a slot in the index, be it for now or later usage.
-            Slot = NextSlot++;
-            Node = Mapping.node(static_cast<index_type>(Slot));
+            // reserve a slot in the index, preferring one released by a
+            // sweep over growing the index.
+            // nodes are shard-agnostic, any shard can mint one
+            Slot = claimFreeSlot();
+            if (Slot == NONE) {
+                Slot = NextSlot++;
+                ensureSegment(Slot);
+            }
+            Node = Shards[0]->node(static_cast<index_type>(Slot));
 
             Handles[H].NextSlot = Slot;
             Handles[H].NextNode = Node;
-
-            if (Slot > MaxSlotBeforeGrow) {
-                tryGrow(H);
-            }
         } else {
             Node = Handles[H].NextNode;
         }
 
         // insert key in the index in advance
-        Slots[Slot] = &Node->value();
+        *slotPtr(Slot) = &Node->value();
 
-        auto Res = Mapping.get(H, Node, std::forward<Args>(Xs)...);
+        auto Res = shardOf(HashValue).getPrehashed(H, Node, HashValue, std::forward<Args>(Xs)...);
         if (Res.second) {
             // inserted by self
+            HeapBytes.fetch_add(
+                    sizeof(value_type) + dynamicMemoryUsage(Node->value().first), std::memory_order_relaxed);
             Handles[H] = {};
             return std::make_pair(static_cast<index_type>(Slot), true);
         } else {
@@ -330,10 +422,68 @@ public:
         }
     }
 
+    /**
+     * Remove every element whose index the given predicate does not report
+     * as live, and return the number of removed elements. The indices of the
+     * surviving elements are unchanged; the freed slots are recycled by
+     * later insertions before the index is grown. Fetching a removed index
+     * is undefined; iteration skips the freed slots.
+     *
+     * This function is not thread-safe, do not call when other threads are
+     * using the datastructure.
+     */
+    template <class IsLive>
+    std::size_t sweep(IsLive&& Live) {
+        // slots reserved by a handle for its next insertion hold no element yet
+        std::vector<slot_type> Pending;
+        for (lane_id I = 0; I < HandleCount; ++I) {
+            if (Handles[I].NextSlot != NONE) {
+                Pending.push_back(Handles[I].NextSlot);
+            }
+        }
+        std::sort(Pending.begin(), Pending.end());
+
+        // drop the consumed prefix of the free list, keeping unconsumed slots
+        const std::intptr_t Remaining = std::max<std::intptr_t>(FreeTop.load(std::memory_order_relaxed), 0);
+        FreeSlots.resize(static_cast<std::size_t>(Remaining));
+
+        std::size_t Swept = 0;
+        const slot_type End = NextSlot.load(std::memory_order_relaxed);
+        for (slot_type I = FirstSlot; I < End; ++I) {
+            if (std::binary_search(Pending.begin(), Pending.end(), I)) {
+                continue;
+            }
+            const value_type** Ptr = slotPtr(I);
+            const value_type* V = *Ptr;
+            if (V == nullptr || Live(index(I))) {  // already freed or still live
+                continue;
+            }
+            HeapBytes.fetch_sub(
+                    sizeof(value_type) + dynamicMemoryUsage(V->first), std::memory_order_relaxed);
+            const std::size_t HashValue = Hasher(V->first);
+            const bool Erased = shardOf(HashValue).erasePrehashed(HashValue, V);
+            assert(Erased && "swept element must be indexed in its shard");
+            (void)Erased;
+            *Ptr = nullptr;
+            FreeSlots.push_back(I);
+            ++Swept;
+        }
+        FreeTop.store(static_cast<std::intptr_t>(FreeSlots.size()), std::memory_order_relaxed);
+
+        // invalidate the per-thread fetch caches, whose entries may point at
+        // swept values or at slots about to be recycled
+        SweepGeneration.fetch_add(1, std::memory_order_release);
+        return Swept;
+    }
+
 private:
     using map_type = ConcurrentInsertOnlyHashMap<LanesPolicy, Key, index_type, Hash, KeyEqual, KeyFactory>;
     using node_type = typename map_type::node_type;
 
+    /// Number of hash-prefix shards of the key-to-index mapping.
+    static constexpr std::size_t ShardBits = 4;
+    static constexpr std::size_t ShardCount = std::size_t(1) << ShardBits;
+
     struct Handle {
         /// Slot where this handle will store its next value
         slot_type NextSlot = NONE;
@@ -351,43 +501,154 @@ private:
     // Handle for each concurrent lane.
     std::unique_ptr<Handle[]> Handles;
 
-    // Slots[I] points to the value associated with index I.
-    std::unique_ptr<const value_type*[]> Slots;
+    /// log2 of the size of the first slot segment.
+    static constexpr std::size_t SegmentBits = 3;
+    static constexpr std::size_t SegmentSize = std::size_t(1) << SegmentBits;
 
-    // The map from keys to index.
-    map_type Mapping;
+    /// Number of slot segments; segment S holds `SegmentSize << S` slots, so
+    /// together the segments cover the whole slot domain.
+    static constexpr std::size_t SegmentCount =
+            std::numeric_limits<std::size_t>::digits - SegmentBits;
 
-    // Next available slot.
-    std::atomic<slot_type> NextSlot;
+    // Segment S points to the values associated with indices
+    // [(SegmentSize << S) - SegmentSize, (SegmentSize << (S + 1)) - SegmentSize).
+    // Segments are allocated on demand, published with a CAS and never moved,
+    // so slots can be read without a lock while the datastructure grows.
+    std::array<std::atomic<const value_type**>, SegmentCount> Segments;
 
-    // Maximum allowed slot index before growing
-    slot_type MaxSlotBeforeGrow;
+    /// Segment number holding the given slot, as in `PiggyList`.
+    static std::size_t segmentOf(const slot_type I) {
+        return (63 - __builtin_clzll(I + SegmentSize)) - SegmentBits;
+    }
 
-    bool tryGrow(const lane_id H) {
-        Lanes.beforeLockAllBut(H);
+    /// Pointer to the given slot; its segment must have been allocated.
+    const value_type** slotPtr(const slot_type I) const {
+        const std::size_t ShiftedSlot = I + SegmentSize;
+        const std::size_t S = (63 - __builtin_clzll(ShiftedSlot)) - SegmentBits;
+        const value_type** Segment = Segments[S].load(std::memory_order_acquire);
+        return &Segment[ShiftedSlot & ((SegmentSize << S) - 1)];
+    }
 
-        if (NextSlot <= MaxSlotBeforeGrow) {
-            // Current size is fine
-            Lanes.beforeUnlockAllBut(H);
-            return false;
-        }
+    /// The value stored in the given slot; its segment must have been allocated.
+    const value_type* getSlot(const slot_type I) const {
+        return *slotPtr(I);
+    }
 
-        Lanes.lockAllBut(H);
+    /// Allocate the segment holding the given slot if it does not exist yet.
+    /// Lock-free; a lane that loses the publication race frees its allocation.
+    void ensureSegment(const slot_type I) {
+        allocateSegment(segmentOf(I));
+    }
 
-        {  // safe section
-            const std::size_t CurrentSize = MaxSlotBeforeGrow + 1;
-            const std::size_t NewSize = (CurrentSize << 1);  // double size policy
-            std::unique_ptr<const value_type*[]> NewSlots = std::make_unique<const value_type*[]>(NewSize);
-            std::memcpy(NewSlots.get(), Slots.get(), sizeof(const value_type*) * CurrentSize);
-            Slots = std::move(NewSlots);
-            MaxSlotBeforeGrow = NewSize - 1;
+    /// Allocate the given segment if it does not exist yet.
+    void allocateSegment(const std::size_t S) {
+        if (Segments[S].load(std::memory_order_acquire) == nullptr) {
+            const value_type** Fresh = new const value_type*[SegmentSize << S]();
+            adviseHugePages(Fresh, (SegmentSize << S) * sizeof(const value_type*));
+            const value_type** Expected = nullptr;
+            if (!Segments[S].compare_exchange_strong(
+                        Expected, Fresh, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                delete[] Fresh;
+            }
+        }
+    }
+
+    /// Allocate all segments needed to address the given number of slots.
+    void reserveSlots(const std::size_t SlotCount) {
+        if (SlotCount == 0) {
+            return;
+        }
+        const std::size_t Last = segmentOf(slot(SlotCount - 1));
+        for (std::size_t S = 0; S <= Last; ++S) {
+            allocateSegment(S);
         }
+    }
+
+    // Hash function, used to select the shard of a key.
+    Hash Hasher;
+
+    // The map from keys to index, sharded by hash prefix.
+    std::vector<std::unique_ptr<map_type>> Shards;
+
+    /// Select the shard responsible for a hash value by its topmost bits;
+    /// the buckets inside a shard are addressed by the lower bits.
+    map_type& shardOf(const std::size_t HashValue) const {
+        return *Shards[HashValue >> (std::numeric_limits<std::size_t>::digits - ShardBits)];
+    }
+
+    /// Estimate of the heap storage behind one key, for keys that own a
+    /// dynamic buffer (strings, record vectors); zero for everything else.
+    template <typename T>
+    static auto dynamicMemoryUsage(const T& X, int) -> decltype(std::size_t(X.capacity())) {
+        return X.capacity() * sizeof(typename T::value_type);
+    }
+
+    template <typename T>
+    static std::size_t dynamicMemoryUsage(const T&, long) {
+        return 0;
+    }
+
+    template <typename T>
+    static std::size_t dynamicMemoryUsage(const T& X) {
+        return dynamicMemoryUsage(X, 0);
+    }
+
+    // First non-reserved slot.
+    slot_type FirstSlot;
+
+    // Next available slot.
+    std::atomic<slot_type> NextSlot;
 
-        Lanes.beforeUnlockAllBut(H);
-        Lanes.unlockAllBut(H);
+    // Slots released by sweeps; only grown and compacted at safe points,
+    // so lanes may read its fixed entries without a lock.
+    std::vector<slot_type> FreeSlots;
+
+    // Number of entries of FreeSlots not yet claimed by an insertion.
+    std::atomic<std::intptr_t> FreeTop{0};
+
+    /// Size of the per-thread fetch cache; a power of two.
+    static constexpr std::size_t FetchCacheSize = 1024;
+
+    /// Entry of the per-thread fetch cache. The owner id keeps entries of
+    /// distinct flyweight instances sharing the thread-local cache apart; an
+    /// id rather than the address, as a new instance may reuse the address
+    /// of a destroyed one while the cache still holds its entries.
+    struct FetchCacheEntry {
+        std::uint64_t Owner = 0;
+        std::uint64_t Generation = 0;
+        index_type Idx = 0;
+        const Key* Value = nullptr;
+    };
 
-        return true;
+    /// Hand out a fresh owner id for the per-thread fetch caches.
+    static std::uint64_t nextInstanceId() {
+        static std::atomic<std::uint64_t> Counter{1};
+        return Counter.fetch_add(1, std::memory_order_relaxed);
     }
+
+    /// This instance's id in the per-thread fetch caches.
+    const std::uint64_t InstanceId = nextInstanceId();
+
+    // Bumped by every sweep; fetch-cache entries of older generations are
+    // ignored, as they may point at swept values or recycled slots.
+    std::atomic<std::uint64_t> SweepGeneration{0};
+
+    /// Claim a slot released by a sweep, or NONE if there is none left.
+    slot_type claimFreeSlot() {
+        if (FreeTop.load(std::memory_order_relaxed) <= 0) {
+            return NONE;
+        }
+        const std::intptr_t Top = FreeTop.fetch_sub(1, std::memory_order_acq_rel);
+        if (Top <= 0) {
+            // lost the race for the last free slots; undo the claim
+            FreeTop.fetch_add(1, std::memory_order_relaxed);
+            return NONE;
+        }
+        return FreeSlots[static_cast<std::size_t>(Top - 1)];
+    }
+
+    // Accumulated size of the stored key/index pairs and their heap storage.
+    std::atomic<std::size_t> HeapBytes{0};
 };
 
 #ifdef _OPENMP
@@ -420,13 +681,22 @@ public:
     }
 
     const Key& fetch(const index_type Idx) const {
-        return Base::fetch(Base::Lanes.threadLane(), Idx);
+        return Base::fetchCached(Idx);
     }
 
     template <class... Args>
     std::pair<index_type, bool> findOrInsert(Args&&... Xs) {
         return Base::findOrInsert(Base::Lanes.threadLane(), std::forward<Args>(Xs)...);
     }
+
+    void reserve(const std::size_t NumKeys) {
+        Base::reserve(NumKeys);
+    }
+
+    template <class IsLive>
+    std::size_t sweep(IsLive&& Live) {
+        return Base::sweep(std::forward<IsLive>(Live));
+    }
 };
 #endif
 
@@ -463,13 +733,22 @@ public:
     }
 
     const Key& fetch(const index_type Idx) const {
-        return Base::fetch(0, Idx);
+        return Base::fetchCached(Idx);
     }
 
     template <class... Args>
     std::pair<index_type, bool> findOrInsert(Args&&... Xs) {
         return Base::findOrInsert(0, std::forward<Args>(Xs)...);
     }
+
+    void reserve(const std::size_t NumKeys) {
+        Base::reserve(NumKeys);
+    }
+
+    template <class IsLive>
+    std::size_t sweep(IsLive&& Live) {
+        return Base::sweep(std::forward<IsLive>(Live));
+    }
 };
 
 #ifdef _OPENMP
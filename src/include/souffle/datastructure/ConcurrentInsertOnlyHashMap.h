@@ -73,6 +73,12 @@ struct Factory {
  * Access to the datastructure is lock-free between different lanes.
  * Concurrent accesses through the same lane is sequential.
  *
+ * Reads go through a lock-free fast path first: bucket tables are retired
+ * rather than freed when the map grows and nodes are never deallocated while
+ * the map is alive, so a reader may search a stale table without taking its
+ * lane lock. A concurrent rehash can at worst hide a present key from such a
+ * reader, in which case the search falls back to the locked path.
+ *
  * Growing the datastructure requires to temporarily lock all lanes to let a
  * single lane perform the growing operation. The global lock is amortized
  * thanks to an exponential growth strategy.
@@ -124,9 +130,25 @@ private:
         value_type Value;
 
         // Points to next element of the map that falls into the same bucket.
-        BucketList* Next;
+        // Atomic because the lock-free read path may chase this pointer while
+        // a growing lane relinks the node into a new bucket table.
+        std::atomic<BucketList*> Next;
+    };
+
+    // A bucket table of some size; the map replaces its table when it grows.
+    struct Table {
+        explicit Table(const std::size_t Count)
+                : BucketCount(Count), Buckets(std::make_unique<std::atomic<BucketList*>[]>(Count)) {}
+
+        const std::size_t BucketCount;
+        std::unique_ptr<std::atomic<BucketList*>[]> Buckets;
     };
 
+    /// Number of nodes the lock-free read path inspects before giving up.
+    /// The bound guards against chasing pointers that concurrent rehashes
+    /// keep relinking; the locked path then gives the definite answer.
+    static constexpr std::size_t MaxProbeSteps = 64;
+
 public:
     /**
      * @brief Construct a hash-map with at least the given number of buckets.
@@ -138,13 +160,13 @@ public:
             const KeyFactory& key_factory = KeyFactory())
             : Lanes(LaneCount), Hasher(hash), EqualTo(key_equal), Factory(key_factory) {
         Size = 0;
-        BucketCount = details::GreaterOrEqualPrime(Bucket_Count);
+        std::size_t BucketCount = details::GreaterOrEqualPrime(Bucket_Count);
         if (BucketCount == 0) {
             // Hopefuly this number of buckets is never reached.
             BucketCount = std::numeric_limits<std::size_t>::max();
         }
         LoadFactor = 1.0;
-        Buckets = std::make_unique<std::atomic<BucketList*>[]>(BucketCount);
+        CurrentTable = new Table(BucketCount);
         MaxSizeBeforeGrow = std::ceil(LoadFactor * BucketCount);
     }
 
@@ -153,20 +175,48 @@ public:
             : ConcurrentInsertOnlyHashMap(8, hash, key_equal, key_factory) {}
 
     ~ConcurrentInsertOnlyHashMap() {
-        for (std::size_t Bucket = 0; Bucket < BucketCount; ++Bucket) {
-            BucketList* L = Buckets[Bucket].load(std::memory_order_relaxed);
+        // every node is reachable from the current table; retired tables only
+        // hold stale bucket arrays
+        Table* Tab = CurrentTable.load(std::memory_order_relaxed);
+        for (std::size_t Bucket = 0; Bucket < Tab->BucketCount; ++Bucket) {
+            BucketList* L = Tab->Buckets[Bucket].load(std::memory_order_relaxed);
             while (L != nullptr) {
                 BucketList* BL = L;
-                L = L->Next;
+                L = L->Next.load(std::memory_order_relaxed);
                 delete (BL);
             }
         }
+        delete Tab;
     }
 
     void setNumLanes(const std::size_t NumLanes) {
         Lanes.setNumLanes(NumLanes);
     }
 
+    /**
+     * @brief Ensure capacity for the given number of elements.
+     *
+     * Rehashes once up-front instead of repeatedly while filling the map.
+     * This function is not thread-safe, do not call when other threads are
+     * using the datastructure.
+     */
+    void reserve(const std::size_t NumElements) {
+        const std::size_t NeededBucketCount = std::ceil(NumElements / LoadFactor);
+        Table* OldTable = CurrentTable.load(std::memory_order_relaxed);
+        if (NeededBucketCount <= OldTable->BucketCount) {
+            return;
+        }
+        std::size_t NewBucketCount = details::GreaterOrEqualPrime(NeededBucketCount);
+        if (NewBucketCount == 0) {
+            NewBucketCount = std::numeric_limits<std::size_t>::max();
+        }
+        Table* NewTable = new Table(NewBucketCount);
+        relinkNodes(OldTable, NewTable);
+        RetiredTables.emplace_back(OldTable);
+        CurrentTable.store(NewTable, std::memory_order_release);
+        MaxSizeBeforeGrow = (NewBucketCount * LoadFactor);
+    }
+
     /** @brief Create a fresh node initialized with the given value and a
      * default-constructed key.
      *
@@ -177,6 +227,32 @@ public:
         return static_cast<node_type>(BL);
     }
 
+    /**
+     * @brief Unlink and delete the node holding the given value.
+     *
+     * The value pointer identifies the node, using a hash value the caller
+     * already computed for its key. Returns true if the node was found and
+     * deleted. This function is not thread-safe, do not call when other
+     * threads are using the datastructure: deleted nodes may still be linked
+     * from retired bucket tables that stale lock-free readers traverse.
+     */
+    bool erasePrehashed(const std::size_t HashValue, const value_type* V) {
+        Table* Tab = CurrentTable.load(std::memory_order_relaxed);
+        std::atomic<BucketList*>* Link = &Tab->Buckets[HashValue % Tab->BucketCount];
+        BucketList* L = Link->load(std::memory_order_relaxed);
+        while (L != nullptr) {
+            if (&L->Value == V) {
+                Link->store(L->Next.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                delete L;
+                --Size;
+                return true;
+            }
+            Link = &L->Next;
+            L = Link->load(std::memory_order_relaxed);
+        }
+        return false;
+    }
+
     /** @brief Checks if the map contains an element with the given key.
      *
      * The search is done concurrently with possible insertion of the
@@ -186,17 +262,27 @@ public:
      */
     template <class K>
     bool weakContains(const lane_id H, const K& X) const {
-        const size_t HashValue = Hasher(X);
-        const auto Guard = Lanes.guard(H);
-        const size_t Bucket = HashValue % BucketCount;
+        return weakContainsPrehashed(H, Hasher(X), X);
+    }
 
-        BucketList* L = Buckets[Bucket].load(std::memory_order_consume);
+    /** @brief Checks if the map contains an element with the given key,
+     * using a hash value the caller already computed. */
+    template <class K>
+    bool weakContainsPrehashed(const lane_id H, const std::size_t HashValue, const K& X) const {
+        if (probe(HashValue, X) != nullptr) {
+            return true;
+        }
+        // a concurrent rehash may have hidden the key from the lock-free
+        // probe; only the locked search can answer negatively
+        const auto Guard = Lanes.guard(H);
+        const Table* Tab = CurrentTable.load(std::memory_order_relaxed);
+        const BucketList* L = Tab->Buckets[HashValue % Tab->BucketCount].load(std::memory_order_consume);
         while (L != nullptr) {
             if (EqualTo(L->Value.first, X)) {
                 // found the key
                 return true;
             }
-            L = L->Next;
+            L = L->Next.load(std::memory_order_consume);
         }
         return false;
     }
@@ -240,6 +326,19 @@ public:
      */
     template <class... Args>
     std::pair<const value_type*, bool> get(const lane_id H, node_type N, Args&&... Xs) {
+        return getPrehashed(H, N, Hasher(std::forward<Args>(Xs)...), std::forward<Args>(Xs)...);
+    }
+
+    /** @brief Like get, but takes a hash value the caller already computed. */
+    template <class... Args>
+    std::pair<const value_type*, bool> getPrehashed(
+            const lane_id H, node_type N, const std::size_t HashValue, Args&&... Xs) {
+        // Fast path: search the key lock-free; interning workloads mostly
+        // look up symbols that are already present.
+        if (const value_type* V = probe(HashValue, std::forward<Args>(Xs)...)) {
+            return std::make_pair(V, false);
+        }
+
         // At any time a concurrent lane may insert the key before this lane.
         //
         // The synchronisation point is the atomic compare-and-exchange of the
@@ -247,7 +346,7 @@ public:
         //
         // The insertion algorithm is as follow:
         //
-        // 1) Compute the key hash from Xs.
+        // 1) The key hash is given by the caller.
         //
         // 2) Lock the lane, that also prevent concurrent lanes from growing of
         // the datastructure.
@@ -291,18 +390,17 @@ public:
 
         size_t NewSize;
 
-        // 1)
-        const size_t HashValue = Hasher(std::forward<Args>(Xs)...);
-
         // 2)
         Lanes.lock(H);  // prevent the datastructure from growing
 
         // 3)
-        const size_t Bucket = HashValue % BucketCount;
+        // the table cannot be replaced while this lane is locked
+        Table* Tab = CurrentTable.load(std::memory_order_relaxed);
+        const size_t Bucket = HashValue % Tab->BucketCount;
 
         // 4)
         // the head of the bucket's list last time we checked
-        BucketList* LastKnownHead = Buckets[Bucket].load(std::memory_order_relaxed);
+        BucketList* LastKnownHead = Tab->Buckets[Bucket].load(std::memory_order_relaxed);
         // the head of the bucket's list we already searched from
         BucketList* SearchedFrom = nullptr;
         // the node we want to insert
@@ -322,13 +420,13 @@ public:
                     Value = &(L->Value);
                     goto Done;
                 }
-                L = L->Next;
+                L = L->Next.load(std::memory_order_relaxed);
             }
             SearchedFrom = LastKnownHead;
 
             // 7)
             // Not found in bucket, prepare node chaining.
-            Node->Next = LastKnownHead;
+            Node->Next.store(LastKnownHead, std::memory_order_relaxed);
             // The factory step could be done only once, but assuming bucket collisions are
             // rare this whole loop is not executed more than once.
             Factory.replace(const_cast<key_type&>(Node->Value.first), std::forward<Args>(Xs)...);
@@ -337,7 +435,7 @@ public:
             // Try to insert the key in front of the bucket's list.
             // This operation also performs step 4) because LastKnownHead is
             // updated in the process.
-            if (Buckets[Bucket].compare_exchange_strong(
+            if (Tab->Buckets[Bucket].compare_exchange_strong(
                         LastKnownHead, Node, std::memory_order_release, std::memory_order_relaxed)) {
                 // 9)
                 Inserted = true;
@@ -371,11 +469,12 @@ private:
     /// Hash function.
     Hash Hasher;
 
-    /// Current number of buckets.
-    std::size_t BucketCount;
+    /// The current bucket table.
+    std::atomic<Table*> CurrentTable;
 
-    /// Atomic pointer to head bucket linked-list head.
-    std::unique_ptr<std::atomic<BucketList*>[]> Buckets;
+    /// Tables replaced by growth operations; kept until destruction so that
+    /// lock-free readers holding a stale table never touch freed memory.
+    std::vector<std::unique_ptr<Table>> RetiredTables;
 
     /// The Equal-to function.
     KeyEqual EqualTo;
@@ -391,6 +490,52 @@ private:
     /// The load-factor of the map.
     double LoadFactor;
 
+    /** Search the key lock-free, inspecting at most MaxProbeSteps nodes.
+     *
+     * Returns the value if the key was found, nullptr otherwise. A negative
+     * answer is not definite: a concurrent rehash can relink nodes out of
+     * the list being searched, so callers must fall back to a locked search.
+     */
+    template <class... Args>
+    const value_type* probe(const std::size_t HashValue, Args&&... Xs) const {
+        const Table* Tab = CurrentTable.load(std::memory_order_acquire);
+        const BucketList* L = Tab->Buckets[HashValue % Tab->BucketCount].load(std::memory_order_consume);
+        std::size_t Steps = 0;
+        while (L != nullptr && Steps < MaxProbeSteps) {
+            if (EqualTo(L->Value.first, std::forward<Args>(Xs)...)) {
+                return &(L->Value);
+            }
+            L = L->Next.load(std::memory_order_consume);
+            ++Steps;
+        }
+        return nullptr;
+    }
+
+    /** Move all nodes of the old table into the new one.
+     *
+     * Rehashing is costly because it requires to scan the existing elements,
+     * compute their hashes to find their new buckets and relink them there.
+     * Callers must ensure no lane is concurrently writing.
+     *
+     * Maybe concurrent lanes could help using some job-stealing algorithm.
+     */
+    void relinkNodes(Table* OldTable, Table* NewTable) {
+        for (std::size_t B = 0; B < OldTable->BucketCount; ++B) {
+            BucketList* L = OldTable->Buckets[B].load(std::memory_order_relaxed);
+            while (L) {
+                BucketList* const Elem = L;
+                L = L->Next.load(std::memory_order_relaxed);
+
+                const auto& Value = Elem->Value;
+                std::size_t NewHash = Hasher(Value.first);
+                const std::size_t NewBucket = NewHash % NewTable->BucketCount;
+                Elem->Next.store(NewTable->Buckets[NewBucket].load(std::memory_order_relaxed),
+                        std::memory_order_relaxed);
+                NewTable->Buckets[NewBucket].store(Elem, std::memory_order_relaxed);
+            }
+        }
+    }
+
     // Grow the datastructure.
     // Must be called while owning lane H.
     bool tryGrow(const lane_id H) {
@@ -422,30 +567,15 @@ private:
                 }
             }
 
-            std::unique_ptr<std::atomic<BucketList*>[]> NewBuckets =
-                    std::make_unique<std::atomic<BucketList*>[]>(NewBucketCount);
-
-            // Rehash, this operation is costly because it requires to scan
-            // the existing elements, compute its hash to find its new bucket
-            // and insert in the new bucket.
-            //
-            // Maybe concurrent lanes could help using some job-stealing algorithm.
-            for (std::size_t B = 0; B < BucketCount; ++B) {
-                BucketList* L = Buckets[B].load(std::memory_order_relaxed);
-                while (L) {
-                    BucketList* const Elem = L;
-                    L = L->Next;
-
-                    const auto& Value = Elem->Value;
-                    std::size_t NewHash = Hasher(Value.first);
-                    const std::size_t NewBucket = NewHash % NewBucketCount;
-                    Elem->Next = NewBuckets[NewBucket].load(std::memory_order_relaxed);
-                    NewBuckets[NewBucket].store(Elem, std::memory_order_relaxed);
-                }
-            }
+            Table* OldTable = CurrentTable.load(std::memory_order_relaxed);
+            Table* NewTable = new Table(NewBucketCount);
+
+            relinkNodes(OldTable, NewTable);
 
-            Buckets = std::move(NewBuckets);
-            BucketCount = NewBucketCount;
+            // retire the old table instead of freeing it: lock-free readers
+            // may still be searching it
+            RetiredTables.emplace_back(OldTable);
+            CurrentTable.store(NewTable, std::memory_order_release);
             MaxSizeBeforeGrow = (NewBucketCount * LoadFactor);
         }
 
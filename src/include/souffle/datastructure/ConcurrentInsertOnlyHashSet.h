@@ -0,0 +1,347 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ConcurrentInsertOnlyHashSet.h
+ *
+ * An open-addressing hash set supporting concurrent insertions and
+ * lock-free membership tests, targeting relations that are only ever
+ * queried through point lookups.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A hash set of keys based on a linear-probing table of slots. Elements
+ * can only be inserted, never removed; the set can merely be cleared
+ * wholesale.
+ *
+ * Insertions claim an empty slot of the probing table through an atomic
+ * state transition and are thus carried out concurrently; membership
+ * tests are lock-free. Once the load factor of the probing table exceeds
+ * 1/2 the table is doubled under an exclusive lock, briefly blocking
+ * concurrent insertions. Replaced tables are retired rather than freed,
+ * such that iterators and membership tests obtained concurrently to the
+ * growth step remain valid; the retired tables are reclaimed upon
+ * clearing or destroying the set.
+ *
+ * Unlike the ordered data structures, the set supports no range queries
+ * and enumerates its elements in no particular order.
+ */
+template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class ConcurrentInsertOnlyHashSet {
+    // the states a slot of the probing table transitions through; slots
+    // are written at most once, thus FULL is a terminal state
+    enum SlotState : uint8_t { EMPTY = 0, BUSY = 1, FULL = 2 };
+
+    /** A single slot of the probing table. */
+    struct Slot {
+        std::atomic<uint8_t> state{EMPTY};
+        Key key{};
+    };
+
+    /** A probing table, linked to the table it grew out of. */
+    struct Table {
+        Table(std::size_t capacity, Table* prev)
+                : slots(std::make_unique<Slot[]>(capacity)), capacity(capacity), prev(prev) {}
+
+        std::unique_ptr<Slot[]> slots;
+
+        // the number of slots, always a power of two
+        std::size_t capacity;
+
+        // the retired predecessor of this table
+        Table* prev;
+    };
+
+    // the capacity of the initial probing table
+    static constexpr std::size_t MIN_CAPACITY = 1 << 4;
+
+    // the current probing table; retired tables remain linked behind it
+    std::atomic<Table*> table;
+
+    // the number of keys stored in the current table
+    std::atomic<std::size_t> count{0};
+
+    // synchronizes insertions (shared) against table growth (exclusive)
+    mutable ReadWriteLock growth_lock;
+
+    Hash hasher;
+    KeyEqual equal;
+
+public:
+    /**
+     * An iterator enumerating the occupied slots of one probing table.
+     * Obtaining and advancing iterators is safe at any time, yet elements
+     * inserted after the iterator was obtained may not be covered.
+     */
+    class iterator {
+        const Slot* slots = nullptr;
+        std::size_t pos = 0;
+        std::size_t limit = 0;
+
+        // advances to the next occupied slot
+        void forward() {
+            while (pos < limit && slots[pos].state.load(std::memory_order_acquire) != FULL) {
+                ++pos;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+
+        iterator(const Slot* slots, std::size_t pos, std::size_t limit)
+                : slots(slots), pos(pos), limit(limit) {
+            forward();
+        }
+
+        const Key& operator*() const {
+            return slots[pos].key;
+        }
+
+        const Key* operator->() const {
+            return &slots[pos].key;
+        }
+
+        iterator& operator++() {
+            ++pos;
+            forward();
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const {
+            return pos == other.pos && slots == other.slots;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    ConcurrentInsertOnlyHashSet() : table(new Table(MIN_CAPACITY, nullptr)) {}
+
+    // sets maintain exclusive ownership of their probing tables
+    ConcurrentInsertOnlyHashSet(const ConcurrentInsertOnlyHashSet&) = delete;
+    ConcurrentInsertOnlyHashSet& operator=(const ConcurrentInsertOnlyHashSet&) = delete;
+
+    ~ConcurrentInsertOnlyHashSet() {
+        freeTables(table.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Inserts the given key unless it is already present. Returns true
+     * if the key was inserted by this operation.
+     */
+    bool insert(const Key& k) {
+        while (true) {
+            growth_lock.start_read();
+            Table& cur = *table.load(std::memory_order_acquire);
+            const std::size_t mask = cur.capacity - 1;
+            std::size_t pos = hasher(k) & mask;
+            for (std::size_t probes = 0; probes < cur.capacity; ++probes, pos = (pos + 1) & mask) {
+                Slot& slot = cur.slots[pos];
+                while (true) {
+                    uint8_t state = slot.state.load(std::memory_order_acquire);
+                    if (state == BUSY) {
+                        // a concurrent insertion is writing this slot
+                        // => wait for its key to become comparable
+                        continue;
+                    }
+                    if (state == FULL) {
+                        break;
+                    }
+                    // claim the empty slot; on failure re-examine it
+                    uint8_t expected = EMPTY;
+                    if (slot.state.compare_exchange_strong(expected, BUSY, std::memory_order_acq_rel)) {
+                        slot.key = k;
+                        slot.state.store(FULL, std::memory_order_release);
+                        std::size_t newCount = count.fetch_add(1, std::memory_order_relaxed) + 1;
+                        bool needGrow = 2 * newCount > cur.capacity;
+                        growth_lock.end_read();
+                        if (needGrow) {
+                            grow();
+                        }
+                        return true;
+                    }
+                }
+                if (equal(slot.key, k)) {
+                    growth_lock.end_read();
+                    return false;
+                }
+            }
+            // the entire table was probed without locating the key or an
+            // empty slot; growth is triggered well before this point, yet
+            // concurrent insertions may exhaust the remaining slots first
+            growth_lock.end_read();
+            grow();
+        }
+    }
+
+    /** Determines whether the given key is contained in this set. */
+    bool contains(const Key& k) const {
+        const Table& cur = *table.load(std::memory_order_acquire);
+        const std::size_t mask = cur.capacity - 1;
+        std::size_t pos = hasher(k) & mask;
+        for (std::size_t probes = 0; probes < cur.capacity; ++probes, pos = (pos + 1) & mask) {
+            const Slot& slot = cur.slots[pos];
+            uint8_t state = slot.state.load(std::memory_order_acquire);
+            while (state == BUSY) {
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (state == EMPTY) {
+                return false;
+            }
+            if (equal(slot.key, k)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * Obtains the range of elements equivalent to the given key, thus a
+     * range covering a single element if the key is present and an empty
+     * range otherwise.
+     */
+    range<iterator> equalRange(const Key& k) const {
+        const Table& cur = *table.load(std::memory_order_acquire);
+        const std::size_t mask = cur.capacity - 1;
+        std::size_t pos = hasher(k) & mask;
+        for (std::size_t probes = 0; probes < cur.capacity; ++probes, pos = (pos + 1) & mask) {
+            const Slot& slot = cur.slots[pos];
+            uint8_t state = slot.state.load(std::memory_order_acquire);
+            while (state == BUSY) {
+                state = slot.state.load(std::memory_order_acquire);
+            }
+            if (state == EMPTY) {
+                break;
+            }
+            if (equal(slot.key, k)) {
+                return make_range(iterator(cur.slots.get(), pos, cur.capacity),
+                        iterator(cur.slots.get(), pos + 1, cur.capacity));
+            }
+        }
+        iterator empty(cur.slots.get(), cur.capacity, cur.capacity);
+        return make_range(empty, empty);
+    }
+
+    /** Obtains the number of elements in this set. */
+    std::size_t size() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    /** Determines whether this set is empty. */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    iterator begin() const {
+        const Table& cur = *table.load(std::memory_order_acquire);
+        return iterator(cur.slots.get(), 0, cur.capacity);
+    }
+
+    iterator end() const {
+        const Table& cur = *table.load(std::memory_order_acquire);
+        return iterator(cur.slots.get(), cur.capacity, cur.capacity);
+    }
+
+    /**
+     * Partitions the slots of the probing table into approximately the
+     * given number of ranges for parallel processing.
+     */
+    std::vector<range<iterator>> partition(std::size_t chunks) const {
+        const Table& cur = *table.load(std::memory_order_acquire);
+        std::vector<range<iterator>> res;
+        std::size_t step = std::max(cur.capacity / chunks, std::size_t(1));
+        for (std::size_t pos = 0; pos < cur.capacity; pos += step) {
+            std::size_t next = std::min(pos + step, cur.capacity);
+            res.push_back(make_range(
+                    iterator(cur.slots.get(), pos, next), iterator(cur.slots.get(), next, next)));
+        }
+        return res;
+    }
+
+    /**
+     * Removes all elements from this set and reclaims the retired probing
+     * tables. Must not be run concurrently to any other operation.
+     */
+    void clear() {
+        freeTables(table.exchange(new Table(MIN_CAPACITY, nullptr)));
+        count.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    /**
+     * Replaces the current probing table by one of twice its capacity,
+     * rehashing all stored keys. The replaced table is retired, keeping
+     * concurrently obtained iterators valid.
+     */
+    void grow() {
+        growth_lock.start_write();
+        Table* cur = table.load(std::memory_order_relaxed);
+
+        // re-examine the load factor; a concurrent insertion may have
+        // grown the table already
+        if (2 * count.load(std::memory_order_relaxed) <= cur->capacity) {
+            growth_lock.end_write();
+            return;
+        }
+
+        auto* fresh = new Table(cur->capacity * 2, cur);
+        const std::size_t mask = fresh->capacity - 1;
+        for (std::size_t i = 0; i < cur->capacity; ++i) {
+            Slot& slot = cur->slots[i];
+            if (slot.state.load(std::memory_order_relaxed) != FULL) {
+                continue;
+            }
+            std::size_t pos = hasher(slot.key) & mask;
+            while (fresh->slots[pos].state.load(std::memory_order_relaxed) == FULL) {
+                pos = (pos + 1) & mask;
+            }
+            fresh->slots[pos].key = slot.key;
+            fresh->slots[pos].state.store(FULL, std::memory_order_relaxed);
+        }
+
+        // publish the new table; all slot contents are made visible to
+        // the lock-free readers by this release
+        table.store(fresh, std::memory_order_release);
+        growth_lock.end_write();
+    }
+
+    /** Frees the given table together with all its retired predecessors. */
+    static void freeTables(Table* cur) {
+        while (cur != nullptr) {
+            Table* prev = cur->prev;
+            delete cur;
+            cur = prev;
+        }
+    }
+};
+
+}  // namespace souffle
@@ -34,6 +34,7 @@
 #include <shared_mutex>
 #include <stdexcept>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -110,16 +111,38 @@ public:
      * @param other the binary relation from which to add elements from
      */
     void insertAll(const EquivalenceRelation<TupleType>& other) {
+        // batches of at least this many elements go through the parallel
+        // hook-and-compress kernel instead of one serial union per pair
+        static constexpr std::size_t bulkUnionThreshold = 10000;
+
         other.genAllDisjointSetLists();
 
-        // iterate over partitions at a time
-        for (typename StatesMap::chunk it : other.equivalencePartition.getChunks(MAX_THREADS)) {
-            for (auto& p : it) {
-                value_type rep = p.first;
-                StatesList& pl = *p.second;
-                const std::size_t ksize = pl.size();
-                for (std::size_t i = 0; i < ksize; ++i) {
-                    this->sds.unionNodes(rep, pl.get(i));
+        if (other.sds.size() >= bulkUnionThreshold) {
+            // materialise the pending (representative, element) pairs and
+            // union them in bulk
+            std::vector<std::pair<value_type, value_type>> pending;
+            pending.reserve(other.sds.size());
+            for (typename StatesMap::chunk it : other.equivalencePartition.getChunks(MAX_THREADS)) {
+                for (auto& p : it) {
+                    value_type rep = p.first;
+                    StatesList& pl = *p.second;
+                    const std::size_t ksize = pl.size();
+                    for (std::size_t i = 0; i < ksize; ++i) {
+                        pending.push_back({rep, pl.get(i)});
+                    }
+                }
+            }
+            this->sds.unionAll(pending);
+        } else {
+            // iterate over partitions at a time
+            for (typename StatesMap::chunk it : other.equivalencePartition.getChunks(MAX_THREADS)) {
+                for (auto& p : it) {
+                    value_type rep = p.first;
+                    StatesList& pl = *p.second;
+                    const std::size_t ksize = pl.size();
+                    for (std::size_t i = 0; i < ksize; ++i) {
+                        this->sds.unionNodes(rep, pl.get(i));
+                    }
                 }
             }
         }
@@ -717,9 +740,16 @@ private:
      * Each set is partitioned into a PiggyList.
      */
     void genAllDisjointSetLists() const {
+        // fast path - the cache is only mutated while the lock is held, so a
+        // fresh cache can be used without acquiring it; readers thus only
+        // contend on the lock while a regeneration is actually due
+        if (!this->statesMapStale.load(std::memory_order_acquire)) {
+            return;
+        }
+
         statesLock.lock();
 
-        // no need to generate again, already done.
+        // no need to generate again, another thread beat us to it.
         if (!this->statesMapStale.load(std::memory_order_acquire)) {
             statesLock.unlock();
             return;
@@ -729,6 +759,49 @@ private:
         emptyPartition();
 
         std::size_t dSetSize = this->sds.ds.a_blocks.size();
+#ifdef IS_PARALLEL
+        // bulk three-phase generation: resolving representatives and
+        // appending elements are embarrassingly parallel; only creating
+        // the per-class buckets mutates the map, and that is done once
+        // per equivalence class rather than once per element, avoiding
+        // the contended functor-insert path of the lambda btree
+
+        // phase 1: resolve the representative of every element
+        std::vector<parent_t> reps(dSetSize);
+#pragma omp parallel for schedule(static)
+        for (std::size_t i = 0; i < dSetSize; ++i) {
+            reps[i] = this->sds.findNode(this->sds.toSparse(i));
+        }
+
+        // phase 2: create one exactly-sized bucket per class; the lock is
+        // held exclusively, so the plain sequential insert suffices for
+        // the comparatively few classes
+        std::unordered_map<parent_t, std::size_t> classSizes;
+        for (parent_t rep : reps) {
+            ++classSizes[rep];
+        }
+        std::unordered_map<parent_t, StatesList*> buckets(classSizes.size());
+        for (const auto& cls : classSizes) {
+            // initial block size covering the whole class in one allocation
+            std::size_t bits = 1;
+            while ((std::size_t(1) << bits) < cls.second) {
+                ++bits;
+            }
+            StorePair p = {static_cast<value_type>(cls.first), nullptr};
+            buckets[cls.first] = equivalencePartition.insert(p, [&](StorePair& sp) {
+                auto* r = new StatesList(bits);
+                sp.second = r;
+                return r;
+            });
+        }
+
+        // phase 3: append the elements; bucket lookups are read-only and
+        // the lists support concurrent appends
+#pragma omp parallel for schedule(static)
+        for (std::size_t i = 0; i < dSetSize; ++i) {
+            buckets.at(reps[i])->append(this->sds.toSparse(i));
+        }
+#else
         for (std::size_t i = 0; i < dSetSize; ++i) {
             typename TupleType::value_type sparseVal = this->sds.toSparse(i);
             parent_t rep = this->sds.findNode(sparseVal);
@@ -741,6 +814,7 @@ private:
             });
             mapList->append(sparseVal);
         }
+#endif
 
         statesMapStale.store(false, std::memory_order_release);
         statesLock.unlock();
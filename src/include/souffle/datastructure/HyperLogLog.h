@@ -0,0 +1,113 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HyperLogLog.h
+ *
+ * A fixed-size HyperLogLog sketch for approximate distinct counting,
+ * backing the `countd` aggregate.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace souffle {
+
+/**
+ * A HyperLogLog cardinality sketch over 64-bit hashed values.
+ *
+ * The sketch occupies a fixed 2^Precision bytes regardless of how many
+ * values are inserted, and two sketches built over disjoint portions of
+ * the data merge by taking the register-wise maximum, which makes it
+ * suitable as a parallel reduction state.
+ */
+class HyperLogLog {
+public:
+    /** number of index bits; 2^12 registers give a standard error of ~1.6% */
+    static constexpr std::size_t Precision = 12;
+    static constexpr std::size_t NumRegisters = std::size_t(1) << Precision;
+
+    /** @brief Fold a value into the sketch */
+    void insert(uint64_t value) {
+        const uint64_t hash = mix(value);
+        const std::size_t index = static_cast<std::size_t>(hash >> (64 - Precision));
+        // rank of the first set bit in the remaining hash bits, 1-based;
+        // the sentinel bit bounds the rank once the index bits are shifted out
+        const uint64_t rest = (hash << Precision) | (uint64_t(1) << (Precision - 1));
+        const uint8_t rank = static_cast<uint8_t>(countLeadingZeroes(rest) + 1);
+        if (registers[index] < rank) {
+            registers[index] = rank;
+        }
+    }
+
+    /** @brief Combine with a sketch built over another portion of the data */
+    void merge(const HyperLogLog& other) {
+        for (std::size_t i = 0; i < NumRegisters; ++i) {
+            if (registers[i] < other.registers[i]) {
+                registers[i] = other.registers[i];
+            }
+        }
+    }
+
+    /** @brief Estimate the number of distinct inserted values */
+    std::size_t estimate() const {
+        double sum = 0.0;
+        std::size_t zeroes = 0;
+        for (const auto reg : registers) {
+            sum += 1.0 / static_cast<double>(uint64_t(1) << reg);
+            if (reg == 0) {
+                ++zeroes;
+            }
+        }
+        const double m = static_cast<double>(NumRegisters);
+        double raw = alpha() * m * m / sum;
+        // small cardinalities are better served by linear counting
+        if (raw <= 2.5 * m && zeroes > 0) {
+            raw = m * std::log(m / static_cast<double>(zeroes));
+        }
+        return static_cast<std::size_t>(raw + 0.5);
+    }
+
+private:
+    /** bias correction constant for the chosen register count */
+    static constexpr double alpha() {
+        return 0.7213 / (1.0 + 1.079 / static_cast<double>(NumRegisters));
+    }
+
+    /** 64-bit finaliser of splitmix64; spreads the dense domain values well */
+    static uint64_t mix(uint64_t value) {
+        value += UINT64_C(0x9e3779b97f4a7c15);
+        value = (value ^ (value >> 30)) * UINT64_C(0xbf58476d1ce4e5b9);
+        value = (value ^ (value >> 27)) * UINT64_C(0x94d049bb133111eb);
+        return value ^ (value >> 31);
+    }
+
+    static int countLeadingZeroes(uint64_t value) {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanReverse64(&index, value);
+        return 63 - static_cast<int>(index);
+#else
+        return __builtin_clzll(value);
+#endif
+    }
+
+    std::array<uint8_t, NumRegisters> registers{};
+};
+
+}  // namespace souffle
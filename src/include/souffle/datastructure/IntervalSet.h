@@ -0,0 +1,336 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file IntervalSet.h
+ *
+ * A set of unary tuples stored as coalesced intervals, collapsing
+ * contiguous runs of values into a single span each.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A set of unary tuples represented by the closed intervals it covers.
+ * Contiguous runs of values -- as produced by `range` generators or by
+ * relations encoding address and line spans point by point -- collapse
+ * into a single [lo,hi] entry, so memory is proportional to the number
+ * of maximal spans rather than the number of stored values.
+ *
+ * Membership tests locate the span preceding the probed value in a map
+ * ordered by span start, costing a single logarithmic search over the
+ * spans. Iteration and range queries enumerate the covered values one
+ * by one, preserving the tuple-at-a-time interface the evaluation
+ * engines expect.
+ *
+ * Following the precedent of the equivalence relation, mutation is
+ * serialized internally by a readers-writer lock so the structure can
+ * back relations filled from parallel rule evaluation.
+ *
+ * @tparam TupleType the stored tuple type; its arity must be one
+ */
+template <typename TupleType>
+class IntervalSet {
+    using value_type = typename TupleType::value_type;
+    using span_map = std::map<value_type, value_type>;
+    using span_iterator = typename span_map::const_iterator;
+
+    static_assert(std::tuple_size<TupleType>::value == 1, "interval sets are limited to unary relations");
+
+    // maps the lower end of each stored span to its inclusive upper end;
+    // spans are pairwise disjoint and never adjacent
+    span_map spans;
+
+    // the number of values covered by the stored spans
+    std::size_t count = 0;
+
+    // serializes mutation against concurrent lookups
+    mutable std::shared_mutex access;
+
+public:
+    IntervalSet() = default;
+
+    /**
+     * The span map carries no positional caches, hence operation hints
+     * are stateless; the type merely satisfies the index interface.
+     */
+    struct operation_hints {};
+
+    /**
+     * An iterator enumerating the covered values in ascending order. The
+     * current tuple is materialized inside the iterator, advancing within
+     * a span by incrementing the cached value and only stepping the
+     * underlying map iterator at span boundaries.
+     */
+    class iterator {
+        span_iterator span{};
+        span_iterator finish{};
+        TupleType value{};
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = TupleType;
+        using pointer = const TupleType*;
+        using reference = const TupleType&;
+
+        iterator() = default;
+
+        iterator(span_iterator span, span_iterator finish) : span(span), finish(finish) {
+            if (span != finish) {
+                value[0] = span->first;
+            }
+        }
+
+        iterator(span_iterator span, span_iterator finish, typename IntervalSet::value_type cur)
+                : span(span), finish(finish) {
+            value[0] = cur;
+        }
+
+        const TupleType& operator*() const {
+            return value;
+        }
+
+        const TupleType* operator->() const {
+            return &value;
+        }
+
+        iterator& operator++() {
+            if (value[0] == span->second) {
+                ++span;
+                if (span != finish) {
+                    value[0] = span->first;
+                }
+            } else {
+                ++value[0];
+            }
+            return *this;
+        }
+
+        bool operator==(const iterator& other) const {
+            return span == other.span && (span == finish || value[0] == other.value[0]);
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    /**
+     * Inserts a single value, coalescing it with an abutting span on
+     * either side. Returns true if the value was not present before.
+     */
+    bool insert(const TupleType& tuple) {
+        const value_type value = tuple[0];
+        std::unique_lock<std::shared_mutex> guard(access);
+        auto next = spans.upper_bound(value);
+        if (next != spans.begin()) {
+            auto prev = std::prev(next);
+            if (value <= prev->second) {
+                return false;
+            }
+            if (prev->second == value - 1) {
+                // grow the left neighbour, and bridge to the right one
+                // if the new value closes the gap between the two
+                if (next != spans.end() && next->first == value + 1) {
+                    prev->second = next->second;
+                    spans.erase(next);
+                } else {
+                    prev->second = value;
+                }
+                ++count;
+                return true;
+            }
+        }
+        if (next != spans.end() && next->first == value + 1) {
+            // extend the right neighbour downwards by re-keying it
+            const value_type hi = next->second;
+            spans.erase(next);
+            spans.emplace(value, hi);
+        } else {
+            spans.emplace(value, value);
+        }
+        ++count;
+        return true;
+    }
+
+    bool insert(const TupleType& tuple, operation_hints& /* hints */) {
+        return insert(tuple);
+    }
+
+    /**
+     * Inserts the closed span [lo,hi] as a single update, merging all
+     * spans it overlaps or abuts. This is the fast path for range
+     * generators, which would otherwise fill the set value by value.
+     * Returns true if at least one new value was covered.
+     */
+    bool insert(value_type lo, value_type hi) {
+        if (lo > hi) {
+            return false;
+        }
+        std::unique_lock<std::shared_mutex> guard(access);
+        value_type newLo = lo;
+        value_type newHi = hi;
+        std::size_t covered = 0;
+        // locate the first span reachable from [lo,hi], including a left
+        // neighbour that overlaps or abuts the new span
+        auto cur = spans.upper_bound(lo);
+        if (cur != spans.begin()) {
+            auto prev = std::prev(cur);
+            if (lo == std::numeric_limits<value_type>::min() || prev->second >= lo - 1) {
+                cur = prev;
+            }
+        }
+        // absorb every span starting no later than one past the new end
+        while (cur != spans.end() &&
+                (hi == std::numeric_limits<value_type>::max() || cur->first <= hi + 1)) {
+            newLo = std::min(newLo, cur->first);
+            newHi = std::max(newHi, cur->second);
+            const value_type overlapLo = std::max(cur->first, lo);
+            const value_type overlapHi = std::min(cur->second, hi);
+            if (overlapLo <= overlapHi) {
+                covered += width(overlapLo, overlapHi);
+            }
+            cur = spans.erase(cur);
+        }
+        spans.emplace(newLo, newHi);
+        const std::size_t added = width(lo, hi) - covered;
+        count += added;
+        return added > 0;
+    }
+
+    /** Tests whether the given value is covered by a stored span. */
+    bool contains(const TupleType& tuple) const {
+        const value_type value = tuple[0];
+        std::shared_lock<std::shared_mutex> guard(access);
+        auto next = spans.upper_bound(value);
+        if (next == spans.begin()) {
+            return false;
+        }
+        return value <= std::prev(next)->second;
+    }
+
+    bool contains(const TupleType& tuple, operation_hints& /* hints */) const {
+        return contains(tuple);
+    }
+
+    /** Obtains an iterator to the first covered value no less than the given one. */
+    iterator lower_bound(const TupleType& tuple) const {
+        const value_type value = tuple[0];
+        auto next = spans.upper_bound(value);
+        if (next != spans.begin()) {
+            auto prev = std::prev(next);
+            if (value <= prev->second) {
+                return iterator(prev, spans.end(), value);
+            }
+        }
+        return iterator(next, spans.end());
+    }
+
+    iterator lower_bound(const TupleType& tuple, operation_hints& /* hints */) const {
+        return lower_bound(tuple);
+    }
+
+    /** Obtains an iterator to the first covered value greater than the given one. */
+    iterator upper_bound(const TupleType& tuple) const {
+        if (tuple[0] == std::numeric_limits<value_type>::max()) {
+            return end();
+        }
+        return lower_bound(TupleType{static_cast<value_type>(tuple[0] + 1)});
+    }
+
+    iterator upper_bound(const TupleType& tuple, operation_hints& /* hints */) const {
+        return upper_bound(tuple);
+    }
+
+    iterator begin() const {
+        return iterator(spans.begin(), spans.end());
+    }
+
+    iterator end() const {
+        return iterator(spans.end(), spans.end());
+    }
+
+    /** Obtains the number of covered values. */
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> guard(access);
+        return count;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /** Obtains the number of maximal spans the covered values form. */
+    std::size_t getNumSpans() const {
+        std::shared_lock<std::shared_mutex> guard(access);
+        return spans.size();
+    }
+
+    /**
+     * Splits the content into approximately balanced chunks for parallel
+     * processing. Chunk boundaries are drawn between spans, so the split
+     * balances spans rather than covered values.
+     */
+    std::vector<souffle::range<iterator>> partition(std::size_t chunks = 100) const {
+        std::vector<souffle::range<iterator>> res;
+        if (spans.empty()) {
+            return res;
+        }
+        const std::size_t step = std::max<std::size_t>(spans.size() / std::max<std::size_t>(chunks, 1), 1);
+        auto cur = spans.begin();
+        while (cur != spans.end()) {
+            auto next = cur;
+            for (std::size_t i = 0; i < step && next != spans.end(); ++i) {
+                ++next;
+            }
+            res.push_back(souffle::make_range(iterator(cur, spans.end()), iterator(next, spans.end())));
+            cur = next;
+        }
+        return res;
+    }
+
+    /** Removes all content, turning this set empty. */
+    void clear() {
+        std::unique_lock<std::shared_mutex> guard(access);
+        spans.clear();
+        count = 0;
+    }
+
+    /** Approximates the number of bytes held by this set. */
+    std::size_t getMemoryUsage() const {
+        std::shared_lock<std::shared_mutex> guard(access);
+        // approximate the per-node bookkeeping of the underlying map
+        return sizeof(*this) + spans.size() * (sizeof(std::pair<value_type, value_type>) + 4 * sizeof(void*));
+    }
+
+private:
+    /** Computes the number of values in the closed span [lo,hi] without overflowing. */
+    static std::size_t width(value_type lo, value_type hi) {
+        using unsigned_type = std::make_unsigned_t<value_type>;
+        return static_cast<std::size_t>(
+                       static_cast<unsigned_type>(hi) - static_cast<unsigned_type>(lo)) +
+               1;
+    }
+};
+
+}  // namespace souffle
@@ -0,0 +1,232 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file KdTree.h
+ *
+ * A k-d tree over fixed-arity tuples supporting orthogonal range
+ * queries, i.e. conjunctions of inequality bounds on several
+ * attributes at once.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <shared_mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A k-d tree storing a set of fixed-arity tuples. Each level of the tree
+ * splits on one attribute, cycling through the attributes by depth, so an
+ * orthogonal range query -- a lower and an upper bound tuple constraining
+ * every attribute independently -- can prune whole subtrees on the
+ * splitting attribute. This serves conjunctive inequality patterns such
+ * as interval-overlap joins (s1 <= e2, s2 <= e1), where a single-order
+ * index can only bound one attribute and must filter the rest.
+ *
+ * Within a level, tuples are ordered by the lexicographic comparison that
+ * starts at the splitting attribute and wraps around, so keys are totally
+ * ordered at every node and lookups follow a single root-to-leaf path.
+ * Bulk construction median-splits the input and yields a balanced tree;
+ * incremental insertion appends at the leaves without rebalancing, so a
+ * sorted insertion order degrades lookups towards linear -- bulk-build
+ * from materialized data where possible.
+ *
+ * Following the precedent of the equivalence relation, mutation is
+ * serialized internally by a readers-writer lock so the structure can
+ * back relations filled from parallel rule evaluation.
+ *
+ * @tparam TupleType the stored tuple type, indexable by attribute
+ */
+template <typename TupleType>
+class KdTree {
+    using value_type = typename TupleType::value_type;
+
+    static constexpr std::size_t Arity = std::tuple_size<TupleType>::value;
+
+    static_assert(Arity > 0, "k-d trees are not applicable to nullary relations");
+
+    struct Node {
+        explicit Node(const TupleType& key) : key(key) {}
+
+        TupleType key;
+        Node* left = nullptr;
+        Node* right = nullptr;
+    };
+
+    // the root of the tree, null iff the tree is empty
+    Node* root = nullptr;
+
+    // the number of stored tuples
+    std::size_t count = 0;
+
+    // serializes mutation against lookups and range queries
+    mutable std::shared_mutex access;
+
+public:
+    KdTree() = default;
+
+    /**
+     * Bulk-builds a balanced tree over the given tuples; duplicates are
+     * dropped. Preferable to repeated insertion whenever the data is
+     * already materialized.
+     */
+    explicit KdTree(std::vector<TupleType> data) {
+        std::sort(data.begin(), data.end());
+        data.erase(std::unique(data.begin(), data.end()), data.end());
+        count = data.size();
+        root = build(data.begin(), data.end(), 0);
+    }
+
+    KdTree(const KdTree&) = delete;
+    KdTree& operator=(const KdTree&) = delete;
+
+    ~KdTree() {
+        // iterative teardown -- degenerate trees would overflow the stack
+        // of a recursive destructor
+        std::vector<Node*> todo;
+        if (root != nullptr) {
+            todo.push_back(root);
+        }
+        while (!todo.empty()) {
+            Node* cur = todo.back();
+            todo.pop_back();
+            if (cur->left != nullptr) {
+                todo.push_back(cur->left);
+            }
+            if (cur->right != nullptr) {
+                todo.push_back(cur->right);
+            }
+            delete cur;
+        }
+    }
+
+    /**
+     * Inserts the given tuple, returning true if it was not yet present.
+     */
+    bool insert(const TupleType& key) {
+        std::unique_lock<std::shared_mutex> guard(access);
+        Node** cur = &root;
+        std::size_t depth = 0;
+        while (*cur != nullptr) {
+            if ((*cur)->key == key) {
+                return false;
+            }
+            cur = less(key, (*cur)->key, depth % Arity) ? &(*cur)->left : &(*cur)->right;
+            ++depth;
+        }
+        *cur = new Node(key);
+        ++count;
+        return true;
+    }
+
+    /**
+     * Determines whether the given tuple is a member of this tree.
+     */
+    bool contains(const TupleType& key) const {
+        std::shared_lock<std::shared_mutex> guard(access);
+        const Node* cur = root;
+        std::size_t depth = 0;
+        while (cur != nullptr) {
+            if (cur->key == key) {
+                return true;
+            }
+            cur = less(key, cur->key, depth % Arity) ? cur->left : cur->right;
+            ++depth;
+        }
+        return false;
+    }
+
+    /**
+     * Enumerates all stored tuples t with lower[i] <= t[i] <= upper[i]
+     * for every attribute i, passing each to the given consumer. Subtrees
+     * outside the box on their splitting attribute are pruned.
+     */
+    template <typename Consumer>
+    void rangeQuery(const TupleType& lower, const TupleType& upper, Consumer&& consumer) const {
+        std::shared_lock<std::shared_mutex> guard(access);
+        visit(root, 0, lower, upper, consumer);
+    }
+
+    std::size_t size() const {
+        std::shared_lock<std::shared_mutex> guard(access);
+        return count;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+private:
+    /**
+     * The per-level ordering: lexicographic comparison starting at the
+     * splitting attribute and wrapping around, total over distinct keys.
+     */
+    static bool less(const TupleType& a, const TupleType& b, std::size_t dim) {
+        for (std::size_t i = 0; i < Arity; ++i) {
+            const std::size_t d = (dim + i) % Arity;
+            if (a[d] < b[d]) {
+                return true;
+            }
+            if (b[d] < a[d]) {
+                return false;
+            }
+        }
+        return false;
+    }
+
+    template <typename Iter>
+    static Node* build(Iter begin, Iter end, std::size_t depth) {
+        if (begin == end) {
+            return nullptr;
+        }
+        const std::size_t dim = depth % Arity;
+        Iter mid = begin + (end - begin) / 2;
+        std::nth_element(begin, mid, end,
+                [dim](const TupleType& a, const TupleType& b) { return less(a, b, dim); });
+        Node* res = new Node(*mid);
+        res->left = build(begin, mid, depth + 1);
+        res->right = build(mid + 1, end, depth + 1);
+        return res;
+    }
+
+    template <typename Consumer>
+    static void visit(const Node* cur, std::size_t depth, const TupleType& lower, const TupleType& upper,
+            Consumer& consumer) {
+        if (cur == nullptr) {
+            return;
+        }
+        const std::size_t dim = depth % Arity;
+        // keys equal on the splitting attribute may sit on either side, as
+        // the wrapped comparison breaks the tie on later attributes
+        if (lower[dim] <= cur->key[dim]) {
+            visit(cur->left, depth + 1, lower, upper, consumer);
+        }
+        bool inside = true;
+        for (std::size_t i = 0; i < Arity && inside; ++i) {
+            inside = lower[i] <= cur->key[i] && cur->key[i] <= upper[i];
+        }
+        if (inside) {
+            consumer(cur->key);
+        }
+        if (cur->key[dim] <= upper[dim]) {
+            visit(cur->right, depth + 1, lower, upper, consumer);
+        }
+    }
+};
+
+}  // namespace souffle
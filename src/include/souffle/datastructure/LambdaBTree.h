@@ -35,15 +35,15 @@ namespace detail {
  *
  * @tparam Key             .. the element type to be stored in this tree
  * @tparam Comparator     .. a class defining an order on the stored elements
- * @tparam Allocator     .. utilized for allocating memory for required nodes
+ * @tparam Allocator     .. the strategy utilized for allocating memory for required nodes;
+ *                          either a standard allocator or a node allocation strategy
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
  * @tparam isSet        .. true = set, false = multiset
  * @tparam Functor      .. a std::function that is called on successful (new) insert
  */
-template <typename Key, typename Comparator,
-        typename Allocator,  // is ignored so far - TODO: add support
-        unsigned blockSize, typename SearchStrategy, bool isSet, typename Functor,
+template <typename Key, typename Comparator, typename Allocator, unsigned blockSize,
+        typename SearchStrategy, bool isSet, typename Functor,
         typename WeakComparator = Comparator, typename Updater = detail::updater<Key>>
 class LambdaBTree : public btree<Key, Comparator, Allocator, blockSize, SearchStrategy, isSet, WeakComparator,
                             Updater> {
@@ -83,13 +83,14 @@ public:
             }
 
             // create new node
-            this->leftmost = new typename parenttype::leaf_node();
+            this->leftmost = this->mem.template create<typename parenttype::leaf_node>();
             this->leftmost->numElements = 1;
             // call the functor as we've successfully inserted
             typename Functor::result_type res = f(k);
 
             this->leftmost->keys[0] = k;
             this->root = this->leftmost;
+            this->m_size.fetch_add(1, std::memory_order_relaxed);
 
             // operation complete => we can release the root lock
             this->root_lock.end_write();
@@ -313,8 +314,8 @@ public:
 
                 // split this node
                 auto old_root = this->root;
-                idx -= cur->rebalance_or_split(
-                        const_cast<typename parenttype::node**>(&this->root), this->root_lock, idx, parents);
+                idx -= cur->rebalance_or_split(const_cast<typename parenttype::node**>(&this->root),
+                        this->root_lock, this->mem, idx, parents);
 
                 // release parent lock
                 for (auto it = parents.rbegin(); it != parents.rend(); ++it) {
@@ -354,6 +355,7 @@ public:
             typename Functor::result_type res = f(k);
             cur->keys[idx] = k;
             cur->numElements++;
+            this->m_size.fetch_add(1, std::memory_order_relaxed);
 
             // release lock on current node
             cur->lock.end_write();
@@ -367,12 +369,13 @@ public:
         // special handling for inserting first element
         if (this->empty()) {
             // create new node
-            this->leftmost = new typename parenttype::leaf_node();
+            this->leftmost = this->mem.template create<typename parenttype::leaf_node>();
             this->leftmost->numElements = 1;
             // call the functor as we've successfully inserted
             typename Functor::result_type res = f(k);
             this->leftmost->keys[0] = k;
             this->root = this->leftmost;
+            this->m_size.fetch_add(1, std::memory_order_relaxed);
 
             hints.last_insert.access(this->leftmost);
 
@@ -445,7 +448,7 @@ public:
             if (cur->numElements >= parenttype::node::maxKeys) {
                 // split this node
                 idx -= cur->rebalance_or_split(
-                        const_cast<typename parenttype::node**>(&this->root), this->root_lock, idx);
+                        const_cast<typename parenttype::node**>(&this->root), this->root_lock, this->mem, idx);
 
                 // insert element in right fragment
                 if (((typename parenttype::size_type)idx) > cur->numElements) {
@@ -467,6 +470,7 @@ public:
             // insert new element
             cur->keys[idx] = k;
             cur->numElements++;
+            this->m_size.fetch_add(1, std::memory_order_relaxed);
 
             // remember last insertion position
             hints.last_insert.access(cur);
@@ -514,7 +518,7 @@ public:
         }
 
         // clone content (deep copy)
-        this->root = other.root->clone();
+        this->root = other.root->clone(this->mem);
 
         // update leftmost reference
         auto tmp = this->root;
@@ -565,13 +569,14 @@ public:
  * @tparam Key             .. the element type to be stored in this set
  * @tparam Functor         .. a std::function that is invoked on successful insert
  * @tparam Comparator     .. a class defining an order on the stored elements
- * @tparam Allocator     .. utilized for allocating memory for required nodes
+ * @tparam Allocator     .. the strategy utilized for allocating memory for required nodes;
+ *                          either a standard allocator or a node allocation strategy
  * @tparam blockSize    .. determines the number of bytes/block utilized by leaf nodes
  * @tparam SearchStrategy .. enables switching between linear, binary or any other search strategy
  */
 template <typename Key, typename Functor, typename Comparator = detail::comparator<Key>,
-        typename Allocator = std::allocator<Key>,  // is ignored so far
-        unsigned blockSize = 256, typename SearchStrategy = typename detail::default_strategy<Key>::type>
+        typename Allocator = std::allocator<Key>, unsigned blockSize = 256,
+        typename SearchStrategy = typename detail::default_strategy<Key>::type>
 class LambdaBTreeSet
         : public detail::LambdaBTree<Key, Comparator, Allocator, blockSize, SearchStrategy, true, Functor> {
     using super = detail::LambdaBTree<Key, Comparator, Allocator, blockSize, SearchStrategy, true, Functor>;
@@ -598,12 +603,6 @@ public:
     // A move constructor.
     LambdaBTreeSet(LambdaBTreeSet&& other) : super(std::move(other)) {}
 
-private:
-    // A constructor required by the bulk-load facility.
-    template <typename s, typename n, typename l>
-    LambdaBTreeSet(s size, n* root, l* leftmost) : super::parenttype(size, root, leftmost) {}
-
-public:
     // Support for the assignment operator.
     LambdaBTreeSet& operator=(const LambdaBTreeSet& other) {
         super::operator=(other);
@@ -0,0 +1,225 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MappedTable.h
+ *
+ * A read-only relation representation backed by a memory-mapped file of
+ * tuples stored in index order. Lookups and range scans are served by
+ * binary search directly against the mapping, hence against the page
+ * cache, without parsing or copying the data.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+/**
+ * A sorted, immutable table of fixed-arity tuples backed by a memory-mapped
+ * file. The file is expected to contain tuples of the given arity in
+ * ascending lexicographical order, as produced e.g. by storing a relation
+ * in its primary index order.
+ *
+ * The container offers the lookup subset of the btree interface; it cannot
+ * be modified after construction.
+ *
+ * @tparam Arity .. the number of attributes per tuple
+ */
+template <std::size_t Arity>
+class MappedTable {
+public:
+    using t_tuple = Tuple<RamDomain, Arity>;
+    using iterator = const t_tuple*;
+    using const_iterator = iterator;
+    using chunk = range<iterator>;
+
+    MappedTable() = default;
+
+    /** Creates a table backed by the given file of index-ordered tuples. */
+    explicit MappedTable(const std::string& filename) {
+        open(filename);
+    }
+
+    MappedTable(const MappedTable&) = delete;
+    MappedTable& operator=(const MappedTable&) = delete;
+
+    MappedTable(MappedTable&& other) : data(other.data), numTuples(other.numTuples) {
+#ifndef _WIN32
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        other.mapping = nullptr;
+        other.mappingSize = 0;
+#else
+        buffer = std::move(other.buffer);
+#endif
+        other.data = nullptr;
+        other.numTuples = 0;
+    }
+
+    ~MappedTable() {
+        close();
+    }
+
+    /** Maps the given file into memory and validates its size. */
+    void open(const std::string& filename) {
+        close();
+#ifdef _WIN32
+        // no memory mapping on Windows so far - fall back to a bulk read
+        std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot open tuple file " + filename + "\n");
+        }
+        const std::size_t size = static_cast<std::size_t>(file.tellg());
+        checkSize(filename, size);
+        buffer.resize(size / sizeof(RamDomain));
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(size));
+        data = reinterpret_cast<const t_tuple*>(buffer.data());
+#else
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::invalid_argument("Cannot open tuple file " + filename + "\n");
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::invalid_argument("Cannot stat tuple file " + filename + "\n");
+        }
+        const std::size_t size = static_cast<std::size_t>(info.st_size);
+        checkSize(filename, size);
+        if (size > 0) {
+            mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                ::close(fd);
+                throw std::invalid_argument("Cannot map tuple file " + filename + "\n");
+            }
+            // the mapping is sufficient to keep the pages reachable
+            madvise(mapping, size, MADV_WILLNEED);
+        }
+        ::close(fd);
+        mappingSize = size;
+        data = static_cast<const t_tuple*>(mapping);
+#endif
+        numTuples = size / sizeof(t_tuple);
+    }
+
+    /** Releases the mapping. */
+    void close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (mapping != nullptr) {
+            munmap(mapping, mappingSize);
+            mapping = nullptr;
+            mappingSize = 0;
+        }
+#endif
+        data = nullptr;
+        numTuples = 0;
+    }
+
+    bool empty() const {
+        return numTuples == 0;
+    }
+
+    std::size_t size() const {
+        return numTuples;
+    }
+
+    iterator begin() const {
+        return data;
+    }
+
+    iterator end() const {
+        return data + numTuples;
+    }
+
+    /** Determines whether the given tuple is contained in this table. */
+    bool contains(const t_tuple& t) const {
+        return std::binary_search(begin(), end(), t);
+    }
+
+    /** Locates the given tuple, returning the end iterator if absent. */
+    iterator find(const t_tuple& t) const {
+        auto pos = std::lower_bound(begin(), end(), t);
+        return (pos != end() && *pos == t) ? pos : end();
+    }
+
+    iterator lower_bound(const t_tuple& t) const {
+        return std::lower_bound(begin(), end(), t);
+    }
+
+    iterator upper_bound(const t_tuple& t) const {
+        return std::upper_bound(begin(), end(), t);
+    }
+
+    /** Obtains the range of tuples enclosed by the given bounds. */
+    chunk equalRange(const t_tuple& low, const t_tuple& high) const {
+        return {lower_bound(low), upper_bound(high)};
+    }
+
+    /**
+     * Partitions the table into up to the given number of approximately
+     * equally sized chunks for parallel processing.
+     */
+    std::vector<chunk> partition(std::size_t num) const {
+        std::vector<chunk> res;
+        if (empty()) {
+            return res;
+        }
+        num = std::max<std::size_t>(num, 1);
+        const std::size_t step = std::max<std::size_t>(numTuples / num, 1);
+        for (std::size_t i = 0; i < numTuples; i += step) {
+            res.push_back({data + i, data + std::min(i + step, numTuples)});
+        }
+        return res;
+    }
+
+private:
+    /** Verifies that the file size is a multiple of the tuple size. */
+    static void checkSize(const std::string& filename, const std::size_t size) {
+        if (size % sizeof(t_tuple) != 0) {
+            throw std::invalid_argument(
+                    "Tuple file " + filename + " is not a multiple of the tuple size.\n");
+        }
+    }
+
+    // the tuples of this table, in ascending order
+    const t_tuple* data = nullptr;
+    std::size_t numTuples = 0;
+
+#ifdef _WIN32
+    std::vector<RamDomain> buffer;
+#else
+    void* mapping = nullptr;
+    std::size_t mappingSize = 0;
+#endif
+};
+
+}  // namespace souffle
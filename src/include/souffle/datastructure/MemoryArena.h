@@ -0,0 +1,181 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MemoryArena.h
+ *
+ * A chunk-based memory arena serving as a backing store for node-based
+ * data structures.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/MemoryUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+namespace souffle {
+
+/**
+ * A memory arena handing out storage from a list of successively larger
+ * chunks. Allocations are served by bumping a position counter within the
+ * most recent chunk, placing consecutively allocated objects contiguously
+ * in memory instead of scattering them over the heap. Individual objects
+ * cannot be returned to the arena; instead, all chunks are released
+ * wholesale once the owning data structure is cleared or destroyed.
+ *
+ * Allocations are thread-safe and lock-free, such that concurrent insert
+ * operations of the owning data structure may draw from the same arena.
+ * The pages backing a chunk are physically placed when first touched,
+ * thus the objects of a structure filled by a thread predominantly end
+ * up on the memory node of that thread.
+ *
+ * The release of the chunks does not run any destructors; the arena is
+ * therefore only intended for trivially destructible objects.
+ */
+class MemoryArena {
+    /**
+     * The header of a single chunk; the usable storage follows the
+     * header within the same allocation.
+     */
+    struct Chunk {
+        // the previously filled chunk, forming a list of all chunks
+        Chunk* next;
+
+        // the number of usable bytes within this chunk
+        std::size_t size;
+
+        // the bump position of the next allocation within this chunk
+        std::atomic<std::size_t> used;
+    };
+
+    // the alignment of the handed out storage
+    static constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+    // the size of the chunk header, padded to preserve the alignment
+    static constexpr std::size_t HEADER_SIZE = ((sizeof(Chunk) + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+    // the usable size of the first chunk of an arena
+    static constexpr std::size_t MIN_CHUNK_SIZE = 1 << 12;
+
+    // the usable size chunks grow towards geometrically
+    static constexpr std::size_t MAX_CHUNK_SIZE = 1 << 21;
+
+    // the chunk size limit when huge pages are requested; a chunk needs to
+    // span many huge pages for its aligned interior to cover most of it
+    static constexpr std::size_t MAX_HUGE_CHUNK_SIZE = 1 << 26;
+
+    // the most recently added chunk, serving all current allocations
+    std::atomic<Chunk*> top{nullptr};
+
+public:
+    MemoryArena() = default;
+
+    // arenas maintain exclusive ownership of their chunks
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    // a move constructor taking over the chunks of another arena
+    MemoryArena(MemoryArena&& other) : top(other.top.exchange(nullptr)) {}
+
+    // a move assignment releasing the own chunks and taking over the
+    // chunks of another arena
+    MemoryArena& operator=(MemoryArena&& other) {
+        if (this == &other) {
+            return *this;
+        }
+        release();
+        top.store(other.top.exchange(nullptr));
+        return *this;
+    }
+
+    ~MemoryArena() {
+        release();
+    }
+
+    /**
+     * Obtains a block of storage of the given size from this arena. The
+     * resulting storage is aligned for any scalar type and remains valid
+     * until the next release of this arena.
+     */
+    void* allocate(std::size_t bytes) {
+        // preserve the alignment for subsequent allocations
+        bytes = ((bytes + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+
+        while (true) {
+            // fast path: bump the position within the current chunk
+            Chunk* cur = top.load(std::memory_order_acquire);
+            if (cur != nullptr) {
+                auto pos = cur->used.fetch_add(bytes, std::memory_order_relaxed);
+                if (pos + bytes <= cur->size) {
+                    return data(cur) + pos;
+                }
+            }
+
+            // slow path: the current chunk is exhausted (or missing)
+            // => add a larger chunk and retry the allocation there
+            const std::size_t maxChunkSize = useHugePages() ? MAX_HUGE_CHUNK_SIZE : MAX_CHUNK_SIZE;
+            std::size_t size = (cur != nullptr) ? std::min(cur->size * 2, maxChunkSize) : MIN_CHUNK_SIZE;
+            size = std::max(size, bytes);
+
+            auto* fresh = new (::operator new(HEADER_SIZE + size)) Chunk();
+            fresh->next = cur;
+            fresh->size = size;
+            fresh->used.store(bytes, std::memory_order_relaxed);
+
+            if (top.compare_exchange_strong(cur, fresh, std::memory_order_acq_rel)) {
+                // request huge-page backing before the chunk is first touched
+                adviseHugePages(data(fresh), size);
+                return data(fresh);
+            }
+
+            // another thread installed a new chunk concurrently
+            // => discard the local one and retry there
+            ::operator delete(fresh);
+        }
+    }
+
+    /**
+     * Releases all chunks of this arena wholesale, invalidating all
+     * storage previously handed out. Must not be run concurrently to
+     * any other operation on this arena.
+     */
+    void release() {
+        Chunk* cur = top.exchange(nullptr);
+        while (cur != nullptr) {
+            Chunk* next = cur->next;
+            ::operator delete(cur);
+            cur = next;
+        }
+    }
+
+    /**
+     * Determines the total amount of memory allocated by this arena.
+     */
+    std::size_t getMemoryUsage() const {
+        std::size_t res = sizeof(*this);
+        for (Chunk* cur = top.load(std::memory_order_acquire); cur != nullptr; cur = cur->next) {
+            res += HEADER_SIZE + cur->size;
+        }
+        return res;
+    }
+
+private:
+    /**
+     * Obtains a pointer to the usable storage of the given chunk.
+     */
+    static char* data(Chunk* chunk) {
+        return reinterpret_cast<char*>(chunk) + HEADER_SIZE;
+    }
+};
+
+}  // namespace souffle
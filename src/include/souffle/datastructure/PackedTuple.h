@@ -0,0 +1,165 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file PackedTuple.h
+ *
+ * A fixed-arity tuple storing each attribute in a reduced number of
+ * bits, packing and unpacking at the attribute-access boundary.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+namespace souffle {
+
+/**
+ * A tuple whose attributes occupy a fixed number of bits each instead
+ * of a full RamDomain, concatenated most-significant-first into an
+ * array of words. A relation of enum-like attributes needing 20 bits
+ * apiece packs a ternary tuple into a single word instead of three,
+ * shrinking index nodes and the scanned working set accordingly.
+ *
+ * Attributes are read and written through operator[], which unpacks
+ * and packs at the access boundary; the packed layout never escapes.
+ * Because attributes are laid out most-significant-first, comparing
+ * the words lexicographically coincides with comparing the tuples
+ * attribute by attribute, so the type orders correctly as a key of
+ * the btree and the other index structures without unpacking.
+ *
+ * Stored values must be non-negative and fit the configured width;
+ * this is the caller's obligation, asserted in debug builds.
+ *
+ * @tparam Arity the number of attributes
+ * @tparam Bits  the number of bits per attribute
+ */
+template <std::size_t Arity, std::size_t Bits>
+class PackedTuple {
+    static constexpr std::size_t WordBits = 64;
+    static constexpr std::size_t Words = (Arity * Bits + WordBits - 1) / WordBits;
+
+    static_assert(Arity > 0, "tuples must have at least one attribute");
+    static_assert(Bits > 0 && Bits <= WordBits, "attribute widths must be between 1 and 64 bits");
+
+    // the packed attribute bits; unused trailing bits stay zero so that
+    // word-wise comparison remains a pure attribute comparison
+    std::array<uint64_t, Words> data{};
+
+    static constexpr uint64_t valueMask = (Bits == WordBits) ? ~uint64_t(0) : ((uint64_t(1) << Bits) - 1);
+
+public:
+    using value_type = RamDomain;
+
+    PackedTuple() = default;
+
+    /**
+     * A writable view of a single attribute, packing on assignment.
+     */
+    class reference {
+        PackedTuple& tuple;
+        std::size_t index;
+
+    public:
+        reference(PackedTuple& tuple, std::size_t index) : tuple(tuple), index(index) {}
+
+        reference& operator=(RamDomain value) {
+            tuple.set(index, value);
+            return *this;
+        }
+
+        operator RamDomain() const {
+            return tuple.get(index);
+        }
+    };
+
+    RamDomain operator[](std::size_t index) const {
+        return get(index);
+    }
+
+    reference operator[](std::size_t index) {
+        return reference(*this, index);
+    }
+
+    static constexpr std::size_t size() {
+        return Arity;
+    }
+
+    bool operator==(const PackedTuple& other) const {
+        return data == other.data;
+    }
+
+    bool operator!=(const PackedTuple& other) const {
+        return data != other.data;
+    }
+
+    bool operator<(const PackedTuple& other) const {
+        return data < other.data;
+    }
+
+    bool operator>(const PackedTuple& other) const {
+        return data > other.data;
+    }
+
+    /**
+     * Determines whether the given value is representable within the
+     * configured attribute width.
+     */
+    static bool fits(RamDomain value) {
+        return value >= 0 && (static_cast<uint64_t>(value) & ~valueMask) == 0;
+    }
+
+private:
+    RamDomain get(std::size_t index) const {
+        assert(index < Arity && "index out of bounds");
+        const std::size_t off = index * Bits;
+        const std::size_t word = off / WordBits;
+        const std::size_t lead = off % WordBits;
+        if (lead + Bits <= WordBits) {
+            return static_cast<RamDomain>((data[word] >> (WordBits - lead - Bits)) & valueMask);
+        }
+        // the attribute straddles a word boundary
+        const std::size_t high = WordBits - lead;
+        const std::size_t low = Bits - high;
+        const uint64_t hi = data[word] & ((uint64_t(1) << high) - 1);
+        const uint64_t lo = data[word + 1] >> (WordBits - low);
+        return static_cast<RamDomain>((hi << low) | lo);
+    }
+
+    void set(std::size_t index, RamDomain value) {
+        assert(index < Arity && "index out of bounds");
+        assert(fits(value) && "value exceeds the configured attribute width");
+        const auto bits = static_cast<uint64_t>(value) & valueMask;
+        const std::size_t off = index * Bits;
+        const std::size_t word = off / WordBits;
+        const std::size_t lead = off % WordBits;
+        if (lead + Bits <= WordBits) {
+            const std::size_t shift = WordBits - lead - Bits;
+            data[word] = (data[word] & ~(valueMask << shift)) | (bits << shift);
+            return;
+        }
+        const std::size_t high = WordBits - lead;
+        const std::size_t low = Bits - high;
+        data[word] = (data[word] & ~((uint64_t(1) << high) - 1)) | (bits >> low);
+        data[word + 1] = (data[word + 1] & (~uint64_t(0) >> low)) | (bits << (WordBits - low));
+    }
+};
+
+}  // namespace souffle
+
+namespace std {
+template <std::size_t Arity, std::size_t Bits>
+struct tuple_size<souffle::PackedTuple<Arity, Bits>> : integral_constant<size_t, Arity> {};
+}  // namespace std
@@ -1,12 +1,16 @@
 #pragma once
 
+#include "souffle/utility/MemoryUtil.h"
 #include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
 #include <cstring>
 #include <iostream>
 #include <iterator>
+#include <new>
+#include <type_traits>
 
 #ifdef _WIN32
 /**
@@ -28,6 +32,34 @@ unsigned long __inline __builtin_clzll(unsigned long long value) {
 using std::size_t;
 namespace souffle {
 
+/**
+ * Allocates a block of the given number of elements for the piggy lists
+ * below. Blocks start on a cache-line boundary, so the first elements never
+ * share a line with unrelated allocations, and are advised onto huge pages
+ * when requested. Elements are default-initialised, like with new T[].
+ */
+template <class T>
+T* allocPiggyListBlock(std::size_t elements) {
+    void* mem = ::operator new(
+            elements * sizeof(T), std::align_val_t(hardware_destructive_interference_size));
+    T* block = static_cast<T*>(mem);
+    if constexpr (!std::is_trivially_default_constructible<T>::value) {
+        for (std::size_t i = 0; i < elements; ++i) {
+            ::new (static_cast<void*>(block + i)) T;
+        }
+    }
+    adviseHugePages(block, elements * sizeof(T));
+    return block;
+}
+
+/** Releases a block obtained from allocPiggyListBlock. */
+template <class T>
+void freePiggyListBlock(T* block) {
+    static_assert(std::is_trivially_destructible<T>::value,
+            "blocks are released without running element destructors");
+    ::operator delete(static_cast<void*>(block), std::align_val_t(hardware_destructive_interference_size));
+}
+
 /**
  * A PiggyList that allows insertAt functionality.
  * This means we can't append, as we don't know the next available element.
@@ -52,7 +84,7 @@ public:
                 const std::size_t blockSize = INITIALBLOCKSIZE << i;
 
                 // allocate that in the new container
-                this->blockLookupTable[i].store(new T[blockSize]);
+                this->blockLookupTable[i].store(allocPiggyListBlock<T>(blockSize));
 
                 // then copy the stuff over
                 std::memcpy(this->blockLookupTable[i].load(), other.blockLookupTable[i].load(),
@@ -96,7 +128,7 @@ public:
         if (blockLookupTable[blockNum].load() == nullptr) {
             slock.lock();
             if (blockLookupTable[blockNum].load() == nullptr) {
-                blockLookupTable[blockNum].store(new T[INITIALBLOCKSIZE << blockNum]);
+                blockLookupTable[blockNum].store(allocPiggyListBlock<T>(INITIALBLOCKSIZE << blockNum));
             }
             slock.unlock();
         }
@@ -131,7 +163,7 @@ public:
         slock.lock();
         // delete all - deleting a nullptr is a no-op
         for (std::size_t i = 0; i < maxContainers; ++i) {
-            delete[] blockLookupTable[i].load();
+            freePiggyListBlock(blockLookupTable[i].load());
             // reset the container within to be empty.
             blockLookupTable[i].store(nullptr);
         }
@@ -155,12 +187,13 @@ public:
         // the size of the next container to allocate
         std::size_t cSize = BLOCKSIZE;
         for (std::size_t i = 0; i < other.num_containers; ++i) {
-            this->blockLookupTable[i] = new T[cSize];
+            this->blockLookupTable[i] = allocPiggyListBlock<T>(cSize);
             std::memcpy(this->blockLookupTable[i], other.blockLookupTable[i], cSize * sizeof(T));
             cSize <<= 1;
         }
         // if this isn't the case, uhh
-        assert((cSize >> 1) == container_size.load());
+        // (the blocks sum to BLOCKSIZE * (2^num_containers - 1) elements)
+        assert(cSize - BLOCKSIZE == container_size.load());
     }
 
     /** move constructor */
@@ -194,7 +227,7 @@ public:
             sl.lock();
             // check and add as many containers as required
             while (container_size < new_index + 1) {
-                blockLookupTable[num_containers] = new T[allocsize];
+                blockLookupTable[num_containers] = allocPiggyListBlock<T>(allocsize);
                 num_containers += 1;
                 container_size += allocsize;
                 // double the number elements that will be allocated next time
@@ -215,7 +248,7 @@ public:
             sl.lock();
             // check and add as many containers as required
             while (container_size < new_index + 1) {
-                blockLookupTable[num_containers] = new T[allocsize];
+                blockLookupTable[num_containers] = allocPiggyListBlock<T>(allocsize);
                 num_containers += 1;
                 container_size += allocsize;
                 // double the number elements that will be allocated next time
@@ -254,32 +287,74 @@ public:
 
     class iterator : std::iterator<std::forward_iterator_tag, T> {
         std::size_t cIndex = 0;
-        PiggyList* bl;
+        PiggyList* bl = nullptr;
+
+        // the span of the block holding cIndex, cached so that stepping
+        // through a block is a pointer bump instead of the log2 addressing
+        // of get() per element
+        T* cur = nullptr;
+        T* curEnd = nullptr;
+
+        /**
+         * Caches the span of the block holding cIndex and prefetches the
+         * start of the following block, hiding its first cache miss behind
+         * the remaining work on the current one.
+         */
+        void enterBlock() {
+            const std::size_t count = bl->size();
+            if (cIndex >= count) {
+                cur = curEnd = nullptr;
+                return;
+            }
+            std::size_t nindex = cIndex + bl->BLOCKSIZE;
+            std::size_t blockNum = (63 - __builtin_clzll(nindex));
+            std::size_t blockInd = (nindex) & ((1ul << blockNum) - 1);
+            const std::size_t capacity = 1ul << blockNum;
+            T* base = bl->getBlock(blockNum - bl->BLOCKBITS);
+            cur = base + blockInd;
+            curEnd = base + std::min(capacity, blockInd + (count - cIndex));
+#if defined(__GNUC__) || defined(__clang__)
+            if (cIndex + (capacity - blockInd) < count) {
+                __builtin_prefetch(bl->getBlock(blockNum - bl->BLOCKBITS + 1), 0, 3);
+            }
+#endif
+        }
+
+        void advance() {
+            ++cIndex;
+            if (++cur == curEnd) {
+                enterBlock();
+            }
+        }
 
     public:
         // default ctor, to silence
         iterator() = default;
 
         /* begin iterator for iterating over all elements */
-        iterator(PiggyList* bl) : bl(bl){};
+        iterator(PiggyList* bl) : bl(bl) {
+            enterBlock();
+        };
         /* ender iterator for marking the end of the iteration */
-        iterator(PiggyList* bl, std::size_t beginInd) : cIndex(beginInd), bl(bl){};
+        iterator(PiggyList* bl, std::size_t beginInd) : cIndex(beginInd), bl(bl) {
+            enterBlock();
+        };
 
         T operator*() {
-            return bl->get(cIndex);
+            return *cur;
         };
         const T operator*() const {
-            return bl->get(cIndex);
+            return *cur;
         };
 
         iterator& operator++(int) {
-            ++cIndex;
+            advance();
             return *this;
         };
 
         iterator operator++() {
             iterator ret(*this);
-            ++cIndex;
+            advance();
             return ret;
         };
 
@@ -298,6 +373,34 @@ public:
     iterator end() {
         return iterator(this, size());
     }
+
+    /**
+     * Applies the given function to every stored element, handing whole
+     * blocks to threads: each block is a contiguous array, so a thread
+     * streams through its blocks linearly without the per-element
+     * addressing of the iterator. Must not run concurrently to insertions
+     * and must be called from outside a parallel region.
+     */
+    template <typename F>
+    void forEachParallel(const F& fun) const {
+        const std::size_t count = size();
+        const std::size_t blocks = num_containers.load();
+        PARALLEL_START
+            pfor(std::size_t b = 0; b < blocks; b++) {
+                // block b spans the global indices [start, start + capacity)
+                const std::size_t capacity = BLOCKSIZE << b;
+                const std::size_t start = capacity - BLOCKSIZE;
+                if (start >= count) {
+                    continue;
+                }
+                T* base = blockLookupTable[b];
+                const std::size_t length = std::min(capacity, count - start);
+                for (std::size_t i = 0; i < length; ++i) {
+                    fun(base[i]);
+                }
+            }
+        PARALLEL_END
+    }
     const std::size_t BLOCKBITS = 16ul;
     const std::size_t BLOCKSIZE = (1ul << BLOCKBITS);
 
@@ -321,7 +424,7 @@ public:
         sl.lock();
         // we don't know which ones are taken up!
         for (std::size_t i = 0; i < num_containers; ++i) {
-            delete[] blockLookupTable[i];
+            freePiggyListBlock(blockLookupTable[i]);
         }
         sl.unlock();
     }
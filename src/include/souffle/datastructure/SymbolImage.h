@@ -0,0 +1,292 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SymbolImage.h
+ *
+ * A read-only symbol dictionary backed by a memory-mapped file. The image
+ * carries the symbols in lexicographic order together with a pre-computed
+ * hash table, so attaching it is a constant-time operation and concurrent
+ * runs share the backing pages through the page cache.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+// no memory mapping on Windows so far - the fallback reads the file
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace souffle {
+
+/**
+ * An immutable dictionary of symbols backed by a memory-mapped image file.
+ *
+ * The image stores its symbols in lexicographic order, so the index of a
+ * symbol doubles as its collation key, and embeds an open-addressing hash
+ * table over the symbol bytes, so lookups probe the mapping directly
+ * without materializing any strings. The format is tied to the producing
+ * architecture; images are not meant to be moved between platforms.
+ *
+ * Layout, in 64-bit words: a magic tag, the symbol count n, the slot count
+ * s, n+1 byte offsets into the character data, s hash slots holding a
+ * symbol index incremented by one (zero marks an empty slot), followed by
+ * the concatenated character data of all symbols.
+ */
+class SymbolImage {
+public:
+    /// Value returned by find for symbols not contained in the image.
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    SymbolImage() = default;
+
+    /** Creates a dictionary backed by the given image file. */
+    explicit SymbolImage(const std::string& filename) {
+        open(filename);
+    }
+
+    SymbolImage(const SymbolImage&) = delete;
+    SymbolImage& operator=(const SymbolImage&) = delete;
+
+    SymbolImage(SymbolImage&& other)
+            : words(other.words), chars(other.chars), count(other.count), mask(other.mask) {
+#ifdef _WIN32
+        buffer = std::move(other.buffer);
+#else
+        mapping = other.mapping;
+        mappingSize = other.mappingSize;
+        other.mapping = nullptr;
+        other.mappingSize = 0;
+#endif
+        other.words = nullptr;
+        other.chars = nullptr;
+        other.count = 0;
+        other.mask = 0;
+    }
+
+    ~SymbolImage() {
+        close();
+    }
+
+    /**
+     * Writes the given symbols into an image file. The symbols are sorted
+     * and de-duplicated; their position in the sorted sequence becomes
+     * their index within the image.
+     */
+    static void write(std::vector<std::string> symbols, const std::string& filename) {
+        std::sort(symbols.begin(), symbols.end());
+        symbols.erase(std::unique(symbols.begin(), symbols.end()), symbols.end());
+
+        const std::uint64_t n = symbols.size();
+        std::uint64_t slots = 16;
+        while (slots < 2 * n) {
+            slots <<= 1;
+        }
+
+        // offsets into the character data, one past-the-end entry included
+        std::vector<std::uint64_t> offsets(n + 1, 0);
+        for (std::uint64_t i = 0; i < n; i++) {
+            offsets[i + 1] = offsets[i] + symbols[i].size();
+        }
+
+        // hash table with linear probing; slots hold the symbol index + 1
+        std::vector<std::uint64_t> table(slots, 0);
+        for (std::uint64_t i = 0; i < n; i++) {
+            std::uint64_t pos = hash(symbols[i]) & (slots - 1);
+            while (table[pos] != 0) {
+                pos = (pos + 1) & (slots - 1);
+            }
+            table[pos] = i + 1;
+        }
+
+        std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot create symbol image " + filename + "\n");
+        }
+        auto emit = [&](const std::uint64_t word) {
+            file.write(reinterpret_cast<const char*>(&word), sizeof(word));
+        };
+        emit(MAGIC);
+        emit(n);
+        emit(slots);
+        for (const std::uint64_t offset : offsets) {
+            emit(offset);
+        }
+        for (const std::uint64_t slot : table) {
+            emit(slot);
+        }
+        for (const std::string& symbol : symbols) {
+            file.write(symbol.data(), static_cast<std::streamsize>(symbol.size()));
+        }
+        if (!file) {
+            throw std::invalid_argument("Cannot write symbol image " + filename + "\n");
+        }
+    }
+
+    /** Maps the given image file into memory and validates its header. */
+    void open(const std::string& filename) {
+        close();
+        std::size_t size = 0;
+#ifdef _WIN32
+        // no memory mapping on Windows so far - fall back to a bulk read
+        std::ifstream file(filename, std::ios::in | std::ios::binary | std::ios::ate);
+        if (!file.is_open()) {
+            throw std::invalid_argument("Cannot open symbol image " + filename + "\n");
+        }
+        size = static_cast<std::size_t>(file.tellg());
+        buffer.resize(size);
+        file.seekg(0);
+        file.read(buffer.data(), static_cast<std::streamsize>(size));
+        const char* base = buffer.data();
+#else
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::invalid_argument("Cannot open symbol image " + filename + "\n");
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            throw std::invalid_argument("Cannot stat symbol image " + filename + "\n");
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        if (size > 0) {
+            mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+                ::close(fd);
+                throw std::invalid_argument("Cannot map symbol image " + filename + "\n");
+            }
+        }
+        ::close(fd);
+        mappingSize = size;
+        const char* base = static_cast<const char*>(mapping);
+#endif
+        if (size < 3 * sizeof(std::uint64_t)) {
+            close();
+            throw std::invalid_argument("Symbol image " + filename + " is truncated.\n");
+        }
+        words = reinterpret_cast<const std::uint64_t*>(base);
+        if (words[0] != MAGIC) {
+            close();
+            throw std::invalid_argument("File " + filename + " is not a symbol image.\n");
+        }
+        count = words[1];
+        const std::uint64_t slots = words[2];
+        mask = slots - 1;
+        const std::size_t headerWords = 3 + (count + 1) + slots;
+        if (size < headerWords * sizeof(std::uint64_t) ||
+                size - headerWords * sizeof(std::uint64_t) < offsets()[count]) {
+            close();
+            throw std::invalid_argument("Symbol image " + filename + " is truncated.\n");
+        }
+        chars = base + headerWords * sizeof(std::uint64_t);
+    }
+
+    /** Releases the mapping. */
+    void close() {
+#ifdef _WIN32
+        buffer.clear();
+#else
+        if (mapping != nullptr) {
+            munmap(mapping, mappingSize);
+            mapping = nullptr;
+            mappingSize = 0;
+        }
+#endif
+        words = nullptr;
+        chars = nullptr;
+        count = 0;
+        mask = 0;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    /** The number of symbols in this image. */
+    std::size_t size() const {
+        return count;
+    }
+
+    /** Obtains a view of the symbol with the given index. */
+    std::string_view get(const std::size_t index) const {
+        const std::uint64_t* offs = offsets();
+        return {chars + offs[index], static_cast<std::size_t>(offs[index + 1] - offs[index])};
+    }
+
+    /** Locates the given symbol, returning npos if it is not contained. */
+    std::size_t find(const std::string_view symbol) const {
+        if (count == 0) {
+            return npos;
+        }
+        const std::uint64_t* table = slots();
+        std::uint64_t pos = hash(symbol) & mask;
+        while (table[pos] != 0) {
+            const std::size_t index = table[pos] - 1;
+            if (get(index) == symbol) {
+                return index;
+            }
+            pos = (pos + 1) & mask;
+        }
+        return npos;
+    }
+
+private:
+    // tag identifying symbol image files ("SFLSYMS1")
+    static constexpr std::uint64_t MAGIC = 0x31534d59534c4653ull;
+
+    /**
+     * FNV-1a over the symbol bytes; the hash is part of the file format and
+     * must not depend on the process, unlike std::hash.
+     */
+    static std::uint64_t hash(const std::string_view symbol) {
+        std::uint64_t h = 14695981039346656037ull;
+        for (const char c : symbol) {
+            h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+        }
+        return h;
+    }
+
+    const std::uint64_t* offsets() const {
+        return words + 3;
+    }
+
+    const std::uint64_t* slots() const {
+        return words + 3 + (count + 1);
+    }
+
+    // the header words and character data of this image
+    const std::uint64_t* words = nullptr;
+    const char* chars = nullptr;
+    std::uint64_t count = 0;
+    std::uint64_t mask = 0;
+
+#ifdef _WIN32
+    std::vector<char> buffer;
+#else
+    void* mapping = nullptr;
+    std::size_t mappingSize = 0;
+#endif
+};
+
+}  // namespace souffle
@@ -102,6 +102,15 @@ public:
         return count;
     }
 
+    /**
+     * Approximates the number of bytes used by this table, derived from the
+     * element counter in constant time.
+     */
+    std::size_t getMemoryUsage() const {
+        const std::size_t blocks = (count + blockSize - 1) / blockSize;
+        return sizeof(*this) + blocks * sizeof(Block);
+    }
+
     const T& insert(const T& element) {
         // check whether the head is initialized
         if (!head) {
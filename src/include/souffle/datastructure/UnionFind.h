@@ -19,11 +19,13 @@
 #include "souffle/datastructure/LambdaBTree.h"
 #include "souffle/datastructure/PiggyList.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <utility>
+#include <vector>
 
 namespace souffle {
 
@@ -105,6 +107,22 @@ public:
         return x;
     }
 
+    /**
+     * Find the highest ancestor of the provided node without path compression
+     * Used by the bulk union kernel, which defers flattening to a dedicated
+     * compress phase rather than issuing CAS traffic against hot roots
+     * @param x the node to find the root of
+     * @return The root of x
+     */
+    parent_t findRoot(parent_t x) const {
+        parent_t px = b2p(get(x));
+        while (x != px) {
+            x = px;
+            px = b2p(get(x));
+        }
+        return x;
+    }
+
 private:
     /**
      * Update the root of the tree of which x is, to have y as the base instead
@@ -186,6 +204,55 @@ public:
         }
     }
 
+    /**
+     * Union a large batch of node pairs via a parallel hook-and-compress kernel
+     * The hook phase splices the set-trees together without compressing paths,
+     * so concurrent workers do not serialise on read-side CAS traffic against
+     * hot roots; the compress phase then pointer-jumps every node directly onto
+     * its root. Ranks are immutable for the duration of the batch, hence every
+     * hook goes strictly upwards in (rank, node) order and no cycle can form;
+     * after compression every tree has depth one, so skipping the rank bump
+     * does not hurt the union-by-rank heuristic of the incremental path.
+     * @param pairs the batch of node pairs to union
+     */
+    void unionAll(const std::vector<std::pair<parent_t, parent_t>>& pairs) {
+        PARALLEL_START
+        // hook phase
+        pfor(std::size_t i = 0; i < pairs.size(); ++i) {
+            parent_t x = pairs[i].first;
+            parent_t y = pairs[i].second;
+            while (true) {
+                x = findRoot(x);
+                y = findRoot(y);
+
+                // no need to hook if both already in same set
+                if (x == y) break;
+
+                rank_t xrank = b2r(get(x));
+                rank_t yrank = b2r(get(y));
+
+                // hook in the same order as unionNodes (better rank or earlier & equal node wins)
+                if (xrank > yrank || ((xrank == yrank) && x > y)) {
+                    std::swap(x, y);
+                    std::swap(xrank, yrank);
+                }
+                if (updateRoot(x, xrank, y, yrank)) break;
+            }
+        }
+        // compress phase - each node is written by exactly one worker, and
+        // concurrent compressions only ever move a parent onto an ancestor,
+        // so root lookups stay valid throughout
+        const std::size_t numNodes = size();
+        pfor(std::size_t i = 0; i < numNodes; ++i) {
+            const block_t state = get(i);
+            const parent_t root = findRoot(b2p(state));
+            if (b2p(state) != root) {
+                get(i).store(pr2b(root, b2r(state)));
+            }
+        }
+        PARALLEL_END
+    }
+
     /**
      * Create a node with its parent as itself, rank 0
      * @return the newly created block
@@ -323,6 +390,23 @@ public:
         ds.unionNodes(toDense(x), toDense(y));
     };
 
+    /**
+     * Union a batch of sparse pairs via the parallel hook-and-compress kernel,
+     * adding any elements not already present
+     * The batch is densified up front (the sparse map supports concurrent
+     * inserts) before being handed to the underlying bulk kernel
+     * @param pairs the batch of sparse pairs to union
+     */
+    void unionAll(const std::vector<std::pair<SparseDomain, SparseDomain>>& pairs) {
+        std::vector<std::pair<parent_t, parent_t>> densePairs(pairs.size());
+        PARALLEL_START
+        pfor(std::size_t i = 0; i < pairs.size(); ++i) {
+            densePairs[i] = {toDense(pairs[i].first), toDense(pairs[i].second)};
+        }
+        PARALLEL_END
+        ds.unionAll(densePairs);
+    }
+
     inline std::size_t size() {
         return ds.size();
     };
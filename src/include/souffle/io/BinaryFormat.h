@@ -0,0 +1,63 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BinaryFormat.h
+ *
+ * Constants shared by the binary fact file reader and writer.
+ *
+ * A binary fact file consists of a fixed-size header, a symbol segment
+ * and a column segment:
+ *
+ *   header:  magic number     (uint64_t)
+ *            format version   (uint32_t)
+ *            domain width     (uint32_t, sizeof(RamDomain))
+ *            arity            (uint32_t)
+ *            tuple count      (uint64_t)
+ *            symbol count     (uint64_t)
+ *   symbols: symbol-count entries of (uint32_t length, raw bytes)
+ *   columns: arity columns of tuple-count RamDomain values each
+ *
+ * Symbol attributes are stored as indices into the symbol segment, making
+ * files independent of the symbol table of the producing run. All values
+ * are stored in native byte order; files are not portable across machines
+ * of different endianness or domain size.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace souffle {
+
+namespace binaryformat {
+
+/** The magic number identifying binary fact files ("SOUFFLEB"). */
+constexpr uint64_t magicNumber = 0x42454c4646554f53ull;
+
+/** The version of the binary fact file layout. */
+constexpr uint32_t formatVersion = 1;
+
+/** The magic number identifying CSV sidecar cache files ("SOUFFLEC").
+ *
+ * A sidecar cache is written next to a CSV fact file after a successful
+ * parse and replaces the parse on subsequent runs. It carries the size and
+ * modification time of the source file and a hash of the parse-affecting
+ * directive options; a mismatch on any of them invalidates the cache. The
+ * segments follow the binary fact format, except that tuples are stored
+ * row-major. */
+constexpr uint64_t sidecarMagicNumber = 0x43454c4646554f53ull;
+
+/** The version of the sidecar cache file layout. */
+constexpr uint32_t sidecarFormatVersion = 1;
+
+}  // namespace binaryformat
+
+}  // namespace souffle
@@ -18,9 +18,11 @@
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/io/ReadStream.h"
+#include "souffle/io/ReadStreamBinary.h"
 #include "souffle/io/ReadStreamCSV.h"
 #include "souffle/io/ReadStreamJSON.h"
 #include "souffle/io/WriteStream.h"
+#include "souffle/io/WriteStreamBinary.h"
 #include "souffle/io/WriteStreamCSV.h"
 #include "souffle/io/WriteStreamJSON.h"
 
@@ -29,6 +31,11 @@
 #include "souffle/io/WriteStreamSQLite.h"
 #endif
 
+#ifdef USE_PARQUET
+#include "souffle/io/ReadStreamParquet.h"
+#include "souffle/io/WriteStreamParquet.h"
+#endif
+
 #include <map>
 #include <memory>
 #include <stdexcept>
@@ -81,14 +88,20 @@ private:
         registerReadStreamFactory(std::make_shared<ReadCinCSVFactory>());
         registerReadStreamFactory(std::make_shared<ReadFileJSONFactory>());
         registerReadStreamFactory(std::make_shared<ReadCinJSONFactory>());
+        registerReadStreamFactory(std::make_shared<ReadBinaryFactory>());
         registerWriteStreamFactory(std::make_shared<WriteFileCSVFactory>());
         registerWriteStreamFactory(std::make_shared<WriteCoutCSVFactory>());
         registerWriteStreamFactory(std::make_shared<WriteCoutPrintSizeFactory>());
         registerWriteStreamFactory(std::make_shared<WriteFileJSONFactory>());
         registerWriteStreamFactory(std::make_shared<WriteCoutJSONFactory>());
+        registerWriteStreamFactory(std::make_shared<WriteBinaryFactory>());
 #ifdef USE_SQLITE
         registerReadStreamFactory(std::make_shared<ReadSQLiteFactory>());
         registerWriteStreamFactory(std::make_shared<WriteSQLiteFactory>());
+#endif
+#ifdef USE_PARQUET
+        registerReadStreamFactory(std::make_shared<ReadParquetFactory>());
+        registerWriteStreamFactory(std::make_shared<WriteParquetFactory>());
 #endif
     };
     std::map<std::string, std::shared_ptr<WriteStreamFactory>> outputFactories;
@@ -22,13 +22,16 @@
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/json11.h"
+#include <algorithm>
 #include <cctype>
 #include <cstddef>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace souffle {
@@ -37,18 +40,144 @@ class ReadStream : public SerialisationStream<false> {
 protected:
     ReadStream(
             const std::map<std::string, std::string>& rwOperation, SymbolTable& symTab, RecordTable& recTab)
-            : SerialisationStream(symTab, recTab, rwOperation) {}
+            : SerialisationStream(symTab, recTab, rwOperation),
+              presorted(getOr(rwOperation, "presorted", "false") == std::string("true")),
+              sampleSize(RamUnsignedFromString(getOr(rwOperation, "sample", "0"))) {}
+
+    /**
+     * A type trait determining whether a relation type supports the bulk
+     * insertion of an ordered sequence of raw tuples.
+     */
+    template <typename T, typename = void>
+    struct has_insert_sorted : std::false_type {};
+
+    template <typename T>
+    struct has_insert_sorted<T, std::void_t<decltype(std::declval<T&>().insertSorted(
+                                        std::declval<const RamDomain*>(), std::declval<std::size_t>()))>>
+            : std::true_type {};
 
 public:
     template <typename T>
     void readAll(T& relation) {
-        while (const auto next = readNextTuple()) {
-            const RamDomain* ramDomain = next.get();
-            relation.insert(ramDomain);
+        const std::size_t rowSize = typeAttributes.size();
+
+        // nullary relations have no parsing cost worth batching
+        if (rowSize == 0) {
+            while (const auto next = readNextTuple()) {
+                relation.insert(next.get());
+            }
+            return;
+        }
+
+        // a calibration run draws a uniform random sample of the input
+        // instead of loading it in full
+        if (sampleSize > 0) {
+            readAllSampled(relation);
+            return;
+        }
+
+        // use the bulk-load fast path if the input is known to be ordered
+        // according to the primary index of the target relation; relations
+        // without a sorted bulk insertion take the regular streaming path,
+        // which an ordered input cannot improve on
+        if constexpr (has_insert_sorted<T>::value) {
+            if (presorted) {
+                readAllSorted(relation);
+                return;
+            }
+        }
+
+        // pull batches of tuples from the stream, enabling stream
+        // implementations to parse the members of a batch in parallel
+        std::vector<RamDomain> buffer;
+        while (true) {
+            buffer.clear();
+            const std::size_t rows = readNextBatch(buffer, batchRows);
+            for (std::size_t i = 0; i < rows; ++i) {
+                relation.insert(&buffer[i * rowSize]);
+            }
+            if (rows < batchRows) {
+                break;
+            }
         }
     }
 
 protected:
+    // the number of tuples requested per batch from the underlying stream
+    static constexpr std::size_t batchRows = 16384;
+
+    /**
+     * Reads up to the given number of tuples into the given row-major buffer,
+     * appending to its current content, and returns the number of tuples read.
+     * The default implementation falls back to tuple-by-tuple reading; stream
+     * implementations may override it to parse the batch in parallel.
+     */
+    virtual std::size_t readNextBatch(std::vector<RamDomain>& buffer, std::size_t maxRows) {
+        std::size_t rows = 0;
+        while (rows < maxRows) {
+            const auto next = readNextTuple();
+            if (!next) {
+                break;
+            }
+            buffer.insert(buffer.end(), next.get(), next.get() + typeAttributes.size());
+            ++rows;
+        }
+        return rows;
+    }
+
+    /**
+     * Reads the full input into a buffer and hands it over to the relation's
+     * ordered bulk insertion as one row-major block.
+     */
+    template <typename T>
+    void readAllSorted(T& relation) {
+        const std::size_t rowSize = typeAttributes.size();
+        std::vector<RamDomain> buffer;
+        while (readNextBatch(buffer, batchRows) == batchRows) {
+        }
+        relation.insertSorted(buffer.data(), buffer.size() / rowSize);
+    }
+    /**
+     * Reads the full input but retains only a uniform random sample of at
+     * most the configured number of tuples, using reservoir sampling: the
+     * first tuples fill the reservoir, and each later tuple replaces a
+     * random reservoir slot with probability sample-size / tuples-seen.
+     * The generator is seeded with a fixed value so that repeated runs over
+     * the same input draw the same sample.
+     */
+    template <typename T>
+    void readAllSampled(T& relation) {
+        const std::size_t rowSize = typeAttributes.size();
+        std::vector<RamDomain> reservoir;
+        reservoir.reserve(sampleSize * rowSize);
+        std::mt19937_64 generator(sampleSize);
+        std::size_t seen = 0;
+        std::vector<RamDomain> buffer;
+        while (true) {
+            buffer.clear();
+            const std::size_t rows = readNextBatch(buffer, batchRows);
+            for (std::size_t i = 0; i < rows; ++i) {
+                const RamDomain* tuple = &buffer[i * rowSize];
+                ++seen;
+                if (seen <= sampleSize) {
+                    reservoir.insert(reservoir.end(), tuple, tuple + rowSize);
+                    continue;
+                }
+                const std::size_t slot =
+                        std::uniform_int_distribution<std::size_t>(0, seen - 1)(generator);
+                if (slot < sampleSize) {
+                    std::copy(tuple, tuple + rowSize, &reservoir[slot * rowSize]);
+                }
+            }
+            if (rows < batchRows) {
+                break;
+            }
+        }
+        for (std::size_t i = 0; i < reservoir.size(); i += rowSize) {
+            relation.insert(&reservoir[i]);
+        }
+    }
+
     /**
      * Read a record from a string.
      *
@@ -381,6 +510,12 @@ protected:
     }
 
     virtual Own<RamDomain[]> readNextTuple() = 0;
+
+    /** A flag indicating that the input is ordered by the primary index of the target relation. */
+    const bool presorted;
+
+    /** The maximum number of tuples retained by a sampled load; zero loads the input in full. */
+    const std::size_t sampleSize;
 };
 
 class ReadStreamFactory {
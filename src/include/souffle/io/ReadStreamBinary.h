@@ -0,0 +1,183 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReadStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/io/ReadStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A read stream deserialising a relation from the native binary columnar
+ * fact format (see BinaryFormat.h). Loading reduces to bulk reads of the
+ * fixed-width column segment; only the distinct symbols of the symbol
+ * segment have to be interned into the symbol table.
+ */
+class ReadStreamBinary : public ReadStream {
+public:
+    ReadStreamBinary(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable)
+            : ReadStream(rwOperation, symbolTable, recordTable),
+              baseName(souffle::baseName(getFileName(rwOperation))),
+              file(getFileName(rwOperation), std::ios::in | std::ios::binary) {
+        if (!file.is_open()) {
+            // suppress error message in case file cannot be open when flag -w is set
+            if (getOr(rwOperation, "no-warn", "false") != "true") {
+                throw std::invalid_argument("Cannot open fact file " + baseName + "\n");
+            }
+            return;
+        }
+        readFile();
+    }
+
+protected:
+    Own<RamDomain[]> readNextTuple() override {
+        if (nextRow >= tupleCount) {
+            return nullptr;
+        }
+        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+        for (std::size_t i = 0; i < arity; ++i) {
+            tuple[i] = columns[i][nextRow];
+        }
+        ++nextRow;
+        return tuple;
+    }
+
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer, std::size_t maxRows) override {
+        const std::size_t rowSize = typeAttributes.size();
+        const std::size_t rows = std::min(maxRows, tupleCount - nextRow);
+
+        // transpose the requested chunk of the column segment
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + rows * rowSize);
+        for (std::size_t i = 0; i < arity; ++i) {
+            const RamDomain* column = &columns[i][nextRow];
+            for (std::size_t row = 0; row < rows; ++row) {
+                buffer[offset + row * rowSize + i] = column[row];
+            }
+        }
+
+        nextRow += rows;
+        return rows;
+    }
+
+private:
+    /** Reads header, symbol segment and column segment of the file. */
+    void readFile() {
+        if (readValue<uint64_t>() != binaryformat::magicNumber) {
+            throw std::invalid_argument("Fact file " + baseName + " is not a binary fact file.\n");
+        }
+        if (readValue<uint32_t>() != binaryformat::formatVersion) {
+            throw std::invalid_argument("Fact file " + baseName + " has an unsupported format version.\n");
+        }
+        if (readValue<uint32_t>() != sizeof(RamDomain)) {
+            throw std::invalid_argument("Fact file " + baseName + " has an incompatible domain size.\n");
+        }
+        if (readValue<uint32_t>() != arity) {
+            throw std::invalid_argument("Fact file " + baseName + " has a mismatching arity.\n");
+        }
+        tupleCount = readValue<uint64_t>();
+        const uint64_t symbolCount = readValue<uint64_t>();
+
+        // intern the symbol segment, mapping file-local to symbol-table indices
+        std::vector<RamDomain> symbolIndex(symbolCount);
+        std::string text;
+        for (uint64_t i = 0; i < symbolCount; ++i) {
+            text.resize(readValue<uint32_t>());
+            file.read(text.data(), static_cast<std::streamsize>(text.size()));
+            symbolIndex[i] = symbolTable.encode(text);
+        }
+
+        // bulk-read the column segment
+        columns.resize(arity);
+        for (std::size_t i = 0; i < arity; ++i) {
+            columns[i].resize(tupleCount);
+            file.read(reinterpret_cast<char*>(columns[i].data()),
+                    static_cast<std::streamsize>(tupleCount * sizeof(RamDomain)));
+
+            // translate symbol attributes to symbol-table indices
+            if (typeAttributes.at(i)[0] == 's') {
+                for (RamDomain& value : columns[i]) {
+                    value = symbolIndex.at(value);
+                }
+            }
+        }
+
+        if (!file) {
+            throw std::invalid_argument("Fact file " + baseName + " is truncated.\n");
+        }
+    }
+
+    template <typename T>
+    T readValue() {
+        T value{};
+        file.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].facts.bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return input filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".facts.bin");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "fact-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    std::string baseName;
+    std::ifstream file;
+
+    // the relation content in columnar layout
+    std::vector<std::vector<RamDomain>> columns;
+
+    std::size_t tupleCount = 0;
+    std::size_t nextRow = 0;
+};
+
+class ReadBinaryFactory : public ReadStreamFactory {
+public:
+    Own<ReadStream> getReader(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable) override {
+        return mk<ReadStreamBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+    ~ReadBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
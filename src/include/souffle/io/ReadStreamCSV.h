@@ -17,6 +17,7 @@
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
 #include "souffle/io/ReadStream.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
@@ -24,20 +25,28 @@
 
 #ifdef USE_LIBZ
 #include "souffle/io/gzfstream.h"
-#else
-#include <fstream>
 #endif
+#ifdef USE_LIBZSTD
+#include "souffle/io/zstdfstream.h"
+#endif
+#ifdef USE_LIBLZ4
+#include "souffle/io/lz4fstream.h"
+#endif
+#include <fstream>
 
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace souffle {
@@ -49,7 +58,8 @@ public:
             : ReadStream(rwOperation, symbolTable, recordTable),
               rfc4180(getOr(rwOperation, "rfc4180", "false") == std::string("true")),
               delimiter(getOr(rwOperation, "delimiter", (rfc4180 ? "," : "\t"))), file(file), lineNumber(0),
-              inputMap(getInputColumnMap(rwOperation, static_cast<unsigned int>(arity))) {
+              inputMap(getInputColumnMap(rwOperation, static_cast<unsigned int>(arity))),
+              deadColumns(getDeadColumns(rwOperation)), filters(getConstantFilters(rwOperation)) {
         if (rfc4180 && delimiter.find('"') != std::string::npos) {
             std::stringstream errorMessage;
             errorMessage << "CSV delimiter cannot contain '\"' character when rfc4180 is enabled.";
@@ -70,35 +80,61 @@ protected:
      * @return
      */
     Own<RamDomain[]> readNextTuple() override {
-        if (file.eof()) {
-            return nullptr;
-        }
         std::string line;
         Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
 
-        if (!getline(file, line)) {
-            return nullptr;
-        }
-        // Handle Windows line endings on non-Windows systems
-        if (!line.empty() && line.back() == '\r') {
-            line = line.substr(0, line.length() - 1);
+        while (true) {
+            if (file.eof() || !getline(file, line)) {
+                return nullptr;
+            }
+            // Handle Windows line endings on non-Windows systems
+            if (!line.empty() && line.back() == '\r') {
+                line = line.substr(0, line.length() - 1);
+            }
+            ++lineNumber;
+
+            if (parseTuple(line, tuple.get(), lineNumber)) {
+                return tuple;
+            }
+            // row dropped by a pushed-down constant filter; read on
         }
-        ++lineNumber;
+    }
 
+    /**
+     * Parses a single input line into the given tuple storage, returning
+     * false when the row is dropped by a pushed-down constant filter. The
+     * line number is only used for error reporting, allowing lines of a batch
+     * to be parsed concurrently and out of order.
+     */
+    bool parseTuple(const std::string& line, RamDomain* tuple, const std::size_t lineNumber) {
         std::size_t start = 0;
         std::size_t columnsFilled = 0;
         for (uint32_t column = 0; columnsFilled < arity; column++) {
             std::size_t charactersRead = 0;
-            std::string element = nextElement(line, start);
+            std::string element = nextElement(line, start, lineNumber);
             if (inputMap.count(column) == 0) {
                 continue;
             }
             ++columnsFilled;
 
+            // dead field: scanned past at the delimiter level, but never
+            // converted, validated or interned
+            if (!deadColumns.empty() && deadColumns[inputMap[column]]) {
+                tuple[inputMap[column]] = 0;
+                continue;
+            }
+
+            const ConstantFilter* filter = filterFor(inputMap[column]);
+
             try {
                 auto&& ty = typeAttributes.at(inputMap[column]);
                 switch (ty[0]) {
                     case 's': {
+                        // compare the raw text so non-matching symbols are
+                        // dropped without touching the symbol table
+                        if (filter != nullptr && element != filter->symbol) {
+                            return false;
+                        }
                         tuple[inputMap[column]] = symbolTable.encode(element);
                         charactersRead = element.size();
                         break;
@@ -136,9 +172,97 @@ protected:
                              << lineNumber << "; ";
                 throw std::invalid_argument(errorMessage.str());
             }
+
+            if (filter != nullptr && filter->kind != 's' && tuple[inputMap[column]] != filter->numeric) {
+                return false;
+            }
         }
+        return true;
+    }
+
+    /**
+     * Reads a batch of lines from the input stream on the calling thread and
+     * parses them in parallel. Parsing is the dominating cost of the CSV load
+     * phase; the symbol and record tables support concurrent insertion, hence
+     * the lines of a batch can be converted independently. Rows dropped by a
+     * pushed-down constant filter are compacted out of the batch, and more
+     * lines are gathered until the batch is full or the input is exhausted.
+     */
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer, std::size_t maxRows) override {
+        const std::size_t rowSize = typeAttributes.size();
+        std::size_t kept = 0;
+        std::vector<std::string> lines;
+        std::vector<char> keep;
+
+        while (kept < maxRows) {
+            // gather a block of input lines on the reading thread
+            const std::size_t want = maxRows - kept;
+            lines.clear();
+            lines.reserve(want);
+            std::string line;
+            while (lines.size() < want && getline(file, line)) {
+                // Handle Windows line endings on non-Windows systems
+                if (!line.empty() && line.back() == '\r') {
+                    line.resize(line.length() - 1);
+                }
+                ++lineNumber;
+                lines.push_back(std::move(line));
+            }
+            if (lines.empty()) {
+                break;
+            }
+
+            const std::size_t firstLine = lineNumber - lines.size() + 1;
+            const std::size_t offset = buffer.size();
+            buffer.resize(offset + lines.size() * rowSize);
+            keep.assign(lines.size(), 1);
+
+            // parse the gathered lines in parallel; the first parse error is
+            // re-thrown on the calling thread once the batch is complete
+            std::exception_ptr error = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 64)
+#endif
+            for (std::int64_t i = 0; i < static_cast<std::int64_t>(lines.size()); ++i) {
+                try {
+                    if (!parseTuple(lines[i], &buffer[offset + i * rowSize], firstLine + i)) {
+                        keep[i] = 0;
+                    }
+                } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(souffle_csv_batch_error)
+#endif
+                    {
+                        if (error == nullptr) {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+            }
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
 
-        return tuple;
+            // compact the dropped rows out of the batch
+            std::size_t out = 0;
+            for (std::size_t i = 0; i < lines.size(); ++i) {
+                if (keep[i] == 0) {
+                    continue;
+                }
+                if (out != i) {
+                    std::copy_n(buffer.data() + offset + i * rowSize, rowSize,
+                            buffer.data() + offset + out * rowSize);
+                }
+                ++out;
+            }
+            buffer.resize(offset + out * rowSize);
+            kept += out;
+
+            if (lines.size() < want) {
+                break;
+            }
+        }
+        return kept;
     }
 
     /**
@@ -162,7 +286,7 @@ protected:
         return value;
     }
 
-    std::string nextElement(const std::string& line, std::size_t& start) {
+    std::string nextElement(const std::string& line, std::size_t& start, const std::size_t lineNumber) {
         std::string element;
 
         if (rfc4180) {
@@ -291,31 +415,186 @@ protected:
         return inputColumnMap;
     }
 
+    /** A constant equality condition pushed down from the rule bodies */
+    struct ConstantFilter {
+        /** Position of the filtered attribute in the tuple */
+        int attribute;
+        /** Type qualifier of the attribute ('s', 'i' or 'u') */
+        char kind;
+        /** Pre-converted constant for numeric attributes */
+        RamDomain numeric = 0;
+        /** Raw constant text for symbol attributes */
+        std::string symbol;
+    };
+
+    /** Return the filter on the given attribute, or nullptr */
+    const ConstantFilter* filterFor(int attribute) const {
+        for (const ConstantFilter& filter : filters) {
+            if (filter.attribute == attribute) {
+                return &filter;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Parses the `constant-filters` directive parameter, a JSON object
+     * mapping attribute positions to the constant the attribute carries in
+     * every use of the relation. Attributes of unsupported kinds and
+     * unparsable constants are ignored.
+     */
+    std::vector<ConstantFilter> getConstantFilters(
+            const std::map<std::string, std::string>& rwOperation) const {
+        const std::string text = getOr(rwOperation, "constant-filters", "");
+        if (text.empty()) {
+            return {};
+        }
+        std::string parseError;
+        const json11::Json json = json11::Json::parse(text, parseError);
+        if (!parseError.empty() || !json.is_object()) {
+            return {};
+        }
+        std::vector<ConstantFilter> result;
+        for (const auto& [key, value] : json.object_items()) {
+            ConstantFilter filter;
+            filter.attribute = stoi(key);
+            if (filter.attribute < 0 || static_cast<std::size_t>(filter.attribute) >= typeAttributes.size()) {
+                continue;
+            }
+            filter.kind = typeAttributes.at(filter.attribute)[0];
+            const std::string& constant = value.string_value();
+            std::size_t consumed = 0;
+            try {
+                switch (filter.kind) {
+                    case 's': filter.symbol = constant; break;
+                    case 'i': filter.numeric = RamSignedFromString(constant, &consumed); break;
+                    case 'u': {
+                        if (isPrefix("0b", constant)) {
+                            filter.numeric = ramBitCast(RamUnsignedFromString(constant, &consumed, 2));
+                        } else if (isPrefix("0x", constant)) {
+                            filter.numeric = ramBitCast(RamUnsignedFromString(constant, &consumed, 16));
+                        } else {
+                            filter.numeric = ramBitCast(RamUnsignedFromString(constant, &consumed));
+                        }
+                        break;
+                    }
+                    default: continue;
+                }
+            } catch (...) {
+                continue;
+            }
+            result.push_back(std::move(filter));
+        }
+        return result;
+    }
+
+    /**
+     * Parses the `dead-columns` directive parameter, a colon-separated list
+     * of attribute positions whose values are never inspected by the program.
+     * Returns an empty vector when every column is live.
+     */
+    std::vector<bool> getDeadColumns(const std::map<std::string, std::string>& rwOperation) const {
+        const std::string deadString = getOr(rwOperation, "dead-columns", "");
+        if (deadString.empty()) {
+            return {};
+        }
+        std::vector<bool> dead(typeAttributes.size(), false);
+        std::istringstream iss(deadString);
+        std::string index;
+        while (std::getline(iss, index, ':')) {
+            const std::size_t position = stoul(index);
+            if (position < dead.size()) {
+                dead[position] = true;
+            }
+        }
+        return dead;
+    }
+
     const bool rfc4180;
     const std::string delimiter;
     std::istream& file;
     std::size_t lineNumber;
     std::map<int, int> inputMap;
+    /** Per-attribute flags for columns skipped at parse time; empty when all live */
+    std::vector<bool> deadColumns;
+    /** Constant filters applied at parse time; rows failing one are dropped */
+    std::vector<ConstantFilter> filters;
 };
 
-class ReadFileCSV : public ReadStreamCSV {
+/**
+ * Owns the input stream of a file-backed CSV reader. The decompression
+ * codec is selected by the magic number of the file rather than its
+ * extension, so compressed fact files are handled transparently.
+ */
+class ReadCSVFileHandle {
+protected:
+    explicit ReadCSVFileHandle(const std::string& filename) {
+        unsigned char magic[4] = {};
+        {
+            std::ifstream probe(filename, std::ios::in | std::ios::binary);
+            probe.read(reinterpret_cast<char*>(magic), sizeof(magic));
+        }
+        if (magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd) {
+#ifdef USE_LIBZSTD
+            fileHandle = mk<zstdfstream::izstdfstream>(filename);
+#else
+            throw std::invalid_argument(
+                    "Cannot read zstd-compressed file " + filename + ": built without zstd support\n");
+#endif
+        } else if (magic[0] == 0x04 && magic[1] == 0x22 && magic[2] == 0x4d && magic[3] == 0x18) {
+#ifdef USE_LIBLZ4
+            fileHandle = mk<lz4fstream::ilz4fstream>(filename);
+#else
+            throw std::invalid_argument(
+                    "Cannot read lz4-compressed file " + filename + ": built without lz4 support\n");
+#endif
+        } else {
+            // zlib reads plain files transparently, so gzip needs no sniffing
+#ifdef USE_LIBZ
+            fileHandle = mk<gzfstream::igzfstream>(filename, std::ios::in | std::ios::binary);
+#else
+            fileHandle = mk<std::ifstream>(filename, std::ios::in | std::ios::binary);
+#endif
+        }
+        fileOpen = static_cast<bool>(*fileHandle);
+    }
+
+    /** The selected input stream */
+    Own<std::istream> fileHandle;
+    /** Whether the file could be opened */
+    bool fileOpen = false;
+};
+
+/**
+ * A CSV fact file reader with a transparent binary sidecar cache. After a
+ * complete parse, the tuples are written in pre-encoded form to a `.cache`
+ * file next to the source; a later run whose source file and directive
+ * options are unchanged loads the sidecar and skips the parse entirely.
+ * The cache is keyed on size and modification time of the source and
+ * invisible to the workflow: a stale or damaged sidecar simply falls back
+ * to parsing. It can be disabled with the `fact-cache=false` directive
+ * parameter.
+ */
+class ReadFileCSV : private ReadCSVFileHandle, public ReadStreamCSV {
 public:
     ReadFileCSV(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
             RecordTable& recordTable)
-            : ReadStreamCSV(fileHandle, rwOperation, symbolTable, recordTable),
-              baseName(souffle::baseName(getFileName(rwOperation))),
-              fileHandle(getFileName(rwOperation), std::ios::in | std::ios::binary) {
-        if (!fileHandle.is_open()) {
+            : ReadCSVFileHandle(getFileName(rwOperation)),
+              ReadStreamCSV(*fileHandle, rwOperation, symbolTable, recordTable),
+              baseName(souffle::baseName(getFileName(rwOperation))) {
+        if (!fileOpen) {
             // suppress error message in case file cannot be open when flag -w is set
             if (getOr(rwOperation, "no-warn", "false") != "true") {
                 throw std::invalid_argument("Cannot open fact file " + baseName + "\n");
             }
+            return;
         }
         // Strip headers if we're using them
         if (getOr(rwOperation, "headers", "false") == "true") {
             std::string line;
             getline(file, line);
         }
+        initialiseCache(rwOperation);
     }
 
     /**
@@ -325,9 +604,59 @@ public:
      * @return
      */
     Own<RamDomain[]> readNextTuple() override {
+        const std::size_t rowSize = typeAttributes.size();
+        if (cacheServing) {
+            if (nextCachedRow >= cachedRowCount) {
+                return nullptr;
+            }
+            Own<RamDomain[]> tuple = mk<RamDomain[]>(rowSize);
+            std::copy_n(cachedTuples.data() + nextCachedRow * rowSize, rowSize, tuple.get());
+            ++nextCachedRow;
+            return tuple;
+        }
         try {
-            return ReadStreamCSV::readNextTuple();
+            auto tuple = ReadStreamCSV::readNextTuple();
+            if (cacheCapturing) {
+                if (tuple == nullptr) {
+                    writeCache();
+                } else {
+                    cachedTuples.insert(cachedTuples.end(), tuple.get(), tuple.get() + rowSize);
+                }
+            }
+            return tuple;
         } catch (std::exception& e) {
+            cacheCapturing = false;
+            std::stringstream errorMessage;
+            errorMessage << e.what();
+            errorMessage << "cannot parse fact file " << baseName << "!\n";
+            throw std::invalid_argument(errorMessage.str());
+        }
+    }
+
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer, std::size_t maxRows) override {
+        if (cacheServing) {
+            const std::size_t rowSize = typeAttributes.size();
+            const std::size_t rows = std::min(maxRows, cachedRowCount - nextCachedRow);
+            const std::size_t offset = buffer.size();
+            buffer.resize(offset + rows * rowSize);
+            std::copy_n(cachedTuples.data() + nextCachedRow * rowSize, rows * rowSize,
+                    buffer.data() + offset);
+            nextCachedRow += rows;
+            return rows;
+        }
+        try {
+            const std::size_t offset = buffer.size();
+            const std::size_t rows = ReadStreamCSV::readNextBatch(buffer, maxRows);
+            if (cacheCapturing) {
+                if (rows == 0) {
+                    writeCache();
+                } else {
+                    cachedTuples.insert(cachedTuples.end(), buffer.begin() + offset, buffer.end());
+                }
+            }
+            return rows;
+        } catch (std::exception& e) {
+            cacheCapturing = false;
             std::stringstream errorMessage;
             errorMessage << e.what();
             errorMessage << "cannot parse fact file " << baseName << "!\n";
@@ -354,11 +683,203 @@ protected:
     }
 
     std::string baseName;
-#ifdef USE_LIBZ
-    gzfstream::igzfstream fileHandle;
+
+private:
+    /** Set up the sidecar cache: serve from a valid cache file, otherwise
+     * capture the parsed tuples so the cache can be written at end of file.
+     * Relations with record or ADT attributes are never cached, as record
+     * indices are not stable across runs. */
+    void initialiseCache(const std::map<std::string, std::string>& rwOperation) {
+        if (getOr(rwOperation, "fact-cache", "true") != "true") {
+            return;
+        }
+        for (const auto& ty : typeAttributes) {
+            if (ty[0] == 'r' || ty[0] == '+') {
+                return;
+            }
+        }
+        const std::string source = getFileName(rwOperation);
+        struct stat status = {};
+        if (stat(source.c_str(), &status) != 0) {
+            return;
+        }
+        sourceSize = static_cast<uint64_t>(status.st_size);
+        sourceMTime = static_cast<int64_t>(status.st_mtime);
+        parseKey = parseOptionsKey(rwOperation);
+        cachePath = source + ".cache";
+        if (loadCache()) {
+            cacheServing = true;
+        } else {
+            cachedTuples.clear();
+            cacheCapturing = true;
+        }
+    }
+
+    /** FNV-1a hash of the directive options that affect the parsed tuples */
+    static uint64_t parseOptionsKey(const std::map<std::string, std::string>& rwOperation) {
+        uint64_t hash = 14695981039346656037ull;
+        for (const char* key :
+                {"rfc4180", "delimiter", "columns", "headers", "dead-columns", "constant-filters"}) {
+            for (const char c : getOr(rwOperation, key, "")) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+            }
+            hash = (hash ^ static_cast<unsigned char>('\n')) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /** Load the sidecar cache; returns false when it is missing, stale or
+     * damaged, leaving the reader to parse the source file. */
+    bool loadCache() {
+        std::ifstream in(cachePath, std::ios::in | std::ios::binary);
+        if (!in.is_open()) {
+            return false;
+        }
+        auto readValue = [&](auto& value) { in.read(reinterpret_cast<char*>(&value), sizeof(value)); };
+
+        uint64_t magic = 0, key = 0, size = 0, rows = 0, symbolCount = 0;
+        uint32_t version = 0, width = 0, fileArity = 0;
+        int64_t mtime = 0;
+        readValue(magic);
+        readValue(version);
+        readValue(width);
+        readValue(fileArity);
+        readValue(key);
+        readValue(size);
+        readValue(mtime);
+        readValue(rows);
+        readValue(symbolCount);
+        if (!in || magic != binaryformat::sidecarMagicNumber ||
+                version != binaryformat::sidecarFormatVersion || width != sizeof(RamDomain) ||
+                fileArity != arity || key != parseKey || size != sourceSize || mtime != sourceMTime) {
+            return false;
+        }
+
+        // intern the symbol segment, mapping cache-local to symbol-table indices
+        std::vector<RamDomain> symbolIndex(symbolCount);
+        std::string text;
+        for (uint64_t i = 0; i < symbolCount; ++i) {
+            uint32_t length = 0;
+            readValue(length);
+            if (!in) {
+                return false;
+            }
+            text.resize(length);
+            in.read(text.data(), static_cast<std::streamsize>(text.size()));
+            symbolIndex[i] = symbolTable.encode(text);
+        }
+
+        const std::size_t rowSize = typeAttributes.size();
+        cachedTuples.resize(rows * rowSize);
+        in.read(reinterpret_cast<char*>(cachedTuples.data()),
+                static_cast<std::streamsize>(cachedTuples.size() * sizeof(RamDomain)));
+        if (!in) {
+            return false;
+        }
+
+        // translate symbol attributes to symbol-table indices
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (typeAttributes.at(i)[0] != 's') {
+                continue;
+            }
+            for (std::size_t row = 0; row < rows; ++row) {
+                RamDomain& value = cachedTuples[row * rowSize + i];
+                if (value < 0 || static_cast<uint64_t>(value) >= symbolCount) {
+                    return false;
+                }
+                value = symbolIndex[value];
+            }
+        }
+
+        cachedRowCount = rows;
+        return true;
+    }
+
+    /** Write the captured tuples as a sidecar cache next to the source file.
+     * The file is written to a temporary name and moved into place, so
+     * concurrent runs see either no cache or a complete one; any I/O failure
+     * just leaves the cache unwritten. */
+    void writeCache() {
+        cacheCapturing = false;
+        const std::size_t rowSize = typeAttributes.size();
+        const uint64_t rows = cachedTuples.size() / rowSize;
+
+        // re-index the symbols of the captured tuples into a cache-local segment
+        std::vector<RamDomain> encoded = cachedTuples;
+        std::unordered_map<RamDomain, RamDomain> localIndex;
+        std::vector<RamDomain> symbols;
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (typeAttributes.at(i)[0] != 's') {
+                continue;
+            }
+            for (uint64_t row = 0; row < rows; ++row) {
+                RamDomain& value = encoded[row * rowSize + i];
+                auto entry = localIndex.emplace(value, static_cast<RamDomain>(symbols.size()));
+                if (entry.second) {
+                    symbols.push_back(value);
+                }
+                value = entry.first->second;
+            }
+        }
+
+#ifdef _WIN32
+        const std::string tmpPath = cachePath + ".tmp." + std::to_string(GetCurrentProcessId());
 #else
-    std::ifstream fileHandle;
+        const std::string tmpPath = cachePath + ".tmp." + std::to_string(getpid());
 #endif
+        {
+            std::ofstream out(tmpPath, std::ios::out | std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) {
+                return;
+            }
+            auto writeValue = [&](auto value) {
+                out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            };
+            writeValue(binaryformat::sidecarMagicNumber);
+            writeValue(binaryformat::sidecarFormatVersion);
+            writeValue(static_cast<uint32_t>(sizeof(RamDomain)));
+            writeValue(static_cast<uint32_t>(arity));
+            writeValue(parseKey);
+            writeValue(sourceSize);
+            writeValue(sourceMTime);
+            writeValue(rows);
+            writeValue(static_cast<uint64_t>(symbols.size()));
+            for (const RamDomain symbol : symbols) {
+                const std::string& text = symbolTable.decode(symbol);
+                writeValue(static_cast<uint32_t>(text.size()));
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+            }
+            out.write(reinterpret_cast<const char*>(encoded.data()),
+                    static_cast<std::streamsize>(encoded.size() * sizeof(RamDomain)));
+            if (!out) {
+                out.close();
+                std::remove(tmpPath.c_str());
+                return;
+            }
+        }
+        if (std::rename(tmpPath.c_str(), cachePath.c_str()) != 0) {
+            std::remove(tmpPath.c_str());
+        }
+    }
+
+    /** Path of the sidecar cache file; empty when caching is disabled */
+    std::string cachePath;
+    /** Hash of the parse-affecting directive options */
+    uint64_t parseKey = 0;
+    /** Size of the source file when it was opened */
+    uint64_t sourceSize = 0;
+    /** Modification time of the source file when it was opened */
+    int64_t sourceMTime = 0;
+    /** The cached or captured tuples, row-major */
+    std::vector<RamDomain> cachedTuples;
+    /** Number of rows served from the cache */
+    std::size_t cachedRowCount = 0;
+    /** Next row to serve from the cache */
+    std::size_t nextCachedRow = 0;
+    /** Whether tuples are served from a loaded cache */
+    bool cacheServing = false;
+    /** Whether parsed tuples are captured to write a cache at end of file */
+    bool cacheCapturing = false;
 };
 
 class ReadCinCSVFactory : public ReadStreamFactory {
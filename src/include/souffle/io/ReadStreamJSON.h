@@ -46,11 +46,17 @@ template <typename... T>
     throw std::runtime_error(out.str());
 }
 
+/**
+ * Reads tuples from a json stream with an incremental, SAX-style parser.
+ * Values are converted to their RamDomain representation as they stream
+ * past, so the document is never materialised and arbitrarily large fact
+ * files parse in memory proportional to a single tuple.
+ */
 class ReadStreamJSON : public ReadStream {
 public:
     ReadStreamJSON(std::istream& file, const std::map<std::string, std::string>& rwOperation,
             SymbolTable& symbolTable, RecordTable& recordTable)
-            : ReadStream(rwOperation, symbolTable, recordTable), file(file), pos(0), isInitialized(false) {
+            : ReadStream(rwOperation, symbolTable, recordTable), file(file), isInitialized(false) {
         std::string err;
         params = Json::parse(rwOperation.at("params"), err);
         if (err.length() > 0) {
@@ -60,37 +66,32 @@ public:
 
 protected:
     std::istream& file;
-    std::size_t pos;
-    Json jsonSource;
     Json params;
     bool isInitialized;
-    bool useObjects;
+    bool useObjects = false;
+    /** Whether the closing bracket of the top-level array has been consumed */
+    bool exhausted = false;
     std::map<const std::string, const std::size_t> paramIndex;
 
     Own<RamDomain[]> readNextTuple() override {
-        // for some reasons we cannot initalized our json objects in constructor
-        // otherwise it will segfault, so we initialize in the first call
         if (!isInitialized) {
             isInitialized = true;
-            std::string error = "";
-            std::string source(std::istreambuf_iterator<char>(file), {});
-
-            jsonSource = Json::parse(source, error);
-            // it should be wrapped by an extra array
-            if (error.length() > 0 || !jsonSource.is_array()) {
-                throwError("cannot deserialize json because ", error, ":\n", source);
+            // the tuples are wrapped by an extra array
+            if (nextToken() != '[') {
+                throwError("cannot deserialize json: the input is not wrapped in an array");
             }
-
-            if (jsonSource.array_items().empty()) {
+            const int c = nextToken();
+            if (c == ']') {
                 // No tuples defined
+                exhausted = true;
                 return nullptr;
             }
-
+            file.unget();
             // we only check the first one, since there are extra checks
             // in readNextTupleObject/readNextTupleList
-            if (jsonSource[0].is_array()) {
+            if (c == '[') {
                 useObjects = false;
-            } else if (jsonSource[0].is_object()) {
+            } else if (c == '{') {
                 useObjects = true;
                 std::size_t index_pos = 0;
                 for (auto param : params["relation"]["params"].array_items()) {
@@ -102,63 +103,48 @@ protected:
             }
         }
 
-        if (useObjects) {
-            return readNextTupleObject();
-        } else {
-            return readNextTupleList();
+        if (exhausted) {
+            return nullptr;
+        }
+
+        Own<RamDomain[]> tuple = useObjects ? readNextTupleObject() : readNextTupleList();
+
+        const int c = nextToken();
+        if (c == ']') {
+            exhausted = true;
+        } else if (c != ',') {
+            throwError("cannot deserialize json: expected ',' or ']' after a tuple");
         }
+        return tuple;
     }
 
     Own<RamDomain[]> readNextTupleList() {
-        if (pos >= jsonSource.array_items().size()) {
-            return nullptr;
+        if (nextToken() != '[') {
+            throwError("cannot deserialize json: the input is not json array");
         }
 
         Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
-        const Json& jsonObj = jsonSource[pos];
-        assert(jsonObj.is_array() && "the input is not json array");
-        pos++;
         for (std::size_t i = 0; i < typeAttributes.size(); ++i) {
-            try {
-                auto&& ty = typeAttributes.at(i);
-                switch (ty[0]) {
-                    case 's': {
-                        tuple[i] = symbolTable.encode(jsonObj[i].string_value());
-                        break;
-                    }
-                    case 'r': {
-                        tuple[i] = readNextElementList(jsonObj[i], ty);
-                        break;
-                    }
-                    case 'i': {
-                        tuple[i] = jsonObj[i].int_value();
-                        break;
-                    }
-                    case 'u': {
-                        tuple[i] = jsonObj[i].int_value();
-                        break;
-                    }
-                    case 'f': {
-                        tuple[i] = static_cast<RamDomain>(jsonObj[i].number_value());
-                        break;
-                    }
-                    default: throwError("invalid type attribute: '", ty[0], "'");
-                }
-            } catch (...) {
+            if (i > 0 && nextToken() != ',') {
                 std::stringstream errorMessage;
-                if (jsonObj.is_array() && i < jsonObj.array_items().size()) {
-                    errorMessage << "Error converting: " << jsonObj[i].dump();
-                } else {
-                    errorMessage << "Invalid index: " << i;
-                }
+                errorMessage << "Invalid index: " << i;
                 throw std::invalid_argument(errorMessage.str());
             }
+            auto&& ty = typeAttributes.at(i);
+            if (ty[0] == 'r') {
+                tuple[i] = readNextElementList(ty);
+            } else {
+                tuple[i] = convert(readScalar(), ty);
+            }
+        }
+        if (nextToken() != ']') {
+            throwError("cannot deserialize json: expected ']' closing a tuple");
         }
 
         return tuple;
     }
 
-    RamDomain readNextElementList(const Json& source, const std::string& recordTypeName) {
+    RamDomain readNextElementList(const std::string& recordTypeName) {
         auto&& recordInfo = types["records"][recordTypeName];
 
         if (recordInfo.is_null()) {
@@ -166,95 +152,75 @@ protected:
         }
 
         // Handle null case
-        if (source.is_null()) {
+        int c = nextToken();
+        if (c == 'n') {
+            expectLiteral("ull");
             return 0;
         }
+        if (c != '[') {
+            throwError("cannot deserialize json: the input is not json array");
+        }
 
-        assert(source.is_array() && "the input is not json array");
         auto&& recordTypes = recordInfo["types"];
         const std::size_t recordArity = recordInfo["arity"].long_value();
         std::vector<RamDomain> recordValues(recordArity);
         for (std::size_t i = 0; i < recordArity; ++i) {
+            if (i > 0 && nextToken() != ',') {
+                throwError("cannot deserialize json: expected ',' in a record");
+            }
             const std::string& recordType = recordTypes[i].string_value();
-            switch (recordType[0]) {
-                case 's': {
-                    recordValues[i] = symbolTable.encode(source[i].string_value());
-                    break;
-                }
-                case 'r': {
-                    recordValues[i] = readNextElementList(source[i], recordType);
-                    break;
-                }
-                case 'i': {
-                    recordValues[i] = source[i].int_value();
-                    break;
-                }
-                case 'u': {
-                    recordValues[i] = source[i].int_value();
-                    break;
-                }
-                case 'f': {
-                    recordValues[i] = static_cast<RamDomain>(source[i].number_value());
-                    break;
-                }
-                default: throwError("invalid type attribute");
+            if (recordType[0] == 'r') {
+                recordValues[i] = readNextElementList(recordType);
+            } else {
+                recordValues[i] = convert(readScalar(), recordType);
             }
         }
+        if (nextToken() != ']') {
+            throwError("cannot deserialize json: expected ']' closing a record");
+        }
 
         return recordTable.pack(recordValues.data(), recordValues.size());
     }
 
     Own<RamDomain[]> readNextTupleObject() {
-        if (pos >= jsonSource.array_items().size()) {
-            return nullptr;
+        if (nextToken() != '{') {
+            throwError("cannot deserialize json: the input is not json object");
         }
 
         Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
-        const Json& jsonObj = jsonSource[pos];
-        assert(jsonObj.is_object() && "the input is not json object");
-        pos++;
-        for (auto p : jsonObj.object_items()) {
-            try {
+        int c = nextToken();
+        if (c != '}') {
+            file.unget();
+            do {
+                if (nextToken() != '"') {
+                    throwError("cannot deserialize json: expected a parameter name");
+                }
+                const std::string key = parseString();
+                if (nextToken() != ':') {
+                    throwError("cannot deserialize json: expected ':' after a parameter name");
+                }
                 // get the corresponding position by parameter name
-                if (paramIndex.find(p.first) == paramIndex.end()) {
-                    throwError("invalid parameter: ", p.first);
+                if (paramIndex.find(key) == paramIndex.end()) {
+                    throwError("invalid parameter: ", key);
                 }
-                std::size_t i = paramIndex.at(p.first);
+                const std::size_t i = paramIndex.at(key);
                 auto&& ty = typeAttributes.at(i);
-                switch (ty[0]) {
-                    case 's': {
-                        tuple[i] = symbolTable.encode(p.second.string_value());
-                        break;
-                    }
-                    case 'r': {
-                        tuple[i] = readNextElementObject(p.second, ty);
-                        break;
-                    }
-                    case 'i': {
-                        tuple[i] = p.second.int_value();
-                        break;
-                    }
-                    case 'u': {
-                        tuple[i] = p.second.int_value();
-                        break;
-                    }
-                    case 'f': {
-                        tuple[i] = static_cast<RamDomain>(p.second.number_value());
-                        break;
-                    }
-                    default: throwError("invalid type attribute: '", ty[0], "'");
+                if (ty[0] == 'r') {
+                    tuple[i] = readNextElementObject(ty);
+                } else {
+                    tuple[i] = convert(readScalar(), ty);
                 }
-            } catch (...) {
-                std::stringstream errorMessage;
-                errorMessage << "Error converting: " << p.second.dump();
-                throw std::invalid_argument(errorMessage.str());
+                c = nextToken();
+            } while (c == ',');
+            if (c != '}') {
+                throwError("cannot deserialize json: expected ',' or '}' in an object");
             }
         }
 
         return tuple;
     }
 
-    RamDomain readNextElementObject(const Json& source, const std::string& recordTypeName) {
+    RamDomain readNextElementObject(const std::string& recordTypeName) {
         auto&& recordInfo = types["records"][recordTypeName];
         const std::string recordName = recordTypeName.substr(2);
         std::map<const std::string, const std::size_t> recordIndex;
@@ -270,49 +236,237 @@ protected:
         }
 
         // Handle null case
-        if (source.is_null()) {
+        int c = nextToken();
+        if (c == 'n') {
+            expectLiteral("ull");
             return 0;
         }
+        if (c != '{') {
+            throwError("cannot deserialize json: the input is not json object");
+        }
 
-        assert(source.is_object() && "the input is not json object");
         auto&& recordTypes = recordInfo["types"];
         const std::size_t recordArity = recordInfo["arity"].long_value();
         std::vector<RamDomain> recordValues(recordArity);
-        recordValues.reserve(recordIndex.size());
-        for (auto readParam : source.object_items()) {
-            // get the corresponding position by parameter name
-            if (recordIndex.find(readParam.first) == recordIndex.end()) {
-                throwError("invalid parameter: ", readParam.first);
-            }
-            std::size_t i = recordIndex.at(readParam.first);
-            auto&& type = recordTypes[i].string_value();
-            switch (type[0]) {
-                case 's': {
-                    recordValues[i] = symbolTable.encode(readParam.second.string_value());
-                    break;
-                }
-                case 'r': {
-                    recordValues[i] = readNextElementObject(readParam.second, type);
-                    break;
+        c = nextToken();
+        if (c != '}') {
+            file.unget();
+            do {
+                if (nextToken() != '"') {
+                    throwError("cannot deserialize json: expected a parameter name");
                 }
-                case 'i': {
-                    recordValues[i] = readParam.second.int_value();
-                    break;
+                const std::string key = parseString();
+                if (nextToken() != ':') {
+                    throwError("cannot deserialize json: expected ':' after a parameter name");
                 }
-                case 'u': {
-                    recordValues[i] = readParam.second.int_value();
-                    break;
+                // get the corresponding position by parameter name
+                if (recordIndex.find(key) == recordIndex.end()) {
+                    throwError("invalid parameter: ", key);
                 }
-                case 'f': {
-                    recordValues[i] = static_cast<RamDomain>(readParam.second.number_value());
-                    break;
+                const std::size_t i = recordIndex.at(key);
+                auto&& type = recordTypes[i].string_value();
+                if (type[0] == 'r') {
+                    recordValues[i] = readNextElementObject(type);
+                } else {
+                    recordValues[i] = convert(readScalar(), type);
                 }
-                default: throwError("invalid type attribute: '", type[0], "'");
+                c = nextToken();
+            } while (c == ',');
+            if (c != '}') {
+                throwError("cannot deserialize json: expected ',' or '}' in an object");
             }
         }
 
         return recordTable.pack(recordValues.data(), recordValues.size());
     }
+
+private:
+    /** A scalar value lifted off the stream */
+    struct Scalar {
+        enum Kind { String, Number, Boolean, Null };
+        Kind kind;
+        std::string text;
+    };
+
+    /** Read the next scalar value off the stream */
+    Scalar readScalar() {
+        const int c = nextToken();
+        if (c == '"') {
+            return {Scalar::String, parseString()};
+        }
+        if (c == '-' || (c >= '0' && c <= '9')) {
+            file.unget();
+            return {Scalar::Number, parseNumber()};
+        }
+        if (c == 't') {
+            expectLiteral("rue");
+            return {Scalar::Boolean, "true"};
+        }
+        if (c == 'f') {
+            expectLiteral("alse");
+            return {Scalar::Boolean, "false"};
+        }
+        if (c == 'n') {
+            expectLiteral("ull");
+            return {Scalar::Null, "null"};
+        }
+        throwError("cannot deserialize json: unexpected character");
+    }
+
+    /** Convert a scalar to the RamDomain representation of the given type,
+     * matching the conversions of the DOM-based reader this one replaced */
+    RamDomain convert(const Scalar& value, const std::string& ty) {
+        try {
+            switch (ty[0]) {
+                case 's':
+                    if (value.kind != Scalar::String) {
+                        break;
+                    }
+                    return symbolTable.encode(value.text);
+                case 'i':
+                    if (value.kind != Scalar::Number) {
+                        break;
+                    }
+                    if (value.text.find_first_of(".eE") == std::string::npos) {
+                        return static_cast<RamDomain>(std::stoll(value.text));
+                    }
+                    return static_cast<RamDomain>(std::stod(value.text));
+                case 'u':
+                    if (value.kind != Scalar::Number) {
+                        break;
+                    }
+                    if (value.text.find_first_of(".eE") == std::string::npos) {
+                        return static_cast<RamDomain>(std::stoull(value.text));
+                    }
+                    return static_cast<RamDomain>(std::stod(value.text));
+                case 'f':
+                    if (value.kind != Scalar::Number) {
+                        break;
+                    }
+                    return static_cast<RamDomain>(std::stod(value.text));
+                default: throwError("invalid type attribute: '", ty[0], "'");
+            }
+        } catch (const std::runtime_error&) {
+            throw;
+        } catch (...) {
+            // fall through to the conversion error below
+        }
+        std::stringstream errorMessage;
+        errorMessage << "Error converting: " << value.text;
+        throw std::invalid_argument(errorMessage.str());
+    }
+
+    /** Return the next character that is not json whitespace, or EOF */
+    int nextToken() {
+        int c = file.get();
+        while (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+            c = file.get();
+        }
+        return c;
+    }
+
+    /** Consume the remainder of a literal keyword */
+    void expectLiteral(const char* rest) {
+        for (const char* c = rest; *c != '\0'; ++c) {
+            if (file.get() != *c) {
+                throwError("cannot deserialize json: invalid literal");
+            }
+        }
+    }
+
+    /** Read the raw text of a number off the stream */
+    std::string parseNumber() {
+        std::string text;
+        int c = file.get();
+        while (c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E' || (c >= '0' && c <= '9')) {
+            text += static_cast<char>(c);
+            c = file.get();
+        }
+        if (c != EOF) {
+            file.unget();
+        }
+        return text;
+    }
+
+    /** Read the remainder of a string off the stream, the opening quote
+     * having been consumed, and decode its escape sequences */
+    std::string parseString() {
+        std::string result;
+        int c = file.get();
+        while (c != EOF && c != '"') {
+            if (c == '\\') {
+                c = file.get();
+                switch (c) {
+                    case '"': result += '"'; break;
+                    case '\\': result += '\\'; break;
+                    case '/': result += '/'; break;
+                    case 'b': result += '\b'; break;
+                    case 'f': result += '\f'; break;
+                    case 'n': result += '\n'; break;
+                    case 'r': result += '\r'; break;
+                    case 't': result += '\t'; break;
+                    case 'u': {
+                        uint32_t code = parseCodepoint();
+                        // combine a surrogate pair into the full codepoint
+                        if (code >= 0xd800 && code <= 0xdbff) {
+                            if (file.get() != '\\' || file.get() != 'u') {
+                                throwError("cannot deserialize json: unpaired surrogate");
+                            }
+                            const uint32_t low = parseCodepoint();
+                            code = 0x10000 + ((code - 0xd800) << 10) + (low - 0xdc00);
+                        }
+                        appendUTF8(result, code);
+                        break;
+                    }
+                    default: throwError("cannot deserialize json: invalid escape sequence");
+                }
+            } else {
+                result += static_cast<char>(c);
+            }
+            c = file.get();
+        }
+        if (c == EOF) {
+            throwError("cannot deserialize json: unterminated string");
+        }
+        return result;
+    }
+
+    /** Read the four hex digits of a unicode escape */
+    uint32_t parseCodepoint() {
+        uint32_t code = 0;
+        for (int i = 0; i < 4; ++i) {
+            const int digit = file.get();
+            if (digit >= '0' && digit <= '9') {
+                code = code * 16 + (digit - '0');
+            } else if (digit >= 'a' && digit <= 'f') {
+                code = code * 16 + (digit - 'a' + 10);
+            } else if (digit >= 'A' && digit <= 'F') {
+                code = code * 16 + (digit - 'A' + 10);
+            } else {
+                throwError("cannot deserialize json: invalid unicode escape");
+            }
+        }
+        return code;
+    }
+
+    /** Append the UTF-8 encoding of a codepoint */
+    static void appendUTF8(std::string& result, const uint32_t code) {
+        if (code < 0x80) {
+            result += static_cast<char>(code);
+        } else if (code < 0x800) {
+            result += static_cast<char>(0xc0 | (code >> 6));
+            result += static_cast<char>(0x80 | (code & 0x3f));
+        } else if (code < 0x10000) {
+            result += static_cast<char>(0xe0 | (code >> 12));
+            result += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            result += static_cast<char>(0x80 | (code & 0x3f));
+        } else {
+            result += static_cast<char>(0xf0 | (code >> 18));
+            result += static_cast<char>(0x80 | ((code >> 12) & 0x3f));
+            result += static_cast<char>(0x80 | ((code >> 6) & 0x3f));
+            result += static_cast<char>(0x80 | (code & 0x3f));
+        }
+    }
 };
 
 class ReadFileJSON : public ReadStreamJSON {
@@ -0,0 +1,220 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReadStreamParquet.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/ReadStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/exception.h>
+
+namespace souffle {
+
+/**
+ * A read stream deserialising a relation from an Apache Parquet file.
+ * Dictionary-encoded string columns are interned wholesale: each distinct
+ * dictionary entry is encoded into the symbol table exactly once and tuples
+ * are translated by a plain index lookup, matching the flyweight symbol
+ * representation.
+ */
+class ReadStreamParquet : public ReadStream {
+public:
+    ReadStreamParquet(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable)
+            : ReadStream(rwOperation, symbolTable, recordTable),
+              baseName(souffle::baseName(getFileName(rwOperation))) {
+        try {
+            readFile(getFileName(rwOperation));
+        } catch (const parquet::ParquetException& e) {
+            throw std::invalid_argument(
+                    "Cannot read fact file " + baseName + ": " + std::string(e.what()) + "\n");
+        }
+    }
+
+protected:
+    Own<RamDomain[]> readNextTuple() override {
+        if (nextRow >= tupleCount) {
+            return nullptr;
+        }
+        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+        for (std::size_t i = 0; i < arity; ++i) {
+            tuple[i] = columns[i][nextRow];
+        }
+        ++nextRow;
+        return tuple;
+    }
+
+    std::size_t readNextBatch(std::vector<RamDomain>& buffer, std::size_t maxRows) override {
+        const std::size_t rowSize = typeAttributes.size();
+        const std::size_t rows = std::min(maxRows, tupleCount - nextRow);
+
+        // transpose the requested chunk of the column store
+        const std::size_t offset = buffer.size();
+        buffer.resize(offset + rows * rowSize);
+        for (std::size_t i = 0; i < arity; ++i) {
+            const RamDomain* column = &columns[i][nextRow];
+            for (std::size_t row = 0; row < rows; ++row) {
+                buffer[offset + row * rowSize + i] = column[row];
+            }
+        }
+
+        nextRow += rows;
+        return rows;
+    }
+
+private:
+    /** Reads the table and translates each column into RamDomain values. */
+    void readFile(const std::string& fileName) {
+        PARQUET_ASSIGN_OR_THROW(const auto file, arrow::io::ReadableFile::Open(fileName));
+        std::unique_ptr<parquet::arrow::FileReader> reader;
+        PARQUET_THROW_NOT_OK(parquet::arrow::OpenFile(file, arrow::default_memory_pool(), &reader));
+        std::shared_ptr<arrow::Table> table;
+        PARQUET_THROW_NOT_OK(reader->ReadTable(&table));
+
+        if (static_cast<std::size_t>(table->num_columns()) != arity) {
+            throw std::invalid_argument("Fact file " + baseName + " has a mismatching arity.\n");
+        }
+        tupleCount = static_cast<std::size_t>(table->num_rows());
+
+        columns.resize(arity);
+        for (std::size_t i = 0; i < arity; ++i) {
+            columns[i].reserve(tupleCount);
+            for (const auto& chunk : table->column(static_cast<int>(i))->chunks()) {
+                appendChunk(columns[i], *chunk, typeAttributes.at(i)[0]);
+            }
+        }
+    }
+
+    /** Appends the values of one column chunk, translated to RamDomain. */
+    void appendChunk(std::vector<RamDomain>& column, const arrow::Array& chunk, const char typeAttribute) {
+        switch (chunk.type_id()) {
+            case arrow::Type::DICTIONARY: {
+                const auto& array = static_cast<const arrow::DictionaryArray&>(chunk);
+                const auto symbolIndex = internDictionary(array.dictionary());
+                const auto& indices = static_cast<const arrow::Int32Array&>(*array.indices());
+                for (std::int64_t row = 0; row < indices.length(); ++row) {
+                    column.push_back(symbolIndex.at(indices.Value(row)));
+                }
+                break;
+            }
+            case arrow::Type::STRING: {
+                const auto& array = static_cast<const arrow::StringArray&>(chunk);
+                for (std::int64_t row = 0; row < array.length(); ++row) {
+                    column.push_back(symbolTable.encode(array.GetString(row)));
+                }
+                break;
+            }
+            case arrow::Type::INT32:
+                appendNumericChunk<arrow::Int32Array>(column, chunk, typeAttribute);
+                break;
+            case arrow::Type::INT64:
+                appendNumericChunk<arrow::Int64Array>(column, chunk, typeAttribute);
+                break;
+            case arrow::Type::UINT32:
+                appendNumericChunk<arrow::UInt32Array>(column, chunk, typeAttribute);
+                break;
+            case arrow::Type::UINT64:
+                appendNumericChunk<arrow::UInt64Array>(column, chunk, typeAttribute);
+                break;
+            case arrow::Type::FLOAT:
+                appendNumericChunk<arrow::FloatArray>(column, chunk, typeAttribute);
+                break;
+            case arrow::Type::DOUBLE:
+                appendNumericChunk<arrow::DoubleArray>(column, chunk, typeAttribute);
+                break;
+            default:
+                throw std::invalid_argument("Fact file " + baseName + " has a column of unsupported type " +
+                                            chunk.type()->ToString() + ".\n");
+        }
+    }
+
+    /** Encodes all entries of a column dictionary into the symbol table. */
+    std::vector<RamDomain> internDictionary(const std::shared_ptr<arrow::Array>& dictionary) {
+        const auto& symbols = static_cast<const arrow::StringArray&>(*dictionary);
+        std::vector<RamDomain> symbolIndex(static_cast<std::size_t>(symbols.length()));
+        for (std::int64_t i = 0; i < symbols.length(); ++i) {
+            symbolIndex[i] = symbolTable.encode(symbols.GetString(i));
+        }
+        return symbolIndex;
+    }
+
+    template <typename Array>
+    void appendNumericChunk(
+            std::vector<RamDomain>& column, const arrow::Array& chunk, const char typeAttribute) {
+        const auto& array = static_cast<const Array&>(chunk);
+        for (std::int64_t row = 0; row < array.length(); ++row) {
+            switch (typeAttribute) {
+                case 'u':
+                    column.push_back(ramBitCast(static_cast<RamUnsigned>(array.Value(row))));
+                    break;
+                case 'f': column.push_back(ramBitCast(static_cast<RamFloat>(array.Value(row)))); break;
+                default: column.push_back(static_cast<RamDomain>(array.Value(row))); break;
+            }
+        }
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].parquet
+     *
+     * @param rwOperation map of IO configuration options
+     * @return input filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".parquet");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "fact-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    std::string baseName;
+
+    // the relation content in columnar layout
+    std::vector<std::vector<RamDomain>> columns;
+
+    std::size_t tupleCount = 0;
+    std::size_t nextRow = 0;
+};
+
+class ReadParquetFactory : public ReadStreamFactory {
+public:
+    Own<ReadStream> getReader(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable) override {
+        return mk<ReadStreamParquet>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "parquet";
+        return name;
+    }
+    ~ReadParquetFactory() override = default;
+};
+
+} /* namespace souffle */
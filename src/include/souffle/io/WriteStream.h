@@ -18,15 +18,30 @@
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/io/SerialisationStream.h"
+#include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/json11.h"
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <functional>
 #include <iomanip>
+#include <limits>
 #include <map>
 #include <memory>
 #include <ostream>
+#include <sstream>
 #include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace souffle {
 
@@ -37,7 +52,11 @@ public:
     WriteStream(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
             const RecordTable& recordTable)
             : SerialisationStream(symbolTable, recordTable, rwOperation),
-              summary(rwOperation.at("IO") == "stdoutprintsize") {}
+              summary(rwOperation.at("IO") == "stdoutprintsize"),
+              differential(getOr(rwOperation, "differential", "false") == "true"),
+              snapshotName(differential ? getOr(rwOperation, "output-dir", ".") + "/" +
+                                                  rwOperation.at("name") + ".snapshot"
+                                        : "") {}
 
     template <typename T>
     void writeAll(const T& relation) {
@@ -50,6 +69,18 @@ public:
             }
             return;
         }
+        if (differential) {
+            writeAllDifferential(relation);
+            return;
+        }
+        // relations offering a partitioning can be formatted in parallel,
+        // provided the stream exposes a plain batch destination
+        if constexpr (has_partition<T>::value) {
+            if (std::ostream* destination = batchDestination()) {
+                writeAllParallel(relation, *destination);
+                return;
+            }
+        }
         for (const auto& current : relation) {
             writeNext(current);
         }
@@ -63,12 +94,174 @@ public:
 protected:
     const bool summary;
 
+    /** Whether only the changes against the previous run are emitted */
+    const bool differential;
+
+    /** Snapshot sidecar retaining the previous run's serialised tuples */
+    const std::string snapshotName;
+
+    /**
+     * A type trait determining whether a relation type supports being
+     * partitioned into chunks for parallel processing.
+     */
+    template <typename T, typename = void>
+    struct has_partition : std::false_type {};
+
+    template <typename T>
+    struct has_partition<T, std::void_t<decltype(std::declval<const T&>().partition())>> : std::true_type {};
+
     virtual void writeNullary() = 0;
     virtual void writeNextTuple(const RamDomain* tuple) = 0;
     virtual void writeSize(std::size_t) {
         fatal("attempting to print size of a write operation");
     }
 
+    /**
+     * The plain output stream shards of a parallel write are emitted to, or
+     * nullptr if this stream does not support batched writing.
+     */
+    virtual std::ostream* batchDestination() {
+        return nullptr;
+    }
+
+    /** Formats a single tuple into the given buffer (parallel write path). */
+    virtual void formatTuple(std::ostream& /* destination */, const RamDomain* /* tuple */) {
+        fatal("stream does not support batched formatting");
+    }
+
+    /** Returns the raw data of a tuple yielded by relation iteration. */
+    static const RamDomain* tupleData(const RamDomain* tuple) {
+        return tuple;
+    }
+
+    template <typename Tuple>
+    static const RamDomain* tupleData(const Tuple& tuple) {
+        using tcb::make_span;
+        return make_span(tuple).data();
+    }
+
+    /**
+     * Writes the given relation by formatting waves of partitions into
+     * per-thread buffers and emitting the buffers in partition order. The
+     * wave size bounds the amount of formatted but unwritten output.
+     */
+    template <typename T>
+    void writeAllParallel(const T& relation, std::ostream& destination) {
+        const auto chunks = relation.partition();
+        const std::size_t numChunks = chunks.size();
+#ifdef _OPENMP
+        const std::size_t wave = static_cast<std::size_t>(omp_get_max_threads()) * 4;
+#else
+        const std::size_t wave = 1;
+#endif
+
+        std::vector<std::string> shards(std::min(wave, numChunks));
+        for (std::size_t begin = 0; begin < numChunks; begin += wave) {
+            const std::size_t end = std::min(begin + wave, numChunks);
+            std::exception_ptr error = nullptr;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (std::int64_t i = static_cast<std::int64_t>(begin); i < static_cast<std::int64_t>(end);
+                    ++i) {
+                try {
+                    std::ostringstream buffer;
+                    buffer << std::setprecision(std::numeric_limits<RamFloat>::max_digits10);
+                    for (const auto& current : chunks[i]) {
+                        formatTuple(buffer, tupleData(current));
+                    }
+                    shards[i - begin] = buffer.str();
+                } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(souffle_write_shard_error)
+#endif
+                    {
+                        if (error == nullptr) {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+            }
+            if (error != nullptr) {
+                std::rethrow_exception(error);
+            }
+            for (std::size_t i = begin; i < end; ++i) {
+                std::string& shard = shards[i - begin];
+                destination.write(shard.data(), static_cast<std::streamsize>(shard.size()));
+                shard.clear();
+            }
+        }
+    }
+
+    /**
+     * Writes only the difference against the previous run of this relation:
+     * each emitted row carries a leading +/- column marking it as added or
+     * removed. The serialised form of the current run is retained in a
+     * snapshot sidecar next to the output (<output-dir>/<relation>.snapshot)
+     * and replaced atomically once the diff is complete; only tuple hashes
+     * are held in memory, and removed rows are recovered from the snapshot
+     * text in a second pass. On the first run, when no snapshot exists yet,
+     * every tuple is emitted as added.
+     */
+    template <typename T>
+    void writeAllDifferential(const T& relation) {
+        std::ostream* destination = batchDestination();
+        if (destination == nullptr) {
+            fatal("differential output is not supported by this write stream");
+        }
+
+        const std::hash<std::string> hasher;
+
+        // hashes of the previous run's serialised tuples; a collision can
+        // suppress a changed row, but the odds of a changed row meeting a
+        // colliding partner are negligible for any realistic relation size
+        std::unordered_set<std::size_t> previous;
+        {
+            std::ifstream snapshot(snapshotName);
+            for (std::string line; std::getline(snapshot, line);) {
+                previous.insert(hasher(line));
+            }
+        }
+
+        // serialise the current run into the successor snapshot, emitting
+        // the rows unseen in the previous one as added
+        const std::string pending = snapshotName + ".part";
+        std::ofstream snapshot(pending, std::ios::out | std::ios::binary);
+        snapshot << std::setprecision(std::numeric_limits<RamFloat>::max_digits10);
+        std::unordered_set<std::size_t> current;
+        std::ostringstream buffer;
+        buffer << std::setprecision(std::numeric_limits<RamFloat>::max_digits10);
+        for (const auto& tuple : relation) {
+            buffer.str(std::string());
+            formatTuple(buffer, tupleData(tuple));
+            std::string line = buffer.str();
+            if (!line.empty() && line.back() == '\n') {
+                line.pop_back();
+            }
+            snapshot << line << '\n';
+            const std::size_t hash = hasher(line);
+            current.insert(hash);
+            if (previous.find(hash) == previous.end()) {
+                *destination << "+\t" << line << '\n';
+            }
+        }
+        snapshot.close();
+
+        // recover the removed rows from the previous snapshot's text
+        if (!previous.empty()) {
+            std::ifstream retired(snapshotName);
+            for (std::string line; std::getline(retired, line);) {
+                if (current.find(hasher(line)) == current.end()) {
+                    *destination << "-\t" << line << '\n';
+                }
+            }
+        }
+
+        if (std::rename(pending.c_str(), snapshotName.c_str()) != 0) {
+            fatal("cannot replace differential snapshot `%s`", snapshotName);
+        }
+    }
+
     template <typename Tuple>
     void writeNext(const Tuple tuple) {
         using tcb::make_span;
@@ -0,0 +1,162 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file WriteStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A write stream serialising a relation into the native binary columnar
+ * fact format (see BinaryFormat.h). Symbol attributes are re-indexed into
+ * a per-file symbol segment so that the produced files can be loaded into
+ * runs with a differently populated symbol table.
+ */
+class WriteStreamBinary : public WriteStream {
+public:
+    WriteStreamBinary(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable)
+            : WriteStream(rwOperation, symbolTable, recordTable),
+              file(getFileName(rwOperation), std::ios::out | std::ios::binary), columns(arity) {
+        for (std::size_t i = 0; i < arity; ++i) {
+            const char ty = typeAttributes.at(i)[0];
+            if (ty == 'r' || ty == '+') {
+                throw std::invalid_argument(
+                        "The binary fact format does not support record or ADT attributes.");
+            }
+        }
+    }
+
+    ~WriteStreamBinary() override {
+        writeFile();
+    }
+
+protected:
+    void writeNullary() override {
+        nonEmptyNullary = true;
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        for (std::size_t i = 0; i < arity; ++i) {
+            RamDomain value = tuple[i];
+            if (typeAttributes.at(i)[0] == 's') {
+                value = encodeLocalSymbol(value);
+            }
+            columns[i].push_back(value);
+        }
+    }
+
+private:
+    /**
+     * Maps the given symbol-table index to its index within the symbol
+     * segment of this file, registering the symbol if necessary.
+     */
+    RamDomain encodeLocalSymbol(const RamDomain value) {
+        auto it = localSymbolIndex.find(value);
+        if (it != localSymbolIndex.end()) {
+            return it->second;
+        }
+        const RamDomain local = static_cast<RamDomain>(localSymbols.size());
+        localSymbolIndex[value] = local;
+        localSymbols.push_back(value);
+        return local;
+    }
+
+    /** Writes header, symbol segment and column segment of the file. */
+    void writeFile() {
+        const uint64_t tupleCount = (arity == 0) ? (nonEmptyNullary ? 1 : 0) : columns[0].size();
+
+        writeValue(binaryformat::magicNumber);
+        writeValue(binaryformat::formatVersion);
+        writeValue(static_cast<uint32_t>(sizeof(RamDomain)));
+        writeValue(static_cast<uint32_t>(arity));
+        writeValue(tupleCount);
+        writeValue(static_cast<uint64_t>(localSymbols.size()));
+
+        for (const RamDomain symbol : localSymbols) {
+            const std::string& text = symbolTable.decode(symbol);
+            writeValue(static_cast<uint32_t>(text.size()));
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        }
+
+        for (const auto& column : columns) {
+            file.write(reinterpret_cast<const char*>(column.data()),
+                    static_cast<std::streamsize>(column.size() * sizeof(RamDomain)));
+        }
+    }
+
+    template <typename T>
+    void writeValue(const T value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].facts.bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return output filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".facts.bin");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "output-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    std::ofstream file;
+
+    // the buffered relation content in columnar layout
+    std::vector<std::vector<RamDomain>> columns;
+
+    // the symbols referenced by this file, in symbol-segment order
+    std::vector<RamDomain> localSymbols;
+    std::unordered_map<RamDomain, RamDomain> localSymbolIndex;
+
+    // whether a non-empty nullary relation was written
+    bool nonEmptyNullary = false;
+};
+
+class WriteBinaryFactory : public WriteStreamFactory {
+public:
+    Own<WriteStream> getWriter(const std::map<std::string, std::string>& rwOperation,
+            const SymbolTable& symbolTable, const RecordTable& recordTable) override {
+        return mk<WriteStreamBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+    ~WriteBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
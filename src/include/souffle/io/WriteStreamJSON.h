@@ -20,9 +20,9 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/json11.h"
 
+#include <cstdio>
 #include <map>
 #include <ostream>
-#include <queue>
 #include <stack>
 #include <string>
 #include <variant>
@@ -42,6 +42,10 @@ protected:
             if (err.length() > 0) {
                 fatal("cannot get internal param names: %s", err);
             }
+            // render the attribute names once instead of per tuple
+            for (std::size_t col = 0; col < arity; ++col) {
+                attributePrefixes.push_back(params["relation"]["params"][col].dump() + ": ");
+            }
         }
     };
 
@@ -49,139 +53,122 @@ protected:
     Json params;
 
     void writeNextTupleJSON(std::ostream& destination, const RamDomain* tuple) {
-        std::vector<Json> result;
-
-        if (useObjects)
-            destination << "{";
-        else
-            destination << "[";
-
+        // tuples are serialised into a reusable buffer and written out in
+        // one piece; json11 objects are only used for the schema metadata
+        buffer.clear();
+        buffer.push_back(useObjects ? '{' : '[');
         for (std::size_t col = 0; col < arity; ++col) {
             if (col > 0) {
-                destination << ", ";
+                buffer.append(", ");
             }
-
             if (useObjects) {
-                destination << params["relation"]["params"][col].dump() << ": ";
-                writeNextTupleObject(destination, typeAttributes.at(col), tuple[col]);
-            } else {
-                writeNextTupleList(destination, typeAttributes.at(col), tuple[col]);
+                buffer.append(attributePrefixes[col]);
             }
+            appendValue(typeAttributes.at(col), tuple[col]);
         }
-
-        if (useObjects)
-            destination << "}";
-        else
-            destination << "]";
+        buffer.push_back(useObjects ? '}' : ']');
+        destination.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
     }
 
-    void writeNextTupleList(std::ostream& destination, const std::string& name, const RamDomain value) {
-        using ValueTuple = std::pair<const std::string, const RamDomain>;
-        std::stack<std::variant<ValueTuple, std::string>> worklist;
-        worklist.push(std::make_pair(name, value));
+private:
+    /** Record metadata resolved from the schema once per record type. */
+    struct RecordInfo {
+        std::size_t arity;
+        std::vector<std::string> types;
+        // pre-rendered '"name": ' prefix per field; object format only
+        std::vector<std::string> prefixes;
+    };
 
-        // the Json11 output is not tail recursive, therefore highly inefficient for recursive record
-        // in addition the JSON object is immutable, so has memory overhead
-        while (!worklist.empty()) {
-            std::variant<ValueTuple, std::string> curr = worklist.top();
-            worklist.pop();
+    /** The reusable per-tuple serialisation buffer. */
+    std::string buffer;
 
-            if (std::holds_alternative<std::string>(curr)) {
-                destination << std::get<std::string>(curr);
-                continue;
-            }
+    /** Pre-rendered '"name": ' prefix per attribute; object format only. */
+    std::vector<std::string> attributePrefixes;
 
-            const std::string& currType = std::get<ValueTuple>(curr).first;
-            const RamDomain currValue = std::get<ValueTuple>(curr).second;
-            assert(currType.length() > 2 && "Invalid type length");
-            switch (currType[0]) {
-                // since some strings may need to be escaped, we use dump here
-                case 's': destination << Json(symbolTable.decode(currValue)).dump(); break;
-                case 'i': destination << currValue; break;
-                case 'u': destination << (int)ramBitCast<RamUnsigned>(currValue); break;
-                case 'f': destination << ramBitCast<RamFloat>(currValue); break;
-                case 'r': {
-                    auto&& recordInfo = types["records"][currType];
-                    assert(!recordInfo.is_null() && "Missing record type information");
-                    if (currValue == 0) {
-                        destination << "null";
-                        break;
-                    }
+    /** Cache of record metadata, keyed by the record type attribute. */
+    std::map<std::string, RecordInfo> recordCache;
 
-                    auto&& recordTypes = recordInfo["types"];
-                    const std::size_t recordArity = recordInfo["arity"].long_value();
-                    const RamDomain* tuplePtr = recordTable.unpack(currValue, recordArity);
-                    worklist.push("]");
-                    for (auto i = (long long)(recordArity - 1); i >= 0; --i) {
-                        if (i != (long long)(recordArity - 1)) {
-                            worklist.push(", ");
-                        }
-                        const std::string& recordType = recordTypes[i].string_value();
-                        const RamDomain recordValue = tuplePtr[i];
-                        worklist.push(std::make_pair(recordType, recordValue));
-                    }
+    const RecordInfo& lookupRecord(const std::string& currType) {
+        auto it = recordCache.find(currType);
+        if (it != recordCache.end()) {
+            return it->second;
+        }
 
-                    worklist.push("[");
-                    break;
-                }
-                default: fatal("unsupported type attribute: `%c`", currType[0]);
+        auto&& recordInfo = types["records"][currType];
+        assert(!recordInfo.is_null() && "Missing record type information");
+        RecordInfo info;
+        info.arity = recordInfo["arity"].long_value();
+        auto&& recordTypes = recordInfo["types"];
+        for (std::size_t i = 0; i < info.arity; ++i) {
+            info.types.push_back(recordTypes[i].string_value());
+        }
+        if (useObjects) {
+            auto&& recordParams = params["records"][currType.substr(2)]["params"];
+            for (std::size_t i = 0; i < info.arity; ++i) {
+                assert(recordParams[i].is_string());
+                info.prefixes.push_back(recordParams[i].dump() + ": ");
             }
         }
+        return recordCache.emplace(currType, std::move(info)).first->second;
+    }
+
+    void appendNumber(const long long value) {
+        char temp[32];
+        const int len = snprintf(temp, sizeof(temp), "%lld", value);
+        buffer.append(temp, len);
     }
 
-    void writeNextTupleObject(std::ostream& destination, const std::string& name, const RamDomain value) {
-        using ValueTuple = std::pair<const std::string, const RamDomain>;
-        std::stack<std::variant<ValueTuple, std::string>> worklist;
-        worklist.push(std::make_pair(name, value));
+    void appendFloat(const RamFloat value) {
+        // the %g rendering matches the former ostream output
+        char temp[32];
+        const int len = snprintf(temp, sizeof(temp), "%g", static_cast<double>(value));
+        buffer.append(temp, len);
+    }
+
+    void appendValue(const std::string& name, const RamDomain value) {
+        using ValueTuple = std::pair<const std::string*, RamDomain>;
+        std::stack<std::variant<ValueTuple, const char*>> worklist;
+        worklist.push(std::make_pair(&name, value));
 
-        // the Json11 output is not tail recursive, therefore highly inefficient for recursive record
-        // in addition the JSON object is immutable, so has memory overhead
+        // records are flattened iteratively; the recursion of the json11
+        // output is not tail recursive and highly inefficient for deep ones
         while (!worklist.empty()) {
-            std::variant<ValueTuple, std::string> curr = worklist.top();
+            std::variant<ValueTuple, const char*> curr = worklist.top();
             worklist.pop();
 
-            if (std::holds_alternative<std::string>(curr)) {
-                destination << std::get<std::string>(curr);
+            if (std::holds_alternative<const char*>(curr)) {
+                buffer.append(std::get<const char*>(curr));
                 continue;
             }
 
-            const std::string& currType = std::get<ValueTuple>(curr).first;
+            const std::string& currType = *std::get<ValueTuple>(curr).first;
             const RamDomain currValue = std::get<ValueTuple>(curr).second;
-            const std::string& typeName = currType.substr(2);
             assert(currType.length() > 2 && "Invalid type length");
             switch (currType[0]) {
-                // since some strings may need to be escaped, we use dump here
-                case 's': destination << Json(symbolTable.decode(currValue)).dump(); break;
-                case 'i': destination << currValue; break;
-                case 'u': destination << (int)ramBitCast<RamUnsigned>(currValue); break;
-                case 'f': destination << ramBitCast<RamFloat>(currValue); break;
+                // symbols are escape-encoded straight into the buffer
+                case 's': json11::dump(symbolTable.decode(currValue), buffer); break;
+                case 'i': appendNumber(currValue); break;
+                case 'u': appendNumber((int)ramBitCast<RamUnsigned>(currValue)); break;
+                case 'f': appendFloat(ramBitCast<RamFloat>(currValue)); break;
                 case 'r': {
-                    auto&& recordInfo = types["records"][currType];
-                    assert(!recordInfo.is_null() && "Missing record type information");
+                    const RecordInfo& info = lookupRecord(currType);
                     if (currValue == 0) {
-                        destination << "null";
+                        buffer.append("null");
                         break;
                     }
 
-                    auto&& recordTypes = recordInfo["types"];
-                    const std::size_t recordArity = recordInfo["arity"].long_value();
-                    const RamDomain* tuplePtr = recordTable.unpack(currValue, recordArity);
-                    worklist.push("}");
-                    for (auto i = (long long)(recordArity - 1); i >= 0; --i) {
-                        if (i != (long long)(recordArity - 1)) {
+                    const RamDomain* tuplePtr = recordTable.unpack(currValue, info.arity);
+                    worklist.push(useObjects ? "}" : "]");
+                    for (auto i = (long long)(info.arity - 1); i >= 0; --i) {
+                        if (i != (long long)(info.arity - 1)) {
                             worklist.push(", ");
                         }
-                        const std::string& recordType = recordTypes[i].string_value();
-                        const RamDomain recordValue = tuplePtr[i];
-                        worklist.push(std::make_pair(recordType, recordValue));
-                        worklist.push(": ");
-
-                        auto&& recordParam = params["records"][typeName]["params"][i];
-                        assert(recordParam.is_string());
-                        worklist.push(recordParam.dump());
+                        worklist.push(std::make_pair(&info.types[i], tuplePtr[i]));
+                        if (useObjects) {
+                            worklist.push(info.prefixes[i].c_str());
+                        }
                     }
-
-                    worklist.push("{");
+                    worklist.push(useObjects ? "{" : "[");
                     break;
                 }
                 default: fatal("unsupported type attribute: `%c`", currType[0]);
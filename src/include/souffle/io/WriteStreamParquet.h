@@ -0,0 +1,231 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file WriteStreamParquet.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/WriteStream.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/io/api.h>
+#include <parquet/arrow/writer.h>
+#include <parquet/exception.h>
+
+namespace souffle {
+
+/**
+ * A write stream serialising a relation to an Apache Parquet file. Symbol
+ * attributes become dictionary-encoded string columns: tuples only carry
+ * dictionary indices, and the distinct symbols are emitted once - mirroring
+ * the flyweight representation of the symbol table. All other attributes are
+ * stored as 64-bit numeric columns.
+ */
+class WriteStreamParquet : public WriteStream {
+public:
+    WriteStreamParquet(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable)
+            : WriteStream(rwOperation, symbolTable, recordTable), fileName(getFileName(rwOperation)) {
+        columns.resize(arity);
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (typeAttributes.at(i)[0] == 's') {
+                symbolColumns.emplace(i, SymbolColumn());
+            }
+        }
+    }
+
+    ~WriteStreamParquet() override {
+        writeFile();
+    }
+
+protected:
+    void writeNullary() override {}
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        for (std::size_t i = 0; i < arity; ++i) {
+            const auto symbolColumn = symbolColumns.find(i);
+            if (symbolColumn != symbolColumns.end()) {
+                columns[i].push_back(encodeLocalSymbol(symbolColumn->second, tuple[i]));
+            } else {
+                columns[i].push_back(tuple[i]);
+            }
+        }
+        ++numRows;
+    }
+
+private:
+    /** The dictionary of a symbol attribute, indexed in order of appearance. */
+    struct SymbolColumn {
+        std::unordered_map<RamDomain, std::int32_t> index;
+        std::vector<RamDomain> symbols;
+    };
+
+    /** Maps a symbol-table index to the dictionary index of the given column. */
+    RamDomain encodeLocalSymbol(SymbolColumn& column, const RamDomain value) {
+        const auto pos = column.index.find(value);
+        if (pos != column.index.end()) {
+            return pos->second;
+        }
+        const auto localIndex = static_cast<std::int32_t>(column.symbols.size());
+        column.index.emplace(value, localIndex);
+        column.symbols.push_back(value);
+        return localIndex;
+    }
+
+    /** Assembles the buffered columns into an arrow table and writes it. */
+    void writeFile() {
+        if (arity == 0) {
+            return;
+        }
+
+        const auto columnNames = params["relation"]["params"].array_items();
+
+        std::vector<std::shared_ptr<arrow::Field>> fields;
+        std::vector<std::shared_ptr<arrow::Array>> arrays;
+        for (std::size_t i = 0; i < arity; ++i) {
+            const std::string columnName =
+                    columnNames[i].is_string() ? columnNames[i].string_value() : std::to_string(i);
+
+            const auto symbolColumn = symbolColumns.find(i);
+            if (symbolColumn != symbolColumns.end()) {
+                arrays.push_back(makeSymbolArray(columns[i], symbolColumn->second));
+                fields.push_back(
+                        arrow::field(columnName, arrow::dictionary(arrow::int32(), arrow::utf8())));
+            } else {
+                arrays.push_back(makeNumericArray(columns[i], typeAttributes.at(i)[0]));
+                fields.push_back(arrow::field(columnName, arrays.back()->type()));
+            }
+            // the buffered column is no longer needed once converted
+            columns[i].clear();
+            columns[i].shrink_to_fit();
+        }
+
+        const auto table =
+                arrow::Table::Make(arrow::schema(fields), arrays, static_cast<std::int64_t>(numRows));
+
+        PARQUET_ASSIGN_OR_THROW(const auto file, arrow::io::FileOutputStream::Open(fileName));
+        PARQUET_THROW_NOT_OK(parquet::arrow::WriteTable(
+                *table, arrow::default_memory_pool(), file, static_cast<std::int64_t>(rowGroupSize)));
+        PARQUET_THROW_NOT_OK(file->Close());
+    }
+
+    /** Builds the dictionary-encoded string array of a symbol attribute. */
+    std::shared_ptr<arrow::Array> makeSymbolArray(
+            const std::vector<RamDomain>& values, const SymbolColumn& column) {
+        arrow::StringBuilder dictionaryBuilder;
+        for (const RamDomain symbol : column.symbols) {
+            PARQUET_THROW_NOT_OK(dictionaryBuilder.Append(symbolTable.decode(symbol)));
+        }
+        std::shared_ptr<arrow::Array> dictionary;
+        PARQUET_THROW_NOT_OK(dictionaryBuilder.Finish(&dictionary));
+
+        arrow::Int32Builder indexBuilder;
+        PARQUET_THROW_NOT_OK(indexBuilder.Reserve(static_cast<std::int64_t>(values.size())));
+        for (const RamDomain value : values) {
+            indexBuilder.UnsafeAppend(static_cast<std::int32_t>(value));
+        }
+        std::shared_ptr<arrow::Array> indices;
+        PARQUET_THROW_NOT_OK(indexBuilder.Finish(&indices));
+
+        PARQUET_ASSIGN_OR_THROW(const auto array,
+                arrow::DictionaryArray::FromArrays(
+                        arrow::dictionary(arrow::int32(), arrow::utf8()), indices, dictionary));
+        return array;
+    }
+
+    /** Builds the 64-bit numeric array of a non-symbol attribute. */
+    std::shared_ptr<arrow::Array> makeNumericArray(
+            const std::vector<RamDomain>& values, const char typeAttribute) {
+        std::shared_ptr<arrow::Array> array;
+        switch (typeAttribute) {
+            case 'u': {
+                arrow::UInt64Builder builder;
+                PARQUET_THROW_NOT_OK(builder.Reserve(static_cast<std::int64_t>(values.size())));
+                for (const RamDomain value : values) {
+                    builder.UnsafeAppend(static_cast<std::uint64_t>(ramBitCast<RamUnsigned>(value)));
+                }
+                PARQUET_THROW_NOT_OK(builder.Finish(&array));
+                break;
+            }
+            case 'f': {
+                arrow::DoubleBuilder builder;
+                PARQUET_THROW_NOT_OK(builder.Reserve(static_cast<std::int64_t>(values.size())));
+                for (const RamDomain value : values) {
+                    builder.UnsafeAppend(static_cast<double>(ramBitCast<RamFloat>(value)));
+                }
+                PARQUET_THROW_NOT_OK(builder.Finish(&array));
+                break;
+            }
+            default: {
+                arrow::Int64Builder builder;
+                PARQUET_THROW_NOT_OK(builder.Reserve(static_cast<std::int64_t>(values.size())));
+                for (const RamDomain value : values) {
+                    builder.UnsafeAppend(static_cast<std::int64_t>(value));
+                }
+                PARQUET_THROW_NOT_OK(builder.Finish(&array));
+                break;
+            }
+        }
+        return array;
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].parquet
+     *
+     * @param rwOperation map of IO configuration options
+     * @return output filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".parquet");
+        if (name.front() != '/') {
+            name = getOr(rwOperation, "output-dir", ".") + "/" + name;
+        }
+        return name;
+    }
+
+    static constexpr std::size_t rowGroupSize = 1u << 20;
+
+    const std::string fileName;
+
+    // the relation content in columnar layout; symbol attributes hold
+    // dictionary indices instead of symbol-table indices
+    std::vector<std::vector<RamDomain>> columns;
+    std::map<std::size_t, SymbolColumn> symbolColumns;
+    std::size_t numRows = 0;
+};
+
+class WriteParquetFactory : public WriteStreamFactory {
+public:
+    Own<WriteStream> getWriter(const std::map<std::string, std::string>& rwOperation,
+            const SymbolTable& symbolTable, const RecordTable& recordTable) override {
+        return mk<WriteStreamParquet>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "parquet";
+        return name;
+    }
+    ~WriteParquetFactory() override = default;
+};
+
+} /* namespace souffle */
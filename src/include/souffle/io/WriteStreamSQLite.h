@@ -18,6 +18,7 @@
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/io/WriteStream.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -37,16 +38,20 @@ public:
     WriteStreamSQLite(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
             const RecordTable& recordTable)
             : WriteStream(rwOperation, symbolTable, recordTable), dbFilename(getFileName(rwOperation)),
-              relationName(rwOperation.at("name")) {
+              relationName(rwOperation.at("name")),
+              batchRows(arity == 0 ? 1 : std::max<std::size_t>(maxBoundVariables / arity, 1)) {
         openDB();
         createTables();
         prepareStatements();
+        batchBuffer.reserve(batchRows * arity);
         executeSQL("BEGIN TRANSACTION", db);
     }
 
     ~WriteStreamSQLite() override {
+        flushRemainder();
         executeSQL("COMMIT", db);
         sqlite3_finalize(insertStatement);
+        sqlite3_finalize(batchInsertStatement);
         sqlite3_finalize(symbolInsertStatement);
         sqlite3_finalize(symbolSelectStatement);
         sqlite3_close(db);
@@ -56,6 +61,8 @@ protected:
     void writeNullary() override {}
 
     void writeNextTuple(const RamDomain* tuple) override {
+        // tuples are buffered and inserted many rows per statement step,
+        // which avoids the per-tuple step/reset round-trip through SQLite
         for (std::size_t i = 0; i < arity; i++) {
             RamDomain value = 0;  // Silence warning
 
@@ -63,20 +70,11 @@ protected:
                 case 's': value = getSymbolTableID(tuple[i]); break;
                 default: value = tuple[i]; break;
             }
-
-#if RAM_DOMAIN_SIZE == 64
-            if (sqlite3_bind_int64(insertStatement, i + 1, value) != SQLITE_OK) {
-#else
-            if (sqlite3_bind_int(insertStatement, i + 1, value) != SQLITE_OK) {
-#endif
-                throwError("SQLite error in sqlite3_bind_text: ");
-            }
+            batchBuffer.push_back(value);
         }
-        if (sqlite3_step(insertStatement) != SQLITE_DONE) {
-            throwError("SQLite error in sqlite3_step: ");
+        if (++bufferedRows == batchRows) {
+            flushBatch();
         }
-        sqlite3_clear_bindings(insertStatement);
-        sqlite3_reset(insertStatement);
     }
 
 private:
@@ -102,6 +100,46 @@ private:
         throw std::invalid_argument(error.str());
     }
 
+    void bindValue(sqlite3_stmt* statement, const int position, const RamDomain value) {
+#if RAM_DOMAIN_SIZE == 64
+        if (sqlite3_bind_int64(statement, position, value) != SQLITE_OK) {
+#else
+        if (sqlite3_bind_int(statement, position, value) != SQLITE_OK) {
+#endif
+            throwError("SQLite error in sqlite3_bind_int: ");
+        }
+    }
+
+    /** Inserts a full buffer of batchRows rows with a single statement step. */
+    void flushBatch() {
+        for (std::size_t i = 0; i < batchBuffer.size(); i++) {
+            bindValue(batchInsertStatement, static_cast<int>(i + 1), batchBuffer[i]);
+        }
+        if (sqlite3_step(batchInsertStatement) != SQLITE_DONE) {
+            throwError("SQLite error in sqlite3_step: ");
+        }
+        sqlite3_clear_bindings(batchInsertStatement);
+        sqlite3_reset(batchInsertStatement);
+        batchBuffer.clear();
+        bufferedRows = 0;
+    }
+
+    /** Inserts the trailing rows not filling a full batch, one row at a time. */
+    void flushRemainder() {
+        for (std::size_t row = 0; row < bufferedRows; row++) {
+            for (std::size_t i = 0; i < arity; i++) {
+                bindValue(insertStatement, static_cast<int>(i + 1), batchBuffer[row * arity + i]);
+            }
+            if (sqlite3_step(insertStatement) != SQLITE_DONE) {
+                throwError("SQLite error in sqlite3_step: ");
+            }
+            sqlite3_clear_bindings(insertStatement);
+            sqlite3_reset(insertStatement);
+        }
+        batchBuffer.clear();
+        bufferedRows = 0;
+    }
+
     uint64_t getSymbolTableIDFromDB(int index) {
         if (sqlite3_bind_text(symbolSelectStatement, 1, symbolTable.decode(index).c_str(), -1,
                     SQLITE_TRANSIENT) != SQLITE_OK) {
@@ -116,8 +154,9 @@ private:
         return rowid;
     }
     uint64_t getSymbolTableID(int index) {
-        if (dbSymbolTable.count(index) != 0) {
-            return dbSymbolTable[index];
+        const auto cached = dbSymbolTable.find(index);
+        if (cached != dbSymbolTable.end()) {
+            return cached->second;
         }
 
         if (sqlite3_bind_text(symbolInsertStatement, 1, symbolTable.decode(index).c_str(), -1,
@@ -150,6 +189,7 @@ private:
 
     void prepareStatements() {
         prepareInsertStatement();
+        prepareBatchInsertStatement();
         prepareSymbolInsertStatement();
         prepareSymbolSelectStatement();
     }
@@ -187,6 +227,26 @@ private:
         }
     }
 
+    void prepareBatchInsertStatement() {
+        if (arity == 0) {
+            return;
+        }
+        std::stringstream insertSQL;
+        insertSQL << "INSERT INTO '_" << relationName << "' VALUES ";
+        for (std::size_t row = 0; row < batchRows; row++) {
+            insertSQL << (row == 0 ? "(" : ",(");
+            for (unsigned int i = 0; i < arity; i++) {
+                insertSQL << (i == 0 ? "?" : ",?");
+            }
+            insertSQL << ")";
+        }
+        insertSQL << ";";
+        const char* tail = nullptr;
+        if (sqlite3_prepare_v2(db, insertSQL.str().c_str(), -1, &batchInsertStatement, &tail) != SQLITE_OK) {
+            throwError("SQLite error in sqlite3_prepare_v2: ");
+        }
+    }
+
     void createTables() {
         createRelationTable();
         createRelationView();
@@ -276,12 +336,22 @@ private:
         return name;
     }
 
+    // keep a full batch within SQLite's default bound-variable limit
+    static constexpr std::size_t maxBoundVariables = 999;
+
     const std::string dbFilename;
     const std::string relationName;
     const std::string symbolTableName = "__SymbolTable";
 
+    /** Number of rows inserted per step of the batch insert statement. */
+    const std::size_t batchRows;
+    /** Row-major buffer of translated but not yet inserted tuples. */
+    std::vector<RamDomain> batchBuffer;
+    std::size_t bufferedRows = 0;
+
     std::unordered_map<uint64_t, uint64_t> dbSymbolTable;
     sqlite3_stmt* insertStatement = nullptr;
+    sqlite3_stmt* batchInsertStatement = nullptr;
     sqlite3_stmt* symbolInsertStatement = nullptr;
     sqlite3_stmt* symbolSelectStatement = nullptr;
     sqlite3* db = nullptr;
@@ -15,10 +15,14 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <zlib.h>
 
 namespace souffle {
@@ -55,12 +59,29 @@ public:
         }
         isOpen = true;
 
+        // input streams decompress ahead on a background thread, so that
+        // the consumer works on one window while the next one is inflated
+        if ((mode & std::ios::in) != 0) {
+            for (auto& window : windows) {
+                window.data.resize(reserveSize + windowSize);
+            }
+            decompressor = std::thread([this] { readahead(); });
+        }
+
         return this;
     }
 
     gzfstreambuf* close() {
         if (is_open()) {
             sync();
+            if (decompressor.joinable()) {
+                {
+                    std::unique_lock<std::mutex> guard(windowLock);
+                    closing = true;
+                }
+                windowState.notify_all();
+                decompressor.join();
+            }
             isOpen = false;
             if (gzclose(fileHandle) == Z_OK) {
                 return this;
@@ -112,14 +133,22 @@ protected:
         if (charsPutBack > reserveSize) {
             charsPutBack = reserveSize;
         }
-        memcpy(buffer + reserveSize - charsPutBack, gptr() - charsPutBack, charsPutBack);
 
-        int charsRead = gzread(fileHandle, buffer + reserveSize, bufferSize - reserveSize);
-        if (charsRead <= 0) {
+        // switch over to the next window decompressed in the background
+        std::unique_lock<std::mutex> guard(windowLock);
+        windowState.wait(guard, [&] { return produced > consumed; });
+        Window& window = windows[consumed % 2];
+        if (window.size <= 0) {
             return EOF;
         }
 
-        setg(buffer + reserveSize - charsPutBack, buffer + reserveSize, buffer + reserveSize + charsRead);
+        char* base = window.data.data();
+        memcpy(base + reserveSize - charsPutBack, gptr() - charsPutBack, charsPutBack);
+        setg(base + reserveSize - charsPutBack, base + reserveSize, base + reserveSize + window.size);
+
+        // release the previous window for refilling
+        ++consumed;
+        windowState.notify_all();
 
         return traits_type::to_int_type(*gptr());
     }
@@ -136,13 +165,57 @@ protected:
     }
 
 private:
+    /**
+     * The decompression loop run by the background thread of input streams.
+     * Windows are filled in rotating order; a window may be re-filled once
+     * the consumer has moved past the window occupying the same slot.
+     */
+    void readahead() {
+        while (true) {
+            std::unique_lock<std::mutex> guard(windowLock);
+            windowState.wait(guard, [&] { return closing || produced < 2 || produced <= consumed; });
+            if (closing) {
+                break;
+            }
+            Window& window = windows[produced % 2];
+            guard.unlock();
+
+            const int charsRead = gzread(fileHandle, window.data.data() + reserveSize, windowSize);
+
+            guard.lock();
+            window.size = charsRead;
+            ++produced;
+            windowState.notify_all();
+            if (charsRead <= 0) {
+                // end of input or error - publish and terminate
+                break;
+            }
+        }
+    }
+
     static constexpr unsigned int bufferSize = 65536;
     static constexpr unsigned int reserveSize = 16;
+    static constexpr int windowSize = 1 << 20;
 
     char buffer[bufferSize] = {};
     gzFile fileHandle = {};
     bool isOpen = false;
     std::ios_base::openmode mode = std::ios_base::in;
+
+    /** A decompressed input window handed from the background thread to the consumer. */
+    struct Window {
+        std::vector<char> data;
+        int size = 0;
+    };
+
+    // double-buffered readahead state (input mode only)
+    Window windows[2];
+    std::size_t produced = 0;
+    std::size_t consumed = 0;
+    bool closing = false;
+    std::mutex windowLock;
+    std::condition_variable windowState;
+    std::thread decompressor;
 };
 
 class gzfstream : virtual public std::ios {
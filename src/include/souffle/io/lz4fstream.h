@@ -0,0 +1,311 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file lz4fstream.h
+ * A simple lz4 frame-format wrapper to provide compressed file streams.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <lz4frame.h>
+#include <string>
+#include <vector>
+
+namespace souffle {
+
+namespace lz4fstream {
+
+namespace internal {
+
+class lz4fstreambuf : public std::streambuf {
+public:
+    lz4fstreambuf() {
+        setp(buffer, buffer + (bufferSize - 1));
+        setg(buffer + reserveSize, buffer + reserveSize, buffer + reserveSize);
+    }
+
+    lz4fstreambuf(const lz4fstreambuf&) = delete;
+
+    lz4fstreambuf(lz4fstreambuf&& old) = default;
+
+    lz4fstreambuf* open(const std::string& filename, std::ios_base::openmode mode) {
+        if (is_open()) {
+            return nullptr;
+        }
+        if ((mode ^ std::ios::in ^ std::ios::out) == 0) {
+            return nullptr;
+        }
+
+        this->mode = mode;
+        fileHandle = fopen(filename.c_str(), (mode & std::ios::in) != 0 ? "rb" : "wb");
+        if (fileHandle == nullptr) {
+            return nullptr;
+        }
+
+        if ((mode & std::ios::in) != 0) {
+            if (LZ4F_isError(LZ4F_createDecompressionContext(&dctx, LZ4F_VERSION)) != 0) {
+                fclose(fileHandle);
+                return nullptr;
+            }
+            compressed.resize(bufferSize);
+            window.resize(reserveSize + (1 << 18));
+        } else {
+            if (LZ4F_isError(LZ4F_createCompressionContext(&cctx, LZ4F_VERSION)) != 0) {
+                fclose(fileHandle);
+                return nullptr;
+            }
+            compressed.resize(LZ4F_compressBound(bufferSize, nullptr) + LZ4F_HEADER_SIZE_MAX);
+            const std::size_t headerSize =
+                    LZ4F_compressBegin(cctx, compressed.data(), compressed.size(), nullptr);
+            if (LZ4F_isError(headerSize) != 0 ||
+                    fwrite(compressed.data(), 1, headerSize, fileHandle) != headerSize) {
+                LZ4F_freeCompressionContext(cctx);
+                cctx = nullptr;
+                fclose(fileHandle);
+                return nullptr;
+            }
+        }
+        isOpen = true;
+
+        return this;
+    }
+
+    lz4fstreambuf* close() {
+        if (!is_open()) {
+            return nullptr;
+        }
+        bool ok = sync() == 0;
+        if (cctx != nullptr) {
+            const std::size_t epilogueSize =
+                    LZ4F_compressEnd(cctx, compressed.data(), compressed.size(), nullptr);
+            if (LZ4F_isError(epilogueSize) != 0 ||
+                    fwrite(compressed.data(), 1, epilogueSize, fileHandle) != epilogueSize) {
+                ok = false;
+            }
+            LZ4F_freeCompressionContext(cctx);
+            cctx = nullptr;
+        }
+        if (dctx != nullptr) {
+            LZ4F_freeDecompressionContext(dctx);
+            dctx = nullptr;
+        }
+        isOpen = false;
+        if (fclose(fileHandle) != 0) {
+            ok = false;
+        }
+        return ok ? this : nullptr;
+    }
+
+    bool is_open() const {
+        return isOpen;
+    }
+
+    ~lz4fstreambuf() override {
+        try {
+            close();
+        } catch (...) {
+            // Don't throw exceptions.
+        }
+    }
+
+protected:
+    int_type overflow(int c = EOF) override {
+        if (((mode & std::ios::out) == 0) || !isOpen) {
+            return EOF;
+        }
+
+        if (c != EOF) {
+            *pptr() = c;
+            pbump(1);
+        }
+        if (compress() != 0) {
+            return EOF;
+        }
+
+        return c;
+    }
+
+    int_type underflow() override {
+        if (((mode & std::ios::in) == 0) || !isOpen) {
+            return EOF;
+        }
+        if ((gptr() != nullptr) && (gptr() < egptr())) {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        unsigned charsPutBack = gptr() - eback();
+        if (charsPutBack > reserveSize) {
+            charsPutBack = reserveSize;
+        }
+
+        std::size_t produced = 0;
+        while (produced == 0) {
+            if (inputPos == inputSize) {
+                inputSize = fread(compressed.data(), 1, compressed.size(), fileHandle);
+                inputPos = 0;
+                if (inputSize == 0) {
+                    return EOF;
+                }
+            }
+            std::size_t dstSize = window.size() - reserveSize;
+            std::size_t srcSize = inputSize - inputPos;
+            if (LZ4F_isError(LZ4F_decompress(dctx, window.data() + reserveSize, &dstSize,
+                        compressed.data() + inputPos, &srcSize, nullptr)) != 0) {
+                return EOF;
+            }
+            inputPos += srcSize;
+            produced = dstSize;
+        }
+
+        char* base = window.data();
+        memcpy(base + reserveSize - charsPutBack, gptr() - charsPutBack, charsPutBack);
+        setg(base + reserveSize - charsPutBack, base + reserveSize, base + reserveSize + produced);
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int sync() override {
+        if ((pptr() != nullptr) && pptr() > pbase()) {
+            if (compress() != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    /** Compress the put area into the next frame block and write it out;
+     * returns 0 on success. */
+    int compress() {
+        const std::size_t toWrite = pptr() - pbase();
+        if (toWrite == 0) {
+            return 0;
+        }
+        const std::size_t produced =
+                LZ4F_compressUpdate(cctx, compressed.data(), compressed.size(), pbase(), toWrite, nullptr);
+        if (LZ4F_isError(produced) != 0 ||
+                fwrite(compressed.data(), 1, produced, fileHandle) != produced) {
+            return -1;
+        }
+        pbump(-static_cast<int>(toWrite));
+        return 0;
+    }
+
+    static constexpr unsigned int bufferSize = 65536;
+    static constexpr unsigned int reserveSize = 16;
+
+    char buffer[bufferSize] = {};
+    FILE* fileHandle = nullptr;
+    bool isOpen = false;
+    std::ios_base::openmode mode = std::ios_base::in;
+
+    LZ4F_cctx* cctx = nullptr;
+    LZ4F_dctx* dctx = nullptr;
+    /** Compressed data staging area, for either direction */
+    std::vector<char> compressed;
+    /** Decompressed window served to the consumer (input mode only) */
+    std::vector<char> window;
+    /** Compressed input not yet consumed by the context (input mode only) */
+    std::size_t inputPos = 0;
+    std::size_t inputSize = 0;
+};
+
+class lz4fstream : virtual public std::ios {
+public:
+    lz4fstream() {
+        init(&buf);
+    }
+
+    lz4fstream(const std::string& filename, std::ios_base::openmode mode) {
+        init(&buf);
+        open(filename, mode);
+    }
+
+    lz4fstream(const lz4fstream&) = delete;
+
+    lz4fstream(lz4fstream&&) = delete;
+
+    ~lz4fstream() override = default;
+
+    void open(const std::string& filename, std::ios_base::openmode mode) {
+        if (buf.open(filename, mode) == nullptr) {
+            clear(rdstate() | std::ios::badbit);
+        }
+    }
+
+    bool is_open() {
+        return buf.is_open();
+    }
+
+    void close() {
+        if (buf.is_open()) {
+            if (buf.close() == nullptr) {
+                clear(rdstate() | std::ios::badbit);
+            }
+        }
+    }
+
+    lz4fstreambuf* rdbuf() const {
+        return &buf;
+    }
+
+protected:
+    mutable lz4fstreambuf buf;
+};
+
+}  // namespace internal
+
+class ilz4fstream : public internal::lz4fstream, public std::istream {
+public:
+    ilz4fstream() : internal::lz4fstream(), std::istream(&buf) {}
+
+    explicit ilz4fstream(const std::string& filename, std::ios_base::openmode mode = std::ios::in)
+            : internal::lz4fstream(filename, mode), std::istream(&buf) {}
+
+    ilz4fstream(const ilz4fstream&) = delete;
+
+    ilz4fstream(ilz4fstream&&) = delete;
+
+    internal::lz4fstreambuf* rdbuf() const {
+        return internal::lz4fstream::rdbuf();
+    }
+
+    void open(const std::string& filename, std::ios_base::openmode mode = std::ios::in) {
+        internal::lz4fstream::open(filename, mode);
+    }
+};
+
+class olz4fstream : public internal::lz4fstream, public std::ostream {
+public:
+    olz4fstream() : std::ostream(&buf) {}
+
+    explicit olz4fstream(const std::string& filename, std::ios_base::openmode mode = std::ios::out)
+            : internal::lz4fstream(filename, mode), std::ostream(&buf) {}
+
+    olz4fstream(const olz4fstream&) = delete;
+
+    olz4fstream(olz4fstream&&) = delete;
+
+    internal::lz4fstreambuf* rdbuf() const {
+        return internal::lz4fstream::rdbuf();
+    }
+
+    void open(const std::string& filename, std::ios_base::openmode mode = std::ios::out) {
+        internal::lz4fstream::open(filename, mode);
+    }
+};
+
+} /* namespace lz4fstream */
+
+} /* namespace souffle */
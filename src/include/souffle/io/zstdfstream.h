@@ -0,0 +1,306 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file zstdfstream.h
+ * A simple zstd wrapper to provide compressed file streams. Output
+ * streams compress on the worker threads of the zstd context when the
+ * library was built with multithreading support.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <zstd.h>
+
+namespace souffle {
+
+namespace zstdfstream {
+
+namespace internal {
+
+class zstdfstreambuf : public std::streambuf {
+public:
+    zstdfstreambuf() {
+        setp(buffer, buffer + (bufferSize - 1));
+        setg(buffer + reserveSize, buffer + reserveSize, buffer + reserveSize);
+    }
+
+    zstdfstreambuf(const zstdfstreambuf&) = delete;
+
+    zstdfstreambuf(zstdfstreambuf&& old) = default;
+
+    zstdfstreambuf* open(const std::string& filename, std::ios_base::openmode mode) {
+        if (is_open()) {
+            return nullptr;
+        }
+        if ((mode ^ std::ios::in ^ std::ios::out) == 0) {
+            return nullptr;
+        }
+
+        this->mode = mode;
+        fileHandle = fopen(filename.c_str(), (mode & std::ios::in) != 0 ? "rb" : "wb");
+        if (fileHandle == nullptr) {
+            return nullptr;
+        }
+
+        if ((mode & std::ios::in) != 0) {
+            dctx = ZSTD_createDCtx();
+            compressed.resize(ZSTD_DStreamInSize());
+            input = {compressed.data(), 0, 0};
+            window.resize(reserveSize + ZSTD_DStreamOutSize());
+        } else {
+            cctx = ZSTD_createCCtx();
+            // hand the compression work to worker threads where the library
+            // supports it; on failure the frames are compressed inline
+            ZSTD_CCtx_setParameter(
+                    cctx, ZSTD_c_nbWorkers, static_cast<int>(std::thread::hardware_concurrency()));
+            compressed.resize(ZSTD_CStreamOutSize());
+        }
+        isOpen = true;
+
+        return this;
+    }
+
+    zstdfstreambuf* close() {
+        if (!is_open()) {
+            return nullptr;
+        }
+        bool ok = sync() == 0;
+        if (cctx != nullptr) {
+            // drain the end-of-frame epilogue
+            ZSTD_inBuffer in = {nullptr, 0, 0};
+            std::size_t remaining = 0;
+            do {
+                ZSTD_outBuffer out = {compressed.data(), compressed.size(), 0};
+                remaining = ZSTD_compressStream2(cctx, &out, &in, ZSTD_e_end);
+                if (ZSTD_isError(remaining) != 0 ||
+                        fwrite(compressed.data(), 1, out.pos, fileHandle) != out.pos) {
+                    ok = false;
+                    break;
+                }
+            } while (remaining != 0);
+            ZSTD_freeCCtx(cctx);
+            cctx = nullptr;
+        }
+        if (dctx != nullptr) {
+            ZSTD_freeDCtx(dctx);
+            dctx = nullptr;
+        }
+        isOpen = false;
+        if (fclose(fileHandle) != 0) {
+            ok = false;
+        }
+        return ok ? this : nullptr;
+    }
+
+    bool is_open() const {
+        return isOpen;
+    }
+
+    ~zstdfstreambuf() override {
+        try {
+            close();
+        } catch (...) {
+            // Don't throw exceptions.
+        }
+    }
+
+protected:
+    int_type overflow(int c = EOF) override {
+        if (((mode & std::ios::out) == 0) || !isOpen) {
+            return EOF;
+        }
+
+        if (c != EOF) {
+            *pptr() = c;
+            pbump(1);
+        }
+        if (compress(ZSTD_e_continue) != 0) {
+            return EOF;
+        }
+
+        return c;
+    }
+
+    int_type underflow() override {
+        if (((mode & std::ios::in) == 0) || !isOpen) {
+            return EOF;
+        }
+        if ((gptr() != nullptr) && (gptr() < egptr())) {
+            return traits_type::to_int_type(*gptr());
+        }
+
+        unsigned charsPutBack = gptr() - eback();
+        if (charsPutBack > reserveSize) {
+            charsPutBack = reserveSize;
+        }
+
+        std::size_t produced = 0;
+        while (produced == 0) {
+            if (input.pos == input.size) {
+                input.size = fread(compressed.data(), 1, compressed.size(), fileHandle);
+                input.pos = 0;
+                if (input.size == 0) {
+                    return EOF;
+                }
+            }
+            ZSTD_outBuffer out = {window.data() + reserveSize, window.size() - reserveSize, 0};
+            if (ZSTD_isError(ZSTD_decompressStream(dctx, &out, &input)) != 0) {
+                return EOF;
+            }
+            produced = out.pos;
+        }
+
+        char* base = window.data();
+        memcpy(base + reserveSize - charsPutBack, gptr() - charsPutBack, charsPutBack);
+        setg(base + reserveSize - charsPutBack, base + reserveSize, base + reserveSize + produced);
+
+        return traits_type::to_int_type(*gptr());
+    }
+
+    int sync() override {
+        if ((pptr() != nullptr) && pptr() > pbase()) {
+            if (compress(ZSTD_e_flush) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    /** Feed the put area through the compression context and write the
+     * produced frames out; returns 0 on success. */
+    int compress(ZSTD_EndDirective directive) {
+        ZSTD_inBuffer in = {pbase(), static_cast<std::size_t>(pptr() - pbase()), 0};
+        std::size_t remaining = 0;
+        do {
+            ZSTD_outBuffer out = {compressed.data(), compressed.size(), 0};
+            remaining = ZSTD_compressStream2(cctx, &out, &in, directive);
+            if (ZSTD_isError(remaining) != 0 ||
+                    fwrite(compressed.data(), 1, out.pos, fileHandle) != out.pos) {
+                return -1;
+            }
+        } while (in.pos < in.size || (directive != ZSTD_e_continue && remaining != 0));
+        pbump(-static_cast<int>(in.size));
+        return 0;
+    }
+
+    static constexpr unsigned int bufferSize = 65536;
+    static constexpr unsigned int reserveSize = 16;
+
+    char buffer[bufferSize] = {};
+    FILE* fileHandle = nullptr;
+    bool isOpen = false;
+    std::ios_base::openmode mode = std::ios_base::in;
+
+    ZSTD_CCtx* cctx = nullptr;
+    ZSTD_DCtx* dctx = nullptr;
+    /** Compressed data staging area, for either direction */
+    std::vector<char> compressed;
+    /** Decompressed window served to the consumer (input mode only) */
+    std::vector<char> window;
+    /** Compressed input not yet consumed by the context (input mode only) */
+    ZSTD_inBuffer input = {nullptr, 0, 0};
+};
+
+class zstdfstream : virtual public std::ios {
+public:
+    zstdfstream() {
+        init(&buf);
+    }
+
+    zstdfstream(const std::string& filename, std::ios_base::openmode mode) {
+        init(&buf);
+        open(filename, mode);
+    }
+
+    zstdfstream(const zstdfstream&) = delete;
+
+    zstdfstream(zstdfstream&&) = delete;
+
+    ~zstdfstream() override = default;
+
+    void open(const std::string& filename, std::ios_base::openmode mode) {
+        if (buf.open(filename, mode) == nullptr) {
+            clear(rdstate() | std::ios::badbit);
+        }
+    }
+
+    bool is_open() {
+        return buf.is_open();
+    }
+
+    void close() {
+        if (buf.is_open()) {
+            if (buf.close() == nullptr) {
+                clear(rdstate() | std::ios::badbit);
+            }
+        }
+    }
+
+    zstdfstreambuf* rdbuf() const {
+        return &buf;
+    }
+
+protected:
+    mutable zstdfstreambuf buf;
+};
+
+}  // namespace internal
+
+class izstdfstream : public internal::zstdfstream, public std::istream {
+public:
+    izstdfstream() : internal::zstdfstream(), std::istream(&buf) {}
+
+    explicit izstdfstream(const std::string& filename, std::ios_base::openmode mode = std::ios::in)
+            : internal::zstdfstream(filename, mode), std::istream(&buf) {}
+
+    izstdfstream(const izstdfstream&) = delete;
+
+    izstdfstream(izstdfstream&&) = delete;
+
+    internal::zstdfstreambuf* rdbuf() const {
+        return internal::zstdfstream::rdbuf();
+    }
+
+    void open(const std::string& filename, std::ios_base::openmode mode = std::ios::in) {
+        internal::zstdfstream::open(filename, mode);
+    }
+};
+
+class ozstdfstream : public internal::zstdfstream, public std::ostream {
+public:
+    ozstdfstream() : std::ostream(&buf) {}
+
+    explicit ozstdfstream(const std::string& filename, std::ios_base::openmode mode = std::ios::out)
+            : internal::zstdfstream(filename, mode), std::ostream(&buf) {}
+
+    ozstdfstream(const ozstdfstream&) = delete;
+
+    ozstdfstream(ozstdfstream&&) = delete;
+
+    internal::zstdfstreambuf* rdbuf() const {
+        return internal::zstdfstream::rdbuf();
+    }
+
+    void open(const std::string& filename, std::ios_base::openmode mode = std::ios::out) {
+        internal::zstdfstream::open(filename, mode);
+    }
+};
+
+} /* namespace zstdfstream */
+
+} /* namespace souffle */
@@ -32,7 +32,7 @@ public:
         int c;
         option longOptions[1];
         longOptions[0] = {nullptr, 0, nullptr, 0};
-        while ((c = getopt_long(argc, argv, "c:hj::", longOptions, nullptr)) != EOF) {
+        while ((c = getopt_long(argc, argv, "c:hj::t::", longOptions, nullptr)) != EOF) {
             // An invalid argument was given
             if (c == '?') {
                 exit(EXIT_FAILURE);
@@ -69,6 +69,10 @@ public:
                       << "-j[filename]          Generate a GUI (html/js) version of the profiler."
                       << std::endl
                       << "                      Default filename is profiler_html/[num].html" << std::endl
+                      << "-t[filename]          Generate a Chrome trace-event (perfetto) version of the "
+                         "profile."
+                      << std::endl
+                      << "                      Default filename is trace.json" << std::endl
                       << "-h                    Print this help message." << std::endl;
             exit(0);
         }
@@ -85,6 +89,12 @@ public:
             } else {
                 Tui(filename, false, true).outputHtml(args['j']);
             }
+        } else if (args.count('t') != 0) {
+            if (args['t'] == "t") {
+                Tui(filename, false, true).outputTrace();
+            } else {
+                Tui(filename, false, true).outputTrace(args['t']);
+            }
         } else {
             Tui(filename, true, false).runProf();
         }
@@ -284,6 +284,57 @@ public:
     }
 } recursiveRuleNumberProcessor;
 
+/**
+ * Non-Recursive Rule Performance Counter Event Processor
+ */
+const class NonRecursiveRuleCounterProcessor : public EventProcessor {
+public:
+    NonRecursiveRuleCounterProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@p-nonrecursive-rule", this);
+    }
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& rule = signature[3];
+        std::size_t cacheMisses = va_arg(args, std::size_t);
+        std::size_t branchMisses = va_arg(args, std::size_t);
+        std::size_t instructions = va_arg(args, std::size_t);
+        db.addSizeEntry(
+                {"program", "relation", relation, "non-recursive-rule", rule, "cache-misses"}, cacheMisses);
+        db.addSizeEntry(
+                {"program", "relation", relation, "non-recursive-rule", rule, "branch-misses"}, branchMisses);
+        db.addSizeEntry(
+                {"program", "relation", relation, "non-recursive-rule", rule, "instructions"}, instructions);
+    }
+} nonRecursiveRuleCounterProcessor;
+
+/**
+ * Recursive Rule Performance Counter Event Processor
+ */
+const class RecursiveRuleCounterProcessor : public EventProcessor {
+public:
+    RecursiveRuleCounterProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@p-recursive-rule", this);
+    }
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& version = signature[2];
+        const std::string& rule = signature[4];
+        std::size_t cacheMisses = va_arg(args, std::size_t);
+        std::size_t branchMisses = va_arg(args, std::size_t);
+        std::size_t instructions = va_arg(args, std::size_t);
+        std::string iteration = std::to_string(va_arg(args, std::size_t));
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "recursive-rule", rule,
+                                version, "cache-misses"},
+                cacheMisses);
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "recursive-rule", rule,
+                                version, "branch-misses"},
+                branchMisses);
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "recursive-rule", rule,
+                                version, "instructions"},
+                instructions);
+    }
+} recursiveRuleCounterProcessor;
+
 /**
  * Non-Recursive Relation Number Profile Event Processor
  */
@@ -374,6 +425,25 @@ public:
     }
 } recursiveRelationNumberProcessor;
 
+/**
+ * Recursive Relation Delta Profile Event Processor
+ */
+const class RecursiveRelationDeltaProcessor : public EventProcessor {
+public:
+    RecursiveRelationDeltaProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@n-recursive-delta", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& srcLocator = signature[2];
+        std::size_t number = va_arg(args, std::size_t);
+        std::string iteration = std::to_string(va_arg(args, std::size_t));
+        db.addTextEntry({"program", "relation", relation, "source-locator"}, srcLocator);
+        db.addSizeEntry({"program", "relation", relation, "iteration", iteration, "delta-tuples"}, number);
+    }
+} recursiveRelationDeltaProcessor;
+
 /**
  * Recursive Relation Copy Timing Profile Event Processor
  */
@@ -423,6 +493,27 @@ public:
     }
 } relationIOTimingProcessor;
 
+/**
+ * Relation Hint Statistics Profile Event Processor
+ */
+const class RelationHintStatisticsProcessor : public EventProcessor {
+public:
+    RelationHintStatisticsProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@hint-stats", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        const std::string& relation = signature[1];
+        const std::string& index = signature[2];
+        const std::string& operation = signature[3];
+        std::size_t hits = va_arg(args, std::size_t);
+        std::size_t misses = va_arg(args, std::size_t);
+        db.addSizeEntry({"program", "relation", relation, "hint-statistics", index, operation, "hits"}, hits);
+        db.addSizeEntry(
+                {"program", "relation", relation, "hint-statistics", index, operation, "misses"}, misses);
+    }
+} relationHintStatisticsProcessor;
+
 /**
  * Program Run Event Processor
  */
@@ -479,6 +570,23 @@ public:
     }
 } programResourceUtilisationProcessor;
 
+/**
+ * Program Memory Usage Event Processor
+ */
+const class ProgramMemoryUsageProcessor : public EventProcessor {
+public:
+    ProgramMemoryUsageProcessor() {
+        EventProcessorSingleton::instance().registerEventProcessor("@memory", this);
+    }
+    /** process event input */
+    void process(ProfileDatabase& db, const std::vector<std::string>& signature, va_list& args) override {
+        microseconds time = va_arg(args, microseconds);
+        std::size_t bytes = va_arg(args, std::size_t);
+        std::string timeString = std::to_string(time.count());
+        db.addSizeEntry({"program", "memory", "timepoint", timeString, signature[1]}, bytes);
+    }
+} programMemoryUsageProcessor;
+
 /**
  * Frequency Atom Processor
  */
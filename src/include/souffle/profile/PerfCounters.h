@@ -0,0 +1,135 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file PerfCounters.h
+ *
+ * Reads hardware performance counters through perf_event_open so that
+ * cache misses, branch misses and retired instructions can be attributed
+ * to the rule that is currently executing. Counting is process-wide and
+ * inherited by threads spawned after profiling starts. When the kernel
+ * interface is unavailable (non-Linux builds, or restrictive
+ * perf_event_paranoid settings) the counters report themselves as
+ * disabled and no counter events are emitted.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <initializer_list>
+
+#ifdef __linux__
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace souffle {
+namespace profile {
+
+/**
+ * Process-wide hardware performance counters.
+ */
+class PerfCounters {
+public:
+    /** counter values at one point in time */
+    struct Snapshot {
+        uint64_t cacheMisses = 0;
+        uint64_t branchMisses = 0;
+        uint64_t instructions = 0;
+    };
+
+    /** get instance */
+    static PerfCounters& instance() {
+        static PerfCounters singleton;
+        return singleton;
+    }
+
+    /** true when all counters could be opened */
+    bool enabled() const {
+        return isEnabled;
+    }
+
+    /** read the current counter values */
+    Snapshot read() const {
+        Snapshot snapshot;
+#ifdef __linux__
+        if (isEnabled) {
+            snapshot.cacheMisses = readCounter(cacheMissesFd);
+            snapshot.branchMisses = readCounter(branchMissesFd);
+            snapshot.instructions = readCounter(instructionsFd);
+        }
+#endif  // __linux__
+        return snapshot;
+    }
+
+private:
+#ifdef __linux__
+    PerfCounters() {
+        cacheMissesFd = openCounter(PERF_COUNT_HW_CACHE_MISSES);
+        branchMissesFd = openCounter(PERF_COUNT_HW_BRANCH_MISSES);
+        instructionsFd = openCounter(PERF_COUNT_HW_INSTRUCTIONS);
+        isEnabled = (cacheMissesFd >= 0) && (branchMissesFd >= 0) && (instructionsFd >= 0);
+        if (!isEnabled) {
+            closeAll();
+        }
+    }
+
+    ~PerfCounters() {
+        closeAll();
+    }
+
+    /**
+     * Open one user-space counter for the whole process. `inherit` makes
+     * threads created after this point, such as the OpenMP worker pool,
+     * count into the same event; a read sums over all of them.
+     */
+    static int openCounter(const uint64_t config) {
+        struct perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.inherit = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    static uint64_t readCounter(const int fd) {
+        uint64_t value = 0;
+        if (::read(fd, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) {
+            return 0;
+        }
+        return value;
+    }
+
+    void closeAll() {
+        for (int* fd : {&cacheMissesFd, &branchMissesFd, &instructionsFd}) {
+            if (*fd >= 0) {
+                ::close(*fd);
+                *fd = -1;
+            }
+        }
+    }
+
+    int cacheMissesFd = -1;
+    int branchMissesFd = -1;
+    int instructionsFd = -1;
+#else
+    PerfCounters() = default;
+#endif  // __linux__
+
+    bool isEnabled = false;
+};
+
+}  // namespace profile
+}  // namespace souffle
@@ -6,6 +6,7 @@
 #include <cassert>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <iterator>
@@ -23,10 +24,54 @@ namespace profile {
 
 class DirectoryEntry;
 class DurationEntry;
+class Entry;
 class SizeEntry;
 class TextEntry;
 class TimeEntry;
 
+/**
+ * The binary profile database format: after the magic number and version,
+ * the entry tree is serialised recursively as tagged, length-prefixed
+ * records. Every directory record carries the byte size of its encoded
+ * children, so a reader can skip over any subtree in constant time; the
+ * reader below uses that as an offset index to decode relation and rule
+ * subtrees lazily, on first access.
+ */
+constexpr uint64_t binaryProfileMagic = 0x50454c4646554f53ull;  // "SOUFFLEP"
+constexpr uint32_t binaryProfileVersion = 1;
+
+inline void writeBinary(std::ostream& os, const uint64_t value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline void writeBinary(std::ostream& os, const uint32_t value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline void writeBinary(std::ostream& os, const int64_t value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline void writeBinary(std::ostream& os, const std::string& text) {
+    writeBinary(os, static_cast<uint32_t>(text.size()));
+    os.write(text.data(), static_cast<std::streamsize>(text.size()));
+}
+
+template <typename T>
+void readBinary(std::istream& is, T& value) {
+    is.read(reinterpret_cast<char*>(&value), sizeof(value));
+}
+
+inline void readBinary(std::istream& is, std::string& text) {
+    uint32_t length = 0;
+    readBinary(is, length);
+    text.resize(length);
+    is.read(text.empty() ? nullptr : &text[0], length);
+}
+
+/** Decode one entry of the binary profile database format */
+inline Own<Entry> readBinaryEntry(std::istream& is, const std::string& filename);
+
 /**
  * Visitor Interface
  */
@@ -68,6 +113,9 @@ public:
 
     // print
     virtual void print(std::ostream& os, int tabpos) const = 0;
+
+    // serialise to the binary profile database format
+    virtual void printBinary(std::ostream& os) const = 0;
 };
 
 /**
@@ -82,7 +130,7 @@ public:
     DirectoryEntry(const std::string& name) : Entry(name) {}
 
     // get keys
-    const std::set<std::string> getKeys() const {
+    virtual const std::set<std::string> getKeys() const {
         std::set<std::string> result;
         std::lock_guard<std::mutex> guard(lock);
         for (auto const& cur : entries) {
@@ -92,7 +140,7 @@ public:
     }
 
     // write entry
-    Entry* writeEntry(Own<Entry> entry) {
+    virtual Entry* writeEntry(Own<Entry> entry) {
         assert(entry != nullptr && "null entry");
         std::lock_guard<std::mutex> guard(lock);
         const std::string& keyToWrite = entry->getKey();
@@ -104,7 +152,7 @@ public:
     }
 
     // read entry
-    Entry* readEntry(const std::string& keyToRead) const {
+    virtual Entry* readEntry(const std::string& keyToRead) const {
         std::lock_guard<std::mutex> guard(lock);
         auto it = entries.find(keyToRead);
         if (it != entries.end()) {
@@ -124,8 +172,10 @@ public:
         v.visit(*this);
     }
 
-    // print directory
+    // print directory; locked so that a live snapshot taken while the
+    // program is still writing entries sees a consistent directory
     void print(std::ostream& os, int tabpos) const override {
+        std::lock_guard<std::mutex> guard(lock);
         os << std::string(tabpos, ' ') << '"' << getKey() << "\": {" << std::endl;
         bool first{true};
         for (auto const& cur : entries) {
@@ -138,6 +188,25 @@ public:
         }
         os << std::endl << std::string(tabpos, ' ') << '}';
     }
+
+    // serialise the directory with the byte size of its encoded children,
+    // patched in afterwards, so readers can skip the subtree in O(1)
+    void printBinary(std::ostream& os) const override {
+        std::lock_guard<std::mutex> guard(lock);
+        os.put('D');
+        writeBinary(os, getKey());
+        const std::streampos sizePos = os.tellp();
+        writeBinary(os, static_cast<uint64_t>(0));
+        writeBinary(os, static_cast<uint32_t>(entries.size()));
+        const std::streampos childrenStart = os.tellp();
+        for (auto const& cur : entries) {
+            cur.second->printBinary(os);
+        }
+        const std::streampos childrenEnd = os.tellp();
+        os.seekp(sizePos);
+        writeBinary(os, static_cast<uint64_t>(childrenEnd - childrenStart));
+        os.seekp(childrenEnd);
+    }
 };
 
 /**
@@ -163,6 +232,12 @@ public:
     void print(std::ostream& os, int tabpos) const override {
         os << std::string(tabpos, ' ') << "\"" << getKey() << "\": " << size;
     }
+
+    void printBinary(std::ostream& os) const override {
+        os.put('S');
+        writeBinary(os, getKey());
+        writeBinary(os, static_cast<uint64_t>(size));
+    }
 };
 
 /**
@@ -190,6 +265,12 @@ public:
     void print(std::ostream& os, int tabpos) const override {
         os << std::string(tabpos, ' ') << "\"" << getKey() << "\": \"" << text << "\"";
     }
+
+    void printBinary(std::ostream& os) const override {
+        os.put('T');
+        writeBinary(os, getKey());
+        writeBinary(os, text);
+    }
 };
 
 /**
@@ -231,6 +312,13 @@ public:
         os << end.count();
         os << '}';
     }
+
+    void printBinary(std::ostream& os) const override {
+        os.put('U');
+        writeBinary(os, getKey());
+        writeBinary(os, static_cast<int64_t>(start.count()));
+        writeBinary(os, static_cast<int64_t>(end.count()));
+    }
 };
 
 /**
@@ -261,8 +349,115 @@ public:
         os << time.count();
         os << '}';
     }
+
+    void printBinary(std::ostream& os) const override {
+        os.put('M');
+        writeBinary(os, getKey());
+        writeBinary(os, static_cast<int64_t>(time.count()));
+    }
 };
 
+/**
+ * A directory whose children still sit in the binary profile file: the
+ * subtree is decoded on first access, so opening a large profile only pays
+ * for the relation and rule subtrees a consumer actually visits.
+ */
+class LazyDirectoryEntry : public DirectoryEntry {
+public:
+    LazyDirectoryEntry(
+            const std::string& name, std::string filename, std::streampos offset, uint32_t childCount)
+            : DirectoryEntry(name), filename(std::move(filename)), offset(offset), childCount(childCount) {}
+
+    const std::set<std::string> getKeys() const override {
+        materialise();
+        return DirectoryEntry::getKeys();
+    }
+
+    Entry* writeEntry(Own<Entry> entry) override {
+        materialise();
+        return DirectoryEntry::writeEntry(std::move(entry));
+    }
+
+    Entry* readEntry(const std::string& keyToRead) const override {
+        materialise();
+        return DirectoryEntry::readEntry(keyToRead);
+    }
+
+    void print(std::ostream& os, int tabpos) const override {
+        materialise();
+        DirectoryEntry::print(os, tabpos);
+    }
+
+    void printBinary(std::ostream& os) const override {
+        materialise();
+        DirectoryEntry::printBinary(os);
+    }
+
+private:
+    /** Decode the children from the profile file, exactly once */
+    void materialise() const {
+        std::call_once(loadFlag, [this] {
+            std::ifstream file(filename, std::ios::in | std::ios::binary);
+            if (!file.is_open()) {
+                throw std::runtime_error("Log file could not be opened.");
+            }
+            file.seekg(offset);
+            auto* self = const_cast<LazyDirectoryEntry*>(this);
+            for (uint32_t i = 0; i < childCount; ++i) {
+                self->DirectoryEntry::writeEntry(readBinaryEntry(file, filename));
+            }
+        });
+    }
+
+    const std::string filename;
+    const std::streampos offset;
+    const uint32_t childCount;
+    mutable std::once_flag loadFlag;
+};
+
+inline Own<Entry> readBinaryEntry(std::istream& is, const std::string& filename) {
+    const int tag = is.get();
+    std::string key;
+    readBinary(is, key);
+    if (!is) {
+        throw std::runtime_error("Parse error: damaged binary profile log.");
+    }
+    switch (tag) {
+        case 'D': {
+            uint64_t childrenSize = 0;
+            uint32_t childCount = 0;
+            readBinary(is, childrenSize);
+            readBinary(is, childCount);
+            const std::streampos childrenStart = is.tellg();
+            is.seekg(childrenStart + static_cast<std::streamoff>(childrenSize));
+            return mk<LazyDirectoryEntry>(key, filename, childrenStart, childCount);
+        }
+        case 'S': {
+            uint64_t size = 0;
+            readBinary(is, size);
+            return mk<SizeEntry>(key, static_cast<std::size_t>(size));
+        }
+        case 'T': {
+            std::string text;
+            readBinary(is, text);
+            return mk<TextEntry>(key, std::move(text));
+        }
+        case 'U': {
+            int64_t start = 0;
+            int64_t end = 0;
+            readBinary(is, start);
+            readBinary(is, end);
+            return mk<DurationEntry>(key, microseconds(start), microseconds(end));
+        }
+        case 'M': {
+            int64_t time = 0;
+            readBinary(is, time);
+            return mk<TimeEntry>(key, microseconds(time));
+        }
+        default: throw std::runtime_error("Parse error: damaged binary profile log.");
+    }
+}
+
 inline void Visitor::visit(DirectoryEntry& e) {
     std::cout << "Dir " << e.getKey() << "\n";
     for (const auto& cur : e.getKeys()) {
@@ -348,10 +543,28 @@ public:
     ProfileDatabase() : root(mk<DirectoryEntry>("root")) {}
 
     ProfileDatabase(const std::string& filename) : root(mk<DirectoryEntry>("root")) {
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::in | std::ios::binary);
         if (!file.is_open()) {
             throw std::runtime_error("Log file could not be opened.");
         }
+        // sniff the magic number to tell the binary format from json
+        uint64_t magic = 0;
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        if (file && magic == binaryProfileMagic) {
+            uint32_t version = 0;
+            readBinary(file, version);
+            if (version != binaryProfileVersion) {
+                throw std::runtime_error("Parse error: unsupported binary profile version.");
+            }
+            Own<Entry> entry = readBinaryEntry(file, filename);
+            if (!isA<DirectoryEntry>(entry.get())) {
+                throw std::runtime_error("Parse error: damaged binary profile log.");
+            }
+            root = Own<DirectoryEntry>(as<DirectoryEntry>(entry.release()));
+            return;
+        }
+        file.clear();
+        file.seekg(0);
         std::string jsonString((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
         std::string error;
         json11::Json json = json11::Json::parse(jsonString, error);
@@ -459,6 +672,18 @@ public:
         root->print(os, 1);
         os << std::endl << '}' << std::endl;
     };
+
+    /**
+     * Serialise the database to the binary profile format. The tree is
+     * written in one streaming pass with no intermediate representation,
+     * so a dump stays cheap even for very large profiles; the stream must
+     * be seekable so the subtree sizes can be patched in.
+     */
+    void printBinary(std::ostream& os) const {
+        writeBinary(os, binaryProfileMagic);
+        writeBinary(os, binaryProfileVersion);
+        root->printBinary(os);
+    };
 };
 
 }  // namespace profile
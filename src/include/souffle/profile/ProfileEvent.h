@@ -19,12 +19,19 @@
 #include "souffle/profile/EventProcessor.h"
 #include "souffle/profile/ProfileDatabase.h"
 #include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <ctime>
+#include <fstream>
+#include <functional>
 #include <iostream>
+#include <map>
 #include <mutex>
 #include <sstream>
 #include <string>
@@ -46,6 +53,29 @@ class ProfileEventSingleton {
     profile::ProfileDatabase database;
     std::string filename{""};
 
+    /** write periodic snapshots of the database while the program runs */
+    bool liveSnapshots = false;
+
+    /** write the log in the binary profile format instead of json */
+    bool binaryFormat = false;
+
+    /** earliest time the next live snapshot may be written */
+    std::chrono::steady_clock::time_point nextSnapshotTime{};
+
+    /** callback reporting current memory usage, guarded by samplerMutex */
+    std::function<void()> memorySampler;
+    std::mutex samplerMutex;
+
+    /** per-thread labels of the currently executing statement, read by the
+     * sampling profiler thread */
+    static constexpr std::size_t maxSampledThreads = 256;
+    std::array<std::atomic<const char*>, maxSampledThreads> sampleSlots{};
+    std::atomic<std::size_t> sampleSlotCount{0};
+
+    /** number of samples observed per statement label; written only by the
+     * sampling profiler thread, read after it has been joined */
+    std::map<std::string, std::size_t> sampleCounts;
+
     ProfileEventSingleton() = default;
 
 public:
@@ -85,6 +115,28 @@ public:
         profile::EventProcessorSingleton::instance().process(database, txt.c_str(), number, iteration);
     }
 
+    /** create an operation-hint statistics event */
+    void makeHintStatsEvent(const std::string& txt, std::size_t hits, std::size_t misses) {
+        profile::EventProcessorSingleton::instance().process(database, txt.c_str(), hits, misses);
+    }
+
+    /** create a hardware performance counter event for the rule bracketed
+     * by a timing scope; labels other than rule scopes are ignored */
+    void makeCounterEvent(const std::string& txt, std::size_t cacheMisses, std::size_t branchMisses,
+            std::size_t instructions, std::size_t iteration) {
+        static const std::string nonRecursiveRule = "@t-nonrecursive-rule";
+        static const std::string recursiveRule = "@t-recursive-rule";
+        if (txt.compare(0, nonRecursiveRule.size(), nonRecursiveRule) == 0) {
+            const std::string signature = "@p-nonrecursive-rule" + txt.substr(nonRecursiveRule.size());
+            profile::EventProcessorSingleton::instance().process(
+                    database, signature.c_str(), cacheMisses, branchMisses, instructions);
+        } else if (txt.compare(0, recursiveRule.size(), recursiveRule) == 0) {
+            const std::string signature = "@p-recursive-rule" + txt.substr(recursiveRule.size());
+            profile::EventProcessorSingleton::instance().process(
+                    database, signature.c_str(), cacheMisses, branchMisses, instructions, iteration);
+        }
+    }
+
     /** create utilisation event */
     void makeUtilisationEvent(const std::string& txt) {
         /* current time */
@@ -125,15 +177,121 @@ public:
                 database, txt.c_str(), time, systemTime, userTime, maxRSS);
     }
 
+    /** create memory usage event for a single component */
+    void makeMemoryEvent(const std::string& component, std::size_t bytes) {
+        microseconds time = std::chrono::duration_cast<microseconds>(now().time_since_epoch());
+        const std::string signature = "@memory;" + component;
+        profile::EventProcessorSingleton::instance().process(database, signature.c_str(), time, bytes);
+    }
+
+    /**
+     * Install a callback reporting the current memory usage of the running
+     * program via makeMemoryEvent; invoked periodically from the utilisation
+     * timer thread. Must be cleared before the sampled state is destroyed.
+     */
+    void setMemorySampler(std::function<void()> sampler) {
+        std::lock_guard<std::mutex> guard(samplerMutex);
+        memorySampler = std::move(sampler);
+    }
+
+    /** remove the installed memory sampler, if any */
+    void clearMemorySampler() {
+        std::lock_guard<std::mutex> guard(samplerMutex);
+        memorySampler = nullptr;
+    }
+
+    /** invoke the installed memory sampler, if any */
+    void sampleMemory() {
+        std::lock_guard<std::mutex> guard(samplerMutex);
+        if (memorySampler) {
+            memorySampler();
+        }
+    }
+
+    /**
+     * Publish the label of the statement the calling thread is about to
+     * execute and return the previously published one, so that nested
+     * scopes can restore it. The cost is a single relaxed atomic exchange,
+     * cheap enough to leave enabled in production runs. The label must
+     * stay alive until the sampler has been stopped.
+     */
+    const char* setSamplePoint(const char* label) {
+        static thread_local std::atomic<const char*>* slot = claimSampleSlot();
+        if (slot == nullptr) {
+            return nullptr;
+        }
+        return slot->exchange(label, std::memory_order_relaxed);
+    }
+
+    /** start the sampling profiler thread */
+    void startSampler() {
+        sampler.start();
+    }
+
+    /**
+     * Stop the sampling profiler thread and convert the gathered sample
+     * counts into ordinary timing events, attributing one sampling period
+     * per observed sample, so a sampled log can be inspected with the
+     * unmodified souffle-profile tooling. Memory and tuple counts are not
+     * gathered while sampling and are reported as zero.
+     */
+    void stopSampler() {
+        sampler.stop();
+        for (const auto& sample : sampleCounts) {
+            const microseconds attributed(
+                    static_cast<int64_t>(sample.second) * SamplingTimer::period.count());
+            makeTimingEvent(sample.first, time_point(),
+                    time_point(std::chrono::duration_cast<time_point::duration>(attributed)), 0, 0, 0, 0);
+        }
+        sampleCounts.clear();
+    }
+
     void setOutputFile(std::string outputFilename) {
         filename = outputFilename;
+        liveSnapshots = (std::getenv("SOUFFLE_PROFILE_LIVE") != nullptr);
+        // a .bin log is written in the compact binary format, which dumps
+        // faster and lets souffle-profile decode subtrees lazily
+        binaryFormat = filename.size() >= 4 && filename.compare(filename.size() - 4, 4, ".bin") == 0;
+    }
+
+    /**
+     * Periodically serialise a snapshot of the database to the log file so
+     * that a concurrent souffle-profile session can follow a still-running
+     * program. The snapshot is written to a temporary file and renamed into
+     * place so readers never observe a partially written database. Rate
+     * limited; called from the utilisation timer thread.
+     */
+    void makeLiveSnapshot() {
+        if (!liveSnapshots || filename.empty()) {
+            return;
+        }
+        const auto currentTime = std::chrono::steady_clock::now();
+        if (currentTime < nextSnapshotTime) {
+            return;
+        }
+        nextSnapshotTime = currentTime + std::chrono::seconds(5);
+        const std::string tmpFilename = filename + ".part";
+        {
+            std::ofstream os(tmpFilename, binaryFormat ? std::ios::out | std::ios::binary : std::ios::out);
+            if (!os.is_open()) {
+                return;
+            }
+            if (binaryFormat) {
+                database.printBinary(os);
+            } else {
+                database.print(os);
+            }
+        }
+        std::rename(tmpFilename.c_str(), filename.c_str());
     }
     /** Dump all events */
     void dump() {
         if (!filename.empty()) {
-            std::ofstream os(filename);
+            std::ofstream os(filename, binaryFormat ? std::ios::out | std::ios::binary : std::ios::out);
             if (!os.is_open()) {
                 std::cerr << "Cannot open profile log file <" + filename + ">";
+            } else if (binaryFormat) {
+                database.printBinary(os);
             } else {
                 database.print(os);
             }
@@ -183,6 +341,8 @@ private:
         /** run method for thread th */
         void run() {
             ProfileEventSingleton::instance().makeUtilisationEvent("@utilisation");
+            ProfileEventSingleton::instance().sampleMemory();
+            ProfileEventSingleton::instance().makeLiveSnapshot();
             ++runCount;
             if (runCount % 128 == 0) {
                 increaseInterval();
@@ -246,7 +406,62 @@ private:
         }
     };
 
+    /**
+     * Sampling profiler thread: roughly once a millisecond it reads the
+     * statement label published by every worker thread and counts one
+     * sample against it. Only this thread touches sampleCounts while it
+     * runs; stopSampler joins it before the counts are read.
+     */
+    class SamplingTimer {
+    public:
+        /** interval between two samples */
+        static constexpr microseconds period{1000};
+
+        /** start sampling on the thread th */
+        void start() {
+            if (running.exchange(true)) {
+                return;
+            }
+            th = std::thread([this]() {
+                auto& profiler = ProfileEventSingleton::instance();
+                while (running) {
+                    std::this_thread::sleep_for(period);
+                    const std::size_t slots = std::min(profiler.sampleSlotCount.load(), maxSampledThreads);
+                    for (std::size_t i = 0; i < slots; ++i) {
+                        const char* label = profiler.sampleSlots[i].load(std::memory_order_relaxed);
+                        if (label != nullptr) {
+                            ++profiler.sampleCounts[label];
+                        }
+                    }
+                }
+            });
+        }
+
+        /** stop sampling and join the thread th */
+        void stop() {
+            running = false;
+            if (th.joinable()) {
+                th.join();
+            }
+        }
+
+    private:
+        /** sampler is running */
+        std::atomic<bool> running{false};
+
+        /** thread the sampler runs on */
+        std::thread th;
+    };
+
+    /** hand out one sample slot per thread, in claiming order; threads
+     * beyond the slot capacity are simply not sampled */
+    std::atomic<const char*>* claimSampleSlot() {
+        const std::size_t index = sampleSlotCount++;
+        return index < maxSampledThreads ? &sampleSlots[index] : nullptr;
+    }
+
     ProfileTimer timer;
+    SamplingTimer sampler;
 };
 
 }  // namespace souffle
@@ -91,6 +91,17 @@ private:
 class RecursiveRuleVisitor : public DSNVisitor<Rule> {
 public:
     RecursiveRuleVisitor(Rule& rule) : DSNVisitor(rule) {}
+    void visit(SizeEntry& size) override {
+        if (size.getKey() == "cache-misses") {
+            base.setCacheMisses(size.getSize());
+        } else if (size.getKey() == "branch-misses") {
+            base.setBranchMisses(size.getSize());
+        } else if (size.getKey() == "instructions") {
+            base.setInstructions(size.getSize());
+        } else {
+            DSNVisitor::visit(size);
+        }
+    }
     void visit(DirectoryEntry& directory) override {
         if (directory.getKey() == "atom-frequency") {
             AtomFrequenciesVisitor atomFrequenciesVisitor(base);
@@ -136,6 +147,17 @@ protected:
 class NonRecursiveRuleVisitor : public DSNVisitor<Rule> {
 public:
     NonRecursiveRuleVisitor(Rule& rule) : DSNVisitor(rule) {}
+    void visit(SizeEntry& size) override {
+        if (size.getKey() == "cache-misses") {
+            base.setCacheMisses(size.getSize());
+        } else if (size.getKey() == "branch-misses") {
+            base.setBranchMisses(size.getSize());
+        } else if (size.getKey() == "instructions") {
+            base.setInstructions(size.getSize());
+        } else {
+            DSNVisitor::visit(size);
+        }
+    }
     void visit(DirectoryEntry& directory) override {
         if (directory.getKey() == "atom-frequency") {
             AtomFrequenciesVisitor atomFrequenciesVisitor(base);
@@ -349,6 +371,22 @@ public:
 
     void save(std::string f_name);
 
+    /**
+     * Re-read a live log file and process its new contents. The writer
+     * replaces the file atomically, so on a read failure we simply keep the
+     * previous snapshot and try again on the next refresh.
+     */
+    void refresh() {
+        if (!file_loc.empty()) {
+            try {
+                ProfileEventSingleton::instance().setDBFromFile(file_loc);
+            } catch (const std::exception&) {
+                // file is mid-replacement; keep the previous snapshot
+            }
+        }
+        processFile();
+    }
+
     inline bool isLive() {
         return online;
     }
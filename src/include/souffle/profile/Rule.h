@@ -9,6 +9,7 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <set>
 #include <sstream>
 #include <string>
@@ -50,6 +51,9 @@ protected:
     std::chrono::microseconds starttime{};
     std::chrono::microseconds endtime{};
     long numTuples{0};
+    std::size_t cacheMisses{0};
+    std::size_t branchMisses{0};
+    std::size_t instructions{0};
     std::string identifier;
     std::string locator{};
     std::set<Atom> atoms;
@@ -96,6 +100,30 @@ public:
         this->numTuples = numTuples;
     }
 
+    std::size_t getCacheMisses() const {
+        return cacheMisses;
+    }
+
+    void setCacheMisses(std::size_t cacheMisses) {
+        this->cacheMisses = cacheMisses;
+    }
+
+    std::size_t getBranchMisses() const {
+        return branchMisses;
+    }
+
+    void setBranchMisses(std::size_t branchMisses) {
+        this->branchMisses = branchMisses;
+    }
+
+    std::size_t getInstructions() const {
+        return instructions;
+    }
+
+    void setInstructions(std::size_t instructions) {
+        this->instructions = instructions;
+    }
+
     void addAtomFrequency(
             const std::string& subruleName, std::string atom, std::size_t level, std::size_t frequency) {
         atoms.emplace(atom, subruleName, level, frequency);
@@ -0,0 +1,126 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file TraceExport.h
+ *
+ * Exports the duration entries of a profile database as Chrome
+ * trace-event JSON, suitable for chrome://tracing and perfetto.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/profile/ProfileDatabase.h"
+#include "souffle/profile/StringUtils.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace souffle {
+namespace profile {
+
+/*
+ * Serialises the duration entries of a profile database as a Chrome
+ * trace-event JSON array. Each relation is laid out on its own track so
+ * that overlapping work — for instance I/O against evaluation in another
+ * stratum — lines up visually; rule, iteration and copy timings appear as
+ * events on the track of their relation.
+ */
+class TraceExport {
+public:
+    static void write(std::ostream& os, const ProfileDatabase& db) {
+        std::vector<TraceEvent> events;
+        if (auto* program = as<DirectoryEntry>(db.lookupEntry({"program"}))) {
+            std::vector<std::string> path;
+            collect(*program, path, events);
+        }
+
+        // start the trace at zero rather than at the epoch timestamps
+        microseconds base{0};
+        if (!events.empty()) {
+            base = std::min_element(events.begin(), events.end(), [](const auto& a, const auto& b) {
+                return a.start < b.start;
+            })->start;
+        }
+
+        // number the tracks in order of first appearance, keeping the
+        // whole-program track first
+        std::map<std::string, std::size_t> tracks;
+        tracks["program"] = 0;
+        for (const auto& event : events) {
+            tracks.emplace(event.track, tracks.size());
+        }
+
+        os << "[\n";
+        os << R"_({"name": "process_name", "ph": "M", "pid": 0, "args": {"name": "souffle"}})_";
+        for (const auto& track : tracks) {
+            os << ",\n";
+            os << R"_({"name": "thread_name", "ph": "M", "pid": 0, "tid": )_" << track.second
+               << R"_(, "args": {"name": ")_" << Tools::cleanJsonOut(track.first) << R"_("}})_";
+        }
+        for (const auto& event : events) {
+            os << ",\n";
+            os << R"_({"name": ")_" << Tools::cleanJsonOut(event.name) << R"_(", "cat": ")_"
+               << (event.track == "program" ? "program" : "relation") << R"_(", "ph": "X", "ts": )_"
+               << (event.start - base).count() << R"_(, "dur": )_" << (event.end - event.start).count()
+               << R"_(, "pid": 0, "tid": )_" << tracks[event.track] << "}";
+        }
+        os << "\n]\n";
+    }
+
+private:
+    struct TraceEvent {
+        std::string track;
+        std::string name;
+        microseconds start;
+        microseconds end;
+    };
+
+    /** Recursively gather all duration entries below the program directory. */
+    static void collect(
+            const DirectoryEntry& dir, std::vector<std::string>& path, std::vector<TraceEvent>& events) {
+        for (const auto& key : dir.getKeys()) {
+            Entry* entry = dir.readEntry(key);
+            if (auto* sub = as<DirectoryEntry>(entry)) {
+                path.push_back(key);
+                collect(*sub, path, events);
+                path.pop_back();
+            } else if (auto* duration = as<DurationEntry>(entry)) {
+                events.push_back(makeEvent(path, key, *duration));
+            }
+        }
+    }
+
+    /**
+     * Turn a database path into a track and an event name: entries below a
+     * relation directory land on that relation's track, everything else on
+     * the whole-program track.
+     */
+    static TraceEvent makeEvent(
+            const std::vector<std::string>& path, const std::string& key, const DurationEntry& duration) {
+        TraceEvent event{"program", "", duration.getStart(), duration.getEnd()};
+        std::size_t first = 0;
+        if (path.size() >= 2 && path[0] == "relation") {
+            event.track = path[1];
+            first = 2;
+        }
+        for (std::size_t i = first; i < path.size(); ++i) {
+            event.name += path[i] + " ";
+        }
+        event.name += key;
+        return event;
+    }
+};
+
+}  // namespace profile
+}  // namespace souffle
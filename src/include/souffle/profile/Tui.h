@@ -21,6 +21,7 @@
 #include "souffle/profile/Rule.h"
 #include "souffle/profile/StringUtils.h"
 #include "souffle/profile/Table.h"
+#include "souffle/profile/TraceExport.h"
 #include "souffle/profile/UserInputReader.h"
 #include "souffle/utility/MiscUtil.h"
 #include <algorithm>
@@ -94,6 +95,13 @@ public:
         this->alive = false;
         updateDB();
         this->loaded = reader->isLoaded();
+
+        // The log of a still-running program has no overall runtime entry
+        // yet; tail it, refreshing the display as new snapshots are written.
+        if (live && loaded && reader->isLive()) {
+            this->alive = true;
+            startUpdater();
+        }
     }
 
     Tui() {
@@ -102,18 +110,7 @@ public:
         this->loaded = true;
         this->alive = true;
         updateDB();
-        updater = std::thread([this]() {
-            // Update the display every 30s. Check for input every 0.5s
-            std::chrono::milliseconds interval(30000);
-            auto nextUpdateTime = std::chrono::high_resolution_clock::now();
-            do {
-                std::this_thread::sleep_for(std::chrono::milliseconds(500));
-                if (nextUpdateTime < std::chrono::high_resolution_clock::now()) {
-                    runCommand({});
-                    nextUpdateTime = std::chrono::high_resolution_clock::now() + interval;
-                }
-            } while (reader->isLive() && !linereader.hasReceivedInput());
-        });
+        startUpdater();
     }
 
     ~Tui() {
@@ -525,6 +522,48 @@ public:
         return ss;
     }
 
+    std::stringstream& genJsonMemory(std::stringstream& ss) {
+        auto comma = [&ss](bool& first, const std::string& delimiter = ", ") {
+            if (!first) {
+                ss << delimiter;
+            } else {
+                first = false;
+            }
+        };
+
+        // Add per-component memory samples, one time series per relation or table
+        ss << R"_("memory": {)_";
+        DirectoryEntry* memoryStats = as<DirectoryEntry>(
+                ProfileEventSingleton::instance().getDB().lookupEntry({"program", "memory", "timepoint"}));
+        if (memoryStats != nullptr) {
+            auto beginTime = out.getProgramRun()->getStarttime();
+            std::map<std::string, std::map<std::chrono::microseconds, std::size_t>> series;
+            for (auto& timeKey : memoryStats->getKeys()) {
+                std::chrono::microseconds time{std::stoul(timeKey)};
+                auto* timepoint = memoryStats->readDirectoryEntry(timeKey);
+                for (auto& component : timepoint->getKeys()) {
+                    if (auto* entry = as<SizeEntry>(timepoint->readEntry(component))) {
+                        series[component][time] = entry->getSize();
+                    }
+                }
+            }
+            bool firstRow = true;
+            for (auto& cur : series) {
+                comma(firstRow, ",\n");
+                ss << '"' << Tools::cleanJsonOut(cur.first) << R"_(": [)_";
+                bool firstCol = true;
+                for (auto& sample : cur.second) {
+                    comma(firstCol);
+                    ss << '[' << (sample.first - beginTime).count() / 1000000.0 << ", " << sample.second
+                       << ']';
+                }
+                ss << ']';
+            }
+        }
+        ss << '}';
+        return ss;
+    }
+
     std::stringstream& genJsonConfiguration(std::stringstream& ss) {
         auto comma = [&ss](bool& first, const std::string& delimiter = ", ") {
             if (!first) {
@@ -625,6 +664,8 @@ public:
         ss << ",\n";
         genJsonConfiguration(ss);
         ss << ",\n";
+        genJsonMemory(ss);
+        ss << ",\n";
         genJsonAtoms(ss);
         ss << '\n';
 
@@ -676,6 +717,16 @@ public:
         std::cout << "file output to: " << newFile << std::endl;
     }
 
+    void outputTrace(std::string filename = "trace.json") {
+        std::ofstream outfile(filename);
+        if (!outfile.is_open()) {
+            std::cerr << "Cannot open trace output file <" << filename << ">\n";
+            exit(2);
+        }
+        TraceExport::write(outfile, ProfileEventSingleton::instance().getDB());
+        std::cout << "trace output to: " << filename << std::endl;
+    }
+
     void quit() {
         if (updater.joinable()) {
             updater.join();
@@ -1060,6 +1111,27 @@ public:
         }
         std::cout << std::endl;
 
+        // While the program is still running, report the stratum that is
+        // currently executing: the one entered most recently.
+        if (alive) {
+            auto* strata = as<DirectoryEntry>(
+                    ProfileEventSingleton::instance().getDB().lookupEntry({"program", "stratum"}));
+            if (strata != nullptr) {
+                std::string current;
+                std::chrono::microseconds latest{0};
+                for (const auto& key : strata->getKeys()) {
+                    auto* entered = as<TimeEntry>(strata->readEntry(key));
+                    if (entered != nullptr && entered->getTime() >= latest) {
+                        latest = entered->getTime();
+                        current = key;
+                    }
+                }
+                if (!current.empty()) {
+                    std::cout << "Executing stratum " << current << "\n";
+                }
+            }
+        }
+
         std::cout << "Slowest relations to fully evaluate\n";
         rel(3, false);
         for (std::size_t i = relationTable.getRows().size(); i < 3; ++i) {
@@ -1101,8 +1173,8 @@ public:
     void rul(std::size_t limit, bool showLimit = true) {
         ruleTable.sort(sortColumn);
         std::cout << "  ----- Rule Table -----\n";
-        std::printf(
-                "%8s%8s%8s%8s%8s%8s %s\n\n", "TOT_T", "NREC_T", "REC_T", "TUPLES", "TUP/s", "ID", "RELATION");
+        std::printf("%8s%8s%8s%8s%8s%8s%8s%8s%8s %s\n\n", "TOT_T", "NREC_T", "REC_T", "TUPLES", "TUP/s",
+                "CACHE_M", "BR_MISS", "INSTR", "ID", "RELATION");
         std::size_t count = 0;
         for (auto& row : Tools::formatTable(ruleTable, precision)) {
             if (++count > limit) {
@@ -1111,8 +1183,9 @@ public:
                 }
                 break;
             }
-            std::printf("%8s%8s%8s%8s%8s%8s %s\n", row[0].c_str(), row[1].c_str(), row[2].c_str(),
-                    row[4].c_str(), row[9].c_str(), row[6].c_str(), row[7].c_str());
+            std::printf("%8s%8s%8s%8s%8s%8s%8s%8s%8s %s\n", row[0].c_str(), row[1].c_str(), row[2].c_str(),
+                    row[4].c_str(), row[9].c_str(), row[11].c_str(), row[12].c_str(), row[13].c_str(),
+                    row[6].c_str(), row[7].c_str());
         }
     }
 
@@ -1465,11 +1538,26 @@ protected:
         std::cout << '\n';
     }
     void updateDB() {
-        reader->processFile();
+        reader->refresh();
         ruleTable = out.getRulTable();
         relationTable = out.getRelTable();
     }
 
+    void startUpdater() {
+        updater = std::thread([this]() {
+            // Update the display every 30s. Check for input every 0.5s
+            std::chrono::milliseconds interval(30000);
+            auto nextUpdateTime = std::chrono::high_resolution_clock::now();
+            do {
+                std::this_thread::sleep_for(std::chrono::milliseconds(500));
+                if (nextUpdateTime < std::chrono::high_resolution_clock::now()) {
+                    runCommand({});
+                    nextUpdateTime = std::chrono::high_resolution_clock::now() + interval;
+                }
+            } while (reader->isLive() && !linereader.hasReceivedInput());
+        });
+    }
+
     uint32_t getTermWidth() {
         struct winsize w {};
         ioctl(0, TIOCGWINSZ, &w);
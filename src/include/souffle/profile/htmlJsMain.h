@@ -570,6 +570,89 @@ function gen_code(highlight_row) {
 }
 
 
+function memory_timepoints() {
+    var times = {};
+    for (var component in data.memory) {
+        var series = data.memory[component];
+        for (var i = 0; i < series.length; i++) {
+            times[series[i][0]] = !0;
+        }
+    }
+    return Object.keys(times).map(Number).sort(function (a, b) { return a - b; });
+}
+
+function memory_at(series, time) {
+    var bytes = 0;
+    for (var i = 0; i < series.length && series[i][0] <= time; i++) {
+        bytes = series[i][1];
+    }
+    return bytes;
+}
+
+function gen_memory_treemap(step) {
+    var times = memory_timepoints();
+    if (times.length === 0) {
+        return;
+    }
+    var slider = document.getElementById("memory-time");
+    slider.max = times.length - 1;
+    if (step < 0 || step >= times.length) {
+        step = times.length - 1;
+    }
+    slider.value = step;
+    var time = times[step];
+
+    var entries = [];
+    var total = 0;
+    for (var component in data.memory) {
+        var bytes = memory_at(data.memory[component], time);
+        if (bytes > 0) {
+            entries.push([component, bytes]);
+            total += bytes;
+        }
+    }
+    document.getElementById("memory-time-label").textContent =
+        humanise_time(time) + " in, " + minify_memory(total) + " total";
+    var view = document.getElementById("memory-treemap");
+    view.innerHTML = "";
+    if (total === 0) {
+        return;
+    }
+    entries.sort(function (a, b) { return b[1] - a[1]; });
+    // slice-and-dice layout: carve each component out of the remaining box in
+    // size order, alternating between vertical and horizontal cuts
+    var box = {x: 0, y: 0, w: 100, h: 100};
+    var remaining = total;
+    for (var i = 0; i < entries.length; i++) {
+        var share = entries[i][1] / remaining;
+        var cell = {x: box.x, y: box.y, w: box.w, h: box.h};
+        if (box.w >= box.h) {
+            cell.w = box.w * share;
+            box.x += cell.w;
+            box.w -= cell.w;
+        } else {
+            cell.h = box.h * share;
+            box.y += cell.h;
+            box.h -= cell.h;
+        }
+        remaining -= entries[i][1];
+        var tile = document.createElement("div");
+        tile.style.position = "absolute";
+        tile.style.left = cell.x + "%";
+        tile.style.top = cell.y + "%";
+        tile.style.width = cell.w + "%";
+        tile.style.height = cell.h + "%";
+        tile.style.background = "hsl(" + (i * 47) % 360 + ",45%,70%)";
+        tile.style.border = "1px solid #fff";
+        tile.style.overflow = "hidden";
+        tile.style.fontSize = "12px";
+        tile.title = entries[i][0] + ": " + minify_memory(entries[i][1]);
+        tile.textContent = entries[i][0] + " (" + minify_memory(entries[i][1]) + ")";
+        view.appendChild(tile);
+    }
+}
+
+
 var precision = !1;
 var selected = {rel: !1, rul: !1};
 var came_from = !1;
@@ -585,6 +668,11 @@ function init() {
     gen_rel_table();
     gen_rul_table();
     gen_code(-1)
+    if (data.hasOwnProperty("memory") && Object.keys(data.memory).length > 0) {
+        gen_memory_treemap(-1);
+    } else {
+        document.getElementById("memory-tab").style.display = "none";
+    }
     Tablesort(document.getElementById('Rel_table'),{descending: true});
     Tablesort(document.getElementById('Rul_table'),{descending: true});
     Tablesort(document.getElementById('rulesofrel_table'),{descending: true});
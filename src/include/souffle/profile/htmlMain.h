@@ -29,6 +29,7 @@ std::string htmlBodyTop = R"___(
         <li><a class="tablinks" id="rel_tab" onclick="changeTab(event, 'Relations');came_from = 'rel';">Relations</a></li>
         <li><a class="tablinks" id="rul_tab" onclick="changeTab(event, 'Rules');came_from = 'rul';">Rules</a></li>
         <li id="code-tab"><a class="tablinks" id="code_tab" onclick="changeTab(event, 'Code')">Code</a></li>
+        <li id="memory-tab"><a class="tablinks" id="memory_tab" onclick="changeTab(event, 'Memory')">Memory</a></li>
         <li><a class="tablinks" onclick="changeTab(event, 'Help')">Help</a></li>
         <li id="chart-tab" style="display:none;"><a id="chart_tab" onclick="changeTab(event, 'Chart')" class="tablinks">Chart</a></li>
     </ul>
@@ -237,6 +238,13 @@ std::string htmlBodyTop = R"___(
         <ol id="code-list"></ol>
     </div>
 </div>
+<div id="Memory" class="tabcontent">
+    <h3>Memory attribution</h3>
+    <p>Treemap of the bytes held by each relation and by the symbol and record tables, as sampled while the program ran. Drag the slider to step through the samples.</p>
+    <input type="range" id="memory-time" min="0" max="0" value="0" style="width:50%;" oninput="gen_memory_treemap(this.value);"/>
+    <span id="memory-time-label"></span>
+    <div id="memory-treemap" style="position:relative;width:100%;height:600px;"></div>
+</div>
 </div>
 )___";
 std::string htmlBodyBottom = R"___(
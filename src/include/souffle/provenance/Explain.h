@@ -101,6 +101,36 @@ public:
             }
             query = parseTuple(command[1]);
             printTree(prov.explain(query.first, query.second, ExplainConfig::getExplainConfig().depthLimit));
+        } else if (command[0] == "explainall") {
+            if (command.size() != 2) {
+                printError(
+                        "Usage: explainall <relation1>(<element1>, ...) <relation2>(<element1>, ...) "
+                        "...\n");
+                return true;
+            }
+            // match each tuple in turn; the proofs are derived in one batch so
+            // that shared subtrees are only traversed once
+            std::regex tupleRegex(
+                    "([a-zA-Z0-9_.-]*)[[:blank:]]*\\(([[:blank:]]*([0-9]+|\"[^\"]*\")([[:blank:]]*,[[:"
+                    "blank:]]*([0-"
+                    "9]+|\"[^\"]*\"))*)?\\)",
+                    std::regex_constants::extended);
+            std::vector<std::pair<std::string, std::vector<std::string>>> queries;
+            std::smatch tupleMatcher;
+            std::string tupleStr = command[1];
+            while (std::regex_search(tupleStr, tupleMatcher, tupleRegex)) {
+                queries.push_back(parseTuple(tupleMatcher[0]));
+                tupleStr = tupleMatcher.suffix().str();
+            }
+            if (queries.empty()) {
+                printError(
+                        "Usage: explainall <relation1>(<element1>, ...) <relation2>(<element1>, ...) "
+                        "...\n");
+                return true;
+            }
+            for (auto& tree : prov.explainBatch(queries, ExplainConfig::getExplainConfig().depthLimit)) {
+                printTree(std::move(tree));
+            }
         } else if (command[0] == "subproof") {
             std::pair<std::string, std::vector<std::string>> query;
             int label = -1;
@@ -253,6 +283,8 @@ public:
                     "----------\n"
                     "setdepth <depth>: Set a limit for printed derivation tree height\n"
                     "explain <relation>(<element1>, <element2>, ...): Prints derivation tree\n"
+                    "explainall <relation1>(<element1>, ...) <relation2>(<element1>, ...) ...: Prints\n"
+                    "    derivation trees for several tuples, sharing common subproofs\n"
                     "explainnegation <relation>(<element1>, <element2>, ...): Enters an interactive\n"
                     "    interface where the non-existence of a tuple can be explained\n"
                     "subproof <relation>(<label>): Prints derivation tree for a subproof, label is\n"
@@ -19,6 +19,7 @@
 #include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
 #include "souffle/SymbolTable.h"
+#include "souffle/provenance/ExplainTree.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
@@ -33,7 +34,6 @@
 #include <vector>
 
 namespace souffle {
-class TreeNode;
 
 /** Equivalence class for variables in query command */
 class Equivalence {
@@ -167,6 +167,22 @@ public:
     virtual Own<TreeNode> explain(
             std::string relName, std::vector<std::string> tuple, std::size_t depthLimit) = 0;
 
+    /**
+     * Explain several tuples in one call; implementations that memoise
+     * proof subtrees derive subtrees shared between the proofs only once
+     * @param queries, vector of relation, argument pairs
+     * */
+    virtual std::vector<Own<TreeNode>> explainBatch(
+            const std::vector<std::pair<std::string, std::vector<std::string>>>& queries,
+            std::size_t depthLimit) {
+        std::vector<Own<TreeNode>> trees;
+        trees.reserve(queries.size());
+        for (const auto& query : queries) {
+            trees.push_back(explain(query.first, query.second, depthLimit));
+        }
+        return trees;
+    }
+
     virtual Own<TreeNode> explainSubproof(std::string relName, RamDomain label, std::size_t depthLimit) = 0;
 
     virtual std::vector<std::string> explainNegationGetVariables(
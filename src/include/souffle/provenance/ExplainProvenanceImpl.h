@@ -91,12 +91,29 @@ public:
 
     Own<TreeNode> explain(std::string relName, std::vector<RamDomain> tuple, int ruleNum, int levelNum,
             std::size_t depthLimit) {
+        std::size_t proofDepth = 0;
+        bool complete = true;
+        return explain(std::move(relName), std::move(tuple), ruleNum, levelNum, depthLimit, proofDepth,
+                complete);
+    }
+
+    /**
+     * Construct the proof tree of a tuple, memoising complete subtrees in
+     * proofMemo so that they are derived only once per explain session.
+     *
+     * @param proofDepth set to the height of the returned proof tree
+     * @param complete set to false iff the tree was cut off by the depth limit
+     */
+    Own<TreeNode> explain(std::string relName, std::vector<RamDomain> tuple, int ruleNum, int levelNum,
+            std::size_t depthLimit, std::size_t& proofDepth, bool& complete) {
         std::stringstream joinedArgs;
         joinedArgs << join(decodeArguments(relName, tuple), ", ");
         auto joinedArgsStr = joinedArgs.str();
 
         // if fact
         if (levelNum == 0) {
+            proofDepth = 1;
+            complete = true;
             return mk<LeafNode>(relName + "(" + joinedArgsStr + ")");
         }
 
@@ -117,9 +134,22 @@ public:
                 idx = subproofs.size() - 1;
             }
 
+            proofDepth = 1;
+            complete = false;
             return mk<LeafNode>("subproof " + relName + "(" + std::to_string(idx) + ")");
         }
 
+        // a memoised complete subtree is reusable whenever it fits into the
+        // remaining depth window, since the depth limit could not have cut
+        // it off either
+        auto memoKey = std::make_tuple(relName, tuple, ruleNum, levelNum);
+        auto memoIt = proofMemo.find(memoKey);
+        if (memoIt != proofMemo.end() && memoIt->second.second <= depthLimit) {
+            proofDepth = memoIt->second.second;
+            complete = true;
+            return memoIt->second.first->clone();
+        }
+
         tuple.push_back(levelNum);
 
         auto internalNode =
@@ -135,6 +165,10 @@ public:
         std::size_t tupleCurInd = 0;
         auto bodyRelations = info.at(std::make_pair(relName, ruleNum));
 
+        // negation and constraint leaves contribute a depth of one
+        std::size_t maxChildDepth = 1;
+        bool nodeComplete = true;
+
         // start from begin + 1 because the first element represents the head atom
         for (auto it = bodyRelations.begin() + 1; it < bodyRelations.end(); it++) {
             std::string bodyLiteral = *it;
@@ -201,8 +235,12 @@ public:
                 internalNode->setSize(internalNode->getSize() + 1);
                 // otherwise, for a normal tuple, recurse
             } else {
-                auto child =
-                        explain(bodyRel, subproofTuple, subproofRuleNum, subproofLevelNum, depthLimit - 1);
+                std::size_t childDepth = 0;
+                bool childComplete = true;
+                auto child = explain(bodyRel, subproofTuple, subproofRuleNum, subproofLevelNum,
+                        depthLimit - 1, childDepth, childComplete);
+                maxChildDepth = std::max(maxChildDepth, childDepth);
+                nodeComplete = nodeComplete && childComplete;
                 internalNode->setSize(internalNode->getSize() + child->getSize());
                 internalNode->add_child(std::move(child));
             }
@@ -210,6 +248,15 @@ public:
             tupleCurInd = tupleEnd;
         }
 
+        proofDepth = maxChildDepth + 1;
+        complete = nodeComplete;
+
+        // only complete subtrees are cached: a truncated tree depends on the
+        // depth window it was built in and registers subproof labels
+        if (nodeComplete) {
+            proofMemo[std::move(memoKey)] = std::make_pair(internalNode->clone(), proofDepth);
+        }
+
         return internalNode;
     }
 
@@ -737,6 +784,12 @@ private:
     std::map<std::pair<std::string, std::size_t>, std::vector<std::string>> info;
     std::map<std::pair<std::string, std::size_t>, std::string> rules;
     std::vector<std::vector<RamDomain>> subproofs;
+
+    /** complete proof subtrees keyed by (relation, tuple, rule, level) and
+     * paired with their height, shared across queries in one session */
+    std::map<std::tuple<std::string, std::vector<RamDomain>, int, int>, std::pair<Own<TreeNode>, std::size_t>>
+            proofMemo;
+
     std::vector<std::string> constraintList = {
             "=", "!=", "<", "<=", ">=", ">", "match", "contains", "not_match", "not_contains"};
 
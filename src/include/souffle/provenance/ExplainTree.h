@@ -112,6 +112,9 @@ public:
 
     virtual void printJSON(std::ostream& os, int pos) = 0;
 
+    // deep copy of the tree; layout state is recomputed on the next place()
+    virtual Own<TreeNode> clone() const = 0;
+
 protected:
     std::string txt;      // text of tree node
     uint32_t width = 0;   // width of node (including sub-trees)
@@ -190,6 +193,16 @@ public:
         os << tab << "}";
     }
 
+    // deep copy of the node and its sub-trees
+    Own<TreeNode> clone() const override {
+        auto copy = mk<InnerNode>(txt, label);
+        copy->size = size;
+        for (const Own<TreeNode>& k : children) {
+            copy->add_child(k->clone());
+        }
+        return copy;
+    }
+
 private:
     VecOwn<TreeNode> children;
     std::string label;
@@ -222,6 +235,11 @@ public:
         std::string tab(pos, '\t');
         os << tab << R"({ "axiom": ")" << stringify(txt) << "\"}";
     }
+
+    // deep copy of the leaf
+    Own<TreeNode> clone() const override {
+        return mk<LeafNode>(txt);
+    }
 };
 
 }  // end of namespace souffle
@@ -16,9 +16,13 @@
 
 #pragma once
 
+#include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <string>
+#include <vector>
 
 /**
  * Abstract base class for generated Datalog programs
@@ -77,6 +81,125 @@ public:
     void dumpOutputs() {
         program->dumpOutputs();
     }
+
+    /**
+     * Calls the corresponding method souffle::SouffleProgram::reset in SouffleInterface.h
+     */
+    void reset() {
+        program->reset();
+    }
+
+    /**
+     * Returns the arity of the named relation, or 0 if it does not exist.
+     */
+    size_t getRelationArity(const std::string& relation) const {
+        auto* rel = program->getRelation(relation);
+        return rel == nullptr ? 0 : rel->getArity();
+    }
+
+    /**
+     * Returns the number of tuples of the named relation, or 0 if it does not exist.
+     */
+    size_t getRelationSize(const std::string& relation) const {
+        auto* rel = program->getRelation(relation);
+        return rel == nullptr ? 0 : rel->size();
+    }
+
+    /**
+     * Inserts a batch of tuples into the named relation from a flat buffer.
+     *
+     * The buffer holds row-major int64 values, one value per relation attribute
+     * per row; symbol columns hold indices obtained from encodeSymbols. From
+     * Python, a C-contiguous 2-D NumPy int64 array enters zero-copy through the
+     * buffer protocol; the rows reach the relation through the bulk-load path
+     * of souffle::Relation::insertBatch rather than per-tuple wrappers.
+     *
+     * @return The number of inserted rows; 0 when the relation is unknown or
+     * the buffer is not a whole number of rows
+     */
+    size_t insertBatch(const std::string& relation, const char* data, size_t size) {
+        auto* rel = program->getRelation(relation);
+        if (rel == nullptr) {
+            return 0;
+        }
+        const size_t arity = rel->getArity();
+        const size_t rowBytes = arity * sizeof(int64_t);
+        if (rowBytes == 0 || size % rowBytes != 0) {
+            return 0;
+        }
+        const size_t rows = size / rowBytes;
+        const auto* values = reinterpret_cast<const int64_t*>(data);
+        if constexpr (sizeof(souffle::RamDomain) == sizeof(int64_t)) {
+            rel->insertBatch(reinterpret_cast<const souffle::RamDomain*>(values), rows);
+        } else {
+            std::vector<souffle::RamDomain> batch(rows * arity);
+            for (size_t i = 0; i < rows * arity; i++) {
+                batch[i] = static_cast<souffle::RamDomain>(values[i]);
+            }
+            rel->insertBatch(batch.data(), rows);
+        }
+        return rows;
+    }
+
+    /**
+     * Copies the named relation into a flat buffer of row-major int64 values.
+     *
+     * From Python, pass a writable C-contiguous NumPy int64 array of shape
+     * (getRelationSize, getRelationArity); the tuples are copied out in blocks
+     * through souffle::Relation::extractBatch without per-tuple wrappers.
+     *
+     * @return The number of rows written, bounded by the buffer's capacity; 0
+     * when the relation is unknown
+     */
+    size_t extractBatch(const std::string& relation, char* data, size_t size) {
+        auto* rel = program->getRelation(relation);
+        if (rel == nullptr) {
+            return 0;
+        }
+        const size_t arity = rel->getArity();
+        const size_t rowBytes = arity * sizeof(int64_t);
+        if (rowBytes == 0) {
+            return 0;
+        }
+        const size_t capacity = size / rowBytes;
+        auto* values = reinterpret_cast<int64_t*>(data);
+        auto it = rel->begin();
+        if constexpr (sizeof(souffle::RamDomain) == sizeof(int64_t)) {
+            return rel->extractBatch(it, reinterpret_cast<souffle::RamDomain*>(values), capacity);
+        } else {
+            std::vector<souffle::RamDomain> batch(capacity * arity);
+            const size_t rows = rel->extractBatch(it, batch.data(), capacity);
+            for (size_t i = 0; i < rows * arity; i++) {
+                values[i] = static_cast<int64_t>(batch[i]);
+            }
+            return rows;
+        }
+    }
+
+    /**
+     * Interns a batch of symbols, returning one symbol index per entry for use
+     * in symbol columns of insertBatch buffers.
+     */
+    std::vector<long long> encodeSymbols(const std::vector<std::string>& symbols) {
+        std::vector<long long> indices(symbols.size());
+        auto& table = program->getSymbolTable();
+        for (size_t i = 0; i < symbols.size(); i++) {
+            indices[i] = static_cast<long long>(table.encode(symbols[i]));
+        }
+        return indices;
+    }
+
+    /**
+     * Decodes a batch of symbol indices back to their text.
+     */
+    std::vector<std::string> decodeSymbols(const std::vector<long long>& indices) {
+        std::vector<std::string> symbols(indices.size());
+        auto& table = program->getSymbolTable();
+        for (size_t i = 0; i < indices.size(); i++) {
+            symbols[i] = table.decode(static_cast<souffle::RamDomain>(indices[i]));
+        }
+        return symbols;
+    }
 };
 
 /**
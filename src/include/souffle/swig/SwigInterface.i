@@ -15,14 +15,25 @@
  *
  ***********************************************************************/
 
-%module SwigInterface 
-%include "std_string.i" 
-%include "std_map.i" 
+%module SwigInterface
+%include "std_string.i"
+%include "std_map.i"
 %include<std_vector.i>
 namespace std {
     %template(map_string_string) map<string, string>;
+    %template(vector_string) vector<string>;
+    %template(vector_int64) vector<long long>;
 }
 
+#ifdef SWIGPYTHON
+// zero-copy fact exchange: C-contiguous NumPy int64 arrays enter and leave
+// insertBatch/extractBatch through the buffer protocol instead of per-tuple
+// wrappers
+%include "pybuffer.i"
+%pybuffer_binary(const char* data, size_t size);
+%pybuffer_mutable_binary(char* data, size_t size);
+#endif
+
 %{
 #include "SwigInterface.h"
 #include <iostream>
@@ -17,6 +17,8 @@
 #pragma once
 
 #include <array>
+#include <atomic>
+#include <cstddef>
 #include <fstream>
 
 // -------------------------------------------------------------------------------
@@ -228,6 +230,61 @@ public:
     }
 };
 
+// -------------------------------------------------------------------------------
+//                           Adaptive Hint Probing
+// -------------------------------------------------------------------------------
+
+/**
+ * An adaptive gate placed in front of an operation-hint probe.
+ *
+ * Probing a hint pays off on workloads with temporal locality and is pure
+ * overhead on random access patterns. The gate observes the hit rate of the
+ * probes it admits in fixed-size windows and suspends probing when the rate
+ * drops below 1/16; while suspended it periodically re-admits probing, so a
+ * change of phase in the workload is picked up again.
+ */
+class HintProbeGate {
+    // the number of admitted probes per sampling window
+    static constexpr std::size_t probeWindow = 1024;
+
+    // the number of operations skipped before probing is re-sampled
+    static constexpr std::size_t suspendWindow = 8192;
+
+    // hits and total events observed in the current window
+    std::size_t hits = 0;
+    std::size_t events = 0;
+
+    // whether probing is currently suspended
+    bool suspended = false;
+
+public:
+    // determines whether the upcoming operation should probe its hint
+    bool shouldProbe() {
+        if (!suspended) {
+            return true;
+        }
+        if (++events >= suspendWindow) {
+            suspended = false;
+            hits = 0;
+            events = 0;
+        }
+        return false;
+    }
+
+    // registers the outcome of an admitted probe
+    void registerOutcome(bool hit) {
+        if (hit) {
+            ++hits;
+        }
+        if (++events < probeWindow) {
+            return;
+        }
+        suspended = hits * 16 < events;
+        hits = 0;
+        events = 0;
+    }
+};
+
 // -------------------------------------------------------------------------------
 //                           Hint / Cache Profiling
 // -------------------------------------------------------------------------------
@@ -237,8 +294,6 @@ public:
  */
 #ifdef _SOUFFLE_STATS
 
-#include <atomic>
-
 class CacheAccessCounter {
     std::atomic<std::size_t> hits;
     std::atomic<std::size_t> misses;
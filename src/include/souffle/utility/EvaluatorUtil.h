@@ -19,7 +19,12 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
+#include <array>
 #include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
 
 namespace souffle::evaluator {
 
@@ -46,6 +51,111 @@ void runRange(A from, A to, F&& go) {
     return runRange(from, to, A(from <= to ? 1 : -1), std::forward<F>(go));
 }
 
+/**
+ * Absorbs the closed span [lo,hi] into a relation offering a span insert.
+ * An unsigned span crossing the sign bit wraps in the signed tuple order
+ * and is split at the boundary.
+ */
+template <typename A, typename R /* offering insertRange(RamDomain, RamDomain) */>
+void fillClosedRange(R& rel, A lo, A hi) {
+    const RamDomain slo = ramBitCast<RamDomain>(lo);
+    const RamDomain shi = ramBitCast<RamDomain>(hi);
+    if (slo <= shi) {
+        rel.insertRange(slo, shi);
+    } else {
+        rel.insertRange(slo, std::numeric_limits<RamDomain>::max());
+        rel.insertRange(std::numeric_limits<RamDomain>::min(), shi);
+    }
+}
+
+/**
+ * Covers the same values as the matching runRange call, but absorbs them
+ * into the given relation as a handful of coalesced span updates instead
+ * of driving an insert per value. Only integral ranges are contiguous in
+ * the stored tuple order; float ranges must go through runRange.
+ */
+template <typename A, typename R>
+void fillRange(R& rel, A from, A to, A step) {
+    static_assert(std::is_integral_v<A>, "span fills require an integral range");
+    if (step == 1) {
+        if (from < to) {
+            fillClosedRange(rel, from, static_cast<A>(to - 1));
+        }
+        return;
+    }
+    if constexpr (std::is_signed_v<A>) {
+        if (step == -1) {
+            if (to < from) {
+                fillClosedRange(rel, static_cast<A>(to + 1), from);
+            }
+            return;
+        }
+    }
+    // non-unit strides do not cover contiguous spans; insert value by value
+    runRange(from, to, step, [&](const Tuple<RamDomain, 1>& t) { rel.insert(t); });
+}
+
+template <typename A, typename R>
+void fillRange(R& rel, A from, A to) {
+    // the implied step mirrors runRange: for an unsigned domain the
+    // descending direction degenerates to an empty range there as well
+    return fillRange(rel, from, to, A(from <= to ? 1 : -1));
+}
+
+/**
+ * A bounded memo table for string functor results: keys are up to three
+ * RamDomain arguments plus a caller-chosen operation tag, values are the
+ * interned result symbol id. String intrinsics like cat and substr are
+ * routinely re-evaluated on a small set of distinct argument tuples, each
+ * time building a temporary string and pushing it through the symbol
+ * table; hitting here turns the repeat evaluations into a single array
+ * probe. The table is direct-mapped and collisions simply overwrite, so
+ * it stays at a fixed size regardless of the workload.
+ */
+class StringFunctorMemo {
+public:
+    template <typename F /* () -> RamDomain */>
+    RamDomain memoize(uint32_t op, RamDomain a, RamDomain b, RamDomain c, F&& compute) {
+        Entry& entry = entries[index(op, a, b, c)];
+        if (entry.valid && entry.op == op && entry.a == a && entry.b == b && entry.c == c) {
+            return entry.result;
+        }
+        const RamDomain result = compute();
+        entry = {op, a, b, c, result, true};
+        return result;
+    }
+
+private:
+    struct Entry {
+        uint32_t op;
+        RamDomain a;
+        RamDomain b;
+        RamDomain c;
+        RamDomain result;
+        bool valid;
+    };
+
+    static constexpr std::size_t numEntries = 1 << 12;
+
+    static std::size_t index(uint32_t op, RamDomain a, RamDomain b, RamDomain c) {
+        // FNV-1a over the four key components
+        uint64_t h = 14695981039346656037ull;
+        for (uint64_t v : {uint64_t(op), uint64_t(ramBitCast<RamUnsigned>(a)),
+                     uint64_t(ramBitCast<RamUnsigned>(b)), uint64_t(ramBitCast<RamUnsigned>(c))}) {
+            h = (h ^ v) * 1099511628211ull;
+        }
+        return static_cast<std::size_t>(h) & (numEntries - 1);
+    }
+
+    std::array<Entry, numEntries> entries{};
+};
+
+/** The calling thread's memo table for string functor results. */
+inline StringFunctorMemo& stringFunctorMemo() {
+    static thread_local StringFunctorMemo memo;
+    return memo;
+}
+
 template <typename A>
 A symbol2numeric(const std::string& src) {
     try {
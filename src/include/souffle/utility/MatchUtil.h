@@ -0,0 +1,129 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MatchUtil.h
+ *
+ * Compiled pattern support for the match constraint, shared by the
+ * interpreter and synthesised code.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include <iostream>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace souffle {
+
+/**
+ * A match-constraint pattern compiled once per distinct pattern symbol.
+ *
+ * The patterns used by practical filters are mostly literals with at most
+ * a leading or trailing ".*"; those are recognised at construction time
+ * and dispatched to plain string comparisons, bypassing std::regex
+ * entirely. Everything else falls back to a std::regex that is built once
+ * and reused instead of being recompiled per evaluation.
+ */
+class MatchPattern {
+public:
+    explicit MatchPattern(std::string patternText) : pattern(std::move(patternText)) {
+        // decompose into (leading ".*")? literal (trailing ".*")?
+        std::string_view rest = pattern;
+        bool anyPrefix = false;
+        bool anySuffix = false;
+        if (rest.size() >= 2 && rest.substr(0, 2) == ".*") {
+            anyPrefix = true;
+            rest.remove_prefix(2);
+        }
+        if (rest.size() >= 2 && rest.substr(rest.size() - 2) == ".*") {
+            anySuffix = true;
+            rest.remove_suffix(2);
+        }
+        if (rest.find_first_of(".^$*+?()[]{}|\\") == std::string_view::npos) {
+            literal = std::string(rest);
+            kind = anyPrefix ? (anySuffix ? Kind::Infix : Kind::Suffix)
+                             : (anySuffix ? Kind::Prefix : Kind::Exact);
+            return;
+        }
+        try {
+            regex.emplace(pattern);
+            kind = Kind::General;
+        } catch (...) {
+            kind = Kind::Invalid;
+        }
+    }
+
+    /** Matches the text against the pattern; nullopt if the pattern is broken. */
+    std::optional<bool> tryMatch(const std::string& text) const {
+        switch (kind) {
+            case Kind::Exact: return text == literal;
+            case Kind::Prefix:
+                return text.size() >= literal.size() && text.compare(0, literal.size(), literal) == 0;
+            case Kind::Suffix:
+                return text.size() >= literal.size() &&
+                       text.compare(text.size() - literal.size(), literal.size(), literal) == 0;
+            case Kind::Infix: return text.find(literal) != std::string::npos;
+            case Kind::General:
+                try {
+                    return std::regex_match(text, *regex);
+                } catch (...) {
+                    break;
+                }
+            case Kind::Invalid: break;
+        }
+        return std::nullopt;
+    }
+
+    /** As tryMatch, but treats a broken pattern as a warned non-match. */
+    bool match(const std::string& text) const {
+        if (std::optional<bool> result = tryMatch(text)) {
+            return *result;
+        }
+        std::cerr << "warning: wrong pattern provided for match(\"" << pattern << "\",\"" << text
+                  << "\").\n";
+        return false;
+    }
+
+private:
+    enum class Kind { Exact, Prefix, Suffix, Infix, General, Invalid };
+
+    /** The original pattern text, kept for diagnostics */
+    std::string pattern;
+
+    /** The literal component of the simple pattern forms */
+    std::string literal;
+
+    /** The fallback engine for patterns beyond the simple forms */
+    std::optional<std::regex> regex;
+
+    Kind kind = Kind::Invalid;
+};
+
+/**
+ * The calling thread's cache of compiled match patterns, keyed by the
+ * pattern's symbol id. Symbol ids are stable for the whole run, so
+ * entries never expire; the handful of distinct patterns a program uses
+ * is compiled once per thread.
+ */
+inline const MatchPattern& cachedMatchPattern(RamDomain id, const std::string& pattern) {
+    static thread_local std::unordered_map<RamDomain, MatchPattern> cache;
+    auto it = cache.find(id);
+    if (it == cache.end()) {
+        it = cache.emplace(id, MatchPattern(pattern)).first;
+    }
+    return it->second;
+}
+
+}  // namespace souffle
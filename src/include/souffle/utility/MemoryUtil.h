@@ -0,0 +1,69 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file MemoryUtil.h
+ *
+ * Utilities for steering the placement of large allocations.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace souffle {
+
+/**
+ * Whether large allocations should be backed by huge pages, as requested
+ * via the SOUFFLE_HUGE_PAGES environment variable (set by the --huge-pages
+ * option). Large node pools suffer considerable TLB pressure on regular
+ * 4kB pages; huge pages trade a coarser memory granularity for far fewer
+ * TLB entries. Off by default since huge pages may increase the resident
+ * memory of sparse structures.
+ */
+inline bool useHugePages() {
+    static const bool enabled = std::getenv("SOUFFLE_HUGE_PAGES") != nullptr;
+    return enabled;
+}
+
+/**
+ * Asks the kernel to back the given allocation with transparent huge
+ * pages, provided huge pages are enabled and the platform supports the
+ * request. The advice covers the huge-page-aligned interior of the range,
+ * hence only allocations spanning several huge pages benefit; smaller
+ * ranges are left untouched. Best effort: the pages materialise on first
+ * touch and the kernel is free to ignore the advice, so failures are
+ * deliberately not reported.
+ */
+inline void adviseHugePages(void* addr, std::size_t bytes) {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (!useHugePages()) {
+        return;
+    }
+    constexpr std::uintptr_t hugePageSize = std::uintptr_t(1) << 21;
+    const std::uintptr_t from = reinterpret_cast<std::uintptr_t>(addr);
+    const std::uintptr_t begin = (from + hugePageSize - 1) & ~(hugePageSize - 1);
+    const std::uintptr_t end = (from + bytes) & ~(hugePageSize - 1);
+    if (begin < end) {
+        madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+    }
+#else
+    (void)addr;
+    (void)bytes;
+#endif
+}
+
+}  // namespace souffle
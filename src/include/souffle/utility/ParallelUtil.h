@@ -62,16 +62,25 @@ constexpr std::size_t hardware_destructive_interference_size = 2 * sizeof(max_al
 #define task_sync
 
 // section start / end => corresponding OpenMP pragmas
-// NOTE: disabled since it causes performance losses
-//#define SECTIONS_START _Pragma("omp parallel sections") {
-// NOTE: we stick to flat-level parallelism since it is faster due to thread pooling
+// NOTE: disabled by default since it causes performance losses
+// NOTE: we stick to flat-level parallelism since it is faster due to thread pooling;
+// programs whose strata form wide dependency DAGs may opt in via
+// -DSOUFFLE_PARALLEL_SECTIONS, trading inner-loop threads for concurrent strata
+#ifdef SOUFFLE_PARALLEL_SECTIONS
+#define SECTIONS_START _Pragma("omp parallel sections") {
+#define SECTIONS_END }
+
+// the markers for a single section
+#define SECTION_START _Pragma("omp section") {
+#define SECTION_END }
+#else
 #define SECTIONS_START {
 #define SECTIONS_END }
 
 // the markers for a single section
-//#define SECTION_START _Pragma("omp section") {
 #define SECTION_START {
 #define SECTION_END }
+#endif
 
 // a macro to create an operation context
 #define CREATE_OP_CONTEXT(NAME, INIT) [[maybe_unused]] auto NAME = INIT;
@@ -707,6 +716,143 @@ public:
     }
 };
 
+/**
+ * A process-wide execution context keeping the OpenMP worker team warm
+ * across program runs.
+ *
+ * OpenMP runtimes keep their workers alive between parallel regions, but
+ * the first region of a process pays thread creation and stack page-fault
+ * costs, repeated per request when a fresh process is used per run. The
+ * context pins the team size, disables dynamic team shrinking and runs one
+ * throwaway region in which every worker pre-faults a small scratch arena,
+ * warming its stack and allocator caches; subsequent runs then start on a
+ * hot pool. Warming up again is cheap unless the team has grown.
+ */
+class ExecutionContext {
+    /** One pre-faulted scratch arena per worker thread */
+    std::vector<std::vector<char>> arenas;
+
+    /** Number of workers already warmed up */
+    std::size_t warmThreads = 0;
+
+    /** Guards concurrent warmup requests */
+    std::mutex access;
+
+    /** Bytes of scratch memory pre-faulted per worker */
+    static constexpr std::size_t ArenaSize = 1 << 20;
+
+    /** Touch stride; one write per page suffices to fault it in */
+    static constexpr std::size_t PageSize = 4096;
+
+public:
+    /** Obtain the process-wide execution context. */
+    static ExecutionContext& instance() {
+        static ExecutionContext ctxt;
+        return ctxt;
+    }
+
+    /**
+     * Pin the team to the given size (0 keeps the current setting) and warm
+     * the workers; a no-op when the team is already warm.
+     */
+    void warmup(std::size_t numThreads = 0) {
+        if (numThreads > 0) {
+            omp_set_num_threads(static_cast<int>(numThreads));
+        }
+        // a dynamically shrinking runtime would tear workers down again
+        omp_set_dynamic(0);
+        const auto team = static_cast<std::size_t>(MAX_THREADS);
+        std::lock_guard<std::mutex> guard(access);
+        if (team <= warmThreads) {
+            return;
+        }
+        arenas.resize(team);
+#pragma omp parallel
+        {
+            auto& arena = arenas[omp_get_thread_num()];
+            if (arena.empty()) {
+                arena.resize(ArenaSize);
+                for (std::size_t i = 0; i < ArenaSize; i += PageSize) {
+                    arena[i] = 1;
+                }
+            }
+        }
+        warmThreads = team;
+    }
+
+    /** Scratch storage of the calling worker, pre-faulted by warmup. */
+    char* localArena() {
+        const auto lane = static_cast<std::size_t>(omp_get_thread_num());
+        return lane < arenas.size() ? arenas[lane].data() : nullptr;
+    }
+
+    /** Size of each worker's scratch arena in bytes. */
+    static constexpr std::size_t arenaSize() {
+        return ArenaSize;
+    }
+};
+
+/**
+ * A distributor of scan partitions with thread affinity, as a replacement
+ * for the plain dynamic schedule of parallel scans.
+ *
+ * Dynamic scheduling hands partitions to whichever thread asks next, so on
+ * multi-socket machines a scan touches remote memory for a large share of
+ * its partitions: the pages of a partition sit on the memory node of the
+ * thread that first touched them, and repeated scans pair threads and
+ * partitions differently every time. This schedule splits the iteration
+ * range into one contiguous block per thread instead; every thread drains
+ * its own block front to back and turns to the blocks of the other threads
+ * only once its own is exhausted. Partitions thereby keep their thread —
+ * and with it their memory node and cache affinity — across repeated scans
+ * of the same relation, while stealing retains the load balance of the
+ * dynamic schedule under skew.
+ */
+class AffinitySchedule {
+public:
+    /** the index reported once all partitions are consumed */
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit AffinitySchedule(std::size_t size)
+            : size(size), blockCount(static_cast<std::size_t>(MAX_THREADS)),
+              blocks(std::make_unique<Block[]>(blockCount)) {
+        for (std::size_t b = 0; b < blockCount; ++b) {
+            blocks[b].next.store(beginOf(b), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Obtains the index of the next partition the calling thread is to
+     * process, or npos once all partitions are consumed.
+     */
+    std::size_t fetch() {
+        const auto lane = static_cast<std::size_t>(omp_get_thread_num()) % blockCount;
+        for (std::size_t k = 0; k < blockCount; ++k) {
+            const std::size_t b = (lane + k) % blockCount;
+            const std::size_t idx = blocks[b].next.fetch_add(1, std::memory_order_relaxed);
+            if (idx < beginOf(b + 1)) {
+                return idx;
+            }
+        }
+        return npos;
+    }
+
+private:
+    /** the per-thread bump cursor, padded against false sharing */
+    struct Block {
+        alignas(hardware_destructive_interference_size) std::atomic<std::size_t> next{0};
+    };
+
+    /** the first partition of the given block */
+    std::size_t beginOf(std::size_t b) const {
+        return b * size / blockCount;
+    }
+
+    const std::size_t size;
+    const std::size_t blockCount;
+    std::unique_ptr<Block[]> blocks;
+};
+
 #else
 
 /**
@@ -855,6 +1001,45 @@ struct ConcurrentLanes : protected SeqConcurrentLanes {
     }
 };
 
+/**
+ * A 'sequential' execution context; there is no worker pool to keep warm.
+ */
+class ExecutionContext {
+public:
+    static ExecutionContext& instance() {
+        static ExecutionContext ctxt;
+        return ctxt;
+    }
+
+    void warmup(std::size_t = 0) {}
+
+    char* localArena() {
+        return nullptr;
+    }
+
+    static constexpr std::size_t arenaSize() {
+        return 0;
+    }
+};
+
+/**
+ * A 'sequential' schedule handing out the partitions in order.
+ */
+class AffinitySchedule {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    explicit AffinitySchedule(std::size_t size) : size(size) {}
+
+    std::size_t fetch() {
+        return next < size ? next++ : npos;
+    }
+
+private:
+    const std::size_t size;
+    std::size_t next = 0;
+};
+
 #endif
 
 /**
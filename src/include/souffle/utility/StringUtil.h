@@ -19,7 +19,9 @@
 #include "souffle/RamTypes.h"
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <limits>
 #include <set>
@@ -35,6 +37,95 @@ namespace souffle {
 // Forward declaration
 inline bool isPrefix(const std::string& prefix, const std::string& element);
 
+namespace detail {
+
+// SWAR (SIMD within a register) digit parsing is only valid on
+// little-endian targets; others take the generic conversion path
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+constexpr bool swarDigitParsing = true;
+#else
+constexpr bool swarDigitParsing = false;
+#endif
+
+/** Tests whether the given word holds eight consecutive decimal digit characters. */
+inline bool isEightDecimalDigits(const uint64_t chunk) {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ull) |
+                   (((chunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) ==
+           0x3333333333333333ull;
+}
+
+/** Converts a word of eight decimal digit characters to its numeric value. */
+inline uint64_t parseEightDecimalDigits(uint64_t chunk) {
+    chunk &= 0x0F0F0F0F0F0F0F0Full;
+    chunk = (chunk * 2561) >> 8;
+    chunk = ((chunk & 0x00FF00FF00FF00FFull) * 6553601) >> 16;
+    chunk = ((chunk & 0x0000FFFF0000FFFFull) * 42949672960001ull) >> 32;
+    return chunk;
+}
+
+/**
+ * Attempts to convert a decimal string eight digits at a time, mirroring the
+ * stoi/stoll behaviour of stopping at the first non-digit character. Returns
+ * false for inputs that require the generic conversion, i.e. unusual shapes
+ * and digit counts that may overflow the target type.
+ */
+template <typename T>
+bool tryDecimalFromString(const std::string& str, std::size_t* position, T& result) {
+    if (!swarDigitParsing) {
+        return false;
+    }
+
+    const char* s = str.data();
+    const std::size_t n = str.size();
+    std::size_t i = 0;
+
+    bool negative = false;
+    if (i < n && (s[i] == '-' || s[i] == '+')) {
+        if (s[i] == '-') {
+            if (!std::is_signed<T>::value) {
+                return false;
+            }
+            negative = true;
+        }
+        ++i;
+    }
+    const std::size_t first = i;
+
+    // numbers longer than this may overflow and are handled generically
+    constexpr std::size_t maxDigits = std::numeric_limits<T>::digits10;
+
+    uint64_t value = 0;
+    while (i + 8 <= n && (i - first) + 8 <= maxDigits) {
+        uint64_t chunk;
+        std::memcpy(&chunk, s + i, sizeof(chunk));
+        if (!isEightDecimalDigits(chunk)) {
+            break;
+        }
+        value = value * 100000000ull + parseEightDecimalDigits(chunk);
+        i += 8;
+    }
+    while (i < n && s[i] >= '0' && s[i] <= '9') {
+        if ((i - first) >= maxDigits) {
+            return false;
+        }
+        value = value * 10 + static_cast<uint64_t>(s[i] - '0');
+        ++i;
+    }
+
+    // leave empty inputs to the generic error handling
+    if (i == first) {
+        return false;
+    }
+
+    result = negative ? static_cast<T>(0) - static_cast<T>(value) : static_cast<T>(value);
+    if (position != nullptr) {
+        *position = i;
+    }
+    return true;
+}
+
+}  // namespace detail
+
 /**
  * Converts a string to a RamSigned
  *
@@ -56,6 +147,14 @@ inline RamSigned RamSignedFromString(
             return RamSignedFromString(str, position);
         }
     }
+    // fast word-at-a-time path for the common decimal case
+    if (base == 10) {
+        RamSigned result;
+        if (detail::tryDecimalFromString(str, position, result)) {
+            return result;
+        }
+    }
+
     std::string binaryNumber;
     bool parsingBinary = base == 2;
 
@@ -119,6 +218,14 @@ inline RamUnsigned RamUnsignedFromString(
         }
     }
 
+    // fast word-at-a-time path for the common decimal case
+    if (base == 10) {
+        RamUnsigned result;
+        if (detail::tryDecimalFromString(str, position, result)) {
+            return result;
+        }
+    }
+
     // stoul/stoull can't handle binary prefix by default.
     std::string binaryNumber;
     bool parsingBinary = false;
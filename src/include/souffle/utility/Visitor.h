@@ -21,6 +21,7 @@
 #include "souffle/utility/VisitorFwd.h"
 #include <cassert>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 
 namespace souffle {
@@ -149,6 +150,15 @@ struct Visitor {
 #define SOUFFLE_VISITOR_FORWARD(Kind) \
     if (auto* n = as<Kind>(node)) return visit_(type_identity<Kind>(), *n, args...);
 
+// Exact-type fast path for dispatchers: compares the node's type_info with a
+// pointer comparison instead of walking a dynamic_cast chain. Expects `kind`
+// to name `typeid(node)` in the enclosing dispatch. Node types not covered
+// (e.g. subclasses defined outside the dispatch list) fall through and are
+// still resolved by the SOUFFLE_VISITOR_FORWARD chain afterwards.
+#define SOUFFLE_VISITOR_FORWARD_EXACT(Kind)                                                          \
+    if (kind == typeid(Kind))                                                                        \
+        return visit_(type_identity<Kind>(), static_cast<copy_const<NodeType, Kind>&>(node), args...);
+
 #define SOUFFLE_VISITOR_LINK(Kind, Parent)                                                        \
     virtual R visit_(type_identity<Kind>, copy_const<NodeType, Kind>& n, Params const&... args) { \
         return visit_(type_identity<Parent>(), n, args...);                                       \
@@ -19,8 +19,11 @@
 #include "interpreter/Index.h"
 #include "interpreter/Relation.h"
 #include "souffle/RamTypes.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -39,6 +42,17 @@ public:
     /** This constructor is used when program enter a new scope.
      * Only Subroutine value needs to be copied */
     Context(Context& ctxt) : returnValues(ctxt.returnValues), args(ctxt.args) {}
+
+    /** @brief Create a context for a task taking over a slice of an enclosing
+     * loop. The tuple bindings visible at the point of the fork are retained;
+     * views are not shared between tasks and have to be recreated. */
+    static Context forkForTask(const Context& ctxt) {
+        Context fork;
+        fork.data = ctxt.data;
+        fork.returnValues = ctxt.returnValues;
+        fork.args = ctxt.args;
+        return fork;
+    }
     virtual ~Context() = default;
 
     const RamDomain*& operator[](std::size_t index) {
@@ -62,6 +76,22 @@ public:
         return allocatedDataContainer.back().get();
     }
 
+    /** @brief Draw the next auto-increment id from this context's block,
+     * fetching a fresh block from the shared counter when it is exhausted.
+     * The block size doubles on every refill up to a cap, adapting to the
+     * consumption rate; ids of an abandoned block are never handed out, so
+     * the resulting sequence is unique but not dense. */
+    RamDomain nextAutoInc(std::atomic<RamDomain>& counter) {
+        if (autoincNext == autoincEnd) {
+            autoincNext = counter.fetch_add(autoincBlock, std::memory_order_relaxed);
+            autoincEnd = autoincNext + autoincBlock;
+            if (autoincBlock < MaxAutoIncBlock) {
+                autoincBlock *= 2;
+            }
+        }
+        return autoincNext++;
+    }
+
     /** @brief Get subroutine return value */
     std::vector<RamDomain>& getReturnValues() const {
         return *returnValues;
@@ -94,12 +124,18 @@ public:
         return (*args)[i];
     }
 
-    /** @brief Create a view in the environment */
+    /** @brief Create or refresh a view in the environment.
+     * View slots are bound to a single relation/index pair for the lifetime of
+     * the program, so a view surviving from a previous loop iteration can be
+     * re-targeted in place instead of being reallocated. */
     void createView(const RelationWrapper& rel, std::size_t indexPos, std::size_t viewPos) {
-        ViewPtr view;
         if (views.size() < viewPos + 1) {
             views.resize(viewPos + 1);
         }
+        if (views[viewPos] != nullptr) {
+            rel.refreshView(indexPos, *views[viewPos]);
+            return;
+        }
         views[viewPos] = rel.createView(indexPos);
     }
 
@@ -109,6 +145,81 @@ public:
         return views[id].get();
     }
 
+    /** @brief Memoised result of a data-independent aggregate.
+     * The entry stays valid as long as the source relation is the same
+     * object, has not been purged and has not grown. */
+    struct AggregateMemo {
+        const void* relation = nullptr;
+        std::size_t version = 0;
+        std::size_t size = 0;
+        RamDomain result = 0;
+        bool runNested = false;
+        bool valid = false;
+    };
+
+    /** @brief Return the memo slot of an aggregate node, creating it on first use.
+     * Memos live in the context rather than in the node so that concurrently
+     * executing subroutines cannot race on them. */
+    AggregateMemo& getAggregateMemo(const void* node) {
+        return aggregateMemos[node];
+    }
+
+    /** @brief Enable staging of bufferable inserts in this context. Set on
+     * the thread-local contexts of parallel regions, where direct inserts
+     * would contend on the shared target structure. */
+    void enableInsertBuffering() {
+        insertBuffering = true;
+    }
+
+    /** @brief Whether bufferable inserts are staged in this context */
+    bool isInsertBuffering() const {
+        return insertBuffering;
+    }
+
+    /** @brief Stage a tuple for a later bulk release into the relation */
+    void bufferInsert(RelationWrapper& rel, const RamDomain* tuple) {
+        for (auto& buffer : insertBuffers) {
+            if (buffer.relation == &rel) {
+                buffer.data.insert(buffer.data.end(), tuple, tuple + rel.getArity());
+                return;
+            }
+        }
+        insertBuffers.push_back({&rel, {}});
+        auto& data = insertBuffers.back().data;
+        data.insert(data.end(), tuple, tuple + rel.getArity());
+    }
+
+    /** @brief Sort, deduplicate and release all staged tuples into their
+     * target relations. Sorted insertion walks the target index in
+     * sequential order and duplicates are dropped before they reach the
+     * shared structure. */
+    void flushInsertBuffers() {
+        for (auto& buffer : insertBuffers) {
+            auto& data = buffer.data;
+            if (data.empty()) {
+                continue;
+            }
+            const std::size_t arity = buffer.relation->getArity();
+            std::vector<const RamDomain*> rows;
+            rows.reserve(data.size() / arity);
+            for (std::size_t i = 0; i < data.size(); i += arity) {
+                rows.push_back(data.data() + i);
+            }
+            std::sort(rows.begin(), rows.end(), [arity](const RamDomain* a, const RamDomain* b) {
+                return std::lexicographical_compare(a, a + arity, b, b + arity);
+            });
+            const RamDomain* previous = nullptr;
+            for (const RamDomain* row : rows) {
+                if (previous != nullptr && std::equal(row, row + arity, previous)) {
+                    continue;
+                }
+                buffer.relation->insert(row);
+                previous = row;
+            }
+            data.clear();
+        }
+    }
+
 private:
     /** @brief Run-time value */
     std::vector<const RamDomain*> data;
@@ -120,6 +231,28 @@ private:
     VecOwn<RamDomain[]> allocatedDataContainer;
     /** @brief Views */
     VecOwn<ViewWrapper> views;
+    /** @brief Aggregate memo slots, keyed by the aggregate node */
+    std::map<const void*, AggregateMemo> aggregateMemos;
+
+    /** @brief Upper bound for the adaptive auto-increment block size */
+    static constexpr RamDomain MaxAutoIncBlock = 4096;
+    /** @brief Next id of this context's auto-increment block */
+    RamDomain autoincNext = 0;
+    /** @brief End of this context's auto-increment block */
+    RamDomain autoincEnd = 0;
+    /** @brief Ids fetched on the next refill; starts small so short-lived
+     * contexts abandon few ids */
+    RamDomain autoincBlock = 16;
+
+    /** @brief A staging area for inserts into one relation */
+    struct InsertBuffer {
+        RelationWrapper* relation;
+        std::vector<RamDomain> data;
+    };
+    /** @brief Whether bufferable inserts are staged in this context */
+    bool insertBuffering = false;
+    /** @brief Insert staging areas, one per target relation */
+    std::vector<InsertBuffer> insertBuffers;
 };
 
 }  // namespace souffle::interpreter
@@ -30,7 +30,10 @@
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/BinRelationStatement.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
 #include "ram/Extend.h"
@@ -47,6 +50,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NumericConstant.h"
@@ -62,7 +66,9 @@
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Query.h"
 #include "ram/Relation.h"
+#include "ram/RelationOperation.h"
 #include "ram/RelationSize.h"
+#include "ram/RelationStatement.h"
 #include "ram/Scan.h"
 #include "ram/Sequence.h"
 #include "ram/Statement.h"
@@ -83,12 +89,15 @@
 #include "souffle/SignalHandler.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/TypeAttribute.h"
+#include "souffle/datastructure/HyperLogLog.h"
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/ReadStream.h"
 #include "souffle/io/WriteStream.h"
 #include "souffle/profile/Logger.h"
 #include "souffle/profile/ProfileEvent.h"
 #include "souffle/utility/EvaluatorUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/MatchUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
@@ -97,15 +106,19 @@
 #include <atomic>
 #include <cassert>
 #include <cstdint>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <deque>
 #include <functional>
 #include <iostream>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
-#include <regex>
+#include <optional>
+#include <set>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -122,6 +135,17 @@ namespace souffle::interpreter {
 #define dynamicLibSuffix ".so";
 #endif
 
+// Largest number of partitions requested per thread for parallel scans.
+// Finer chunks allow threads that finish early to take over the remainder
+// of a skewed partition instead of idling until the straggler completes,
+// but pay a scheduler transaction each; the per-statement ScanGrain adapts
+// the actual count below this bound.
+static constexpr std::size_t scanChunkFactor = 32;
+
+// Number of tuples per task when a nested index scan splits a large range
+// into morsels for threads left idle by its enclosing parallel loop.
+static constexpr std::size_t morselSize = 2048;
+
 // Aliases for foreign function interface.
 #if RAM_DOMAIN_SIZE == 64
 #define FFI_RamSigned ffi_type_sint64
@@ -153,15 +177,51 @@ std::size_t number_of_threads(const std::size_t) {
 }
 #endif
 
+/** Whether the interpreter node is a load directive */
+bool isLoadStatement(const Node* node) {
+    if (node->getType() != I_IO) {
+        return false;
+    }
+    const auto& io = *static_cast<const ram::IO*>(node->getShadow());
+    return io.get("operation") == "input";
+}
+
 }  // namespace
 
 Engine::Engine(ram::TranslationUnit& tUnit)
         : profileEnabled(Global::config().has("profile")),
           frequencyCounterEnabled(Global::config().has("profile-frequency")),
+          profileSamplingEnabled(Global::config().has("profile-sampling")),
           isProvenance(Global::config().has("provenance")),
+          relaxedAutoInc(Global::config().has("relaxed-autoinc")),
           numOfThreads(number_of_threads(std::stoi(Global::config().get("jobs")))), tUnit(tUnit),
           isa(tUnit.getAnalysis<ram::analysis::IndexAnalysis>()), recordTable(numOfThreads),
-          symbolTable(numOfThreads) {}
+          symbolTable(numOfThreads), hotQueriesEnabled(Global::config().has("verbose")) {
+    if (Global::config().has("memory-budget")) {
+        memoryBudget = std::stoul(Global::config().get("memory-budget")) << 20;
+    }
+    if (Global::config().has("goal")) {
+        goalRelationName = Global::config().get("goal");
+    }
+    if (Global::config().has("parallel-threshold")) {
+        parallelThreshold = std::stoul(Global::config().get("parallel-threshold"));
+    }
+    ioParallelism = numOfThreads;
+    if (Global::config().has("io-parallelism")) {
+        ioParallelism = std::max<std::size_t>(1, std::stoul(Global::config().get("io-parallelism")));
+    }
+    if (Global::config().has("calibrate")) {
+        inputSample = Global::config().get("calibrate");
+    }
+}
+
+std::map<std::string, std::string> Engine::inputDirectives(const ram::IO& io) const {
+    auto directives = io.getDirectives();
+    if (!inputSample.empty()) {
+        directives["sample"] = inputSample;
+    }
+    return directives;
+}
 
 Engine::RelationHandle& Engine::getRelationHandle(const std::size_t idx) {
     return *relations[idx];
@@ -170,9 +230,90 @@ Engine::RelationHandle& Engine::getRelationHandle(const std::size_t idx) {
 void Engine::swapRelation(const std::size_t ramRel1, const std::size_t ramRel2) {
     RelationHandle& rel1 = getRelationHandle(ramRel1);
     RelationHandle& rel2 = getRelationHandle(ramRel2);
+    completePendingStores(rel1.get());
+    completePendingStores(rel2.get());
     std::swap(rel1, rel2);
 }
 
+void Engine::completePendingStores(const RelationWrapper* relation) {
+    auto it = pendingStores.find(relation);
+    if (it == pendingStores.end()) {
+        return;
+    }
+    for (auto& store : it->second) {
+        try {
+            store.get();
+        } catch (std::exception& e) {
+            std::cerr << e.what();
+            exit(EXIT_FAILURE);
+        }
+    }
+    pendingStores.erase(it);
+}
+
+void Engine::completeAllPendingStores() {
+    while (!pendingStores.empty()) {
+        completePendingStores(pendingStores.begin()->first);
+    }
+}
+
+void Engine::evalConcurrentLoads(const VecOwn<Node>& children, std::size_t begin, std::size_t end) {
+    std::atomic<std::size_t> next{begin};
+    const std::size_t workers = std::min(ioParallelism, end - begin);
+    std::vector<std::future<void>> loaders;
+    loaders.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i) {
+        loaders.push_back(std::async(std::launch::async, [&] {
+            for (;;) {
+                const std::size_t idx = next.fetch_add(1);
+                if (idx >= end) {
+                    return;
+                }
+                const auto& cur = *static_cast<const ram::IO*>(children[idx]->getShadow());
+                auto& rel = *static_cast<const IO&>(*children[idx]).getRelation();
+                try {
+                    IOSystem::getInstance()
+                            .getReader(inputDirectives(cur), getSymbolTable(), getRecordTable())
+                            ->readAll(rel);
+                } catch (std::exception& e) {
+                    std::cerr << "Error loading data: " << e.what() << "\n";
+                }
+            }
+        }));
+    }
+    for (auto& loader : loaders) {
+        loader.get();
+    }
+}
+
+void Engine::reportHotQueries() const {
+    std::chrono::microseconds total{0};
+    for (const auto& [query, time] : queryTimes) {
+        total += time;
+    }
+    if (total.count() == 0) {
+        return;
+    }
+
+    // list the queries accounting for the bulk of the evaluation time;
+    // these are the prime candidates for running in compiled mode
+    std::vector<std::pair<const ram::Node*, std::chrono::microseconds>> hot(
+            queryTimes.begin(), queryTimes.end());
+    std::sort(hot.begin(), hot.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+
+    std::cout << "Hot queries (by cumulative evaluation time):\n";
+    std::size_t shown = 0;
+    for (const auto& [query, time] : hot) {
+        const auto percent = (100 * time.count()) / total.count();
+        if (percent < 5 || shown >= 5) {
+            break;
+        }
+        std::cout << "-- query: " << percent << "% (" << (time.count() / 1000) << "ms) --\n";
+        std::cout << *query;
+        ++shown;
+    }
+}
+
 int Engine::incCounter() {
     return counter++;
 }
@@ -211,6 +352,12 @@ void Engine::createRelation(const ram::Relation& id, const std::size_t idx) {
     } else {
         if (isProvenance) {
             res = createProvenanceRelation(id, isa.getIndexSelection(id.getName()));
+        } else if (id.getRepresentation() == RelationRepresentation::BRIE && id.getArity() == 1) {
+            // unary brie relations reduce to a sparse bit map
+            res = createBrieRelation(id, isa.getIndexSelection(id.getName()));
+        } else if (id.getRepresentation() == RelationRepresentation::INTERVAL) {
+            // interval relations store coalesced spans of a unary domain
+            res = createIntervalRelation(id, isa.getIndexSelection(id.getName()));
         } else {
             res = createBTreeRelation(id, isa.getIndexSelection(id.getName()));
         }
@@ -273,7 +420,14 @@ void Engine::resetIterationNumber() {
     iteration = 0;
 }
 
+void Engine::setPerformIO(bool value) {
+    performIO = value;
+}
+
 void Engine::executeMain() {
+    // keep the worker pool warm across repeat runs of the same process
+    ExecutionContext::instance().warmup(numOfThreads);
+
     SignalHandler::instance()->set();
     if (Global::config().has("verbose")) {
         SignalHandler::instance()->enableLogging();
@@ -284,11 +438,26 @@ void Engine::executeMain() {
 
     loadDLL();
 
+    // give stateful functor libraries a chance to set up shared state
+    // (database handles, caches) once per run instead of once per call
+    if (auto* init = reinterpret_cast<void (*)()>(getMethodHandle("souffle_functors_init"))) {
+        init();
+    }
+
     Context ctxt;
 
     if (!profileEnabled) {
         Context ctxt;
-        execute(main.get(), ctxt);
+        if (Global::config().has("snapshot")) {
+            executeWithSnapshots(ctxt);
+        } else if (!goalRelationName.empty()) {
+            executeGoalDirected(ctxt);
+        } else if (memoryBudget > 0) {
+            executeWithMemoryBudget(ctxt);
+        } else {
+            executeWithCompaction(ctxt);
+        }
+        completeAllPendingStores();
     } else {
         ProfileEventSingleton::instance().setOutputFile(Global::config().get("profile"));
         // Prepare the frequency table for threaded use
@@ -301,6 +470,9 @@ void Engine::executeMain() {
         });
         // Enable profiling for execution of main
         ProfileEventSingleton::instance().startTimer();
+        if (profileSamplingEnabled) {
+            ProfileEventSingleton::instance().startSampler();
+        }
         ProfileEventSingleton::instance().makeTimeEvent("@time;starttime");
         // Store configuration
         for (auto&& [k, vs] : Global::config().data())
@@ -322,8 +494,47 @@ void Engine::executeMain() {
         visit(program, [&](const ram::Query&) { ++ruleCount; });
         ProfileEventSingleton::instance().makeConfigRecord("ruleCount", std::to_string(ruleCount));
 
+        // Periodically attribute live memory to the relations and to the
+        // symbol and record tables; invoked from the profiling timer thread,
+        // hence restricted to the constant-time accounting interfaces.
+        ProfileEventSingleton::instance().setMemorySampler([this]() {
+            for (const auto& handle : relations) {
+                if (handle == nullptr || *handle == nullptr) {
+                    continue;
+                }
+                const auto& rel = **handle;
+                if (rel.getName()[0] == '@') {
+                    continue;
+                }
+                ProfileEventSingleton::instance().makeMemoryEvent(rel.getName(), rel.getMemoryUsage());
+            }
+            ProfileEventSingleton::instance().makeMemoryEvent(
+                    "symbol-table", getSymbolTable().getMemoryUsage());
+            ProfileEventSingleton::instance().makeMemoryEvent(
+                    "record-table", getRecordTable().getMemoryUsage());
+        });
+
         Context ctxt;
-        execute(main.get(), ctxt);
+        if (const auto* sequence = dynamic_cast<const Sequence*>(main.get())) {
+            // Mark the entry into each stratum so a live profile session can
+            // tell which one is currently executing.
+            std::size_t stratumIndex = 0;
+            for (const auto& stratum : sequence->getChildren()) {
+                ProfileEventSingleton::instance().makeTimeEvent(
+                        "@time;stratum;" + std::to_string(stratumIndex++));
+                execute(stratum.get(), ctxt);
+            }
+        } else {
+            execute(main.get(), ctxt);
+        }
+        completeAllPendingStores();
+        // The sampler captures this engine; drop it before the relations go away.
+        ProfileEventSingleton::instance().clearMemorySampler();
+        if (profileSamplingEnabled) {
+            // Synthesize the timing events from the gathered samples while
+            // the RAM program, which owns the sampled labels, is still alive.
+            ProfileEventSingleton::instance().stopSampler();
+        }
         ProfileEventSingleton::instance().stopTimer();
         for (auto const& cur : frequencies) {
             for (std::size_t i = 0; i < cur.second.size(); ++i) {
@@ -334,33 +545,509 @@ void Engine::executeMain() {
             ProfileEventSingleton::instance().makeQuantityEvent(
                     "@relation-reads;" + cur.first, cur.second, 0);
         }
+        // per-column distinct estimates, feeding cost models and monitoring
+        for (auto& handle : relations) {
+            if (handle == nullptr) {
+                continue;
+            }
+            const auto& rel = **handle;
+            if (rel.getName()[0] == '@') {
+                continue;
+            }
+            std::vector<HyperLogLog> sketches(rel.getArity());
+            const auto stop = rel.end();
+            for (auto it = rel.begin(); it != stop; ++it) {
+                const RamDomain* tuple = *it;
+                for (std::size_t j = 0; j < sketches.size(); ++j) {
+                    sketches[j].insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(tuple[j])));
+                }
+            }
+            for (std::size_t j = 0; j < sketches.size(); ++j) {
+                ProfileEventSingleton::instance().makeQuantityEvent(
+                        "@relation-distinct;" + rel.getName() + ";" + std::to_string(j),
+                        sketches[j].estimate(), 0);
+            }
+        }
+    }
+    if (hotQueriesEnabled) {
+        reportHotQueries();
+    }
+    // counterpart of souffle_functors_init, releasing per-run functor state
+    if (auto* teardown = reinterpret_cast<void (*)()>(getMethodHandle("souffle_functors_teardown"))) {
+        teardown();
     }
     SignalHandler::instance()->reset();
 }
 
-void Engine::generateIR() {
+namespace {
+
+/** Leading tag of the binary snapshot format, bumped on layout changes. */
+constexpr char snapshotMagic[8] = {'S', 'f', 'l', 'S', 'n', 'a', 'p', '1'};
+
+template <typename T>
+void writeRaw(std::ostream& os, const T& value) {
+    os.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+T readRaw(std::istream& is) {
+    T value{};
+    is.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+void writeString(std::ostream& os, const std::string& str) {
+    writeRaw<uint64_t>(os, str.size());
+    os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+std::string readString(std::istream& is) {
+    std::string str(readRaw<uint64_t>(is), '\0');
+    is.read(str.data(), static_cast<std::streamsize>(str.size()));
+    return str;
+}
+
+}  // namespace
+
+void Engine::executeWithSnapshots(Context& ctxt) {
+    std::vector<const Node*> strata;
+    if (const auto* sequence = dynamic_cast<const Sequence*>(main.get())) {
+        for (const auto& stratum : sequence->getChildren()) {
+            strata.push_back(stratum.get());
+        }
+    } else {
+        strata.push_back(main.get());
+    }
+    const std::size_t completed = restoreSnapshot();
+    if (completed > strata.size()) {
+        fatal("snapshot file `%s` does not match the current program", Global::config().get("snapshot"));
+    }
+    for (std::size_t i = completed; i < strata.size(); i++) {
+        execute(strata[i], ctxt);
+        saveSnapshot(i + 1);
+    }
+}
+
+void Engine::saveSnapshot(const std::size_t completedStrata) const {
+    // Symbol and record references can only be reproduced on restore if
+    // their enumerations carry no index gaps. A gap can be left behind by a
+    // racing insertion in a preceding parallel section; in that rare case
+    // keep the previous snapshot and try again after the next stratum.
+    std::size_t symbolCount = 0;
+    for (auto it = symbolTable.begin(); it != symbolTable.end(); ++it) {
+        if (it->second != symbolCount) {
+            std::cerr << "warning: skipping snapshot, symbol references are not contiguous\n";
+            return;
+        }
+        ++symbolCount;
+    }
+    std::map<std::size_t, std::vector<RamDomain>> recordsByArity;
+    bool contiguous = true;
+    recordTable.enumerate([&](std::size_t arity, RamDomain ref, const RamDomain* tuple) {
+        auto& flat = recordsByArity[arity];
+        if (!contiguous || static_cast<std::size_t>(ref) != flat.size() / arity + 1) {
+            contiguous = false;
+            return;
+        }
+        flat.insert(flat.end(), tuple, tuple + arity);
+    });
+    if (!contiguous) {
+        std::cerr << "warning: skipping snapshot, record references are not contiguous\n";
+        return;
+    }
+
+    const std::string path = Global::config().get("snapshot");
+    const std::string tmpPath = path + ".part";
+    std::ofstream os(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        std::cerr << "warning: cannot write snapshot file " << tmpPath << "\n";
+        return;
+    }
+    os.write(snapshotMagic, sizeof(snapshotMagic));
+    writeRaw<uint64_t>(os, completedStrata);
+
+    writeRaw<uint64_t>(os, symbolCount);
+    for (auto it = symbolTable.begin(); it != symbolTable.end(); ++it) {
+        writeString(os, it->first);
+    }
+
+    writeRaw<uint64_t>(os, recordsByArity.size());
+    for (const auto& [arity, flat] : recordsByArity) {
+        writeRaw<uint64_t>(os, arity);
+        writeRaw<uint64_t>(os, flat.size() / arity);
+        os.write(reinterpret_cast<const char*>(flat.data()),
+                static_cast<std::streamsize>(flat.size() * sizeof(RamDomain)));
+    }
+
+    writeRaw<uint64_t>(os, relations.size());
+    for (const auto& handle : relations) {
+        const RelationWrapper& rel = **handle;
+        writeString(os, rel.getName());
+        writeRaw<uint64_t>(os, rel.getArity());
+        writeRaw<uint64_t>(os, rel.size());
+        const std::streamsize rowSize = static_cast<std::streamsize>(rel.getArity() * sizeof(RamDomain));
+        for (auto it = rel.begin(); it != rel.end(); ++it) {
+            os.write(reinterpret_cast<const char*>(*it), rowSize);
+        }
+    }
+
+    // Only replace the previous snapshot once the new one is complete, so
+    // that a crash mid-write never loses the last good checkpoint.
+    os.close();
+    if (!os || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "warning: cannot finalise snapshot file " << path << "\n";
+    }
+}
+
+std::size_t Engine::restoreSnapshot() {
+    const std::string path = Global::config().get("snapshot");
+    std::ifstream is(path, std::ios::binary);
+    if (!is) {
+        // No snapshot yet: cold start.
+        return 0;
+    }
+    char magic[sizeof(snapshotMagic)];
+    is.read(magic, sizeof(magic));
+    if (!is || memcmp(magic, snapshotMagic, sizeof(magic)) != 0) {
+        fatal("file `%s` is not a souffle snapshot", path);
+    }
+    const auto completedStrata = readRaw<uint64_t>(is);
+
+    // Symbols interned while generating the IR are simply deduplicated; the
+    // indices line up as long as the program itself has not changed.
+    const auto symbolCount = readRaw<uint64_t>(is);
+    for (uint64_t i = 0; i < symbolCount; i++) {
+        if (static_cast<uint64_t>(symbolTable.findOrInsert(readString(is)).first) != i) {
+            fatal("snapshot file `%s` is incompatible with the current program", path);
+        }
+    }
+
+    const auto mapCount = readRaw<uint64_t>(is);
+    for (uint64_t m = 0; m < mapCount; m++) {
+        const auto arity = readRaw<uint64_t>(is);
+        const auto count = readRaw<uint64_t>(is);
+        std::vector<RamDomain> tuple(std::max<std::size_t>(arity, 1));
+        for (uint64_t i = 0; i < count; i++) {
+            is.read(reinterpret_cast<char*>(tuple.data()),
+                    static_cast<std::streamsize>(arity * sizeof(RamDomain)));
+            if (recordTable.pack(tuple.data(), arity) != static_cast<RamDomain>(i + 1)) {
+                fatal("snapshot file `%s` is incompatible with the current program", path);
+            }
+        }
+    }
+
+    if (readRaw<uint64_t>(is) != relations.size()) {
+        fatal("snapshot file `%s` is incompatible with the current program", path);
+    }
+    for (const auto& handle : relations) {
+        RelationWrapper& rel = **handle;
+        const std::string name = readString(is);
+        const auto arity = readRaw<uint64_t>(is);
+        const auto count = readRaw<uint64_t>(is);
+        if (name != rel.getName() || arity != rel.getArity()) {
+            fatal("snapshot file `%s` is incompatible with the current program", path);
+        }
+        std::vector<RamDomain> tuple(std::max<std::size_t>(arity, 1));
+        for (uint64_t i = 0; i < count; i++) {
+            is.read(reinterpret_cast<char*>(tuple.data()),
+                    static_cast<std::streamsize>(arity * sizeof(RamDomain)));
+            rel.insert(tuple.data());
+        }
+    }
+    if (!is) {
+        fatal("snapshot file `%s` is truncated", path);
+    }
+    return completedStrata;
+}
+
+namespace {
+
+/** Collect the given RAM fragment and the bodies of all subroutines it
+ * (transitively) calls. Stratum statements are plain calls, so relation
+ * usage has to be read off the called body. */
+std::vector<const ram::Node*> collectFragments(const ram::Program& program, const ram::Node& root) {
+    std::vector<const ram::Node*> fragments = {&root};
+    std::set<std::string> seen;
+    for (std::size_t i = 0; i < fragments.size(); ++i) {
+        visit(*fragments[i], [&](const ram::Call& call) {
+            if (!seen.insert(call.getName()).second) {
+                return;
+            }
+            const auto subroutines = program.getSubroutines();
+            auto pos = subroutines.find(call.getName());
+            if (pos != subroutines.end()) {
+                fragments.push_back(pos->second);
+            }
+        });
+    }
+    return fragments;
+}
+
+/** Collect the names of all relations the given RAM fragment references. */
+std::set<std::string> referencedRelations(const ram::Program& program, const ram::Node& root) {
+    std::set<std::string> names;
+    for (const ram::Node* fragment : collectFragments(program, root)) {
+        visit(*fragment, [&](const ram::RelationOperation& op) { names.insert(op.getRelation()); });
+        visit(*fragment, [&](const ram::RelationStatement& stmt) { names.insert(stmt.getRelation()); });
+        visit(*fragment, [&](const ram::BinRelationStatement& stmt) {
+            names.insert(stmt.getFirstRelation());
+            names.insert(stmt.getSecondRelation());
+        });
+        visit(*fragment,
+                [&](const ram::AbstractExistenceCheck& check) { names.insert(check.getRelation()); });
+        visit(*fragment, [&](const ram::EmptinessCheck& check) { names.insert(check.getRelation()); });
+        visit(*fragment, [&](const ram::RelationSize& size) { names.insert(size.getRelation()); });
+        visit(*fragment, [&](const ram::Insert& insert) { names.insert(insert.getRelation()); });
+        visit(*fragment, [&](const ram::Erase& erase) { names.insert(erase.getRelation()); });
+    }
+    return names;
+}
+
+/** Collect the names of all relations the given RAM fragment may add tuples to. */
+std::set<std::string> producedRelations(const ram::Program& program, const ram::Node& root) {
+    std::set<std::string> names;
+    for (const ram::Node* fragment : collectFragments(program, root)) {
+        visit(*fragment, [&](const ram::Insert& insert) { names.insert(insert.getRelation()); });
+        visit(*fragment, [&](const ram::IO& io) { names.insert(io.getRelation()); });
+        visit(*fragment, [&](const ram::BinRelationStatement& stmt) {
+            names.insert(stmt.getFirstRelation());
+            names.insert(stmt.getSecondRelation());
+        });
+    }
+    return names;
+}
+
+}  // namespace
+
+void Engine::executeWithMemoryBudget(Context& ctxt) {
+    std::vector<const Node*> strata;
+    if (const auto* sequence = dynamic_cast<const Sequence*>(main.get())) {
+        for (const auto& stratum : sequence->getChildren()) {
+            strata.push_back(stratum.get());
+        }
+    } else {
+        strata.push_back(main.get());
+    }
+    for (const Node* stratum : strata) {
+        const std::set<std::string> active =
+                referencedRelations(tUnit.getProgram(), *stratum->getShadow());
+        // Anything the stratum touches must be resident before it runs.
+        for (const auto& handle : relations) {
+            if (handle == nullptr || *handle == nullptr) {
+                continue;
+            }
+            RelationWrapper& rel = **handle;
+            if (active.count(rel.getName()) != 0) {
+                reloadRelation(rel);
+            }
+        }
+        // Under memory pressure, move the largest relations the stratum does
+        // not reference out to disk until the budget is met again.
+        std::size_t resident = 0;
+        std::vector<RelationWrapper*> cold;
+        for (const auto& handle : relations) {
+            if (handle == nullptr || *handle == nullptr) {
+                continue;
+            }
+            RelationWrapper& rel = **handle;
+            if (spillFiles.count(rel.getName()) != 0) {
+                continue;
+            }
+            resident += rel.getMemoryUsage();
+            if (active.count(rel.getName()) == 0 && rel.size() > 0) {
+                cold.push_back(&rel);
+            }
+        }
+        std::sort(cold.begin(), cold.end(), [](const RelationWrapper* a, const RelationWrapper* b) {
+            return a->getMemoryUsage() > b->getMemoryUsage();
+        });
+        for (RelationWrapper* rel : cold) {
+            if (resident <= memoryBudget) {
+                break;
+            }
+            const std::size_t bytes = rel->getMemoryUsage();
+            spillRelation(*rel);
+            if (spillFiles.count(rel->getName()) != 0) {
+                resident -= bytes;
+            }
+        }
+        execute(stratum, ctxt);
+    }
+    // Stores and the host program read the relations through the interface
+    // afterwards; bring everything back in.
+    for (const auto& handle : relations) {
+        if (handle == nullptr || *handle == nullptr) {
+            continue;
+        }
+        reloadRelation(**handle);
+    }
+}
+
+void Engine::spillRelation(RelationWrapper& rel) {
+    completePendingStores(&rel);
+    std::string path = tempFile();
+    std::ofstream os(path, std::ios::binary | std::ios::trunc);
+    if (!os) {
+        std::cerr << "warning: cannot write spill file " << path << "\n";
+        std::remove(path.c_str());
+        return;
+    }
+    writeRaw<uint64_t>(os, rel.size());
+    const std::streamsize rowSize = static_cast<std::streamsize>(rel.getArity() * sizeof(RamDomain));
+    const auto stop = rel.end();
+    for (auto it = rel.begin(); it != stop; ++it) {
+        os.write(reinterpret_cast<const char*>(*it), rowSize);
+    }
+    os.close();
+    if (!os) {
+        // Keep the relation resident rather than risk losing tuples.
+        std::cerr << "warning: cannot write spill file " << path << "\n";
+        std::remove(path.c_str());
+        return;
+    }
+    rel.purge();
+    spillFiles[rel.getName()] = std::move(path);
+}
+
+void Engine::reloadRelation(RelationWrapper& rel) {
+    const auto entry = spillFiles.find(rel.getName());
+    if (entry == spillFiles.end()) {
+        return;
+    }
+    std::ifstream is(entry->second, std::ios::binary);
+    if (!is) {
+        fatal("cannot reload spill file `%s` of relation %s", entry->second, rel.getName());
+    }
+    const auto count = readRaw<uint64_t>(is);
+    const std::size_t arity = rel.getArity();
+    std::vector<RamDomain> tuple(std::max<std::size_t>(arity, 1));
+    for (uint64_t i = 0; i < count; i++) {
+        is.read(reinterpret_cast<char*>(tuple.data()),
+                static_cast<std::streamsize>(arity * sizeof(RamDomain)));
+        rel.insert(tuple.data());
+    }
+    if (!is) {
+        fatal("spill file `%s` of relation %s is truncated", entry->second, rel.getName());
+    }
+    std::remove(entry->second.c_str());
+    spillFiles.erase(entry);
+}
+
+void Engine::executeGoalDirected(Context& ctxt) {
+    for (const auto& handle : relations) {
+        if (handle != nullptr && *handle != nullptr && (*handle)->getName() == goalRelationName) {
+            goalHandle = handle.get();
+        }
+    }
+    if (goalHandle == nullptr) {
+        fatal("goal relation `%s` does not exist", goalRelationName);
+    }
+    std::vector<const Node*> strata;
+    if (const auto* sequence = dynamic_cast<const Sequence*>(main.get())) {
+        for (const auto& stratum : sequence->getChildren()) {
+            strata.push_back(stratum.get());
+        }
+    } else {
+        strata.push_back(main.get());
+    }
+    // Backward closure from the goal: since the strata are topologically
+    // ordered, a single reverse sweep finds every stratum that can feed it.
+    std::set<std::string> needed = {goalRelationName};
+    std::vector<bool> onPath(strata.size(), false);
+    for (std::size_t i = strata.size(); i-- > 0;) {
+        const std::set<std::string> produced = producedRelations(tUnit.getProgram(), *strata[i]->getShadow());
+        const bool feeds = std::any_of(produced.begin(), produced.end(),
+                [&](const std::string& name) { return needed.count(name) != 0; });
+        if (feeds) {
+            onPath[i] = true;
+            const std::set<std::string> referenced =
+                    referencedRelations(tUnit.getProgram(), *strata[i]->getShadow());
+            needed.insert(referenced.begin(), referenced.end());
+        }
+    }
+    for (std::size_t i = 0; i < strata.size(); i++) {
+        if (!onPath[i]) {
+            continue;
+        }
+        execute(strata[i], ctxt);
+        if ((*goalHandle)->size() > 0) {
+            break;
+        }
+    }
+    goalHandle = nullptr;
+}
+
+void Engine::executeWithCompaction(Context& ctxt) {
+    std::vector<const Node*> strata;
+    if (const auto* sequence = dynamic_cast<const Sequence*>(main.get())) {
+        for (const auto& stratum : sequence->getChildren()) {
+            strata.push_back(stratum.get());
+        }
+    } else {
+        strata.push_back(main.get());
+    }
+    // Resolve each stratum's relation usage up front: strata release their
+    // subroutine bodies once executed, so the sets cannot be derived later.
     const ram::Program& program = tUnit.getProgram();
-    NodeGenerator generator(*this);
-    if (subroutine.empty()) {
+    std::vector<std::set<std::string>> produced(strata.size());
+    std::vector<std::set<std::string>> referenced(strata.size());
+    for (std::size_t i = 0; i < strata.size(); ++i) {
+        produced[i] = producedRelations(program, *strata[i]->getShadow());
+        referenced[i] = referencedRelations(program, *strata[i]->getShadow());
+    }
+    for (std::size_t i = 0; i < strata.size(); ++i) {
+        execute(strata[i], ctxt);
+        // A relation this stratum wrote and no later one writes is final;
+        // rebuild it into a packed layout while later strata still probe it.
+        std::set<std::string> writtenLater;
+        std::set<std::string> readLater;
+        for (std::size_t j = i + 1; j < strata.size(); ++j) {
+            writtenLater.insert(produced[j].begin(), produced[j].end());
+            readLater.insert(referenced[j].begin(), referenced[j].end());
+        }
+        for (const auto& handle : relations) {
+            if (handle == nullptr || *handle == nullptr) {
+                continue;
+            }
+            RelationWrapper& rel = **handle;
+            const std::string& name = rel.getName();
+            if (name[0] == '@' || rel.size() == 0) {
+                continue;
+            }
+            if (produced[i].count(name) == 0 || writtenLater.count(name) != 0 ||
+                    readLater.count(name) == 0) {
+                continue;
+            }
+            // a background store may still be iterating the old layout
+            completePendingStores(&rel);
+            rel.compact();
+        }
+    }
+}
+
+void Engine::generateIR() {
+    // Subroutines may be invoked concurrently once the main program has
+    // finished, so the lazy IR construction must happen exactly once.
+    std::call_once(generateIRFlag, [&]() {
+        const ram::Program& program = tUnit.getProgram();
+        NodeGenerator generator(*this);
         for (const auto& sub : program.getSubroutines()) {
+            subroutineIndex[sub.first] = subroutine.size();
             subroutine.push_back(generator.generateTree(*sub.second));
         }
-    }
-    if (main == nullptr) {
         main = generator.generateTree(program.getMain());
-    }
+    });
 }
 
 void Engine::executeSubroutine(
         const std::string& name, const std::vector<RamDomain>& args, std::vector<RamDomain>& ret) {
+    // Each invocation evaluates against its own context; the relations are
+    // frozen after the main run, so concurrent calls do not interfere.
     Context ctxt;
     ctxt.setReturnValues(ret);
     ctxt.setArguments(args);
     generateIR();
-    const ram::Program& program = tUnit.getProgram();
-    auto subs = program.getSubroutines();
-    std::size_t i = distance(subs.begin(), subs.find(name));
-    execute(subroutine[i].get(), ctxt);
+    execute(subroutine[subroutineIndex.at(name)].get(), ctxt);
 }
 
 RamDomain Engine::execute(const Node* node, Context& ctxt) {
@@ -369,6 +1056,21 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #define EVAL_LEFT(ty) ramBitCast<ty>(execute(shadow.getLhs(), ctxt))
 #define EVAL_RIGHT(ty) ramBitCast<ty>(execute(shadow.getRhs(), ctxt))
 
+// Where the GNU labels-as-values extension is available, dispatch jumps
+// through a table of label addresses instead of the type switch. The
+// indirect jump sits at each operation's body, giving the branch predictor
+// one target history per operation instead of a single shared dispatch
+// point, which removes a large share of mispredictions in the execute loop.
+#if defined(__GNUC__)
+#define SOUFFLE_COMPUTED_GOTO 1
+#endif
+
+#ifdef SOUFFLE_COMPUTED_GOTO
+#define CASE_LABEL(Id) lbl_##Id:
+#else
+#define CASE_LABEL(Id) case (Id):
+#endif
+
 // Overload CASE based on number of arguments.
 // CASE(Kind) -> BASE_CASE(Kind)
 // CASE(Kind, Structure, Arity) -> EXTEND_CASE(Kind, Structure, Arity)
@@ -376,13 +1078,13 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #define CASE(...) GET_MACRO(__VA_ARGS__, EXTEND_CASE, _Dummy, BASE_CASE)(__VA_ARGS__)
 
 #define BASE_CASE(Kind) \
-    case (I_##Kind): {  \
+    CASE_LABEL(I_##Kind) { \
         return [&]() -> RamDomain { \
             [[maybe_unused]] const auto& shadow = *static_cast<const interpreter::Kind*>(node); \
             [[maybe_unused]] const auto& cur = *static_cast<const ram::Kind*>(node->getShadow());
 // EXTEND_CASE also defer the relation type
-#define EXTEND_CASE(Kind, Structure, Arity)    \
-    case (I_##Kind##_##Structure##_##Arity): { \
+#define EXTEND_CASE(Kind, Structure, Arity)         \
+    CASE_LABEL(I_##Kind##_##Structure##_##Arity) { \
         return [&]() -> RamDomain { \
             [[maybe_unused]] const auto& shadow = *static_cast<const interpreter::Kind*>(node); \
             [[maybe_unused]] const auto& cur = *static_cast<const ram::Kind*>(node->getShadow());\
@@ -415,7 +1117,20 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         high[expr.first] = execute(expr.second.get(), ctxt);            \
     }
 
+#ifdef SOUFFLE_COMPUTED_GOTO
+// Dispatch table in NodeType enum order; enum and table are generated from
+// the same token list, which keeps them aligned.
+#define SINGLE_TOKEN_LABEL(tok) &&lbl_I_##tok,
+#define EXPAND_TOKEN_LABEL(structure, arity, tok) &&lbl_I_##tok##_##structure##_##arity,
+    static void* const dispatchTable[] = {
+            FOR_EACH_INTERPRETER_TOKEN(SINGLE_TOKEN_LABEL, EXPAND_TOKEN_LABEL)};
+#undef SINGLE_TOKEN_LABEL
+#undef EXPAND_TOKEN_LABEL
+    goto* dispatchTable[node->getType()];
+    {
+#else
     switch (node->getType()) {
+#endif
         CASE(NumericConstant)
             return cur.getConstant();
         ESAC(NumericConstant)
@@ -429,6 +1144,11 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(TupleElement)
 
         CASE(AutoIncrement)
+            // under the relaxed mode ids come from per-context blocks,
+            // keeping parallel workers off the shared counter's cache line
+            if (relaxedAutoInc) {
+                return ctxt.nextAutoInc(counter);
+            }
             return incCounter();
         ESAC(AutoIncrement)
 
@@ -484,8 +1204,13 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         auto x = EVAL_CHILD(ty, 0); \
         return ramBitCast(func(x)); \
     }
-#define CONV_TO_STRING(op, ty)                                                             \
-    case FunctorOp::op: return getSymbolTable().encode(std::to_string(EVAL_CHILD(ty, 0)));
+#define CONV_TO_STRING(op, ty)                                                                      \
+    case FunctorOp::op: {                                                                           \
+        const RamDomain arg = execute(shadow.getChild(0), ctxt);                                    \
+        return evaluator::stringFunctorMemo().memoize(                                              \
+                (static_cast<uint32_t>(FunctorOp::op) << 2u) | 1u, arg, 0, 0,                       \
+                [&] { return getSymbolTable().encode(std::to_string(ramBitCast<ty>(arg))); });      \
+    }
 #define CONV_FROM_STRING(op, ty)                              \
     case FunctorOp::op: return evaluator::symbol2numeric<ty>( \
         getSymbolTable().decode(EVAL_CHILD(RamDomain, 0)));
@@ -591,6 +1316,17 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                     // clang-format on
 
                 case FunctorOp::CAT: {
+                    // the binary form dominates and its results recur on a
+                    // small set of argument pairs, so it goes through the memo
+                    if (args.size() == 2) {
+                        const RamDomain left = execute(shadow.getChild(0), ctxt);
+                        const RamDomain right = execute(shadow.getChild(1), ctxt);
+                        return evaluator::stringFunctorMemo().memoize(
+                                (static_cast<uint32_t>(FunctorOp::CAT) << 2u) | 2u, left, right, 0, [&] {
+                                    return getSymbolTable().encode(
+                                            getSymbolTable().decode(left) + getSymbolTable().decode(right));
+                                });
+                    }
                     std::stringstream ss;
                     for (std::size_t i = 0; i < args.size(); i++) {
                         ss << getSymbolTable().decode(execute(shadow.getChild(i), ctxt));
@@ -600,17 +1336,21 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 /** Ternary Functor Operators */
                 case FunctorOp::SUBSTR: {
                     auto symbol = execute(shadow.getChild(0), ctxt);
-                    const std::string& str = getSymbolTable().decode(symbol);
                     auto idx = execute(shadow.getChild(1), ctxt);
                     auto len = execute(shadow.getChild(2), ctxt);
-                    std::string sub_str;
-                    try {
-                        sub_str = str.substr(idx, len);
-                    } catch (...) {
-                        std::cerr << "warning: wrong index position provided by substr(\"";
-                        std::cerr << str << "\"," << (int32_t)idx << "," << (int32_t)len << ") functor.\n";
-                    }
-                    return getSymbolTable().encode(sub_str);
+                    return evaluator::stringFunctorMemo().memoize(
+                            (static_cast<uint32_t>(FunctorOp::SUBSTR) << 2u) | 3u, symbol, idx, len, [&] {
+                                const std::string& str = getSymbolTable().decode(symbol);
+                                std::string sub_str;
+                                try {
+                                    sub_str = str.substr(idx, len);
+                                } catch (...) {
+                                    std::cerr << "warning: wrong index position provided by substr(\"";
+                                    std::cerr << str << "\"," << (int32_t)idx << "," << (int32_t)len
+                                              << ") functor.\n";
+                                }
+                                return getSymbolTable().encode(sub_str);
+                            });
                 }
 
                 case FunctorOp::RANGE:
@@ -641,6 +1381,27 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 execute(shadow.getChild(numArgs), ctxt);
             };
 
+            if (shadow.isIntervalFill()) {
+                // the nested operation is a bare insert into an interval
+                // relation: absorb the whole range as coalesced spans
+                // instead of driving the child chain once per value
+                auto& rel = *static_cast<interpreter::Relation<1, interpreter::Interval>*>(
+                        static_cast<const Insert*>(shadow.getChild(numArgs))->getRelation());
+
+#define FILL_RANGE(ty)                                                                                      \
+    numArgs == 3                                                                                            \
+            ? evaluator::fillRange<ty>(rel, EVAL_CHILD(ty, 0), EVAL_CHILD(ty, 1), EVAL_CHILD(ty, 2))        \
+            : evaluator::fillRange<ty>(rel, EVAL_CHILD(ty, 0), EVAL_CHILD(ty, 1)),                          \
+            true
+
+                switch (cur.getFunction()) {
+                    case ram::NestedIntrinsicOp::RANGE: return FILL_RANGE(RamSigned);
+                    case ram::NestedIntrinsicOp::URANGE: return FILL_RANGE(RamUnsigned);
+                    default: fatal("ICE: `%s` cannot be fused into a span fill", cur.getFunction());
+                }
+#undef FILL_RANGE
+            }
+
 #define RUN_RANGE(ty)                                                                                     \
     numArgs == 3                                                                                          \
             ? evaluator::runRange<ty>(EVAL_CHILD(ty, 0), EVAL_CHILD(ty, 1), EVAL_CHILD(ty, 2), runNested) \
@@ -786,6 +1547,9 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             for (std::size_t i = 0; i < arity; ++i) {
                 data[i] = execute(shadow.getChild(i), ctxt);
             }
+            if (details::isInlineArity(arity) && details::fitsInline(data, arity)) {
+                return details::encodeInline(data, arity);
+            }
             return getRecordTable().pack(data, arity);
         ESAC(PackRecord)
 
@@ -802,7 +1566,47 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(False)
 
         CASE(Conjunction)
-            return execute(shadow.getLhs(), ctxt) && execute(shadow.getRhs(), ctxt);
+            const auto& terms = shadow.getChildren();
+            if (!shadow.isAdaptive()) {
+                for (const auto& term : terms) {
+                    if (!execute(term.get(), ctxt)) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+            // evaluate the terms in the adaptive order, sampling pass rates;
+            // a torn re-sort by another thread may momentarily duplicate
+            // entries in the order, so the terms already evaluated are
+            // tracked and any term missed is evaluated afterwards
+            const std::size_t numTerms = terms.size();
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < numTerms; i++) {
+                const std::size_t term = shadow.getTermOrder(i);
+                const std::uint64_t bit = std::uint64_t(1) << term;
+                if ((seen & bit) != 0) {
+                    continue;
+                }
+                seen |= bit;
+                const bool pass = execute(terms[term].get(), ctxt);
+                shadow.registerOutcome(term, pass);
+                if (!pass) {
+                    shadow.finishEvaluation();
+                    return false;
+                }
+            }
+            for (std::size_t term = 0; term < numTerms; term++) {
+                if ((seen & (std::uint64_t(1) << term)) != 0) {
+                    continue;
+                }
+                if (!execute(terms[term].get(), ctxt)) {
+                    shadow.finishEvaluation();
+                    return false;
+                }
+            }
+            shadow.finishEvaluation();
+            return true;
         ESAC(Conjunction)
 
         CASE(Negation)
@@ -846,9 +1650,8 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         CASE(Constraint)
         // clang-format off
 #define COMPARE_NUMERIC(ty, op) return EVAL_LEFT(ty) op EVAL_RIGHT(ty)
-#define COMPARE_STRING(op)                                        \
-    return (getSymbolTable().decode(EVAL_LEFT(RamDomain)) op \
-            getSymbolTable().decode(EVAL_RIGHT(RamDomain)))
+#define COMPARE_STRING(op)                                                         \
+    return (getSymbolTable().compare(EVAL_LEFT(RamDomain), EVAL_RIGHT(RamDomain)) op 0)
 #define COMPARE_EQ_NE(opCode, op)                                         \
     case BinaryConstraintOp::   opCode: COMPARE_NUMERIC(RamDomain  , op); \
     case BinaryConstraintOp::F##opCode: COMPARE_NUMERIC(RamFloat   , op);
@@ -873,28 +1676,24 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                     RamDomain right = execute(shadow.getRhs(), ctxt);
                     const std::string& pattern = getSymbolTable().decode(left);
                     const std::string& text = getSymbolTable().decode(right);
-                    bool result = false;
-                    try {
-                        result = std::regex_match(text, std::regex(pattern));
-                    } catch (...) {
-                        std::cerr << "warning: wrong pattern provided for match(\"" << pattern << "\",\""
-                                  << text << "\").\n";
+                    if (std::optional<bool> result = cachedMatchPattern(left, pattern).tryMatch(text)) {
+                        return *result;
                     }
-                    return result;
+                    std::cerr << "warning: wrong pattern provided for match(\"" << pattern << "\",\"" << text
+                              << "\").\n";
+                    return false;
                 }
                 case BinaryConstraintOp::NOT_MATCH: {
                     RamDomain left = execute(shadow.getLhs(), ctxt);
                     RamDomain right = execute(shadow.getRhs(), ctxt);
                     const std::string& pattern = getSymbolTable().decode(left);
                     const std::string& text = getSymbolTable().decode(right);
-                    bool result = false;
-                    try {
-                        result = !std::regex_match(text, std::regex(pattern));
-                    } catch (...) {
-                        std::cerr << "warning: wrong pattern provided for !match(\"" << pattern << "\",\""
-                                  << text << "\").\n";
+                    if (std::optional<bool> result = cachedMatchPattern(left, pattern).tryMatch(text)) {
+                        return !*result;
                     }
-                    return result;
+                    std::cerr << "warning: wrong pattern provided for !match(\"" << pattern << "\",\"" << text
+                              << "\").\n";
+                    return false;
                 }
                 case BinaryConstraintOp::CONTAINS: {
                     RamDomain left = execute(shadow.getLhs(), ctxt);
@@ -969,6 +1768,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH(PARALLEL_INDEX_SCAN)
 #undef PARALLEL_INDEX_SCAN
 
+        // written out by hand: the node is interpreter-only and has no ram
+        // counterpart for the case macros to cast the shadow to
+        CASE_LABEL(I_MergeJoin) {
+            return [&]() -> RamDomain {
+                const auto& shadow = *static_cast<const interpreter::MergeJoin*>(node);
+                return evalMergeJoin(shadow, ctxt);
+            }();
+        }
+
 #define IFEXISTS(Structure, Arity, ...)                                 \
     CASE(IfExists, Structure, Arity)                                    \
         const auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
@@ -1014,6 +1822,19 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
             // update environment variable
             std::size_t arity = cur.getArity();
+
+            // decode inline references locally, without a record table lookup
+            if (details::isInlineRef(ref)) {
+                RamDomain data[details::MaxInlineArity];
+                details::decodeInline(ref, arity, data);
+
+                // save reference to temporary value
+                ctxt[cur.getTupleId()] = data;
+
+                // run nested part - using base class visitor
+                return execute(shadow.getNestedOperation(), ctxt);
+            }
+
             const RamDomain* tuple = getRecordTable().unpack(ref, arity);
 
             // save reference to temporary value
@@ -1035,6 +1856,9 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #define AGGREGATE(Structure, Arity, ...)                                                                  \
     CASE(Aggregate, Structure, Arity)                                                                     \
         const auto& rel = *static_cast<RelType*>(shadow.getRelation());                                   \
+        if (shadow.isMemoisable()) {                                                                      \
+            return evalMemoisedAggregate(rel, cur, shadow, ctxt);                                         \
+        }                                                                                                 \
         return evalAggregate(cur, *shadow.getCondition(), shadow.getExpr(), *shadow.getNestedOperation(), \
                 rel.scan(), ctxt);                                                                        \
     ESAC(Aggregate)
@@ -1093,6 +1917,21 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH(GUARDED_INSERT)
 #undef GUARDED_INSERT
 
+// spelled out rather than going through CASE, as the fused node shadows a
+// ram::Filter and the generic preamble would cast it to a ram::CheckedInsert
+#define CHECKED_INSERT(Structure, Arity, ...)                                           \
+    CASE_LABEL(I_CheckedInsert_##Structure##_##Arity) {                                 \
+        return [&]() -> RamDomain {                                                     \
+            const auto& shadow = *static_cast<const interpreter::CheckedInsert*>(node); \
+            using RelType = Relation<Arity, interpreter::Structure>;                    \
+            auto& rel = *static_cast<RelType*>(shadow.getRelation());                   \
+            return evalCheckedInsert<RelType>(rel, shadow, ctxt);                       \
+        }();                                                                            \
+    }
+
+        FOR_EACH(CHECKED_INSERT)
+#undef CHECKED_INSERT
+
 #define INSERT(Structure, Arity, ...)                             \
     CASE(Insert, Structure, Arity)                                \
         auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
@@ -1102,6 +1941,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         FOR_EACH(INSERT)
 #undef INSERT
 
+#define ERASE(Structure, Arity, ...)                              \
+    CASE(Erase, Structure, Arity)                                 \
+        auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        return evalErase(rel, shadow, ctxt);                      \
+    ESAC(Erase)
+
+        FOR_EACH(ERASE)
+#undef ERASE
+
         CASE(SubroutineReturn)
             for (std::size_t i = 0; i < cur.getValues().size(); ++i) {
                 if (shadow.getChild(i) == nullptr) {
@@ -1114,8 +1962,30 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(SubroutineReturn)
 
         CASE(Sequence)
-            for (const auto& child : shadow.getChildren()) {
-                if (!execute(child.get(), ctxt)) {
+            const auto& children = shadow.getChildren();
+            for (std::size_t i = 0; i < children.size(); ++i) {
+                // A run of consecutive loads over distinct relations is handed
+                // to a bounded pool of loader tasks: the loads fill disjoint
+                // relations and the symbol and record tables support
+                // concurrent insertion.
+                if (performIO && ioParallelism > 1 && isLoadStatement(children[i].get())) {
+                    std::size_t end = i;
+                    std::vector<const RelationWrapper*> targets;
+                    while (end < children.size() && isLoadStatement(children[end].get())) {
+                        const auto* rel = static_cast<const IO&>(*children[end]).getRelation();
+                        if (std::find(targets.begin(), targets.end(), rel) != targets.end()) {
+                            break;
+                        }
+                        targets.push_back(rel);
+                        ++end;
+                    }
+                    if (end - i > 1) {
+                        evalConcurrentLoads(children, i, end);
+                        i = end - 1;
+                        continue;
+                    }
+                }
+                if (!execute(children[i].get(), ctxt)) {
                     return false;
                 }
             }
@@ -1123,6 +1993,28 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Sequence)
 
         CASE(Parallel)
+#ifdef _OPENMP
+            if (numOfThreads != 1 && !omp_in_parallel() && shadow.getChildren().size() > 1) {
+                std::atomic<bool> success{true};
+                PARALLEL_START
+#pragma omp single
+                    {
+                        for (const auto& child : shadow.getChildren()) {
+#pragma omp task default(shared)
+                            {
+                                // Statements must not share views or bindings;
+                                // give each task a fresh scope.
+                                Context taskCtxt(ctxt);
+                                if (!execute(child.get(), taskCtxt)) {
+                                    success = false;
+                                }
+                            }
+                        }
+                    }
+                PARALLEL_END
+                return success;
+            }
+#endif
             for (const auto& child : shadow.getChildren()) {
                 if (!execute(child.get(), ctxt)) {
                     return false;
@@ -1133,8 +2025,14 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
         CASE(Loop)
             resetIterationNumber();
+            convergenceMonitor.beginLoop();
             while (execute(shadow.getChild(), ctxt)) {
+                convergenceMonitor.endIteration(getIterationNumber());
                 incIterationNumber();
+                // In goal-directed mode the first goal tuple ends the fixpoint.
+                if (goalHandle != nullptr && (*goalHandle)->size() > 0) {
+                    break;
+                }
             }
             resetIterationNumber();
             return true;
@@ -1145,12 +2043,20 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Exit)
 
         CASE(LogRelationTimer)
+            if (profileSamplingEnabled) {
+                SamplePoint sample(cur.getMessage());
+                return execute(shadow.getChild(), ctxt);
+            }
             Logger logger(cur.getMessage(), getIterationNumber(),
                     std::bind(&RelationWrapper::size, shadow.getRelation()));
             return execute(shadow.getChild(), ctxt);
         ESAC(LogRelationTimer)
 
         CASE(LogTimer)
+            if (profileSamplingEnabled) {
+                SamplePoint sample(cur.getMessage());
+                return execute(shadow.getChild(), ctxt);
+            }
             Logger logger(cur.getMessage(), getIterationNumber());
             return execute(shadow.getChild(), ctxt);
         ESAC(LogTimer)
@@ -1163,6 +2069,7 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 #define CLEAR(Structure, Arity, ...)                              \
     CASE(Clear, Structure, Arity)                                 \
         auto& rel = *static_cast<RelType*>(shadow.getRelation()); \
+        completePendingStores(shadow.getRelation());              \
         rel.__purge();                                            \
         return true;                                              \
     ESAC(Clear)
@@ -1172,6 +2079,15 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
         CASE(Call)
             execute(subroutine[shadow.getSubroutineId()].get(), ctxt);
+            // Strata run exactly once, so their interpreter tree and RAM
+            // subtree can be dropped as soon as the call returns; otherwise
+            // the full IR stays co-resident with the relation data until the
+            // end of the run. Provenance subroutines are invoked again later
+            // and are kept.
+            if (!profileEnabled && isPrefix("stratum_", cur.getName())) {
+                subroutine[shadow.getSubroutineId()].reset();
+                tUnit.getProgram().releaseSubroutine(cur.getName());
+            }
             return true;
         ESAC(Call)
 
@@ -1183,6 +2099,9 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(LogSize)
 
         CASE(IO)
+            if (!performIO) {
+                return true;
+            }
             const auto& directive = cur.getDirectives();
             const std::string& op = cur.get("operation");
             auto& rel = *shadow.getRelation();
@@ -1190,13 +2109,31 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             if (op == "input") {
                 try {
                     IOSystem::getInstance()
-                            .getReader(directive, getSymbolTable(), getRecordTable())
+                            .getReader(inputDirectives(cur), getSymbolTable(), getRecordTable())
                             ->readAll(rel);
                 } catch (std::exception& e) {
                     std::cerr << "Error loading data: " << e.what() << "\n";
                 }
                 return true;
             } else if (op == "output" || op == "printsize") {
+                // the results of a calibration run are computed from sampled
+                // inputs and not meaningful; only the profile is kept
+                if (!inputSample.empty()) {
+                    return true;
+                }
+                // A relation is final once the stratum storing it has completed,
+                // so file stores can run in the background, overlapped with the
+                // evaluation of the remaining strata. Stores targeting shared
+                // streams such as stdout remain synchronous to keep their order.
+                if (op == "output" && directive.count("IO") != 0 && directive.at("IO") == "file") {
+                    pendingStores[&rel].push_back(
+                            std::async(std::launch::async, [this, directive, &rel] {
+                                IOSystem::getInstance()
+                                        .getWriter(directive, getSymbolTable(), getRecordTable())
+                                        ->writeAll(rel);
+                            }));
+                    return true;
+                }
                 try {
                     IOSystem::getInstance()
                             .getWriter(directive, getSymbolTable(), getRecordTable())
@@ -1246,7 +2183,14 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                     ctxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
                 }
             }
-            execute(shadow.getChild(), ctxt);
+            if (hotQueriesEnabled) {
+                const auto start = std::chrono::steady_clock::now();
+                execute(shadow.getChild(), ctxt);
+                queryTimes[&cur] += std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() - start);
+            } else {
+                execute(shadow.getChild(), ctxt);
+            }
             return true;
         ESAC(Query)
 
@@ -1258,8 +2202,20 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
             return true;
         ESAC(Extend)
 
+        CASE(Merge)
+            auto& src = *getRelationHandle(shadow.getSourceId());
+            auto& trg = *getRelationHandle(shadow.getTargetId());
+            trg.insert(src);
+            return true;
+        ESAC(Merge)
+
         CASE(Swap)
             swapRelation(shadow.getSourceId(), shadow.getTargetId());
+            // after the swap the delta relation holds exactly the tuples
+            // produced by this iteration
+            if (convergenceMonitor.enabled()) {
+                convergenceMonitor.addDelta(getRelationHandle(shadow.getSourceId())->size());
+            }
             return true;
         ESAC(Swap)
     }
@@ -1268,6 +2224,10 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
 #undef EVAL_CHILD
 #undef DEBUG
+#undef CASE_LABEL
+#ifdef SOUFFLE_COMPUTED_GOTO
+#undef SOUFFLE_COMPUTED_GOTO
+#endif
 }
 
 template <typename Rel>
@@ -1321,43 +2281,35 @@ RamDomain Engine::evalProvenanceExistenceCheck(const ProvenanceExistenceCheck& s
     constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
 
-    // for partial we search for lower and upper boundaries
+    // only the payload attributes take part in the lookup; the auxiliary
+    // columns are ignored by the weak comparator of the provenance index
     souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
     TUPLE_COPY_FROM(low, superInfo.first);
-    TUPLE_COPY_FROM(high, superInfo.second);
 
     /* TupleElement */
     for (const auto& tupleElement : superInfo.tupleFirst) {
         low[tupleElement[0]] = ctxt[tupleElement[1]][tupleElement[2]];
-        high[tupleElement[0]] = low[tupleElement[0]];
     }
     /* Generic */
     for (const auto& expr : superInfo.exprFirst) {
         assert(expr.second.get() != nullptr &&
                 "ProvenanceExistenceCheck should always be specified for payload");
         low[expr.first] = execute(expr.second.get(), ctxt);
-        high[expr.first] = low[expr.first];
     }
 
-    low[Arity - 2] = MIN_RAM_SIGNED;
-    low[Arity - 1] = MIN_RAM_SIGNED;
-    high[Arity - 2] = MAX_RAM_SIGNED;
-    high[Arity - 1] = MAX_RAM_SIGNED;
-
     // obtain view
     std::size_t viewPos = shadow.getViewId();
 
-    // get an equalRange
-    auto equalRange = Rel::castView(ctxt.getView(viewPos))->range(low, high);
-
-    // if range is empty
-    if (equalRange.begin() == equalRange.end()) {
+    // a provenance index holds at most one tuple per payload, so a single
+    // weak-comparator descent replaces the former range query with open
+    // bounds on the auxiliary columns
+    const auto* match = Rel::castView(ctxt.getView(viewPos))->weakFind(low);
+    if (match == nullptr) {
         return false;
     }
 
     // check whether the height is less than the current height
-    return (*equalRange.begin())[Arity - 1] <= execute(shadow.getChild(), ctxt);
+    return (*match)[Arity - 1] <= execute(shadow.getChild(), ctxt);
 }
 
 template <typename Rel>
@@ -1376,23 +2328,48 @@ RamDomain Engine::evalParallelScan(
         const Rel& rel, const ram::ParallelScan& cur, const ParallelScan& shadow, Context& ctxt) {
     auto viewContext = shadow.getViewContext();
 
-    auto pStream = rel.partitionScan(numOfThreads);
+    // A small source relation does not amortise the cost of fanning out a
+    // team; decide serial vs parallel here at runtime rather than at
+    // translation time, where the cardinality is unknown.
+    if (rel.size() < parallelThreshold) {
+        Context newCtxt(ctxt);
+        auto viewInfo = viewContext->getViewInfoForNested();
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        for (const auto& tuple : rel.scan()) {
+            newCtxt[cur.getTupleId()] = tuple.data();
+            if (!execute(shadow.getNestedOperation(), newCtxt)) {
+                break;
+            }
+        }
+        return true;
+    }
+
+    const auto& grain = shadow.getScanGrain();
+    auto pStream = rel.partitionScan(grain.partitions(numOfThreads, scanChunkFactor));
+    AffinitySchedule schedule(pStream.size());
 
+    const auto start = now();
     PARALLEL_START
         Context newCtxt(ctxt);
+        newCtxt.enableInsertBuffering();
         auto viewInfo = viewContext->getViewInfoForNested();
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-            for (const auto& tuple : *it) {
+        for (std::size_t part = schedule.fetch(); part != AffinitySchedule::npos;
+                part = schedule.fetch()) {
+            for (const auto& tuple : pStream[part]) {
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (!execute(shadow.getNestedOperation(), newCtxt)) {
                     break;
                 }
             }
         }
+        newCtxt.flushInsertBuffers();
     PARALLEL_END
+    grain.record(numOfThreads, duration_in_us(start, now()));
     return true;
 }
 
@@ -1407,6 +2384,51 @@ RamDomain Engine::evalIndexScan(const ram::IndexScan& cur, const IndexScan& shad
 
     std::size_t viewId = shadow.getViewId();
     auto view = Rel::castView(ctxt.getView(viewId));
+#ifdef _OPENMP
+    // Inside a parallel region, a large range is handed out in morsels as
+    // tasks, so threads starved by a low-cardinality outer loop can take
+    // over slices of the inner join instead of idling at its barrier.
+    if constexpr (Arity > 0) {
+        if (omp_in_parallel() && shadow.getViewContext() != nullptr) {
+            auto range = view->range(low, high);
+            const auto rangeEnd = range.end();
+            auto carve = [&](auto it) {
+                for (std::size_t i = 0; i < morselSize && it != rangeEnd; ++i) {
+                    ++it;
+                }
+                return it;
+            };
+
+            const auto firstEnd = carve(range.begin());
+            if (firstEnd != rangeEnd) {
+#pragma omp taskgroup
+                {
+                    for (auto morsel = range.begin(); morsel != rangeEnd;) {
+                        auto morselEnd = (morsel == range.begin()) ? firstEnd : carve(morsel);
+#pragma omp task default(shared) firstprivate(morsel, morselEnd)
+                        {
+                            Context taskCtxt = Context::forkForTask(ctxt);
+                            taskCtxt.enableInsertBuffering();
+                            auto viewInfo = shadow.getViewContext()->getViewInfoForNested();
+                            for (const auto& info : viewInfo) {
+                                taskCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+                            }
+                            for (auto it = morsel; it != morselEnd; ++it) {
+                                taskCtxt[cur.getTupleId()] = (*it).data();
+                                if (!execute(shadow.getNestedOperation(), taskCtxt)) {
+                                    break;
+                                }
+                            }
+                            taskCtxt.flushInsertBuffers();
+                        }
+                        morsel = morselEnd;
+                    }
+                }
+                return true;
+            }
+        }
+    }
+#endif
     // conduct range query
     for (const auto& tuple : view->range(low, high)) {
         ctxt[cur.getTupleId()] = tuple.data();
@@ -1430,22 +2452,231 @@ RamDomain Engine::evalParallelIndexScan(
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t indexPos = shadow.getViewId();
-    auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads);
-    PARALLEL_START
+
+    // Runtime serial fallback for small source relations, as in evalParallelScan.
+    if (rel.size() < parallelThreshold) {
         Context newCtxt(ctxt);
         auto viewInfo = viewContext->getViewInfoForNested();
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+        auto stream = rel.partitionRange(indexPos, low, high, 1);
+        for (auto it = stream.begin(); it < stream.end(); ++it) {
             for (const auto& tuple : *it) {
+                newCtxt[cur.getTupleId()] = tuple.data();
+                if (!execute(shadow.getNestedOperation(), newCtxt)) {
+                    return true;
+                }
+            }
+        }
+        return true;
+    }
+
+    const auto& grain = shadow.getScanGrain();
+    auto pStream = rel.partitionRange(indexPos, low, high, grain.partitions(numOfThreads, scanChunkFactor));
+    AffinitySchedule schedule(pStream.size());
+    const auto start = now();
+    PARALLEL_START
+        Context newCtxt(ctxt);
+        newCtxt.enableInsertBuffering();
+        auto viewInfo = viewContext->getViewInfoForNested();
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        for (std::size_t part = schedule.fetch(); part != AffinitySchedule::npos;
+                part = schedule.fetch()) {
+            for (const auto& tuple : pStream[part]) {
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (!execute(shadow.getNestedOperation(), newCtxt)) {
                     break;
                 }
             }
         }
+        newCtxt.flushInsertBuffers();
     PARALLEL_END
+    grain.record(numOfThreads, duration_in_us(start, now()));
+    return true;
+}
+
+RamDomain Engine::evalMergeJoin(const MergeJoin& shadow, Context& ctxt) {
+    const RelationWrapper& outerRel = *shadow.getOuterRelation();
+    const RelationWrapper& innerRel = *shadow.getInnerRelation();
+    if (outerRel.size() == 0 || innerRel.size() == 0) {
+        return true;
+    }
+
+    const auto& outerKey = shadow.getOuterKey();
+    const auto& innerKey = shadow.getInnerKey();
+
+    // when the outer main index and the index selected for the inner scan
+    // both sort by the join key in the same sequence, the two indexes are
+    // walked in lockstep and nothing is materialised or sorted; the index
+    // orders are only fixed once the relations exist, so the alignment is
+    // checked here rather than at generation time
+    if (shadow.getInnerIndexPos() != MergeJoin::NoSortedIndex) {
+        const Order outerOrder = outerRel.getIndexOrder(0);
+        const Order innerOrder = innerRel.getIndexOrder(shadow.getInnerIndexPos());
+        const std::size_t keyArity = outerKey.size();
+        // aligned iff for every prefix slot k the outer order sorts by some
+        // key column outerKey[m] and the inner order by its partner innerKey[m]
+        bool aligned = true;
+        for (std::size_t k = 0; k < keyArity && aligned; ++k) {
+            std::size_t m = 0;
+            while (m < keyArity && outerKey[m] != outerOrder[k]) {
+                ++m;
+            }
+            aligned = m < keyArity && innerOrder[k] == innerKey[m];
+        }
+        if (aligned) {
+            const std::size_t innerArity = innerRel.getArity();
+            auto outerIt = outerRel.begin();
+            const auto outerEnd = outerRel.end();
+            auto innerIt = innerRel.begin(shadow.getInnerIndexPos());
+            const auto innerEnd = innerRel.end(shadow.getInnerIndexPos());
+            std::vector<RamDomain> key(keyArity);
+            std::vector<RamDomain> innerGroup;
+            while (outerIt != outerEnd && innerIt != innerEnd) {
+                const RamDomain* outer = *outerIt;
+                const RamDomain* inner = *innerIt;
+                int cmp = 0;
+                for (std::size_t k = 0; k < keyArity && cmp == 0; ++k) {
+                    const RamDomain a = outer[outerOrder[k]];
+                    const RamDomain b = inner[innerOrder[k]];
+                    cmp = (a < b) ? -1 : ((a > b) ? 1 : 0);
+                }
+                if (cmp < 0) {
+                    ++outerIt;
+                    continue;
+                }
+                if (cmp > 0) {
+                    ++innerIt;
+                    continue;
+                }
+                for (std::size_t k = 0; k < keyArity; ++k) {
+                    key[k] = outer[outerOrder[k]];
+                }
+                // buffer the inner group of this key once, then pair it with
+                // every outer tuple of the group
+                innerGroup.clear();
+                for (; innerIt != innerEnd; ++innerIt) {
+                    const RamDomain* tuple = *innerIt;
+                    bool same = true;
+                    for (std::size_t k = 0; k < keyArity && same; ++k) {
+                        same = tuple[innerOrder[k]] == key[k];
+                    }
+                    if (!same) {
+                        break;
+                    }
+                    innerGroup.insert(innerGroup.end(), tuple, tuple + innerArity);
+                }
+                for (; outerIt != outerEnd; ++outerIt) {
+                    const RamDomain* tuple = *outerIt;
+                    bool same = true;
+                    for (std::size_t k = 0; k < keyArity && same; ++k) {
+                        same = tuple[outerOrder[k]] == key[k];
+                    }
+                    if (!same) {
+                        break;
+                    }
+                    ctxt[shadow.getOuterId()] = tuple;
+                    for (std::size_t pos = 0; pos < innerGroup.size(); pos += innerArity) {
+                        ctxt[shadow.getInnerId()] = innerGroup.data() + pos;
+                        if (!execute(shadow.getNestedOperation(), ctxt)) {
+                            return true;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+    }
+
+    // transient hash join: materialise both sides into flat arenas (the
+    // wrapper iterator reuses a single tuple buffer, so the values have to
+    // be copied out), hash the smaller one into an open-addressing table
+    // and probe it with the other; the table lives only for this query
+    auto materialise = [](const RelationWrapper& rel, std::vector<RamDomain>& arena) {
+        const std::size_t arity = rel.getArity();
+        arena.reserve(rel.size() * arity);
+        for (auto it = rel.begin(); it != rel.end(); ++it) {
+            const RamDomain* tuple = *it;
+            arena.insert(arena.end(), tuple, tuple + arity);
+        }
+        std::vector<const RamDomain*> rows;
+        rows.reserve(rel.size());
+        for (std::size_t i = 0; i < rel.size(); ++i) {
+            rows.push_back(arena.data() + i * arity);
+        }
+        return rows;
+    };
+
+    std::vector<RamDomain> outerArena;
+    std::vector<RamDomain> innerArena;
+    auto outerRows = materialise(outerRel, outerArena);
+    auto innerRows = materialise(innerRel, innerArena);
+
+    const bool buildInner = innerRows.size() <= outerRows.size();
+    const auto& buildRows = buildInner ? innerRows : outerRows;
+    const auto& probeRows = buildInner ? outerRows : innerRows;
+    const auto& buildKey = buildInner ? innerKey : outerKey;
+    const auto& probeKey = buildInner ? outerKey : innerKey;
+    const std::size_t buildId = buildInner ? shadow.getInnerId() : shadow.getOuterId();
+    const std::size_t probeId = buildInner ? shadow.getOuterId() : shadow.getInnerId();
+
+    auto hashKey = [](const RamDomain* row, const std::vector<std::size_t>& key) {
+        std::size_t h = 0;
+        for (std::size_t col : key) {
+            h = h * 0x9e3779b97f4a7c15ull + static_cast<std::size_t>(row[col]);
+        }
+        return h;
+    };
+    auto equalKeys = [](const RamDomain* a, const std::vector<std::size_t>& aKey, const RamDomain* b,
+                             const std::vector<std::size_t>& bKey) {
+        for (std::size_t k = 0; k < aKey.size(); ++k) {
+            if (a[aKey[k]] != b[bKey[k]]) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // open-addressing table with linear probing, kept at most half full; a
+    // slot holds the first build row of its key and duplicates chain
+    // through the next vector
+    constexpr std::size_t Empty = std::numeric_limits<std::size_t>::max();
+    std::size_t capacity = 1;
+    while (capacity < buildRows.size() * 2) {
+        capacity <<= 1;
+    }
+    const std::size_t mask = capacity - 1;
+    std::vector<std::size_t> slots(capacity, Empty);
+    std::vector<std::size_t> chain(buildRows.size(), Empty);
+    for (std::size_t row = 0; row < buildRows.size(); ++row) {
+        std::size_t pos = hashKey(buildRows[row], buildKey) & mask;
+        while (slots[pos] != Empty &&
+                !equalKeys(buildRows[slots[pos]], buildKey, buildRows[row], buildKey)) {
+            pos = (pos + 1) & mask;
+        }
+        chain[row] = slots[pos];
+        slots[pos] = row;
+    }
+
+    for (const RamDomain* probe : probeRows) {
+        std::size_t pos = hashKey(probe, probeKey) & mask;
+        while (slots[pos] != Empty && !equalKeys(probe, probeKey, buildRows[slots[pos]], buildKey)) {
+            pos = (pos + 1) & mask;
+        }
+        if (slots[pos] == Empty) {
+            continue;
+        }
+        ctxt[probeId] = probe;
+        for (std::size_t row = slots[pos]; row != Empty; row = chain[row]) {
+            ctxt[buildId] = buildRows[row];
+            if (!execute(shadow.getNestedOperation(), ctxt)) {
+                return true;
+            }
+        }
+    }
     return true;
 }
 
@@ -1467,16 +2698,34 @@ template <typename Rel>
 RamDomain Engine::evalParallelIfExists(
         const Rel& rel, const ram::ParallelIfExists& cur, const ParallelIfExists& shadow, Context& ctxt) {
     auto viewContext = shadow.getViewContext();
-
-    auto pStream = rel.partitionScan(numOfThreads);
     auto viewInfo = viewContext->getViewInfoForNested();
+
+    // Runtime serial fallback for small source relations, as in evalParallelScan.
+    if (rel.size() < parallelThreshold) {
+        Context newCtxt(ctxt);
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        for (const auto& tuple : rel.scan()) {
+            newCtxt[cur.getTupleId()] = tuple.data();
+            if (execute(shadow.getCondition(), newCtxt)) {
+                execute(shadow.getNestedOperation(), newCtxt);
+                break;
+            }
+        }
+        return true;
+    }
+
+    auto pStream = rel.partitionScan(numOfThreads * scanChunkFactor);
+    AffinitySchedule schedule(pStream.size());
     PARALLEL_START
         Context newCtxt(ctxt);
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
-            for (const auto& tuple : *it) {
+        for (std::size_t part = schedule.fetch(); part != AffinitySchedule::npos;
+                part = schedule.fetch()) {
+            for (const auto& tuple : pStream[part]) {
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (execute(shadow.getCondition(), newCtxt)) {
                     execute(shadow.getNestedOperation(), newCtxt);
@@ -1525,15 +2774,37 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t indexPos = shadow.getViewId();
-    auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads);
 
-    PARALLEL_START
+    // Runtime serial fallback for small source relations, as in evalParallelScan.
+    if (rel.size() < parallelThreshold) {
         Context newCtxt(ctxt);
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
-        pfor(auto it = pStream.begin(); it < pStream.end(); it++) {
+        auto stream = rel.partitionRange(indexPos, low, high, 1);
+        for (auto it = stream.begin(); it < stream.end(); ++it) {
             for (const auto& tuple : *it) {
+                newCtxt[cur.getTupleId()] = tuple.data();
+                if (execute(shadow.getCondition(), newCtxt)) {
+                    execute(shadow.getNestedOperation(), newCtxt);
+                    return true;
+                }
+            }
+        }
+        return true;
+    }
+
+    auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads * scanChunkFactor);
+    AffinitySchedule schedule(pStream.size());
+
+    PARALLEL_START
+        Context newCtxt(ctxt);
+        for (const auto& info : viewInfo) {
+            newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+        }
+        for (std::size_t part = schedule.fetch(); part != AffinitySchedule::npos;
+                part = schedule.fetch()) {
+            for (const auto& tuple : pStream[part]) {
                 newCtxt[cur.getTupleId()] = tuple.data();
                 if (execute(shadow.getCondition(), newCtxt)) {
                     execute(shadow.getNestedOperation(), newCtxt);
@@ -1548,7 +2819,7 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
 
 template <typename Aggregate, typename Iter>
 RamDomain Engine::evalAggregate(const Aggregate& aggregate, const Node& filter, const Node* expression,
-        const Node& nestedOperation, const Iter& ranges, Context& ctxt) {
+        const Node& nestedOperation, const Iter& ranges, Context& ctxt, Context::AggregateMemo* memo) {
     bool shouldRunNested = false;
 
     // initialize result
@@ -1557,6 +2828,9 @@ RamDomain Engine::evalAggregate(const Aggregate& aggregate, const Node& filter,
     // Use for calculating mean.
     std::pair<RamFloat, RamFloat> accumulateMean;
 
+    // Sketch of the values seen so far, for countd.
+    Own<HyperLogLog> distinct;
+
     switch (aggregate.getFunction()) {
         case AggregateOp::MIN: res = ramBitCast(MAX_RAM_SIGNED); break;
         case AggregateOp::UMIN: res = ramBitCast(MAX_RAM_UNSIGNED); break;
@@ -1588,6 +2862,12 @@ RamDomain Engine::evalAggregate(const Aggregate& aggregate, const Node& filter,
             res = 0;
             shouldRunNested = true;
             break;
+
+        case AggregateOp::COUNTD:
+            res = 0;
+            distinct = mk<HyperLogLog>();
+            shouldRunNested = true;
+            break;
     }
 
     for (const auto& tuple : ranges) {
@@ -1639,6 +2919,10 @@ RamDomain Engine::evalAggregate(const Aggregate& aggregate, const Node& filter,
                 accumulateMean.second++;
                 break;
 
+            case AggregateOp::COUNTD:
+                distinct->insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(val)));
+                break;
+
             case AggregateOp::COUNT: fatal("This should never be executed");
         }
     }
@@ -1647,6 +2931,15 @@ RamDomain Engine::evalAggregate(const Aggregate& aggregate, const Node& filter,
         res = ramBitCast(accumulateMean.first / accumulateMean.second);
     }
 
+    if (aggregate.getFunction() == AggregateOp::COUNTD) {
+        res = ramBitCast(static_cast<RamSigned>(distinct->estimate()));
+    }
+
+    if (memo != nullptr) {
+        memo->result = res;
+        memo->runNested = shouldRunNested;
+    }
+
     // write result to environment
     souffle::Tuple<RamDomain, 1> tuple;
     tuple[0] = res;
@@ -1658,6 +2951,47 @@ RamDomain Engine::evalAggregate(const Aggregate& aggregate, const Node& filter,
         return execute(&nestedOperation, ctxt);
     }
 }
+template <typename Rel>
+RamDomain Engine::evalMemoisedAggregate(
+        const Rel& rel, const ram::Aggregate& cur, const Aggregate& shadow, Context& ctxt) {
+    // Relations only ever grow between purges, so an unchanged object,
+    // version and size guarantee an unchanged aggregate result; recursive
+    // strata then skip re-scanning sources that did not change this
+    // iteration.
+    auto& memo = ctxt.getAggregateMemo(&shadow);
+    if (memo.valid && memo.relation == &rel && memo.version == rel.getVersion() &&
+            memo.size == rel.size()) {
+        souffle::Tuple<RamDomain, 1> tuple;
+        tuple[0] = memo.result;
+        ctxt[cur.getTupleId()] = tuple.data();
+        if (!memo.runNested) {
+            return true;
+        }
+        return execute(shadow.getNestedOperation(), ctxt);
+    }
+
+    memo.relation = &rel;
+    memo.version = rel.getVersion();
+    memo.size = rel.size();
+
+    // an unconditional count over the whole relation is its maintained
+    // cardinality; no scan needed
+    if (cur.getFunction() == AggregateOp::COUNT && isA<ram::True>(&cur.getCondition())) {
+        memo.result = static_cast<RamDomain>(rel.size());
+        memo.runNested = true;
+        memo.valid = true;
+        souffle::Tuple<RamDomain, 1> tuple;
+        tuple[0] = memo.result;
+        ctxt[cur.getTupleId()] = tuple.data();
+        return execute(shadow.getNestedOperation(), ctxt);
+    }
+
+    RamDomain ret = evalAggregate(cur, *shadow.getCondition(), shadow.getExpr(),
+            *shadow.getNestedOperation(), rel.scan(), ctxt, &memo);
+    memo.valid = true;
+    return ret;
+}
+
 template <typename Rel>
 RamDomain Engine::evalParallelAggregate(
         const Rel& rel, const ram::ParallelAggregate& cur, const ParallelAggregate& shadow, Context& ctxt) {
@@ -1673,6 +3007,93 @@ RamDomain Engine::evalParallelAggregate(
             cur, *shadow.getCondition(), shadow.getExpr(), *shadow.getNestedOperation(), rel.scan(), newCtxt);
 }
 
+namespace {
+// whether a view offers the endpoint lookups of comparator-ordered indexes
+template <typename View, typename Tuple, typename = void>
+struct has_endpoint_lookup : std::false_type {};
+
+template <typename View, typename Tuple>
+struct has_endpoint_lookup<View, Tuple,
+        std::void_t<decltype(std::declval<View&>().minIn(
+                std::declval<const Tuple&>(), std::declval<const Tuple&>()))>> : std::true_type {};
+}  // namespace
+
+template <typename Rel>
+bool Engine::tryEndpointAggregate(const ram::IndexAggregate& cur, const IndexAggregate& shadow,
+        typename Rel::View& view, const souffle::Tuple<RamDomain, Rel::Arity>& low,
+        const souffle::Tuple<RamDomain, Rel::Arity>& high, Context& ctxt, RamDomain& result) {
+    using Tuple = souffle::Tuple<RamDomain, Rel::Arity>;
+    if constexpr (!has_endpoint_lookup<typename Rel::View, Tuple>::value) {
+        return false;
+    } else {
+        const AggregateOp fn = cur.getFunction();
+        if (fn != AggregateOp::MIN && fn != AggregateOp::MAX && fn != AggregateOp::COUNT) {
+            return false;
+        }
+        if (!isA<ram::True>(&cur.getCondition())) {
+            return false;
+        }
+
+        // an unconditional count is served by the node-wise range count:
+        // two descents plus one step per touched node
+        if (fn == AggregateOp::COUNT) {
+            souffle::Tuple<RamDomain, 1> res;
+            res[0] = static_cast<RamDomain>(view.countIn(low, high));
+            ctxt[cur.getTupleId()] = res.data();
+            // a count always executes the nested operation, matching the
+            // generic evaluation
+            result = execute(shadow.getNestedOperation(), ctxt);
+            return true;
+        }
+
+        // only signed extrema over an unconditional body follow the index's
+        // comparator order; the aggregated value must be an attribute of
+        // the scanned tuple ...
+        const Node* exprNode = shadow.getExpr();
+        if (exprNode == nullptr || exprNode->getType() != I_TupleElement) {
+            return false;
+        }
+        const auto& expr = *static_cast<const TupleElement*>(exprNode);
+        if (expr.getTupleId() != cur.getTupleId()) {
+            return false;
+        }
+        // ... every bound column must be a point bound ...
+        std::size_t bound = 0;
+        const auto& pattern = cur.getRangePattern();
+        for (std::size_t i = 0; i < pattern.first.size(); ++i) {
+            const ram::Expression* l = pattern.first[i];
+            const ram::Expression* u = pattern.second[i];
+            if (isUndefValue(l) && isUndefValue(u)) {
+                continue;
+            }
+            if (!(*l == *u)) {
+                return false;
+            }
+            ++bound;
+        }
+        // ... and sit directly behind them in the selected lex order, so
+        // the extremum is the first respectively last element of the
+        // scanned range; the element is already mapped into the order's
+        // coordinates by the generator
+        if (expr.getElement() != bound) {
+            return false;
+        }
+
+        const Tuple* tuple = (fn == AggregateOp::MIN) ? view.minIn(low, high) : view.maxIn(low, high);
+        souffle::Tuple<RamDomain, 1> res;
+        if (tuple == nullptr) {
+            res[0] = (fn == AggregateOp::MIN) ? ramBitCast(MAX_RAM_SIGNED) : ramBitCast(MIN_RAM_SIGNED);
+        } else {
+            res[0] = (*tuple)[expr.getElement()];
+        }
+        ctxt[cur.getTupleId()] = res.data();
+        // an empty range leaves the nested operation unexecuted, matching
+        // the generic evaluation
+        result = (tuple == nullptr) ? true : execute(shadow.getNestedOperation(), ctxt);
+        return true;
+    }
+}
+
 template <typename Rel>
 RamDomain Engine::evalParallelIndexAggregate(
         const ram::ParallelIndexAggregate& cur, const ParallelIndexAggregate& shadow, Context& ctxt) {
@@ -1695,6 +3116,10 @@ RamDomain Engine::evalParallelIndexAggregate(
     std::size_t viewId = shadow.getViewId();
     auto view = Rel::castView(newCtxt.getView(viewId));
 
+    RamDomain endpointResult;
+    if (tryEndpointAggregate<Rel>(cur, shadow, *view, low, high, newCtxt, endpointResult)) {
+        return endpointResult;
+    }
     return evalAggregate(cur, *shadow.getCondition(), shadow.getExpr(), *shadow.getNestedOperation(),
             view->range(low, high), newCtxt);
 }
@@ -1712,6 +3137,10 @@ RamDomain Engine::evalIndexAggregate(
     std::size_t viewId = shadow.getViewId();
     auto view = Rel::castView(ctxt.getView(viewId));
 
+    RamDomain endpointResult;
+    if (tryEndpointAggregate<Rel>(cur, shadow, *view, low, high, ctxt, endpointResult)) {
+        return endpointResult;
+    }
     return evalAggregate(cur, *shadow.getCondition(), shadow.getExpr(), *shadow.getNestedOperation(),
             view->range(low, high), ctxt);
 }
@@ -1732,11 +3161,88 @@ RamDomain Engine::evalInsert(Rel& rel, const Insert& shadow, Context& ctxt) {
         tuple[expr.first] = execute(expr.second.get(), ctxt);
     }
 
-    // insert in target relation
+    // insert in target relation; inside a parallel region an unobserved
+    // target is staged thread-locally and bulk-merged at region end
+    if constexpr (Arity > 0) {
+        if (shadow.isBufferable() && ctxt.isInsertBuffering()) {
+            ctxt.bufferInsert(rel, tuple.data());
+            return true;
+        }
+    }
     rel.insert(tuple);
     return true;
 }
 
+template <typename Rel>
+RamDomain Engine::evalCheckedInsert(Rel& rel, const CheckedInsert& shadow, Context& ctxt) {
+    // evaluate the remaining guards before the tuple is materialised
+    if (shadow.getCondition() != nullptr && !execute(shadow.getCondition(), ctxt)) {
+        return true;
+    }
+
+    constexpr std::size_t Arity = Rel::Arity;
+    const auto& superInfo = shadow.getSuperInst();
+    souffle::Tuple<RamDomain, Arity> tuple;
+    TUPLE_COPY_FROM(tuple, superInfo.first);
+
+    /* TupleElement */
+    for (const auto& tupleElement : superInfo.tupleFirst) {
+        tuple[tupleElement[0]] = ctxt[tupleElement[1]][tupleElement[2]];
+    }
+    /* Generic */
+    for (const auto& expr : superInfo.exprFirst) {
+        tuple[expr.first] = execute(expr.second.get(), ctxt);
+    }
+
+    if (profileEnabled && !shadow.isTemp()) {
+        reads[shadow.getCheckRelationName()]++;
+    }
+
+    // probe the check relation through its view, permuting the tuple into
+    // the column order of the view's index; this is the only extra descent,
+    // as the insertion's own descent already rejects duplicates
+    const auto& order = shadow.getProbeOrder();
+    souffle::Tuple<RamDomain, Arity> probe;
+    for (std::size_t i = 0; i < Arity; i++) {
+        probe[i] = tuple[order[i]];
+    }
+    if (Rel::castView(ctxt.getView(shadow.getViewId()))->contains(probe)) {
+        return true;
+    }
+
+    // insert in target relation; inside a parallel region an unobserved
+    // target is staged thread-locally and bulk-merged at region end
+    if constexpr (Arity > 0) {
+        if (shadow.isBufferable() && ctxt.isInsertBuffering()) {
+            ctxt.bufferInsert(rel, tuple.data());
+            return true;
+        }
+    }
+    rel.insert(tuple);
+    return true;
+}
+
+template <typename Rel>
+RamDomain Engine::evalErase(Rel& rel, const Erase& shadow, Context& ctxt) {
+    constexpr std::size_t Arity = Rel::Arity;
+    const auto& superInfo = shadow.getSuperInst();
+    souffle::Tuple<RamDomain, Arity> tuple;
+    TUPLE_COPY_FROM(tuple, superInfo.first);
+
+    /* TupleElement */
+    for (const auto& tupleElement : superInfo.tupleFirst) {
+        tuple[tupleElement[0]] = ctxt[tupleElement[1]][tupleElement[2]];
+    }
+    /* Generic */
+    for (const auto& expr : superInfo.exprFirst) {
+        tuple[expr.first] = execute(expr.second.get(), ctxt);
+    }
+
+    // erase from target relation
+    rel.erase(tuple);
+    return true;
+}
+
 template <typename Rel>
 RamDomain Engine::evalGuardedInsert(Rel& rel, const GuardedInsert& shadow, Context& ctxt) {
     if (!execute(shadow.getCondition(), ctxt)) {
@@ -1757,7 +3263,14 @@ RamDomain Engine::evalGuardedInsert(Rel& rel, const GuardedInsert& shadow, Conte
         tuple[expr.first] = execute(expr.second.get(), ctxt);
     }
 
-    // insert in target relation
+    // insert in target relation; inside a parallel region an unobserved
+    // target is staged thread-locally and bulk-merged at region end
+    if constexpr (Arity > 0) {
+        if (shadow.isBufferable() && ctxt.isInsertBuffering()) {
+            ctxt.bufferInsert(rel, tuple.data());
+            return true;
+        }
+    }
     rel.insert(tuple);
     return true;
 }
@@ -24,15 +24,19 @@
 #include "interpreter/Relation.h"
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Index.h"
+#include "souffle/ConvergenceMonitor.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/utility/ContainerUtil.h"
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <deque>
+#include <future>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #ifdef _OPENMP
@@ -57,13 +61,41 @@ public:
 
     /** @brief Execute the main program */
     void executeMain();
-    /** @brief Execute the subroutine program */
+    /** @brief Enable or disable I/O directives during evaluation
+     *
+     * Server-style embeddings rerun the main program on facts fed through
+     * the interface; disabling I/O keeps a rerun from reloading fact files
+     * and rewriting output files.
+     */
+    void setPerformIO(bool value);
+    /** @brief Execute the subroutine program
+     *
+     * May be invoked concurrently from multiple threads once the main
+     * program has finished: each call evaluates against its own context,
+     * and the relations are only read. */
     void executeSubroutine(
             const std::string& name, const std::vector<RamDomain>& args, std::vector<RamDomain>& ret);
 
 private:
     /** @brief Generate intermediate representation from RAM */
     void generateIR();
+    /** @brief Execute the main program stratum-by-stratum, checkpointing to the snapshot file */
+    void executeWithSnapshots(Context& ctxt);
+    /** @brief Write a binary snapshot of the evaluation state covering the given number of strata */
+    void saveSnapshot(std::size_t completedStrata) const;
+    /** @brief Restore the snapshot file, if any; returns the number of strata it covers */
+    std::size_t restoreSnapshot();
+    /** @brief Execute the main program stratum-by-stratum, spilling cold relations under memory pressure */
+    void executeWithMemoryBudget(Context& ctxt);
+    /** @brief Write the relation to a temporary spill file and release its in-memory storage */
+    void spillRelation(RelationWrapper& rel);
+    /** @brief Reload the relation from its spill file, if it has one, and remove the file */
+    void reloadRelation(RelationWrapper& rel);
+    /** @brief Execute only the strata feeding the goal relation, stopping on its first tuple */
+    void executeGoalDirected(Context& ctxt);
+    /** @brief Execute the main program stratum-by-stratum, compacting each relation once its last
+     * writer has run while later strata still probe it */
+    void executeWithCompaction(Context& ctxt);
     /** @brief Remove a relation from the environment */
     void dropRelation(const std::size_t relId);
     /** @brief Swap the content of two relations */
@@ -96,6 +128,18 @@ private:
     VecOwn<RelationHandle>& getRelationMap();
     /** @brief Create and add relation into the runtime environment.  */
     void createRelation(const ram::Relation& id, const std::size_t idx);
+    /** @brief Wait for pending background stores of the given relation */
+    void completePendingStores(const RelationWrapper* relation);
+    /** @brief Wait for all pending background stores */
+    void completeAllPendingStores();
+    /** @brief Execute the load statements children[begin, end) of a sequence
+     * with a pool of loader tasks bounded by the I/O parallelism */
+    void evalConcurrentLoads(const VecOwn<Node>& children, std::size_t begin, std::size_t end);
+    /** @brief Return the input directives of the given load statement,
+     * amended with the sampling bound of a calibration run */
+    std::map<std::string, std::string> inputDirectives(const ram::IO& io) const;
+    /** @brief Report the queries dominating the run time, if requested */
+    void reportHotQueries() const;
 
     // -- Defines template for specialized interpreter operation -- */
     template <typename Rel>
@@ -118,6 +162,8 @@ private:
     RamDomain evalParallelIndexScan(const Rel& rel, const ram::ParallelIndexScan& cur,
             const ParallelIndexScan& shadow, Context& ctxt);
 
+    RamDomain evalMergeJoin(const MergeJoin& shadow, Context& ctxt);
+
     template <typename Rel>
     RamDomain evalIfExists(const Rel& rel, const ram::IfExists& cur, const IfExists& shadow, Context& ctxt);
 
@@ -134,7 +180,12 @@ private:
 
     template <typename Aggregate, typename Iter>
     RamDomain evalAggregate(const Aggregate& aggregate, const Node& filter, const Node* expression,
-            const Node& nestedOperation, const Iter& ranges, Context& ctxt);
+            const Node& nestedOperation, const Iter& ranges, Context& ctxt,
+            Context::AggregateMemo* memo = nullptr);
+
+    template <typename Rel>
+    RamDomain evalMemoisedAggregate(
+            const Rel& rel, const ram::Aggregate& cur, const Aggregate& shadow, Context& ctxt);
 
     template <typename Rel>
     RamDomain evalParallelAggregate(const Rel& rel, const ram::ParallelAggregate& cur,
@@ -147,27 +198,68 @@ private:
     template <typename Rel>
     RamDomain evalIndexAggregate(const ram::IndexAggregate& cur, const IndexAggregate& shadow, Context& ctxt);
 
+    /** Serve an eligible min/max index aggregate through an endpoint lookup on
+     * the view, or an unconditional count through the node-wise range count;
+     * returns false when the aggregate needs the generic range scan. */
+    template <typename Rel>
+    bool tryEndpointAggregate(const ram::IndexAggregate& cur, const IndexAggregate& shadow,
+            typename Rel::View& view, const souffle::Tuple<RamDomain, Rel::Arity>& low,
+            const souffle::Tuple<RamDomain, Rel::Arity>& high, Context& ctxt, RamDomain& result);
+
     template <typename Rel>
     RamDomain evalGuardedInsert(Rel& rel, const GuardedInsert& shadow, Context& ctxt);
 
+    template <typename Rel>
+    RamDomain evalCheckedInsert(Rel& rel, const CheckedInsert& shadow, Context& ctxt);
+
     template <typename Rel>
     RamDomain evalInsert(Rel& rel, const Insert& shadow, Context& ctxt);
 
+    template <typename Rel>
+    RamDomain evalErase(Rel& rel, const Erase& shadow, Context& ctxt);
+
     /** If profile is enable in this program */
     const bool profileEnabled;
     const bool frequencyCounterEnabled;
+    /** If timing scopes are replaced by the low-overhead sampling profiler */
+    const bool profileSamplingEnabled;
     /** If running a provenance program */
     const bool isProvenance;
+    /** If autoinc ids are drawn from per-context blocks instead of the
+     * shared counter; unique but neither dense nor sequential */
+    const bool relaxedAutoInc;
     /** subroutines */
     VecOwn<Node> subroutine;
+    /** subroutine name to index mapping */
+    std::map<std::string, std::size_t> subroutineIndex;
+    /** guard for the one-off IR generation */
+    std::once_flag generateIRFlag;
     /** main program */
     Own<Node> main;
     /** Number of threads enabled for this program */
     std::size_t numOfThreads;
+    /** Minimum source-relation size for a parallel operation to fan out a team */
+    std::size_t parallelThreshold = 1024;
+    /** Maximum number of input relations loaded concurrently */
+    std::size_t ioParallelism = 1;
+    /** Whether I/O directives are performed during evaluation */
+    bool performIO = true;
+    /** Input sampling bound of a calibration run; empty outside calibration */
+    std::string inputSample;
+    /** Bound on resident relation storage in bytes; 0 disables spilling */
+    std::size_t memoryBudget = 0;
+    /** Spill files of the currently spilled-out relations, keyed by relation name */
+    std::map<std::string, std::string> spillFiles;
+    /** Name of the goal relation for goal-directed evaluation; empty when disabled */
+    std::string goalRelationName;
+    /** Handle of the goal relation; non-null only during goal-directed evaluation */
+    RelationHandle* goalHandle = nullptr;
     /** Profile counter */
     std::atomic<RamDomain> counter{0};
     /** Loop iteration counter */
     std::size_t iteration = 0;
+    /** Watches fixpoint delta cardinalities for divergence */
+    ConvergenceMonitor convergenceMonitor;
     /** Profile for rule frequencies */
     std::map<std::string, std::deque<std::atomic<std::size_t>>> frequencies;
     /** Profile for relation reads */
@@ -184,6 +276,12 @@ private:
     VecOwn<RelationHandle> relations;
     /** Symbol table */
     SymbolTable symbolTable;
+    /** File stores running in the background, overlapped with later strata */
+    std::map<const RelationWrapper*, std::vector<std::future<void>>> pendingStores;
+    /** If the hot-query report is enabled for this program */
+    const bool hotQueriesEnabled;
+    /** Cumulative evaluation time per query, feeding the hot-query report */
+    std::map<const ram::Node*, std::chrono::microseconds> queryTimes;
 };
 
 }  // namespace souffle::interpreter
@@ -95,7 +95,8 @@ NodePtr NodeGenerator::visit_(
         children.push_back(dispatch(*arg));
     }
     children.push_back(visit_(type_identity<ram::TupleOperation>(), op));
-    return mk<NestedIntrinsicOperator>(I_NestedIntrinsicOperator, &op, std::move(children));
+    return mk<NestedIntrinsicOperator>(
+            I_NestedIntrinsicOperator, &op, std::move(children), isIntervalFill(op));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::PackRecord>, const ram::PackRecord& pr) {
@@ -120,7 +121,21 @@ NodePtr NodeGenerator::visit_(type_identity<ram::False>, const ram::False& lfals
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Conjunction>, const ram::Conjunction& conj) {
-    return mk<Conjunction>(I_Conjunction, &conj, dispatch(conj.getLHS()), dispatch(conj.getRHS()));
+    // flatten the conjunction chain into a single n-ary node so that the
+    // evaluation order of the terms can adapt to their observed pass rates
+    NodePtrVec terms;
+    std::vector<const ram::Condition*> worklist = {&conj};
+    while (!worklist.empty()) {
+        const auto* condition = worklist.back();
+        worklist.pop_back();
+        if (const auto* inner = as<ram::Conjunction>(condition)) {
+            worklist.push_back(&inner->getRHS());
+            worklist.push_back(&inner->getLHS());
+        } else {
+            terms.push_back(dispatch(*condition));
+        }
+    }
+    return mk<Conjunction>(I_Conjunction, &conj, std::move(terms));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Negation>, const ram::Negation& neg) {
@@ -201,8 +216,12 @@ NodePtr NodeGenerator::visit_(type_identity<ram::IndexScan>, const ram::IndexSca
     orderingContext.addTupleWithIndexOrder(iScan.getTupleId(), iScan);
     SuperInstruction indexOperation = getIndexSuperInstInfo(iScan);
     NodeType type = constructNodeType("IndexScan", lookup(iScan.getRelation()));
-    return mk<IndexScan>(type, &iScan, nullptr, visit_(type_identity<ram::TupleOperation>(), iScan),
+    auto res = mk<IndexScan>(type, &iScan, nullptr, visit_(type_identity<ram::TupleOperation>(), iScan),
             encodeView(&iScan), std::move(indexOperation));
+    // the view context lets the engine split a large range into morsel
+    // tasks when the scan runs nested inside a parallel loop
+    res->setViewContext(parentQueryViewContext);
+    return res;
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::ParallelIndexScan>, const ram::ParallelIndexScan& piscan) {
@@ -278,7 +297,8 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Aggregate>, const ram::Aggregat
     std::size_t relId = encodeRelation(aggregate.getRelation());
     auto rel = getRelationHandle(relId);
     NodeType type = constructNodeType("Aggregate", lookup(aggregate.getRelation()));
-    return mk<Aggregate>(type, &aggregate, rel, std::move(expr), std::move(cond), std::move(nested));
+    return mk<Aggregate>(type, &aggregate, rel, std::move(expr), std::move(cond), std::move(nested),
+            isMemoisableAggregate(aggregate));
 }
 
 NodePtr NodeGenerator::visit_(
@@ -334,6 +354,28 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Break>, const ram::Break& break
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Filter>, const ram::Filter& filter) {
+    // Fuse the ubiquitous Filter -> Insert tail of rule bodies into a single
+    // guarded insert, saving one dispatch and context hand-over per tuple.
+    // Fusion is skipped when the filter carries frequency-profiling text, as
+    // the generic filter case maintains the frequency counters.
+    if (const auto* insert = as<ram::Insert>(filter.getOperation())) {
+        const bool countsFrequency = engine.profileEnabled && engine.frequencyCounterEnabled &&
+                                     !filter.getProfileText().empty();
+        if (!isA<ram::GuardedInsert>(insert) && !countsFrequency) {
+            // Further specialise when one of the conjuncts is a negated total
+            // existence check over exactly the inserted values, so the probe
+            // and the insertion share a single materialised tuple.
+            if (NodePtr fused = tryFuseCheckedInsert(filter, *insert)) {
+                return fused;
+            }
+            SuperInstruction superOp = getInsertSuperInstInfo(*insert);
+            std::size_t relId = encodeRelation(insert->getRelation());
+            auto rel = getRelationHandle(relId);
+            NodeType type = constructNodeType("GuardedInsert", lookup(insert->getRelation()));
+            return mk<GuardedInsert>(type, &filter, rel, std::move(superOp), dispatch(filter.getCondition()),
+                    contains(bufferableTargets, insert->getRelation()));
+        }
+    }
     return mk<Filter>(I_Filter, &filter, dispatch(filter.getCondition()), dispatch(filter.getOperation()));
 }
 
@@ -343,7 +385,87 @@ NodePtr NodeGenerator::visit_(type_identity<ram::GuardedInsert>, const ram::Guar
     auto rel = getRelationHandle(relId);
     NodeType type = constructNodeType("GuardedInsert", lookup(guardedInsert.getRelation()));
     auto condition = guardedInsert.getCondition();
-    return mk<GuardedInsert>(type, &guardedInsert, rel, std::move(superOp), dispatch(*condition));
+    return mk<GuardedInsert>(type, &guardedInsert, rel, std::move(superOp), dispatch(*condition),
+            contains(bufferableTargets, guardedInsert.getRelation()));
+}
+
+NodePtr NodeGenerator::tryFuseCheckedInsert(const ram::Filter& filter, const ram::Insert& insert) {
+    // provenance relations probe through their own existence check node
+    if (Global::config().has("provenance")) {
+        return nullptr;
+    }
+
+    // find a negated total existence check over exactly the inserted values;
+    // the clause translator emits one against the full relation for the head
+    // of every recursive rule
+    const auto conditions = findConjunctiveTerms(&filter.getCondition());
+    const auto insertValues = insert.getValues();
+    const ram::ExistenceCheck* probe = nullptr;
+    std::size_t probePos = 0;
+    for (std::size_t i = 0; i < conditions.size() && probe == nullptr; i++) {
+        const auto* negation = as<ram::Negation>(conditions[i]);
+        if (negation == nullptr) {
+            continue;
+        }
+        const auto* exists = as<ram::ExistenceCheck>(&negation->getOperand());
+        if (exists == nullptr) {
+            continue;
+        }
+        const auto checkValues = exists->getValues();
+        if (checkValues.size() != insertValues.size()) {
+            continue;
+        }
+        bool matches = true;
+        for (std::size_t j = 0; j < checkValues.size(); j++) {
+            if (isUndefValue(checkValues[j]) || !(*checkValues[j] == *insertValues[j])) {
+                matches = false;
+                break;
+            }
+        }
+        // the probe and the insertion must agree on the tuple layout, so the
+        // check relation must map to the same specialised node family
+        if (matches && constructNodeType("Insert", lookup(exists->getRelation())) ==
+                               constructNodeType("Insert", lookup(insert.getRelation()))) {
+            probe = exists;
+            probePos = i;
+        }
+    }
+    if (probe == nullptr) {
+        return nullptr;
+    }
+
+    // the remaining conjuncts guard the fused operation; they are evaluated
+    // before the probe, which only changes the order of pure conditions
+    NodePtrVec rest;
+    for (std::size_t i = 0; i < conditions.size(); i++) {
+        if (i != probePos) {
+            rest.push_back(dispatch(*conditions[i]));
+        }
+    }
+    Own<Node> guard;
+    if (rest.size() == 1) {
+        guard = std::move(rest[0]);
+    } else if (!rest.empty()) {
+        guard = mk<Conjunction>(I_Conjunction, &filter.getCondition(), std::move(rest));
+    }
+
+    // the view probes through an index, whose column order the materialised
+    // tuple is permuted into at evaluation time
+    std::size_t interpreterRel = encodeRelation(probe->getRelation());
+    std::size_t indexId = encodeIndexPos(*probe);
+    auto order = (*getRelationHandle(interpreterRel))->getIndexOrder(indexId);
+    std::vector<std::size_t> probeOrder;
+    for (std::size_t i = 0; i < getArity(probe->getRelation()); i++) {
+        probeOrder.push_back(order[i]);
+    }
+
+    SuperInstruction superOp = getInsertSuperInstInfo(insert);
+    auto rel = getRelationHandle(encodeRelation(insert.getRelation()));
+    const auto& checkRelation = lookup(probe->getRelation());
+    NodeType type = constructNodeType("CheckedInsert", lookup(insert.getRelation()));
+    return mk<CheckedInsert>(type, &filter, rel, std::move(superOp), std::move(guard), encodeView(probe),
+            std::move(probeOrder), checkRelation.isTemp(), checkRelation.getName(),
+            contains(bufferableTargets, insert.getRelation()));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Insert>, const ram::Insert& insert) {
@@ -351,7 +473,16 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Insert>, const ram::Insert& ins
     std::size_t relId = encodeRelation(insert.getRelation());
     auto rel = getRelationHandle(relId);
     NodeType type = constructNodeType("Insert", lookup(insert.getRelation()));
-    return mk<Insert>(type, &insert, rel, std::move(superOp));
+    return mk<Insert>(
+            type, &insert, rel, std::move(superOp), contains(bufferableTargets, insert.getRelation()));
+}
+
+NodePtr NodeGenerator::visit_(type_identity<ram::Erase>, const ram::Erase& erase) {
+    SuperInstruction superOp = getEraseSuperInstInfo(erase);
+    std::size_t relId = encodeRelation(erase.getRelation());
+    auto rel = getRelationHandle(relId);
+    NodeType type = constructNodeType("Erase", lookup(erase.getRelation()));
+    return mk<Erase>(type, &erase, rel, std::move(superOp));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::SubroutineReturn>, const ram::SubroutineReturn& ret) {
@@ -431,7 +562,135 @@ NodePtr NodeGenerator::visit_(type_identity<ram::IO>, const ram::IO& io) {
     return mk<IO>(I_IO, &io, rel);
 }
 
+NodePtr NodeGenerator::tryMergeJoin(const ram::Query& query) {
+    // the fused node maintains neither frequency counters nor the auxiliary
+    // provenance columns, so both modes take the generic path
+    if (engine.profileEnabled || engine.isProvenance) {
+        return nullptr;
+    }
+
+    // outer loop: a full serial scan
+    const auto* scan = as<ram::Scan>(query.getOperation());
+    if (scan == nullptr || isA<ram::ParallelScan>(scan)) {
+        return nullptr;
+    }
+
+    // inner loop: a serial index scan whose bound columns are all
+    // point-bound to elements of the outer tuple
+    const auto* iScan = as<ram::IndexScan>(scan->getOperation());
+    if (iScan == nullptr || isA<ram::ParallelIndexScan>(iScan)) {
+        return nullptr;
+    }
+    std::vector<std::size_t> outerKey;
+    std::vector<std::size_t> innerKey;
+    const auto& pattern = iScan->getRangePattern();
+    for (std::size_t i = 0; i < pattern.first.size(); ++i) {
+        const ram::Expression* lower = pattern.first[i];
+        const ram::Expression* upper = pattern.second[i];
+        if (isUndefValue(lower) && isUndefValue(upper)) {
+            continue;
+        }
+        const auto* element = as<ram::TupleElement>(lower);
+        if (element == nullptr || !(*lower == *upper) ||
+                element->getTupleId() != scan->getTupleId()) {
+            return nullptr;
+        }
+        innerKey.push_back(i);
+        outerKey.push_back(element->getElement());
+    }
+    if (innerKey.empty()) {
+        return nullptr;
+    }
+
+    // tail: filters down to an insert into a third relation, so the inputs
+    // stay unchanged while the join runs and can be safely materialised
+    const ram::Operation* tail = &iScan->getOperation();
+    while (const auto* filter = as<ram::Filter>(tail)) {
+        tail = &filter->getOperation();
+    }
+    const auto* insert = as<ram::Insert>(tail);
+    if (insert == nullptr || insert->getRelation() == scan->getRelation() ||
+            insert->getRelation() == iScan->getRelation()) {
+        return nullptr;
+    }
+
+    std::shared_ptr<ViewContext> viewContext = std::make_shared<ViewContext>();
+    parentQueryViewContext = viewContext;
+
+    // both tuples are bound to raw relation tuples by the engine, hence in
+    // the natural column order rather than the order of the skipped index
+    orderingContext.addTupleWithDefaultOrder(scan->getTupleId(), *scan);
+    orderingContext.addTupleWithDefaultOrder(iScan->getTupleId(), *iScan);
+
+    NodePtr nested = dispatch(iScan->getOperation());
+
+    // existence checks in the remaining filters still evaluate through views
+    visit(iScan->getOperation(), [&](const ram::Node& node) {
+        if (requireView(&node)) {
+            const auto& rel = getViewRelation(&node);
+            viewContext->addViewInfoForNested(encodeRelation(rel), indexTable[&node], encodeView(&node));
+        }
+    });
+    viewContext->isParallel = false;
+
+    // when both relations are b-tree backed, their indexes iterate in
+    // lexicographical order and the engine can walk the outer main index and
+    // the index selected for the inner scan in lockstep - provided the two
+    // orders sort by the join key in the same sequence, which only the
+    // engine can check against the selected orders; the other structures
+    // make no iteration-order guarantee and always take the materialising
+    // path (mirrors the structure selection in constructNodeType)
+    auto btreeBacked = [&](const std::string& relName) {
+        const ram::Relation& rel = lookup(relName);
+        return rel.getRepresentation() != RelationRepresentation::EQREL &&
+               rel.getRepresentation() != RelationRepresentation::INTERVAL &&
+               !(rel.getRepresentation() == RelationRepresentation::BRIE && rel.getArity() == 1);
+    };
+    std::size_t innerIndexPos = MergeJoin::NoSortedIndex;
+    if (btreeBacked(scan->getRelation()) && btreeBacked(iScan->getRelation())) {
+        innerIndexPos = encodeIndexPos(*iScan);
+    }
+
+    auto outerHandle = getRelationHandle(encodeRelation(scan->getRelation()));
+    auto innerHandle = getRelationHandle(encodeRelation(iScan->getRelation()));
+    auto res = mk<Query>(I_Query, &query,
+            mk<MergeJoin>(I_MergeJoin, &query, outerHandle, innerHandle, scan->getTupleId(),
+                    iScan->getTupleId(), std::move(outerKey), std::move(innerKey), innerIndexPos,
+                    std::move(nested)));
+    res->setViewContext(parentQueryViewContext);
+    return res;
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query) {
+    // an insert whose target nothing else in the query observes may be
+    // staged in thread-local buffers inside parallel regions; collect the
+    // qualifying targets before the operation tree is generated
+    bufferableTargets.clear();
+    std::set<std::string> observed;
+    visit(query, [&](const ram::Node& node) {
+        if (const auto* insert = as<ram::Insert>(node)) {
+            bufferableTargets.insert(insert->getRelation());
+        } else if (const auto* erase = as<ram::Erase>(node)) {
+            observed.insert(erase->getRelation());
+        } else if (const auto* relOp = as<ram::RelationOperation>(node)) {
+            observed.insert(relOp->getRelation());
+        } else if (const auto* check = as<ram::AbstractExistenceCheck>(node)) {
+            observed.insert(check->getRelation());
+        } else if (const auto* empty = as<ram::EmptinessCheck>(node)) {
+            observed.insert(empty->getRelation());
+        } else if (const auto* size = as<ram::RelationSize>(node)) {
+            observed.insert(size->getRelation());
+        }
+    });
+    for (const auto& relation : observed) {
+        bufferableTargets.erase(relation);
+    }
+
+    // a scan/index-join/filter/insert chain is joined batchwise instead
+    if (NodePtr batched = tryMergeJoin(query)) {
+        return batched;
+    }
+
     std::shared_ptr<ViewContext> viewContext = std::make_shared<ViewContext>();
     parentQueryViewContext = viewContext;
     // split terms of conditions of outer-most filter operation
@@ -484,6 +743,12 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Extend>, const ram::Extend& ext
     return mk<Extend>(I_Extend, &extend, src, target);
 }
 
+NodePtr NodeGenerator::visit_(type_identity<ram::Merge>, const ram::Merge& merge) {
+    std::size_t src = encodeRelation(merge.getSourceRelation());
+    std::size_t target = encodeRelation(merge.getTargetRelation());
+    return mk<Merge>(I_Merge, &merge, src, target);
+}
+
 NodePtr NodeGenerator::visit_(type_identity<ram::Swap>, const ram::Swap& swap) {
     std::size_t src = encodeRelation(swap.getFirstRelation());
     std::size_t target = encodeRelation(swap.getSecondRelation());
@@ -500,7 +765,9 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Node>, const ram::Node& node) {
 
 void NodeGenerator::newQueryBlock() {
     viewTable.clear();
-    viewId = 0;
+    // The view id counter is deliberately not reset: keeping view slots unique
+    // across queries lets evaluation contexts recycle view objects in place
+    // instead of reallocating them on every loop iteration.
 }
 
 std::size_t NodeGenerator::getNewRelId() {
@@ -569,6 +836,60 @@ bool NodeGenerator::requireView(const ram::Node* node) {
     return false;
 }
 
+bool NodeGenerator::isMemoisableAggregate(const ram::Aggregate& aggregate) {
+    // Only a whitelist of node types is admitted: anything that could read
+    // other relations, outer tuples, subroutine arguments or mutable state
+    // invalidates a memoised result without the source relation changing.
+    bool memoisable = true;
+    auto inspect = [&](const ram::Node& root) {
+        visit(root, [&](const ram::Node& node) {
+            if (const auto* element = as<ram::TupleElement>(node)) {
+                if (element->getTupleId() != aggregate.getTupleId()) {
+                    memoisable = false;
+                }
+            } else if (!isA<ram::NumericConstant>(node) && !isA<ram::StringConstant>(node) &&
+                       !isA<ram::UndefValue>(node) && !isA<ram::IntrinsicOperator>(node) &&
+                       !isA<ram::PackRecord>(node) && !isA<ram::True>(node) && !isA<ram::False>(node) &&
+                       !isA<ram::Conjunction>(node) && !isA<ram::Negation>(node) &&
+                       !isA<ram::Constraint>(node)) {
+                memoisable = false;
+            }
+        });
+    };
+    inspect(aggregate.getCondition());
+    inspect(aggregate.getExpression());
+    return memoisable;
+}
+
+bool NodeGenerator::isIntervalFill(const ram::NestedIntrinsicOperator& op) {
+    // profiling counts the frequency of each generated value, which a
+    // fused span insert would no longer report
+    if (engine.profileEnabled) {
+        return false;
+    }
+    // float ranges are not contiguous in the stored tuple order
+    if (op.getFunction() != ram::NestedIntrinsicOp::RANGE &&
+            op.getFunction() != ram::NestedIntrinsicOp::URANGE) {
+        return false;
+    }
+    // the nested operation must be a bare insert of the generated value
+    // into an interval relation
+    const auto* insert = as<ram::Insert>(op.getOperation());
+    if (insert == nullptr || isA<ram::GuardedInsert>(insert)) {
+        return false;
+    }
+    if (lookup(insert->getRelation()).getRepresentation() != RelationRepresentation::INTERVAL) {
+        return false;
+    }
+    const auto& values = insert->getValues();
+    if (values.size() != 1) {
+        return false;
+    }
+    const auto* element = as<ram::TupleElement>(values[0]);
+    return element != nullptr && element->getTupleId() == static_cast<int>(op.getTupleId()) &&
+           element->getElement() == 0;
+}
+
 const std::string& NodeGenerator::getViewRelation(const ram::Node* node) {
     if (const auto* exist = as<ram::AbstractExistenceCheck>(node)) {
         return exist->getRelation();
@@ -723,6 +1044,34 @@ SuperInstruction NodeGenerator::getInsertSuperInstInfo(const ram::Insert& exist)
     return superOp;
 }
 
+SuperInstruction NodeGenerator::getEraseSuperInstInfo(const ram::Erase& erase) {
+    std::size_t arity = getArity(erase.getRelation());
+    SuperInstruction superOp(arity);
+    const auto& children = erase.getValues();
+    for (std::size_t i = 0; i < arity; ++i) {
+        auto& child = children[i];
+        // Constant
+        if (isA<ram::NumericConstant>(child)) {
+            superOp.first[i] = as<ram::NumericConstant>(child)->getConstant();
+            continue;
+        }
+
+        // TupleElement
+        if (isA<ram::TupleElement>(child)) {
+            auto tuple = as<ram::TupleElement>(child);
+            std::size_t tupleId = tuple->getTupleId();
+            std::size_t elementId = tuple->getElement();
+            std::size_t newElementId = orderingContext.mapOrder(tupleId, elementId);
+            superOp.tupleFirst.push_back({i, tupleId, newElementId});
+            continue;
+        }
+
+        // Generic expression
+        superOp.exprFirst.push_back(std::pair<std::size_t, Own<Node>>(i, dispatch(*child)));
+    }
+    return superOp;
+}
+
 // -- Definition of OrderingContext --
 
 NodeGenerator::OrderingContext::OrderingContext(NodeGenerator& generator) : generator(generator) {}
@@ -34,6 +34,7 @@
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
 #include "ram/Expression.h"
@@ -52,6 +53,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -70,6 +72,7 @@
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Query.h"
 #include "ram/Relation.h"
+#include "ram/RelationOperation.h"
 #include "ram/RelationSize.h"
 #include "ram/Scan.h"
 #include "ram/Sequence.h"
@@ -97,6 +100,7 @@
 #include <map>
 #include <memory>
 #include <queue>
+#include <set>
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
@@ -203,6 +207,8 @@ public:
 
     NodePtr visit_(type_identity<ram::Insert>, const ram::Insert& insert) override;
 
+    NodePtr visit_(type_identity<ram::Erase>, const ram::Erase& erase) override;
+
     NodePtr visit_(type_identity<ram::SubroutineReturn>, const ram::SubroutineReturn& ret) override;
 
     NodePtr visit_(type_identity<ram::Sequence>, const ram::Sequence& seq) override;
@@ -231,6 +237,8 @@ public:
 
     NodePtr visit_(type_identity<ram::Extend>, const ram::Extend& extend) override;
 
+    NodePtr visit_(type_identity<ram::Merge>, const ram::Merge& merge) override;
+
     NodePtr visit_(type_identity<ram::Swap>, const ram::Swap& swap) override;
 
     NodePtr visit_(type_identity<ram::UndefValue>, const ram::UndefValue&) override;
@@ -312,6 +320,34 @@ private:
      */
     bool requireView(const ram::Node* node);
 
+    /**
+     * @brief Return true if the result of the aggregate can be reused while
+     * its source relation is unchanged, i.e. condition and expression depend
+     * on nothing but the scanned tuple and are free of side effects.
+     */
+    bool isMemoisableAggregate(const ram::Aggregate& aggregate);
+
+    /**
+     * @brief Return true if the given range generator feeds a bare insert
+     * into an interval relation, so the engine can absorb the whole range
+     * as coalesced spans instead of inserting value by value.
+     */
+    bool isIntervalFill(const ram::NestedIntrinsicOperator& op);
+
+    /**
+     * @brief Generate a batch MergeJoin query if the given query is a serial
+     * scan/index-join/filter/insert chain whose inner index is point-bound
+     * to elements of the outer tuple; returns nullptr otherwise.
+     */
+    NodePtr tryMergeJoin(const ram::Query& query);
+
+    /**
+     * @brief Generate a CheckedInsert if a conjunct of the filter's condition
+     * is a negated total existence check over exactly the inserted values, as
+     * emitted for the head of recursive rules; returns nullptr otherwise.
+     */
+    NodePtr tryFuseCheckedInsert(const ram::Filter& filter, const ram::Insert& insert);
+
     /**
      * @brief Return the associated relation of a operation which requires a view.
      * This function assume the operation does requires a view.
@@ -336,6 +372,11 @@ private:
      */
     SuperInstruction getInsertSuperInstInfo(const ram::Insert& exist);
 
+    /**
+     * @brief Encode and return the super-instruction information about an erase operation
+     */
+    SuperInstruction getEraseSuperInstInfo(const ram::Erase& erase);
+
     /** Environment encoding, store a mapping from ram::Node to its operation index id. */
     std::unordered_map<const ram::Node*, std::size_t> indexTable;
     /** Points to the current viewContext during the generation.
@@ -352,6 +393,10 @@ private:
     std::unordered_map<std::string, std::size_t> relTable;
     /** name / relation mapping */
     std::unordered_map<std::string, const ram::Relation*> relationMap;
+    /** Insert targets of the current query that no other operation of the
+     * query observes; inserts into those may be staged in thread-local
+     * buffers inside parallel regions. */
+    std::set<std::string> bufferableTargets;
     /** ordering context */
     OrderingContext orderingContext = OrderingContext(*this);
     /** Reference to the engine instance */
@@ -22,6 +22,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/StreamUtil.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
@@ -167,15 +168,23 @@ public:
      */
     class View : public ViewWrapper {
         mutable Hints hints;
-        const Data& data;
+        const Data* data;
         Comparator cmp;
 
     public:
-        View(const Data& data) : data(data) {}
+        View(const Data& data) : data(&data) {}
+
+        /** Re-targets this view, dropping the cached hints. Allows a view
+         * object to be recycled across loop iterations instead of being
+         * reconstructed. */
+        void rebind(const Data& newData) {
+            data = &newData;
+            hints = Hints{};
+        }
 
         /** Tests whether the given entry is contained in this index. */
         bool contains(const Tuple& entry) {
-            return data.contains(entry, hints);
+            return data->contains(entry, hints);
         }
 
         /** Tests whether any element in the given range is contained in this index. */
@@ -186,9 +195,68 @@ public:
         /** Obtains a pair of iterators representing the given range within this index. */
         souffle::range<iterator> range(const Tuple& low, const Tuple& high) {
             if (cmp(low, high) > 0) {
-                return {data.end(), data.end()};
+                return {data->end(), data->end()};
             }
-            return {data.lower_bound(low, hints), data.upper_bound(high, hints)};
+            return {data->lower_bound(low, hints), data->upper_bound(high, hints)};
+        }
+
+        /**
+         * Obtains the smallest element of the given range, or nullptr if
+         * the range is empty. Only offered by data structures that iterate
+         * their ranges in comparator order, marked by floor_bound support.
+         */
+        template <typename D = Data>
+        auto minIn(const Tuple& low, const Tuple& high)
+                -> decltype(std::declval<D&>().floor_bound(high, hints), static_cast<const Tuple*>(nullptr)) {
+            auto found = range(low, high);
+            return found.empty() ? nullptr : &*found.begin();
+        }
+
+        /**
+         * Obtains the largest element of the given range through a
+         * logarithmic endpoint lookup, or nullptr if the range is empty.
+         */
+        template <typename D = Data>
+        auto maxIn(const Tuple& low, const Tuple& high)
+                -> decltype(std::declval<D&>().floor_bound(high, hints), static_cast<const Tuple*>(nullptr)) {
+            if (cmp(low, high) > 0) {
+                return static_cast<const Tuple*>(nullptr);
+            }
+            auto it = data->floor_bound(high, hints);
+            if (it == data->end() || cmp(*it, low) < 0) {
+                return static_cast<const Tuple*>(nullptr);
+            }
+            return &*it;
+        }
+
+        /**
+         * Locates the element agreeing with the given tuple on the
+         * attributes observed by the structure's weak comparator, or
+         * nullptr if there is none. A structure deduplicating under a weak
+         * comparator holds at most one such element, so a single descent
+         * replaces a range query with open bounds on the ignored
+         * attributes. Only offered by data structures with a weak_find
+         * operation (i.e. the b-tree backed provenance indices).
+         */
+        template <typename D = Data>
+        auto weakFind(const Tuple& entry)
+                -> decltype(std::declval<D&>().weak_find(entry, hints), static_cast<const Tuple*>(nullptr)) {
+            auto it = data->weak_find(entry, hints);
+            return it == data->end() ? nullptr : &*it;
+        }
+
+        /**
+         * Counts the elements of the given range node-wise instead of
+         * iterating them one by one. Only offered by data structures with
+         * a count_range operation.
+         */
+        template <typename D = Data>
+        auto countIn(const Tuple& low, const Tuple& high)
+                -> decltype(std::declval<D&>().count_range(
+                                    std::declval<iterator>(), std::declval<iterator>()),
+                        std::size_t()) {
+            auto found = range(low, high);
+            return data->count_range(found.begin(), found.end());
         }
     };
 
@@ -200,6 +268,13 @@ public:
         return View(this->data);
     }
 
+    /**
+     * Re-targets an existing view at this index, recycling its allocation.
+     */
+    void refreshView(View& view) const {
+        view.rebind(this->data);
+    }
+
     iterator begin() const {
         return data.begin();
     }
@@ -245,6 +320,35 @@ public:
         }
     }
 
+    /**
+     * Inserts an ordered sequence of raw tuples into this index by
+     * bulk-loading the underlying data structure. Only data structures
+     * providing a sorted bulk insertion are supported; all others leave the
+     * index unchanged and false is returned. The structure itself guards
+     * against a sequence that is not actually ordered for this index.
+     */
+    bool insertSorted(const RamDomain* tuples, std::size_t numTuples) {
+        return insertSorted(data, tuples, numTuples, 0);
+    }
+
+    /**
+     * Inserts every value of the closed span [low,high] into this index.
+     * Only data structures providing a span insert are supported; all
+     * others leave the index unchanged.
+     */
+    bool insertRange(RamDomain low, RamDomain high) {
+        return insertRange(data, low, high, 0);
+    }
+
+    /**
+     * Removes the given tuple from this index, returning whether an element
+     * has actually been removed. Only data structures providing an erase
+     * operation are supported; all others leave the index unchanged.
+     */
+    bool erase(const Tuple& tuple) {
+        return erase(data, order.encode(tuple), 0);
+    }
+
     /**
      * Tests whether the given tuple is present in this index or not.
      */
@@ -310,6 +414,87 @@ public:
     void clear() {
         data.clear();
     }
+
+    /**
+     * Rebuilds the underlying data structure by re-inserting its content in
+     * order. The b-tree splits in-order insertions off-centre, so a rebuilt
+     * index packs its nodes close to capacity and lays them out in
+     * allocation order, reclaiming the slack left by unordered and
+     * concurrent inserts. Structures that do not benefit are left alone.
+     * Only safe while no other thread accesses the index.
+     */
+    void compact() {
+        if constexpr (is_btree_based<Structure>::value) {
+            Data packed;
+            Hints hints;
+            for (const auto& tuple : data) {
+                packed.insert(tuple, hints);
+            }
+            data.swap(packed);
+        }
+    }
+
+    /**
+     * Approximates the number of bytes held by this index. Relies on the
+     * underlying data structure's constant-time accounting and is thus safe
+     * to call while the index is being updated concurrently; structures
+     * without such accounting report zero.
+     */
+    std::size_t getMemoryUsage() const {
+        return getMemoryUsage(data, 0);
+    }
+
+private:
+    template <typename D>
+    static auto getMemoryUsage(const D& data, int) -> decltype(data.getMemoryUsage()) {
+        return data.getMemoryUsage();
+    }
+
+    template <typename D>
+    static std::size_t getMemoryUsage(const D&, long) {
+        return 0;
+    }
+
+    template <typename D>
+    auto insertSorted(D& data, const RamDomain* tuples, std::size_t numTuples, int)
+            -> decltype(data.insert_sorted(std::declval<const Tuple*>(), std::declval<const Tuple*>()),
+                    bool()) {
+        std::vector<Tuple> buffer;
+        buffer.reserve(numTuples);
+        for (std::size_t i = 0; i < numTuples; ++i) {
+            Tuple tuple{};
+            std::copy_n(&tuples[i * Arity], Arity, tuple.begin());
+            buffer.push_back(order.encode(tuple));
+        }
+        data.insert_sorted(buffer.data(), buffer.data() + buffer.size());
+        return true;
+    }
+
+    template <typename D>
+    bool insertSorted(D&, const RamDomain*, std::size_t, long) {
+        return false;
+    }
+
+    template <typename D>
+    static auto insertRange(D& data, RamDomain low, RamDomain high, int)
+            -> decltype(data.insert(low, high)) {
+        return data.insert(low, high);
+    }
+
+    template <typename D>
+    static bool insertRange(D&, RamDomain, RamDomain, long) {
+        return false;
+    }
+
+    template <typename D>
+    static auto erase(D& data, const Tuple& tuple, int) -> decltype(data.erase(tuple)) {
+        return data.erase(tuple);
+    }
+
+    template <typename D>
+    static bool erase(D&, const Tuple&, long) {
+        return false;
+    }
 };
 
 /**
@@ -366,21 +551,25 @@ public:
 
     // The nullary index view -- does not require any hints.
     struct View : public ViewWrapper {
-        const std::atomic<bool>& data;
+        const std::atomic<bool>* data;
 
     public:
-        View(const std::atomic<bool>& data) : data(data) {}
+        View(const std::atomic<bool>& data) : data(&data) {}
+
+        void rebind(const std::atomic<bool>& newData) {
+            data = &newData;
+        }
 
         bool contains(const Tuple& /* t */) const {
-            return data;
+            return *data;
         }
 
         bool contains(const Tuple& /* l */, const Tuple& /* h */) const {
-            return data;
+            return *data;
         }
 
         souffle::range<iterator> range(const Tuple& /* l */, const Tuple& /* h */) const {
-            return {iterator(data), iterator()};
+            return {iterator(*data), iterator()};
         }
     };
 
@@ -389,6 +578,10 @@ public:
         return View(this->data);
     }
 
+    void refreshView(View& view) const {
+        view.rebind(this->data);
+    }
+
     Order getOrder() const {
         return Order({0});
     }
@@ -409,6 +602,14 @@ public:
         data = src.data;
     }
 
+    bool insertSorted(const RamDomain* /* tuples */, std::size_t /* numTuples */) {
+        return false;
+    }
+
+    bool erase(const Tuple& /* t */) {
+        return data.exchange(false);
+    }
+
     bool contains(const Tuple& /* t */) const {
         return data;
     }
@@ -439,6 +640,12 @@ public:
     void clear() {
         data = false;
     }
+
+    void compact() {}
+
+    std::size_t getMemoryUsage() const {
+        return sizeof(*this);
+    }
 };
 
 /**
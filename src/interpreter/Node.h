@@ -28,10 +28,15 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -76,6 +81,7 @@ struct RelationWrapper;
     FOR_EACH(Expand, ParallelScan)\
     FOR_EACH(Expand, IndexScan)\
     FOR_EACH(Expand, ParallelIndexScan)\
+    Forward(MergeJoin)\
     FOR_EACH(Expand, IfExists)\
     FOR_EACH(Expand, ParallelIfExists)\
     FOR_EACH(Expand, IndexIfExists)\
@@ -88,7 +94,9 @@ struct RelationWrapper;
     Forward(Break)\
     Forward(Filter)\
     FOR_EACH(Expand, GuardedInsert)\
+    FOR_EACH(Expand, CheckedInsert)\
     FOR_EACH(Expand, Insert)\
+    FOR_EACH(Expand, Erase)\
     Forward(SubroutineReturn)\
     Forward(Sequence)\
     Forward(Parallel)\
@@ -102,6 +110,7 @@ struct RelationWrapper;
     Forward(IO)\
     Forward(Query)\
     Forward(Extend)\
+    Forward(Merge)\
     Forward(Swap)\
     Forward(Call)
 
@@ -144,6 +153,10 @@ inline NodeType constructNodeType(std::string tokBase, const ram::Relation& rel)
         return map.at("I_" + tokBase + "_Eqrel_" + arity);
     } else if (isProvenance) {
         return map.at("I_" + tokBase + "_Provenance_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::BRIE && rel.getArity() == 1) {
+        return map.at("I_" + tokBase + "_Brie_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::INTERVAL) {
+        return map.at("I_" + tokBase + "_Interval_" + arity);
     } else {
         return map.at("I_" + tokBase + "_Btree_" + arity);
     }
@@ -297,6 +310,53 @@ protected:
     const SuperInstruction superInst;
 };
 
+/**
+ * @class ScanGrain
+ * @brief Self-tuning partition count for a parallel scan.
+ *
+ * The number of partitions a scan is carved into trades scheduling
+ * overhead against load balance: fine partitions pay a scheduler
+ * transaction each, while coarse ones let a skewed partition straggle.
+ * The right grain depends on the per-tuple cost of the nested operation,
+ * which is unknown at translation time, so each parallel statement
+ * carries its own grain and steers it by the measured cost of its own
+ * previous execution: the next execution carves just enough partitions
+ * for each to cost roughly the target, bounded below by one partition
+ * per thread and above by the static chunk factor. Re-executions of the
+ * same statement — in particular the iterations of a fixpoint loop —
+ * thereby converge to a grain matching their workload.
+ */
+class ScanGrain {
+public:
+    /** per-partition cost the grain steers towards, in microseconds */
+    static constexpr std::uint64_t TargetPartitionCost = 100;
+
+    /** @brief the number of partitions to carve for the next execution */
+    std::size_t partitions(std::size_t numOfThreads, std::size_t chunkFactor) const {
+        const std::uint64_t work = measuredWork.load(std::memory_order_relaxed);
+        const std::size_t finest = numOfThreads * chunkFactor;
+        if (work == 0) {
+            // no sample yet; favour balance over scheduling overhead
+            return finest;
+        }
+        const auto ideal = static_cast<std::size_t>(work / TargetPartitionCost);
+        return std::clamp(ideal, numOfThreads, finest);
+    }
+
+    /** @brief record the measured wall time of a completed execution */
+    void record(std::size_t numOfThreads, long elapsedUs) const {
+        // the wall time of the region times the team size approximates the
+        // total work; only the previous execution is kept, as the cost of a
+        // statement shifts with the delta it scans
+        measuredWork.store(
+                static_cast<std::uint64_t>(elapsedUs) * numOfThreads, std::memory_order_relaxed);
+    }
+
+private:
+    /** total work of the previous execution, in thread-microseconds */
+    mutable std::atomic<std::uint64_t> measuredWork{0};
+};
+
 /**
  * @class AbstractParallel
  * @brief  node that utilizes parallel execution should inherit from this class.
@@ -314,8 +374,16 @@ public:
         viewContext = v;
     }
 
+    /** @brief get the self-tuning partition grain of this statement */
+    const ScanGrain& getScanGrain() const {
+        return grain;
+    }
+
 protected:
     std::shared_ptr<ViewContext> viewContext = nullptr;
+
+    /** partition grain, adapted across executions of this statement */
+    ScanGrain grain;
 };
 
 /**
@@ -476,7 +544,21 @@ class UserDefinedOperator : public CompoundNode {
  * @class NestedIntrinsicOperator
  */
 class NestedIntrinsicOperator : public CompoundNode {
-    using CompoundNode::CompoundNode;
+    using NodePtrVec = VecOwn<Node>;
+
+public:
+    NestedIntrinsicOperator(
+            enum NodeType ty, const ram::Node* sdw, NodePtrVec children, bool intervalFill = false)
+            : CompoundNode(ty, sdw, std::move(children)), intervalFill(intervalFill) {}
+
+    /** @brief Whether this range generator feeds a bare insert into an
+     * interval relation and can thus be absorbed as coalesced spans. */
+    bool isIntervalFill() const {
+        return intervalFill;
+    }
+
+private:
+    const bool intervalFill;
 };
 
 /**
@@ -509,9 +591,100 @@ class False : public Node {
 
 /**
  * @class Conjunction
- */
-class Conjunction : public BinaryNode {
-    using BinaryNode::BinaryNode;
+ * @brief A flattened chain of conjunctive terms, evaluated in an adaptive
+ * order. Pass rates of the terms are sampled during evaluation and the
+ * evaluation order is periodically re-sorted so that the most selective
+ * term runs first. Since filters execute inside parallel scans, the order
+ * is stored as individually atomic slots; a reader observing a torn
+ * re-sort may see duplicated entries, which the engine compensates for by
+ * tracking the terms already evaluated.
+ */
+class Conjunction : public CompoundNode {
+public:
+    /** number of conjunction evaluations between two re-sorts */
+    static constexpr std::uint64_t SampleWindow = 4096;
+
+    /** largest number of terms managed adaptively (bounded by the seen-mask) */
+    static constexpr std::size_t MaxAdaptiveTerms = 64;
+
+    Conjunction(enum NodeType ty, const ram::Node* sdw, VecOwn<Node> terms)
+            : CompoundNode(ty, sdw, std::move(terms)) {
+        const std::size_t numTerms = getChildren().size();
+        if (numTerms < 2 || numTerms > MaxAdaptiveTerms) {
+            return;
+        }
+        order = std::make_unique<std::atomic<std::size_t>[]>(numTerms);
+        tried = std::make_unique<std::atomic<std::uint64_t>[]>(numTerms);
+        passed = std::make_unique<std::atomic<std::uint64_t>[]>(numTerms);
+        for (std::size_t i = 0; i < numTerms; i++) {
+            order[i].store(i, std::memory_order_relaxed);
+            tried[i].store(0, std::memory_order_relaxed);
+            passed[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief whether the evaluation order of this conjunction adapts */
+    bool isAdaptive() const {
+        return order != nullptr;
+    }
+
+    /** @brief the term to evaluate in the given position of the current order */
+    std::size_t getTermOrder(std::size_t pos) const {
+        return order[pos].load(std::memory_order_relaxed);
+    }
+
+    /** @brief record the outcome of evaluating the given term */
+    void registerOutcome(std::size_t term, bool pass) const {
+        tried[term].fetch_add(1, std::memory_order_relaxed);
+        if (pass) {
+            passed[term].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    /** @brief account a completed evaluation; re-sorts the order once per window */
+    void finishEvaluation() const {
+        if (evaluations.fetch_add(1, std::memory_order_relaxed) + 1 != SampleWindow) {
+            return;
+        }
+        const std::size_t numTerms = getChildren().size();
+
+        // sort the terms by their sampled pass rate, most selective first;
+        // terms never tried in this window carry no evidence of failing and
+        // keep their relative position at the back
+        std::vector<std::size_t> terms(numTerms);
+        std::iota(terms.begin(), terms.end(), 0);
+        std::vector<double> rate(numTerms);
+        for (std::size_t i = 0; i < numTerms; i++) {
+            const auto attempts = tried[i].load(std::memory_order_relaxed);
+            rate[i] = (attempts == 0) ? 1.0
+                                      : static_cast<double>(passed[i].load(std::memory_order_relaxed)) /
+                                                static_cast<double>(attempts);
+        }
+        std::stable_sort(terms.begin(), terms.end(),
+                [&](std::size_t lhs, std::size_t rhs) { return rate[lhs] < rate[rhs]; });
+
+        // publish the new order slot by slot and start a fresh window;
+        // concurrent counter updates lost around the reset are noise
+        for (std::size_t i = 0; i < numTerms; i++) {
+            order[i].store(terms[i], std::memory_order_relaxed);
+        }
+        for (std::size_t i = 0; i < numTerms; i++) {
+            tried[i].store(0, std::memory_order_relaxed);
+            passed[i].store(0, std::memory_order_relaxed);
+        }
+        evaluations.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    /** current evaluation order, a permutation of the term indices */
+    mutable std::unique_ptr<std::atomic<std::size_t>[]> order;
+
+    /** per-term evaluation and pass counts within the current window */
+    mutable std::unique_ptr<std::atomic<std::uint64_t>[]> tried;
+    mutable std::unique_ptr<std::atomic<std::uint64_t>[]> passed;
+
+    /** conjunction evaluations within the current window */
+    mutable std::atomic<std::uint64_t> evaluations{0};
 };
 
 /**
@@ -610,8 +783,11 @@ class ParallelScan : public Scan, public AbstractParallel {
 
 /**
  * @class IndexScan
+ * @brief Carries the view context of the enclosing query so that, when the
+ *        scan runs nested inside a parallel loop, morsel tasks splitting a
+ *        large range can recreate their own views.
  */
-class IndexScan : public Scan, public SuperOperation, public ViewOperation {
+class IndexScan : public Scan, public SuperOperation, public ViewOperation, public AbstractParallel {
 public:
     IndexScan(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, Own<Node> nested,
             std::size_t viewId, SuperInstruction superInst)
@@ -622,11 +798,83 @@ public:
 /**
  * @class ParallelIndexScan
  */
-class ParallelIndexScan : public IndexScan, public AbstractParallel {
+class ParallelIndexScan : public IndexScan {
 public:
     using IndexScan::IndexScan;
 };
 
+/**
+ * @class MergeJoin
+ * @brief Batch join of an outer scan with an equality-keyed inner index
+ *        scan, replacing one inner index probe per outer tuple.
+ *
+ * Generated for serial queries of the shape scan/index-join/filter/insert
+ * where every bound column of the inner index is point-bound to an element
+ * of the outer tuple. When both sides hold a b-tree index ordered by the
+ * join key in the same sequence, the engine walks those indexes in
+ * lockstep without materialising anything; innerIndexPos names the index
+ * of the inner relation to walk, or NoSortedIndex if the layouts rule the
+ * lockstep path out. Otherwise the smaller side is hashed into a
+ * transient open-addressing table that is probed with the other side and
+ * discarded when the query ends. The nested operation is the remainder of
+ * the query below the inner scan.
+ */
+class MergeJoin : public Node, public NestedOperation {
+public:
+    using RelationHandle = Own<RelationWrapper>;
+
+    /** Sentinel index position: no sorted iteration available on the inner side. */
+    static constexpr std::size_t NoSortedIndex = std::numeric_limits<std::size_t>::max();
+
+    MergeJoin(enum NodeType ty, const ram::Node* sdw, RelationHandle* outerHandle,
+            RelationHandle* innerHandle, std::size_t outerId, std::size_t innerId,
+            std::vector<std::size_t> outerKey, std::vector<std::size_t> innerKey,
+            std::size_t innerIndexPos, Own<Node> nested)
+            : Node(ty, sdw), NestedOperation(std::move(nested)), outerHandle(outerHandle),
+              innerHandle(innerHandle), outerId(outerId), innerId(innerId), outerKey(std::move(outerKey)),
+              innerKey(std::move(innerKey)), innerIndexPos(innerIndexPos) {}
+
+    RelationWrapper* getOuterRelation() const {
+        return (*outerHandle).get();
+    }
+
+    RelationWrapper* getInnerRelation() const {
+        return (*innerHandle).get();
+    }
+
+    std::size_t getOuterId() const {
+        return outerId;
+    }
+
+    std::size_t getInnerId() const {
+        return innerId;
+    }
+
+    /** @brief columns of the outer tuple forming the join key */
+    const std::vector<std::size_t>& getOuterKey() const {
+        return outerKey;
+    }
+
+    /** @brief columns of the inner relation bound to the key, pairwise with the outer key */
+    const std::vector<std::size_t>& getInnerKey() const {
+        return innerKey;
+    }
+
+    /** @brief index of the inner relation eligible for lockstep iteration, or NoSortedIndex */
+    std::size_t getInnerIndexPos() const {
+        return innerIndexPos;
+    }
+
+private:
+    RelationHandle* const outerHandle;
+    RelationHandle* const innerHandle;
+    const std::size_t outerId;
+    const std::size_t innerId;
+    const std::vector<std::size_t> outerKey;
+    const std::vector<std::size_t> innerKey;
+    const std::size_t innerIndexPos;
+};
+
 /**
  * @class IfExists
  */
@@ -691,16 +939,24 @@ class Aggregate : public Node,
                   public RelationalOperation {
 public:
     Aggregate(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, Own<Node> expr,
-            Own<Node> filter, Own<Node> nested)
+            Own<Node> filter, Own<Node> nested, bool memoisable = false)
             : Node(ty, sdw), ConditionalOperation(std::move(filter)), NestedOperation(std::move(nested)),
-              RelationalOperation(relHandle), expr(std::move(expr)) {}
+              RelationalOperation(relHandle), expr(std::move(expr)), memoisable(memoisable) {}
 
     inline const Node* getExpr() const {
         return expr.get();
     }
 
+    /** @brief True if condition and expression depend on nothing but the
+     * scanned tuple, so the result can be reused while the source relation
+     * is unchanged. */
+    inline bool isMemoisable() const {
+        return memoisable;
+    }
+
 protected:
     Own<Node> expr;
+    bool memoisable;
 };
 
 /**
@@ -751,8 +1007,20 @@ public:
  */
 class Insert : public Node, public SuperOperation, public RelationalOperation {
 public:
-    Insert(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, SuperInstruction superInst)
-            : Node(ty, sdw), SuperOperation(std::move(superInst)), RelationalOperation(relHandle) {}
+    Insert(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, SuperInstruction superInst,
+            bool bufferable = false)
+            : Node(ty, sdw), SuperOperation(std::move(superInst)), RelationalOperation(relHandle),
+              bufferable(bufferable) {}
+
+    /** @brief whether no other operation of the enclosing query observes the
+     * target relation, so the tuple may be staged in a thread-local buffer
+     * inside parallel regions instead of being inserted right away */
+    bool isBufferable() const {
+        return bufferable;
+    }
+
+private:
+    const bool bufferable;
 };
 
 /**
@@ -761,8 +1029,56 @@ public:
 class GuardedInsert : public Insert, public ConditionalOperation {
 public:
     GuardedInsert(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle,
-            SuperInstruction superInst, Own<Node> condition)
-            : Insert(ty, sdw, relHandle, std::move(superInst)), ConditionalOperation(std::move(condition)) {}
+            SuperInstruction superInst, Own<Node> condition, bool bufferable = false)
+            : Insert(ty, sdw, relHandle, std::move(superInst), bufferable),
+              ConditionalOperation(std::move(condition)) {}
+};
+
+/**
+ * @class CheckedInsert
+ * @brief Insert fused with a negated total existence check over the same
+ * value vector, as the clause translator emits for the head of recursive
+ * rules. The tuple is materialised once and serves both the probe of the
+ * check relation's view and the insertion; the insertion needs no probe of
+ * its own since the b-tree insert already descends exactly once, reporting
+ * whether the key was present. The probe order permutes the tuple into the
+ * column order of the view's index.
+ */
+class CheckedInsert : public GuardedInsert, public ViewOperation {
+public:
+    CheckedInsert(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle,
+            SuperInstruction superInst, Own<Node> condition, std::size_t viewId,
+            std::vector<std::size_t> probeOrder, bool tempRelation, std::string checkRelationName,
+            bool bufferable = false)
+            : GuardedInsert(ty, sdw, relHandle, std::move(superInst), std::move(condition), bufferable),
+              ViewOperation(viewId), probeOrder(std::move(probeOrder)), tempRelation(tempRelation),
+              checkRelationName(std::move(checkRelationName)) {}
+
+    const std::vector<std::size_t>& getProbeOrder() const {
+        return probeOrder;
+    }
+
+    bool isTemp() const {
+        return tempRelation;
+    }
+
+    const std::string& getCheckRelationName() const {
+        return checkRelationName;
+    }
+
+private:
+    const std::vector<std::size_t> probeOrder;
+    const bool tempRelation;
+    const std::string checkRelationName;
+};
+
+/**
+ * @class Erase
+ */
+class Erase : public Node, public SuperOperation, public RelationalOperation {
+public:
+    Erase(enum NodeType ty, const ram::Node* sdw, RelationHandle* relHandle, SuperInstruction superInst)
+            : Node(ty, sdw), SuperOperation(std::move(superInst)), RelationalOperation(relHandle) {}
 };
 
 /**
@@ -882,6 +1198,15 @@ public:
             : Node(ty, sdw), BinRelOperation(src, target) {}
 };
 
+/**
+ * @class Merge
+ */
+class Merge : public Node, public BinRelOperation {
+public:
+    Merge(enum NodeType ty, const ram::Node* sdw, std::size_t src, std::size_t target)
+            : Node(ty, sdw), BinRelOperation(src, target) {}
+};
+
 /**
  * @class Swap
  */
@@ -29,6 +29,7 @@
 #include "souffle/SouffleInterface.h"
 #include "souffle/SymbolTable.h"
 #include "souffle/utility/MiscUtil.h"
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
@@ -58,11 +59,42 @@ public:
         relation.insert(t.data);
     }
 
+    /** Insert a batch of raw tuples, bypassing per-tuple interface objects */
+    void insertBatch(const RamDomain* data, std::size_t count) override {
+        const arity_type arity = getArity();
+        for (std::size_t i = 0; i < count; i++) {
+            relation.insert(data + i * arity);
+        }
+    }
+
     /** Check whether tuple exists */
     bool contains(const tuple& t) const override {
         return relation.contains(t.data);
     }
 
+    /** Copy a batch of raw tuples out, skipping tuple and symbol conversion */
+    std::size_t extractBatch(iterator& it, RamDomain* buffer, std::size_t maxRows) const override {
+        auto& rawIt = asAssert<RelInterface::iterator_base>(it.base()).it;
+        const arity_type arity = getArity();
+        const auto stop = relation.end();
+        std::size_t rows = 0;
+        for (; rows < maxRows && rawIt != stop; ++rawIt, ++rows) {
+            const RamDomain* row = *rawIt;
+            std::copy(row, row + arity, buffer + rows * arity);
+        }
+        return rows;
+    }
+
+    /** Split into independently iterable ranges for parallel extraction */
+    std::vector<std::pair<iterator, iterator>> partition(std::size_t chunks) const override {
+        std::vector<std::pair<iterator, iterator>> res;
+        for (const auto& cur : relation.partition(chunks)) {
+            res.emplace_back(iterator(mk<RelInterface::iterator_base>(id, this, cur.first)),
+                    iterator(mk<RelInterface::iterator_base>(id, this, cur.second)));
+        }
+        return res;
+    }
+
     /** Iterator to first tuple */
     iterator begin() const override {
         return RelInterface::iterator(mk<RelInterface::iterator_base>(id, this, relation.begin()));
@@ -166,6 +198,9 @@ protected:
             return new RelInterface::iterator_base(getId(), ramRelationInterface, it);
         }
 
+        // batch extraction reaches through to the raw iterator
+        friend class RelInterface;
+
     protected:
         /** Check equivalence */
         bool equal(const souffle::Relation::iterator_base& o) const override {
@@ -254,8 +289,12 @@ public:
         }
     }
 
-    /** Run program instance: not implemented */
-    void run() override {}
+    /** Run program instance on the facts currently in its relations, without I/O */
+    void run() override {
+        exec.setPerformIO(false);
+        exec.executeMain();
+        exec.setPerformIO(true);
+    }
 
     /** Load data, run program instance, store data: not implemented */
     void runAll(std::string, std::string, bool, bool) override {}
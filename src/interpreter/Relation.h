@@ -105,14 +105,56 @@ public:
 
     virtual Iterator end() const = 0;
 
+    /**
+     * Iteration over an arbitrary index of the relation; tuples arrive in
+     * the lexicographical order of that index, decoded to column order.
+     */
+    virtual Iterator begin(std::size_t indexPos) const = 0;
+
+    virtual Iterator end(std::size_t indexPos) const = 0;
+
+    /**
+     * Splits the full scan into independently traversable portions for
+     * parallel extraction; the requested count is a hint.
+     */
+    virtual std::vector<std::pair<Iterator, Iterator>> partition(std::size_t chunks) const = 0;
+
     virtual void insert(const RamDomain*) = 0;
 
+    virtual void insert(const RelationWrapper& other) = 0;
+
+    /** Add an ordered sequence of raw tuples, bulk-loading where the backing structure allows it */
+    virtual void insertSorted(const RamDomain* tuples, std::size_t numTuples) = 0;
+
     virtual bool contains(const RamDomain*) const = 0;
 
     virtual std::size_t size() const = 0;
 
+    /**
+     * Approximates the number of bytes held by this relation across all of
+     * its indexes; safe to call while the relation is being updated.
+     */
+    virtual std::size_t getMemoryUsage() const = 0;
+
     virtual void purge() = 0;
 
+    /**
+     * Rebuilds the indexes of this relation into a packed layout. Intended
+     * for relations that have received their last update and are only
+     * probed from here on; the content is unchanged. Only safe while no
+     * other thread accesses the relation.
+     */
+    virtual void compact() = 0;
+
+    /**
+     * Content between content-destroying updates only ever grows, so a
+     * relation object with an unchanged version and size is guaranteed to
+     * hold the same tuples.
+     */
+    std::size_t getVersion() const {
+        return version;
+    }
+
     const std::string& getName() const {
         return relName;
     }
@@ -141,11 +183,21 @@ public:
      */
     virtual IndexViewPtr createView(const std::size_t&) const = 0;
 
+    /**
+     * Re-targets an existing view at an index of this relation, recycling the
+     * view object instead of allocating a new one. The view must have been
+     * created for the same relation/index slot.
+     */
+    virtual void refreshView(const std::size_t&, ViewWrapper&) const = 0;
+
 protected:
     std::string relName;
 
     arity_type arity;
     arity_type auxiliaryArity;
+
+    /** counter of content-destroying updates, incremented on purge and erase */
+    std::size_t version = 0;
 };
 
 /**
@@ -213,10 +265,40 @@ public:
         __purge();
     }
 
+    void compact() override {
+        for (auto& idx : indexes) {
+            idx->compact();
+        }
+    }
+
     void insert(const RamDomain* data) override {
         insert(constructTuple(data));
     }
 
+    void insert(const RelationWrapper& other) override {
+        // all relations derived from the same source relation share their
+        // arity and data structure, hence the typed bulk insertion applies
+        insert(static_cast<const Relation<Arity, Structure>&>(other));
+    }
+
+    void insertSorted(const RamDomain* data, std::size_t numTuples) override {
+        // an empty relation bulk-loads its main index from the ordered
+        // sequence and populates the remaining indexes by ordinary
+        // insertion; otherwise, and for index structures without a sorted
+        // bulk insertion, the tuples are inserted one by one
+        if (size() == 0 && main->insertSorted(data, numTuples)) {
+            for (std::size_t i = 1; i < indexes.size(); ++i) {
+                for (std::size_t j = 0; j < numTuples; ++j) {
+                    indexes[i]->insert(constructTuple(&data[j * Arity]));
+                }
+            }
+            return;
+        }
+        for (std::size_t j = 0; j < numTuples; ++j) {
+            insert(&data[j * Arity]);
+        }
+    }
+
     bool contains(const RamDomain* data) const override {
         return contains(constructTuple(data));
     }
@@ -225,10 +307,22 @@ public:
         return mk<View>(indexes[indexPos]->createView());
     }
 
+    void refreshView(const std::size_t& indexPos, ViewWrapper& view) const override {
+        indexes[indexPos]->refreshView(*castView(&view));
+    }
+
     std::size_t size() const override {
         return __size();
     }
 
+    std::size_t getMemoryUsage() const override {
+        std::size_t bytes = sizeof(*this);
+        for (const auto& idx : indexes) {
+            bytes += idx->getMemoryUsage();
+        }
+        return bytes;
+    }
+
     Order getIndexOrder(std::size_t idx) const override {
         return indexes[idx]->getOrder();
     }
@@ -276,6 +370,23 @@ public:
         return Iterator(new iterator_base(main->end(), main->getOrder()));
     }
 
+    Iterator begin(std::size_t indexPos) const override {
+        return Iterator(new iterator_base(indexes[indexPos]->begin(), indexes[indexPos]->getOrder()));
+    }
+
+    Iterator end(std::size_t indexPos) const override {
+        return Iterator(new iterator_base(indexes[indexPos]->end(), indexes[indexPos]->getOrder()));
+    }
+
+    std::vector<std::pair<Iterator, Iterator>> partition(std::size_t chunks) const override {
+        std::vector<std::pair<Iterator, Iterator>> res;
+        for (const auto& cur : partitionScan(std::max<std::size_t>(chunks, 1))) {
+            res.emplace_back(Iterator(new iterator_base(cur.begin(), main->getOrder())),
+                    Iterator(new iterator_base(cur.end(), main->getOrder())));
+        }
+        return res;
+    }
+
     // -----
     // Following section defines and implement interfaces for interpreter execution.
     //
@@ -296,6 +407,38 @@ public:
         return true;
     }
 
+    /**
+     * Add every value of the closed span [low,high] to this relation as a
+     * single coalescing update. Only relations backed by data structures
+     * with a span insert absorb the range; others are unchanged.
+     */
+    bool insertRange(RamDomain low, RamDomain high) {
+        if (!(main->insertRange(low, high))) {
+            return false;
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->insertRange(low, high);
+        }
+        return true;
+    }
+
+    /**
+     * Remove the given tuple from this relation. Only relations backed by
+     * data structures with an erase operation shrink; others are unchanged.
+     */
+    bool erase(const Tuple& tuple) {
+        if (!(main->erase(tuple))) {
+            return false;
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->erase(tuple);
+        }
+        // content no longer grows monotonically, so cached knowledge about
+        // this relation's content must be invalidated
+        ++version;
+        return true;
+    }
+
     /**
      * Add all entries of the given relation to this relation.
      */
@@ -355,6 +498,8 @@ public:
      * installed indexes.
      */
     void swap(Relation<Arity, Structure>& other) {
+        ++version;
+        ++other.version;
         indexes.swap(other.indexes);
     }
 
@@ -376,6 +521,7 @@ public:
      * Clear all indexes
      */
     void __purge() {
+        ++version;
         for (auto& idx : indexes) {
             idx->clear();
         }
@@ -431,4 +577,7 @@ Own<RelationWrapper> createBrieRelation(
 // A factory for Eqrel index.
 Own<RelationWrapper> createEqrelRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+// A factory for Interval based index.
+Own<RelationWrapper> createIntervalRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 }  // namespace souffle::interpreter
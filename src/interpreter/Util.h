@@ -20,8 +20,11 @@
 #include "souffle/datastructure/BTree.h"
 #include "souffle/datastructure/Brie.h"
 #include "souffle/datastructure/EquivalenceRelation.h"
+#include "souffle/datastructure/IntervalSet.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include <memory>
+#include <type_traits>
 
 namespace souffle::interpreter {
 // clang-format off
@@ -79,12 +82,22 @@ namespace souffle::interpreter {
     func(Btree, 17, __VA_ARGS__) \
     func(Btree, 18, __VA_ARGS__) \
     func(Btree, 19, __VA_ARGS__) \
-    func(Btree, 20, __VA_ARGS__)
-
-// Brie is disabled for now.
-#define FOR_EACH_BRIE(func, ...)
+    func(Btree, 20, __VA_ARGS__) \
+    func(Btree, 21, __VA_ARGS__) \
+    func(Btree, 22, __VA_ARGS__) \
+    func(Btree, 23, __VA_ARGS__) \
+    func(Btree, 24, __VA_ARGS__) \
+    func(Btree, 25, __VA_ARGS__) \
+    func(Btree, 26, __VA_ARGS__) \
+    func(Btree, 27, __VA_ARGS__) \
+    func(Btree, 28, __VA_ARGS__)
+
+// Brie is only enabled for unary relations, where the trie reduces to a
+// sparse bit map offering bit-level storage and constant-time membership
+// tests for dense domains. Higher arities remain disabled for now.
+#define FOR_EACH_BRIE(func, ...) \
+    func(Brie, 1, __VA_ARGS__)
     /* func(Brie, 0, __VA_ARGS__) \ */
-    /* func(Brie, 1, __VA_ARGS__) \ */
     /* func(Brie, 2, __VA_ARGS__) \ */
     /* func(Brie, 3, __VA_ARGS__) \ */
     /* func(Brie, 4, __VA_ARGS__) \ */
@@ -108,11 +121,17 @@ namespace souffle::interpreter {
 #define FOR_EACH_EQREL(func, ...)\
     func(Eqrel, 2, __VA_ARGS__)
 
+// Interval sets are inherently unary: they coalesce contiguous runs of a
+// single attribute into spans.
+#define FOR_EACH_INTERVAL(func, ...)\
+    func(Interval, 1, __VA_ARGS__)
+
 #define FOR_EACH(func, ...)                 \
     FOR_EACH_BTREE(func, __VA_ARGS__)       \
     FOR_EACH_BRIE(func, __VA_ARGS__)        \
     FOR_EACH_PROVENANCE(func, __VA_ARGS__)  \
-    FOR_EACH_EQREL(func, __VA_ARGS__)
+    FOR_EACH_EQREL(func, __VA_ARGS__)       \
+    FOR_EACH_INTERVAL(func, __VA_ARGS__)
 
 // clang-format on
 
@@ -220,9 +239,17 @@ using comparator = typename index_utils::get_full_index<Arity>::type::comparator
 template <std::size_t Arity>
 using prov_comparator = typename index_utils::get_full_prov_index<Arity>::type::comparator;
 
+// The node-search strategy to be used for B-tree nodes. Single-column
+// relations store plain RamDomain keys in their natural order and can use
+// the vectorised search.
+template <std::size_t Arity>
+using btree_strategy = std::conditional_t<Arity == 1, detail::simd_search,
+        typename detail::default_strategy<t_tuple<Arity>>::type>;
+
 // Alias for btree_set
 template <std::size_t Arity>
-using Btree = btree_set<t_tuple<Arity>, comparator<Arity>>;
+using Btree = btree_set<t_tuple<Arity>, comparator<Arity>, std::allocator<t_tuple<Arity>>, 256,
+        btree_strategy<Arity>>;
 
 // Alias for Trie
 template <std::size_t Arity>
@@ -248,4 +275,22 @@ using Provenance = btree_set<t_tuple<Arity>, prov_comparator<Arity>, std::alloca
 template <std::size_t Arity>
 using Eqrel = EquivalenceRelation<t_tuple<Arity>>;
 
+// Alias for Interval
+// Note: require Arity = 1.
+template <std::size_t Arity>
+using Interval = IntervalSet<t_tuple<Arity>>;
+
+// Whether a data structure is backed by the b-tree and hence gains from an
+// in-order rebuild once its relation is final: unordered and concurrent
+// insertion leaves b-tree nodes partially filled, while tries, interval sets
+// and equivalence relations reproduce the same layout regardless of order.
+template <template <std::size_t> typename Structure>
+struct is_btree_based : std::false_type {};
+
+template <>
+struct is_btree_based<Btree> : std::true_type {};
+
+template <>
+struct is_btree_based<Provenance> : std::true_type {};
+
 };  // namespace souffle::interpreter
@@ -33,6 +33,7 @@
 #include "ast/transform/GroundedTermsChecker.h"
 #include "ast/transform/IOAttributes.h"
 #include "ast/transform/IODefaults.h"
+#include "ast/transform/IncrementalCheckpoint.h"
 #include "ast/transform/InlineRelations.h"
 #include "ast/transform/MagicSet.h"
 #include "ast/transform/MaterializeAggregationQueries.h"
@@ -54,6 +55,7 @@
 #include "ast/transform/ResolveAliases.h"
 #include "ast/transform/ResolveAnonymousRecordAliases.h"
 #include "ast/transform/SemanticChecker.h"
+#include "ast/transform/SharedBodyPrefix.h"
 #include "ast/transform/SimplifyAggregateTargetExpression.h"
 #include "ast/transform/UniqueAggregationVariables.h"
 #include "ast2ram/TranslationStrategy.h"
@@ -70,26 +72,35 @@
 #include "ram/Node.h"
 #include "ram/Program.h"
 #include "ram/TranslationUnit.h"
+#include "ram/analysis/Partition.h"
 #include "ram/transform/CollapseFilters.h"
 #include "ram/transform/Conditional.h"
 #include "ram/transform/EliminateDuplicates.h"
 #include "ram/transform/ExpandFilter.h"
+#include "ram/transform/FoldConstants.h"
 #include "ram/transform/HoistAggregate.h"
 #include "ram/transform/HoistConditions.h"
+#include "ram/transform/HoistRecordUnpacks.h"
 #include "ram/transform/IfConversion.h"
 #include "ram/transform/IfExistsConversion.h"
 #include "ram/transform/Loop.h"
 #include "ram/transform/MakeIndex.h"
 #include "ram/transform/Parallel.h"
+#include "ram/transform/ParallelizeSequences.h"
+#include "ram/transform/ReleaseRelations.h"
 #include "ram/transform/ReorderConditions.h"
 #include "ram/transform/ReorderFilterBreak.h"
 #include "ram/transform/ReportIndex.h"
 #include "ram/transform/Sequence.h"
 #include "ram/transform/Transformer.h"
 #include "ram/transform/TupleId.h"
+#include "ram/utility/QueryPlanPrinter.h"
+#include "ram/utility/Serialiser.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
+#include "souffle/QueryShell.h"
 #include "souffle/RamTypes.h"
+#include "souffle/ServerInterface.h"
 #include "souffle/profile/Tui.h"
 #include "souffle/provenance/Explain.h"
 #include "souffle/utility/ContainerUtil.h"
@@ -101,9 +112,11 @@
 #include "synthesiser/Synthesiser.h"
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -115,9 +128,39 @@
 #include <thread>
 #include <utility>
 #include <vector>
+#ifndef _WIN32
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 namespace souffle {
 
+/**
+ * The stamp of the program being evaluated, guarding the incremental
+ * checkpoint directory; computed once the transformed AST is available.
+ */
+std::string incrementalCheckpointStamp;
+
+/**
+ * Marks the incremental checkpoint directory as complete, enabling warm
+ * starts on subsequent runs. The marker carries the stamp of the evaluated
+ * program, so a later run with changed rules rejects the checkpoint.
+ */
+void completeIncrementalCheckpoint() {
+    if (!Global::config().has("incremental-dir")) {
+        return;
+    }
+    const std::string markerFile = Global::config().get("incremental-dir") + "/.complete";
+    // a cached-RAM rerun skips the frontend and computes no stamp; the cache
+    // key covers source and configuration, so the existing marker still holds
+    if (incrementalCheckpointStamp.empty() && existFile(markerFile)) {
+        return;
+    }
+    std::ofstream marker(markerFile);
+    marker << incrementalCheckpointStamp << '\n';
+}
+
 /**
  * Executes a binary file.
  */
@@ -137,6 +180,9 @@ namespace souffle {
 
     auto exit = execute(binaryFilename, {}, env);
     if (!exit) throw std::invalid_argument("failed to execute `" + binaryFilename + "`");
+    if (*exit == 0) {
+        completeIncrementalCheckpoint();
+    }
 
     if (!Global::config().has("dl-program")) {
         remove(binaryFilename.c_str());
@@ -155,6 +201,26 @@ void compileToBinary(const std::string& command, std::string_view sourceFilename
         argv.push_back("-s");
         argv.push_back(Global::config().get("swig"));
     }
+    if (Global::config().get("jobs") != "1") {
+        // let souffle-compile build the split translation units in parallel
+        argv.push_back("-j");
+        argv.push_back(Global::config().get("jobs"));
+    }
+
+    if (Global::config().has("fast-compile")) {
+        argv.push_back("-f");
+    }
+
+    // integrated PGO flow: a --profile run leaves compiler profile data next
+    // to the log file, and a --profile-use run feeds it back to the compiler
+    if (Global::config().has("profile")) {
+        argv.push_back("-p");
+        argv.push_back(Global::config().get("profile") + ".pgo");
+    }
+    if (Global::config().has("profile-use") && existDir(Global::config().get("profile-use") + ".pgo")) {
+        argv.push_back("-u");
+        argv.push_back(Global::config().get("profile-use") + ".pgo");
+    }
 
     for (auto&& path : Global::config().getMany("library-dir")) {
         // The first entry may be blank
@@ -179,6 +245,189 @@ void compileToBinary(const std::string& command, std::string_view sourceFilename
         throw std::invalid_argument(tfm::format("failed to compile C++ source <%s>", sourceFilename));
 }
 
+#ifndef _WIN32
+/**
+ * Hybrid execution: the interpreter starts evaluating immediately while the
+ * synthesiser and the C++ compiler run concurrently; whichever side finishes
+ * first supplies the result. The two sides run in separate processes and do
+ * not share relation state, so a finished compile stops the interpreter and
+ * the compiled binary re-evaluates from the fact files — it rewrites every
+ * output, so no partial interpreter output survives. The total run time is
+ * the minimum of the two pure modes, plus a fork.
+ */
+[[noreturn]] void executeHybridAndExit(
+        ram::TranslationUnit& ramTranslationUnit, const std::string& souffleExecutable) {
+    const std::string baseFilename = tempFile();
+    const std::string sourceFilename = baseFilename + ".cpp";
+
+    const pid_t interpreterPid = fork();
+    if (interpreterPid == 0) {
+        try {
+            interpreter::Engine engine(ramTranslationUnit);
+            engine.executeMain();
+            completeIncrementalCheckpoint();
+        } catch (std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            std::_Exit(EXIT_FAILURE);
+        }
+        std::_Exit(EXIT_SUCCESS);
+    }
+    if (interpreterPid < 0) {
+        throw std::runtime_error("failed to fork the interpreter for hybrid execution");
+    }
+
+    const pid_t compilerPid = fork();
+    if (compilerPid == 0) {
+        // own process group, so that an abandoned compile dies with its subprocesses
+        setpgid(0, 0);
+        try {
+            auto synthesiser = mk<synthesiser::Synthesiser>(ramTranslationUnit);
+            bool withSharedLibrary;
+            {
+                std::ofstream os{sourceFilename};
+                synthesiser->generateCode(os, identifier(simpleName(baseFilename)), withSharedLibrary);
+            }
+            auto souffle_compile = findTool("souffle-compile", souffleExecutable, ".");
+            if (!isExecutable(souffle_compile)) {
+                throw std::runtime_error("failed to locate souffle-compile");
+            }
+            compileToBinary(souffle_compile, sourceFilename);
+        } catch (std::exception& e) {
+            std::cerr << e.what() << std::endl;
+            std::_Exit(EXIT_FAILURE);
+        }
+        std::_Exit(EXIT_SUCCESS);
+    }
+    if (compilerPid < 0) {
+        // no compile side; the interpreter carries the run alone
+        int status = 0;
+        waitpid(interpreterPid, &status, 0);
+        std::exit(WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE);
+    }
+    setpgid(compilerPid, compilerPid);
+
+    for (;;) {
+        int status = 0;
+        const pid_t finished = wait(&status);
+        if (finished == interpreterPid) {
+            // interpretation won: abandon the compile
+            kill(-compilerPid, SIGTERM);
+            waitpid(compilerPid, nullptr, 0);
+            remove(sourceFilename.c_str());
+            remove(baseFilename.c_str());
+            std::exit(WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE);
+        }
+        if (finished == compilerPid) {
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                // compilation failed; the interpreter carries the run alone
+                waitpid(interpreterPid, &status, 0);
+                std::exit(WIFEXITED(status) ? WEXITSTATUS(status) : EXIT_FAILURE);
+            }
+            if (Global::config().has("verbose")) {
+                std::cout << "Hybrid execution: switching to compiled evaluation\n";
+            }
+            kill(interpreterPid, SIGKILL);
+            waitpid(interpreterPid, nullptr, 0);
+            executeBinaryAndExit(baseFilename);
+        }
+        if (finished < 0) {
+            std::exit(EXIT_FAILURE);
+        }
+    }
+}
+#endif
+
+/**
+ * Renders the FNV-1a hash of the given cache description as a fixed-width
+ * hexadecimal key.
+ */
+std::string hashToKey(const std::string& content) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char c : content) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    std::stringstream key;
+    key << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return key.str();
+}
+
+/**
+ * Computes the key for the compiled-binary cache: a content hash of the
+ * transformed RAM program together with every configuration value that is
+ * baked into the generated code, and the compiler environment.
+ */
+std::string binaryCacheKey(const ram::TranslationUnit& ramTranslationUnit) {
+    std::stringstream content;
+    // configuration keys read during synthesis and compilation
+    for (const char* key : {"", "jobs", "profile", "profile-frequency", "provenance", "verbose",
+                 "live-profile", "version", "libraries", "library-dir", "fast-compile",
+                 "functor-header"}) {
+        content << key << '=' << Global::config().get(key) << '\n';
+    }
+    // the toolchain may change underneath the cache
+    for (const char* var : {"CXX", "CXXFLAGS", "CPPFLAGS", "LDFLAGS"}) {
+        const char* value = std::getenv(var);
+        content << var << '=' << (value != nullptr ? value : "") << '\n';
+    }
+    content << ramTranslationUnit.getProgram();
+
+    return hashToKey(content.str());
+}
+
+/**
+ * Computes the key for the interpreter's RAM cache: a content hash of the
+ * pre-processed source together with the entire configuration, which
+ * subsumes every option that can influence the transformed program.
+ */
+std::string ramCacheKey(const std::string& source) {
+    std::stringstream content;
+    content << join(Global::config().data(), "\n", [](std::ostream& out, const auto& arg) {
+        out << arg.first << '=' << arg.second;
+    });
+    content << '\n' << source;
+    return hashToKey(content.str());
+}
+
+/**
+ * Computes the stamp guarding the incremental checkpoint directory: a
+ * content hash of the transformed program together with the options that
+ * change the set of derived tuples. The transformed AST is hashed rather
+ * than the RAM program, since the latter differs between a warm and a cold
+ * run of the very same rules.
+ */
+std::string incrementalCheckpointKey(const ast::TranslationUnit& astTranslationUnit) {
+    std::stringstream content;
+    for (const char* key : {"magic-transform", "magic-transform-exclude", "inline-exclude",
+                 "disable-transformers", "legacy"}) {
+        content << key << '=' << Global::config().get(key) << '\n';
+    }
+    content << astTranslationUnit.getProgram();
+    return hashToKey(content.str());
+}
+
+/**
+ * Copies a binary file, carrying over its permission bits.
+ */
+bool copyBinaryFile(const std::string& from, const std::string& to) {
+    std::ifstream source(from, std::ios::binary);
+    std::ofstream destination(to, std::ios::binary | std::ios::trunc);
+    if (!source || !destination) {
+        return false;
+    }
+    destination << source.rdbuf();
+    destination.close();
+    if (!destination) {
+        return false;
+    }
+#ifndef _WIN32
+    struct stat status = {};
+    if (stat(from.c_str(), &status) == 0) {
+        chmod(to.c_str(), status.st_mode);
+    }
+#endif
+    return true;
+}
+
 int main(int argc, char** argv) {
     /* Time taking for overall runtime */
     auto souffle_start = std::chrono::high_resolution_clock::now();
@@ -210,6 +459,77 @@ int main(int argc, char** argv) {
                 {"include-dir", 'I', "DIR", ".", true, "Specify directory for include files."},
                 {"output-dir", 'D', "DIR", ".", false,
                         "Specify directory for output files. If <DIR> is `-` then stdout is used."},
+                {"incremental-dir", '\x9', "DIR", "", false,
+                        "Enable incremental evaluation, checkpointing relation states to <DIR>. "
+                        "A later run restores the checkpoint and propagates fact insertions only."},
+                {"snapshot", '\xa', "FILE", "", false,
+                        "Write a binary snapshot of the evaluation state to <FILE> after each "
+                        "stratum (interpreter only). A later run restores the snapshot and resumes "
+                        "after the last completed stratum."},
+                {"memory-budget", '\xf', "MB", "", false,
+                        "Bound the interpreter's resident relation storage to roughly <MB> "
+                        "megabytes. When the bound is exceeded between strata, relations not "
+                        "referenced by the upcoming stratum are spilled to temporary files and "
+                        "reloaded on demand."},
+                {"goal", '\x10', "RELATION", "", false,
+                        "Evaluate goal-directed (interpreter only): run only the strata on the "
+                        "dependency path to <RELATION> and stop the evaluation as soon as its "
+                        "first tuple is derived, leaving other outputs partial."},
+                {"parallel-threshold", '\x11', "N", "", false,
+                        "Run parallel scans serially while their source relation holds fewer "
+                        "than <N> tuples (interpreter only, default 1024), so small strata do "
+                        "not pay thread-team overhead. Also settable per program via "
+                        ".pragma \"parallel-threshold\"."},
+                {"io-parallelism", '\x15', "N", "", false,
+                        "Load up to <N> input relations concurrently (interpreter only; defaults "
+                        "to the jobs count). Consecutive loads of distinct relations stream from "
+                        "disk in parallel; 1 restores strictly serial loading."},
+                {"huge-pages", '\x17', "", "", false,
+                        "Back large node pools and symbol-table storage with transparent huge "
+                        "pages where the platform supports it, reducing TLB pressure on "
+                        "multi-gigabyte relations."},
+                {"relaxed-autoinc", '\x13', "", "", false,
+                        "Hand out autoinc() identifiers from per-thread blocks instead of one "
+                        "shared counter (interpreter only). Identifiers stay unique but are no "
+                        "longer dense or sequential across threads."},
+                {"hybrid", '\x14', "", "", false,
+                        "Start interpreting immediately while the program is compiled in the "
+                        "background; whichever finishes first supplies the result. A finished "
+                        "compile restarts the evaluation from the fact files with the compiled "
+                        "binary, so long fixpoints benefit from compiled speed without paying "
+                        "the compile time up front."},
+                {"server", '\xe', "SOCKET", "", false,
+                        "After the first evaluation, keep serving the program over the Unix domain "
+                        "socket at <SOCKET> (interpreter only): clients send fact batches and "
+                        "fetch results in the binary tuple format, and trigger re-evaluations, "
+                        "amortising startup and fact parsing across jobs."},
+                {"live", '\x19', "", "", false,
+                        "Generate an `update` subroutine folding facts inserted since the last "
+                        "evaluation into the computed fixpoint, re-entering the semi-naive loop "
+                        "with the new tuples as the delta instead of recomputing from scratch. "
+                        "Maintenance is insert-only: retractions, and new facts reaching a "
+                        "negation or an aggregate, still require a full re-run. Server clients "
+                        "trigger an update with the 'U' request."},
+                {"query", '\x1a', "", "", false,
+                        "Open an interactive shell after evaluation (interpreter only): the "
+                        "relations stay loaded in memory, and ad-hoc conjunctive queries over "
+                        "constants, quoted symbols and shared variables are answered directly "
+                        "from the resident data instead of a rerun with extra outputs."},
+                {"functor-header", '\xd', "FILE", "", false,
+                        "Include <FILE> into the generated C++ source instead of declaring "
+                        "user-defined functors externally, so that functor calls inline into the "
+                        "generated loops. <FILE> must define every functor with the signature its "
+                        "functor library would export. The interpreter ignores this option and "
+                        "keeps resolving functors dynamically."},
+                {"fast-compile", '\xc', "", "", false,
+                        "Compile the generated C++ at a low optimisation level. For short-running "
+                        "or mid-sized programs the shorter compilation usually outweighs the "
+                        "slower generated code."},
+                {"cache-dir", '\xb', "DIR", "", false,
+                        "Cache compiled binaries and transformed RAM programs in <DIR>, keyed by "
+                        "a content hash of the program and its options. A rerun of an unchanged "
+                        "program reuses the cached binary (compiled mode) or restores the RAM "
+                        "program and skips the frontend entirely (interpreted mode)."},
                 {"jobs", 'j', "N", "1", false,
                         "Run interpreter/compiler in parallel using N threads, N=auto for system "
                         "default."},
@@ -221,6 +541,10 @@ int main(int argc, char** argv) {
                         "<FILE>. If <FILE> is `-` then stdout is used."},
                 {"inline-exclude", '\x7', "RELATIONS", "", false,
                         "Prevent the given relations from being inlined. Overrides any `inline` qualifiers."},
+                {"inline-budget", '\x18', "N", "50000", false,
+                        "Demote `inline` relations to materialised ones while the estimated "
+                        "post-inline clause count exceeds <N>, largest blowup first. 0 inlines "
+                        "unconditionally."},
                 {"swig", 's', "LANG", "", false,
                         "Generate SWIG interface for given language. The values <LANG> accepts is java and "
                         "python. "},
@@ -244,6 +568,21 @@ int main(int argc, char** argv) {
                 {"profile-use", 'u', "FILE", "", false,
                         "Use profile log-file <FILE> for profile-guided optimization."},
                 {"profile-frequency", '\2', "", "", false, "Enable the frequency counter in the profiler."},
+                {"profile-sampling", '\x16', "FILE", "", false,
+                        "Enable sampling profiling, and write profile data to <FILE> (interpreter "
+                        "only). A background thread samples the executing statement about once a "
+                        "millisecond instead of timing every statement, keeping the overhead low "
+                        "enough for production runs at the cost of statistical attribution."},
+                {"auto-tune", '\x12', "FILE", "", false,
+                        "Enable profile-guided auto-tuning. Tuning data is read from <FILE> when it "
+                        "exists and rewritten after the run, so a second run of the same program is "
+                        "tuned by the first."},
+                {"calibrate", '\x1b', "N", "", false,
+                        "Calibrate the run with a sampled pre-run (interpreter only, not on "
+                        "Windows): the program is first evaluated on a uniform random sample of at "
+                        "most <N> facts per input relation with profiling enabled, and the "
+                        "recorded profile then drives the planning of the full run, like a "
+                        "profile passed via --profile-use."},
                 {"debug-report", 'r', "FILE", "", false, "Write HTML debug report to <FILE>."},
                 {"pragma", 'P', "OPTIONS", "", true, "Set pragma options."},
                 {"provenance", 't', "[ none | explain | explore ]", "", false,
@@ -256,8 +595,10 @@ int main(int argc, char** argv) {
                         "\tinitial-ast\n"
                         "\tinitial-ram\n"
                         "\tparse-errors\n"
+                        "\tpartition-analysis\n"
                         "\tprecedence-graph\n"
                         "\tprecedence-graph-text\n"
+                        "\tquery-plan\n"
                         "\tscc-graph\n"
                         "\tscc-graph-text\n"
                         "\ttransformed-ast\n"
@@ -368,6 +709,92 @@ int main(int argc, char** argv) {
         if (Global::config().has("live-profile") && !Global::config().has("profile")) {
             Global::config().set("profile");
         }
+
+        // Huge-page backing is decided inside the header-only datastructures,
+        // shared by the interpreter and compiled binaries alike, hence the
+        // request travels as an environment variable that child processes
+        // inherit rather than as a configuration entry.
+        if (Global::config().has("huge-pages")) {
+#ifdef _WIN32
+            _putenv_s("SOUFFLE_HUGE_PAGES", "1");
+#else
+            setenv("SOUFFLE_HUGE_PAGES", "1", 1);
+#endif
+        }
+
+        // Sampling reuses the profiling instrumentation of the RAM program
+        // and the profile log plumbing; the engine only swaps the per-scope
+        // timers for the cheap sample-point stores.
+        if (Global::config().has("profile-sampling") && !Global::config().has("profile")) {
+            Global::config().set("profile", Global::config().get("profile-sampling"));
+        }
+
+        // Auto-tuning treats the profile log as a persistent tuning sidecar:
+        // when it exists it is fed back as a profile for profile-guided
+        // optimisation, and the run refreshes it either way, so a second run
+        // of the same program picks up the tuning of the first.
+        if (Global::config().has("auto-tune")) {
+            const std::string tuningFile = Global::config().get("auto-tune");
+            if (!Global::config().has("profile-use") && existFile(tuningFile)) {
+                Global::config().set("profile-use", tuningFile);
+            }
+            if (!Global::config().has("profile")) {
+                Global::config().set("profile", tuningFile);
+            }
+            if (!Global::config().has("profile-frequency")) {
+                Global::config().set("profile-frequency");
+            }
+        }
+
+        // Calibration measures the program before the run is planned: a
+        // forked child evaluates the program on a uniform sample of the
+        // input facts with profiling enabled, and the resulting profile
+        // then drives the planning of the full run through the regular
+        // profile feedback path. The child runs the ordinary pipeline; the
+        // sampled loads and the suppressed stores are keyed off the
+        // calibrate option within the interpreter itself.
+        if (Global::config().has("calibrate")) {
+            bool applicable = true;
+            for (const char* opt : {"compile", "dl-program", "generate", "swig", "show", "provenance",
+                         "server", "live-profile", "query", "hybrid", "profile-use"}) {
+                applicable = applicable && !Global::config().has(opt);
+            }
+#ifdef _WIN32
+            applicable = false;
+#endif
+            if (!applicable) {
+                std::cerr << "warning: calibration is incompatible with the given options; "
+                             "running without it\n";
+                Global::config().unset("calibrate");
+            }
+        }
+#ifndef _WIN32
+        if (Global::config().has("calibrate")) {
+            const std::string calibrationProfile = tempFile();
+            const pid_t calibrationPid = fork();
+            if (calibrationPid < 0) {
+                throw std::runtime_error("failed to fork the calibration pre-run");
+            }
+            if (calibrationPid == 0) {
+                Global::config().set("profile", calibrationProfile);
+                Global::config().set("profile-frequency");
+                // the pre-run must leave no traces beyond the profile
+                for (const char* opt : {"incremental-dir", "cache-dir", "auto-tune"}) {
+                    Global::config().unset(opt);
+                }
+            } else {
+                int status = 0;
+                waitpid(calibrationPid, &status, 0);
+                if (WIFEXITED(status) && WEXITSTATUS(status) == EXIT_SUCCESS &&
+                        existFile(calibrationProfile)) {
+                    Global::config().set("profile-use", calibrationProfile);
+                } else {
+                    std::cerr << "warning: the calibration pre-run failed; planning without it\n";
+                }
+                Global::config().unset("calibrate");
+            }
+        }
+#endif
     } catch (std::exception& e) {
         std::cerr << e.what() << std::endl;
         exit(EXIT_FAILURE);
@@ -411,11 +838,39 @@ int main(int argc, char** argv) {
 
     // ------- parse program -------------
 
-    // parse file
+    // A plain interpreted run with an enabled cache buffers the pre-processed
+    // source so the invocation can be hashed; a rerun of an unchanged program
+    // then restores the transformed RAM program below and skips the whole
+    // frontend. Interactive and code-emitting modes take the full pipeline,
+    // as does any program carrying pragmas, since those are merged into the
+    // configuration during semantic analysis.
+    bool ramCacheEnabled = Global::config().has("cache-dir");
+    for (const char* opt : {"compile", "dl-program", "generate", "swig", "show", "provenance", "server",
+                 "live-profile", "query", "hybrid"}) {
+        ramCacheEnabled = ramCacheEnabled && !Global::config().has(opt);
+    }
+    std::string source;
+    bool sourceBuffered = false;
+    if (ramCacheEnabled) {
+        char chunk[4096];
+        for (std::size_t bytes; (bytes = fread(chunk, 1, sizeof(chunk), in)) > 0;) {
+            source.append(chunk, bytes);
+        }
+        sourceBuffered = true;
+        ramCacheEnabled = source.find(".pragma") == std::string::npos;
+    }
+    const std::string ramCacheFile =
+            ramCacheEnabled ? Global::config().get("cache-dir") + "/souffle-ram-" + ramCacheKey(source) : "";
+
+    // parse file, unless a cached RAM program makes the frontend redundant
     ErrorReport errReport(Global::config().has("no-warn"));
     DebugReport debugReport;
-    Own<ast::TranslationUnit> astTranslationUnit =
-            ParserDriver::parseTranslationUnit("<stdin>", in, errReport, debugReport);
+    Own<ast::TranslationUnit> astTranslationUnit;
+    if (ramCacheFile.empty() || !existFile(ramCacheFile)) {
+        astTranslationUnit = sourceBuffered
+                                     ? ParserDriver::parseTranslationUnit(source, errReport, debugReport)
+                                     : ParserDriver::parseTranslationUnit("<stdin>", in, errReport, debugReport);
+    }
 
     // close input pipe
     int preprocessor_status = pclose(in);
@@ -424,6 +879,26 @@ int main(int argc, char** argv) {
         throw std::runtime_error("failed to close pre-processor pipe");
     }
 
+    if (astTranslationUnit == nullptr) {
+        // a warm cache: restore the transformed program and interpret it
+        // right away; analyses are recomputed on demand from the program
+        std::ifstream cachedImage(ramCacheFile, std::ios::binary);
+        Own<ram::Program> cachedProgram = ram::deserialise(cachedImage);
+        if (cachedProgram == nullptr) {
+            // a stale or truncated entry is rebuilt through the full pipeline
+            astTranslationUnit = ParserDriver::parseTranslationUnit(source, errReport, debugReport);
+        } else {
+            if (Global::config().has("verbose")) {
+                std::cout << "Reusing cached RAM program <" << ramCacheFile << ">\n";
+            }
+            ram::TranslationUnit cachedRamTranslationUnit(std::move(cachedProgram), errReport, debugReport);
+            Own<interpreter::Engine> interpreter(mk<interpreter::Engine>(cachedRamTranslationUnit));
+            interpreter->executeMain();
+            completeIncrementalCheckpoint();
+            return 0;
+        }
+    }
+
     /* Report run-time of the parser if verbose flag is set */
     if (Global::config().has("verbose")) {
         auto parser_end = std::chrono::high_resolution_clock::now();
@@ -518,11 +993,12 @@ int main(int argc, char** argv) {
                     mk<ast::transform::RemoveRedundantRelationsTransformer>())),
             mk<ast::transform::RemoveRelationCopiesTransformer>(), std::move(partitionPipeline),
             std::move(equivalencePipeline), mk<ast::transform::RemoveRelationCopiesTransformer>(),
-            std::move(magicPipeline), mk<ast::transform::ReorderLiteralsTransformer>(),
+            mk<ast::transform::SharedBodyPrefixTransformer>(), std::move(magicPipeline), mk<ast::transform::ReorderLiteralsTransformer>(),
             mk<ast::transform::RemoveEmptyRelationsTransformer>(),
             mk<ast::transform::AddNullariesToAtomlessAggregatesTransformer>(),
             mk<ast::transform::ReorderLiteralsTransformer>(), mk<ast::transform::ExecutionPlanChecker>(),
-            std::move(provenancePipeline), mk<ast::transform::IOAttributesTransformer>());
+            std::move(provenancePipeline), mk<ast::transform::IncrementalCheckpointTransformer>(),
+            mk<ast::transform::IOAttributesTransformer>());
 
     // Disable unwanted transformations
     if (Global::config().has("disable-transformers")) {
@@ -601,7 +1077,27 @@ int main(int argc, char** argv) {
     }
 
     // bail if we've nothing else left to show
-    if (Global::config().has("show") && !hasShowOpt("initial-ram", "transformed-ram")) return 0;
+    if (Global::config().has("show") &&
+            !hasShowOpt("initial-ram", "partition-analysis", "query-plan", "transformed-ram")) {
+        return 0;
+    }
+
+    // Guard the incremental checkpoint against a changed program: warm
+    // starting from the fixpoint of different rules silently yields wrong
+    // (superset) results, so a stamp mismatch discards the marker and the
+    // semi-naive translator below takes the cold path.
+    if (Global::config().has("incremental-dir")) {
+        incrementalCheckpointStamp = incrementalCheckpointKey(*astTranslationUnit);
+        const std::string markerFile = Global::config().get("incremental-dir") + "/.complete";
+        if (existFile(markerFile)) {
+            std::ifstream marker(markerFile);
+            std::string stamp;
+            std::getline(marker, stamp);
+            if (stamp != incrementalCheckpointStamp) {
+                remove(markerFile.c_str());
+            }
+        }
+    }
 
     // ------- execution -------------
     /* translate AST to RAM */
@@ -617,26 +1113,40 @@ int main(int argc, char** argv) {
     if (hasShowOpt("initial-ram")) {
         std::cout << ramTranslationUnit->getProgram();
         // bail if we've nothing else left to show
-        if (!hasShowOpt("transformed-ram")) return 0;
+        if (!hasShowOpt("partition-analysis", "query-plan", "transformed-ram")) return 0;
     }
 
     // Apply RAM transforms
     {
         using namespace ram::transform;
-        Own<Transformer> ramTransform = mk<TransformerSequence>(
+        Own<Transformer> ramTransform = mk<TransformerSequence>(mk<FoldConstantsTransformer>(),
                 mk<LoopTransformer>(mk<TransformerSequence>(mk<ExpandFilterTransformer>(),
                         mk<HoistConditionsTransformer>(), mk<MakeIndexTransformer>())),
                 mk<IfConversionTransformer>(), mk<IfExistsConversionTransformer>(),
                 mk<CollapseFiltersTransformer>(), mk<TupleIdTransformer>(),
                 mk<LoopTransformer>(
-                        mk<TransformerSequence>(mk<HoistAggregateTransformer>(), mk<TupleIdTransformer>())),
+                        mk<TransformerSequence>(mk<HoistAggregateTransformer>(), mk<TupleIdTransformer>(),
+                                mk<HoistRecordUnpacksTransformer>(), mk<TupleIdTransformer>())),
                 mk<ExpandFilterTransformer>(), mk<HoistConditionsTransformer>(),
                 mk<CollapseFiltersTransformer>(), mk<EliminateDuplicatesTransformer>(),
                 mk<ReorderConditionsTransformer>(), mk<LoopTransformer>(mk<ReorderFilterBreak>()),
+                mk<ConditionalTransformer>(
+                        // releasing relations early is unsound whenever they are
+                        // read back after the main program: ad-hoc queries
+                        // (--query, --server) and embedders of generated code
+                        // access non-output relations once the run is complete
+                        []() -> bool {
+                            return !Global::config().has("query") && !Global::config().has("server") &&
+                                   !Global::config().has("compile") &&
+                                   !Global::config().has("dl-program") &&
+                                   !Global::config().has("generate") && !Global::config().has("swig");
+                        },
+                        mk<ReleaseRelationsTransformer>()),
                 mk<ConditionalTransformer>(
                         // job count of 0 means all cores are used.
                         []() -> bool { return std::stoi(Global::config().get("jobs")) != 1; },
-                        mk<ParallelTransformer>()),
+                        mk<TransformerSequence>(
+                                mk<ParallelizeSequencesTransformer>(), mk<ParallelTransformer>())),
                 mk<ReportIndexTransformer>());
 
         ramTransform->apply(*ramTranslationUnit);
@@ -646,6 +1156,40 @@ int main(int argc, char** argv) {
         std::cerr << ramTranslationUnit->getErrorReport();
     }
 
+    // store the transformed program for later interpreted runs
+    if (!ramCacheFile.empty() && ramTranslationUnit->getErrorReport().getNumErrors() == 0) {
+        const std::string cacheDir = Global::config().get("cache-dir");
+#ifndef _WIN32
+        if (!existDir(cacheDir)) {
+            mkdir(cacheDir.c_str(), 0777);
+        }
+#endif
+        // written to the side and moved into place, so that a concurrent
+        // run never observes a partial image
+        const std::string pending = ramCacheFile + ".part";
+        std::ofstream image(pending, std::ios::binary);
+        const bool written = ram::serialise(ramTranslationUnit->getProgram(), image) && image.good();
+        image.close();
+        if (!written || std::rename(pending.c_str(), ramCacheFile.c_str()) != 0) {
+            std::remove(pending.c_str());
+            std::cerr << "warning: unable to cache RAM program in <" << cacheDir << ">\n";
+        }
+    }
+
+    // Report whether all joins align on a partition key
+    if (hasShowOpt("partition-analysis")) {
+        ramTranslationUnit->getAnalysis<ram::analysis::PartitionAnalysis>().print(std::cout);
+        // bail if we've nothing else left to show
+        if (!hasShowOpt("query-plan", "transformed-ram")) return 0;
+    }
+
+    // Output the query plans of the transformed RAM program in JSON format
+    if (hasShowOpt("query-plan")) {
+        ram::printQueryPlan(*ramTranslationUnit, std::cout);
+        // bail if we've nothing else left to show
+        if (!hasShowOpt("transformed-ram")) return 0;
+    }
+
     // Output the transformed RAM program and return
     if (hasShowOpt("transformed-ram")) {
         std::cout << ramTranslationUnit->getProgram();
@@ -662,6 +1206,22 @@ int main(int argc, char** argv) {
     const bool must_compile = must_execute || compile_mode;
 
     try {
+        if (must_interpret && Global::config().has("hybrid")) {
+            // ------- hybrid: interpret now, compile concurrently -------------
+#ifndef _WIN32
+            // the interactive modes need the in-process engine to survive
+            // the evaluation, so they stay purely interpreted
+            if (!Global::config().has("server") && !Global::config().has("provenance") &&
+                    !Global::config().has("live-profile") && !Global::config().has("query")) {
+                executeHybridAndExit(*ramTranslationUnit, souffleExecutable);
+            }
+            std::cerr << "warning: hybrid execution is incompatible with interactive modes; "
+                         "falling back to the interpreter\n";
+#else
+            std::cerr << "warning: hybrid execution is not supported on this platform; "
+                         "falling back to the interpreter\n";
+#endif
+        }
         if (must_interpret) {
             // ------- interpreter -------------
 
@@ -674,10 +1234,16 @@ int main(int argc, char** argv) {
             // configure and execute interpreter
             Own<interpreter::Engine> interpreter(mk<interpreter::Engine>(*ramTranslationUnit));
             interpreter->executeMain();
+            completeIncrementalCheckpoint();
             // If the profiler was started, join back here once it exits.
             if (profiler.joinable()) {
                 profiler.join();
             }
+            if (Global::config().has("server")) {
+                // keep serving the evaluated program over a socket
+                interpreter::ProgInterface interface(*interpreter);
+                serveProgram(interface, Global::config().get("server"));
+            }
             if (Global::config().has("provenance")) {
                 // only run explain interface if interpreted
                 interpreter::ProgInterface interface(*interpreter);
@@ -687,6 +1253,11 @@ int main(int argc, char** argv) {
                     explain(interface, true);
                 }
             }
+            if (Global::config().has("query")) {
+                // serve ad-hoc queries against the still-loaded relations
+                interpreter::ProgInterface interface(*interpreter);
+                QueryShell(interface).run();
+            }
         } else {
             // ------- compiler -------------
             // int jobs = std::stoi(Global::config().get("jobs"));
@@ -716,6 +1287,26 @@ int main(int argc, char** argv) {
             std::string baseIdentifier = identifier(simpleName(baseFilename));
             std::string sourceFilename = baseFilename + ".cpp";
 
+            // with an enabled cache, a rerun of an unchanged program reuses
+            // the previously compiled binary and skips synthesis entirely
+            std::string cachedBinary;
+            if (must_compile && Global::config().has("cache-dir") && !Global::config().has("swig")) {
+                cachedBinary = Global::config().get("cache-dir") + "/souffle-" +
+                               binaryCacheKey(*ramTranslationUnit);
+                if (isExecutable(cachedBinary)) {
+                    if (Global::config().has("verbose")) {
+                        std::cout << "Reusing cached binary <" << cachedBinary << ">\n";
+                    }
+                    if (!copyBinaryFile(cachedBinary, baseFilename)) {
+                        throw std::runtime_error("failed to restore cached binary <" + cachedBinary + ">");
+                    }
+                    if (must_execute) {
+                        executeBinaryAndExit(baseFilename);
+                    }
+                    return 0;
+                }
+            }
+
             bool withSharedLibrary;
             auto synthesisStart = std::chrono::high_resolution_clock::now();
             const bool emitToStdOut = Global::config().has("generate", "-");
@@ -754,6 +1345,19 @@ int main(int argc, char** argv) {
                     std::cout << "Compilation time: " << std::chrono::duration<double>(t_end - t_bgn).count()
                               << "sec\n";
                 }
+
+                // store the fresh binary for later runs
+                if (!cachedBinary.empty()) {
+                    const std::string cacheDir = Global::config().get("cache-dir");
+#ifndef _WIN32
+                    if (!existDir(cacheDir)) {
+                        mkdir(cacheDir.c_str(), 0777);
+                    }
+#endif
+                    if (!copyBinaryFile(baseFilename, cachedBinary)) {
+                        std::cerr << "warning: unable to cache binary in <" << cacheDir << ">\n";
+                    }
+                }
             }
 
             // run compiled C++ program if requested.
@@ -36,7 +36,10 @@
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/tinyformat.h"
+#include <cstddef>
+#include <cstdio>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -44,7 +47,6 @@ using YY_BUFFER_STATE = struct yy_buffer_state*;
 extern YY_BUFFER_STATE yy_scan_string(const char*, yyscan_t scanner);
 extern int yylex_destroy(yyscan_t scanner);
 extern int yylex_init_extra(ScannerInfo* data, yyscan_t* scanner);
-extern void yyset_in(FILE* in_str, yyscan_t scanner);
 
 namespace souffle {
 
@@ -55,7 +57,18 @@ Own<ast::TranslationUnit> ParserDriver::parse(
     ScannerInfo data;
     data.yyfilename = filename;
     yylex_init_extra(&data, &scanner);
-    yyset_in(in, scanner);
+
+    // Slurp the whole stream up front and lex from one contiguous in-memory
+    // buffer. The input arrives through the pre-processor pipe, and lexing it
+    // in flex's small stdio blocks stalls the lexer on the pipe for large
+    // machine-generated inputs.
+    std::string code;
+    char chunk[1 << 16];
+    std::size_t bytes;
+    while ((bytes = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        code.append(chunk, bytes);
+    }
+    yy_scan_string(code.c_str(), scanner);
 
     yy::parser parser(*this, scanner);
     parser.parse();
@@ -218,8 +231,8 @@ Own<ast::Counter> ParserDriver::addDeprecatedCounter(SrcLocation tagLoc) {
 
 std::set<RelationTag> ParserDriver::addReprTag(
         RelationTag tag, SrcLocation tagLoc, std::set<RelationTag> tags) {
-    return addTag(tag, {RelationTag::BTREE, RelationTag::BRIE, RelationTag::EQREL}, std::move(tagLoc),
-            std::move(tags));
+    return addTag(tag, {RelationTag::BTREE, RelationTag::BRIE, RelationTag::EQREL, RelationTag::INTERVAL},
+            std::move(tagLoc), std::move(tags));
 }
 
 std::set<RelationTag> ParserDriver::addTag(RelationTag tag, SrcLocation tagLoc, std::set<RelationTag> tags) {
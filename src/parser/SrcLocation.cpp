@@ -20,17 +20,20 @@
 #include <cstdio>
 #include <fstream>
 #include <limits>
+#include <map>
+#include <memory>
 #include <sstream>
 
 namespace souffle {
 
-std::string getCurrentFilename(const std::vector<std::string>& filenames) {
+std::string getCurrentFilename(const std::vector<std::shared_ptr<const std::string>>& filenames) {
     if (filenames.empty()) {
         return "";
     }
 
     std::string path = ".";
-    for (std::string filename : filenames) {
+    for (const auto& filenamePtr : filenames) {
+        const std::string& filename = *filenamePtr;
         if (!filename.empty() && filename[0] == '/') {
             path = dirName(filename);
         } else if (existFile(path + "/" + filename)) {
@@ -42,7 +45,7 @@ std::string getCurrentFilename(const std::vector<std::string>& filenames) {
         }
     }
 
-    return path + "/" + baseName(filenames.back());
+    return path + "/" + baseName(*filenames.back());
 }
 
 bool SrcLocation::operator<(const SrcLocation& other) const {
@@ -70,18 +73,26 @@ bool SrcLocation::operator<(const SrcLocation& other) const {
 }
 
 void SrcLocation::setFilename(std::string filename) {
+    // hand out one shared instance per distinct file name; only the scanner
+    // calls this, so the intern table needs no synchronisation
+    static std::map<std::string, std::shared_ptr<const std::string>> interned;
+    auto& entry = interned[filename];
+    if (entry == nullptr) {
+        entry = std::make_shared<const std::string>(filename);
+    }
+
     if (filenames.empty()) {
-        filenames.emplace_back(filename);
+        filenames.push_back(entry);
         return;
     }
-    if (filenames.back() == filename) {
+    if (*filenames.back() == filename) {
         return;
     }
-    if (filenames.size() > 1 && filenames.at(filenames.size() - 2) == filename) {
+    if (filenames.size() > 1 && *filenames.at(filenames.size() - 2) == filename) {
         filenames.pop_back();
         return;
     }
-    filenames.emplace_back(filename);
+    filenames.push_back(entry);
 }
 
 std::string SrcLocation::extloc() const {
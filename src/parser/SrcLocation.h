@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include <memory>
 #include <ostream>
 #include <string>
 #include <vector>
@@ -53,8 +54,11 @@ public:
         }
     };
 
-    /** The file referred to */
-    std::vector<std::string> filenames;
+    /** The file referred to: an include stack of interned file names. Every
+     * AST node embeds a source location and clones copy it, so the stack
+     * shares one string instance per distinct file instead of copying the
+     * paths by value. */
+    std::vector<std::shared_ptr<const std::string>> filenames;
 
     /** The start location */
     Point start = {};
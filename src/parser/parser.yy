@@ -65,6 +65,7 @@
     #include "ast/Relation.h"
     #include "ast/StringConstant.h"
     #include "ast/SubsetType.h"
+    #include "ast/SubsumptiveClause.h"
     #include "ast/AliasType.h"
     #include "ast/AlgebraicDataType.h"
     #include "ast/BranchType.h"
@@ -132,6 +133,7 @@
 %token BRIE_QUALIFIER            "BRIE datastructure qualifier"
 %token BTREE_QUALIFIER           "BTREE datastructure qualifier"
 %token EQREL_QUALIFIER           "equivalence relation qualifier"
+%token INTERVAL_QUALIFIER        "interval datastructure qualifier"
 %token OVERRIDABLE_QUALIFIER     "relation qualifier overidable"
 %token INLINE_QUALIFIER          "relation qualifier inline"
 %token NO_INLINE_QUALIFIER       "relation qualifier no_inline"
@@ -149,6 +151,7 @@
 %token MIN                       "min aggregator"
 %token MAX                       "max aggregator"
 %token COUNT                     "count aggregator"
+%token COUNTD                    "countd aggregator"
 %token SUM                       "sum aggregator"
 %token TRUE                      "true literal constraint"
 %token FALSE                     "false literal constraint"
@@ -569,6 +572,10 @@ relation_tags
     {
       $$ = driver.addReprTag(RelationTag::EQREL, @2, $1);
     }
+  | relation_tags INTERVAL_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::INTERVAL, @2, $1);
+    }
   /* Deprecated Qualifiers */
   | relation_tags OUTPUT_QUALIFIER
     {
@@ -669,6 +676,21 @@ rule
         rule->setExecutionPlan(clone(query_plan));
       }
     }
+  | atom[dominated] LE atom[dominating] IF body DOT
+    {
+      auto dominated = $dominated;
+      auto dominating = $dominating;
+      auto bodies = $body->toClauseBodies();
+      for (auto&& body : bodies) {
+        VecOwn<ast::Literal> literals;
+        literals.push_back(clone(dominated));
+        literals.push_back(clone(dominating));
+        for (auto&& literal : body->getBodyLiterals()) {
+          literals.push_back(clone(literal));
+        }
+        $$.push_back(mk<ast::SubsumptiveClause>(clone(dominated), std::move(literals), nullptr, @$));
+      }
+    }
   ;
 
 /**
@@ -918,6 +940,7 @@ arg
       auto agg_2_func = [](AggregateOp op) -> char const* {
         switch (op) {
           case AggregateOp::COUNT : return {};
+          case AggregateOp::COUNTD: return {};
           case AggregateOp::MAX   : return "max";
           case AggregateOp::MEAN  : return {};
           case AggregateOp::MIN   : return "min";
@@ -1081,6 +1104,10 @@ aggregate_func
     {
       $$ = AggregateOp::COUNT;
     }
+  | COUNTD
+    {
+      $$ = AggregateOp::COUNTD;
+    }
   | MAX
     {
       $$ = AggregateOp::MAX;
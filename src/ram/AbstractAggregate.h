@@ -84,6 +84,7 @@ protected:
             case AggregateOp::FSUM:
             case AggregateOp::USUM: os << "sum "; break;
             case AggregateOp::COUNT: os << "count "; break;
+            case AggregateOp::COUNTD: os << "countd "; break;
             case AggregateOp::MEAN: os << "mean "; break;
         }
         if (function != AggregateOp::COUNT) {
@@ -19,6 +19,8 @@
 #include <cassert>
 #include <functional>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <typeinfo>
 #include <utility>
 #include <vector>
@@ -39,6 +41,12 @@ void Node::rewrite(const Node* oldNode, Own<Node> newNode) {
     });
 }
 
+std::size_t Node::getStructuralHash() const {
+    std::ostringstream buffer;
+    print(buffer);
+    return std::hash<std::string>{}(buffer.str());
+}
+
 Node::ConstChildNodes Node::getChildNodes() const {
     return ConstChildNodes(getChildren(), detail::RefCaster());
 }
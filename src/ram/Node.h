@@ -21,6 +21,7 @@
 #include "souffle/utility/Types.h"
 #include "souffle/utility/VisitorFwd.h"
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <iostream>
 #include <memory>
@@ -76,6 +77,18 @@ public:
         return !(*this == other);
     }
 
+    /**
+     * @brief Compute a structural fingerprint of this node
+     *
+     * The fingerprint is derived from the canonical printed form, hence equal
+     * nodes yield equal fingerprints and differing fingerprints prove
+     * inequality. It serves as a cheap pre-filter in front of the deep equal()
+     * machinery wherever many subtrees are compared against each other;
+     * callers memoise it per subtree, as nodes carry no parent links through
+     * which an on-node cache could be invalidated on mutation.
+     */
+    std::size_t getStructuralHash() const;
+
     /** @brief Create a clone (i.e. deep copy) of this node as a smart-pointer */
     Own<Node> cloneImpl() const {
         return Own<Node>(cloning());
@@ -18,6 +18,7 @@
 
 #include "ram/Node.h"
 #include "ram/Relation.h"
+#include "ram/Sequence.h"
 #include "ram/Statement.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
@@ -83,6 +84,12 @@ public:
         return *subroutines.at(name);
     }
 
+    /** @brief Replace a subroutine's body by an empty sequence, releasing its subtree.
+     * Used by the interpreter to free a stratum's IR once its single run is over. */
+    void releaseSubroutine(const std::string& name) {
+        subroutines.at(name) = mk<Sequence>();
+    }
+
     Program* cloning() const override {
         auto* res = new Program();
         res->main = clone(main);
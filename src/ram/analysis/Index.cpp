@@ -18,7 +18,10 @@
 #include "Global.h"
 #include "RelationTag.h"
 #include "ram/Expression.h"
+#include "ram/IndexAggregate.h"
+#include "ram/Loop.h"
 #include "ram/Node.h"
+#include "ram/TupleElement.h"
 #include "ram/Program.h"
 #include "ram/Relation.h"
 #include "ram/Swap.h"
@@ -30,6 +33,7 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <queue>
@@ -219,16 +223,14 @@ const MaxMatching::Matchings& MaxMatching::solve() {
     return match;
 }
 
-IndexCluster MinIndexSelectionStrategy::solve(const SearchSet& searches) const {
-    OrderCollection orders;
-    SignatureOrderMap indexSelection;
-
+IndexCluster MinIndexSelectionStrategy::solve(const SearchSet& searches, const SearchWeightMap& weights) const {
     // If there are no orders then the arity of the relation is zero
     // this is because every non-nullary relation has an existence check
     if (searches.empty()) {
         auto search = SearchSignature::getFullSearchSignature(0);
         LexOrder emptyOrder;
-        orders.push_back(emptyOrder);
+        OrderCollection orders = {emptyOrder};
+        SignatureOrderMap indexSelection;
         indexSelection.insert({search, emptyOrder});
         return IndexCluster(indexSelection, {search}, orders);
     }
@@ -264,6 +266,14 @@ IndexCluster MinIndexSelectionStrategy::solve(const SearchSet& searches) const {
 
     // Should never get no chains back as we never call calculate on an empty graph
     assert(!chains.empty());
+    return clusterFromChains(chains, searches, weights);
+}
+
+IndexCluster MinIndexSelectionStrategy::clusterFromChains(
+        const ChainOrderMap& chains, const SearchSet& searches, const SearchWeightMap& weights) const {
+    OrderCollection orders;
+    SignatureOrderMap indexSelection;
+
     for (const auto& chain : chains) {
         std::vector<uint32_t> ids;
 
@@ -307,13 +317,171 @@ IndexCluster MinIndexSelectionStrategy::solve(const SearchSet& searches) const {
         }
     }
 
+    // Discharge cold chains: an order maintained only for searches outside
+    // the fixpoint loops may be dropped if each of its searches is served
+    // exactly by a prefix of one of the remaining orders, saving the index
+    // maintenance on every insert at the price of a one-off larger scan
+    auto weightOf = [&](const SearchSignature& search) -> std::size_t {
+        auto it = weights.find(search);
+        return it == weights.end() ? 0 : it->second;
+    };
+    const auto fullSignature = SearchSignature::getFullSearchSignature(searches.begin()->arity());
+    std::vector<bool> retained(chains.size(), true);
+    SignatureOrderMap remapped;
+    for (std::size_t c = 0; c < chains.size(); c++) {
+        const auto& chain = chains[c];
+
+        // the chain holding the full-order search backs the master index
+        if (std::find(chain.begin(), chain.end(), fullSignature) != chain.end()) {
+            continue;
+        }
+
+        // only chains never searched inside a loop are worth dropping
+        bool cold = std::all_of(chain.begin(), chain.end(),
+                [&](const SearchSignature& search) { return weightOf(search) == 0; });
+        if (!cold) {
+            continue;
+        }
+
+        // every search of the chain must be served by another retained order
+        SignatureOrderMap candidates;
+        bool servable = true;
+        for (const auto& search : chain) {
+            bool found = false;
+            for (std::size_t o = 0; o < orders.size(); o++) {
+                if (o == c || !retained[o]) {
+                    continue;
+                }
+                if (isServedByPrefix(search, orders[o])) {
+                    candidates.insert({search, orders[o]});
+                    found = true;
+                    break;
+                }
+            }
+            if (!found) {
+                servable = false;
+                break;
+            }
+        }
+        if (!servable) {
+            continue;
+        }
+
+        retained[c] = false;
+        remapped.insert(candidates.begin(), candidates.end());
+    }
+
     // Return the index selection
     for (const auto& search : searches) {
-        std::size_t orderIndex = map(search, orders, chains);
-        indexSelection.insert({search, orders.at(orderIndex)});
+        auto it = remapped.find(search);
+        if (it != remapped.end()) {
+            indexSelection.insert({search, it->second});
+        } else {
+            std::size_t orderIndex = map(search, orders, chains);
+            indexSelection.insert({search, orders.at(orderIndex)});
+        }
     }
 
-    return IndexCluster(indexSelection, searches, orders);
+    OrderCollection retainedOrders;
+    for (std::size_t c = 0; c < orders.size(); c++) {
+        if (retained[c]) {
+            retainedOrders.push_back(orders[c]);
+        }
+    }
+
+    return IndexCluster(indexSelection, searches, retainedOrders);
+}
+
+IndexCluster ScalableIndexSelectionStrategy::solve(
+        const SearchSet& searches, const SearchWeightMap& weights) const {
+    // small search sets are still solved exactly
+    if (searches.size() <= exactSolveLimit) {
+        return MinIndexSelectionStrategy::solve(searches, weights);
+    }
+    return clusterFromChains(greedyChainCover(searches, weights), searches, weights);
+}
+
+ChainOrderMap ScalableIndexSelectionStrategy::greedyChainCover(
+        const SearchSet& searches, const SearchWeightMap& weights) const {
+    auto cardinality = [](const SearchSignature& search) {
+        return static_cast<std::size_t>(std::count_if(
+                search.begin(), search.end(), [](auto c) { return c != AttributeConstraint::None; }));
+    };
+    auto weightOf = [&](const SearchSignature& search) -> std::size_t {
+        auto it = weights.find(search);
+        return it == weights.end() ? 0 : it->second;
+    };
+
+    // bucket the searches into levels of equal constraint cardinality;
+    // a chain can only ever grow from one level into a higher one
+    std::map<std::size_t, SearchCollection> levels;
+    for (const auto& search : searches) {
+        levels[cardinality(search)].push_back(search);
+    }
+
+    ChainOrderMap chains;
+    for (auto& level : levels) {
+        // hot searches claim their chains first, so that cold signatures are
+        // merged onto the orders shaped by the hot ones rather than vice versa
+        std::stable_sort(
+                level.second.begin(), level.second.end(), [&](const SearchSignature& a,
+                                                                  const SearchSignature& b) {
+                    return weightOf(a) > weightOf(b);
+                });
+        for (const auto& search : level.second) {
+            // best fit: extend the chain with the tightest extendable tail,
+            // keeping the deltas - and thus the resulting lex-orders - short
+            std::size_t best = chains.size();
+            std::size_t bestCardinality = 0;
+            for (std::size_t c = 0; c < chains.size(); ++c) {
+                const std::size_t tailCardinality = cardinality(chains[c].back());
+                if ((best == chains.size() || tailCardinality > bestCardinality) &&
+                        chains[c].back().precedes(search)) {
+                    best = c;
+                    bestCardinality = tailCardinality;
+                }
+            }
+            if (best == chains.size()) {
+                chains.push_back({search});
+            } else {
+                chains[best].push_back(search);
+            }
+        }
+    }
+    return chains;
+}
+
+bool MinIndexSelectionStrategy::isServedByPrefix(const SearchSignature& search, const LexOrder& order) const {
+    // collect the constrained columns of the search
+    std::vector<AttributeIndex> equalities;
+    std::vector<AttributeIndex> inequalities;
+    for (std::size_t i = 0; i < search.arity(); i++) {
+        if (search[i] == AttributeConstraint::Equal) {
+            equalities.push_back(i);
+        } else if (search[i] == AttributeConstraint::Inequal) {
+            inequalities.push_back(i);
+        }
+    }
+    if (equalities.size() + inequalities.size() > order.size()) {
+        return false;
+    }
+
+    // the equality columns must form the first part of the order, in any
+    // permutation
+    for (std::size_t i = 0; i < equalities.size(); i++) {
+        if (std::find(equalities.begin(), equalities.end(), order[i]) == equalities.end()) {
+            return false;
+        }
+    }
+
+    // the inequality columns must follow immediately, in the ascending order
+    // a dedicated index would use, so that the scanned range is identical
+    for (std::size_t i = 0; i < inequalities.size(); i++) {
+        if (order[equalities.size() + i] != inequalities[i]) {
+            return false;
+        }
+    }
+    return true;
 }
 
 Chain MinIndexSelectionStrategy::getChain(const SearchSignature umn, const MaxMatching::Matchings& match,
@@ -391,18 +559,36 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
     // 0-arity relation in a provenance program still need to be revisited.
     // visit all nodes to collect searches of each relation
 
-    // visit all nodes to collect searches of each relation
-    visit(translationUnit.getProgram(), [&](const Node& node) {
+    // visit all nodes to collect searches of each relation, weighting each
+    // search by the loop depth of the deepest operation performing it:
+    // searches inside the fixpoint loops run once per iteration while
+    // top-level searches run only once
+    std::function<void(const Node&, std::size_t)> collectSearches = [&](const Node& node,
+                                                                            std::size_t loopDepth) {
+        auto addSearch = [&](const std::string& relation, const SearchSignature& signature) {
+            relationToSearches[relation].insert(signature);
+            auto& weight = relationToWeights[relation][signature];
+            weight = std::max(weight, loopDepth);
+        };
+
         if (const auto* indexSearch = as<IndexOperation>(node)) {
-            relationToSearches[indexSearch->getRelation()].insert(getSearchSignature(indexSearch));
+            addSearch(indexSearch->getRelation(), getSearchSignature(indexSearch));
         } else if (const auto* exists = as<ExistenceCheck>(node)) {
-            relationToSearches[exists->getRelation()].insert(getSearchSignature(exists));
+            addSearch(exists->getRelation(), getSearchSignature(exists));
         } else if (const auto* provExists = as<ProvenanceExistenceCheck>(node)) {
-            relationToSearches[provExists->getRelation()].insert(getSearchSignature(provExists));
+            addSearch(provExists->getRelation(), getSearchSignature(provExists));
         } else if (const auto* ramRel = as<Relation>(node)) {
-            relationToSearches[ramRel->getName()].insert(getSearchSignature(ramRel));
+            addSearch(ramRel->getName(), getSearchSignature(ramRel));
         }
-    });
+
+        if (isA<Loop>(node)) {
+            loopDepth++;
+        }
+        for (const Node& child : node.getChildNodes()) {
+            collectSearches(child, loopDepth);
+        }
+    };
+    collectSearches(translationUnit.getProgram(), 0);
 
     // A swap happen between rel A and rel B indicates A should include all indices of B, vice versa.
     visit(translationUnit.getProgram(), [&](const Swap& swap) {
@@ -420,6 +606,18 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
 
         relationToSearches[relA].insert(searchesB.begin(), searchesB.end());
         relationToSearches[relB].insert(searchesA.begin(), searchesA.end());
+
+        // merge the search weights accordingly
+        const auto weightsA = relationToWeights[relA];
+        const auto weightsB = relationToWeights[relB];
+        for (const auto& [signature, weight] : weightsB) {
+            auto& merged = relationToWeights[relA][signature];
+            merged = std::max(merged, weight);
+        }
+        for (const auto& [signature, weight] : weightsA) {
+            auto& merged = relationToWeights[relB][signature];
+            merged = std::max(merged, weight);
+        }
     });
 
     // remove all empty searches
@@ -438,7 +636,7 @@ void IndexAnalysis::run(const TranslationUnit& translationUnit) {
     for (auto& relToSearch : relationToSearches) {
         const std::string& relation = relToSearch.first;
         auto& searches = relToSearch.second;
-        indexCover.insert({relation, solver->solve(searches)});
+        indexCover.insert({relation, solver->solve(searches, relationToWeights[relation])});
     }
 }
 
@@ -506,6 +704,23 @@ SearchSignature IndexAnalysis::getSearchSignature(const IndexOperation* search)
             keys[i] = AttributeConstraint::Inequal;
         }
     }
+
+    // a min/max aggregate over one of the scanned attributes prefers an
+    // order that sorts the matching range by that attribute: mark it like
+    // an inequality column, so the chosen order places it directly after
+    // the equality prefix and the extrema sit at the range endpoints
+    if (const auto* aggregate = as<IndexAggregate>(search)) {
+        const auto fn = aggregate->getFunction();
+        if (fn == AggregateOp::MIN || fn == AggregateOp::MAX) {
+            if (const auto* element = as<TupleElement>(&aggregate->getExpression())) {
+                const std::size_t i = element->getElement();
+                if (element->getTupleId() == aggregate->getTupleId() && i < arity &&
+                        keys[i] == AttributeConstraint::None) {
+                    keys[i] = AttributeConstraint::Inequal;
+                }
+            }
+        }
+    }
     return keys;
 }
 
@@ -311,6 +311,7 @@ using SearchCollection = std::vector<SearchSignature>;
 using Chain = std::vector<SearchSignature>;
 using ChainOrderMap = std::vector<Chain>;
 using SignatureOrderMap = std::unordered_map<SearchSignature, LexOrder, SearchSignature::Hasher>;
+using SearchWeightMap = std::unordered_map<SearchSignature, std::size_t, SearchSignature::Hasher>;
 
 class SearchComparator {
 public:
@@ -371,15 +372,30 @@ public:
     virtual ~IndexSelectionStrategy() = default;
 
     /** @brief Run analysis for a RAM translation unit */
-    virtual IndexCluster solve(const SearchSet& searches) const = 0;
+    IndexCluster solve(const SearchSet& searches) const;
+
+    /**
+     * @brief Run analysis for a RAM translation unit, weighting each search
+     * by the frequency at which it is expected to be performed
+     */
+    virtual IndexCluster solve(const SearchSet& searches, const SearchWeightMap& weights) const = 0;
 };
 
 class MinIndexSelectionStrategy : public IndexSelectionStrategy {
 public:
+    using IndexSelectionStrategy::solve;
+
     /** @Brief map the keys in the key set to lexicographical order */
-    IndexCluster solve(const SearchSet& searches) const override;
+    IndexCluster solve(const SearchSet& searches, const SearchWeightMap& weights) const override;
 
 protected:
+    /**
+     * @Brief check whether a search is served exactly by a prefix of the
+     * given lexicographical order, i.e. whether scanning the order yields
+     * the same range as a dedicated index for the search
+     */
+    bool isServedByPrefix(const SearchSignature& search, const LexOrder& order) const;
+
     /** @Brief maps a provided search to its corresponding lexicographical ordering **/
     std::size_t map(SearchSignature cols, [[maybe_unused]] const OrderCollection& orders,
             const ChainOrderMap& chainToOrder) const {
@@ -440,6 +456,42 @@ protected:
         }
         return unmatched;
     }
+
+    /**
+     * @Brief turn a chain cover into the final index selection, i.e. build
+     * the lex-order of every chain, discharge cold orders and map each
+     * search to its order
+     */
+    IndexCluster clusterFromChains(
+            const ChainOrderMap& chains, const SearchSet& searches, const SearchWeightMap& weights) const;
+};
+
+/**
+ * @class ScalableIndexSelectionStrategy
+ * @Brief approximates the minimal index cover for relations with many searches
+ *
+ * The exact strategy solves Dilworth's problem via a maximum matching over
+ * all pairs of searches, which grows prohibitive for relations accumulating
+ * dozens of distinct search signatures. This strategy hands small search sets
+ * to the exact solver and otherwise covers the searches greedily: they are
+ * bucketed into levels by their number of constrained attributes and, hottest
+ * first, appended to the chain with the tightest extendable tail. For
+ * equality-only searches each level is an antichain and thus a lower bound on
+ * the optimal cover, so the greedy cover exceeds the optimum by at most a
+ * factor of the number of levels (bounded by the relation's arity plus one).
+ */
+class ScalableIndexSelectionStrategy : public MinIndexSelectionStrategy {
+public:
+    using IndexSelectionStrategy::solve;
+
+    /** @Brief largest search set still handed to the exact Dilworth solver */
+    static constexpr std::size_t exactSolveLimit = 24;
+
+    IndexCluster solve(const SearchSet& searches, const SearchWeightMap& weights) const override;
+
+protected:
+    /** @Brief greedily cover the searches with chains, level by level */
+    ChainOrderMap greedyChainCover(const SearchSet& searches, const SearchWeightMap& weights) const;
 };
 
 /**
@@ -478,13 +530,17 @@ private:
     OrderCollection orders;
 };
 
+inline IndexCluster IndexSelectionStrategy::solve(const SearchSet& searches) const {
+    return solve(searches, SearchWeightMap());
+}
+
 /**
  * @class RamIndexAnalyis
  * @Brief Analysis pass computing the index sets of RAM relations
  */
 class IndexAnalysis : public Analysis {
 public:
-    IndexAnalysis() : Analysis(name), relAnalysis(nullptr), solver(mk<MinIndexSelectionStrategy>()) {}
+    IndexAnalysis() : Analysis(name), relAnalysis(nullptr), solver(mk<ScalableIndexSelectionStrategy>()) {}
 
     static constexpr const char* name = "index-analysis";
 
@@ -543,6 +599,12 @@ private:
     Own<IndexSelectionStrategy> solver;
     std::map<std::string, IndexCluster> indexCover;
     std::map<std::string, SearchSet> relationToSearches;
+
+    /**
+     * frequency weight of each search, given by the loop depth of the
+     * deepest RAM operation performing it
+     */
+    std::map<std::string, SearchWeightMap> relationToWeights;
 };
 
 }  // namespace souffle::ram::analysis
@@ -22,6 +22,7 @@
 #include "ram/Conjunction.h"
 #include "ram/Constraint.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Expression.h"
 #include "ram/False.h"
@@ -173,6 +174,15 @@ int LevelAnalysis::getLevel(const Node* node) const {
             return level;
         }
 
+        // erase
+        int visit_(type_identity<Erase>, const Erase& erase) override {
+            int level = -1;
+            for (auto& exp : erase.getValues()) {
+                level = std::max(level, dispatch(*exp));
+            }
+            return level;
+        }
+
         // return
         int visit_(type_identity<SubroutineReturn>, const SubroutineReturn& ret) override {
             int level = -1;
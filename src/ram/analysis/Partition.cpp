@@ -0,0 +1,242 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Partition.cpp
+ *
+ * Implements the partition-alignment analysis over the RAM program.
+ *
+ ***********************************************************************/
+
+#include "ram/analysis/Partition.h"
+#include "ram/AbstractAggregate.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/AbstractIfExists.h"
+#include "ram/Condition.h"
+#include "ram/Constraint.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/Expression.h"
+#include "ram/Filter.h"
+#include "ram/IndexOperation.h"
+#include "ram/Insert.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/TupleElement.h"
+#include "ram/analysis/Relation.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/utility/MiscUtil.h"
+#include <set>
+#include <vector>
+
+namespace souffle::ram::analysis {
+
+namespace {
+
+/**
+ * Walks the operation tree of one query, tracking the set of tuples whose
+ * first attribute is tied to the partition key of the outermost iteration.
+ */
+class AlignmentChecker {
+public:
+    AlignmentChecker(const RelationAnalysis& ra) : ra(ra) {}
+
+    bool isAligned() const {
+        return aligned;
+    }
+
+    const std::string& getReason() const {
+        return reason;
+    }
+
+    void descend(const Operation& op) {
+        if (const auto* indexOp = as<IndexOperation>(op)) {
+            checkIndexedAccess(*indexOp);
+        } else if (const auto* relOp = as<RelationOperation>(op)) {
+            checkFreeAccess(*relOp);
+        }
+
+        if (const auto* aggregate = as<AbstractAggregate, AllowCrossCast>(op)) {
+            const auto* relOp = as<RelationOperation>(op);
+            if (ra.lookup(relOp->getRelation()).getArity() != 0) {
+                fail("aggregate over " + relOp->getRelation() + " requires cross-partition combination");
+            }
+            checkCondition(aggregate->getCondition());
+        }
+        if (const auto* filter = as<Filter>(op)) {
+            checkCondition(filter->getCondition());
+        }
+        if (const auto* ifExists = as<AbstractIfExists, AllowCrossCast>(op)) {
+            checkCondition(ifExists->getCondition());
+        }
+        if (const auto* insert = as<Insert>(op)) {
+            checkWrite(insert->getRelation(), insert->getValues());
+        }
+        if (const auto* erase = as<Erase>(op)) {
+            checkWrite(erase->getRelation(), erase->getValues());
+        }
+
+        for (const Node& child : op.getChildNodes()) {
+            if (const auto* nested = as<Operation>(child)) {
+                descend(*nested);
+            }
+        }
+    }
+
+private:
+    /** @brief whether the expression is the first attribute of an anchored tuple */
+    bool isAnchoredKey(const Expression* expr) const {
+        const auto* element = as<TupleElement>(expr);
+        return element != nullptr && element->getElement() == 0 &&
+               anchored.count(element->getTupleId()) != 0;
+    }
+
+    /** @brief whether the expression depends on any tuple at all */
+    static bool isGrounded(const Expression* expr) {
+        return !visitExists(*expr, [](const TupleElement&) { return true; });
+    }
+
+    void fail(const std::string& why) {
+        if (aligned) {
+            aligned = false;
+            reason = why;
+        }
+    }
+
+    void checkIndexedAccess(const IndexOperation& indexOp) {
+        if (ra.lookup(indexOp.getRelation()).getArity() == 0) {
+            return;
+        }
+        const auto& pattern = indexOp.getRangePattern();
+        const Expression* lower = pattern.first[0];
+        const Expression* upper = pattern.second[0];
+        if (anchored.empty()) {
+            // the outermost iteration defines the partition the query works on
+            anchored.insert(indexOp.getTupleId());
+            return;
+        }
+        if (*lower == *upper && isAnchoredKey(lower)) {
+            anchored.insert(indexOp.getTupleId());
+            return;
+        }
+        fail("join on " + indexOp.getRelation() + " is not keyed by the partition attribute");
+    }
+
+    void checkFreeAccess(const RelationOperation& relOp) {
+        if (ra.lookup(relOp.getRelation()).getArity() == 0) {
+            return;
+        }
+        if (anchored.empty()) {
+            anchored.insert(relOp.getTupleId());
+            return;
+        }
+        fail("free iteration of " + relOp.getRelation() + " below the outer loop");
+    }
+
+    void checkCondition(const Condition& condition) {
+        // attribute-0 equalities propagate the anchor between tuples
+        visit(condition, [&](const Constraint& constraint) {
+            if (constraint.getOperator() != BinaryConstraintOp::EQ) {
+                return;
+            }
+            const auto* lhs = as<TupleElement>(constraint.getLHS());
+            const auto* rhs = as<TupleElement>(constraint.getRHS());
+            if (lhs == nullptr || rhs == nullptr || lhs->getElement() != 0 || rhs->getElement() != 0) {
+                return;
+            }
+            if (anchored.count(lhs->getTupleId()) != 0) {
+                anchored.insert(rhs->getTupleId());
+            }
+            if (anchored.count(rhs->getTupleId()) != 0) {
+                anchored.insert(lhs->getTupleId());
+            }
+        });
+        visit(condition, [&](const AbstractExistenceCheck& check) {
+            if (ra.lookup(check.getRelation()).getArity() == 0) {
+                return;
+            }
+            const Expression* key = check.getValues()[0];
+            if (!isAnchoredKey(key) && !(anchored.empty() && isGrounded(key))) {
+                fail("existence check on " + check.getRelation() +
+                        " is not keyed by the partition attribute");
+            }
+        });
+        visit(condition, [&](const EmptinessCheck& check) {
+            if (ra.lookup(check.getRelation()).getArity() != 0) {
+                fail("emptiness check on " + check.getRelation() + " is a cross-partition predicate");
+            }
+        });
+    }
+
+    void checkWrite(const std::string& relation, const std::vector<Expression*>& values) {
+        if (values.empty()) {
+            return;
+        }
+        const Expression* key = values[0];
+        // a fully grounded tuple can be routed to its owning partition; a
+        // derived tuple must take its key from the partition being worked on
+        if (isAnchoredKey(key) || isGrounded(key)) {
+            return;
+        }
+        fail("tuple written to " + relation + " does not keep the partition attribute");
+    }
+
+    const RelationAnalysis& ra;
+    std::set<int> anchored;
+    bool aligned = true;
+    std::string reason;
+};
+
+}  // namespace
+
+PartitionAnalysis::QueryResult PartitionAnalysis::analyseQuery(const Query& query) const {
+    AlignmentChecker checker(*ra);
+    checker.descend(query.getOperation());
+
+    QueryResult result;
+    result.aligned = checker.isAligned();
+    result.reason = checker.getReason();
+
+    // identify the query by the relation it feeds
+    result.location = "<no write>";
+    visit(query, [&](const Insert& insert) {
+        if (result.location == "<no write>") {
+            result.location = insert.getRelation();
+        }
+    });
+    return result;
+}
+
+void PartitionAnalysis::run(const TranslationUnit& tUnit) {
+    ra = &tUnit.getAnalysis<RelationAnalysis>();
+    visit(tUnit.getProgram().getMain(), [&](const Query& query) {
+        QueryResult result = analyseQuery(query);
+        partitionable = partitionable && result.aligned;
+        queryResults.push_back(std::move(result));
+    });
+}
+
+void PartitionAnalysis::print(std::ostream& os) const {
+    os << "program is hash-partitionable by the first attribute: " << (partitionable ? "true" : "false")
+       << "\n";
+    for (const auto& result : queryResults) {
+        os << "  " << (result.aligned ? "aligned     " : "not aligned ") << result.location;
+        if (!result.aligned) {
+            os << " (" << result.reason << ")";
+        }
+        os << "\n";
+    }
+}
+
+}  // namespace souffle::ram::analysis
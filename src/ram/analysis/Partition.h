@@ -0,0 +1,75 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Partition.h
+ *
+ * Determines whether a RAM program can be evaluated on horizontal
+ * partitions of its relations, hash-partitioned by their first attribute.
+ * A program qualifies when every query keeps all relation accesses on one
+ * partition: joins and existence checks must constrain the first column of
+ * each accessed relation with either a constant or the first column of
+ * another access in the same query, and every inserted tuple must take its
+ * first column from such an access. Partition-parallel (and eventually
+ * distributed) evaluation is only sound for qualifying programs, since no
+ * rule then combines tuples living on different partitions.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Relation.h"
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace souffle::ram {
+class Query;
+}
+
+namespace souffle::ram::analysis {
+
+/**
+ * @class PartitionAnalysis
+ * @brief A Ram Analysis checking alignment of all joins on a partition key
+ */
+class PartitionAnalysis : public Analysis {
+public:
+    PartitionAnalysis() : Analysis(name) {}
+
+    static constexpr const char* name = "partition-analysis";
+
+    void run(const TranslationUnit& tUnit) override;
+
+    void print(std::ostream& os) const override;
+
+    /** @brief whether every query of the program is partition-aligned */
+    bool isPartitionable() const {
+        return partitionable;
+    }
+
+private:
+    /** verdict for a single query */
+    struct QueryResult {
+        std::string location;
+        bool aligned;
+        std::string reason;
+    };
+
+    /** @brief analyse one query; returns its verdict */
+    QueryResult analyseQuery(const Query& query) const;
+
+    std::vector<QueryResult> queryResults;
+    bool partitionable = true;
+    RelationAnalysis* ra{nullptr};
+};
+
+}  // namespace souffle::ram::analysis
@@ -36,6 +36,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/Operation.h"
 #include "ram/Parallel.h"
@@ -107,6 +108,21 @@ TEST(Extend, CloneAndEquals) {
     delete c;
 }
 
+TEST(Merge, CloneAndEquals) {
+    // MERGE B WITH A
+    Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
+    Relation B("B", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
+    Merge a("B", "A");
+    Merge b("B", "A");
+    EXPECT_EQ(a, b);
+    EXPECT_NE(&a, &b);
+
+    Merge* c = a.cloning();
+    EXPECT_EQ(a, *c);
+    EXPECT_NE(&a, c);
+    delete c;
+}
+
 TEST(Swap, CloneAndEquals) {
     // SWAP(A,B)
     Relation A("A", 1, 1, {"x"}, {"i"}, RelationRepresentation::DEFAULT);
@@ -21,10 +21,12 @@
 #include "ram/utility/NodeMapper.h"
 #include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
+#include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include <cstddef>
 #include <functional>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace souffle::ram::transform {
@@ -36,20 +38,25 @@ bool EliminateDuplicatesTransformer::eliminateDuplicates(Program& program) {
             const Condition* condition = &filter->getCondition();
             VecOwn<Condition> conds = toConjunctionList(condition);
             bool eliminatedDuplicate = false;
-            // TODO: This is O(n^2). Make PR for O(n) variant.
-            for (std::size_t i = 0; i < conds.size(); i++) {
-                for (std::size_t j = i + 1; j < conds.size(); j++) {
-                    if (*conds[i] == *conds[j]) {
-                        conds.erase(conds.begin() + j);
-                        i = -1;
-                        eliminatedDuplicate = true;
-                        break;
-                    }
+            // keep the first occurrence of each condition; the memoised
+            // structural hashes confine deep equality checks to colliding
+            // buckets, avoiding a quadratic number of subtree walks
+            VecOwn<Condition> uniqueConds;
+            std::unordered_map<std::size_t, std::vector<const Condition*>> seen;
+            for (auto& cond : conds) {
+                auto& bucket = seen[cond->getStructuralHash()];
+                const bool duplicate =
+                        any_of(bucket, [&](const Condition* other) { return *other == *cond; });
+                if (duplicate) {
+                    eliminatedDuplicate = true;
+                    continue;
                 }
+                bucket.push_back(cond.get());
+                uniqueConds.push_back(std::move(cond));
             }
             if (eliminatedDuplicate) {
                 changed = true;
-                node = mk<Filter>(Own<Condition>(toCondition(conds)), clone(filter->getOperation()));
+                node = mk<Filter>(Own<Condition>(toCondition(uniqueConds)), clone(filter->getOperation()));
             }
         }
 
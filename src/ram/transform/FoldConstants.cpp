@@ -0,0 +1,275 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file FoldConstants.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/FoldConstants.h"
+#include "FunctorOps.h"
+#include "ram/Expression.h"
+#include "ram/FloatConstant.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/Node.h"
+#include "ram/NumericConstant.h"
+#include "ram/Program.h"
+#include "ram/SignedConstant.h"
+#include "ram/UnsignedConstant.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+namespace {
+
+/** The shift operators only consume the low bits of their right operand,
+ * mirroring the evaluation in the interpreter and the synthesised code. */
+constexpr RamUnsigned ShiftMask = RAM_DOMAIN_SIZE - 1;
+
+/** @brief Return the exponent k with v == 2^k, or -1 if v is not a power of two */
+int powerOfTwoExponent(RamUnsigned v) {
+    if (v == 0 || (v & (v - 1)) != 0) {
+        return -1;
+    }
+    int k = 0;
+    while ((v >>= 1) != 0) {
+        ++k;
+    }
+    return k;
+}
+
+/** @brief Evaluate an intrinsic operator whose operands are all numeric
+ * constants, or return nullptr when the operator is outside the folded subset.
+ *
+ * The arithmetic mirrors the interpreter's evaluation case for case; string
+ * functors, exponentiation and the range generators are not folded. Division
+ * and modulus are only folded when the divisor is non-zero so that the
+ * run-time behaviour of a division by zero is preserved. */
+Own<Expression> foldOperator(const IntrinsicOperator& op) {
+    std::vector<RamDomain> vals;
+    for (const Expression* arg : op.getArguments()) {
+        const auto* constant = as<NumericConstant>(arg);
+        if (constant == nullptr) {
+            return nullptr;
+        }
+        vals.push_back(constant->getConstant());
+    }
+
+    auto s = [&](std::size_t i) { return ramBitCast<RamSigned>(vals[i]); };
+    auto u = [&](std::size_t i) { return ramBitCast<RamUnsigned>(vals[i]); };
+    auto f = [&](std::size_t i) { return ramBitCast<RamFloat>(vals[i]); };
+    auto mkSigned = [](RamSigned v) -> Own<Expression> { return mk<SignedConstant>(v); };
+    auto mkUnsigned = [](RamUnsigned v) -> Own<Expression> { return mk<UnsignedConstant>(v); };
+    auto mkFloat = [](RamFloat v) -> Own<Expression> { return mk<FloatConstant>(v); };
+
+// clang-format off
+#define FOLD_BINARY_INTEGRAL(opcode, binop)                                            \
+    case FunctorOp::   opcode: return mkSigned  (static_cast<RamSigned>(s(0) binop s(1)));   \
+    case FunctorOp::U##opcode: return mkUnsigned(static_cast<RamUnsigned>(u(0) binop u(1)));
+#define FOLD_BINARY_NUMERIC(opcode, binop)     \
+    FOLD_BINARY_INTEGRAL(opcode, binop)        \
+    case FunctorOp::F##opcode: return mkFloat(static_cast<RamFloat>(f(0) binop f(1)));
+#define FOLD_MINMAX_NUMERIC(opcode, fn)                                                       \
+    case FunctorOp::opcode: {                                                                 \
+        RamSigned result = s(0);                                                              \
+        for (std::size_t i = 1; i < vals.size(); i++) result = fn(result, s(i));              \
+        return mkSigned(result);                                                              \
+    }                                                                                         \
+    case FunctorOp::U##opcode: {                                                              \
+        RamUnsigned result = u(0);                                                            \
+        for (std::size_t i = 1; i < vals.size(); i++) result = fn(result, u(i));              \
+        return mkUnsigned(result);                                                            \
+    }                                                                                         \
+    case FunctorOp::F##opcode: {                                                              \
+        RamFloat result = f(0);                                                               \
+        for (std::size_t i = 1; i < vals.size(); i++) result = fn(result, f(i));              \
+        return mkFloat(result);                                                               \
+    }
+    // clang-format on
+
+    switch (op.getOperator()) {
+        /** Unary Functor Operators */
+        case FunctorOp::NEG: return mkSigned(-s(0));
+        case FunctorOp::FNEG: return mkFloat(-f(0));
+        case FunctorOp::BNOT: return mkSigned(~s(0));
+        case FunctorOp::UBNOT: return mkUnsigned(~u(0));
+        case FunctorOp::LNOT: return mkSigned(static_cast<RamSigned>(!s(0)));
+        case FunctorOp::ULNOT: return mkUnsigned(static_cast<RamUnsigned>(!u(0)));
+
+        /** Numeric coercions; the string-valued ones stay with the evaluator */
+        case FunctorOp::F2F:
+        case FunctorOp::I2I:
+        case FunctorOp::U2U: return clone(op.getArguments()[0]);
+        case FunctorOp::F2I: return mkSigned(static_cast<RamSigned>(f(0)));
+        case FunctorOp::F2U: return mkUnsigned(static_cast<RamUnsigned>(f(0)));
+        case FunctorOp::I2F: return mkFloat(static_cast<RamFloat>(s(0)));
+        case FunctorOp::I2U: return mkUnsigned(static_cast<RamUnsigned>(s(0)));
+        case FunctorOp::U2F: return mkFloat(static_cast<RamFloat>(u(0)));
+        case FunctorOp::U2I: return mkSigned(static_cast<RamSigned>(u(0)));
+
+            /** Binary Functor Operators */
+            // clang-format off
+        FOLD_BINARY_NUMERIC(ADD, +)
+        FOLD_BINARY_NUMERIC(SUB, -)
+        FOLD_BINARY_NUMERIC(MUL, *)
+        FOLD_BINARY_INTEGRAL(BAND, &)
+        FOLD_BINARY_INTEGRAL(BOR, |)
+        FOLD_BINARY_INTEGRAL(BXOR, ^)
+        FOLD_BINARY_INTEGRAL(LAND, &&)
+        FOLD_BINARY_INTEGRAL(LOR, ||)
+        FOLD_MINMAX_NUMERIC(MAX, std::max)
+        FOLD_MINMAX_NUMERIC(MIN, std::min)
+            // clang-format on
+
+        case FunctorOp::DIV: return s(1) == 0 ? nullptr : mkSigned(s(0) / s(1));
+        case FunctorOp::UDIV: return u(1) == 0 ? nullptr : mkUnsigned(u(0) / u(1));
+        case FunctorOp::FDIV: return mkFloat(f(0) / f(1));
+        case FunctorOp::MOD: return s(1) == 0 ? nullptr : mkSigned(s(0) % s(1));
+        case FunctorOp::UMOD: return u(1) == 0 ? nullptr : mkUnsigned(u(0) % u(1));
+
+        case FunctorOp::LXOR: return mkSigned(static_cast<RamSigned>((s(0) != 0) != (s(1) != 0)));
+        case FunctorOp::ULXOR: return mkUnsigned(static_cast<RamUnsigned>((u(0) != 0) != (u(1) != 0)));
+
+        /** Left shifts are computed on the unsigned representation, as in the evaluator */
+        case FunctorOp::BSHIFT_L: return mkSigned(ramBitCast<RamSigned>(u(0) << (u(1) & ShiftMask)));
+        case FunctorOp::UBSHIFT_L: return mkUnsigned(u(0) << (u(1) & ShiftMask));
+        case FunctorOp::BSHIFT_R: return mkSigned(s(0) >> (u(1) & ShiftMask));
+        case FunctorOp::UBSHIFT_R: return mkUnsigned(u(0) >> (u(1) & ShiftMask));
+        case FunctorOp::BSHIFT_R_UNSIGNED:
+            return mkSigned(ramBitCast<RamSigned>(u(0) >> (u(1) & ShiftMask)));
+        case FunctorOp::UBSHIFT_R_UNSIGNED: return mkUnsigned(u(0) >> (u(1) & ShiftMask));
+
+        default: return nullptr;
+    }
+
+#undef FOLD_BINARY_INTEGRAL
+#undef FOLD_BINARY_NUMERIC
+#undef FOLD_MINMAX_NUMERIC
+}
+
+/** @brief Rewrite an operator with a power-of-two constant operand into a
+ * cheaper equivalent, or return nullptr when no reduction applies.
+ *
+ * Multiplications become left shifts and unsigned division/modulus become a
+ * right shift and a bit mask; the results agree bit for bit with the original
+ * operator. Signed division rounds towards zero while an arithmetic right
+ * shift rounds towards negative infinity, so for signed division and modulus
+ * only the trivial divisor of one is simplified. */
+Own<Expression> reduceStrength(const IntrinsicOperator& op) {
+    const auto& args = op.getArguments();
+    if (args.size() != 2) {
+        return nullptr;
+    }
+
+    switch (op.getOperator()) {
+        case FunctorOp::MUL:
+        case FunctorOp::UMUL: {
+            for (std::size_t i = 0; i < 2; i++) {
+                const auto* constant = as<NumericConstant>(args[i]);
+                if (constant == nullptr) {
+                    continue;
+                }
+                const RamUnsigned factor = ramBitCast<RamUnsigned>(constant->getConstant());
+                if (factor == 1) {
+                    return clone(args[1 - i]);
+                }
+                const int k = powerOfTwoExponent(factor);
+                if (k < 0) {
+                    continue;
+                }
+                const bool isUnsigned = op.getOperator() == FunctorOp::UMUL;
+                VecOwn<Expression> shiftArgs;
+                shiftArgs.emplace_back(args[1 - i]->cloning());
+                if (isUnsigned) {
+                    shiftArgs.emplace_back(mk<UnsignedConstant>(static_cast<RamUnsigned>(k)));
+                    return mk<IntrinsicOperator>(FunctorOp::UBSHIFT_L, std::move(shiftArgs));
+                }
+                shiftArgs.emplace_back(mk<SignedConstant>(static_cast<RamSigned>(k)));
+                return mk<IntrinsicOperator>(FunctorOp::BSHIFT_L, std::move(shiftArgs));
+            }
+            return nullptr;
+        }
+        case FunctorOp::UDIV: {
+            const auto* constant = as<NumericConstant>(args[1]);
+            if (constant == nullptr) {
+                return nullptr;
+            }
+            const RamUnsigned divisor = ramBitCast<RamUnsigned>(constant->getConstant());
+            if (divisor == 1) {
+                return clone(args[0]);
+            }
+            const int k = powerOfTwoExponent(divisor);
+            if (k < 0) {
+                return nullptr;
+            }
+            VecOwn<Expression> shiftArgs;
+            shiftArgs.emplace_back(args[0]->cloning());
+            shiftArgs.emplace_back(mk<UnsignedConstant>(static_cast<RamUnsigned>(k)));
+            return mk<IntrinsicOperator>(FunctorOp::UBSHIFT_R, std::move(shiftArgs));
+        }
+        case FunctorOp::UMOD: {
+            const auto* constant = as<NumericConstant>(args[1]);
+            if (constant == nullptr) {
+                return nullptr;
+            }
+            const RamUnsigned divisor = ramBitCast<RamUnsigned>(constant->getConstant());
+            if (divisor == 1) {
+                return mk<UnsignedConstant>(static_cast<RamUnsigned>(0));
+            }
+            if (powerOfTwoExponent(divisor) < 0) {
+                return nullptr;
+            }
+            VecOwn<Expression> maskArgs;
+            maskArgs.emplace_back(args[0]->cloning());
+            maskArgs.emplace_back(mk<UnsignedConstant>(divisor - 1));
+            return mk<IntrinsicOperator>(FunctorOp::UBAND, std::move(maskArgs));
+        }
+        case FunctorOp::DIV: {
+            const auto* constant = as<NumericConstant>(args[1]);
+            if (constant != nullptr && constant->getConstant() == 1) {
+                return clone(args[0]);
+            }
+            return nullptr;
+        }
+        default: return nullptr;
+    }
+}
+
+}  // namespace
+
+bool FoldConstantsTransformer::foldConstants(Program& program) {
+    bool changed = false;
+    forEachQueryMap(program, [&](auto&& go, Own<Node> node) -> Own<Node> {
+        // rewrite the operands first so that constants propagate upwards
+        node->apply(go);
+
+        if (const IntrinsicOperator* op = as<IntrinsicOperator>(node)) {
+            if (auto folded = foldOperator(*op)) {
+                changed = true;
+                return folded;
+            }
+            if (auto reduced = reduceStrength(*op)) {
+                changed = true;
+                return reduced;
+            }
+        }
+        return node;
+    });
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
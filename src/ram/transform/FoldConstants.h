@@ -0,0 +1,66 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file FoldConstants.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class FoldConstantsTransformer
+ * @brief Evaluates intrinsic operators with constant operands at translation
+ * time and strength-reduces multiplications and unsigned divisions by
+ * powers of two into shifts and masks.
+ *
+ * For example ..
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  INSERT ((t0.0*8)+(2+3)) INTO A
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  INSERT ((t0.0 bshl 3)+5) INTO A
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Folding covers numeric and logical operators whose semantics are fixed at
+ * translation time; string functors, exponentiation and the range generators
+ * are left alone. Signed division keeps its rounding-towards-zero semantics,
+ * so only a divisor of one is simplified there.
+ */
+class FoldConstantsTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "FoldConstantsTransformer";
+    }
+
+    /**
+     * @brief Fold constant expressions and strength-reduce power-of-two arithmetic
+     * @param program Program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool foldConstants(Program& program);
+
+protected:
+    bool transform(TranslationUnit& translationUnit) override {
+        return foldConstants(translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
@@ -13,12 +13,19 @@
  ***********************************************************************/
 
 #include "ram/transform/HoistConditions.h"
+#include "ram/AbstractIfExists.h"
 #include "ram/Condition.h"
+#include "ram/IfExists.h"
+#include "ram/IndexIfExists.h"
 #include "ram/Node.h"
 #include "ram/Operation.h"
+#include "ram/ParallelIfExists.h"
+#include "ram/ParallelIndexIfExists.h"
 #include "ram/Program.h"
 #include "ram/Statement.h"
+#include "ram/True.h"
 #include "ram/utility/NodeMapper.h"
+#include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/utility/MiscUtil.h"
 #include <functional>
@@ -96,6 +103,70 @@ bool HoistConditionsTransformer::hoistConditions(Program& program) {
                     mk<Filter>(std::move(newCondition), clone(search.getOperation())));
         }
     });
+
+    // hoist loop-invariant conjuncts out of if-exists conditions: a conjunct
+    // that does not refer to the tuple searched for is re-evaluated for every
+    // candidate tuple of the search, but can be checked once before it instead
+    forEachQuery(program, [&](Query& query) {
+        query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+            node->apply(go);
+
+            const Condition* searchCondition = nullptr;
+            const auto* tupleOp = as<TupleOperation>(node);
+            if (const auto* op = as<IfExists>(node)) {
+                searchCondition = &op->getCondition();
+            } else if (const auto* op = as<IndexIfExists>(node)) {
+                searchCondition = &op->getCondition();
+            }
+            if (searchCondition == nullptr || tupleOp == nullptr) {
+                return node;
+            }
+
+            // split the condition into tuple-dependent and invariant conjuncts
+            Own<Condition> dependent;
+            Own<Condition> invariant;
+            for (auto& term : toConjunctionList(searchCondition)) {
+                if (isTrue(term.get())) {
+                    continue;
+                }
+                if (rla->getLevel(term.get()) == tupleOp->getTupleId()) {
+                    dependent = addCondition(std::move(dependent), std::move(term));
+                } else {
+                    invariant = addCondition(std::move(invariant), std::move(term));
+                }
+            }
+            if (invariant == nullptr) {
+                return node;
+            }
+            if (dependent == nullptr) {
+                dependent = mk<True>();
+            }
+
+            // rebuild the search with the dependent conjuncts only
+            Own<Operation> replacement;
+            if (const auto* op = as<ParallelIndexIfExists>(node)) {
+                RamPattern pattern(clone(op->getRangePattern().first), clone(op->getRangePattern().second));
+                replacement = mk<ParallelIndexIfExists>(op->getRelation(), op->getTupleId(),
+                        std::move(dependent), std::move(pattern), clone(op->getOperation()),
+                        op->getProfileText());
+            } else if (const auto* op = as<IndexIfExists>(node)) {
+                RamPattern pattern(clone(op->getRangePattern().first), clone(op->getRangePattern().second));
+                replacement = mk<IndexIfExists>(op->getRelation(), op->getTupleId(), std::move(dependent),
+                        std::move(pattern), clone(op->getOperation()), op->getProfileText());
+            } else if (const auto* op = as<ParallelIfExists>(node)) {
+                replacement = mk<ParallelIfExists>(op->getRelation(), op->getTupleId(), std::move(dependent),
+                        clone(op->getOperation()), op->getProfileText());
+            } else if (const auto* op = as<IfExists>(node)) {
+                replacement = mk<IfExists>(op->getRelation(), op->getTupleId(), std::move(dependent),
+                        clone(op->getOperation()), op->getProfileText());
+            } else {
+                return node;
+            }
+
+            changed = true;
+            return mk<Filter>(std::move(invariant), std::move(replacement));
+        }));
+    });
     return changed;
 }
 
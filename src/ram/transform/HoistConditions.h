@@ -77,6 +77,11 @@ public:
      * TupleOperation operations. The second type are independent of
      * tuple access. Both types of conditions will be hoisted to
      * the most out-scope such that the program is still valid.
+     *
+     * In addition, conjuncts of if-exists conditions that do not
+     * depend on the tuple searched for are extracted into a filter
+     * preceding the search, so that they are evaluated once rather
+     * than for every candidate tuple.
      */
     bool hoistConditions(Program& program);
 
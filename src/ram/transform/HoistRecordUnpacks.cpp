@@ -0,0 +1,124 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HoistRecordUnpacks.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/HoistRecordUnpacks.h"
+#include "ram/Break.h"
+#include "ram/Filter.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/Program.h"
+#include "ram/Statement.h"
+#include "ram/UnpackRecord.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include <cassert>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+bool HoistRecordUnpacksTransformer::hoistRecordUnpacks(Program& program) {
+    bool changed = false;
+
+    // There are two cases: unpacks whose argument has no data-dependency
+    // on other RAM operations, and unpacks whose argument is bound by a
+    // prior operation. A rewriter has two tasks: (1) identify a single
+    // unpack that can be hoisted and (2) insert it at its binding level.
+    // We assume all operations are renumbered for this transformation.
+    // Filters and breaks are barriers in both cases: they may guard the
+    // lookup against nil or otherwise invalid record references, so an
+    // unpack is never moved above them.
+
+    // hoist a single data-independent unpack to the outermost scope
+    forEachQuery(program, [&](Query& query) {
+        Own<UnpackRecord> newUnpack;
+        bool priorTupleOp = false;
+        bool priorGuard = false;
+        query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+            if (auto* unpack = as<UnpackRecord>(node)) {
+                // only hoist when there is a loop to escape from;
+                // an unpack already at the top stays where it is
+                if (newUnpack == nullptr && priorTupleOp && !priorGuard &&
+                        rla->getLevel(unpack) == -1) {
+                    changed = true;
+                    newUnpack = clone(unpack);
+                    return clone(unpack->getOperation());
+                }
+            } else if (isA<TupleOperation>(node)) {
+                priorTupleOp = true;
+            } else if (as<Filter>(node) != nullptr || as<Break>(node) != nullptr) {
+                priorGuard = true;
+            }
+
+            node->apply(go);
+            return node;
+        }));
+
+        if (newUnpack != nullptr) {
+            newUnpack->rewrite(&newUnpack->getOperation(), clone(query.getOperation()));
+            query.rewrite(&query.getOperation(), std::move(newUnpack));
+        }
+    });
+
+    // hoist a single unpack to the level where its record argument is bound
+    forEachQuery(program, [&](Query& query) {
+        int newLevel = -1;
+        Own<UnpackRecord> newUnpack;
+        int priorOpLevel = -1;
+        int enclosingLevel = -1;
+        int barrierLevel = -1;
+
+        query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+            if (auto* unpack = as<UnpackRecord>(node)) {
+                int dataDepLevel = rla->getLevel(unpack);
+                if (newUnpack == nullptr && dataDepLevel != -1 &&
+                        dataDepLevel < unpack->getTupleId() - 1 && dataDepLevel > barrierLevel) {
+                    // If all tuple ops between the data-dependence level and
+                    // the unpack are unpacks, then we do not hoist, i.e., we
+                    // would continuously swap their positions.
+                    if (dataDepLevel != priorOpLevel) {
+                        changed = true;
+                        newLevel = dataDepLevel;
+                        newUnpack = clone(unpack);
+                        return clone(unpack->getOperation());
+                    }
+                }
+                enclosingLevel = unpack->getTupleId();
+            } else if (const TupleOperation* tupleOp = as<TupleOperation>(node)) {
+                priorOpLevel = tupleOp->getTupleId();
+                enclosingLevel = tupleOp->getTupleId();
+            } else if (as<Filter>(node) != nullptr || as<Break>(node) != nullptr) {
+                // hoisting stops below the innermost operation enclosing a guard
+                barrierLevel = std::max(barrierLevel, enclosingLevel);
+            }
+
+            node->apply(go);
+
+            if (auto* search = as<TupleOperation>(node)) {
+                if (newUnpack != nullptr && search->getTupleId() == newLevel) {
+                    newUnpack->rewrite(&newUnpack->getOperation(), clone(search->getOperation()));
+                    search->rewrite(&search->getOperation(), std::move(newUnpack));
+                }
+            }
+
+            return node;
+        }));
+    });
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
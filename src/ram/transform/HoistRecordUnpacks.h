@@ -0,0 +1,61 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HoistRecordUnpacks.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/analysis/Level.h"
+#include "ram/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class HoistRecordUnpacksTransformer
+ * @brief Pushes record unpacks up to the level binding their argument
+ *
+ * A record lookup whose argument tuple is bound in an outer loop is
+ * re-evaluated for every iteration of the loops nested in between.
+ * This transformer moves such an UnpackRecord operation up to the
+ * operation binding its argument, so the record table is consulted
+ * once per binding instead of once per inner iteration. Unpacks are
+ * never moved above a filter or break, as those may guard the lookup
+ * against nil or otherwise invalid record references.
+ *
+ */
+class HoistRecordUnpacksTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "HoistRecordUnpacksTransformer";
+    }
+
+    /**
+     * @brief Apply hoistRecordUnpacks to the whole program
+     * @param RAM program
+     * @result A flag indicating whether the RAM program has been changed.
+     *
+     * Pushes an UnpackRecord up the loop nest if possible
+     */
+    bool hoistRecordUnpacks(Program& program);
+
+protected:
+    analysis::LevelAnalysis* rla{nullptr};
+    bool transform(TranslationUnit& translationUnit) override {
+        rla = &translationUnit.getAnalysis<analysis::LevelAnalysis>();
+        return hoistRecordUnpacks(translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
@@ -13,6 +13,7 @@
  ***********************************************************************/
 
 #include "ram/transform/Parallel.h"
+#include "Global.h"
 #include "ram/Condition.h"
 #include "ram/Expression.h"
 #include "ram/Node.h"
@@ -22,8 +23,12 @@
 #include "ram/Statement.h"
 #include "ram/utility/NodeMapper.h"
 #include "ram/utility/Visitor.h"
+#include "souffle/profile/ProgramRun.h"
+#include "souffle/profile/Reader.h"
+#include "souffle/profile/Relation.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
 
 #include <functional>
 #include <memory>
@@ -32,6 +37,26 @@
 
 namespace souffle::ram::transform {
 
+bool ParallelTransformer::keepSerial(const std::string& relationName) {
+    if (!Global::config().has("profile-use")) {
+        return false;
+    }
+    if (!profileLoaded) {
+        // the profile database has already been primed from the supplied log
+        // by the profile-use analysis; assemble the program run from it once
+        profileLoaded = true;
+        profiledRun = std::make_shared<profile::ProgramRun>(profile::ProgramRun());
+        profile::Reader(profiledRun).processFile();
+    }
+
+    // the profile records source relation names; strip the staging prefixes
+    const std::string baseName = stripPrefix("@new_",
+            stripPrefix("@delta_", stripPrefix("@prev_", stripPrefix("@load_", stripPrefix("@subsumed_",
+                                                                 stripPrefix("@info_", relationName))))));
+    const auto* profiledRelation = profiledRun->getRelation(baseName);
+    return profiledRelation != nullptr && profiledRelation->size() < MinParallelSize;
+}
+
 bool ParallelTransformer::parallelizeOperations(Program& program) {
     bool changed = false;
 
@@ -44,7 +69,7 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
         query.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
             if (const Scan* scan = as<Scan>(node)) {
                 const Relation& rel = relAnalysis->lookup(scan->getRelation());
-                if (scan->getTupleId() == 0 && rel.getArity() > 0) {
+                if (scan->getTupleId() == 0 && rel.getArity() > 0 && !keepSerial(scan->getRelation())) {
                     if (!isA<Insert>(&scan->getOperation())) {
                         changed = true;
                         return mk<ParallelScan>(scan->getRelation(), scan->getTupleId(),
@@ -52,14 +77,14 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
                     }
                 }
             } else if (const IfExists* ifexists = as<IfExists>(node)) {
-                if (ifexists->getTupleId() == 0) {
+                if (ifexists->getTupleId() == 0 && !keepSerial(ifexists->getRelation())) {
                     changed = true;
                     return mk<ParallelIfExists>(ifexists->getRelation(), ifexists->getTupleId(),
                             clone(ifexists->getCondition()), clone(ifexists->getOperation()),
                             ifexists->getProfileText());
                 }
             } else if (const IndexScan* indexScan = as<IndexScan>(node)) {
-                if (indexScan->getTupleId() == 0) {
+                if (indexScan->getTupleId() == 0 && !keepSerial(indexScan->getRelation())) {
                     changed = true;
                     RamPattern queryPattern = clone(indexScan->getRangePattern());
                     return mk<ParallelIndexScan>(indexScan->getRelation(), indexScan->getTupleId(),
@@ -67,7 +92,7 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
                             indexScan->getProfileText());
                 }
             } else if (const IndexIfExists* indexIfExists = as<IndexIfExists>(node)) {
-                if (indexIfExists->getTupleId() == 0) {
+                if (indexIfExists->getTupleId() == 0 && !keepSerial(indexIfExists->getRelation())) {
                     changed = true;
                     RamPattern queryPattern = clone(indexIfExists->getRangePattern());
                     return mk<ParallelIndexIfExists>(indexIfExists->getRelation(),
@@ -77,7 +102,8 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
                 }
             } else if (const Aggregate* aggregate = as<Aggregate>(node)) {
                 const Relation& rel = relAnalysis->lookup(aggregate->getRelation());
-                if (aggregate->getTupleId() == 0 && !rel.isNullary()) {
+                if (aggregate->getTupleId() == 0 && !rel.isNullary() &&
+                        !keepSerial(aggregate->getRelation())) {
                     changed = true;
                     return mk<ParallelAggregate>(clone(aggregate->getOperation()), aggregate->getFunction(),
                             aggregate->getRelation(), clone(aggregate->getExpression()),
@@ -85,7 +111,8 @@ bool ParallelTransformer::parallelizeOperations(Program& program) {
                 }
             } else if (const IndexAggregate* indexAggregate = as<IndexAggregate>(node)) {
                 const Relation& rel = relAnalysis->lookup(indexAggregate->getRelation());
-                if (indexAggregate->getTupleId() == 0 && !rel.isNullary()) {
+                if (indexAggregate->getTupleId() == 0 && !rel.isNullary() &&
+                        !keepSerial(indexAggregate->getRelation())) {
                     changed = true;
                     RamPattern queryPattern = clone(indexAggregate->getRangePattern());
                     return mk<ParallelIndexAggregate>(clone(indexAggregate->getOperation()),
@@ -18,8 +18,14 @@
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Relation.h"
 #include "ram/transform/Transformer.h"
+#include <cstddef>
+#include <memory>
 #include <string>
 
+namespace souffle::profile {
+class ProgramRun;
+}
+
 namespace souffle::ram::transform {
 
 /**
@@ -62,6 +68,20 @@ protected:
         return parallelizeOperations(translationUnit.getProgram());
     }
     analysis::RelationAnalysis* relAnalysis{nullptr};
+
+private:
+    /** relations profiled below this size are iterated serially */
+    static constexpr std::size_t MinParallelSize = 1024;
+
+    /**
+     * @brief Whether a profile of a previous run reports the relation as too
+     * small for the fork/join overhead of a parallel iteration to pay off
+     */
+    bool keepSerial(const std::string& relationName);
+
+    /** profiled relation sizes, loaded lazily from the supplied profile */
+    bool profileLoaded = false;
+    std::shared_ptr<profile::ProgramRun> profiledRun;
 };
 
 }  // namespace souffle::ram::transform
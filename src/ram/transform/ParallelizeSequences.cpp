@@ -0,0 +1,152 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ParallelizeSequences.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/ParallelizeSequences.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/Call.h"
+#include "ram/Clear.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Exit.h"
+#include "ram/Extend.h"
+#include "ram/IO.h"
+#include "ram/Insert.h"
+#include "ram/LogRelationTimer.h"
+#include "ram/LogSize.h"
+#include "ram/Merge.h"
+#include "ram/Node.h"
+#include "ram/Parallel.h"
+#include "ram/Program.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
+#include "ram/Sequence.h"
+#include "ram/Statement.h"
+#include "ram/SubroutineReturn.h"
+#include "ram/Swap.h"
+#include "ram/utility/NodeMapper.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+namespace {
+
+/** The relation footprint of a statement. */
+struct AccessSets {
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+    /** Statements with side effects beyond relation contents stay serial. */
+    bool parallelizable = true;
+};
+
+AccessSets collectAccessSets(const Statement& stmt) {
+    AccessSets sets;
+    visit(stmt, [&](const Insert& insert) { sets.writes.insert(insert.getRelation()); });
+    visit(stmt, [&](const Clear& clear) { sets.writes.insert(clear.getRelation()); });
+    visit(stmt, [&](const Merge& merge) {
+        sets.reads.insert(merge.getSourceRelation());
+        sets.writes.insert(merge.getTargetRelation());
+    });
+    visit(stmt, [&](const RelationOperation& op) { sets.reads.insert(op.getRelation()); });
+    visit(stmt, [&](const AbstractExistenceCheck& exists) { sets.reads.insert(exists.getRelation()); });
+    visit(stmt, [&](const EmptinessCheck& empty) { sets.reads.insert(empty.getRelation()); });
+    visit(stmt, [&](const RelationSize& size) { sets.reads.insert(size.getRelation()); });
+    visit(stmt, [&](const LogRelationTimer& timer) { sets.reads.insert(timer.getRelation()); });
+    visit(stmt, [&](const LogSize& size) { sets.reads.insert(size.getRelation()); });
+    visit(stmt, [&](const IO&) { sets.parallelizable = false; });
+    visit(stmt, [&](const Swap&) { sets.parallelizable = false; });
+    visit(stmt, [&](const Extend&) { sets.parallelizable = false; });
+    visit(stmt, [&](const Call&) { sets.parallelizable = false; });
+    visit(stmt, [&](const Exit&) { sets.parallelizable = false; });
+    visit(stmt, [&](const SubroutineReturn&) { sets.parallelizable = false; });
+    return sets;
+}
+
+bool disjoint(const std::set<std::string>& left, const std::set<std::string>& right) {
+    for (const auto& cur : left) {
+        if (right.find(cur) != right.end()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool independent(const AccessSets& a, const AccessSets& b) {
+    return disjoint(a.writes, b.writes) && disjoint(a.writes, b.reads) && disjoint(a.reads, b.writes);
+}
+
+}  // namespace
+
+bool ParallelizeSequencesTransformer::parallelizeSequences(Program& program) {
+    bool changed = false;
+    program.apply(nodeMapper<Node>([&](auto&& go, Own<Node> node) -> Own<Node> {
+        // Rewrite nested sequences first.
+        node->apply(go);
+
+        const Sequence* sequence = as<Sequence>(node);
+        if (sequence == nullptr) {
+            return node;
+        }
+
+        // Partition the sequence into maximal runs of pairwise independent
+        // statements; every run of more than one statement becomes a
+        // parallel statement.
+        VecOwn<Statement> result;
+        VecOwn<Statement> group;
+        AccessSets groupSets;
+        bool grouped = false;
+
+        auto flush = [&]() {
+            if (group.size() > 1) {
+                result.push_back(mk<Parallel>(std::move(group)));
+                grouped = true;
+            } else {
+                for (auto& cur : group) {
+                    result.push_back(std::move(cur));
+                }
+            }
+            group.clear();
+            groupSets = AccessSets();
+        };
+
+        for (const Statement* stmt : sequence->getStatements()) {
+            AccessSets sets = collectAccessSets(*stmt);
+            if (!sets.parallelizable) {
+                flush();
+                result.push_back(clone(stmt));
+                continue;
+            }
+            if (!independent(groupSets, sets)) {
+                flush();
+            }
+            group.push_back(clone(stmt));
+            groupSets.reads.insert(sets.reads.begin(), sets.reads.end());
+            groupSets.writes.insert(sets.writes.begin(), sets.writes.end());
+        }
+        flush();
+
+        if (!grouped) {
+            return node;
+        }
+        changed = true;
+        return mk<Sequence>(std::move(result));
+    }));
+    return changed;
+}
+
+}  // namespace souffle::ram::transform
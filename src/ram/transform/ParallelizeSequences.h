@@ -0,0 +1,75 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ParallelizeSequences.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class ParallelizeSequencesTransformer
+ * @brief Rewrites runs of independent statements in a sequence into a
+ * parallel statement.
+ *
+ * Two statements are independent if neither writes a relation the other
+ * one reads or writes. Statements with side effects beyond relation
+ * contents (I/O, swaps, subroutine returns, ...) are never grouped.
+ *
+ * For example ..
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *    ... insert into A ...
+ *  QUERY
+ *    ... insert into B ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  PARALLEL
+ *   QUERY
+ *     ... insert into A ...
+ *   QUERY
+ *     ... insert into B ...
+ *  END PARALLEL
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * assuming that neither query reads the relation the other one inserts into.
+ *
+ */
+class ParallelizeSequencesTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "ParallelizeSequencesTransformer";
+    }
+
+    /**
+     * @brief Group independent statements of sequences into parallel statements
+     * @param program Program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool parallelizeSequences(Program& program);
+
+protected:
+    bool transform(TranslationUnit& translationUnit) override {
+        return parallelizeSequences(translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,135 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReleaseRelations.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/transform/ReleaseRelations.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/BinRelationStatement.h"
+#include "ram/Clear.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/IO.h"
+#include "ram/Insert.h"
+#include "ram/Node.h"
+#include "ram/Program.h"
+#include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
+#include "ram/RelationStatement.h"
+#include "ram/Sequence.h"
+#include "ram/Statement.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram::transform {
+
+namespace {
+
+/** The relations referenced anywhere below the given node. */
+std::set<std::string> collectUsedRelations(const Node& root) {
+    std::set<std::string> used;
+    visit(root, [&](const RelationStatement& stmt) { used.insert(stmt.getRelation()); });
+    visit(root, [&](const BinRelationStatement& stmt) {
+        used.insert(stmt.getFirstRelation());
+        used.insert(stmt.getSecondRelation());
+    });
+    visit(root, [&](const RelationOperation& op) { used.insert(op.getRelation()); });
+    visit(root, [&](const AbstractExistenceCheck& exists) { used.insert(exists.getRelation()); });
+    visit(root, [&](const EmptinessCheck& empty) { used.insert(empty.getRelation()); });
+    visit(root, [&](const RelationSize& size) { used.insert(size.getRelation()); });
+    visit(root, [&](const Insert& insert) { used.insert(insert.getRelation()); });
+    visit(root, [&](const Erase& erase) { used.insert(erase.getRelation()); });
+    return used;
+}
+
+}  // namespace
+
+bool ReleaseRelationsTransformer::releaseRelations(Program& program) {
+    const Sequence* main = as<Sequence>(program.getMain());
+    if (main == nullptr) {
+        return false;
+    }
+    const auto statements = main->getStatements();
+    if (statements.empty()) {
+        return false;
+    }
+
+    // relations that must stay live to the end of the program: those read
+    // by subroutines (which run after the main program), those stored to an
+    // output (embedders read them after the run), and temporary relations
+    // (whose lifetime is managed by their loops)
+    std::set<std::string> pinned;
+    for (const auto& subroutine : program.getSubroutines()) {
+        for (const auto& relation : collectUsedRelations(*subroutine.second)) {
+            pinned.insert(relation);
+        }
+    }
+    visit(program.getMain(), [&](const IO& io) {
+        const std::string& op = io.get("operation");
+        if (op == "output" || op == "printsize") {
+            pinned.insert(io.getRelation());
+        }
+    });
+    for (const Relation* relation : program.getRelations()) {
+        if (relation->isTemp()) {
+            pinned.insert(relation->getName());
+        }
+    }
+
+    // determine the last top-level statement referencing each relation
+    std::map<std::string, std::size_t> lastUse;
+    for (std::size_t i = 0; i < statements.size(); i++) {
+        for (const auto& relation : collectUsedRelations(*statements[i])) {
+            lastUse[relation] = i;
+        }
+    }
+
+    // releases behind the final statement gain nothing - the program ends
+    std::map<std::size_t, std::vector<std::string>> releases;
+    for (const auto& [relation, index] : lastUse) {
+        if (index + 1 >= statements.size() || pinned.find(relation) != pinned.end()) {
+            continue;
+        }
+        // already released - the last use is a clear of the relation itself
+        if (const Clear* clear = as<Clear>(statements[index]);
+                clear != nullptr && clear->getRelation() == relation) {
+            continue;
+        }
+        releases[index].push_back(relation);
+    }
+    if (releases.empty()) {
+        return false;
+    }
+
+    // rebuild the main sequence with the clear statements inserted
+    VecOwn<Statement> result;
+    for (std::size_t i = 0; i < statements.size(); i++) {
+        result.push_back(clone(statements[i]));
+        auto pos = releases.find(i);
+        if (pos != releases.end()) {
+            for (const auto& relation : pos->second) {
+                result.push_back(mk<Clear>(relation));
+            }
+        }
+    }
+    program.rewrite(main, mk<Sequence>(std::move(result)));
+    return true;
+}
+
+}  // namespace souffle::ram::transform
@@ -0,0 +1,84 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2023, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReleaseRelations.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Program.h"
+#include "ram/TranslationUnit.h"
+#include "ram/transform/Transformer.h"
+#include <string>
+
+namespace souffle::ram::transform {
+
+/**
+ * @class ReleaseRelationsTransformer
+ * @brief Clears relations right after the last statement that reads them,
+ * instead of holding their tuples until the end of the program.
+ *
+ * The last use of each relation is determined over the top-level statement
+ * sequence of the main program; a clear statement is inserted behind it, so
+ * peak memory tracks the live relations of the current stratum rather than
+ * everything computed so far. This covers input relations only consumed by
+ * early strata as well as intermediate relations.
+ *
+ * Relations referenced by a subroutine are never released, since
+ * subroutines run after the main program. Relations written to an output
+ * are kept as well: embedders commonly read them through the interface
+ * after the run, and in generated executables their stores are skipped
+ * entirely when I/O is disabled. Temporary relations are managed by their
+ * loops and left alone.
+ *
+ * For example ..
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *    ... read A, insert into B ...
+ *  QUERY
+ *    ... read B, insert into C ...
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * will be rewritten to
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *  QUERY
+ *    ... read A, insert into B ...
+ *  CLEAR A
+ *  QUERY
+ *    ... read B, insert into C ...
+ *  CLEAR B
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * assuming that A and B are not used afterwards.
+ *
+ */
+class ReleaseRelationsTransformer : public Transformer {
+public:
+    std::string getName() const override {
+        return "ReleaseRelationsTransformer";
+    }
+
+    /**
+     * @brief Insert clear statements behind the last use of each relation
+     * @param program Program that is transformed
+     * @return Flag showing whether the program has been changed by the transformation
+     */
+    bool releaseRelations(Program& program);
+
+protected:
+    bool transform(TranslationUnit& translationUnit) override {
+        return releaseRelations(translationUnit.getProgram());
+    }
+};
+
+}  // namespace souffle::ram::transform
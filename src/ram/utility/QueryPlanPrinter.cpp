@@ -0,0 +1,165 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file QueryPlanPrinter.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/utility/QueryPlanPrinter.h"
+#include "ram/AbstractConditional.h"
+#include "ram/Aggregate.h"
+#include "ram/Break.h"
+#include "ram/DebugInfo.h"
+#include "ram/Erase.h"
+#include "ram/Filter.h"
+#include "ram/GuardedInsert.h"
+#include "ram/IfExists.h"
+#include "ram/IndexAggregate.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexOperation.h"
+#include "ram/IndexScan.h"
+#include "ram/Insert.h"
+#include "ram/NestedIntrinsicOperator.h"
+#include "ram/NestedOperation.h"
+#include "ram/Node.h"
+#include "ram/Operation.h"
+#include "ram/ParallelAggregate.h"
+#include "ram/ParallelIfExists.h"
+#include "ram/ParallelIndexAggregate.h"
+#include "ram/ParallelIndexIfExists.h"
+#include "ram/ParallelIndexScan.h"
+#include "ram/ParallelScan.h"
+#include "ram/Program.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/RelationOperation.h"
+#include "ram/Scan.h"
+#include "ram/Statement.h"
+#include "ram/SubroutineReturn.h"
+#include "ram/TranslationUnit.h"
+#include "ram/UnpackRecord.h"
+#include "ram/analysis/Index.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/json11.h"
+#include <string>
+#include <vector>
+
+namespace souffle::ram {
+
+using json11::Json;
+
+namespace {
+
+/** @brief Name of an operation kind; most derived classes are checked first */
+std::string getOperationName(const Operation& op) {
+    if (isA<ParallelIndexIfExists>(&op)) return "parallel-index-if-exists";
+    if (isA<IndexIfExists>(&op)) return "index-if-exists";
+    if (isA<ParallelIfExists>(&op)) return "parallel-if-exists";
+    if (isA<IfExists>(&op)) return "if-exists";
+    if (isA<ParallelIndexScan>(&op)) return "parallel-index-scan";
+    if (isA<IndexScan>(&op)) return "index-scan";
+    if (isA<ParallelScan>(&op)) return "parallel-scan";
+    if (isA<Scan>(&op)) return "scan";
+    if (isA<ParallelIndexAggregate>(&op)) return "parallel-index-aggregate";
+    if (isA<IndexAggregate>(&op)) return "index-aggregate";
+    if (isA<ParallelAggregate>(&op)) return "parallel-aggregate";
+    if (isA<Aggregate>(&op)) return "aggregate";
+    if (isA<UnpackRecord>(&op)) return "unpack-record";
+    if (isA<Break>(&op)) return "break";
+    if (isA<Filter>(&op)) return "filter";
+    if (isA<NestedIntrinsicOperator>(&op)) return "nested-intrinsic-operator";
+    if (isA<GuardedInsert>(&op)) return "guarded-insert";
+    if (isA<Insert>(&op)) return "insert";
+    if (isA<Erase>(&op)) return "erase";
+    if (isA<SubroutineReturn>(&op)) return "subroutine-return";
+    return "operation";
+}
+
+/** @brief Describe the loop nest of a query, one entry per nesting level */
+Json describeQuery(const Query& query, const std::string& subroutine, const std::string& clause,
+        const analysis::IndexAnalysis& idxAnalysis) {
+    Json::array plan;
+    const Operation* op = &query.getOperation();
+    int depth = 0;
+    while (op != nullptr) {
+        Json::object entry;
+        entry["depth"] = static_cast<long long>(depth);
+        entry["operation"] = getOperationName(*op);
+        if (const auto* relOp = as<RelationOperation>(op)) {
+            entry["relation"] = relOp->getRelation();
+        }
+        if (const auto* indexOp = as<IndexOperation>(op)) {
+            const auto keys = idxAnalysis.getSearchSignature(indexOp);
+            const auto selection = idxAnalysis.getIndexSelection(indexOp->getRelation());
+            Json::array order;
+            for (const auto attr : selection.getLexOrder(keys)) {
+                order.push_back(static_cast<long long>(attr));
+            }
+            entry["search"] = toString(keys);
+            entry["index"] = order;
+            entry["indexNum"] = static_cast<long long>(selection.getLexOrderNum(keys));
+        }
+        if (const auto* conditional = as<AbstractConditional>(op)) {
+            entry["condition"] = toString(conditional->getCondition());
+        }
+        plan.push_back(entry);
+        const auto* nested = as<NestedOperation>(op);
+        op = (nested != nullptr) ? &nested->getOperation() : nullptr;
+        depth++;
+    }
+    return Json::object{{"subroutine", subroutine}, {"clause", clause}, {"plan", plan}};
+}
+
+/** @brief Collect all queries of a statement, tracking the enclosing debug info */
+void collectQueries(const Node& node, const std::string& subroutine, const std::string& clause,
+        const analysis::IndexAnalysis& idxAnalysis, Json::array& queries) {
+    if (const auto* query = as<Query>(&node)) {
+        queries.push_back(describeQuery(*query, subroutine, clause, idxAnalysis));
+        return;
+    }
+    const auto* debug = as<DebugInfo>(&node);
+    for (const Node& child : node.getChildNodes()) {
+        collectQueries(child, subroutine, (debug != nullptr) ? debug->getMessage() : clause, idxAnalysis,
+                queries);
+    }
+}
+
+}  // namespace
+
+void printQueryPlan(TranslationUnit& translationUnit, std::ostream& os) {
+    const auto& idxAnalysis = translationUnit.getAnalysis<analysis::IndexAnalysis>();
+    const Program& program = translationUnit.getProgram();
+
+    // per-relation summary: arity, representation, and selected index orders
+    Json::object relations;
+    for (const Relation* rel : program.getRelations()) {
+        Json::array indexes;
+        for (const auto& lexOrder : idxAnalysis.getIndexSelection(rel->getName()).getAllOrders()) {
+            Json::array order;
+            for (const auto attr : lexOrder) {
+                order.push_back(static_cast<long long>(attr));
+            }
+            indexes.push_back(order);
+        }
+        relations[rel->getName()] = Json::object{{"arity", static_cast<long long>(rel->getArity())},
+                {"representation", toString(rel->getRepresentation())}, {"indexes", indexes}};
+    }
+
+    // per-query loop nests, in main program and subroutines
+    Json::array queries;
+    collectQueries(program.getMain(), "", "", idxAnalysis, queries);
+    for (const auto& [name, statement] : program.getSubroutines()) {
+        collectQueries(*statement, name, "", idxAnalysis, queries);
+    }
+
+    os << Json(Json::object{{"relations", relations}, {"queries", queries}}).dump() << std::endl;
+}
+
+}  // namespace souffle::ram
@@ -0,0 +1,37 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file QueryPlanPrinter.h
+ *
+ * Emits a machine-readable report of the query plans of a RAM program:
+ * for each query, the loop nest and the index orders chosen by the
+ * index analysis. Intended for diffing plans between releases.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <ostream>
+
+namespace souffle::ram {
+
+class TranslationUnit;
+
+/**
+ * @brief Print the query plans of the given program as a JSON document
+ *
+ * The report contains one entry per relation (arity, representation, and
+ * the selected index orders) and one entry per query (the source clause
+ * from the surrounding debug info, and the loop nest with the index order
+ * used by each index operation).
+ */
+void printQueryPlan(TranslationUnit& translationUnit, std::ostream& os);
+
+}  // namespace souffle::ram
@@ -0,0 +1,917 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Serialiser.cpp
+ *
+ ***********************************************************************/
+
+#include "ram/utility/Serialiser.h"
+#include "ram/Aggregate.h"
+#include "ram/AutoIncrement.h"
+#include "ram/Break.h"
+#include "ram/Call.h"
+#include "ram/Clear.h"
+#include "ram/Condition.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/DebugInfo.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/ExistenceCheck.h"
+#include "ram/Exit.h"
+#include "ram/Expression.h"
+#include "ram/Extend.h"
+#include "ram/False.h"
+#include "ram/Filter.h"
+#include "ram/FloatConstant.h"
+#include "ram/GuardedInsert.h"
+#include "ram/IO.h"
+#include "ram/IfExists.h"
+#include "ram/IndexAggregate.h"
+#include "ram/IndexIfExists.h"
+#include "ram/IndexOperation.h"
+#include "ram/IndexScan.h"
+#include "ram/Insert.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/LogRelationTimer.h"
+#include "ram/LogSize.h"
+#include "ram/LogTimer.h"
+#include "ram/Loop.h"
+#include "ram/Merge.h"
+#include "ram/Negation.h"
+#include "ram/NestedIntrinsicOperator.h"
+#include "ram/Operation.h"
+#include "ram/PackRecord.h"
+#include "ram/Parallel.h"
+#include "ram/ParallelAggregate.h"
+#include "ram/ParallelIfExists.h"
+#include "ram/ParallelIndexAggregate.h"
+#include "ram/ParallelIndexIfExists.h"
+#include "ram/ParallelIndexScan.h"
+#include "ram/ParallelScan.h"
+#include "ram/Program.h"
+#include "ram/ProvenanceExistenceCheck.h"
+#include "ram/Query.h"
+#include "ram/Relation.h"
+#include "ram/RelationSize.h"
+#include "ram/Scan.h"
+#include "ram/Sequence.h"
+#include "ram/SignedConstant.h"
+#include "ram/Statement.h"
+#include "ram/StringConstant.h"
+#include "ram/SubroutineArgument.h"
+#include "ram/SubroutineReturn.h"
+#include "ram/Swap.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/UnpackRecord.h"
+#include "ram/UnsignedConstant.h"
+#include "ram/UserDefinedOperator.h"
+#include "souffle/RamTypes.h"
+#include "souffle/utility/DynamicCasting.h"
+#include "souffle/utility/Types.h"
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace souffle::ram {
+
+namespace {
+
+/** Image preamble identifying the format and its revision */
+constexpr char Magic[4] = {'S', 'R', 'A', 'M'};
+constexpr std::uint32_t FormatVersion = 1;
+
+/**
+ * One tag per concrete node class. Enum values and the numeric encoding
+ * of the referenced operator enums are part of the format; images are
+ * versioned by FormatVersion and additionally keyed by the caller, so
+ * neither needs to stay stable across releases.
+ */
+enum class Tag : std::uint8_t {
+    // statements
+    Sequence = 1,
+    Parallel,
+    Loop,
+    Exit,
+    Query,
+    Clear,
+    Call,
+    IO,
+    Extend,
+    Merge,
+    Swap,
+    LogRelationTimer,
+    LogTimer,
+    DebugInfo,
+    LogSize,
+
+    // operations
+    ParallelScan,
+    Scan,
+    ParallelIndexScan,
+    IndexScan,
+    ParallelIfExists,
+    IfExists,
+    ParallelIndexIfExists,
+    IndexIfExists,
+    ParallelAggregate,
+    Aggregate,
+    ParallelIndexAggregate,
+    IndexAggregate,
+    UnpackRecord,
+    NestedIntrinsicOperator,
+    Filter,
+    Break,
+    GuardedInsert,
+    Insert,
+    Erase,
+    SubroutineReturn,
+
+    // conditions
+    Conjunction,
+    Negation,
+    Constraint,
+    True,
+    False,
+    EmptinessCheck,
+    ExistenceCheck,
+    ProvenanceExistenceCheck,
+
+    // expressions
+    TupleElement,
+    SignedConstant,
+    UnsignedConstant,
+    FloatConstant,
+    StringConstant,
+    IntrinsicOperator,
+    UserDefinedOperator,
+    SubroutineArgument,
+    AutoIncrement,
+    UndefValue,
+    PackRecord,
+    RelationSize,
+};
+
+/** Serialises a program onto a stream; throws on an uncovered node kind. */
+class Writer {
+public:
+    explicit Writer(std::ostream& os) : os(os) {}
+
+    void write(const Program& program) {
+        os.write(Magic, sizeof(Magic));
+        u64(FormatVersion);
+
+        const auto relations = program.getRelations();
+        u64(relations.size());
+        for (const Relation* rel : relations) {
+            relation(*rel);
+        }
+
+        statement(program.getMain());
+
+        const auto subroutines = program.getSubroutines();
+        u64(subroutines.size());
+        for (auto&& [name, sub] : subroutines) {
+            str(name);
+            statement(*sub);
+        }
+    }
+
+private:
+    std::ostream& os;
+
+    // --- primitives -----------------------------------------------------
+
+    void u64(std::uint64_t value) {
+        char bytes[8];
+        for (std::size_t i = 0; i < 8; ++i) {
+            bytes[i] = static_cast<char>(value >> (8 * i));
+        }
+        os.write(bytes, sizeof(bytes));
+    }
+
+    void i64(std::int64_t value) {
+        u64(static_cast<std::uint64_t>(value));
+    }
+
+    void str(const std::string& value) {
+        u64(value.size());
+        os.write(value.data(), static_cast<std::streamsize>(value.size()));
+    }
+
+    void tag(Tag value) {
+        const char byte = static_cast<char>(value);
+        os.write(&byte, 1);
+    }
+
+    template <typename E>
+    void enumValue(E value) {
+        i64(static_cast<std::int64_t>(static_cast<std::underlying_type_t<E>>(value)));
+    }
+
+    // --- composites -----------------------------------------------------
+
+    void relation(const Relation& rel) {
+        str(rel.getName());
+        u64(rel.getArity());
+        u64(rel.getAuxiliaryArity());
+        strings(rel.getAttributeNames());
+        strings(rel.getAttributeTypes());
+        enumValue(rel.getRepresentation());
+    }
+
+    void strings(const std::vector<std::string>& values) {
+        u64(values.size());
+        for (const std::string& value : values) {
+            str(value);
+        }
+    }
+
+    void expressions(const std::vector<Expression*>& values) {
+        u64(values.size());
+        for (const Expression* value : values) {
+            expression(*value);
+        }
+    }
+
+    void pattern(const IndexOperation& index) {
+        const auto range = index.getRangePattern();
+        expressions(range.first);
+        expressions(range.second);
+    }
+
+    void statement(const Statement& stmt) {
+        if (const auto* sequence = as<Sequence>(stmt)) {
+            tag(Tag::Sequence);
+            statements(sequence->getStatements());
+        } else if (const auto* parallel = as<Parallel>(stmt)) {
+            tag(Tag::Parallel);
+            statements(parallel->getStatements());
+        } else if (const auto* loop = as<Loop>(stmt)) {
+            tag(Tag::Loop);
+            statement(loop->getBody());
+        } else if (const auto* exit = as<Exit>(stmt)) {
+            tag(Tag::Exit);
+            condition(exit->getCondition());
+        } else if (const auto* query = as<Query>(stmt)) {
+            tag(Tag::Query);
+            operation(query->getOperation());
+        } else if (const auto* clear = as<Clear>(stmt)) {
+            tag(Tag::Clear);
+            str(clear->getRelation());
+        } else if (const auto* call = as<Call>(stmt)) {
+            tag(Tag::Call);
+            str(call->getName());
+        } else if (const auto* io = as<IO>(stmt)) {
+            tag(Tag::IO);
+            str(io->getRelation());
+            const auto& directives = io->getDirectives();
+            u64(directives.size());
+            for (auto&& [key, value] : directives) {
+                str(key);
+                str(value);
+            }
+        } else if (const auto* extend = as<Extend>(stmt)) {
+            tag(Tag::Extend);
+            str(extend->getTargetRelation());
+            str(extend->getSourceRelation());
+        } else if (const auto* merge = as<Merge>(stmt)) {
+            tag(Tag::Merge);
+            str(merge->getTargetRelation());
+            str(merge->getSourceRelation());
+        } else if (const auto* swap = as<Swap>(stmt)) {
+            tag(Tag::Swap);
+            str(swap->getFirstRelation());
+            str(swap->getSecondRelation());
+        } else if (const auto* timer = as<LogRelationTimer>(stmt)) {
+            tag(Tag::LogRelationTimer);
+            statement(timer->getStatement());
+            str(timer->getMessage());
+            str(timer->getRelation());
+        } else if (const auto* timer = as<LogTimer>(stmt)) {
+            tag(Tag::LogTimer);
+            statement(timer->getStatement());
+            str(timer->getMessage());
+        } else if (const auto* info = as<DebugInfo>(stmt)) {
+            tag(Tag::DebugInfo);
+            statement(info->getStatement());
+            str(info->getMessage());
+        } else if (const auto* size = as<LogSize>(stmt)) {
+            tag(Tag::LogSize);
+            str(size->getRelation());
+            str(size->getMessage());
+        } else {
+            throw std::runtime_error("cannot serialise RAM statement");
+        }
+    }
+
+    void statements(const std::vector<Statement*>& values) {
+        u64(values.size());
+        for (const Statement* value : values) {
+            statement(*value);
+        }
+    }
+
+    void operation(const Operation& op) {
+        // most derived kinds first: the parallel index forms are also
+        // their sequential and non-indexed counterparts
+        if (const auto* scan = as<ParallelIndexScan>(op)) {
+            tag(Tag::ParallelIndexScan);
+            indexScan(*scan);
+        } else if (const auto* scan = as<IndexScan>(op)) {
+            tag(Tag::IndexScan);
+            indexScan(*scan);
+        } else if (const auto* scan = as<ParallelScan>(op)) {
+            tag(Tag::ParallelScan);
+            scanOp(*scan);
+        } else if (const auto* scan = as<Scan>(op)) {
+            tag(Tag::Scan);
+            scanOp(*scan);
+        } else if (const auto* exists = as<ParallelIndexIfExists>(op)) {
+            tag(Tag::ParallelIndexIfExists);
+            indexIfExists(*exists);
+        } else if (const auto* exists = as<IndexIfExists>(op)) {
+            tag(Tag::IndexIfExists);
+            indexIfExists(*exists);
+        } else if (const auto* exists = as<ParallelIfExists>(op)) {
+            tag(Tag::ParallelIfExists);
+            ifExists(*exists);
+        } else if (const auto* exists = as<IfExists>(op)) {
+            tag(Tag::IfExists);
+            ifExists(*exists);
+        } else if (const auto* aggregate = as<ParallelIndexAggregate>(op)) {
+            tag(Tag::ParallelIndexAggregate);
+            indexAggregate(*aggregate);
+        } else if (const auto* aggregate = as<IndexAggregate>(op)) {
+            tag(Tag::IndexAggregate);
+            indexAggregate(*aggregate);
+        } else if (const auto* aggregate = as<ParallelAggregate>(op)) {
+            tag(Tag::ParallelAggregate);
+            aggregateOp(*aggregate);
+        } else if (const auto* aggregate = as<Aggregate>(op)) {
+            tag(Tag::Aggregate);
+            aggregateOp(*aggregate);
+        } else if (const auto* unpack = as<UnpackRecord>(op)) {
+            tag(Tag::UnpackRecord);
+            operation(unpack->getOperation());
+            i64(unpack->getTupleId());
+            expression(unpack->getExpression());
+            u64(unpack->getArity());
+        } else if (const auto* nested = as<NestedIntrinsicOperator>(op)) {
+            tag(Tag::NestedIntrinsicOperator);
+            enumValue(nested->getFunction());
+            expressions(nested->getArguments());
+            operation(nested->getOperation());
+            i64(nested->getTupleId());
+        } else if (const auto* breakOp = as<Break>(op)) {
+            tag(Tag::Break);
+            condition(breakOp->getCondition());
+            operation(breakOp->getOperation());
+            str(breakOp->getProfileText());
+        } else if (const auto* filter = as<Filter>(op)) {
+            tag(Tag::Filter);
+            condition(filter->getCondition());
+            operation(filter->getOperation());
+            str(filter->getProfileText());
+        } else if (const auto* insert = as<GuardedInsert>(op)) {
+            tag(Tag::GuardedInsert);
+            str(insert->getRelation());
+            expressions(insert->getValues());
+            condition(*insert->getCondition());
+        } else if (const auto* insert = as<Insert>(op)) {
+            tag(Tag::Insert);
+            str(insert->getRelation());
+            expressions(insert->getValues());
+        } else if (const auto* erase = as<Erase>(op)) {
+            tag(Tag::Erase);
+            str(erase->getRelation());
+            expressions(erase->getValues());
+        } else if (const auto* ret = as<SubroutineReturn>(op)) {
+            tag(Tag::SubroutineReturn);
+            expressions(ret->getValues());
+        } else {
+            throw std::runtime_error("cannot serialise RAM operation");
+        }
+    }
+
+    void scanOp(const Scan& scan) {
+        str(scan.getRelation());
+        i64(scan.getTupleId());
+        operation(scan.getOperation());
+        str(scan.getProfileText());
+    }
+
+    void indexScan(const IndexScan& scan) {
+        str(scan.getRelation());
+        i64(scan.getTupleId());
+        pattern(scan);
+        operation(scan.getOperation());
+        str(scan.getProfileText());
+    }
+
+    void ifExists(const IfExists& exists) {
+        str(exists.getRelation());
+        i64(exists.getTupleId());
+        condition(exists.getCondition());
+        operation(exists.getOperation());
+        str(exists.getProfileText());
+    }
+
+    void indexIfExists(const IndexIfExists& exists) {
+        str(exists.getRelation());
+        i64(exists.getTupleId());
+        condition(exists.getCondition());
+        pattern(exists);
+        operation(exists.getOperation());
+        str(exists.getProfileText());
+    }
+
+    void aggregateOp(const Aggregate& aggregate) {
+        operation(aggregate.getOperation());
+        enumValue(aggregate.getFunction());
+        str(aggregate.getRelation());
+        expression(aggregate.getExpression());
+        condition(aggregate.getCondition());
+        i64(aggregate.getTupleId());
+    }
+
+    void indexAggregate(const IndexAggregate& aggregate) {
+        operation(aggregate.getOperation());
+        enumValue(aggregate.getFunction());
+        str(aggregate.getRelation());
+        expression(aggregate.getExpression());
+        condition(aggregate.getCondition());
+        pattern(aggregate);
+        i64(aggregate.getTupleId());
+    }
+
+    void condition(const Condition& cond) {
+        if (const auto* conjunction = as<Conjunction>(cond)) {
+            tag(Tag::Conjunction);
+            condition(conjunction->getLHS());
+            condition(conjunction->getRHS());
+        } else if (const auto* negation = as<Negation>(cond)) {
+            tag(Tag::Negation);
+            condition(negation->getOperand());
+        } else if (const auto* constraint = as<Constraint>(cond)) {
+            tag(Tag::Constraint);
+            enumValue(constraint->getOperator());
+            expression(constraint->getLHS());
+            expression(constraint->getRHS());
+        } else if (isA<True>(cond)) {
+            tag(Tag::True);
+        } else if (isA<False>(cond)) {
+            tag(Tag::False);
+        } else if (const auto* empty = as<EmptinessCheck>(cond)) {
+            tag(Tag::EmptinessCheck);
+            str(empty->getRelation());
+        } else if (const auto* exists = as<ProvenanceExistenceCheck>(cond)) {
+            tag(Tag::ProvenanceExistenceCheck);
+            str(exists->getRelation());
+            expressions(exists->getValues());
+        } else if (const auto* exists = as<ExistenceCheck>(cond)) {
+            tag(Tag::ExistenceCheck);
+            str(exists->getRelation());
+            expressions(exists->getValues());
+        } else {
+            throw std::runtime_error("cannot serialise RAM condition");
+        }
+    }
+
+    void expression(const Expression& expr) {
+        if (const auto* element = as<TupleElement>(expr)) {
+            tag(Tag::TupleElement);
+            i64(element->getTupleId());
+            u64(element->getElement());
+        } else if (const auto* constant = as<SignedConstant>(expr)) {
+            tag(Tag::SignedConstant);
+            i64(constant->getConstant());
+        } else if (const auto* constant = as<UnsignedConstant>(expr)) {
+            tag(Tag::UnsignedConstant);
+            i64(constant->getConstant());
+        } else if (const auto* constant = as<FloatConstant>(expr)) {
+            tag(Tag::FloatConstant);
+            i64(constant->getConstant());
+        } else if (const auto* constant = as<StringConstant>(expr)) {
+            tag(Tag::StringConstant);
+            str(constant->getConstant());
+        } else if (const auto* intrinsic = as<IntrinsicOperator>(expr)) {
+            tag(Tag::IntrinsicOperator);
+            enumValue(intrinsic->getOperator());
+            expressions(intrinsic->getArguments());
+        } else if (const auto* functor = as<UserDefinedOperator>(expr)) {
+            tag(Tag::UserDefinedOperator);
+            str(functor->getName());
+            const auto& argsTypes = functor->getArgsTypes();
+            u64(argsTypes.size());
+            for (const TypeAttribute type : argsTypes) {
+                enumValue(type);
+            }
+            enumValue(functor->getReturnType());
+            u64(functor->isStateful() ? 1 : 0);
+            expressions(functor->getArguments());
+        } else if (const auto* argument = as<SubroutineArgument>(expr)) {
+            tag(Tag::SubroutineArgument);
+            u64(argument->getArgument());
+        } else if (isA<AutoIncrement>(expr)) {
+            tag(Tag::AutoIncrement);
+        } else if (isA<UndefValue>(expr)) {
+            tag(Tag::UndefValue);
+        } else if (const auto* pack = as<PackRecord>(expr)) {
+            tag(Tag::PackRecord);
+            expressions(pack->getArguments());
+        } else if (const auto* size = as<RelationSize>(expr)) {
+            tag(Tag::RelationSize);
+            str(size->getRelation());
+        } else {
+            throw std::runtime_error("cannot serialise RAM expression");
+        }
+    }
+};
+
+/** Reconstructs a program from a stream; throws on a malformed image. */
+class Reader {
+public:
+    explicit Reader(std::istream& is) : is(is) {}
+
+    Own<Program> read() {
+        char magic[sizeof(Magic)];
+        bytes(magic, sizeof(magic));
+        if (!std::equal(magic, magic + sizeof(magic), Magic)) {
+            throw std::runtime_error("not a RAM image");
+        }
+        if (u64() != FormatVersion) {
+            throw std::runtime_error("RAM image version mismatch");
+        }
+
+        VecOwn<Relation> relations;
+        for (std::size_t i = u64(); i > 0; --i) {
+            relations.push_back(relation());
+        }
+
+        Own<Statement> main = statement();
+
+        std::map<std::string, Own<Statement>> subroutines;
+        for (std::size_t i = u64(); i > 0; --i) {
+            std::string name = str();
+            subroutines.emplace(std::move(name), statement());
+        }
+
+        return mk<Program>(std::move(relations), std::move(main), std::move(subroutines));
+    }
+
+private:
+    std::istream& is;
+
+    // --- primitives -----------------------------------------------------
+
+    void bytes(char* destination, std::size_t size) {
+        if (!is.read(destination, static_cast<std::streamsize>(size))) {
+            throw std::runtime_error("truncated RAM image");
+        }
+    }
+
+    std::uint64_t u64() {
+        char raw[8];
+        bytes(raw, sizeof(raw));
+        std::uint64_t value = 0;
+        for (std::size_t i = 0; i < 8; ++i) {
+            value |= static_cast<std::uint64_t>(static_cast<unsigned char>(raw[i])) << (8 * i);
+        }
+        return value;
+    }
+
+    std::int64_t i64() {
+        return static_cast<std::int64_t>(u64());
+    }
+
+    std::string str() {
+        const std::size_t size = u64();
+        std::string value(size, '\0');
+        if (size > 0) {
+            bytes(value.data(), size);
+        }
+        return value;
+    }
+
+    Tag tag() {
+        char byte;
+        bytes(&byte, 1);
+        return static_cast<Tag>(byte);
+    }
+
+    template <typename E>
+    E enumValue() {
+        return static_cast<E>(static_cast<std::underlying_type_t<E>>(i64()));
+    }
+
+    // --- composites -----------------------------------------------------
+
+    Own<Relation> relation() {
+        std::string name = str();
+        const std::size_t arity = u64();
+        const std::size_t auxiliaryArity = u64();
+        std::vector<std::string> attributeNames = strings();
+        std::vector<std::string> attributeTypes = strings();
+        const auto representation = enumValue<RelationRepresentation>();
+        return mk<Relation>(std::move(name), arity, auxiliaryArity, std::move(attributeNames),
+                std::move(attributeTypes), representation);
+    }
+
+    std::vector<std::string> strings() {
+        std::vector<std::string> values;
+        for (std::size_t i = u64(); i > 0; --i) {
+            values.push_back(str());
+        }
+        return values;
+    }
+
+    VecOwn<Expression> expressions() {
+        VecOwn<Expression> values;
+        for (std::size_t i = u64(); i > 0; --i) {
+            values.push_back(expression());
+        }
+        return values;
+    }
+
+    RamPattern pattern() {
+        VecOwn<Expression> lower = expressions();
+        VecOwn<Expression> upper = expressions();
+        return {std::move(lower), std::move(upper)};
+    }
+
+    Own<Statement> statement() {
+        switch (tag()) {
+            case Tag::Sequence: return mk<Sequence>(statements());
+            case Tag::Parallel: return mk<Parallel>(statements());
+            case Tag::Loop: return mk<Loop>(statement());
+            case Tag::Exit: return mk<Exit>(condition());
+            case Tag::Query: return mk<Query>(operation());
+            case Tag::Clear: return mk<Clear>(str());
+            case Tag::Call: return mk<Call>(str());
+            case Tag::IO: {
+                std::string rel = str();
+                std::map<std::string, std::string> directives;
+                for (std::size_t i = u64(); i > 0; --i) {
+                    std::string key = str();
+                    directives.emplace(std::move(key), str());
+                }
+                return mk<IO>(std::move(rel), std::move(directives));
+            }
+            case Tag::Extend: {
+                std::string target = str();
+                std::string source = str();
+                return mk<Extend>(std::move(target), source);
+            }
+            case Tag::Merge: {
+                std::string target = str();
+                std::string source = str();
+                return mk<Merge>(std::move(target), source);
+            }
+            case Tag::Swap: {
+                std::string first = str();
+                return mk<Swap>(std::move(first), str());
+            }
+            case Tag::LogRelationTimer: {
+                Own<Statement> nested = statement();
+                std::string message = str();
+                return mk<LogRelationTimer>(std::move(nested), std::move(message), str());
+            }
+            case Tag::LogTimer: {
+                Own<Statement> nested = statement();
+                return mk<LogTimer>(std::move(nested), str());
+            }
+            case Tag::DebugInfo: {
+                Own<Statement> nested = statement();
+                return mk<DebugInfo>(std::move(nested), str());
+            }
+            case Tag::LogSize: {
+                std::string rel = str();
+                return mk<LogSize>(std::move(rel), str());
+            }
+            default: throw std::runtime_error("invalid RAM statement tag");
+        }
+    }
+
+    VecOwn<Statement> statements() {
+        VecOwn<Statement> values;
+        for (std::size_t i = u64(); i > 0; --i) {
+            values.push_back(statement());
+        }
+        return values;
+    }
+
+    Own<Operation> operation() {
+        switch (tag()) {
+            case Tag::ParallelScan: return scanOp<ParallelScan>();
+            case Tag::Scan: return scanOp<Scan>();
+            case Tag::ParallelIndexScan: return indexScan<ParallelIndexScan>();
+            case Tag::IndexScan: return indexScan<IndexScan>();
+            case Tag::ParallelIfExists: return ifExists<ParallelIfExists>();
+            case Tag::IfExists: return ifExists<IfExists>();
+            case Tag::ParallelIndexIfExists: return indexIfExists<ParallelIndexIfExists>();
+            case Tag::IndexIfExists: return indexIfExists<IndexIfExists>();
+            case Tag::ParallelAggregate: return aggregateOp<ParallelAggregate>();
+            case Tag::Aggregate: return aggregateOp<Aggregate>();
+            case Tag::ParallelIndexAggregate: return indexAggregate<ParallelIndexAggregate>();
+            case Tag::IndexAggregate: return indexAggregate<IndexAggregate>();
+            case Tag::UnpackRecord: {
+                Own<Operation> nested = operation();
+                const int ident = static_cast<int>(i64());
+                Own<Expression> expr = expression();
+                return mk<UnpackRecord>(std::move(nested), ident, std::move(expr), u64());
+            }
+            case Tag::NestedIntrinsicOperator: {
+                const auto op = enumValue<NestedIntrinsicOp>();
+                VecOwn<Expression> args = expressions();
+                Own<Operation> nested = operation();
+                return mk<NestedIntrinsicOperator>(
+                        op, std::move(args), std::move(nested), static_cast<int>(i64()));
+            }
+            case Tag::Break: {
+                Own<Condition> cond = condition();
+                Own<Operation> nested = operation();
+                return mk<Break>(std::move(cond), std::move(nested), str());
+            }
+            case Tag::Filter: {
+                Own<Condition> cond = condition();
+                Own<Operation> nested = operation();
+                return mk<Filter>(std::move(cond), std::move(nested), str());
+            }
+            case Tag::GuardedInsert: {
+                std::string rel = str();
+                VecOwn<Expression> values = expressions();
+                return mk<GuardedInsert>(std::move(rel), std::move(values), condition());
+            }
+            case Tag::Insert: {
+                std::string rel = str();
+                return mk<Insert>(std::move(rel), expressions());
+            }
+            case Tag::Erase: {
+                std::string rel = str();
+                return mk<Erase>(std::move(rel), expressions());
+            }
+            case Tag::SubroutineReturn: return mk<SubroutineReturn>(expressions());
+            default: throw std::runtime_error("invalid RAM operation tag");
+        }
+    }
+
+    template <typename T>
+    Own<T> scanOp() {
+        std::string rel = str();
+        const int ident = static_cast<int>(i64());
+        Own<Operation> nested = operation();
+        return mk<T>(std::move(rel), ident, std::move(nested), str());
+    }
+
+    template <typename T>
+    Own<T> indexScan() {
+        std::string rel = str();
+        const int ident = static_cast<int>(i64());
+        RamPattern queryPattern = pattern();
+        Own<Operation> nested = operation();
+        return mk<T>(std::move(rel), ident, std::move(queryPattern), std::move(nested), str());
+    }
+
+    template <typename T>
+    Own<T> ifExists() {
+        std::string rel = str();
+        const int ident = static_cast<int>(i64());
+        Own<Condition> cond = condition();
+        Own<Operation> nested = operation();
+        return mk<T>(std::move(rel), ident, std::move(cond), std::move(nested), str());
+    }
+
+    template <typename T>
+    Own<T> indexIfExists() {
+        std::string rel = str();
+        const int ident = static_cast<int>(i64());
+        Own<Condition> cond = condition();
+        RamPattern queryPattern = pattern();
+        Own<Operation> nested = operation();
+        return mk<T>(std::move(rel), ident, std::move(cond), std::move(queryPattern), std::move(nested),
+                str());
+    }
+
+    template <typename T>
+    Own<T> aggregateOp() {
+        Own<Operation> nested = operation();
+        const auto fun = enumValue<AggregateOp>();
+        std::string rel = str();
+        Own<Expression> expr = expression();
+        Own<Condition> cond = condition();
+        return mk<T>(std::move(nested), fun, std::move(rel), std::move(expr), std::move(cond),
+                static_cast<int>(i64()));
+    }
+
+    template <typename T>
+    Own<T> indexAggregate() {
+        Own<Operation> nested = operation();
+        const auto fun = enumValue<AggregateOp>();
+        std::string rel = str();
+        Own<Expression> expr = expression();
+        Own<Condition> cond = condition();
+        RamPattern queryPattern = pattern();
+        return mk<T>(std::move(nested), fun, std::move(rel), std::move(expr), std::move(cond),
+                std::move(queryPattern), static_cast<int>(i64()));
+    }
+
+    Own<Condition> condition() {
+        switch (tag()) {
+            case Tag::Conjunction: {
+                Own<Condition> lhs = condition();
+                return mk<Conjunction>(std::move(lhs), condition());
+            }
+            case Tag::Negation: return mk<Negation>(condition());
+            case Tag::Constraint: {
+                const auto op = enumValue<BinaryConstraintOp>();
+                Own<Expression> lhs = expression();
+                return mk<Constraint>(op, std::move(lhs), expression());
+            }
+            case Tag::True: return mk<True>();
+            case Tag::False: return mk<False>();
+            case Tag::EmptinessCheck: return mk<EmptinessCheck>(str());
+            case Tag::ExistenceCheck: {
+                std::string rel = str();
+                return mk<ExistenceCheck>(std::move(rel), expressions());
+            }
+            case Tag::ProvenanceExistenceCheck: {
+                std::string rel = str();
+                return mk<ProvenanceExistenceCheck>(std::move(rel), expressions());
+            }
+            default: throw std::runtime_error("invalid RAM condition tag");
+        }
+    }
+
+    Own<Expression> expression() {
+        switch (tag()) {
+            case Tag::TupleElement: {
+                const auto ident = static_cast<std::size_t>(i64());
+                return mk<TupleElement>(ident, u64());
+            }
+            case Tag::SignedConstant: return mk<SignedConstant>(static_cast<RamDomain>(i64()));
+            case Tag::UnsignedConstant:
+                return mk<UnsignedConstant>(ramBitCast<RamUnsigned>(static_cast<RamDomain>(i64())));
+            case Tag::FloatConstant:
+                return mk<FloatConstant>(ramBitCast<RamFloat>(static_cast<RamDomain>(i64())));
+            case Tag::StringConstant: return mk<StringConstant>(str());
+            case Tag::IntrinsicOperator: {
+                const auto op = enumValue<FunctorOp>();
+                return mk<IntrinsicOperator>(op, expressions());
+            }
+            case Tag::UserDefinedOperator: {
+                std::string name = str();
+                std::vector<TypeAttribute> argsTypes;
+                for (std::size_t i = u64(); i > 0; --i) {
+                    argsTypes.push_back(enumValue<TypeAttribute>());
+                }
+                const auto returnType = enumValue<TypeAttribute>();
+                const bool stateful = u64() != 0;
+                return mk<UserDefinedOperator>(
+                        std::move(name), std::move(argsTypes), returnType, stateful, expressions());
+            }
+            case Tag::SubroutineArgument: return mk<SubroutineArgument>(u64());
+            case Tag::AutoIncrement: return mk<AutoIncrement>();
+            case Tag::UndefValue: return mk<UndefValue>();
+            case Tag::PackRecord: return mk<PackRecord>(expressions());
+            case Tag::RelationSize: return mk<RelationSize>(str());
+            default: throw std::runtime_error("invalid RAM expression tag");
+        }
+    }
+};
+
+}  // namespace
+
+bool serialise(const Program& program, std::ostream& os) {
+    try {
+        Writer(os).write(program);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+    return os.good();
+}
+
+Own<Program> deserialise(std::istream& is) {
+    try {
+        return Reader(is).read();
+    } catch (const std::runtime_error&) {
+        return nullptr;
+    }
+}
+
+}  // namespace souffle::ram
@@ -0,0 +1,49 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Serialiser.h
+ *
+ * Reads and writes a RAM program in a compact binary form, so that a
+ * rerun of an unchanged interpreted program can restore the fully
+ * transformed program directly instead of repeating the parse, semantic
+ * check and transformation pipeline. The format is an internal cache
+ * format, not an interchange format: images are only expected to be read
+ * back by the binary that wrote them.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/utility/Types.h"
+#include <iosfwd>
+
+namespace souffle::ram {
+
+class Program;
+
+/**
+ * @brief Write the given program to the stream in binary form
+ *
+ * Returns false if the program contains a node kind the serialiser does
+ * not cover; nothing useful has been written to the stream in that case
+ * and the caller should discard it.
+ */
+bool serialise(const Program& program, std::ostream& os);
+
+/**
+ * @brief Reconstruct a program from the given binary image
+ *
+ * Returns nullptr if the stream does not hold a complete image of the
+ * expected format version; a stale or truncated cache entry is thereby
+ * rejected rather than diagnosed.
+ */
+Own<Program> deserialise(std::istream& is);
+
+}  // namespace souffle::ram
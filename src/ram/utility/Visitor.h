@@ -31,6 +31,7 @@
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
 #include "ram/Expression.h"
@@ -52,6 +53,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -110,6 +112,82 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
     R dispatch(NodeType& node, Params... args) override {
         // dispatch node processing based on dynamic type
 
+        // exact-type fast path: almost every node is an instance of one of
+        // the concrete kinds below, resolved by one type_info comparison each
+        const std::type_info& kind = typeid(node);
+
+        // Relation
+        SOUFFLE_VISITOR_FORWARD_EXACT(Relation);
+
+        // Expressions
+        SOUFFLE_VISITOR_FORWARD_EXACT(TupleElement);
+        SOUFFLE_VISITOR_FORWARD_EXACT(SignedConstant);
+        SOUFFLE_VISITOR_FORWARD_EXACT(UnsignedConstant);
+        SOUFFLE_VISITOR_FORWARD_EXACT(FloatConstant);
+        SOUFFLE_VISITOR_FORWARD_EXACT(StringConstant);
+        SOUFFLE_VISITOR_FORWARD_EXACT(IntrinsicOperator);
+        SOUFFLE_VISITOR_FORWARD_EXACT(UserDefinedOperator);
+        SOUFFLE_VISITOR_FORWARD_EXACT(AutoIncrement);
+        SOUFFLE_VISITOR_FORWARD_EXACT(PackRecord);
+        SOUFFLE_VISITOR_FORWARD_EXACT(SubroutineArgument);
+        SOUFFLE_VISITOR_FORWARD_EXACT(UndefValue);
+        SOUFFLE_VISITOR_FORWARD_EXACT(RelationSize);
+
+        // Conditions
+        SOUFFLE_VISITOR_FORWARD_EXACT(True);
+        SOUFFLE_VISITOR_FORWARD_EXACT(False);
+        SOUFFLE_VISITOR_FORWARD_EXACT(EmptinessCheck);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ProvenanceExistenceCheck);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ExistenceCheck);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Conjunction);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Negation);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Constraint);
+
+        // Operations
+        SOUFFLE_VISITOR_FORWARD_EXACT(Filter);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Break);
+        SOUFFLE_VISITOR_FORWARD_EXACT(GuardedInsert);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Insert);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Erase);
+        SOUFFLE_VISITOR_FORWARD_EXACT(SubroutineReturn);
+        SOUFFLE_VISITOR_FORWARD_EXACT(UnpackRecord);
+        SOUFFLE_VISITOR_FORWARD_EXACT(NestedIntrinsicOperator);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ParallelScan);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Scan);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ParallelIndexScan);
+        SOUFFLE_VISITOR_FORWARD_EXACT(IndexScan);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ParallelIfExists);
+        SOUFFLE_VISITOR_FORWARD_EXACT(IfExists);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ParallelIndexIfExists);
+        SOUFFLE_VISITOR_FORWARD_EXACT(IndexIfExists);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ParallelAggregate);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Aggregate);
+        SOUFFLE_VISITOR_FORWARD_EXACT(ParallelIndexAggregate);
+        SOUFFLE_VISITOR_FORWARD_EXACT(IndexAggregate);
+
+        // Statements
+        SOUFFLE_VISITOR_FORWARD_EXACT(IO);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Query);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Clear);
+        SOUFFLE_VISITOR_FORWARD_EXACT(LogSize);
+
+        SOUFFLE_VISITOR_FORWARD_EXACT(Swap);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Extend);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Merge);
+
+        // Control-flow
+        SOUFFLE_VISITOR_FORWARD_EXACT(Program);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Sequence);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Loop);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Parallel);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Exit);
+        SOUFFLE_VISITOR_FORWARD_EXACT(LogTimer);
+        SOUFFLE_VISITOR_FORWARD_EXACT(LogRelationTimer);
+        SOUFFLE_VISITOR_FORWARD_EXACT(DebugInfo);
+        SOUFFLE_VISITOR_FORWARD_EXACT(Call);
+
+        // RTTI fallback for node types not covered above
+
         // Relation
         SOUFFLE_VISITOR_FORWARD(Relation);
 
@@ -143,6 +221,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
         SOUFFLE_VISITOR_FORWARD(Break);
         SOUFFLE_VISITOR_FORWARD(GuardedInsert);
         SOUFFLE_VISITOR_FORWARD(Insert);
+        SOUFFLE_VISITOR_FORWARD(Erase);
         SOUFFLE_VISITOR_FORWARD(SubroutineReturn);
         SOUFFLE_VISITOR_FORWARD(UnpackRecord);
         SOUFFLE_VISITOR_FORWARD(NestedIntrinsicOperator);
@@ -167,6 +246,7 @@ struct Visitor : souffle::detail::VisitorBase<R, NodeType, Params...> {
 
         SOUFFLE_VISITOR_FORWARD(Swap);
         SOUFFLE_VISITOR_FORWARD(Extend);
+        SOUFFLE_VISITOR_FORWARD(Merge);
 
         // Control-flow
         SOUFFLE_VISITOR_FORWARD(Program);
@@ -194,6 +274,7 @@ protected:
 
     SOUFFLE_VISITOR_LINK(Swap, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(Extend, BinRelationStatement);
+    SOUFFLE_VISITOR_LINK(Merge, BinRelationStatement);
     SOUFFLE_VISITOR_LINK(BinRelationStatement, Statement);
 
     SOUFFLE_VISITOR_LINK(Sequence, ListStatement);
@@ -211,6 +292,7 @@ protected:
     // -- operations --
     SOUFFLE_VISITOR_LINK(GuardedInsert, Insert);
     SOUFFLE_VISITOR_LINK(Insert, Operation);
+    SOUFFLE_VISITOR_LINK(Erase, Operation);
     SOUFFLE_VISITOR_LINK(SubroutineReturn, Operation);
     SOUFFLE_VISITOR_LINK(UnpackRecord, TupleOperation);
     SOUFFLE_VISITOR_LINK(NestedIntrinsicOperator, TupleOperation)
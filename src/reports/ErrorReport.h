@@ -21,6 +21,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -147,7 +148,7 @@ class ErrorReport {
 public:
     ErrorReport(bool nowarn = false) : nowarn(nowarn) {}
 
-    ErrorReport(const ErrorReport& other) = default;
+    ErrorReport(const ErrorReport& other) : diagnostics(other.diagnostics), nowarn(other.nowarn) {}
 
     unsigned getNumErrors() const {
         return std::count_if(diagnostics.begin(), diagnostics.end(),
@@ -165,6 +166,7 @@ public:
 
     /** Adds an error with the given message and location */
     void addError(const std::string& message, SrcLocation location) {
+        std::lock_guard<std::mutex> guard(access);
         diagnostics.insert(
                 Diagnostic(Diagnostic::Type::ERROR, DiagnosticMessage(message, std::move(location))));
     }
@@ -172,12 +174,14 @@ public:
     /** Adds a warning with the given message and location */
     void addWarning(const std::string& message, SrcLocation location) {
         if (!nowarn) {
+            std::lock_guard<std::mutex> guard(access);
             diagnostics.insert(
                     Diagnostic(Diagnostic::Type::WARNING, DiagnosticMessage(message, std::move(location))));
         }
     }
 
     void addDiagnostic(const Diagnostic& diagnostic) {
+        std::lock_guard<std::mutex> guard(access);
         diagnostics.insert(diagnostic);
     }
 
@@ -204,6 +208,9 @@ public:
 private:
     std::set<Diagnostic> diagnostics;
     bool nowarn;
+    /** Checkers report from parallel clause checks; the diagnostics stay
+     * ordered by the set regardless of insertion order. */
+    std::mutex access;
 };
 
 }  // end of namespace souffle
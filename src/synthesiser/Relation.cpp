@@ -43,6 +43,50 @@ std::string Relation::getTypeAttributeString(const std::vector<std::string>& att
     return type.str();
 }
 
+/** Generates the addHintStatistics method publishing the hint hit/miss
+ * counters of the given number of b-tree indices to the profile; a no-op
+ * unless the program is compiled with _SOUFFLE_STATS (verbose mode) */
+static void generateHintStatisticsMethod(std::ostream& out, std::size_t numIndexes) {
+    out << "void addHintStatistics(const std::string& relationName) const {\n";
+    out << "#ifdef _SOUFFLE_STATS\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        out << "{\n";
+        out << "const auto& stats = ind_" << i << ".getHintStatistics();\n";
+        out << "const std::string prefix = \"@hint-stats;\" + relationName + \";index-" << i << ";\";\n";
+        out << "ProfileEventSingleton::instance().makeHintStatsEvent(prefix + \"insert\", "
+               "stats.inserts.getHits(), stats.inserts.getMisses());\n";
+        out << "ProfileEventSingleton::instance().makeHintStatsEvent(prefix + \"contains\", "
+               "stats.contains.getHits(), stats.contains.getMisses());\n";
+        out << "ProfileEventSingleton::instance().makeHintStatsEvent(prefix + \"lower-bound\", "
+               "stats.lower_bound.getHits(), stats.lower_bound.getMisses());\n";
+        out << "ProfileEventSingleton::instance().makeHintStatsEvent(prefix + \"upper-bound\", "
+               "stats.upper_bound.getHits(), stats.upper_bound.getMisses());\n";
+        out << "}\n";
+    }
+    out << "#else\n";
+    out << "(void)relationName;\n";
+    out << "#endif\n";
+    out << "}\n";
+}
+
+/** Determines whether every indexed access of a relation is a point lookup
+ * over its full signature, i.e. the relation is never subject to range
+ * queries and requires no ordered index */
+static bool usesPointLookupsOnly(const ram::analysis::IndexCluster& indexSelection) {
+    const auto& searches = indexSelection.getSearches();
+    if (searches.empty()) {
+        return false;
+    }
+    for (const auto& search : searches) {
+        for (std::size_t i = 0; i < search.arity(); i++) {
+            if (search[i] != ram::analysis::AttributeConstraint::Equal) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 Own<Relation> Relation::getSynthesiserRelation(
         const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection, bool isProvenance) {
     Relation* rel;
@@ -58,11 +102,25 @@ Own<Relation> Relation::getSynthesiserRelation(
         rel = new BrieRelation(ramRel, indexSelection, isProvenance);
     } else if (ramRel.getRepresentation() == RelationRepresentation::EQREL) {
         rel = new EqrelRelation(ramRel, indexSelection, isProvenance);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::INTERVAL) {
+        rel = new IntervalRelation(ramRel, indexSelection, isProvenance);
     } else if (ramRel.getRepresentation() == RelationRepresentation::INFO) {
         rel = new InfoRelation(ramRel, indexSelection, isProvenance);
     } else {
         // Handle the data structure command line flag
-        if (ramRel.getArity() > 6) {
+        if (!ramRel.isTemp() && usesPointLookupsOnly(indexSelection)) {
+            // existence-only relations do not require an ordered index;
+            // temporary relations are excluded since they are swapped with
+            // their sibling temporaries, which may be indexed differently
+            if (ramRel.getArity() == 1) {
+                // unary predicates reduce to the brie's sparse bit map: one
+                // bit per element on dense domains, and a membership test
+                // that is a single load and mask
+                rel = new BrieRelation(ramRel, indexSelection, isProvenance);
+            } else {
+                rel = new HashsetRelation(ramRel, indexSelection, isProvenance);
+            }
+        } else if (ramRel.getArity() > 6) {
             rel = new IndirectRelation(ramRel, indexSelection, isProvenance);
         } else {
             rel = new DirectRelation(ramRel, indexSelection, isProvenance);
@@ -182,6 +240,13 @@ std::string DirectRelation::getTypeName() {
         res << "__" << search;
     }
 
+    // temporary relations keep their secondary indexes eager and pool their
+    // node storage, which changes the generated struct body; keep their type
+    // distinct from structurally identical non-temporary relations
+    if (relation.isTemp()) {
+        res << "__tmp";
+    }
+
     return res.str();
 }
 
@@ -194,6 +259,36 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
     std::size_t numIndexes = inds.size();
     std::map<LexOrder, int> indexToNumMap;
 
+    // existence checks over the full tuple can be pruned by an approximate
+    // membership filter before descending into the master index; provenance
+    // relations are excluded since their weak comparators ignore the
+    // auxiliary attributes, which a full-tuple hash cannot
+    bool hasFilter = false;
+    if (!isProvenance && arity > 0) {
+        for (auto& search : indexSelection.getSearches()) {
+            bool isTotal = true;
+            for (std::size_t column = 0; column < arity; column++) {
+                if (search[column] != analysis::AttributeConstraint::Equal) {
+                    isTotal = false;
+                }
+            }
+            hasFilter = hasFilter || isTotal;
+        }
+    }
+
+    // secondary indexes of non-temporary relations are materialised from the
+    // master index the first time a search needs them, so relations whose
+    // secondary searches only occur in later strata (or never) do not pay
+    // their maintenance during insertion; temporary relations are excluded
+    // since they are rebuilt every iteration anyway. This matters most for
+    // provenance relations, where every search order is expanded to a full
+    // index carrying the annotation columns: secondaries only searched by
+    // the top-down proof phase are not built (nor kept up to date) during
+    // bottom-up evaluation at all. Annotation updates stay consistent, as
+    // built secondaries see them through the regular insert path and
+    // unbuilt ones copy the master's current tuples when materialised.
+    bool lazySecondaries = !relation.isTemp() && numIndexes > 1;
+
     // struct definition
     out << "struct " << getTypeName() << " {\n";
     out << "static constexpr Relation::arity_type Arity = " << arity << ";\n";
@@ -287,7 +382,27 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
         };
 
         std::string comparator = "t_comparator_" + std::to_string(i);
-        genstruct(comparator, ind.size());
+
+        // indices whose attributes are all signed can alias the library's
+        // generic comparator template instead of a bespoke struct; equal
+        // (arity, order) combinations then denote the same btree
+        // specialisation in every generated program, letting the
+        // precompiled common instantiations cover them
+        bool sharedComparator = !isProvenance;
+        for (std::size_t attrib : ind) {
+            if (types[attrib][0] == 'f' || types[attrib][0] == 'u') {
+                sharedComparator = false;
+            }
+        }
+        if (sharedComparator) {
+            out << "using " << comparator << " = signed_tuple_comparator<t_tuple";
+            for (std::size_t attrib : ind) {
+                out << "," << attrib;
+            }
+            out << ">;\n";
+        } else {
+            genstruct(comparator, ind.size());
+        }
 
         // for provenance, all indices must be full so we use btree_set
         // also strong/weak comparators and updater methods
@@ -307,14 +422,82 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
                    "souffle::detail::default_strategy<t_tuple>::type,"
                 << comparator_aux << ",updater_" << getTypeName() << ">;\n";
         } else {
+            // temporary relations are filled and purged every iteration of a
+            // fixpoint; their node storage is recycled through a free pool
+            // instead of round-tripping the allocator
+            const std::string allocator =
+                    relation.isTemp() ? "souffle::detail::pool_allocation" : "std::allocator<t_tuple>";
             if (ind.size() == arity) {
-                out << "using t_ind_" << i << " = btree_set<t_tuple," << comparator << ">;\n";
+                if (arity == 1 && types[0][0] != 'f' && types[0][0] != 'u') {
+                    // a single signed 32-bit attribute in natural order can use the
+                    // vectorised node search
+                    out << "using t_ind_" << i << " = btree_set<t_tuple," << comparator << "," << allocator
+                        << ",256,souffle::detail::simd_search>;\n";
+                } else {
+                    out << "using t_ind_" << i << " = btree_set<t_tuple," << comparator << "," << allocator
+                        << ">;\n";
+                }
             } else {
                 // without provenance, some indices may be not full, so we use btree_multiset for those
-                out << "using t_ind_" << i << " = btree_multiset<t_tuple," << comparator << ">;\n";
+                out << "using t_ind_" << i << " = btree_multiset<t_tuple," << comparator << "," << allocator
+                    << ">;\n";
             }
         }
-        out << "t_ind_" << i << " ind_" << i << ";\n";
+        if (lazySecondaries && i != masterIndex) {
+            out << "mutable t_ind_" << i << " ind_" << i << ";\n";
+        } else {
+            out << "t_ind_" << i << " ind_" << i << ";\n";
+        }
+    }
+
+    // deferred materialisation of the secondary indexes: a bulk build sorts
+    // the tuples of the master index into the order of the secondary and
+    // replays them with hinted inserts; double-checked locking keeps the
+    // build safe against concurrent readers, while writers cannot interleave
+    // since a relation is never inserted into and searched in the same query
+    if (lazySecondaries) {
+        for (std::size_t i = 0; i < numIndexes; i++) {
+            if (i == masterIndex) {
+                continue;
+            }
+            out << "mutable std::atomic<bool> ind_" << i << "_built{false};\n";
+        }
+        out << "mutable std::mutex materialise_lock;\n";
+        for (std::size_t i = 0; i < numIndexes; i++) {
+            if (i == masterIndex) {
+                continue;
+            }
+            out << "void materialise_" << i << "() const {\n";
+            out << "if (ind_" << i << "_built.load(std::memory_order_acquire)) return;\n";
+            out << "const std::lock_guard<std::mutex> guard(materialise_lock);\n";
+            out << "if (ind_" << i << "_built.load(std::memory_order_relaxed)) return;\n";
+            out << "std::vector<t_tuple> tuples(ind_" << masterIndex << ".begin(), ind_" << masterIndex
+                << ".end());\n";
+            out << "std::sort(tuples.begin(), tuples.end(), [](const t_tuple& a, const t_tuple& b) { return "
+                   "t_comparator_"
+                << i << "().less(a, b); });\n";
+            out << "t_ind_" << i << "::operation_hints hints;\n";
+            out << "for (const auto& cur : tuples) {\n";
+            out << "ind_" << i << ".insert(cur, hints);\n";
+            out << "}\n";
+            out << "ind_" << i << "_built.store(true, std::memory_order_release);\n";
+            out << "}\n";
+        }
+    }
+
+    // the filter is consulted on existence checks and fed on insertions
+    if (hasFilter) {
+        out << "struct t_hasher {\n";
+        out << "std::size_t operator()(const t_tuple& t) const {\n";
+        out << "std::size_t seed = 0;\n";
+        for (std::size_t i = 0; i < arity; i++) {
+            out << "seed ^= static_cast<std::size_t>(ramBitCast<RamUnsigned>(t[" << i
+                << "])) + 0x9e3779b9 + (seed << 6) + (seed >> 2);\n";
+        }
+        out << "return seed;\n";
+        out << "}\n";
+        out << "};\n";
+        out << "BloomFilter filter;\n";
     }
 
     // typedef master index iterator to be struct iterator
@@ -342,10 +525,17 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
         << ")) {\n";
     for (std::size_t i = 0; i < numIndexes; i++) {
         if (i != masterIndex && provenanceIndexNumbers.find(i) == provenanceIndexNumbers.end()) {
+            if (lazySecondaries) {
+                // unbuilt secondaries pick the tuple up when materialised
+                out << "if (ind_" << i << "_built.load(std::memory_order_relaxed)) ";
+            }
             out << "ind_" << i << ".insert(t, h.hints_" << i << "_lower"
                 << ");\n";
         }
     }
+    if (hasFilter) {
+        out << "filter.insert(t_hasher()(t));\n";
+    }
     out << "return true;\n";
     out << "} else return false;\n";
     out << "}\n";  // end of insert(t_tuple&, context&)
@@ -369,8 +559,101 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
     out << "return insert(data);\n";
     out << "}\n";  // end of insert(RamDomain x1, RamDomain x2, ...)
 
+    // ordered bulk insertion: an empty relation builds its master index
+    // bottom-up from the ordered sequence (the tree itself falls back if the
+    // sequence turns out unordered) and replays the tuples into the built
+    // secondaries and the filter; a non-empty relation takes the ordinary
+    // insertion. Provenance relations are excluded, since their master
+    // updates weakly equal tuples on insertion.
+    if (!isProvenance) {
+        out << "void insertSorted(const RamDomain* ramDomain, std::size_t numTuples) {\n";
+        out << "const t_tuple* tuples = reinterpret_cast<const t_tuple*>(ramDomain);\n";
+        out << "if (!empty()) {\n";
+        out << "for (std::size_t i = 0; i < numTuples; i++) insert(tuples[i]);\n";
+        out << "return;\n";
+        out << "}\n";
+        out << "ind_" << masterIndex << ".insert_sorted(tuples, tuples + numTuples);\n";
+        if (hasFilter || numIndexes > 1) {
+            if (numIndexes > 1) {
+                out << "context h;\n";
+            }
+            out << "for (std::size_t i = 0; i < numTuples; i++) {\n";
+            out << "const t_tuple& t = tuples[i];\n";
+            for (std::size_t i = 0; i < numIndexes; i++) {
+                if (i != masterIndex) {
+                    if (lazySecondaries) {
+                        // unbuilt secondaries pick the tuples up when materialised
+                        out << "if (ind_" << i << "_built.load(std::memory_order_relaxed)) ";
+                    }
+                    out << "ind_" << i << ".insert(t, h.hints_" << i << "_lower"
+                        << ");\n";
+                }
+            }
+            if (hasFilter) {
+                out << "filter.insert(t_hasher()(t));\n";
+            }
+            out << "}\n";
+        }
+        out << "}\n";  // end of insertSorted(RamDomain*, std::size_t)
+    }
+
+    // erase method; dominated tuples are removed from every built index.
+    // A stale bloom filter entry merely costs a redundant index probe, so
+    // the filter is left untouched.
+    out << "bool erase(const t_tuple& t) {\n";
+    out << "if (ind_" << masterIndex << ".erase(t)) {\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        if (i != masterIndex && provenanceIndexNumbers.find(i) == provenanceIndexNumbers.end()) {
+            if (lazySecondaries) {
+                // unbuilt secondaries never saw the tuple in the first place
+                out << "if (ind_" << i << "_built.load(std::memory_order_relaxed)) ";
+            }
+            out << "ind_" << i << ".erase(t);\n";
+        }
+    }
+    out << "return true;\n";
+    out << "} else return false;\n";
+    out << "}\n";  // end of erase(t_tuple&)
+
+    // insertAll methods: a source of the same type is merged tree by tree,
+    // any other source is inserted tuple by tuple
+    out << "void insertAll(" << getTypeName() << "& other) {\n";
+    if (hasFilter) {
+        // merged trees bypass insert(), so the filter is fed separately
+        out << "for (auto const& cur : other.ind_" << masterIndex << ") {\n";
+        out << "filter.insert(t_hasher()(cur));\n";
+        out << "}\n";
+    }
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        if (provenanceIndexNumbers.find(i) == provenanceIndexNumbers.end()) {
+            if (lazySecondaries && i != masterIndex) {
+                // the other side's secondary may be unbuilt, so built
+                // secondaries are fed from the other side's master instead
+                out << "if (ind_" << i << "_built.load(std::memory_order_relaxed)) {\n";
+                out << "for (auto const& cur : other.ind_" << masterIndex << ") {\n";
+                out << "ind_" << i << ".insert(cur);\n";
+                out << "}\n";
+                out << "}\n";
+            } else {
+                out << "ind_" << i << ".insertAll(other.ind_" << i << ");\n";
+            }
+        }
+    }
+    out << "}\n";  // end of insertAll(t_this&)
+
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";  // end of insertAll(T&)
+
     // contains methods
     out << "bool contains(const t_tuple& t, context& h) const {\n";
+    if (hasFilter) {
+        // a negative filter probe saves the descent into the index
+        out << "if (!filter.mayContain(t_hasher()(t))) return false;\n";
+    }
     out << "return ind_" << masterIndex << ".contains(t, h.hints_" << masterIndex << "_lower"
         << ");\n";
     out << "}\n";
@@ -418,6 +701,10 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
         out << "range<t_ind_" << indNum << "::iterator> lowerUpperRange_" << search;
         out << "(const t_tuple& lower, const t_tuple& upper, context& h) const {\n";
 
+        if (lazySecondaries && indNum != masterIndex) {
+            out << "materialise_" << indNum << "();\n";
+        }
+
         // count size of search pattern
         std::size_t eqSize = 0;
         for (std::size_t column = 0; column < arity; column++) {
@@ -472,6 +759,12 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
     out << "void purge() {\n";
     for (std::size_t i = 0; i < numIndexes; i++) {
         out << "ind_" << i << ".clear();\n";
+        if (lazySecondaries && i != masterIndex) {
+            out << "ind_" << i << "_built.store(false, std::memory_order_relaxed);\n";
+        }
+    }
+    if (hasFilter) {
+        out << "filter.clear();\n";
     }
     out << "}\n";
 
@@ -504,6 +797,17 @@ void DirectRelation::generateTypeStruct(std::ostream& out) {
     }
     out << "}\n";
 
+    generateHintStatisticsMethod(out, numIndexes);
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return sizeof(*this)";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        out << " + ind_" << i << ".getMemoryUsage()";
+    }
+    out << ";\n";
+    out << "}\n";
+
     // end struct
     out << "};\n";
 }  // namespace souffle
@@ -564,6 +868,13 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
     std::size_t numIndexes = inds.size();
     std::map<LexOrder, int> indexToNumMap;
 
+    // indexes over a narrow part of a wide tuple inline their key columns
+    // next to the table reference, so searches and comparisons do not pull
+    // the full rows of the data table through the cache
+    auto isColumnar = [&](std::size_t i) {
+        return i != masterIndex && 2 * inds[i].size() <= arity;
+    };
+
     // struct definition
     out << "struct " << getTypeName() << " {\n";
     out << "static constexpr Relation::arity_type Arity = " << arity << ";\n";
@@ -596,58 +907,116 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
 
         std::string comparator = "t_comparator_" + std::to_string(i);
 
-        out << "struct " << comparator << "{\n";
-        out << " int operator()(const t_tuple *a, const t_tuple *b) const {\n";
-        out << "  return ";
-        std::function<void(std::size_t)> gencmp = [&](std::size_t i) {
-            std::size_t attrib = ind[i];
-            const auto& typecast = typecasts[attrib];
-            out << "(" << typecast << "((*a)[" << attrib << "]) <" << typecast << " ((*b)[" << attrib
-                << "])) ? -1 : ((" << typecast << "((*a)[" << attrib << "]) > " << typecast << "((*b)["
-                << attrib << "])) ? 1 :(";
-            if (i + 1 < ind.size()) {
-                gencmp(i + 1);
-            } else {
-                out << "0";
-            }
-            out << "))";
-        };
-        gencmp(0);
-        out << ";\n }\n";
-        out << "bool less(const t_tuple *a, const t_tuple *b) const {\n";
-        out << "  return ";
-        std::function<void(std::size_t)> genless = [&](std::size_t i) {
-            std::size_t attrib = ind[i];
-            const auto& typecast = typecasts[attrib];
-            out << typecast << " ((*a)[" << attrib << "]) < " << typecast << "((*b)[" << attrib << "])";
-            if (i + 1 < ind.size()) {
-                out << "|| (" << typecast << "((*a)[" << attrib << "]) == " << typecast << "((*b)[" << attrib
-                    << "]) && (";
-                genless(i + 1);
+        if (isColumnar(i)) {
+            // the key columns of the index are stored in lex-order next to
+            // a reference to the full tuple within the data table
+            out << "struct t_entry_" << i << " {\n";
+            out << "RamDomain key[" << ind.size() << "];\n";
+            out << "const t_tuple* rec;\n";
+            out << "};\n";
+
+            out << "struct " << comparator << "{\n";
+            out << " int operator()(const t_entry_" << i << "& a, const t_entry_" << i
+                << "& b) const {\n";
+            out << "  return ";
+            std::function<void(std::size_t)> gencmp = [&](std::size_t j) {
+                const auto& typecast = typecasts[ind[j]];
+                out << "(" << typecast << "(a.key[" << j << "]) <" << typecast << " (b.key[" << j
+                    << "])) ? -1 : ((" << typecast << "(a.key[" << j << "]) > " << typecast << "(b.key["
+                    << j << "])) ? 1 :(";
+                if (j + 1 < ind.size()) {
+                    gencmp(j + 1);
+                } else {
+                    out << "0";
+                }
                 out << "))";
-            }
-        };
-        genless(0);
-        out << ";\n }\n";
-        out << "bool equal(const t_tuple *a, const t_tuple *b) const {\n";
-        out << "return ";
-        std::function<void(std::size_t)> geneq = [&](std::size_t i) {
-            std::size_t attrib = ind[i];
-            const auto& typecast = typecasts[attrib];
-            out << typecast << "((*a)[" << attrib << "]) == " << typecast << "((*b)[" << attrib << "])";
-            if (i + 1 < ind.size()) {
-                out << "&&";
-                geneq(i + 1);
-            }
-        };
-        geneq(0);
-        out << ";\n }\n";
-        out << "};\n";
+            };
+            gencmp(0);
+            out << ";\n }\n";
+            out << "bool less(const t_entry_" << i << "& a, const t_entry_" << i << "& b) const {\n";
+            out << "  return ";
+            std::function<void(std::size_t)> genless = [&](std::size_t j) {
+                const auto& typecast = typecasts[ind[j]];
+                out << typecast << " (a.key[" << j << "]) < " << typecast << "(b.key[" << j << "])";
+                if (j + 1 < ind.size()) {
+                    out << "|| (" << typecast << "(a.key[" << j << "]) == " << typecast << "(b.key[" << j
+                        << "]) && (";
+                    genless(j + 1);
+                    out << "))";
+                }
+            };
+            genless(0);
+            out << ";\n }\n";
+            out << "bool equal(const t_entry_" << i << "& a, const t_entry_" << i << "& b) const {\n";
+            out << "return ";
+            std::function<void(std::size_t)> geneq = [&](std::size_t j) {
+                const auto& typecast = typecasts[ind[j]];
+                out << typecast << "(a.key[" << j << "]) == " << typecast << "(b.key[" << j << "])";
+                if (j + 1 < ind.size()) {
+                    out << "&&";
+                    geneq(j + 1);
+                }
+            };
+            geneq(0);
+            out << ";\n }\n";
+            out << "};\n";
 
-        if (ind.size() == arity) {
-            out << "using t_ind_" << i << " = btree_set<const t_tuple*," << comparator << ">;\n";
+            out << "using t_ind_" << i << " = btree_multiset<t_entry_" << i << "," << comparator
+                << ">;\n";
         } else {
-            out << "using t_ind_" << i << " = btree_multiset<const t_tuple*," << comparator << ">;\n";
+            out << "struct " << comparator << "{\n";
+            out << " int operator()(const t_tuple *a, const t_tuple *b) const {\n";
+            out << "  return ";
+            std::function<void(std::size_t)> gencmp = [&](std::size_t i) {
+                std::size_t attrib = ind[i];
+                const auto& typecast = typecasts[attrib];
+                out << "(" << typecast << "((*a)[" << attrib << "]) <" << typecast << " ((*b)[" << attrib
+                    << "])) ? -1 : ((" << typecast << "((*a)[" << attrib << "]) > " << typecast << "((*b)["
+                    << attrib << "])) ? 1 :(";
+                if (i + 1 < ind.size()) {
+                    gencmp(i + 1);
+                } else {
+                    out << "0";
+                }
+                out << "))";
+            };
+            gencmp(0);
+            out << ";\n }\n";
+            out << "bool less(const t_tuple *a, const t_tuple *b) const {\n";
+            out << "  return ";
+            std::function<void(std::size_t)> genless = [&](std::size_t i) {
+                std::size_t attrib = ind[i];
+                const auto& typecast = typecasts[attrib];
+                out << typecast << " ((*a)[" << attrib << "]) < " << typecast << "((*b)[" << attrib << "])";
+                if (i + 1 < ind.size()) {
+                    out << "|| (" << typecast << "((*a)[" << attrib << "]) == " << typecast << "((*b)["
+                        << attrib << "]) && (";
+                    genless(i + 1);
+                    out << "))";
+                }
+            };
+            genless(0);
+            out << ";\n }\n";
+            out << "bool equal(const t_tuple *a, const t_tuple *b) const {\n";
+            out << "return ";
+            std::function<void(std::size_t)> geneq = [&](std::size_t i) {
+                std::size_t attrib = ind[i];
+                const auto& typecast = typecasts[attrib];
+                out << typecast << "((*a)[" << attrib << "]) == " << typecast << "((*b)[" << attrib << "])";
+                if (i + 1 < ind.size()) {
+                    out << "&&";
+                    geneq(i + 1);
+                }
+            };
+            geneq(0);
+            out << ";\n }\n";
+            out << "};\n";
+
+            if (ind.size() == arity) {
+                out << "using t_ind_" << i << " = btree_set<const t_tuple*," << comparator << ">;\n";
+            } else {
+                out << "using t_ind_" << i << " = btree_multiset<const t_tuple*," << comparator << ">;\n";
+            }
         }
 
         out << "t_ind_" << i << " ind_" << i << ";\n";
@@ -655,7 +1024,17 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
 
     // typedef deref iterators
     for (std::size_t i = 0; i < numIndexes; i++) {
-        out << "using iterator_" << i << " = IterDerefWrapper<typename t_ind_" << i << "::iterator>;\n";
+        if (isColumnar(i)) {
+            // project the entries of columnar indexes back to the full tuples
+            out << "struct t_deref_" << i << " {\n";
+            out << "const t_tuple& operator()(const t_entry_" << i << "& e) const { return *e.rec; }\n";
+            out << "};\n";
+            out << "using iterator_" << i << " = TransformIterator<typename t_ind_" << i
+                << "::iterator, t_deref_" << i << ">;\n";
+        } else {
+            out << "using iterator_" << i << " = IterDerefWrapper<typename t_ind_" << i
+                << "::iterator>;\n";
+        }
     }
     out << "using iterator = iterator_" << masterIndex << ";\n";
 
@@ -684,8 +1063,18 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
     out << "}\n";
     for (std::size_t i = 0; i < numIndexes; i++) {
         if (i != masterIndex) {
-            out << "ind_" << i << ".insert(masterCopy, h.hints_" << i << "_lower"
-                << ");\n";
+            if (isColumnar(i)) {
+                std::vector<std::string> columns;
+                for (auto attr : inds[i]) {
+                    columns.push_back("t[" + std::to_string(attr) + "]");
+                }
+                out << "ind_" << i << ".insert(t_entry_" << i << "{{" << join(columns, ",")
+                    << "},masterCopy}, h.hints_" << i << "_lower"
+                    << ");\n";
+            } else {
+                out << "ind_" << i << ".insert(masterCopy, h.hints_" << i << "_lower"
+                    << ");\n";
+            }
         }
     }
     out << "return true;\n";
@@ -710,6 +1099,14 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
     out << "return insert(data);\n";
     out << "}\n";  // end of insert(RamDomain x1, RamDomain x2, ...)
 
+    // generic insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";  // end of insertAll(T&)
+
     // contains methods
     out << "bool contains(const t_tuple& t, context& h) const {\n";
     out << "return ind_" << masterIndex << ".contains(&t, h.hints_" << masterIndex << "_lower"
@@ -765,6 +1162,44 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
             }
         }
 
+        if (isColumnar(indNum)) {
+            // project the bounds onto the inlined key columns of the index
+            std::vector<std::string> lowerColumns;
+            std::vector<std::string> upperColumns;
+            for (auto attr : inds[indNum]) {
+                lowerColumns.push_back("lower[" + std::to_string(attr) + "]");
+                upperColumns.push_back("upper[" + std::to_string(attr) + "]");
+            }
+            out << "t_entry_" << indNum << " lowerEntry{{" << join(lowerColumns, ",")
+                << "},nullptr};\n";
+            out << "t_entry_" << indNum << " upperEntry{{" << join(upperColumns, ",")
+                << "},nullptr};\n";
+
+            out << "t_comparator_" << indNum << " comparator;\n";
+            out << "int cmp = comparator(lowerEntry, upperEntry);\n";
+
+            // if lower > upper then we have an empty range
+            out << "if (cmp > 0) {\n";
+            out << "    return range<iterator_" << indNum << ">(ind_" << indNum << ".end(), ind_" << indNum
+                << ".end());\n";
+            out << "}\n";
+
+            out << "return range<iterator_" << indNum << ">(ind_" << indNum
+                << ".lower_bound(lowerEntry, h.hints_" << indNum << "_lower"
+                << "), ind_" << indNum << ".upper_bound(upperEntry, h.hints_" << indNum << "_upper"
+                << "));\n";
+
+            out << "}\n";
+
+            out << "range<iterator_" << indNum << "> lowerUpperRange_" << search;
+            out << "(const t_tuple& lower, const t_tuple& upper) const {\n";
+
+            out << "context h;\n";
+            out << "return lowerUpperRange_" << search << "(lower, upper, h);\n";
+            out << "}\n";
+            continue;
+        }
+
         out << "t_comparator_" << indNum << " comparator;\n";
         out << "int cmp = comparator(&lower, &upper);\n";
 
@@ -840,6 +1275,17 @@ void IndirectRelation::generateTypeStruct(std::ostream& out) {
     }
     out << "}\n";
 
+    generateHintStatisticsMethod(out, numIndexes);
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return sizeof(*this) + dataTable.getMemoryUsage()";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        out << " + ind_" << i << ".getMemoryUsage()";
+    }
+    out << ";\n";
+    out << "}\n";
+
     // end struct
     out << "};\n";
 }
@@ -1008,6 +1454,14 @@ void BrieRelation::generateTypeStruct(std::ostream& out) {
     out << "return insert(data);\n";
     out << "}\n";
 
+    // generic insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";  // end of insertAll(T&)
+
     // contains methods
     out << "bool contains(const t_tuple& t, context& h) const {\n";
     out << "return ind_" << masterIndex << ".contains(orderIn_" << masterIndex << "(t), h.hints_"
@@ -1114,6 +1568,18 @@ void BrieRelation::generateTypeStruct(std::ostream& out) {
     }
     out << "}\n";
 
+    // no hint statistics tracked by brie indices
+    out << "void addHintStatistics(const std::string&) const {}\n";
+
+    // getMemoryUsage method
+    out << "std::size_t getMemoryUsage() const {\n";
+    out << "return sizeof(*this)";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        out << " + ind_" << i << ".getMemoryUsage()";
+    }
+    out << ";\n";
+    out << "}\n";
+
     // orderOut and orderIn methods for reordering tuples according to index orders
     for (std::size_t i = 0; i < numIndexes; i++) {
         auto ind = inds[i];
@@ -1138,6 +1604,307 @@ void BrieRelation::generateTypeStruct(std::ostream& out) {
     out << "};\n";
 }
 
+// -------- Hashset Relation --------
+
+/** Generate index set for a hashset relation, which is the single hash index */
+void HashsetRelation::computeIndices() {
+    assert(!isProvenance && "hashset indexes cannot be used for provenance");
+    masterIndex = 0;
+    computedIndices = indexSelection.getAllOrders();
+}
+
+/** Generate type name of a hashset relation */
+std::string HashsetRelation::getTypeName() {
+    // all attributes contribute to the hash
+    std::unordered_set<uint32_t> attributesUsed;
+    for (std::size_t i = 0; i < getArity(); i++) {
+        attributesUsed.insert(i);
+    }
+
+    std::stringstream res;
+    res << "t_hashset_" << getTypeAttributeString(relation.getAttributeTypes(), attributesUsed);
+    return res.str();
+}
+
+/** Generate type struct of a hashset relation */
+void HashsetRelation::generateTypeStruct(std::ostream& out) {
+    std::size_t arity = getArity();
+
+    // struct definition
+    out << "struct " << getTypeName() << " {\n";
+    out << "static constexpr Relation::arity_type Arity = " << arity << ";\n";
+
+    // stored tuple type
+    out << "using t_tuple = Tuple<RamDomain, " << arity << ">;\n";
+
+    // hash all attributes of a tuple into a single probing position
+    out << "struct t_hasher {\n";
+    out << "std::size_t operator()(const t_tuple& t) const {\n";
+    out << "std::size_t seed = 0;\n";
+    for (std::size_t i = 0; i < arity; i++) {
+        out << "seed ^= static_cast<std::size_t>(ramBitCast<RamUnsigned>(t[" << i
+            << "])) + 0x9e3779b9 + (seed << 6) + (seed >> 2);\n";
+    }
+    out << "return seed;\n";
+    out << "}\n";
+    out << "};\n";
+
+    out << "using t_ind_0 = ConcurrentInsertOnlyHashSet<t_tuple, t_hasher>;\n";
+    out << "t_ind_0 ind_0;\n";
+    out << "using iterator = t_ind_0::iterator;\n";
+
+    // the hash set requires no operation hints
+    out << "struct context {\n";
+    out << "};\n";
+    out << "context createContext() { return context(); }\n";
+
+    // insert methods
+    out << "bool insert(const t_tuple& t) {\n";
+    out << "return ind_0.insert(t);\n";
+    out << "}\n";  // end of insert(t_tuple&)
+
+    out << "bool insert(const t_tuple& t, context& /* h */) {\n";
+    out << "return ind_0.insert(t);\n";
+    out << "}\n";  // end of insert(t_tuple&, context&)
+
+    out << "bool insert(const RamDomain* ramDomain) {\n";
+    out << "RamDomain data[" << arity << "];\n";
+    out << "std::copy(ramDomain, ramDomain + " << arity << ", data);\n";
+    out << "const t_tuple& tuple = reinterpret_cast<const t_tuple&>(data);\n";
+    out << "return insert(tuple);\n";
+    out << "}\n";  // end of insert(RamDomain*)
+
+    std::vector<std::string> decls;
+    std::vector<std::string> params;
+    for (std::size_t i = 0; i < arity; i++) {
+        decls.push_back("RamDomain a" + std::to_string(i));
+        params.push_back("a" + std::to_string(i));
+    }
+    out << "bool insert(" << join(decls, ",") << ") {\n";
+    out << "RamDomain data[" << arity << "] = {" << join(params, ",") << "};\n";
+    out << "return insert(data);\n";
+    out << "}\n";  // end of insert(RamDomain x1, RamDomain x2, ...)
+
+    // insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";  // end of insertAll(T&)
+
+    // contains methods
+    out << "bool contains(const t_tuple& t, context& /* h */) const {\n";
+    out << "return ind_0.contains(t);\n";
+    out << "}\n";
+
+    out << "bool contains(const t_tuple& t) const {\n";
+    out << "return ind_0.contains(t);\n";
+    out << "}\n";
+
+    // size method
+    out << "std::size_t size() const {\n";
+    out << "return ind_0.size();\n";
+    out << "}\n";
+
+    // empty lowerUpperRange method
+    out << "range<iterator> lowerUpperRange_" << SearchSignature(arity)
+        << "(const t_tuple& /* lower */, const t_tuple& /* upper */, context& /* h */) const {\n";
+    out << "return make_range(ind_0.begin(), ind_0.end());\n";
+    out << "}\n";
+
+    out << "range<iterator> lowerUpperRange_" << SearchSignature(arity)
+        << "(const t_tuple& /* lower */, const t_tuple& /* upper */) const {\n";
+    out << "return make_range(ind_0.begin(), ind_0.end());\n";
+    out << "}\n";
+
+    // all searches of this relation are point lookups over the full
+    // signature, thus each range is at most a single element
+    for (auto search : indexSelection.getSearches()) {
+        out << "range<iterator> lowerUpperRange_" << search;
+        out << "(const t_tuple& lower, const t_tuple& /* upper */, context& /* h */) const {\n";
+        out << "return ind_0.equalRange(lower);\n";
+        out << "}\n";
+
+        out << "range<iterator> lowerUpperRange_" << search;
+        out << "(const t_tuple& lower, const t_tuple& /* upper */) const {\n";
+        out << "return ind_0.equalRange(lower);\n";
+        out << "}\n";
+    }
+
+    // empty method
+    out << "bool empty() const {\n";
+    out << "return ind_0.empty();\n";
+    out << "}\n";
+
+    // partition method for parallelism
+    out << "std::vector<range<iterator>> partition() const {\n";
+    out << "return ind_0.partition(400);\n";
+    out << "}\n";
+
+    // purge method
+    out << "void purge() {\n";
+    out << "ind_0.clear();\n";
+    out << "}\n";
+
+    // begin and end iterators
+    out << "iterator begin() const {\n";
+    out << "return ind_0.begin();\n";
+    out << "}\n";
+
+    out << "iterator end() const {\n";
+    out << "return ind_0.end();\n";
+    out << "}\n";
+
+    // printStatistics method
+    out << "void printStatistics(std::ostream& o) const {\n";
+    out << "o << \" arity " << arity << " hash set index\\n\";\n";
+    out << "}\n";
+
+    // no hint statistics tracked by the hash set index
+    out << "void addHintStatistics(const std::string&) const {}\n";
+
+    // end struct
+    out << "};\n";
+}
+
+// -------- Interval Relation --------
+
+/** Generate index set for an interval relation */
+void IntervalRelation::computeIndices() {
+    assert(!isProvenance && "interval sets cannot be used with provenance");
+    assert(getArity() == 1 && "interval sets are limited to unary relations");
+    masterIndex = 0;
+    computedIndices = indexSelection.getAllOrders();
+}
+
+/** Generate type name of an interval relation */
+std::string IntervalRelation::getTypeName() {
+    // the struct is independent of the attribute type and the searches
+    // performed on the relation, hence a single shared name suffices
+    return "t_interval";
+}
+
+/** Generate type struct of an interval relation */
+void IntervalRelation::generateTypeStruct(std::ostream& out) {
+    // struct definition
+    out << "struct " << getTypeName() << " {\n";
+    out << "static constexpr Relation::arity_type Arity = 1;\n";
+
+    // stored tuple type
+    out << "using t_tuple = Tuple<RamDomain, 1>;\n";
+
+    out << "using t_ind_0 = souffle::IntervalSet<t_tuple>;\n";
+    out << "t_ind_0 ind_0;\n";
+    out << "using iterator = t_ind_0::iterator;\n";
+
+    // the interval set requires no operation hints
+    out << "struct context {\n";
+    out << "};\n";
+    out << "context createContext() { return context(); }\n";
+
+    // insert methods
+    out << "bool insert(const t_tuple& t) {\n";
+    out << "return ind_0.insert(t);\n";
+    out << "}\n";  // end of insert(t_tuple&)
+
+    out << "bool insert(const t_tuple& t, context& /* h */) {\n";
+    out << "return ind_0.insert(t);\n";
+    out << "}\n";  // end of insert(t_tuple&, context&)
+
+    out << "bool insert(const RamDomain* ramDomain) {\n";
+    out << "return insert(t_tuple{ramDomain[0]});\n";
+    out << "}\n";  // end of insert(RamDomain*)
+
+    out << "bool insert(RamDomain a0) {\n";
+    out << "return insert(t_tuple{a0});\n";
+    out << "}\n";  // end of insert(RamDomain a0)
+
+    // span insert, absorbing a whole closed range of values at once
+    out << "bool insertRange(RamDomain lo, RamDomain hi) {\n";
+    out << "return ind_0.insert(lo, hi);\n";
+    out << "}\n";  // end of insertRange(RamDomain, RamDomain)
+
+    // insertAll method
+    out << "template <typename T>\n";
+    out << "void insertAll(T& other) {\n";
+    out << "for (auto const& cur : other) {\n";
+    out << "insert(cur);\n";
+    out << "}\n";
+    out << "}\n";  // end of insertAll(T&)
+
+    // contains methods
+    out << "bool contains(const t_tuple& t, context& /* h */) const {\n";
+    out << "return ind_0.contains(t);\n";
+    out << "}\n";
+
+    out << "bool contains(const t_tuple& t) const {\n";
+    out << "return ind_0.contains(t);\n";
+    out << "}\n";
+
+    // size method
+    out << "std::size_t size() const {\n";
+    out << "return ind_0.size();\n";
+    out << "}\n";
+
+    // full scan
+    out << "range<iterator> lowerUpperRange_0(const t_tuple& /* lower */, const t_tuple& /* upper */, "
+           "context& /* h */) const {\n";
+    out << "return make_range(ind_0.begin(), ind_0.end());\n";
+    out << "}\n";
+
+    out << "range<iterator> lowerUpperRange_0(const t_tuple& /* lower */, const t_tuple& /* upper */) const "
+           "{\n";
+    out << "return make_range(ind_0.begin(), ind_0.end());\n";
+    out << "}\n";
+
+    // point lookups; inequalities are never indexed on interval sets, so
+    // the bounds of each search delimit an inclusive range of values
+    out << "range<iterator> lowerUpperRange_1(const t_tuple& lower, const t_tuple& upper, context& /* h */) "
+           "const {\n";
+    out << "return make_range(ind_0.lower_bound(lower), ind_0.upper_bound(upper));\n";
+    out << "}\n";
+
+    out << "range<iterator> lowerUpperRange_1(const t_tuple& lower, const t_tuple& upper) const {\n";
+    out << "return make_range(ind_0.lower_bound(lower), ind_0.upper_bound(upper));\n";
+    out << "}\n";
+
+    // empty method
+    out << "bool empty() const {\n";
+    out << "return ind_0.empty();\n";
+    out << "}\n";
+
+    // partition method for parallelism
+    out << "std::vector<range<iterator>> partition() const {\n";
+    out << "return ind_0.partition(400);\n";
+    out << "}\n";
+
+    // purge method
+    out << "void purge() {\n";
+    out << "ind_0.clear();\n";
+    out << "}\n";
+
+    // begin and end iterators
+    out << "iterator begin() const {\n";
+    out << "return ind_0.begin();\n";
+    out << "}\n";
+
+    out << "iterator end() const {\n";
+    out << "return ind_0.end();\n";
+    out << "}\n";
+
+    // printStatistics method
+    out << "void printStatistics(std::ostream& o) const {\n";
+    out << "o << \" interval set index: \" << ind_0.getNumSpans() << \" spans\\n\";\n";
+    out << "}\n";
+
+    // no hint statistics tracked by the interval set index
+    out << "void addHintStatistics(const std::string&) const {}\n";
+
+    // end struct
+    out << "};\n";
+}
+
 // -------- Eqrel Relation --------
 
 /** Generate index set for a eqrel relation, which should be empty */
@@ -150,6 +150,28 @@ public:
     void generateTypeStruct(std::ostream& out) override;
 };
 
+class HashsetRelation : public Relation {
+public:
+    HashsetRelation(
+            const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection, bool isProvenance)
+            : Relation(ramRel, indexSelection, isProvenance) {}
+
+    void computeIndices() override;
+    std::string getTypeName() override;
+    void generateTypeStruct(std::ostream& out) override;
+};
+
+class IntervalRelation : public Relation {
+public:
+    IntervalRelation(
+            const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection, bool isProvenance)
+            : Relation(ramRel, indexSelection, isProvenance) {}
+
+    void computeIndices() override;
+    std::string getTypeName() override;
+    void generateTypeStruct(std::ostream& out) override;
+};
+
 class EqrelRelation : public Relation {
 public:
     EqrelRelation(
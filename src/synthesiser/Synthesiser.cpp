@@ -19,9 +19,11 @@
 #include "FunctorOps.h"
 #include "Global.h"
 #include "RelationTag.h"
+#include "ram/AbstractExistenceCheck.h"
 #include "ram/AbstractParallel.h"
 #include "ram/Aggregate.h"
 #include "ram/AutoIncrement.h"
+#include "ram/BinRelationStatement.h"
 #include "ram/Break.h"
 #include "ram/Call.h"
 #include "ram/Clear.h"
@@ -30,6 +32,7 @@
 #include "ram/Constraint.h"
 #include "ram/DebugInfo.h"
 #include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
 #include "ram/ExistenceCheck.h"
 #include "ram/Exit.h"
 #include "ram/Expression.h"
@@ -48,6 +51,7 @@
 #include "ram/LogSize.h"
 #include "ram/LogTimer.h"
 #include "ram/Loop.h"
+#include "ram/Merge.h"
 #include "ram/Negation.h"
 #include "ram/NestedIntrinsicOperator.h"
 #include "ram/NestedOperation.h"
@@ -87,6 +91,7 @@
 #include "ram/utility/Visitor.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
 #include "souffle/TypeAttribute.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
@@ -99,6 +104,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iterator>
@@ -220,6 +226,24 @@ std::set<const ram::Relation*> Synthesiser::getReferencedRelations(const Operati
     return res;
 }
 
+/** Replaces whole-identifier occurrences of a name in generated code */
+static std::string replaceIdentifier(std::string text, const std::string& from, const std::string& to) {
+    const auto isIdentChar = [](unsigned char c) { return isalnum(c) != 0 || c == '_'; };
+    std::size_t pos = 0;
+    while ((pos = text.find(from, pos)) != std::string::npos) {
+        const bool leftBound = pos == 0 || !isIdentChar(static_cast<unsigned char>(text[pos - 1]));
+        const bool rightBound = pos + from.size() == text.size() ||
+                                !isIdentChar(static_cast<unsigned char>(text[pos + from.size()]));
+        if (leftBound && rightBound) {
+            text.replace(pos, from.size(), to);
+            pos += to.size();
+        } else {
+            pos += from.size();
+        }
+    }
+    return text;
+}
+
 void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
     class CodeEmitter : public ram::Visitor<void, Node const, std::ostream&> {
         using ram::Visitor<void, Node const, std::ostream&>::visit_;
@@ -414,10 +438,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 }
             }
 
-            // outline each search operation to improve compilation time
-            out << "[&]()";
-            // enclose operation in its own scope
-            out << "{\n";
+            // render the operation into a buffer so that rules differing only
+            // in the relations they touch can share one outlined method body
+            std::ostringstream body;
 
             // check whether loop nest can be parallelized
             bool isParallel = visitExists(
@@ -441,30 +464,87 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     preamble << "if(";
                     dispatch(*toCondition(requireCtx), preamble);
                     preamble << ") {\n";
-                    dispatch(*next, out);
-                    out << "}\n";
+                    dispatch(*next, body);
+                    body << "}\n";
                 } else {
-                    dispatch(*next, out);
+                    dispatch(*next, body);
                 }
             } else {
-                out << preamble.str();
+                body << preamble.str();
                 if (requireCtx.size() > 0) {
-                    out << "if(";
-                    dispatch(*toCondition(requireCtx), out);
-                    out << ") {\n";
-                    dispatch(*next, out);
-                    out << "}\n";
+                    body << "if(";
+                    dispatch(*toCondition(requireCtx), body);
+                    body << ") {\n";
+                    dispatch(*next, body);
+                    body << "}\n";
                 } else {
-                    dispatch(*next, out);
+                    dispatch(*next, body);
                 }
             }
 
             if (isParallel) {
-                out << "PARALLEL_END\n";  // end parallel
+                body << "PARALLEL_END\n";  // end parallel
             }
 
-            out << "}\n";
-            out << "();";  // call lambda
+            // queries reading subroutine state cannot be outlined into a
+            // shared method; they keep their own immediately-invoked lambda
+            bool shareable = !visitExists(query, [&](const Node& n) {
+                return isA<SubroutineArgument>(n) || isA<SubroutineReturn>(n);
+            });
+
+            // relations referenced by the query, in a stable order
+            std::vector<const ram::Relation*> rels;
+            for (const ram::Relation* rel : synthesiser.getReferencedRelations(query.getOperation())) {
+                rels.push_back(rel);
+            }
+            std::sort(rels.begin(), rels.end(), [&](const ram::Relation* a, const ram::Relation* b) {
+                return synthesiser.getRelationName(a) < synthesiser.getRelationName(b);
+            });
+
+            if (!shareable || rels.empty()) {
+                // outline the search operation to improve compilation time
+                out << "[&]()";
+                out << "{\n";
+                out << body.str();
+                out << "}\n";
+                out << "();";  // call lambda
+            } else {
+                // abstract relation identity out of the rendered body; bodies
+                // that then coincide are implemented by a single method
+                std::string key = body.str();
+                for (std::size_t i = 0; i < rels.size(); i++) {
+                    key = replaceIdentifier(key, synthesiser.getOpContextName(*rels[i]),
+                            "ctxt" + std::to_string(i));
+                    key = replaceIdentifier(
+                            key, synthesiser.getRelationName(rels[i]), "param" + std::to_string(i));
+                }
+
+                auto pos = synthesiser.queryBodyCache.find(key);
+                if (pos == synthesiser.queryBodyCache.end()) {
+                    std::size_t num = synthesiser.queryBodyCache.size();
+                    pos = synthesiser.queryBodyCache.insert(std::make_pair(key, num)).first;
+
+                    // in-class member template, implicitly inline
+                    auto& defs = synthesiser.sharedQueryMethods;
+                    defs << "template <";
+                    for (std::size_t i = 0; i < rels.size(); i++) {
+                        defs << (i == 0 ? "" : ",") << "typename R" << i;
+                    }
+                    defs << ">\n";
+                    // marked hot so the linker clusters the query bodies
+                    defs << "SOUFFLE_HOT void query_" << num << "(";
+                    for (std::size_t i = 0; i < rels.size(); i++) {
+                        defs << (i == 0 ? "" : ",") << "R" << i << "* param" << i;
+                    }
+                    defs << ") {\n" << key << "}\n";
+                }
+
+                out << "query_" << pos->second << "(";
+                for (std::size_t i = 0; i < rels.size(); i++) {
+                    out << (i == 0 ? "" : ",") << synthesiser.getRelationName(rels[i]) << ".get()";
+                }
+                out << ");";
+            }
 
             if (freeOfCtx.size() > 0) {
                 out << "}\n";
@@ -540,8 +620,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
         void visit_(type_identity<Loop>, const Loop& loop, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
             out << "iter = 0;\n";
+            out << "convergenceMonitor.beginLoop();\n";
             out << "for(;;) {\n";
             dispatch(loop.getBody(), out);
+            out << "convergenceMonitor.endIteration(iter);\n";
             out << "iter++;\n";
             out << "}\n";
             out << "iter = 0;\n";
@@ -556,6 +638,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     synthesiser.getRelationName(synthesiser.lookup(swap.getSecondRelation()));
 
             out << "std::swap(" << deltaKnowledge << ", " << newKnowledge << ");\n";
+            // after the swap the delta relation holds exactly the tuples
+            // produced by this iteration
+            out << "if (convergenceMonitor.enabled()) convergenceMonitor.addDelta(" << deltaKnowledge
+                << "->size());\n";
             PRINT_END_COMMENT(out);
         }
 
@@ -568,11 +654,23 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<Merge>, const Merge& merge, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            // overload resolution picks the tree-wise merge if both relations
+            // share their type, and the tuple-wise fallback otherwise
+            out << synthesiser.getRelationName(synthesiser.lookup(merge.getTargetRelation())) << "->"
+                << "insertAll("
+                << "*" << synthesiser.getRelationName(synthesiser.lookup(merge.getSourceRelation()))
+                << ");\n";
+            PRINT_END_COMMENT(out);
+        }
+
         void visit_(type_identity<Exit>, const Exit& exit, std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
-            out << "if(";
+            // fixpoint loops run many iterations before the exit test holds
+            out << "if(SOUFFLE_UNLIKELY(";
             dispatch(exit.getCondition(), out);
-            out << ") break;\n";
+            out << ")) break;\n";
             PRINT_END_COMMENT(out);
         }
 
@@ -653,6 +751,93 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        /**
+         * Checks that a filter condition is pure arithmetic over the tuple
+         * environment, so that it can be evaluated over a gathered block of
+         * tuples. Relation reads keep the scalar path since block evaluation
+         * would not tighten their loop, and stateful expressions must not be
+         * re-ordered or evaluated speculatively.
+         */
+        bool isBatchableCondition(const Condition& condition) {
+            bool batchable = true;
+            visit(condition, [&](const Node& node) {
+                if (isA<ExistenceCheck>(node) || isA<ProvenanceExistenceCheck>(node) ||
+                        isA<EmptinessCheck>(node) || isA<UserDefinedOperator>(node) ||
+                        isA<NestedIntrinsicOperator>(node) || isA<AutoIncrement>(node) ||
+                        isA<PackRecord>(node)) {
+                    batchable = false;
+                }
+            });
+            return batchable;
+        }
+
+        /**
+         * Returns the filter directly nested in a scan if its condition can be
+         * evaluated batch-wise, or nullptr if the scan must stay scalar.
+         */
+        const Filter* getBatchableFilter(const RelationOperation& scan) {
+            // frequency counters count per-tuple visits in emission order
+            if (Global::config().has("profile")) {
+                return nullptr;
+            }
+            const auto* filter = as<Filter>(scan.getOperation());
+            if (filter == nullptr || isTrue(&filter->getCondition()) ||
+                    !isBatchableCondition(filter->getCondition())) {
+                return nullptr;
+            }
+            // a break underneath would leave the block loop instead of the scan
+            bool hasBreak = false;
+            visit(filter->getOperation(), [&](const Break&) { hasBreak = true; });
+            if (hasBreak) {
+                return nullptr;
+            }
+            return filter;
+        }
+
+        /**
+         * Emits a scan over the given iterable source that gathers tuples in
+         * blocks, evaluates the filter condition over the block in a tight
+         * loop the compiler can auto-vectorise, and applies the nested
+         * operation to the surviving tuples.
+         */
+        void emitBatchedFilterLoop(std::ostream& out, const std::string& source, std::size_t arity,
+                int id, const Filter& filter) {
+            out << "{\n";
+            out << "constexpr std::size_t batch_size = 256;\n";
+            out << "Tuple<RamDomain," << arity << "> batch[batch_size];\n";
+            out << "uint8_t batch_keep[batch_size];\n";
+            out << "auto batch_it = (" << source << ").begin();\n";
+            out << "auto batch_end = (" << source << ").end();\n";
+            out << "while(batch_it != batch_end) {\n";
+
+            // gather
+            out << "std::size_t batch_n = 0;\n";
+            out << "for(; batch_n < batch_size && batch_it != batch_end; ++batch_it, ++batch_n) {\n";
+            out << "const auto& batch_t = *batch_it;\n";
+            out << "for(std::size_t batch_j = 0; batch_j < " << arity << "; batch_j++) {\n";
+            out << "batch[batch_n][batch_j] = batch_t[batch_j];\n";
+            out << "}\n";
+            out << "}\n";
+
+            // evaluate the filter over the block
+            out << "for(std::size_t batch_i = 0; batch_i < batch_n; batch_i++) {\n";
+            out << "const Tuple<RamDomain," << arity << ">& env" << id << " = batch[batch_i];\n";
+            out << "batch_keep[batch_i] = static_cast<uint8_t>(";
+            dispatch(filter.getCondition(), out);
+            out << ");\n";
+            out << "}\n";
+
+            // apply the nested operation to the surviving tuples
+            out << "for(std::size_t batch_i = 0; batch_i < batch_n; batch_i++) {\n";
+            out << "if(batch_keep[batch_i] == 0) continue;\n";
+            out << "const Tuple<RamDomain," << arity << ">& env" << id << " = batch[batch_i];\n";
+            dispatch(filter.getOperation(), out);
+            out << "}\n";
+
+            out << "}\n";
+            out << "}\n";
+        }
+
         void visit_(type_identity<ParallelScan>, const ParallelScan& pscan, std::ostream& out) override {
             const auto* rel = synthesiser.lookup(pscan.getRelation());
             const auto& relName = synthesiser.getRelationName(rel);
@@ -671,11 +856,15 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             out << preamble.str();
             out << "pfor(auto it = part.begin(); it<part.end();++it){\n";
             out << "try{\n";
-            out << "for(const auto& env0 : *it) {\n";
+            if (const Filter* filter = getBatchableFilter(pscan)) {
+                emitBatchedFilterLoop(out, "*it", rel->getArity(), pscan.getTupleId(), *filter);
+            } else {
+                out << "for(const auto& env0 : *it) {\n";
 
-            visit_(type_identity<TupleOperation>(), pscan, out);
+                visit_(type_identity<TupleOperation>(), pscan, out);
 
-            out << "}\n";
+                out << "}\n";
+            }
             out << "} catch(std::exception &e) { signalHandler->error(e.what());}\n";
             out << "}\n";
 
@@ -691,12 +880,16 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
             assert(rel->getArity() > 0 && "AstToRamTranslator failed/no scans for nullaries");
 
-            out << "for(const auto& env" << id << " : "
-                << "*" << relName << ") {\n";
+            if (const Filter* filter = getBatchableFilter(scan)) {
+                emitBatchedFilterLoop(out, "*" + relName, rel->getArity(), id, *filter);
+            } else {
+                out << "for(const auto& env" << id << " : "
+                    << "*" << relName << ") {\n";
 
-            visit_(type_identity<TupleOperation>(), scan, out);
+                visit_(type_identity<TupleOperation>(), scan, out);
 
-            out << "}\n";
+                out << "}\n";
+            }
 
             PRINT_END_COMMENT(out);
         }
@@ -921,11 +1114,20 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             // Handle nil case.
             out << "if (ref == 0) continue;\n";
 
-            // Unpack tuple
-            out << "const RamDomain *"
-                << "env" << unpack.getTupleId() << " = "
-                << "recordTable.unpack(ref," << arity << ");"
-                << "\n";
+            // Unpack tuple; small records are decoded from the reference
+            // itself into local storage without a record table lookup.
+            if (details::isInlineArity(arity)) {
+                out << "Tuple<RamDomain," << arity << "> env" << unpack.getTupleId() << "_data;\n";
+                out << "const RamDomain *"
+                    << "env" << unpack.getTupleId() << " = "
+                    << "unpack(recordTable, ref, env" << unpack.getTupleId() << "_data);"
+                    << "\n";
+            } else {
+                out << "const RamDomain *"
+                    << "env" << unpack.getTupleId() << " = "
+                    << "recordTable.unpack(ref," << arity << ");"
+                    << "\n";
+            }
 
             out << "{\n";
 
@@ -986,6 +1188,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     init = "0";
                     out << "shouldRunNested = true;\n";
                     break;
+                case AggregateOp::COUNTD:
+                    out << "shouldRunNested = true;\n";
+                    break;
                 case AggregateOp::MEAN: init = "0"; break;
                 case AggregateOp::FSUM:
                 case AggregateOp::USUM:
@@ -1020,6 +1225,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     op = "+";
                     break;
                 }
+
+                case AggregateOp::COUNTD: {
+                    op = "hllMerge";
+                    break;
+                }
                 default: fatal("Unhandled aggregate operation");
             }
             // res0 stores the aggregate result
@@ -1035,12 +1245,21 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 case TypeAttribute::ADT:
                 case TypeAttribute::Record: type = "RamDomain"; break;
             }
-            out << type << " res0 = " << init << ";\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                // the sketch replaces the scalar accumulator; bounded memory
+                out << "souffle::HyperLogLog res0;\n";
+            } else {
+                out << type << " res0 = " << init << ";\n";
+            }
             if (aggregate.getFunction() == AggregateOp::MEAN) {
                 out << "RamUnsigned res1 = 0;\n";
                 sharedVariable += ", res1";
             }
 
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                out << "#pragma omp declare reduction(hllMerge : souffle::HyperLogLog : "
+                       "omp_out.merge(omp_in))\n";
+            }
             out << preamble.str();
             out << "PARALLEL_START\n";
             // check whether there is an index to use
@@ -1089,6 +1308,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     out << "));\n";
                     break;
                 case AggregateOp::COUNT: out << "++res0\n;"; break;
+                case AggregateOp::COUNTD:
+                    out << "res0.insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(";
+                    dispatch(aggregate.getExpression(), out);
+                    out << ")));\n";
+                    break;
                 case AggregateOp::FSUM:
                 case AggregateOp::USUM:
                 case AggregateOp::SUM:
@@ -1128,7 +1352,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             }
 
             // write result into environment tuple
-            out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                out << "env" << identifier << "[0] = ramBitCast(static_cast<RamSigned>(res0.estimate()));\n";
+            } else {
+                out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            }
 
             // check whether there exists a min/max first before next loop
             out << "if (shouldRunNested) {\n";
@@ -1195,6 +1423,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     init = "0";
                     out << "shouldRunNested = true;\n";
                     break;
+                case AggregateOp::COUNTD:
+                    out << "shouldRunNested = true;\n";
+                    break;
                 case AggregateOp::MEAN: init = "0"; break;
                 case AggregateOp::FSUM:
                 case AggregateOp::USUM:
@@ -1214,7 +1445,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 case TypeAttribute::ADT:
                 case TypeAttribute::Record: type = "RamDomain"; break;
             }
-            out << type << " res0 = " << init << ";\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                // the sketch replaces the scalar accumulator; bounded memory
+                out << "souffle::HyperLogLog res0;\n";
+            } else {
+                out << type << " res0 = " << init << ";\n";
+            }
 
             if (aggregate.getFunction() == AggregateOp::MEAN) {
                 out << "RamUnsigned res1 = 0;\n";
@@ -1265,6 +1501,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     out << "));\n";
                     break;
                 case AggregateOp::COUNT: out << "++res0\n;"; break;
+                case AggregateOp::COUNTD:
+                    out << "res0.insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(";
+                    dispatch(aggregate.getExpression(), out);
+                    out << ")));\n";
+                    break;
                 case AggregateOp::FSUM:
                 case AggregateOp::USUM:
                 case AggregateOp::SUM:
@@ -1295,7 +1536,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             }
 
             // write result into environment tuple
-            out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                out << "env" << identifier << "[0] = ramBitCast(static_cast<RamSigned>(res0.estimate()));\n";
+            } else {
+                out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            }
 
             // check whether there exists a min/max first before next loop
             out << "if (shouldRunNested) {\n";
@@ -1348,6 +1593,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     init = "0";
                     out << "shouldRunNested = true;\n";
                     break;
+                case AggregateOp::COUNTD:
+                    out << "shouldRunNested = true;\n";
+                    break;
 
                 case AggregateOp::MEAN: init = "0"; break;
 
@@ -1385,6 +1633,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     break;
                 }
 
+                case AggregateOp::COUNTD: {
+                    op = "hllMerge";
+                    break;
+                }
+
                 default: fatal("Unhandled aggregate operation");
             }
 
@@ -1398,7 +1651,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 case TypeAttribute::ADT:
                 case TypeAttribute::Record: type = "RamDomain"; break;
             }
-            out << type << " res0 = " << init << ";\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                // the sketch replaces the scalar accumulator; bounded memory
+                out << "souffle::HyperLogLog res0;\n";
+            } else {
+                out << type << " res0 = " << init << ";\n";
+            }
 
             std::string sharedVariable = "res0";
             if (aggregate.getFunction() == AggregateOp::MEAN) {
@@ -1406,6 +1664,10 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 sharedVariable += ", res1";
             }
 
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                out << "#pragma omp declare reduction(hllMerge : souffle::HyperLogLog : "
+                       "omp_out.merge(omp_in))\n";
+            }
             // create a partitioning of the relation to iterate over simeltaneously
             out << "auto part = " << relName << "->partition();\n";
             out << "PARALLEL_START\n";
@@ -1440,6 +1702,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     out << "));\n";
                     break;
                 case AggregateOp::COUNT: out << "++res0\n;"; break;
+                case AggregateOp::COUNTD:
+                    out << "res0.insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(";
+                    dispatch(aggregate.getExpression(), out);
+                    out << ")));\n";
+                    break;
                 case AggregateOp::FSUM:
                 case AggregateOp::USUM:
                 case AggregateOp::SUM:
@@ -1473,7 +1740,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             }
 
             // write result into environment tuple
-            out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                out << "env" << identifier << "[0] = ramBitCast(static_cast<RamSigned>(res0.estimate()));\n";
+            } else {
+                out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            }
 
             // check whether there exists a min/max first before next loop
             out << "if (shouldRunNested) {\n";
@@ -1518,6 +1789,9 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     init = "0";
                     out << "shouldRunNested = true;\n";
                     break;
+                case AggregateOp::COUNTD:
+                    out << "shouldRunNested = true;\n";
+                    break;
 
                 case AggregateOp::MEAN: init = "0"; break;
 
@@ -1540,7 +1814,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 case TypeAttribute::Record:
                 default: type = "RamDomain"; break;
             }
-            out << type << " res0 = " << init << ";\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                // the sketch replaces the scalar accumulator; bounded memory
+                out << "souffle::HyperLogLog res0;\n";
+            } else {
+                out << type << " res0 = " << init << ";\n";
+            }
 
             if (aggregate.getFunction() == AggregateOp::MEAN) {
                 out << "RamUnsigned res1 = 0;\n";
@@ -1573,6 +1852,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     out << "));\n";
                     break;
                 case AggregateOp::COUNT: out << "++res0\n;"; break;
+                case AggregateOp::COUNTD:
+                    out << "res0.insert(static_cast<uint64_t>(ramBitCast<RamUnsigned>(";
+                    dispatch(aggregate.getExpression(), out);
+                    out << ")));\n";
+                    break;
                 case AggregateOp::FSUM:
                 case AggregateOp::USUM:
                 case AggregateOp::SUM:
@@ -1602,7 +1886,11 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             }
 
             // write result into environment tuple
-            out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            if (aggregate.getFunction() == AggregateOp::COUNTD) {
+                out << "env" << identifier << "[0] = ramBitCast(static_cast<RamSigned>(res0.estimate()));\n";
+            } else {
+                out << "env" << identifier << "[0] = ramBitCast(res0);\n";
+            }
 
             // check whether there exists a min/max first before next loop
             out << "if (shouldRunNested) {\n";
@@ -1677,6 +1965,23 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
             PRINT_END_COMMENT(out);
         }
 
+        void visit_(type_identity<Erase>, const Erase& erase, std::ostream& out) override {
+            PRINT_BEGIN_COMMENT(out);
+            const auto* rel = synthesiser.lookup(erase.getRelation());
+            auto arity = rel->getArity();
+            auto relName = synthesiser.getRelationName(rel);
+
+            // create erased tuple
+            out << "Tuple<RamDomain," << arity << "> tuple{{" << join(erase.getValues(), ",", rec)
+                << "}};\n";
+
+            // erase tuple
+            out << relName << "->"
+                << "erase(tuple);\n";
+
+            PRINT_END_COMMENT(out);
+        }
+
         // -- conditions --
 
         void visit_(type_identity<True>, const True&, std::ostream& out) override {
@@ -1720,12 +2025,12 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
     EVAL_CHILD(ty, getRHS);     \
     out << ")";                 \
     break
-#define COMPARE_STRING(op)                \
-    out << "(symTable.decode(";           \
-    EVAL_CHILD(RamDomain, getLHS);        \
-    out << ") " #op " symTable.decode(";  \
-    EVAL_CHILD(RamDomain, getRHS);        \
-    out << "))";                          \
+#define COMPARE_STRING(op)          \
+    out << "(symTable.compare(";    \
+    EVAL_CHILD(RamDomain, getLHS);  \
+    out << ",";                     \
+    EVAL_CHILD(RamDomain, getRHS);  \
+    out << ") " #op " 0)";          \
     break
 #define COMPARE_EQ_NE(opCode, op)                                         \
     case BinaryConstraintOp::   opCode: COMPARE_NUMERIC(RamDomain  , op); \
@@ -1751,20 +2056,20 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 // strings
                 case BinaryConstraintOp::MATCH: {
                     synthesiser.UsingStdRegex = true;
-                    out << "regex_wrapper(symTable.decode(";
+                    out << "regex_wrapper(";
                     dispatch(rel.getLHS(), out);
-                    out << "),symTable.decode(";
+                    out << ",";
                     dispatch(rel.getRHS(), out);
-                    out << "))";
+                    out << ")";
                     break;
                 }
                 case BinaryConstraintOp::NOT_MATCH: {
                     synthesiser.UsingStdRegex = true;
-                    out << "!regex_wrapper(symTable.decode(";
+                    out << "!regex_wrapper(";
                     dispatch(rel.getLHS(), out);
-                    out << "),symTable.decode(";
+                    out << ",";
                     dispatch(rel.getRHS(), out);
-                    out << "))";
+                    out << ")";
                     break;
                 }
                 case BinaryConstraintOp::CONTAINS: {
@@ -2030,11 +2335,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
     NARY_OP(F##opcode, RamFloat   , op)
 
 
-#define CONV_TO_STRING(opcode, ty)                \
-    case FunctorOp::opcode: {                     \
-        out << "symTable.encode(std::to_string("; \
-        dispatch(*args[0], out);                  \
-        out << "))";                              \
+#define CONV_TO_STRING(opcode, ty)                                                                \
+    case FunctorOp::opcode: {                                                                     \
+        out << "[&](RamDomain memoArg){return souffle::evaluator::stringFunctorMemo().memoize("   \
+            << ((static_cast<uint32_t>(FunctorOp::opcode) << 2u) | 1u)                            \
+            << "u,memoArg,0,0,[&]{return symTable.encode(std::to_string(ramBitCast<" #ty          \
+               ">(memoArg)));});}(ramBitCast<RamDomain>(";                                        \
+        dispatch(*args[0], out);                                                                  \
+        out << "))";                                                                              \
     } break;
 #define CONV_FROM_STRING(opcode, ty)                                            \
     case FunctorOp::opcode: {                                                   \
@@ -2138,6 +2446,20 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
                 // strings
                 case FunctorOp::CAT: {
+                    // the binary form recurs on a small set of argument
+                    // pairs, so it is routed through the per-thread memo
+                    if (args.size() == 2) {
+                        out << "[&](RamDomain memoA,RamDomain memoB){"
+                               "return souffle::evaluator::stringFunctorMemo().memoize("
+                            << ((static_cast<uint32_t>(FunctorOp::CAT) << 2u) | 2u)
+                            << "u,memoA,memoB,0,[&]{return symTable.encode("
+                               "symTable.decode(memoA) + symTable.decode(memoB));});}(";
+                        dispatch(*args[0], out);
+                        out << ",";
+                        dispatch(*args[1], out);
+                        out << ")";
+                        break;
+                    }
                     out << "symTable.encode(";
                     std::size_t i = 0;
                     while (i < args.size() - 1) {
@@ -2154,14 +2476,17 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
 
                 /** Ternary Functor Operators */
                 case FunctorOp::SUBSTR: {
-                    out << "symTable.encode(";
-                    out << "substr_wrapper(symTable.decode(";
+                    out << "[&](RamDomain memoA,RamDomain memoB,RamDomain memoC){"
+                           "return souffle::evaluator::stringFunctorMemo().memoize("
+                        << ((static_cast<uint32_t>(FunctorOp::SUBSTR) << 2u) | 3u)
+                        << "u,memoA,memoB,memoC,[&]{return symTable.encode("
+                           "substr_wrapper(symTable.decode(memoA),memoB,memoC));});}(";
                     dispatch(*args[0], out);
-                    out << "),(";
+                    out << ",(";
                     dispatch(*args[1], out);
                     out << "),(";
                     dispatch(*args[2], out);
-                    out << ")))";
+                    out << "))";
                     break;
                 }
 
@@ -2179,6 +2504,43 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 std::ostream& out) override {
             PRINT_BEGIN_COMMENT(out);
 
+            // a bare range insert into an interval relation is absorbed as
+            // coalesced spans instead of being driven value by value; under
+            // profiling the per-value frequencies must remain observable
+            auto isIntervalFill = [&]() {
+                if (Global::config().has("profile")) {
+                    return false;
+                }
+                if (op.getFunction() != NestedIntrinsicOp::RANGE &&
+                        op.getFunction() != NestedIntrinsicOp::URANGE) {
+                    return false;
+                }
+                const auto* insert = as<Insert>(op.getOperation());
+                if (insert == nullptr || isA<GuardedInsert>(insert)) {
+                    return false;
+                }
+                if (synthesiser.lookup(insert->getRelation())->getRepresentation() !=
+                        RelationRepresentation::INTERVAL) {
+                    return false;
+                }
+                const auto& values = insert->getValues();
+                if (values.size() != 1) {
+                    return false;
+                }
+                const auto* element = as<TupleElement>(values[0]);
+                return element != nullptr && element->getTupleId() == static_cast<int>(op.getTupleId()) &&
+                       element->getElement() == 0;
+            };
+
+            auto emitIntervalFill = [&](char const* ty) {
+                const auto* insert = as<Insert>(op.getOperation());
+                const std::string& relName =
+                        synthesiser.getRelationName(synthesiser.lookup(insert->getRelation()));
+                tfm::format(out, "souffle::evaluator::fillRange<%s>(*%s, %s);\n", ty, relName,
+                        join(op.getArguments(), ",", [&](auto& os, auto* arg) { return dispatch(*arg, os); }));
+                PRINT_END_COMMENT(out);
+            };
+
             auto emitHelper = [&](auto&& func) {
                 tfm::format(out, "%s(%s, [&](auto&& env%d) {\n", func,
                         join(op.getArguments(), ",", [&](auto& os, auto* arg) { return dispatch(*arg, os); }),
@@ -2193,6 +2555,14 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                 return emitHelper(tfm::format("souffle::evaluator::runRange<%s>", ty));
             };
 
+            if (isIntervalFill()) {
+                switch (op.getFunction()) {
+                    case NestedIntrinsicOp::RANGE: return emitIntervalFill("RamSigned");
+                    case NestedIntrinsicOp::URANGE: return emitIntervalFill("RamUnsigned");
+                    case NestedIntrinsicOp::FRANGE: break;
+                }
+            }
+
             switch (op.getFunction()) {
                 case NestedIntrinsicOp::RANGE: return emitRange("RamSigned");
                 case NestedIntrinsicOp::URANGE: return emitRange("RamUnsigned");
@@ -2375,6 +2745,71 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
     // ---------------------------------------------------------------
     const Program& prog = translationUnit.getProgram();
     auto& idxAnalysis = translationUnit.getAnalysis<IndexAnalysis>();
+
+    // ---------------------------------------------------------------
+    //                 Output-Driven Stratum Skipping
+    // ---------------------------------------------------------------
+    // each top-level statement of the main sequence is a stratum; compute for
+    // every stratum the set of output relations that transitively depend on
+    // it, so that runFunction can skip the strata outside the dependency cone
+    // of the outputs requested at run time via SOUFFLE_OUTPUT_RELATIONS
+    std::vector<const Statement*> strata;
+    std::vector<std::set<std::string>> stratumServes;
+    const auto* mainSequence = as<Sequence>(prog.getMain());
+    if (mainSequence != nullptr && !Global::config().has("provenance") &&
+            !Global::config().has("profile") &&
+            !visitExists(prog.getMain(), [](const Call&) { return true; })) {
+        for (const Statement* stmt : mainSequence->getStatements()) {
+            strata.push_back(stmt);
+        }
+        const std::size_t numStrata = strata.size();
+        std::vector<std::set<std::string>> stratumReads(numStrata);
+        std::vector<std::set<std::string>> stratumWrites(numStrata);
+        std::vector<std::set<std::string>> stratumOutputs(numStrata);
+        for (std::size_t i = 0; i < numStrata; i++) {
+            auto& reads = stratumReads[i];
+            auto& writes = stratumWrites[i];
+            visit(*strata[i], [&](const Insert& insert) { writes.insert(insert.getRelation()); });
+            visit(*strata[i], [&](const RelationOperation& op) { reads.insert(op.getRelation()); });
+            visit(*strata[i],
+                    [&](const AbstractExistenceCheck& check) { reads.insert(check.getRelation()); });
+            visit(*strata[i], [&](const EmptinessCheck& check) { reads.insert(check.getRelation()); });
+            visit(*strata[i], [&](const RelationSize& size) { reads.insert(size.getRelation()); });
+            visit(*strata[i], [&](const Clear& clear) { writes.insert(clear.getRelation()); });
+            // swaps, merges and extends both read and modify their relations
+            visit(*strata[i], [&](const BinRelationStatement& bin) {
+                reads.insert(bin.getFirstRelation());
+                writes.insert(bin.getFirstRelation());
+                reads.insert(bin.getSecondRelation());
+                writes.insert(bin.getSecondRelation());
+            });
+            visit(*strata[i], [&](const IO& io) {
+                if (io.get("operation") == "input") {
+                    writes.insert(io.getRelation());
+                } else {
+                    reads.insert(io.getRelation());
+                    stratumOutputs[i].insert(io.get("name"));
+                }
+            });
+        }
+        // a stratum serves the outputs it prints plus everything served by the
+        // later strata touching a relation it writes; the main sequence is in
+        // topological order, so a single backward sweep closes transitively
+        stratumServes.resize(numStrata);
+        for (std::size_t i = numStrata; i-- > 0;) {
+            stratumServes[i] = stratumOutputs[i];
+            for (std::size_t j = i + 1; j < numStrata; j++) {
+                const bool depends = std::any_of(stratumWrites[i].begin(), stratumWrites[i].end(),
+                        [&](const std::string& rel) {
+                            return stratumReads[j].count(rel) != 0 || stratumWrites[j].count(rel) != 0;
+                        });
+                if (depends) {
+                    stratumServes[i].insert(stratumServes[j].begin(), stratumServes[j].end());
+                }
+            }
+        }
+    }
+
     // ---------------------------------------------------------------
     //                      Code Generation
     // ---------------------------------------------------------------
@@ -2385,6 +2820,11 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
 
     std::string classname = "Sf_" + id;
 
+    // subroutine definitions are collected separately and emitted after the
+    // class body, so that souffle-compile can assign them to individual
+    // translation units for parallel compilation
+    std::stringstream subroutineDefs;
+
     // generate C++ program
 
     if (Global::config().has("verbose")) {
@@ -2392,6 +2832,13 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
         os << "#include \"souffle/profile/ProfileEvent.h\"";
     }
     os << "\n#include \"souffle/CompiledSouffle.h\"\n";
+    os << "#ifdef __EMBEDDED_SOUFFLE__\n";
+    os << "#include \"souffle/SouffleCABI.h\"\n";
+    os << "#endif\n";
+    if (!strata.empty()) {
+        os << "#include <cstdlib>\n";
+        os << "#include <set>\n";
+    }
     if (Global::config().has("provenance")) {
         os << "#include <mutex>\n";
         os << "#include \"souffle/provenance/Explain.h\"\n";
@@ -2404,7 +2851,7 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
 
     {
         auto _os = os.delayed_if(UsingStdRegex);
-        *_os << "#include <regex>\n";
+        *_os << "#include \"souffle/utility/MatchUtil.h\"\n";
     }
 
     if (Global::config().has("profile") || Global::config().has("live-profile")) {
@@ -2420,41 +2867,58 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
         }
         withSharedLibrary = true;
     });
-    os << "extern \"C\" {\n";
-    for (const auto& f : functors) {
-        //        std::size_t arity = f.second.length() - 1;
-        const std::string& name = f.first;
-
-        const auto& functorTypes = f.second;
-        const auto& returnType = std::get<0>(functorTypes);
-        const auto& argsTypes = std::get<1>(functorTypes);
-        const auto& stateful = std::get<2>(functorTypes);
-
-        auto cppTypeDecl = [](TypeAttribute ty) -> char const* {
-            switch (ty) {
-                case TypeAttribute::Signed: return "souffle::RamSigned";
-                case TypeAttribute::Unsigned: return "souffle::RamUnsigned";
-                case TypeAttribute::Float: return "souffle::RamFloat";
-                case TypeAttribute::Symbol: return "const char *";
-                case TypeAttribute::ADT: fatal("adts cannot be used by user-defined functors");
-                case TypeAttribute::Record: fatal("records cannot be used by user-defined functors");
-            }
+    if (!functors.empty() && Global::config().has("functor-header")) {
+        // functor implementations are included into the generated source so
+        // that calls inline into the loops instead of crossing a shared
+        // library boundary; the header must define every functor with the
+        // signature the functor library would export
+        os << "#include \"" << Global::config().get("functor-header") << "\"\n";
+        withSharedLibrary = false;
+    } else {
+        os << "extern \"C\" {\n";
+        for (const auto& f : functors) {
+            //        std::size_t arity = f.second.length() - 1;
+            const std::string& name = f.first;
+
+            const auto& functorTypes = f.second;
+            const auto& returnType = std::get<0>(functorTypes);
+            const auto& argsTypes = std::get<1>(functorTypes);
+            const auto& stateful = std::get<2>(functorTypes);
+
+            auto cppTypeDecl = [](TypeAttribute ty) -> char const* {
+                switch (ty) {
+                    case TypeAttribute::Signed: return "souffle::RamSigned";
+                    case TypeAttribute::Unsigned: return "souffle::RamUnsigned";
+                    case TypeAttribute::Float: return "souffle::RamFloat";
+                    case TypeAttribute::Symbol: return "const char *";
+                    case TypeAttribute::ADT: fatal("adts cannot be used by user-defined functors");
+                    case TypeAttribute::Record: fatal("records cannot be used by user-defined functors");
+                }
 
-            UNREACHABLE_BAD_CASE_ANALYSIS
-        };
+                UNREACHABLE_BAD_CASE_ANALYSIS
+            };
 
-        if (stateful) {
-            os << "souffle::RamDomain " << name << "(souffle::SymbolTable *, souffle::RecordTable *";
-            for (std::size_t i = 0; i < argsTypes.size(); i++) {
-                os << ",souffle::RamDomain";
+            if (stateful) {
+                os << "souffle::RamDomain " << name << "(souffle::SymbolTable *, souffle::RecordTable *";
+                for (std::size_t i = 0; i < argsTypes.size(); i++) {
+                    os << ",souffle::RamDomain";
+                }
+                os << ");\n";
+            } else {
+                tfm::format(os, "%s %s(%s);\n", cppTypeDecl(returnType), name,
+                        join(map(argsTypes, cppTypeDecl), ","));
             }
-            os << ");\n";
-        } else {
-            tfm::format(os, "%s %s(%s);\n", cppTypeDecl(returnType), name,
-                    join(map(argsTypes, cppTypeDecl), ","));
         }
+        os << "}\n";
+    }
+    if (!functors.empty()) {
+        // optional lifecycle hooks for stateful functor libraries; weak so
+        // that libraries without per-run state need not define them
+        os << "extern \"C\" {\n";
+        os << "void souffle_functors_init() __attribute__((weak));\n";
+        os << "void souffle_functors_teardown() __attribute__((weak));\n";
+        os << "}\n";
     }
-    os << "}\n";
     os << "\n";
     os << "namespace souffle {\n";
     os << "static const RamDomain RAM_BIT_SHIFT_MASK = RAM_DOMAIN_SIZE - 1;\n";
@@ -2477,13 +2941,9 @@ void Synthesiser::generateCode(std::ostream& sos, const std::string& id, bool& w
         auto osp = os.delayed_if(UsingStdRegex);
         auto& _os = *osp;
         _os << "private:\n";
-        _os << "static inline bool regex_wrapper(const std::string& pattern, const std::string& text) {\n";
-        _os << "   bool result = false; \n";
-        _os << "   try { result = std::regex_match(text, std::regex(pattern)); } catch(...) { \n";
-        _os << "     std::cerr << \"warning: wrong pattern provided for match(\\\"\" << pattern << "
-               "\"\\\",\\\"\" "
-               "<< text << \"\\\").\\n\";\n}\n";
-        _os << "   return result;\n";
+        _os << "bool regex_wrapper(RamDomain pattern, RamDomain text) {\n";
+        _os << "   return souffle::cachedMatchPattern(pattern, symTable.decode(pattern))"
+               ".match(symTable.decode(text));\n";
         _os << "}\n";
     }
 
@@ -2635,6 +3095,7 @@ private:
 std::string             inputDirectory;
 std::string             outputDirectory;
 SignalHandler*          signalHandler {SignalHandler::instance()};
+ConvergenceMonitor      convergenceMonitor;
 std::atomic<RamDomain>  ctr {};
 std::atomic<std::size_t>     iter {};
 
@@ -2653,11 +3114,17 @@ void runFunction(std::string  inputDirectoryArg,
     if (0 < getNumThreads()) { omp_set_num_threads(getNumThreads()); }
 #endif
 
+    // keep the worker pool warm across repeat runs of the same process
+    ExecutionContext::instance().warmup(getNumThreads());
+
     signalHandler->set();
 )_";
     if (Global::config().has("verbose")) {
         os << "signalHandler->enableLogging();\n";
     }
+    if (!functors.empty()) {
+        os << "if (souffle_functors_init != nullptr) { souffle_functors_init(); }\n";
+    }
 
     // add actual program body
     os << "// -- query evaluation --\n";
@@ -2676,13 +3143,90 @@ void runFunction(std::string  inputDirectoryArg,
         // Store configuration
         os << R"_(ProfileEventSingleton::instance().makeConfigRecord("relationCount", std::to_string()_"
            << relationCount << "));";
+        // periodically attribute live memory to the relations and to the
+        // symbol and record tables from the profiling timer thread
+        os << "ProfileEventSingleton::instance().setMemorySampler([this]() {\n";
+        for (auto rel : prog.getRelations()) {
+            if (rel->isTemp()) {
+                continue;
+            }
+            os << "ProfileEventSingleton::instance().makeMemoryEvent(R\"_(" << rel->getName()
+               << ")_\", wrapper_" << getRelationName(*rel) << ".getMemoryUsage());\n";
+        }
+        os << "ProfileEventSingleton::instance().makeMemoryEvent(\"symbol-table\", "
+              "symTable.getMemoryUsage());\n";
+        os << "ProfileEventSingleton::instance().makeMemoryEvent(\"record-table\", "
+              "recordTable.getMemoryUsage());\n";
+        os << "});\n";
     }
 
     // emit code
-    emitCode(os, prog.getMain());
+    if (!strata.empty()) {
+        // restrict evaluation to the dependency cone of the outputs named in
+        // SOUFFLE_OUTPUT_RELATIONS (comma-separated); all strata run when the
+        // variable is unset or when IO goes through the program interface
+        os << "bool stratumEnabled[" << strata.size() << "];\n";
+        os << "for (std::size_t i = 0; i < " << strata.size() << "; i++) stratumEnabled[i] = true;\n";
+        os << "if (performIO) {\n";
+        os << "if (const char* requestedOutputs = std::getenv(\"SOUFFLE_OUTPUT_RELATIONS\")) {\n";
+        os << "if (*requestedOutputs != 0) {\n";
+        os << "std::set<std::string> requested;\n";
+        os << "const std::string names = requestedOutputs;\n";
+        os << "std::size_t start = 0;\n";
+        os << "while (start <= names.size()) {\n";
+        os << "std::size_t end = names.find(',', start);\n";
+        os << "if (end == std::string::npos) end = names.size();\n";
+        os << "if (end > start) requested.insert(names.substr(start, end - start));\n";
+        os << "start = end + 1;\n";
+        os << "}\n";
+        for (std::size_t i = 0; i < strata.size(); i++) {
+            os << "stratumEnabled[" << i << "] = false";
+            for (const auto& name : stratumServes[i]) {
+                os << " || requested.count(R\"_(" << name << ")_\") != 0";
+            }
+            os << ";\n";
+        }
+        os << "}\n";
+        os << "}\n";
+        os << "}\n";
+        // once the last stratum with an input directive has run, the symbol
+        // table is frozen: decoding during output writing and re-encoding of
+        // known symbols then bypass the flyweight, while functors minting new
+        // symbols fall back to the regular insert path
+        std::size_t lastInputStratum = strata.size();
+        for (std::size_t i = 0; i < strata.size(); i++) {
+            visit(*strata[i], [&](const IO& io) {
+                if (io.get("operation") == "input") {
+                    lastInputStratum = i;
+                }
+            });
+        }
+        for (std::size_t i = 0; i < strata.size(); i++) {
+            os << "if (stratumEnabled[" << i << "]) {\n";
+            emitCode(os, *strata[i]);
+            os << "}\n";
+            if (i == lastInputStratum) {
+                os << "if (performIO) { symTable.freeze(); }\n";
+            }
+        }
+    } else if (Global::config().has("profile") && mainSequence != nullptr &&
+               !visitExists(prog.getMain(), [](const Call&) { return true; })) {
+        // mark the entry into each stratum so that a live profile session can
+        // tell which one is currently executing
+        std::size_t stratumIndex = 0;
+        for (const Statement* stmt : mainSequence->getStatements()) {
+            os << "ProfileEventSingleton::instance().makeTimeEvent(\"@time;stratum;" << stratumIndex++
+               << "\");\n";
+            emitCode(os, *stmt);
+        }
+    } else {
+        emitCode(os, prog.getMain());
+    }
 
     if (Global::config().has("profile")) {
         os << "}\n";
+        // the sampler captures this program; drop it before the relations go away
+        os << "ProfileEventSingleton::instance().clearMemorySampler();\n";
         os << "ProfileEventSingleton::instance().stopTimer();\n";
         os << "dumpFreqs();\n";
     }
@@ -2697,8 +3241,18 @@ void runFunction(std::string  inputDirectoryArg,
             os << name << "->printStatistics(std::cout);\n";
             os << "std::cout << \"\\n\";\n";
         }
+        // in profiled runs the hint hit/miss counters additionally go
+        // into the profile database for offline analysis
+        if (Global::config().has("profile")) {
+            for (auto rel : prog.getRelations()) {
+                os << getRelationName(*rel) << "->addHintStatistics(\"" << rel->getName() << "\");\n";
+            }
+        }
     }
 
+    if (!functors.empty()) {
+        os << "if (souffle_functors_teardown != nullptr) { souffle_functors_teardown(); }\n";
+    }
     os << "signalHandler->reset();\n";
 
     os << "}\n";  // end of runFunction() method
@@ -2716,6 +3270,14 @@ void runFunction(std::string  inputDirectoryArg,
         os << "if (profiler.joinable()) { profiler.join(); }\n";
     }
     os << "}\n";
+
+    // issue reset method, clearing the per-run counters on top of the
+    // relation purge performed by the base class
+    os << "public:\nvoid reset() override {\n";
+    os << "SouffleProgram::reset();\n";
+    os << "ctr = 0;\n";
+    os << "iter = 0;\n";
+    os << "}\n";
     // issue printAll method
     os << "public:\n";
     os << "void printAll(std::string outputDirectoryArg = \"\") override {\n";
@@ -2830,7 +3392,7 @@ void runFunction(std::string  inputDirectoryArg,
 
     if (!prog.getSubroutines().empty()) {
         // generate subroutine adapter
-        os << "void executeSubroutine(std::string name, const std::vector<RamDomain>& args, "
+        os << "SOUFFLE_COLD void executeSubroutine(std::string name, const std::vector<RamDomain>& args, "
               "std::vector<RamDomain>& ret) override {\n";
         // subroutine number
         std::size_t subroutineNum = 0;
@@ -2845,40 +3407,64 @@ void runFunction(std::string  inputDirectoryArg,
         os << "fatal(\"unknown subroutine\");\n";
         os << "}\n";  // end of executeSubroutine
 
-        // generate method for each subroutine
+        // declare the subroutine methods; their bodies are emitted after the
+        // class so that each definition can be assigned to a separate
+        // translation unit when split compilation is requested; subroutines
+        // only run during provenance queries, so they are marked cold to keep
+        // them away from the query loops in the instruction cache
+        for (subroutineNum = 0; subroutineNum < prog.getSubroutines().size(); subroutineNum++) {
+            os << "SOUFFLE_COLD void "
+               << "subroutine_" << subroutineNum
+               << "(const std::vector<RamDomain>& args, "
+                  "std::vector<RamDomain>& ret);\n";
+        }
+
+        // generate method definition for each subroutine
         subroutineNum = 0;
         for (auto& sub : prog.getSubroutines()) {
+            // a guard that restricts the definition to one translation unit
+            // when the source is compiled once per part (see souffle-compile)
+            subroutineDefs << "#if !defined(SOUFFLE_SPLIT_COMPILATION) || defined(SOUFFLE_SPLIT_PART_"
+                           << subroutineNum << ")\n";
+
             // silence unused argument warnings on MSVC
-            os << "#ifdef _MSC_VER\n";
-            os << "#pragma warning(disable: 4100)\n";
-            os << "#endif // _MSC_VER\n";
+            subroutineDefs << "#ifdef _MSC_VER\n";
+            subroutineDefs << "#pragma warning(disable: 4100)\n";
+            subroutineDefs << "#endif // _MSC_VER\n";
 
             // issue method header
-            os << "void "
-               << "subroutine_" << subroutineNum
-               << "(const std::vector<RamDomain>& args, "
-                  "std::vector<RamDomain>& ret) {\n";
+            subroutineDefs << "void " << classname << "::"
+                           << "subroutine_" << subroutineNum
+                           << "(const std::vector<RamDomain>& args, "
+                              "std::vector<RamDomain>& ret) {\n";
 
             // issue lock variable for return statements
             bool needLock = false;
             visit(*sub.second, [&](const SubroutineReturn&) { needLock = true; });
             if (needLock) {
-                os << "std::mutex lock;\n";
+                subroutineDefs << "std::mutex lock;\n";
             }
 
             // emit code for subroutine
-            emitCode(os, *sub.second);
+            emitCode(subroutineDefs, *sub.second);
 
             // issue end of subroutine
-            os << "}\n";
+            subroutineDefs << "}\n";
 
             // restore unused argument warning
-            os << "#ifdef _MSC_VER\n";
-            os << "#pragma warning(default: 4100)\n";
-            os << "#endif // _MSC_VER\n";
+            subroutineDefs << "#ifdef _MSC_VER\n";
+            subroutineDefs << "#pragma warning(default: 4100)\n";
+            subroutineDefs << "#endif // _MSC_VER\n";
+            subroutineDefs << "#endif // SOUFFLE_SPLIT_COMPILATION\n";
             subroutineNum++;
         }
     }
+    // query methods shared between rules that differ only in the relations
+    // they touch; as in-class member templates they are implicitly inline,
+    // so every split-compilation part can instantiate them
+    os << "private:\n";
+    os << sharedQueryMethods.str();
+
     // dumpFreqs method
     //  Frequency counts must be emitted after subroutines otherwise lookup tables
     //  are not populated.
@@ -2893,10 +3479,30 @@ void runFunction(std::string  inputDirectoryArg,
             os << "\tProfileEventSingleton::instance().makeQuantityEvent(R\"_(@relation-reads;" << cur.first
                << ")_\", reads[" << cur.second << "],0);\n";
         }
+        // per-column distinct estimates, feeding cost models and monitoring
+        for (auto rel : prog.getRelations()) {
+            if (rel->isTemp()) {
+                continue;
+            }
+            os << "{\n";
+            os << "const auto stats = wrapper_" << getRelationName(*rel) << ".getColumnStatistics();\n";
+            os << "for (std::size_t c = 0; c < stats.size(); c++) {\n";
+            os << "ProfileEventSingleton::instance().makeQuantityEvent(R\"_(@relation-distinct;"
+               << rel->getName() << ";)_\" + std::to_string(c), stats[c].distinct, 0);\n";
+            os << "}\n";
+            os << "}\n";
+        }
         os << "}\n";  // end of dumpFreqs() method
     }
     os << "};\n";  // end of class declaration
 
+    // subroutine method definitions, one split-compilation part each
+    os << subroutineDefs.str();
+
+    // the remaining definitions must end up in a single object file, so they
+    // are restricted to the main part when split compilation is requested
+    os << "#if !defined(SOUFFLE_SPLIT_COMPILATION) || defined(SOUFFLE_SPLIT_MAIN)\n";
+
     // hidden hooks
     os << "SouffleProgram *newInstance_" << id << "(){return new " << classname << ";}\n";
     os << "SymbolTable *getST_" << id << "(SouffleProgram *p){return &reinterpret_cast<" << classname
@@ -2913,6 +3519,83 @@ void runFunction(std::string  inputDirectoryArg,
     os << "extern \"C\" {\n";
     os << "factory_" << classname << " __factory_" << classname << "_instance;\n";
     os << "}\n";
+
+    // versioned C ABI (see souffle/SouffleCABI.h); implemented purely in
+    // terms of the public SouffleProgram interface so that precompiled
+    // program libraries keep working across engine updates
+    os << "struct CABI_iterator_" << classname << " {\n";
+    os << "Relation::iterator cur;\n";
+    os << "Relation::iterator end;\n";
+    os << "};\n";
+    os << "extern \"C\" {\n";
+    os << "int32_t souffle_cabi_version() { return SOUFFLE_CABI_VERSION; }\n";
+    os << "int32_t souffle_cabi_domain_bits() { return RAM_DOMAIN_SIZE; }\n";
+    os << "souffle_program* souffle_program_create() {\n";
+    os << "return reinterpret_cast<souffle_program*>(static_cast<SouffleProgram*>(new " << classname
+       << "()));\n";
+    os << "}\n";
+    os << "void souffle_program_destroy(souffle_program* program) {\n";
+    os << "delete reinterpret_cast<SouffleProgram*>(program);\n";
+    os << "}\n";
+    os << "void souffle_program_run(souffle_program* program) {\n";
+    os << "reinterpret_cast<SouffleProgram*>(program)->run();\n";
+    os << "}\n";
+    os << "void souffle_program_load_all(souffle_program* program, const char* input_directory) {\n";
+    os << "reinterpret_cast<SouffleProgram*>(program)->loadAll(input_directory);\n";
+    os << "}\n";
+    os << "void souffle_program_print_all(souffle_program* program, const char* output_directory) {\n";
+    os << "reinterpret_cast<SouffleProgram*>(program)->printAll(output_directory);\n";
+    os << "}\n";
+    os << "int64_t souffle_program_encode_symbol(souffle_program* program, const char* symbol) {\n";
+    os << "return static_cast<int64_t>(reinterpret_cast<SouffleProgram*>(program)->getSymbolTable()."
+          "encode(symbol));\n";
+    os << "}\n";
+    os << "const char* souffle_program_decode_symbol(souffle_program* program, int64_t index) {\n";
+    os << "return reinterpret_cast<SouffleProgram*>(program)->getSymbolTable().decode(static_cast<RamDomain>("
+          "index)).c_str();\n";
+    os << "}\n";
+    os << "souffle_relation* souffle_relation_by_name(souffle_program* program, const char* name) {\n";
+    os << "return reinterpret_cast<souffle_relation*>(reinterpret_cast<SouffleProgram*>(program)->"
+          "getRelation(name));\n";
+    os << "}\n";
+    os << "size_t souffle_relation_arity(souffle_relation* relation) {\n";
+    os << "return reinterpret_cast<Relation*>(relation)->getArity();\n";
+    os << "}\n";
+    os << "size_t souffle_relation_size(souffle_relation* relation) {\n";
+    os << "return reinterpret_cast<Relation*>(relation)->size();\n";
+    os << "}\n";
+    os << "void souffle_relation_insert(souffle_relation* relation, const int64_t* data, size_t tuple_count) "
+          "{\n";
+    os << "auto* rel = reinterpret_cast<Relation*>(relation);\n";
+    os << "const std::size_t arity = rel->getArity();\n";
+    os << "tuple t(rel);\n";
+    os << "for (std::size_t i = 0; i < tuple_count; i++) {\n";
+    os << "for (std::size_t j = 0; j < arity; j++) {\n";
+    os << "t[j] = static_cast<RamDomain>(data[i * arity + j]);\n";
+    os << "}\n";
+    os << "rel->insert(t);\n";
+    os << "}\n";
+    os << "}\n";
+    os << "souffle_iterator* souffle_iterator_create(souffle_relation* relation) {\n";
+    os << "auto* rel = reinterpret_cast<Relation*>(relation);\n";
+    os << "return reinterpret_cast<souffle_iterator*>(new CABI_iterator_" << classname
+       << "{rel->begin(), rel->end()});\n";
+    os << "}\n";
+    os << "int souffle_iterator_next(souffle_iterator* iterator, int64_t* out) {\n";
+    os << "auto* it = reinterpret_cast<CABI_iterator_" << classname << "*>(iterator);\n";
+    os << "if (it->cur == it->end) return 0;\n";
+    os << "const tuple& t = *it->cur;\n";
+    os << "for (std::size_t j = 0; j < t.size(); j++) {\n";
+    os << "out[j] = static_cast<int64_t>(t[j]);\n";
+    os << "}\n";
+    os << "++it->cur;\n";
+    os << "return 1;\n";
+    os << "}\n";
+    os << "void souffle_iterator_destroy(souffle_iterator* iterator) {\n";
+    os << "delete reinterpret_cast<CABI_iterator_" << classname << "*>(iterator);\n";
+    os << "}\n";
+    os << "}\n";  // end of extern "C"
+
     os << "}\n";
     os << "#else\n";
     os << "}\n";
@@ -2970,6 +3653,9 @@ void runFunction(std::string  inputDirectoryArg,
     os << "} catch(std::exception &e) { souffle::SignalHandler::instance()->error(e.what());}\n";
     os << "}\n";
     os << "\n#endif\n";
+    os << "#else\n";
+    os << "}\n";  // close the souffle namespace in subroutine-only parts
+    os << "#endif // SOUFFLE_SPLIT_COMPILATION\n";
 
     *recordTable_os << "SpecializedRecordTable<0";
     for (std::size_t arity : arities) {
@@ -29,6 +29,7 @@
 #include <memory>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <string>
 
 namespace souffle::synthesiser {
@@ -55,6 +56,12 @@ private:
     /** Cache for generated types for relations */
     std::set<std::string> typeCache;
 
+    /** Outlined query bodies, keyed by their relation-abstracted text */
+    std::map<std::string, std::size_t> queryBodyCache;
+
+    /** Definitions of the shared query methods backing the cache */
+    std::ostringstream sharedQueryMethods;
+
     /** Relation map */
     std::map<std::string, const ram::Relation*> relationMap;
 
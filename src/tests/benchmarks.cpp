@@ -0,0 +1,373 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file benchmarks.cpp
+ *
+ * Micro-benchmarks for the core data structures. Unlike the unit tests
+ * next door these do not verify behaviour; they measure it, so that a
+ * performance regression in e.g. btree insertion shows up as a number
+ * rather than in production. The binary is built by the dedicated
+ * `souffle_benchmarks` target and is not part of the ctest suite.
+ *
+ * Usage:
+ *   souffle_benchmarks [--json] [--filter=<substring>]
+ *                      [--threads=<n>[,<n>...]] [--repeat=<n>] [--scale=<n>]
+ *
+ * Each benchmark is run `repeat` times and the best wall-clock time is
+ * reported; `--json` emits one record per measurement for CI trend
+ * tracking.
+ *
+ ***********************************************************************/
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/Brie.h"
+#include "souffle/datastructure/ConcurrentInsertOnlyHashMap.h"
+#include "souffle/datastructure/EquivalenceRelation.h"
+#include "souffle/io/ReadStreamCSV.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace souffle::benchmark {
+
+/** A sink keeping computed values observable, so loops are not elided. */
+volatile std::uint64_t sink = 0;
+
+struct Options {
+    bool json = false;
+    std::string filter;
+    std::size_t repeat = 3;
+    std::size_t scale = 1;
+    std::vector<std::size_t> threads;
+};
+
+struct Measurement {
+    std::string name;
+    std::size_t threads;
+    std::size_t operations;
+    double seconds;
+};
+
+std::vector<Measurement> measurements;
+
+/**
+ * The lock-based data structures (btree, brie, equivalence relation) only
+ * compile in their locking protocols when parallel execution is enabled;
+ * sweeping them over multiple mutator threads is only sound then.
+ */
+std::size_t maxMutatorThreads() {
+#ifdef _OPENMP
+    return std::numeric_limits<std::size_t>::max();
+#else
+    return 1;
+#endif
+}
+
+/** Runs the body `repeat` times and records the best wall-clock time. */
+template <typename Body>
+void benchmark(const Options& opt, const std::string& name, std::size_t threads, std::size_t operations,
+        Body&& body) {
+    if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) {
+        return;
+    }
+    double best = std::numeric_limits<double>::max();
+    for (std::size_t run = 0; run < opt.repeat; ++run) {
+        const auto start = std::chrono::steady_clock::now();
+        body();
+        const auto stop = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double>(stop - start).count());
+    }
+    measurements.push_back({name, threads, operations, best});
+}
+
+/** Runs the body on the given number of threads, passing each its index. */
+template <typename Body>
+void inParallel(std::size_t numThreads, Body&& body) {
+    if (numThreads == 1) {
+        body(std::size_t(0));
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < numThreads; ++t) {
+        workers.emplace_back([&body, t] { body(t); });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template <std::size_t Arity>
+std::vector<Tuple<RamDomain, Arity>> randomTuples(std::size_t count) {
+    std::mt19937 prng(42);
+    std::uniform_int_distribution<RamDomain> dist(0, std::numeric_limits<RamDomain>::max());
+    std::vector<Tuple<RamDomain, Arity>> tuples(count);
+    for (auto& tuple : tuples) {
+        for (std::size_t i = 0; i < Arity; ++i) {
+            tuple[i] = dist(prng);
+        }
+    }
+    return tuples;
+}
+
+// -- btree: insert / lookup / scan at several arities ------------------
+
+template <std::size_t Arity>
+void btreeBenchmarks(const Options& opt) {
+    using tuple_type = Tuple<RamDomain, Arity>;
+    using set_type = btree_set<tuple_type>;
+    const std::string suffix = "/arity:" + std::to_string(Arity);
+    const std::size_t count = 1000000 * opt.scale;
+    const auto tuples = randomTuples<Arity>(count);
+
+    for (std::size_t numThreads : opt.threads) {
+        if (numThreads > maxMutatorThreads()) {
+            continue;
+        }
+        benchmark(opt, "btree_insert" + suffix, numThreads, count, [&] {
+            set_type set;
+            inParallel(numThreads, [&](std::size_t t) {
+                typename set_type::operation_hints hints;
+                const std::size_t begin = t * count / numThreads;
+                const std::size_t end = (t + 1) * count / numThreads;
+                for (std::size_t i = begin; i < end; ++i) {
+                    set.insert(tuples[i], hints);
+                }
+            });
+        });
+    }
+
+    set_type set;
+    {
+        typename set_type::operation_hints hints;
+        for (const auto& tuple : tuples) {
+            set.insert(tuple, hints);
+        }
+    }
+
+    benchmark(opt, "btree_lookup" + suffix, 1, count, [&] {
+        typename set_type::operation_hints hints;
+        std::uint64_t hits = 0;
+        for (const auto& tuple : tuples) {
+            hits += set.contains(tuple, hints) ? 1 : 0;
+        }
+        sink = hits;
+    });
+
+    benchmark(opt, "btree_scan" + suffix, 1, set.size(), [&] {
+        std::uint64_t sum = 0;
+        for (const auto& tuple : set) {
+            sum += static_cast<std::uint64_t>(tuple[0]);
+        }
+        sink = sum;
+    });
+}
+
+// -- brie: dense and sparse insertion patterns -------------------------
+
+void brieBenchmarks(const Options& opt) {
+    const std::size_t count = 1000000 * opt.scale;
+
+    benchmark(opt, "brie_insert_dense/arity:2", 1, count, [&] {
+        Trie<2> trie;
+        for (std::size_t i = 0; i < count; ++i) {
+            trie.insert({static_cast<RamDomain>(i >> 6), static_cast<RamDomain>(i & 63)});
+        }
+    });
+
+    const auto tuples = randomTuples<2>(count);
+    benchmark(opt, "brie_insert_sparse/arity:2", 1, count, [&] {
+        Trie<2> trie;
+        for (const auto& tuple : tuples) {
+            trie.insert(tuple);
+        }
+    });
+}
+
+// -- equivalence relation: union and iteration -------------------------
+
+void eqrelBenchmarks(const Options& opt) {
+    using eqrel_type = EquivalenceRelation<Tuple<RamDomain, 2>>;
+    const std::size_t count = 100000 * opt.scale;
+    // chains of 64 elements each; keeps the pair expansion linear in count
+    constexpr RamDomain classSize = 64;
+
+    benchmark(opt, "eqrel_union", 1, count, [&] {
+        eqrel_type eqrel;
+        for (std::size_t i = 0; i < count; ++i) {
+            const auto element = static_cast<RamDomain>(i);
+            eqrel.insert((element / classSize) * classSize, element);
+        }
+    });
+
+    eqrel_type eqrel;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto element = static_cast<RamDomain>(i);
+        eqrel.insert((element / classSize) * classSize, element);
+    }
+    benchmark(opt, "eqrel_iterate", 1, eqrel.size(), [&] {
+        std::uint64_t sum = 0;
+        for (const auto& pair : eqrel) {
+            sum += static_cast<std::uint64_t>(pair[0]);
+        }
+        sink = sum;
+    });
+}
+
+// -- concurrent hash map: contended interning --------------------------
+
+void hashMapBenchmarks(const Options& opt) {
+    using map_type = ConcurrentInsertOnlyHashMap<ConcurrentLanes, RamDomain, RamDomain>;
+    const std::size_t count = 1000000 * opt.scale;
+
+    for (std::size_t numThreads : opt.threads) {
+        // all threads intern the same key range, so most operations race
+        // on keys that are present or about to be
+        benchmark(opt, "hashmap_intern_contended", numThreads, count * numThreads, [&] {
+            map_type map(numThreads, 1 << 10);
+            inParallel(numThreads, [&](std::size_t t) {
+                auto* node = map.node(0);
+                for (std::size_t i = 0; i < count; ++i) {
+                    const auto key = static_cast<RamDomain>((i + t * 7919) % count);
+                    const auto result = map.get(t, node, key);
+                    if (result.second) {
+                        node = map.node(0);
+                    }
+                }
+                delete node;
+            });
+        });
+    }
+}
+
+// -- CSV reading: parse throughput -------------------------------------
+
+void csvBenchmarks(const Options& opt) {
+    const std::size_t rows = 1000000 * opt.scale;
+    std::string input;
+    input.reserve(rows * 24);
+    for (std::size_t i = 0; i < rows; ++i) {
+        input += std::to_string(i);
+        input += '\t';
+        input += std::to_string(i * 31);
+        input += "\tsym";
+        input += std::to_string(i % 1024);
+        input += '\n';
+    }
+    const std::map<std::string, std::string> rwOperation = {
+            {"types", R"({"relation": {"arity": 3, "types": ["i:a", "i:b", "s:c"]}})"}};
+
+    // a relation stub absorbing tuples at no cost; parsing dominates
+    struct CountingRelation {
+        std::size_t count = 0;
+        void insert(const RamDomain*) {
+            ++count;
+        }
+    };
+
+    benchmark(opt, "csv_parse", 1, rows, [&] {
+        SymbolTable symbolTable;
+        SpecializedRecordTable<2> recordTable;
+        std::istringstream file(input);
+        ReadStreamCSV reader(file, rwOperation, symbolTable, recordTable);
+        CountingRelation relation;
+        reader.readAll(relation);
+        sink = relation.count;
+    });
+}
+
+// -- driver ------------------------------------------------------------
+
+void report(const Options& opt) {
+    if (opt.json) {
+        std::cout << "[\n";
+        for (std::size_t i = 0; i < measurements.size(); ++i) {
+            const auto& m = measurements[i];
+            std::cout << "  {\"name\": \"" << m.name << "\", \"threads\": " << m.threads
+                      << ", \"operations\": " << m.operations << ", \"seconds\": " << m.seconds
+                      << ", \"ns_per_op\": " << (m.seconds * 1e9 / static_cast<double>(m.operations)) << "}"
+                      << (i + 1 < measurements.size() ? "," : "") << "\n";
+        }
+        std::cout << "]\n";
+        return;
+    }
+    for (const auto& m : measurements) {
+        std::printf("%-32s threads:%2zu %12zu ops %10.3f s %10.1f ns/op\n", m.name.c_str(), m.threads,
+                m.operations, m.seconds, m.seconds * 1e9 / static_cast<double>(m.operations));
+    }
+}
+
+Options parseOptions(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        auto value = [&](const std::string& prefix) -> std::string {
+            return arg.substr(prefix.size());
+        };
+        if (arg == "--json") {
+            opt.json = true;
+        } else if (arg.rfind("--filter=", 0) == 0) {
+            opt.filter = value("--filter=");
+        } else if (arg.rfind("--repeat=", 0) == 0) {
+            opt.repeat = std::stoul(value("--repeat="));
+        } else if (arg.rfind("--scale=", 0) == 0) {
+            opt.scale = std::stoul(value("--scale="));
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            std::stringstream list(value("--threads="));
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                opt.threads.push_back(std::stoul(item));
+            }
+        } else {
+            std::cerr << "unknown option: " << arg << "\n";
+            std::exit(1);
+        }
+    }
+    if (opt.threads.empty()) {
+        const std::size_t hardware = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        for (std::size_t t = 1; t <= hardware; t *= 2) {
+            opt.threads.push_back(t);
+        }
+    }
+    return opt;
+}
+
+int main(int argc, char** argv) {
+    const Options opt = parseOptions(argc, argv);
+    btreeBenchmarks<1>(opt);
+    btreeBenchmarks<2>(opt);
+    btreeBenchmarks<4>(opt);
+    brieBenchmarks(opt);
+    eqrelBenchmarks(opt);
+    hashMapBenchmarks(opt);
+    csvBenchmarks(opt);
+    report(opt);
+    return 0;
+}
+
+}  // namespace souffle::benchmark
+
+int main(int argc, char** argv) {
+    return souffle::benchmark::main(argc, argv);
+}
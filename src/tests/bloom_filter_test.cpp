@@ -0,0 +1,97 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file bloom_filter_test.cpp
+ *
+ * Test cases for the BloomFilter data structure.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/BloomFilter.h"
+#include <cstddef>
+
+namespace souffle {
+
+TEST(BloomFilter, Basic) {
+    BloomFilter filter;
+
+    EXPECT_FALSE(filter.mayContain(1));
+
+    filter.insert(1);
+    EXPECT_TRUE(filter.mayContain(1));
+}
+
+TEST(BloomFilter, NoFalseNegatives) {
+    BloomFilter filter;
+
+    const std::size_t N = 100000;
+    for (std::size_t i = 0; i < N; i++) {
+        filter.insert(i);
+    }
+
+    // inserted keys remain visible across segment growth
+    for (std::size_t i = 0; i < N; i++) {
+        EXPECT_TRUE(filter.mayContain(i));
+    }
+}
+
+TEST(BloomFilter, FalsePositiveRate) {
+    BloomFilter filter;
+
+    const std::size_t N = 100000;
+    for (std::size_t i = 0; i < N; i++) {
+        filter.insert(i);
+    }
+
+    // absent keys are mostly rejected; the bound is deliberately loose
+    // since the rate depends on the segment sizing
+    std::size_t falsePositives = 0;
+    for (std::size_t i = N; i < 2 * N; i++) {
+        if (filter.mayContain(i)) {
+            falsePositives++;
+        }
+    }
+    EXPECT_LT(falsePositives, N / 4);
+}
+
+TEST(BloomFilter, Clear) {
+    BloomFilter filter;
+
+    for (std::size_t i = 0; i < 1000; i++) {
+        filter.insert(i);
+    }
+
+    filter.clear();
+    EXPECT_FALSE(filter.mayContain(0));
+
+    // the filter remains usable after clearing
+    filter.insert(42);
+    EXPECT_TRUE(filter.mayContain(42));
+}
+
+#ifdef _OPENMP
+TEST(BloomFilter, ParallelInsert) {
+    BloomFilter filter;
+
+    const int N = 100000;
+#pragma omp parallel for num_threads(4)
+    for (int i = 0; i < N; i++) {
+        filter.insert(static_cast<std::size_t>(i));
+    }
+
+    for (int i = 0; i < N; i++) {
+        EXPECT_TRUE(filter.mayContain(static_cast<std::size_t>(i)));
+    }
+}
+#endif  // _OPENMP
+
+}  // namespace souffle
@@ -440,43 +440,23 @@ TEST(SparseArray, UpperBound2) {
 }
 
 TEST(SparseArray, MemoryUsage) {
-    if (sizeof(void*) > 4) {
-        SparseArray<int> a;
-
-        // an empty one should be small
-        EXPECT_TRUE(a.empty());
-        // EXPECT_EQ(56, a.getMemoryUsage());
-        EXPECT_EQ(40, a.getMemoryUsage());
-
-        // a single element should have the same size as an empty one
-        a.update(12, 15);
-        EXPECT_FALSE(a.empty());
-        // EXPECT_EQ(56, a.getMemoryUsage());
-        EXPECT_EQ(560, a.getMemoryUsage());
-
-        // more than one => there are nodes
-        a.update(14, 18);
-        EXPECT_FALSE(a.empty());
-
-        // EXPECT_EQ(576, a.getMemoryUsage());
-        EXPECT_EQ(560, a.getMemoryUsage());
-    } else {
-        SparseArray<int> a;
-
-        // an empty one should be small
-        EXPECT_TRUE(a.empty());
-        EXPECT_EQ(28, a.getMemoryUsage());
-
-        // a single element should have the same size as an empty one
-        a.update(12, 15);
-        EXPECT_FALSE(a.empty());
-        EXPECT_EQ(288, a.getMemoryUsage());
-
-        // more than one => there are nodes
-        a.update(14, 18);
-        EXPECT_FALSE(a.empty());
-        EXPECT_EQ(288, a.getMemoryUsage());
-    }
+    SparseArray<int> a;
+
+    // an empty one should be small
+    EXPECT_TRUE(a.empty());
+    auto empty_usage = a.getMemoryUsage();
+    EXPECT_TRUE(sizeof(a) <= empty_usage);
+
+    // the first element materializes a leaf node
+    a.update(12, 15);
+    EXPECT_FALSE(a.empty());
+    auto one_usage = a.getMemoryUsage();
+    EXPECT_LT(empty_usage, one_usage);
+
+    // a second element in the same leaf does not allocate
+    a.update(14, 18);
+    EXPECT_FALSE(a.empty());
+    EXPECT_EQ(one_usage, a.getMemoryUsage());
 }
 
 TEST(SparseBitMap, Basic) {
@@ -1671,6 +1651,52 @@ TEST(Trie, Limits) {
     EXPECT_EQ(2, counter);
 }
 
+TEST(Trie, SpanWidth) {
+    using tuple = std::array<RamDomain, 2>;
+
+    const int N = 10000;
+
+    // a narrow span reduces the node fan-out for sparse domains; the
+    // iterator, boundary and partition contracts must be unaffected
+    Trie<2, 3> set;
+
+    std::set<tuple> data;
+    while (data.size() < N) {
+        tuple cur;
+        cur[0] = (RamDomain)(rand(N * 10));
+        cur[1] = (RamDomain)(rand(N * 10));
+        if (data.insert(cur).second) {
+            EXPECT_FALSE(set.contains(cur));
+            set.insert(cur);
+            EXPECT_TRUE(set.contains(cur));
+        }
+    }
+
+    std::set<tuple> is;
+    for (const auto& cur : set) {
+        is.insert(cur);
+    }
+
+    EXPECT_EQ(N, set.size());
+    EXPECT_EQ(data, is);
+
+    // check the partition contract - the chunks must cover the full content
+    std::set<tuple> chunked;
+    for (const auto& chunk : set.partition(100)) {
+        for (const auto& cur : chunk) {
+            chunked.insert(cur);
+        }
+    }
+    EXPECT_EQ(data, chunked);
+
+    // check boundaries on a fixed first component
+    tuple probe = *data.begin();
+    auto range = set.getBoundaries<1>(probe);
+    for (const auto& cur : range) {
+        EXPECT_EQ(probe[0], cur[0]);
+    }
+}
+
 TEST(Trie, Parallel) {
     const int N = 10000;
 
@@ -1745,4 +1771,31 @@ TEST(Trie, Parallel) {
     }
 }
 
+TEST(Trie, ParallelContexts) {
+    const int N = 50000;
+
+    // insert a dense range of values in parallel, each thread drawing its
+    // nodes through a persistent context and thus through the batched
+    // per-thread node pool
+    using entry_t = typename Trie<2>::entry_type;
+    Trie<2> res;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+    {
+        typename Trie<2>::op_context ctxt;
+#ifdef _OPENMP
+#pragma omp for
+#endif
+        for (int i = 0; i < N; i++) {
+            res.insert(entry_t{(RamDomain)(i / 100), (RamDomain)(i % 100)}, ctxt);
+        }
+    }
+
+    EXPECT_EQ(N, res.size());
+    for (int i = 0; i < N; i++) {
+        EXPECT_TRUE(res.contains(entry_t{(RamDomain)(i / 100), (RamDomain)(i % 100)}));
+    }
+}
+
 }  // namespace souffle
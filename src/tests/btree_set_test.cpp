@@ -20,6 +20,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdlib>
 #include <functional>
@@ -259,6 +260,36 @@ TEST(BTreeSet, Shuffled) {
     }
 }
 
+TEST(BTreeSet, SimdSearch) {
+    using key = std::array<int32_t, 1>;
+    using test_set = btree_set<key, detail::comparator<key>, std::allocator<key>, 256, detail::simd_search>;
+
+    test_set t;
+
+    int N = 10000;
+
+    std::vector<int32_t> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i * 3 - N);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+
+    shuffle(data.begin(), data.end(), generator);
+
+    for (int i = 0; i < N; i++) {
+        t.insert(key{data[i]});
+    }
+
+    for (int i = 0; i < N - 1; i++) {
+        int32_t v = i * 3 - N;
+        EXPECT_TRUE(t.contains(key{v})) << "v=" << v;
+        EXPECT_FALSE(t.contains(key{v + 1})) << "v=" << v;
+        EXPECT_EQ(v, (*t.lower_bound(key{v}))[0]);
+        EXPECT_EQ(v + 3, (*t.upper_bound(key{v}))[0]);
+    }
+}
+
 TEST(BTreeSet, Copy) {
     using test_set = btree_set<int>;
 
@@ -335,6 +366,47 @@ TEST(BTreeSet, Merge) {
     EXPECT_NE(c, d);
 }
 
+TEST(BTreeSet, InsertAll) {
+    using test_set = btree_set<int>;
+
+    const int N = 10000;
+
+    // merging into an empty tree adopts a copy of the source
+    test_set a;
+    for (int i = 0; i < N; i++) {
+        a.insert(2 * i);
+    }
+
+    test_set b;
+    b.insertAll(a);
+    EXPECT_EQ(a.size(), b.size());
+    for (int i = 0; i < N; i++) {
+        EXPECT_TRUE(b.contains(2 * i));
+    }
+
+    // merging into a non-empty tree yields the union
+    test_set c;
+    for (int i = 0; i < N; i++) {
+        c.insert(3 * i);
+    }
+    c.insertAll(a);
+
+    std::set<int> ref;
+    for (int i = 0; i < N; i++) {
+        ref.insert(2 * i);
+        ref.insert(3 * i);
+    }
+    EXPECT_EQ(ref.size(), c.size());
+    for (const auto& cur : ref) {
+        EXPECT_TRUE(c.contains(cur));
+    }
+
+    // merging an empty tree is a no-op
+    std::size_t size = c.size();
+    c.insertAll(test_set());
+    EXPECT_EQ(size, c.size());
+}
+
 TEST(BTreeSet, IteratorEmpty) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
     test_set t;
@@ -399,6 +471,61 @@ TEST(BTreeSet, IteratorStress) {
     }
 }
 
+TEST(BTreeSet, IteratorReverse) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    test_set t;
+
+    EXPECT_EQ(t.rbegin(), t.rend());
+
+    int N = 1000;
+
+    std::vector<int> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+
+    shuffle(data.begin(), data.end(), generator);
+
+    for (int i = 0; i < N; i++) {
+        t.insert(data[i]);
+    }
+
+    // a full reverse scan enumerates all elements in descending order
+    int expected = N - 1;
+    for (auto it = t.rbegin(); it != t.rend(); ++it) {
+        EXPECT_EQ(expected, *it);
+        expected--;
+    }
+    EXPECT_EQ(-1, expected);
+
+    // an arbitrary range can be walked backwards through the same index
+    auto a = t.lower_bound(100);
+    auto b = t.upper_bound(900);
+    expected = 900;
+    for (auto it = std::make_reverse_iterator(b); it != std::make_reverse_iterator(a); ++it) {
+        EXPECT_EQ(expected, *it);
+        expected--;
+    }
+    EXPECT_EQ(99, expected);
+
+    // reverse iteration skips leaves emptied by erase, including the extremes
+    shuffle(data.begin(), data.end(), generator);
+    for (int i = 0; i < N; i++) {
+        if (data[i] % 2 == 0) {
+            EXPECT_TRUE(t.erase(data[i])) << "i=" << data[i];
+        }
+    }
+    expected = N - 1;
+    for (auto it = t.rbegin(); it != t.rend(); ++it) {
+        EXPECT_EQ(expected, *it);
+        expected -= 2;
+    }
+    EXPECT_EQ(-1, expected);
+}
+
 TEST(BTreeSet, BoundaryTest) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -484,6 +611,58 @@ TEST(BTreeSet, Load) {
     }
 }
 
+TEST(BTreeSet, InsertSorted) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    // ordered input with duplicates bulk-loads an empty tree
+    for (int N = 0; N < 100; N++) {
+        std::vector<int> data;
+        for (int i = 0; i < N; i++) {
+            data.push_back(i);
+            data.push_back(i);
+        }
+
+        test_set t;
+        t.insert_sorted(data.begin(), data.end());
+
+        EXPECT_EQ((std::size_t)N, t.size());
+        EXPECT_TRUE(t.check());
+
+        int last = -1;
+        for (int c : t) {
+            EXPECT_EQ(last + 1, c);
+            last = c;
+        }
+        EXPECT_EQ(last, N - 1);
+    }
+
+    // unordered input falls back to the ordinary insertion
+    {
+        std::vector<int> data = {4, 2, 7, 1, 3};
+        test_set t;
+        t.insert_sorted(data.begin(), data.end());
+        EXPECT_EQ(5u, t.size());
+        EXPECT_TRUE(t.check());
+        for (int c : data) {
+            EXPECT_TRUE(t.contains(c));
+        }
+    }
+
+    // a non-empty tree absorbs the range through the ordinary insertion
+    {
+        test_set t;
+        t.insert(10);
+        std::vector<int> data = {5, 15, 25};
+        t.insert_sorted(data.begin(), data.end());
+        EXPECT_EQ(4u, t.size());
+        EXPECT_TRUE(t.check());
+        EXPECT_TRUE(t.contains(10));
+        for (int c : data) {
+            EXPECT_TRUE(t.contains(c));
+        }
+    }
+}
+
 TEST(BTreeSet, Clear) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -501,6 +680,268 @@ TEST(BTreeSet, Clear) {
     EXPECT_TRUE(t.empty());
 }
 
+TEST(BTreeSet, Erase) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    test_set t;
+
+    int N = 10000;
+
+    std::vector<int> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+
+    shuffle(data.begin(), data.end(), generator);
+
+    for (int i = 0; i < N; i++) {
+        t.insert(data[i]);
+    }
+
+    // erase every second element in random order
+    shuffle(data.begin(), data.end(), generator);
+    for (int i = 0; i < N; i++) {
+        if (data[i] % 2 == 0) {
+            EXPECT_TRUE(t.erase(data[i])) << "i=" << data[i];
+            EXPECT_FALSE(t.erase(data[i])) << "i=" << data[i];
+        }
+    }
+
+    EXPECT_EQ(N / 2, (int)t.size());
+
+    // the remaining elements are still found and enumerated in order
+    for (int i = 0; i < N; i++) {
+        EXPECT_EQ(i % 2 != 0, t.contains(i)) << "i=" << i;
+    }
+    int expected = 1;
+    for (int cur : t) {
+        EXPECT_EQ(expected, cur);
+        expected += 2;
+    }
+
+    // erase everything, including the first element
+    for (int i = 1; i < N; i += 2) {
+        EXPECT_TRUE(t.erase(i)) << "i=" << i;
+    }
+    EXPECT_TRUE(t.size() == 0);
+    EXPECT_TRUE(t.begin() == t.end());
+
+    // the tree remains usable afterwards
+    t.insert(42);
+    EXPECT_TRUE(t.contains(42));
+    EXPECT_EQ(1, (int)t.size());
+}
+
+TEST(BTreeSet, ArenaAllocation) {
+    using test_set = btree_set<int, detail::comparator<int>, detail::arena_allocation, 16>;
+
+    const int N = 10000;
+
+    // fill a tree backed by an arena with a shuffled sequence
+    std::vector<int> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    shuffle(data.begin(), data.end(), generator);
+
+    test_set t;
+    for (int i : data) {
+        t.insert(i);
+    }
+
+    EXPECT_EQ(N, (int)t.size());
+    EXPECT_TRUE(t.check());
+
+    int last = -1;
+    for (int c : t) {
+        EXPECT_EQ(last + 1, c);
+        last = c;
+    }
+    EXPECT_EQ(last, N - 1);
+
+    // a copy clones the content into its own arena
+    test_set c = t;
+    EXPECT_EQ(t, c);
+    EXPECT_TRUE(c.check());
+
+    // clearing releases the node storage wholesale and the tree is reusable
+    t.clear();
+    EXPECT_TRUE(t.empty());
+    for (int i = 0; i < N; i++) {
+        t.insert(i);
+    }
+    EXPECT_EQ(N, (int)t.size());
+    EXPECT_TRUE(t.check());
+
+    // the bulk-load facility draws from the arena of the result as well
+    std::sort(data.begin(), data.end());
+    auto l = test_set::load(data.begin(), data.end());
+    EXPECT_EQ(N, (int)l.size());
+    EXPECT_TRUE(l.check());
+
+    // swapping exchanges the arenas along with the content
+    t.clear();
+    t.swap(l);
+    EXPECT_EQ(N, (int)t.size());
+    EXPECT_TRUE(t.check());
+    EXPECT_TRUE(l.empty());
+}
+
+TEST(BTreeSet, PoolAllocation) {
+    using test_set = btree_set<int, detail::comparator<int>, detail::pool_allocation, 16>;
+
+    const int N = 10000;
+
+    std::vector<int> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i);
+    }
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    shuffle(data.begin(), data.end(), generator);
+
+    // fill a tree backed by a node pool with a shuffled sequence
+    test_set t;
+    for (int i : data) {
+        t.insert(i);
+    }
+    EXPECT_EQ(N, (int)t.size());
+    EXPECT_TRUE(t.check());
+
+    // clearing recycles the nodes into the pool -- refilling the tree must
+    // not grow its memory footprint beyond the established high-water mark
+    const auto highWater = t.getMemoryUsage();
+    for (int round = 0; round < 3; round++) {
+        t.clear();
+        EXPECT_TRUE(t.empty());
+        EXPECT_EQ(highWater, t.getMemoryUsage());
+        for (int i : data) {
+            t.insert(i);
+        }
+        EXPECT_EQ(N, (int)t.size());
+        EXPECT_TRUE(t.check());
+        EXPECT_EQ(highWater, t.getMemoryUsage());
+    }
+
+    int last = -1;
+    for (int c : t) {
+        EXPECT_EQ(last + 1, c);
+        last = c;
+    }
+    EXPECT_EQ(last, N - 1);
+
+    // swapping exchanges the pools along with the content
+    test_set s;
+    s.insert(42);
+    t.swap(s);
+    EXPECT_EQ(1, (int)t.size());
+    EXPECT_EQ(N, (int)s.size());
+    EXPECT_TRUE(s.check());
+}
+
+TEST(BTreeSet, WeakFind) {
+    // a provenance-shaped key: ordered by both components, deduplicated
+    // by the first, with the second maintained through the updater
+    using entry = std::pair<int, int>;
+    struct full_comparator {
+        int operator()(const entry& a, const entry& b) const {
+            return a < b ? -1 : (b < a ? 1 : 0);
+        }
+        bool less(const entry& a, const entry& b) const {
+            return a < b;
+        }
+        bool equal(const entry& a, const entry& b) const {
+            return a == b;
+        }
+    };
+    struct payload_comparator {
+        int operator()(const entry& a, const entry& b) const {
+            return a.first < b.first ? -1 : (b.first < a.first ? 1 : 0);
+        }
+        bool less(const entry& a, const entry& b) const {
+            return a.first < b.first;
+        }
+        bool equal(const entry& a, const entry& b) const {
+            return a.first == b.first;
+        }
+    };
+    struct height_updater {
+        void update(entry& old_t, const entry& new_t) {
+            old_t.second = new_t.second;
+        }
+    };
+    using test_set = btree_set<entry, full_comparator, std::allocator<entry>, 16,
+            typename detail::default_strategy<entry>::type, payload_comparator, height_updater>;
+
+    const int N = 1000;
+
+    test_set t;
+    for (int i = 0; i < N; i++) {
+        t.insert({i, i + 100});
+    }
+    EXPECT_EQ(N, (int)t.size());
+
+    // a weakly equal insert does not add an element but updates the height
+    t.insert({42, 7});
+    EXPECT_EQ(N, (int)t.size());
+
+    // a single descent locates the unique element per payload, whatever
+    // the probe carries in the ignored component
+    test_set::operation_hints hints;
+    for (int i = 0; i < N; i++) {
+        auto it = t.weak_find({i, -1}, hints);
+        EXPECT_TRUE(it != t.end());
+        EXPECT_EQ(i, (*it).first);
+        EXPECT_EQ(i == 42 ? 7 : i + 100, (*it).second);
+    }
+    EXPECT_TRUE(t.weak_find({N, 0}) == t.end());
+    EXPECT_TRUE(t.weak_find({-1, 0}) == t.end());
+}
+
+TEST(BTreeSet, ContainsSorted) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    const int N = 10000;
+
+    test_set t;
+    for (int i = 0; i < N; i++) {
+        t.insert(3 * i);
+    }
+
+    // an empty tree rejects every probe
+    std::vector<int> probes;
+    for (int i = 0; i < 3 * N; i++) {
+        probes.push_back(i);
+    }
+    std::vector<bool> res;
+    test_set().contains_sorted(probes.begin(), probes.end(), std::back_inserter(res));
+    EXPECT_EQ(probes.size(), res.size());
+    for (bool hit : res) {
+        EXPECT_FALSE(hit);
+    }
+
+    // a dense sorted block of probes agrees with per-element lookups
+    res.clear();
+    t.contains_sorted(probes.begin(), probes.end(), std::back_inserter(res));
+    EXPECT_EQ(probes.size(), res.size());
+    for (std::size_t i = 0; i < probes.size(); i++) {
+        EXPECT_EQ(t.contains(probes[i]), (bool)res[i]);
+    }
+
+    // a sparse block including duplicates and out-of-range probes
+    probes = {-7, -1, 0, 0, 299, 300, 301, 3 * (N - 1), 3 * N, 3 * N + 5};
+    res.clear();
+    t.contains_sorted(probes.begin(), probes.end(), std::back_inserter(res));
+    EXPECT_EQ(probes.size(), res.size());
+    for (std::size_t i = 0; i < probes.size(); i++) {
+        EXPECT_EQ(t.contains(probes[i]), (bool)res[i]);
+    }
+}
+
 TEST(BTreeSet, ChunkSplit) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
@@ -0,0 +1,137 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file compressed_tuple_store_test.cpp
+ *
+ * Test cases for the CompressedTupleStore data structure.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/CompressedTupleStore.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace souffle {
+
+using TestTuple = Tuple<RamDomain, 3>;
+using TestStore = CompressedTupleStore<TestTuple>;
+
+TEST(CompressedTupleStore, Empty) {
+    TestStore store;
+
+    EXPECT_TRUE(store.empty());
+    EXPECT_EQ(0, store.size());
+    EXPECT_EQ(store.begin(), store.end());
+    EXPECT_FALSE(store.contains(TestTuple{1, 2, 3}));
+    EXPECT_EQ(store.end(), store.lower_bound(TestTuple{0, 0, 0}));
+}
+
+TEST(CompressedTupleStore, ScanRoundTrip) {
+    const int N = 10000;
+
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::uniform_int_distribution<RamDomain> dist(0, 200);
+
+    std::vector<TestTuple> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(TestTuple{dist(generator), dist(generator), dist(generator)});
+    }
+    // extreme values exercise delta wrap-around in the varint coding
+    data.push_back(TestTuple{std::numeric_limits<RamDomain>::min(), 0, 0});
+    data.push_back(TestTuple{std::numeric_limits<RamDomain>::max(), 0, 0});
+    std::sort(data.begin(), data.end());
+    data.erase(std::unique(data.begin(), data.end()), data.end());
+
+    TestStore store(data);
+    EXPECT_EQ(data.size(), store.size());
+
+    // a full scan reproduces the input exactly
+    std::size_t i = 0;
+    for (const auto& cur : store) {
+        EXPECT_EQ(data[i], cur);
+        i++;
+    }
+    EXPECT_EQ(data.size(), i);
+}
+
+TEST(CompressedTupleStore, Lookup) {
+    const int N = 5000;
+
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::uniform_int_distribution<RamDomain> dist(0, 100);
+
+    std::vector<TestTuple> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(TestTuple{dist(generator), dist(generator), dist(generator)});
+    }
+    std::sort(data.begin(), data.end());
+    data.erase(std::unique(data.begin(), data.end()), data.end());
+
+    TestStore store(data);
+
+    // every stored tuple is found; bounds agree with the uncompressed data
+    for (const auto& cur : data) {
+        EXPECT_TRUE(store.contains(cur));
+        EXPECT_EQ(cur, *store.find(cur));
+    }
+
+    for (int i = 0; i < 200; i++) {
+        TestTuple probe{dist(generator), dist(generator), dist(generator)};
+
+        auto expected = std::lower_bound(data.begin(), data.end(), probe);
+        auto actual = store.lower_bound(probe);
+        if (expected == data.end()) {
+            EXPECT_EQ(store.end(), actual);
+        } else {
+            EXPECT_EQ(*expected, *actual);
+        }
+
+        expected = std::upper_bound(data.begin(), data.end(), probe);
+        actual = store.upper_bound(probe);
+        if (expected == data.end()) {
+            EXPECT_EQ(store.end(), actual);
+        } else {
+            EXPECT_EQ(*expected, *actual);
+        }
+    }
+}
+
+TEST(CompressedTupleStore, CompressionRatio) {
+    // points-to shape: neighbouring tuples differ only in the last
+    // attribute, so deltas collapse to a prefix byte and a small varint
+    std::vector<TestTuple> data;
+    for (RamDomain a = 0; a < 100; a++) {
+        for (RamDomain b = 0; b < 100; b++) {
+            data.push_back(TestTuple{a, a + 1000, b});
+        }
+    }
+    TestStore store(data);
+
+    const std::size_t raw = data.size() * sizeof(TestTuple);
+    EXPECT_LT(store.getByteSize() * 3, raw);
+
+    // the compressed scan still reproduces the input
+    std::size_t i = 0;
+    for (const auto& cur : store) {
+        EXPECT_EQ(data[i], cur);
+        i++;
+    }
+    EXPECT_EQ(data.size(), i);
+}
+
+}  // namespace souffle
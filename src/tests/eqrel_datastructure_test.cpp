@@ -146,6 +146,36 @@ TEST(PiggyTest, Iteration) {
     }
 }
 
+TEST(PiggyTest, IterationMultiBlock) {
+    souffle::PiggyList<std::size_t> pl;
+    // spans several doubling blocks past the 65536 element first block
+    constexpr std::size_t N = 300000;
+    for (std::size_t i = 0; i < N; ++i) {
+        pl.append(i);
+    }
+    std::size_t counter = 0;
+    for (std::size_t e : pl) {
+        EXPECT_EQ(e, counter++);
+    }
+    EXPECT_EQ(counter, N);
+}
+
+TEST(PiggyTest, ForEachParallel) {
+    souffle::PiggyList<std::size_t> pl;
+    constexpr std::size_t N = 100000;
+    for (std::size_t i = 0; i < N; ++i) {
+        pl.append(i);
+    }
+    std::atomic<std::size_t> count{0};
+    std::atomic<std::size_t> sum{0};
+    pl.forEachParallel([&](std::size_t e) {
+        count.fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(e, std::memory_order_relaxed);
+    });
+    EXPECT_EQ(count.load(), N);
+    EXPECT_EQ(sum.load(), N * (N - 1) / 2);
+}
+
 TEST(PiggyTest, CopyCtor) {
     souffle::PiggyList<std::size_t> pl;
     constexpr std::size_t N = 10000;
@@ -300,6 +330,46 @@ TEST(DjTest, TestUnion) {
     EXPECT_EQ(ds.size(), 5);
 }
 
+TEST(DjTest, BulkUnion) {
+    // the hook-and-compress kernel must produce the same partition as per-pair unions
+    souffle::DisjointSet ds;
+    constexpr std::size_t N = 100000;
+
+    for (std::size_t i = 0; i < N; ++i) {
+        ds.makeNode();
+    }
+
+    // seed some sets through the incremental path so the batch hooks onto existing trees
+    for (std::size_t i = 0; i < N / 2; i += 2) {
+        ds.unionNodes(i, i + 2);
+    }
+
+    // chain up the odd nodes, and join them onto the even chain
+    std::vector<std::pair<parent_t, parent_t>> batch;
+    for (std::size_t i = 1; i + 2 < N; i += 2) {
+        batch.push_back({i, i + 2});
+    }
+    batch.push_back({0, 1});
+    // finish the even chain too
+    for (std::size_t i = N / 2; i + 2 < N; i += 2) {
+        batch.push_back({i, i + 2});
+    }
+    ds.unionAll(batch);
+
+    // everything collapses into a single set
+    parent_t rep = ds.findNode(0);
+    for (std::size_t i = 0; i < N; ++i) {
+        EXPECT_EQ(rep, ds.findNode(i));
+    }
+    EXPECT_EQ(ds.size(), N);
+
+    // the incremental path must still work afterwards
+    parent_t extra = DisjointSet::b2p(ds.makeNode());
+    EXPECT_FALSE(ds.sameSet(0, extra));
+    ds.unionNodes(0, extra);
+    EXPECT_TRUE(ds.sameSet(extra, N - 1));
+}
+
 #ifdef _OPENMP
 TEST(DjTest, ParallelScaling) {
     // insert, union, and stuff in parallel, then check things are in the valid sets
@@ -373,6 +443,28 @@ TEST(SparseDjTest, TestUnion) {
     EXPECT_EQ(sds.size(), 3);
 }
 
+TEST(SparseDjTest, BulkUnion) {
+    // bulk union on sparse values, mixing seen and unseen elements
+    souffle::SparseDisjointSet<std::size_t> sds;
+    constexpr std::size_t N = 100000;
+
+    for (std::size_t i = 0; i < N / 2; ++i) {
+        sds.makeNode(i * 50);
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> batch;
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+        batch.push_back({i * 50, (i + 1) * 50});
+    }
+    sds.unionAll(batch);
+
+    EXPECT_EQ(sds.size(), N);
+    for (std::size_t i = 0; i + 1 < N; ++i) {
+        EXPECT_TRUE(sds.contains(i * 50, (i + 1) * 50));
+    }
+    EXPECT_TRUE(sds.contains(0, (N - 1) * 50));
+}
+
 TEST(SparseDjTest, SignedData) {
     // test when the sparse dj set stores different signed-ness to the internally stored data
     souffle::SparseDisjointSet<std::size_t> sds;
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <iostream>
 #include <random>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -177,6 +178,60 @@ TEST(Flyweight, FindOrInsertCopy) {
     }
 }
 
+TEST(Flyweight, Sweep) {
+    using index_type = FlyweightImpl<std::string>::index_type;
+    constexpr std::size_t N = 1000;
+
+    FlyweightImpl<std::string> flyweight{1};
+    std::vector<index_type> keys(N);
+    for (std::size_t i = 0; i < N; ++i) {
+        std::tie(keys[i], std::ignore) = flyweight.findOrInsert("value-" + std::to_string(i));
+    }
+
+    // warm the per-thread fetch cache so the sweep has stale entries to drop
+    for (std::size_t i = 0; i < N; ++i) {
+        EXPECT_EQ("value-" + std::to_string(i), flyweight.fetch(keys[i]));
+    }
+
+    // sweep out the odd half of the elements
+    std::set<index_type> live;
+    for (std::size_t i = 0; i < N; i += 2) {
+        live.insert(keys[i]);
+    }
+    const std::size_t swept = flyweight.sweep([&](const index_type idx) { return live.count(idx) > 0; });
+    EXPECT_EQ(N / 2, swept);
+
+    // survivors keep their index and value, swept elements are gone
+    for (std::size_t i = 0; i < N; ++i) {
+        if (i % 2 == 0) {
+            EXPECT_EQ("value-" + std::to_string(i), flyweight.fetch(keys[i]));
+        } else {
+            EXPECT_FALSE(flyweight.weakContains("value-" + std::to_string(i)));
+        }
+    }
+
+    // iteration skips the freed slots
+    std::size_t count = 0;
+    for (const auto& val : flyweight) {
+        EXPECT_TRUE(live.count(val.second) > 0);
+        ++count;
+    }
+    EXPECT_EQ(N / 2, count);
+
+    // new elements recycle the freed slots before the index grows
+    const index_type maxKey = *std::max_element(keys.begin(), keys.end());
+    for (std::size_t i = 0; i < N / 2; ++i) {
+        index_type key;
+        bool was_new;
+        std::tie(key, was_new) = flyweight.findOrInsert("fresh-" + std::to_string(i));
+        EXPECT_TRUE(was_new);
+        EXPECT_TRUE(key <= maxKey);
+        EXPECT_EQ("fresh-" + std::to_string(i), flyweight.fetch(key));
+    }
+
+    check(flyweight);
+}
+
 TEST(Flyweight, IteratorEmptyBeginEnd) {
     FlyweightImpl<std::string> flyweight{1};
     EXPECT_EQ(flyweight.begin(), flyweight.begin());
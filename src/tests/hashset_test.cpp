@@ -0,0 +1,145 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hashset_test.cpp
+ *
+ * Test cases for the ConcurrentInsertOnlyHashSet data structure.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/ConcurrentInsertOnlyHashSet.h"
+#include <algorithm>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle {
+
+TEST(ConcurrentInsertOnlyHashSet, Basic) {
+    ConcurrentInsertOnlyHashSet<int> set;
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(0, set.size());
+    EXPECT_FALSE(set.contains(1));
+
+    EXPECT_TRUE(set.insert(1));
+    EXPECT_FALSE(set.empty());
+    EXPECT_EQ(1, set.size());
+    EXPECT_TRUE(set.contains(1));
+    EXPECT_FALSE(set.contains(2));
+
+    // duplicates are rejected
+    EXPECT_FALSE(set.insert(1));
+    EXPECT_EQ(1, set.size());
+}
+
+TEST(ConcurrentInsertOnlyHashSet, Growth) {
+    ConcurrentInsertOnlyHashSet<int> set;
+
+    const int N = 100000;
+    for (int i = 0; i < N; i++) {
+        EXPECT_TRUE(set.insert(i));
+    }
+    EXPECT_EQ(N, set.size());
+
+    for (int i = 0; i < N; i++) {
+        EXPECT_TRUE(set.contains(i));
+        EXPECT_FALSE(set.contains(i + N));
+    }
+}
+
+TEST(ConcurrentInsertOnlyHashSet, Iteration) {
+    ConcurrentInsertOnlyHashSet<int> set;
+
+    const int N = 10000;
+    std::vector<int> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(i);
+    }
+    std::shuffle(data.begin(), data.end(), std::default_random_engine(0));
+    for (int cur : data) {
+        set.insert(cur);
+    }
+
+    // the iteration order is arbitrary but covers each element once
+    std::set<int> seen;
+    for (int cur : set) {
+        EXPECT_TRUE(seen.insert(cur).second);
+    }
+    EXPECT_EQ(N, seen.size());
+
+    // partitions jointly cover all elements as well
+    seen.clear();
+    for (const auto& chunk : set.partition(400)) {
+        for (int cur : chunk) {
+            EXPECT_TRUE(seen.insert(cur).second);
+        }
+    }
+    EXPECT_EQ(N, seen.size());
+}
+
+TEST(ConcurrentInsertOnlyHashSet, EqualRange) {
+    ConcurrentInsertOnlyHashSet<int> set;
+
+    for (int i = 0; i < 1000; i++) {
+        set.insert(i);
+    }
+
+    for (int i = 0; i < 1000; i++) {
+        auto range = set.equalRange(i);
+        EXPECT_FALSE(range.empty());
+        EXPECT_EQ(i, *range.begin());
+        auto it = range.begin();
+        ++it;
+        EXPECT_EQ(range.end(), it);
+    }
+
+    EXPECT_TRUE(set.equalRange(1000).empty());
+}
+
+TEST(ConcurrentInsertOnlyHashSet, Clear) {
+    ConcurrentInsertOnlyHashSet<int> set;
+
+    for (int i = 0; i < 1000; i++) {
+        set.insert(i);
+    }
+    EXPECT_EQ(1000, set.size());
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains(0));
+
+    // the set remains usable after clearing
+    EXPECT_TRUE(set.insert(42));
+    EXPECT_TRUE(set.contains(42));
+    EXPECT_EQ(1, set.size());
+}
+
+#ifdef _OPENMP
+TEST(ConcurrentInsertOnlyHashSet, ParallelInsert) {
+    ConcurrentInsertOnlyHashSet<int> set;
+
+    const int N = 100000;
+#pragma omp parallel for num_threads(4)
+    for (int i = 0; i < N; i++) {
+        // concurrently insert each element twice
+        set.insert(i / 2);
+    }
+
+    EXPECT_EQ(N / 2, set.size());
+    for (int i = 0; i < N / 2; i++) {
+        EXPECT_TRUE(set.contains(i));
+    }
+}
+#endif  // _OPENMP
+
+}  // namespace souffle
@@ -0,0 +1,77 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2025, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hyperloglog_test.cpp
+ *
+ * Test cases for the HyperLogLog sketch backing the countd aggregate.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/HyperLogLog.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace souffle::test {
+
+TEST(HyperLogLog, Empty) {
+    HyperLogLog sketch;
+    EXPECT_EQ(0, sketch.estimate());
+}
+
+TEST(HyperLogLog, SmallWithinError) {
+    // small cardinalities fall into the linear counting regime and
+    // are expected to be close to exact
+    HyperLogLog sketch;
+    for (uint64_t i = 0; i < 100; ++i) {
+        sketch.insert(i);
+    }
+    std::size_t estimate = sketch.estimate();
+    EXPECT_TRUE(95 <= estimate && estimate <= 105);
+}
+
+TEST(HyperLogLog, Idempotent) {
+    HyperLogLog sketch;
+    for (int round = 0; round < 5; ++round) {
+        for (uint64_t i = 0; i < 1000; ++i) {
+            sketch.insert(i);
+        }
+    }
+    std::size_t estimate = sketch.estimate();
+    EXPECT_TRUE(950 <= estimate && estimate <= 1050);
+}
+
+TEST(HyperLogLog, LargeWithinError) {
+    const uint64_t n = 1000000;
+    HyperLogLog sketch;
+    for (uint64_t i = 0; i < n; ++i) {
+        sketch.insert(i);
+    }
+    // 2^12 registers give a standard error of ~1.6%; allow 5%
+    std::size_t estimate = sketch.estimate();
+    EXPECT_TRUE(n * 95 / 100 <= estimate && estimate <= n * 105 / 100);
+}
+
+TEST(HyperLogLog, Merge) {
+    const uint64_t n = 100000;
+    HyperLogLog full;
+    HyperLogLog even;
+    HyperLogLog odd;
+    for (uint64_t i = 0; i < n; ++i) {
+        full.insert(i);
+        (i % 2 == 0 ? even : odd).insert(i);
+    }
+    // merging per-thread sketches must reproduce the combined sketch
+    even.merge(odd);
+    EXPECT_EQ(full.estimate(), even.estimate());
+}
+
+}  // namespace souffle::test
@@ -0,0 +1,201 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file interval_set_test.cpp
+ *
+ * Test cases for the IntervalSet data structure.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/IntervalSet.h"
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace souffle {
+
+using TestTuple = Tuple<RamDomain, 1>;
+using TestSet = IntervalSet<TestTuple>;
+
+TEST(IntervalSet, Basic) {
+    TestSet set;
+
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(0, set.size());
+    EXPECT_FALSE(set.contains(TestTuple{1}));
+
+    EXPECT_TRUE(set.insert(TestTuple{1}));
+    EXPECT_FALSE(set.insert(TestTuple{1}));
+
+    EXPECT_TRUE(set.contains(TestTuple{1}));
+    EXPECT_FALSE(set.contains(TestTuple{2}));
+    EXPECT_EQ(1, set.size());
+}
+
+TEST(IntervalSet, Coalescing) {
+    TestSet set;
+
+    // adjacent values collapse into a single span
+    set.insert(TestTuple{1});
+    set.insert(TestTuple{3});
+    EXPECT_EQ(2, set.getNumSpans());
+
+    // the middle value bridges the two spans
+    set.insert(TestTuple{2});
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(3, set.size());
+
+    // extension on either side keeps a single span
+    set.insert(TestTuple{0});
+    set.insert(TestTuple{4});
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(5, set.size());
+}
+
+TEST(IntervalSet, SpanInsert) {
+    TestSet set;
+
+    EXPECT_TRUE(set.insert(10, 20));
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(11, set.size());
+
+    // a fully covered span adds nothing
+    EXPECT_FALSE(set.insert(12, 18));
+    EXPECT_EQ(11, set.size());
+
+    // an overlapping span extends the existing one
+    EXPECT_TRUE(set.insert(15, 30));
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(21, set.size());
+
+    // an abutting span is merged as well
+    EXPECT_TRUE(set.insert(31, 40));
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(31, set.size());
+
+    // a span bridging several stored spans absorbs all of them
+    set.insert(50, 60);
+    set.insert(70, 80);
+    EXPECT_EQ(3, set.getNumSpans());
+    EXPECT_TRUE(set.insert(41, 69));
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(71, set.size());
+}
+
+TEST(IntervalSet, DenseFill) {
+    TestSet set;
+
+    // a range-generator style point-by-point fill collapses to one span
+    const RamDomain N = 100000;
+    for (RamDomain i = 0; i < N; i++) {
+        EXPECT_TRUE(set.insert(TestTuple{i}));
+    }
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ((std::size_t)N, set.size());
+
+    for (RamDomain i = 0; i < N; i++) {
+        EXPECT_TRUE(set.contains(TestTuple{i}));
+    }
+    EXPECT_FALSE(set.contains(TestTuple{N}));
+    EXPECT_FALSE(set.contains(TestTuple{-1}));
+}
+
+TEST(IntervalSet, Iteration) {
+    TestSet set;
+
+    set.insert(1, 3);
+    set.insert(7, 9);
+    set.insert(TestTuple{5});
+
+    std::vector<RamDomain> values;
+    for (const auto& tuple : set) {
+        values.push_back(tuple[0]);
+    }
+
+    const std::vector<RamDomain> expected{1, 2, 3, 5, 7, 8, 9};
+    EXPECT_EQ(expected, values);
+}
+
+TEST(IntervalSet, Bounds) {
+    TestSet set;
+
+    set.insert(10, 20);
+    set.insert(30, 40);
+
+    // inside a span
+    EXPECT_EQ(15, (*set.lower_bound(TestTuple{15}))[0]);
+    // in a gap between spans
+    EXPECT_EQ(30, (*set.lower_bound(TestTuple{21}))[0]);
+    // before all spans
+    EXPECT_EQ(10, (*set.lower_bound(TestTuple{-5}))[0]);
+    // past all spans
+    EXPECT_TRUE(set.lower_bound(TestTuple{41}) == set.end());
+
+    // the upper bound is exclusive
+    EXPECT_EQ(16, (*set.upper_bound(TestTuple{15}))[0]);
+    EXPECT_EQ(30, (*set.upper_bound(TestTuple{20}))[0]);
+    EXPECT_TRUE(set.upper_bound(TestTuple{40}) == set.end());
+    EXPECT_TRUE(set.upper_bound(TestTuple{std::numeric_limits<RamDomain>::max()}) == set.end());
+
+    // an equality search covers exactly the probed value
+    std::size_t count = 0;
+    for (auto it = set.lower_bound(TestTuple{15}); it != set.upper_bound(TestTuple{15}); ++it) {
+        count++;
+    }
+    EXPECT_EQ(1, count);
+}
+
+TEST(IntervalSet, NegativeValues) {
+    TestSet set;
+
+    set.insert(-10, -5);
+    EXPECT_TRUE(set.contains(TestTuple{-7}));
+    EXPECT_FALSE(set.contains(TestTuple{-11}));
+
+    // bridge across zero
+    EXPECT_TRUE(set.insert(-4, 4));
+    EXPECT_EQ(1, set.getNumSpans());
+    EXPECT_EQ(15, set.size());
+}
+
+TEST(IntervalSet, Partition) {
+    TestSet set;
+
+    for (RamDomain i = 0; i < 1000; i += 10) {
+        set.insert(i, i + 4);
+    }
+
+    std::size_t count = 0;
+    for (const auto& chunk : set.partition(16)) {
+        for (const auto& tuple : chunk) {
+            testutil::ignore(tuple);
+            count++;
+        }
+    }
+    EXPECT_EQ(set.size(), count);
+}
+
+TEST(IntervalSet, Clear) {
+    TestSet set;
+
+    set.insert(1, 100);
+    EXPECT_FALSE(set.empty());
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(0, set.size());
+    EXPECT_EQ(0, set.getNumSpans());
+    EXPECT_TRUE(set.begin() == set.end());
+}
+
+}  // namespace souffle
@@ -0,0 +1,158 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file kdtree_test.cpp
+ *
+ * Test cases for the KdTree data structure.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/KdTree.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace souffle {
+
+using TestTuple = Tuple<RamDomain, 2>;
+using TestTree = KdTree<TestTuple>;
+
+namespace {
+
+// collects the result of a range query in sorted order
+std::vector<TestTuple> query(const TestTree& tree, const TestTuple& lower, const TestTuple& upper) {
+    std::vector<TestTuple> res;
+    tree.rangeQuery(lower, upper, [&](const TestTuple& t) { res.push_back(t); });
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+// the brute-force reference for the same query
+std::vector<TestTuple> queryNaive(
+        const std::vector<TestTuple>& data, const TestTuple& lower, const TestTuple& upper) {
+    std::vector<TestTuple> res;
+    for (const auto& t : data) {
+        bool inside = true;
+        for (std::size_t i = 0; i < t.size(); ++i) {
+            inside = inside && lower[i] <= t[i] && t[i] <= upper[i];
+        }
+        if (inside) {
+            res.push_back(t);
+        }
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+}  // namespace
+
+TEST(KdTree, Basic) {
+    TestTree tree;
+
+    EXPECT_TRUE(tree.empty());
+    EXPECT_EQ(0, tree.size());
+    EXPECT_FALSE(tree.contains(TestTuple{1, 2}));
+
+    EXPECT_TRUE(tree.insert(TestTuple{1, 2}));
+    EXPECT_FALSE(tree.insert(TestTuple{1, 2}));
+
+    EXPECT_TRUE(tree.contains(TestTuple{1, 2}));
+    EXPECT_FALSE(tree.contains(TestTuple{2, 1}));
+    EXPECT_EQ(1, tree.size());
+}
+
+TEST(KdTree, RangeQueryStress) {
+    const int N = 10000;
+
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::uniform_int_distribution<RamDomain> dist(0, 500);
+
+    std::vector<TestTuple> data;
+    for (int i = 0; i < N; i++) {
+        data.push_back(TestTuple{dist(generator), dist(generator)});
+    }
+    std::sort(data.begin(), data.end());
+    data.erase(std::unique(data.begin(), data.end()), data.end());
+
+    // the incrementally filled and the bulk-built tree must agree with
+    // the brute-force scan on arbitrary boxes, including empty and
+    // degenerate (point / line) ones
+    TestTree incremental;
+    for (const auto& t : data) {
+        EXPECT_TRUE(incremental.insert(t));
+    }
+    TestTree bulk(data);
+    EXPECT_EQ(data.size(), incremental.size());
+    EXPECT_EQ(data.size(), bulk.size());
+
+    for (int i = 0; i < 100; i++) {
+        TestTuple a{dist(generator), dist(generator)};
+        TestTuple b{dist(generator), dist(generator)};
+        TestTuple lower{std::min(a[0], b[0]), std::min(a[1], b[1])};
+        TestTuple upper{std::max(a[0], b[0]), std::max(a[1], b[1])};
+
+        auto expected = queryNaive(data, lower, upper);
+        EXPECT_EQ(expected, query(incremental, lower, upper));
+        EXPECT_EQ(expected, query(bulk, lower, upper));
+    }
+
+    auto point = data[data.size() / 2];
+    EXPECT_EQ(queryNaive(data, point, point), query(bulk, point, point));
+    EXPECT_EQ(0, query(bulk, TestTuple{501, 0}, TestTuple{600, 500}).size());
+}
+
+TEST(KdTree, IntervalOverlapJoin) {
+    // intervals (start, end); the driving pattern of an overlap join with
+    // a probe interval [s, e] is the box s1 <= e && e1 >= s, i.e. a
+    // two-sided inequality conjunction no single-order index can serve
+    std::vector<TestTuple> intervals;
+    for (RamDomain i = 0; i < 1000; i++) {
+        intervals.push_back(TestTuple{i * 10, i * 10 + 14});
+    }
+    TestTree tree(intervals);
+
+    const RamDomain s = 4995;
+    const RamDomain e = 5020;
+    auto overlapping = query(tree, TestTuple{0, s}, TestTuple{e, std::numeric_limits<RamDomain>::max()});
+
+    std::vector<TestTuple> expected;
+    for (const auto& iv : intervals) {
+        if (iv[0] <= e && iv[1] >= s) {
+            expected.push_back(iv);
+        }
+    }
+    EXPECT_EQ(expected, overlapping);
+    EXPECT_EQ(4, overlapping.size());
+}
+
+TEST(KdTree, ParallelInsert) {
+    const int N = 10000;
+
+    TestTree tree;
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < N; i++) {
+        tree.insert(TestTuple{i / 100, i % 100});
+    }
+
+    EXPECT_EQ(N, tree.size());
+    for (int i = 0; i < N; i++) {
+        EXPECT_TRUE(tree.contains(TestTuple{i / 100, i % 100}));
+    }
+}
+
+}  // namespace souffle
@@ -0,0 +1,130 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2021, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file packed_tuple_test.cpp
+ *
+ * Test cases for the PackedTuple data structure.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/BTree.h"
+#include "souffle/datastructure/PackedTuple.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace souffle {
+
+TEST(PackedTuple, RoundTrip) {
+    // 20-bit attributes straddle word boundaries from the fourth on
+    PackedTuple<5, 20> t;
+
+    std::array<RamDomain, 5> values = {0, 1, (1 << 20) - 1, 12345, 1 << 19};
+    for (std::size_t i = 0; i < values.size(); i++) {
+        t[i] = values[i];
+    }
+    for (std::size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(values[i], t[i]) << "i=" << i;
+    }
+
+    // overwriting one attribute leaves its neighbours untouched
+    t[2] = 7;
+    EXPECT_EQ(7, t[2]);
+    EXPECT_EQ(values[1], t[1]);
+    EXPECT_EQ(values[3], t[3]);
+}
+
+TEST(PackedTuple, Fits) {
+    using Narrow = PackedTuple<3, 8>;
+
+    EXPECT_TRUE(Narrow::fits(0));
+    EXPECT_TRUE(Narrow::fits(255));
+    EXPECT_FALSE(Narrow::fits(256));
+    EXPECT_FALSE(Narrow::fits(-1));
+}
+
+TEST(PackedTuple, Ordering) {
+    using Packed = PackedTuple<3, 13>;
+    using Plain = std::array<RamDomain, 3>;
+
+    const int N = 2000;
+
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    std::uniform_int_distribution<RamDomain> dist(0, (1 << 13) - 1);
+
+    std::vector<Plain> plain;
+    std::vector<Packed> packed;
+    for (int i = 0; i < N; i++) {
+        Plain p = {dist(generator), dist(generator), dist(generator)};
+        Packed q;
+        for (std::size_t j = 0; j < p.size(); j++) {
+            q[j] = p[j];
+        }
+        plain.push_back(p);
+        packed.push_back(q);
+    }
+
+    // the packed comparison coincides with the attribute-wise one
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < 20; j++) {
+            EXPECT_EQ(plain[i] < plain[j], packed[i] < packed[j]);
+            EXPECT_EQ(plain[i] == plain[j], packed[i] == packed[j]);
+        }
+    }
+}
+
+TEST(PackedTuple, BTreeKey) {
+    using Packed = PackedTuple<3, 10>;
+    using test_set = btree_set<Packed, detail::comparator<Packed>, std::allocator<Packed>, 256>;
+
+    const RamDomain N = 20;
+
+    std::vector<Packed> data;
+    for (RamDomain a = 0; a < N; a++) {
+        for (RamDomain b = 0; b < N; b++) {
+            for (RamDomain c = 0; c < N; c++) {
+                Packed t;
+                t[0] = a;
+                t[1] = b;
+                t[2] = c;
+                data.push_back(t);
+            }
+        }
+    }
+
+    std::random_device rd;
+    std::mt19937 generator(rd());
+    shuffle(data.begin(), data.end(), generator);
+
+    test_set t;
+    for (const auto& cur : data) {
+        EXPECT_TRUE(t.insert(cur));
+    }
+    EXPECT_EQ(data.size(), t.size());
+
+    // iteration yields the attribute-lexicographic order despite the
+    // shuffled, packed insertion
+    RamDomain expected = 0;
+    for (const auto& cur : t) {
+        EXPECT_EQ(expected / (N * N), cur[0]);
+        EXPECT_EQ((expected / N) % N, cur[1]);
+        EXPECT_EQ(expected % N, cur[2]);
+        expected++;
+    }
+    EXPECT_EQ((RamDomain)data.size(), expected);
+}
+
+}  // namespace souffle
@@ -23,7 +23,9 @@
 #include <iostream>
 #include <limits>
 #include <random>
+#include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <cstddef>
@@ -72,7 +74,8 @@ TEMPLATE_TEST(PackUnpack, Tuple, std::size_t TupleSize, TupleSize) {
     for (std::size_t i = 0; i < NUMBER_OF_TESTS; ++i) {
         std::generate(toPack[i].begin(), toPack[i].end(), rnd);
         tupleRef[i] = pack(recordTable, toPack[i]);
-        EXPECT_LT(0, tupleRef[i]);
+        // small records of arity 1 and 2 are encoded inline as negative references
+        EXPECT_NE(0, tupleRef[i]);
     }
 
     // unpack and test
@@ -96,6 +99,136 @@ INSTANTIATE_TEMPLATE_TEST(PackUnpack, Tuple, 11);
 INSTANTIATE_TEMPLATE_TEST(PackUnpack, Tuple, 23);
 INSTANTIATE_TEMPLATE_TEST(PackUnpack, Tuple, 59);
 
+// Pack a contiguous buffer of tuples in one batch; the references must
+// agree with the ones handed out by the one-at-a-time interface.
+TEST(PackUnpack, Batch) {
+    constexpr std::size_t tupleSize = 3;
+
+    // Setup random number generation
+    std::default_random_engine randomGenerator(3);
+    std::uniform_int_distribution<RamDomain> distribution(
+            std::numeric_limits<RamDomain>::lowest(), std::numeric_limits<RamDomain>::max());
+
+    auto random = std::bind(distribution, randomGenerator);
+    auto rnd = [&]() { return random(); };
+
+    SpecializedRecordTable<tupleSize> recordTable;
+    recordTable.reserve(tupleSize, NUMBER_OF_TESTS);
+
+    std::vector<RamDomain> buffer(NUMBER_OF_TESTS * tupleSize);
+    std::generate(buffer.begin(), buffer.end(), rnd);
+
+    std::vector<RamDomain> batchRefs(NUMBER_OF_TESTS);
+    recordTable.packBatch(buffer.data(), NUMBER_OF_TESTS, tupleSize, batchRefs.data());
+
+    for (std::size_t i = 0; i < NUMBER_OF_TESTS; ++i) {
+        EXPECT_LT(0, batchRefs[i]);
+        EXPECT_EQ(batchRefs[i], recordTable.pack(buffer.data() + i * tupleSize, tupleSize));
+        const RamDomain* unpacked{recordTable.unpack(batchRefs[i], tupleSize)};
+        for (std::size_t j = 0; j < tupleSize; ++j) {
+            EXPECT_EQ(buffer[i * tupleSize + j], unpacked[j]);
+        }
+    }
+}
+
+// Sweeping releases the records not marked live. Survivors keep their
+// reference, and the freed slots are recycled by later packs.
+TEST(PackUnpack, Sweep) {
+    constexpr std::size_t tupleSize = 3;
+    constexpr std::size_t count = 100;
+
+    SpecializedRecordTable<tupleSize> recordTable;
+
+    // fill a specialized (arity 3) and a generic (arity 4) map
+    std::vector<RamDomain> refs3(count);
+    std::vector<RamDomain> refs4(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const RamDomain d = static_cast<RamDomain>(i);
+        const Tuple<RamDomain, 3> t3 = {{d, d + 1, d + 2}};
+        const Tuple<RamDomain, 4> t4 = {{d, d + 1, d + 2, d + 3}};
+        refs3[i] = recordTable.pack(t3.data(), 3);
+        refs4[i] = recordTable.pack(t4.data(), 4);
+    }
+
+    // sweep out the odd half of the records of both arities
+    std::set<std::pair<std::size_t, RamDomain>> live;
+    for (std::size_t i = 0; i < count; i += 2) {
+        live.insert({3, refs3[i]});
+        live.insert({4, refs4[i]});
+    }
+    const std::size_t before = recordTable.getMemoryUsage();
+    const std::size_t swept = recordTable.sweep([&](const std::size_t arity, const RamDomain ref) {
+        return live.count({arity, ref}) > 0;
+    });
+    EXPECT_EQ(count, swept);
+    EXPECT_LT(recordTable.getMemoryUsage(), before);
+
+    // survivors keep their reference and fields
+    for (std::size_t i = 0; i < count; i += 2) {
+        const RamDomain d = static_cast<RamDomain>(i);
+        const RamDomain* ptr3 = recordTable.unpack(refs3[i], 3);
+        const RamDomain* ptr4 = recordTable.unpack(refs4[i], 4);
+        for (std::size_t j = 0; j < 3; ++j) {
+            EXPECT_EQ(d + static_cast<RamDomain>(j), ptr3[j]);
+        }
+        for (std::size_t j = 0; j < 4; ++j) {
+            EXPECT_EQ(d + static_cast<RamDomain>(j), ptr4[j]);
+        }
+        // re-packing a survivor resolves to the existing reference
+        EXPECT_EQ(refs3[i], recordTable.pack(ptr3, 3));
+    }
+
+    // fresh records recycle the freed slots before the maps grow
+    const RamDomain maxRef = *std::max_element(refs3.begin(), refs3.end());
+    for (std::size_t i = 0; i < count / 2; ++i) {
+        const RamDomain d = static_cast<RamDomain>(count + i);
+        const Tuple<RamDomain, 3> t3 = {{d, d + 1, d + 2}};
+        const RamDomain ref = recordTable.pack(t3.data(), 3);
+        EXPECT_TRUE(ref <= maxRef);
+        const RamDomain* ptr = recordTable.unpack(ref, 3);
+        for (std::size_t j = 0; j < 3; ++j) {
+            EXPECT_EQ(d + static_cast<RamDomain>(j), ptr[j]);
+        }
+    }
+}
+
+// Records of arity 1 and 2 with small fields are encoded inline in the
+// reference; the encoding must be canonical across all pack entry points
+// and unpack must reproduce the fields.
+TEST(PackUnpack, Inline) {
+    SpecializedRecordTable<1, 2> recordTable;
+
+    // a pair of 14-bit values is encoded inline, as a negative reference
+    const Tuple<RamDomain, 2> pair = {{12345, 678}};
+    const RamDomain pairRef = pack(recordTable, pair);
+    EXPECT_TRUE(details::isInlineRef(pairRef));
+
+    // every pack entry point hands out the same reference
+    EXPECT_EQ(pairRef, recordTable.pack(pair.data(), 2));
+    RamDomain batchRef;
+    recordTable.packBatch(pair.data(), 1, 2, &batchRef);
+    EXPECT_EQ(pairRef, batchRef);
+
+    // the storage-based unpack decodes without touching the table
+    Tuple<RamDomain, 2> storage;
+    const RamDomain* decoded = unpack(recordTable, pairRef, storage);
+    EXPECT_EQ(pair[0], decoded[0]);
+    EXPECT_EQ(pair[1], decoded[1]);
+
+    // the generic unpack materialises a stable copy with the same fields
+    const RamDomain* unpacked = recordTable.unpack(pairRef, 2);
+    EXPECT_EQ(pair[0], unpacked[0]);
+    EXPECT_EQ(pair[1], unpacked[1]);
+
+    // fields that exceed the payload width fall back to the record map
+    const Tuple<RamDomain, 2> big = {{1 << 20, -1}};
+    const RamDomain bigRef = pack(recordTable, big);
+    EXPECT_LT(0, bigRef);
+    const RamDomain* bigUnpacked = recordTable.unpack(bigRef, 2);
+    EXPECT_EQ(big[0], bigUnpacked[0]);
+    EXPECT_EQ(big[1], bigUnpacked[1]);
+}
+
 // Generate random vectors
 // pack them all
 // unpack and test for equality
@@ -123,7 +256,8 @@ TEMPLATE_TEST(PackUnpack, Vector, std::size_t VectorSize, VectorSize) {
         toPack[i].resize(vectorSize);
         std::generate(toPack[i].begin(), toPack[i].end(), rnd);
         tupleRef[i] = recordTable.pack(toPack[i].data(), vectorSize);
-        EXPECT_LT(0, tupleRef[i]);
+        // small records of arity 1 and 2 are encoded inline as negative references
+        EXPECT_NE(0, tupleRef[i]);
     }
 
     // unpack and test
@@ -20,6 +20,7 @@
 #include "souffle/utility/MiscUtil.h"
 #include <algorithm>
 #include <cstddef>
+#include <cstdio>
 #include <iostream>
 #include <random>
 #include <string>
@@ -89,6 +90,158 @@ TEST(SymbolTable, Basics) {
     }
 }
 
+TEST(SymbolTable, Freeze) {
+    for (int i = 0; i < RANDOM_TESTS; ++i) {
+        SymbolTable table;
+        std::vector<std::pair<std::string, RamDomain>> entries;
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            std::string s = random_string() + "~" + std::to_string(j);
+            entries.emplace_back(s, table.encode(s));
+        }
+
+        table.freeze();
+        EXPECT_TRUE(table.isFrozen());
+
+        // frozen symbols keep their indices
+        for (const auto& [symbol, index] : entries) {
+            EXPECT_EQ(index, table.encode(symbol));
+            EXPECT_STREQ(symbol, table.decode(index));
+            bool was_new;
+            std::tie(std::ignore, was_new) = table.findOrInsert(symbol);
+            EXPECT_TRUE(!was_new);
+        }
+
+        // new symbols take the escape path into the flyweight
+        const std::string fresh = "fresh~symbol";
+        const RamDomain index = table.encode(fresh);
+        EXPECT_STREQ(fresh, table.decode(index));
+        EXPECT_EQ(index, table.encode(fresh));
+    }
+}
+
+TEST(SymbolTable, Image) {
+    const std::string path = "./symbol_table_test.img";
+    std::vector<std::string> symbols;
+    {
+        // intern a set of symbols and persist them into an image
+        SymbolTable table;
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            std::string s = random_string() + "~" + std::to_string(j);
+            table.encode(s);
+            symbols.push_back(std::move(s));
+        }
+        table.saveImage(path);
+    }
+
+    {
+        SymbolTable table;
+        table.attachImage(path);
+        EXPECT_TRUE(table.hasImage());
+
+        // image symbols are served without re-interning, in sorted order
+        std::sort(symbols.begin(), symbols.end());
+        for (std::size_t j = 0; j < symbols.size(); ++j) {
+            EXPECT_TRUE(table.weakContains(symbols[j]));
+            EXPECT_EQ(static_cast<RamDomain>(j), table.encode(symbols[j]));
+            EXPECT_STREQ(symbols[j], table.decode(static_cast<RamDomain>(j)));
+            bool was_new;
+            std::tie(std::ignore, was_new) = table.findOrInsert(symbols[j]);
+            EXPECT_TRUE(!was_new);
+        }
+
+        // image indices double as collation keys
+        for (std::size_t j = 1; j < symbols.size(); ++j) {
+            EXPECT_TRUE(table.compare(static_cast<RamDomain>(j - 1), static_cast<RamDomain>(j)) < 0);
+        }
+
+        // run-local symbols land in the overlay above the image range
+        const std::string fresh = "fresh~symbol";
+        const RamDomain index = table.encode(fresh);
+        EXPECT_TRUE(static_cast<std::size_t>(index) >= symbols.size());
+        EXPECT_STREQ(fresh, table.decode(index));
+        EXPECT_EQ(index, table.encode(fresh));
+        for (std::size_t j = 0; j < symbols.size(); ++j) {
+            EXPECT_EQ(symbols[j].compare(fresh) < 0, table.compare(static_cast<RamDomain>(j), index) < 0);
+        }
+
+        // overlay symbols survive freezing alongside the image
+        table.freeze();
+        EXPECT_EQ(index, table.encode(fresh));
+        EXPECT_STREQ(fresh, table.decode(index));
+        EXPECT_EQ(0, table.encode(symbols[0]));
+
+        // re-saving folds the overlay into the next image
+        table.saveImage(path);
+    }
+
+    {
+        SymbolTable table;
+        table.attachImage(path);
+        EXPECT_TRUE(table.weakContains("fresh~symbol"));
+        for (const std::string& s : symbols) {
+            EXPECT_TRUE(table.weakContains(s));
+        }
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(SymbolTable, Compare) {
+    for (int i = 0; i < RANDOM_TESTS; ++i) {
+        SymbolTable table;
+        std::vector<std::pair<std::string, RamDomain>> entries;
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            std::string s = random_string() + "~" + std::to_string(j);
+            entries.emplace_back(s, table.encode(s));
+        }
+
+        // an unfrozen table compares character data
+        for (int j = 1; j < RANDOM_TEST_SIZE; ++j) {
+            const auto& [a, ia] = entries[j - 1];
+            const auto& [b, ib] = entries[j];
+            EXPECT_EQ(a.compare(b) < 0, table.compare(ia, ib) < 0);
+            EXPECT_EQ(0, table.compare(ia, ia));
+        }
+
+        // frozen symbols are ordered by their collation keys
+        table.freeze();
+        for (int j = 1; j < RANDOM_TEST_SIZE; ++j) {
+            const auto& [a, ia] = entries[j - 1];
+            const auto& [b, ib] = entries[j];
+            EXPECT_EQ(a.compare(b) < 0, table.compare(ia, ib) < 0);
+            EXPECT_EQ(a.compare(b) > 0, table.compare(ia, ib) > 0);
+            EXPECT_EQ(0, table.compare(ia, ia));
+        }
+
+        // symbols minted after freezing fall back to character comparison
+        const std::string fresh = "fresh~symbol";
+        const RamDomain index = table.encode(fresh);
+        for (const auto& [symbol, j] : entries) {
+            EXPECT_EQ(symbol.compare(fresh) < 0, table.compare(j, index) < 0);
+            EXPECT_EQ(fresh.compare(symbol) < 0, table.compare(index, j) < 0);
+        }
+    }
+}
+
+TEST(SymbolTable, EncodeBatch) {
+    for (int i = 0; i < RANDOM_TESTS; ++i) {
+        SymbolTable table;
+        std::vector<std::string> symbols;
+        for (int j = 0; j < RANDOM_TEST_SIZE; ++j) {
+            symbols.push_back(random_string() + "~" + std::to_string(j % (RANDOM_TEST_SIZE / 2)));
+        }
+
+        std::vector<RamDomain> indices(symbols.size());
+        table.encodeBatch(symbols.data(), indices.data(), symbols.size());
+
+        // batch encoding agrees with one-at-a-time encoding
+        for (std::size_t j = 0; j < symbols.size(); ++j) {
+            EXPECT_EQ(indices[j], table.encode(symbols[j]));
+            EXPECT_STREQ(symbols[j], table.decode(indices[j]));
+        }
+    }
+}
+
 TEST(SymbolTable, Inserts) {
     for (int i = 0; i < RANDOM_TESTS; ++i) {
         SymbolTable X;
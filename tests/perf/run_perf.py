@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+# Souffle - A Datalog Compiler
+# Copyright (c) 2026, The Souffle Developers. All rights reserved
+# Licensed under the Universal Permissive License v 1.0 as shown at:
+# - https://opensource.org/licenses/UPL
+# - <souffle root>/licenses/SOUFFLE-UPL.txt
+
+"""End-to-end performance regression harness.
+
+Runs the benchmark programs under programs/ in interpreter and
+synthesiser mode, recording wall time, peak RSS and the per-relation
+runtimes from the profile log that souffle writes via ProfileDatabase.
+Results can be stored as a baseline and later runs compared against it
+with a configurable regression threshold; the driver exits non-zero
+when any measurement regresses past the threshold.
+
+Typical usage:
+    ./run_perf.py --souffle ../../build/src/souffle --update-baseline
+    ./run_perf.py --souffle ../../build/src/souffle   # compare and gate
+"""
+
+import argparse
+import json
+import os
+import subprocess
+import sys
+import tempfile
+import time
+
+PROGRAMS = ["tc", "pointsto", "dataflow"]
+MODES = ["interpreted", "compiled"]
+
+
+def run_measured(command, cwd):
+    """Runs the command, returning (wall seconds, peak RSS in kB)."""
+    start = time.monotonic()
+    process = subprocess.Popen(command, cwd=cwd)
+    _, status, rusage = os.wait4(process.pid, 0)
+    wall = time.monotonic() - start
+    if status != 0:
+        raise RuntimeError("command failed ({}): {}".format(status, " ".join(command)))
+    return wall, rusage.ru_maxrss
+
+
+def relation_runtimes(profile_path):
+    """Extracts per-relation runtimes (in seconds) from a profile log.
+
+    The log is the JSON serialisation of ProfileDatabase; relation
+    runtimes live under root/program/relation/<name> as duration
+    entries, with recursive rules nested under their iterations.
+    """
+    with open(profile_path) as profile_file:
+        profile = json.load(profile_file)
+
+    def sum_durations(node):
+        total = 0
+        for key, value in node.items():
+            if not isinstance(value, dict):
+                continue
+            if key == "runtime" and set(value) >= {"start", "end"}:
+                total += value["end"] - value["start"]
+            else:
+                total += sum_durations(value)
+        return total
+
+    runtimes = {}
+    relations = profile.get("root", {}).get("program", {}).get("relation", {})
+    for name, entries in relations.items():
+        if isinstance(entries, dict):
+            runtimes[name] = sum_durations(entries) / 1e6
+    return runtimes
+
+
+def run_benchmark(options, program, mode, workdir):
+    perf_dir = os.path.dirname(os.path.abspath(__file__))
+    facts_dir = os.path.join(workdir, program, "facts")
+    if not os.path.isdir(facts_dir):
+        subprocess.check_call([sys.executable, os.path.join(perf_dir, "generate_facts.py"), program,
+                "--scale", str(options.scale), "--output-dir", facts_dir])
+    output_dir = os.path.join(workdir, program, mode)
+    os.makedirs(output_dir, exist_ok=True)
+    profile_path = os.path.join(output_dir, "profile.json")
+    command = [os.path.abspath(options.souffle), "-F", facts_dir, "-D", output_dir, "-p", profile_path,
+            "-j", str(options.jobs)]
+    if mode == "compiled":
+        command.append("-c")
+    command.append(os.path.join(perf_dir, "programs", program + ".dl"))
+    wall, max_rss = run_measured(command, output_dir)
+    return {
+        "wall_seconds": round(wall, 3),
+        "max_rss_kb": max_rss,
+        "relations": {name: round(seconds, 3) for name, seconds in relation_runtimes(profile_path).items()},
+    }
+
+
+def compare(results, baseline, threshold):
+    """Prints a comparison and returns the measurements that regressed."""
+    regressions = []
+    for key, current in sorted(results.items()):
+        previous = baseline.get(key)
+        if previous is None:
+            print("{:<24} {:>8.3f} s  {:>9} kB  (no baseline)".format(
+                    key, current["wall_seconds"], current["max_rss_kb"]))
+            continue
+        for metric, unit in (("wall_seconds", "s"), ("max_rss_kb", "kB")):
+            old, new = previous[metric], current[metric]
+            delta = 100.0 * (new - old) / old if old else 0.0
+            marker = ""
+            if delta > threshold:
+                marker = "  ** regression **"
+                regressions.append("{} {} {:+.1f}%".format(key, metric, delta))
+            print("{:<24} {:>10} {:>10} -> {:>10} {:>3} {:+6.1f}%{}".format(
+                    key, metric, old, new, unit, delta, marker))
+    return regressions
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("--souffle", default="souffle", help="souffle binary to benchmark")
+    parser.add_argument("--programs", default=",".join(PROGRAMS))
+    parser.add_argument("--modes", default=",".join(MODES))
+    parser.add_argument("--scale", type=int, default=1)
+    parser.add_argument("--jobs", type=int, default=1)
+    parser.add_argument("--workdir", help="working directory (default: temporary)")
+    parser.add_argument("--baseline", default="baseline.json")
+    parser.add_argument("--update-baseline", action="store_true")
+    parser.add_argument("--threshold", type=float, default=10.0,
+            help="regression threshold in percent (default: 10)")
+    parser.add_argument("--output", help="write raw results to this JSON file")
+    options = parser.parse_args()
+
+    workdir = options.workdir or tempfile.mkdtemp(prefix="souffle-perf-")
+    results = {}
+    for program in options.programs.split(","):
+        for mode in options.modes.split(","):
+            key = program + "/" + mode
+            print("running " + key + " ...", flush=True)
+            results[key] = run_benchmark(options, program, mode, workdir)
+
+    if options.output:
+        with open(options.output, "w") as output_file:
+            json.dump(results, output_file, indent=2, sort_keys=True)
+
+    if options.update_baseline:
+        with open(options.baseline, "w") as baseline_file:
+            json.dump(results, baseline_file, indent=2, sort_keys=True)
+        print("baseline written to " + options.baseline)
+        return 0
+
+    baseline = {}
+    if os.path.exists(options.baseline):
+        with open(options.baseline) as baseline_file:
+            baseline = json.load(baseline_file)
+    regressions = compare(results, baseline, options.threshold)
+    if regressions:
+        print("\nregressions past {:.0f}%:".format(options.threshold))
+        for regression in regressions:
+            print("  " + regression)
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())